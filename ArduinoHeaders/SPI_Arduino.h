@@ -17,6 +17,10 @@
 	#define		SPI_1_HWINFO	(&gSPI1)
 	
 	#define		SPI_INIT		SPIArduinoInit
+	
+	#define		SPI_1_CAPS		(SPI_Configure | SPI_BeginTransfer | SPI_EndTransfer | SPI_BiDir1Byte | SPI_BiDirBlock)
+	
+	#define		SPIARDUINO_BLOCKBUFF	32
 
 	#define		BUILD_DEBUG		1
 	#ifdef BUILD_DEBUG
@@ -43,6 +47,8 @@
 	eSPIReturn_t SPIArduinoEndTrans(sSPIIface_t *pIface);
 		
 	eSPIReturn_t SPIArduinoTransByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t *pnReadByte);
+	
+	eSPIReturn_t SPIArduinoTransBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes);
 
 /***** Functions	*****/
 
@@ -58,6 +64,7 @@ eSPIReturn_t SPIArduinoInit(sSPIIface_t *pIface, void *pHWInfo, uint32_t nBusClo
 	pIface->pfBeginTransfer = &SPIArduinoBeginTrans;
 	pIface->pfEndTransfer = &SPIArduinoEndTrans;
 	pIface->pfTransferByte = &SPIArduinoTransByte;
+	pIface->pfTransferBlock = &SPIArduinoTransBlock;
 	
 	//Copy settigns into the object
 	pIface->nBusClockFreq = nBusClockFreq;
@@ -130,5 +137,33 @@ eSPIReturn_t SPIArduinoTransByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t
 	return SPI_Success;
 }
 
+eSPIReturn_t SPIArduinoTransBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes) {
+	sArduinoSPI_t *pSPIObj = (sArduinoSPI_t *)pIface->pHWInfo;
+	uint8_t aBuff[SPIARDUINO_BLOCKBUFF];
+	uint32_t nOffset, nChunk;
+	
+	//The library transfers in place, so work through a copy of the send data
+	for (nOffset = 0; nOffset < nBytes; nOffset += nChunk) {
+		nChunk = nBytes - nOffset;
+		if (nChunk > SPIARDUINO_BLOCKBUFF) {
+			nChunk = SPIARDUINO_BLOCKBUFF;
+		}
+		
+		if (pSendBytes != NULL) {
+			memcpy(aBuff, pSendBytes + nOffset, nChunk);
+		} else {
+			memset(aBuff, 0xFF, nChunk);
+		}
+		
+		pSPIObj->pSPI->transfer(aBuff, nChunk);
+		
+		if (pReadBytes != NULL) {
+			memcpy(pReadBytes + nOffset, aBuff, nChunk);
+		}
+	}
+	
+	return SPI_Success;
+}
+
 #endif
 
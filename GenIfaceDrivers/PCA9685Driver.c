@@ -133,6 +133,35 @@ ePCA9685Return_t PCA9685SetOutput(sPCA9685Info_t *pObj, uint8_t nPWMOutNum, uint
 	return PCA9685_Success;
 }
 
+ePCA9685Return_t PCA9685SetDigital(sPCA9685Info_t *pObj, uint8_t nPWMOutNum, bool bOn) {
+	uint8_t nOnHAddr, nOffHAddr;
+	eI2CReturn_t eResult;
+	
+	if (nPWMOutNum >= PCA9685_NUMPWM) { //requested output does not exist
+		return PCA9685Fail_Unknown;
+	}
+	
+	nOnHAddr = PCA9685REG_PWM00_OnH + (nPWMOutNum * PCA9685REG_PWMnn_Offset);
+	nOffHAddr = PCA9685REG_PWM00_OffH + (nPWMOutNum * PCA9685REG_PWMnn_Offset);
+	
+	if (bOn == true) {
+		//Full off overrides full on, so set full on before clearing full off
+		eResult = pObj->pI2C->pfI2CWriteUint8Reg(pObj->pI2C, pObj->eAddr, nOnHAddr, PCA9685REG_High_FullOn);
+		if (eResult == I2C_Success) {
+			eResult = pObj->pI2C->pfI2CWriteUint8Reg(pObj->pI2C, pObj->eAddr, nOffHAddr, 0);
+		}
+	} else {
+		//Full off takes effect on its own
+		eResult = pObj->pI2C->pfI2CWriteUint8Reg(pObj->pI2C, pObj->eAddr, nOffHAddr, PCA9685REG_High_FullOn);
+	}
+	
+	if (eResult != I2C_Success) {
+		return PCA9685Fail_BusError;
+	}
+	
+	return PCA9685_Success;
+}
+
 ePCA9685Return_t PCA9685GetPWMFrequency(sPCA9685Info_t *pObj, uint32_t *pnFreqHz) {
 	eI2CReturn_t eResult;
 	uint8_t nRegVal;
@@ -249,6 +249,18 @@
 		@ingroup	pca9685driver
 	*/
 	ePCA9685Return_t PCA9685SetOutput(sPCA9685Info_t *pObj, uint8_t nPWMOutNum, uint16_t nOnCnt, uint16_t nOffCnt);
+
+	/**	@brief		Sets an output fully on or fully off
+		@details	Uses the full on and full off bits so the output does not pulse
+			at the PWM frequency.  Useful for driving relays and other loads that
+			are only switched.
+		@param		nPWMOutNum		The PWM output to operate
+		@param		bOn				True to turn the output fully on, false for fully off
+		@return		PCA9685_Success on success, or a code indicating the type of problem 
+			encounterd
+		@ingroup	pca9685driver
+	*/
+	ePCA9685Return_t PCA9685SetDigital(sPCA9685Info_t *pObj, uint8_t nPWMOutNum, bool bOn);
 	
 	/**	@brief		Retrieve the output frequency for all PWM outputs 
 		@return		PCA9685_Success on success, or a code indicating the type of problem 
@@ -18,7 +18,8 @@
 
 /***** Prototypes 	*****/
 	/**	@brief		Read data from the Wiznet peripheral
-		@details	Performs read operations with the peripheral over the SPI bus
+		@details	Performs read operations with the peripheral over the SPI bus.  The
+			whole read is one chip select frame, moved with the bus's block transfer.
 		@param		pDev		Pointer to the Wiznet5500 device object
 		@param		nAddress	The address in the requested back to read from
 		@param		eControl	Indicate the memory bank to read from
@@ -26,10 +27,11 @@
 		@param		nBytes		Number of bytes to read
 		@ingroup	w5500driver
 	*/
-	eW5500Return_t W5500ReadData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, uint8_t *pBuff, uint8_t nBytes);
+	eW5500Return_t W5500ReadData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, uint8_t *pBuff, uint16_t nBytes);
 	
 	/**	@brief		Write data from the Wiznet peripheral
-		@details	Performs write operations with the peripheral over the SPI bus
+		@details	Performs write operations with the peripheral over the SPI bus.  The
+			whole write is one chip select frame, moved with the bus's block transfer.
 		@param		pDev		Pointer to the Wiznet5500 device object
 		@param		nAddress	The address in the requested back to write to
 		@param		eControl	Indicate the memory bank to write to
@@ -37,17 +39,121 @@
 		@param		nBytes		Number of bytes to write
 		@ingroup	w5500driver
 	*/
-	eW5500Return_t W5500WriteData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, const uint8_t *pBuff, uint8_t nBytes);
+	eW5500Return_t W5500WriteData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, const uint8_t *pBuff, uint16_t nBytes);
+	
+	/**	@brief		Interrupt handler for the INTn pin
+		@details	Makes no bus access, only notes that there are events to service
+			if INTn is low.
+		@param		pIface		GPIO interface the pin belongs to
+		@param		nPin		Pin that interrupted
+		@param		pParam		Pointer to the W5500 driver object
+		@ingroup	w5500driver
+	*/
+	void W5500EventIntHandler(sGPIOIface_t *pIface, GPIOID_t nPin, void *pParam);
+	
+	/**	@brief		Wait for an interrupt on any of a set of sockets
+		@details	Spins on the flag set by the INTn interrupt without touching the
+			bus, servicing events each time it is set, until one of the requested
+			interrupts has been seen on one of the sockets.  Those interrupts are 
+			then cleared from what has been seen on those sockets.
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSckMask	Sockets to wait on, bit 0 for socket 0 and so on
+		@param		nIntMask	Socket interrupts to wait for, eW5500SckInt_t values
+		@return		Sockets the requested interrupts were seen on
+		@ingroup	w5500driver
+	*/
+	uint8_t W5500EventWait(sW5500Obj_t *pDev, uint8_t nSckMask, uint8_t nIntMask);
+	
+	/**	@brief		Write a socket's interrupt mask for the handlers it has
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSocket		Socket to set the mask of
+		@ingroup	w5500driver
+	*/
+	void W5500EventSetMask(sW5500Obj_t *pDev, uint8_t nSocket);
+	
+	/**	@brief		Choose the socket to give out for a new listen or connection
+		@details	Of the sockets not in use with at least nBuffKB of receive and 
+			transmit memory, picks the one with the least memory.  No bus access is
+			needed, the sizes and sockets in use are tracked in the device object.
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nBuffKB		Smallest buffers, in KB, the socket may have
+		@param		pnSocket	Returns the socket chosen
+		@return		W5500_Success if a socket was found, W5500Fail_NoSockets if not
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SocketAllocate(sW5500Obj_t *pDev, uint8_t nBuffKB, uint8_t *pnSocket);
+	
+	/**	@brief		Open a socket in the requested mode
+		@details	Clears its interrupts, sets its source port and mode, then opens
+			it and waits for it to leave the closed state.
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSocket		Socket to open
+		@param		nPort		Source port for the socket
+		@param		nMode		Value for the socket mode register
+		@return		W5500_Success if the socket opened, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SocketOpen(sW5500Obj_t *pDev, uint8_t nSocket, uint16_t nPort, uint8_t nMode);
+	
+	/**	@brief		Find how much a socket's transmit buffer can take and where
+		@details	The free size, read pointer, and write pointer sit next to each 
+			other so one read gets all three.  Until the read pointer catches up 
+			to the write pointer the part is still sending, and no room is 
+			reported so another send is not issued on top of it.
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSocket		Socket to check
+		@param		pnFree		Returns the bytes that can be written, 0 while sending
+		@param		pnWrite		Returns the transmit write pointer
+		@return		W5500_Success if the part can take data, W5500Warn_Partial if it
+			is still sending
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SocketTXRoom(sW5500Obj_t *pDev, uint8_t nSocket, uint16_t *pnFree, uint16_t *pnWrite);
+	
+	/**	@brief		Write data into a socket's transmit buffer and send it
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSocket		Socket to send through
+		@param		nTXAddr		Transmit write pointer to put the data at
+		@param		pBuff		Data to send
+		@param		nBytes		Number of bytes to send, must fit in the free space
+		@ingroup	w5500driver
+	*/
+	void W5500SocketTXWrite(sW5500Obj_t *pDev, uint8_t nSocket, uint16_t nTXAddr, const uint8_t *pBuff, uint16_t nBytes);
+	
+	/**	@brief		Send all of the data through a TCP socket, piece by piece
+		@details	Waits between pieces for the part to finish sending, sleeping on
+			the send ok event when events are enabled.
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSocket		Socket to send through
+		@param		pData		Data to send
+		@param		nBytes		Number of bytes to send
+		@return		Net_Success once all of it is sent, NetFail_SocketState if the 
+			connection is lost, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetTCPSendAll(sW5500Obj_t *pDev, uint8_t nSocket, const uint8_t *pData, uint32_t nBytes);
+	
+	/**	@brief		Wait until a socket has data waiting or leaves its open state
+		@details	Sleeps on INTn between looks if events are enabled.
+		@param		pDev		Pointer to the Wiznet5500 device object
+		@param		nSocket		Socket to wait on
+		@param		eOpenState	State the socket is in while it can receive
+		@param		pnAvail		Returns the number of bytes waiting
+		@return		Net_Success if data is waiting, NetFail_SocketState if the socket
+			left the open state first, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetWaitData(sW5500Obj_t *pDev, uint8_t nSocket, eW5500SckStat_t eOpenState, uint16_t *pnAvail);
 	
 	/**	@brief		Binds a TCP port on the Wiznet device and listens for connections
 		@details	The wiznet device does not allow multiply IP addresses, so the IP
 			value in the pConn paramater will not be checked.  This will always assume
 			it is being asked to bind on the Wiznet's assigned IP address.
 			
-			The Wiznet also can not accept multiple connections on a single port.  Once
-			a connection request is made, it will be accepted and the socket will no 
-			longer be bound.  When a connection is accepted it is necessary to bind
-			the socket again.
+			The Wiznet also can not accept multiple connections on a single socket.  
+			Once a connection request is made, it will be accepted and the socket will
+			no longer be listening.  To cover this several sockets are set listening
+			on the port, and each one that accepts a connection is replaced.
 		@param		pTCPServ		Pointer to the Wiznet5500 TCP server interface object
 		@param		pConn			Connection information on the socket to bind
 		@return		Net_Success on success, or a code indicating the failure
@@ -63,11 +169,12 @@
 	eNetReturn_t W5500NetTCPServCloseHost(sTCPServ_t *pTCPServ);
 	
 	/**	@brief		Block until a connection request arrives then accept it
-		@details	The function will monitor the state of the listening socket until it
-			leaves the listening state.  The Wiznet device will automatically accept any
-			and all connection requests and change the state to established.  When this
-			happens the function will retrieve the connection details set a new socket to
-			listen on the socket then return.
+		@details	The function will monitor the state of the listening sockets until 
+			one leaves the listening state.  The Wiznet device will automatically accept
+			any and all connection requests and change the state to established.  When 
+			this happens the function will retrieve the connection details, set a new 
+			socket to listen in its place, then return.  Listening sockets that fail 
+			are closed and replaced.
 		@param		pTCPServ		Pointer to the Wiznet5500 TCP server interface object
 		@param		pClientSck		Returns information about the client that connected
 		@return		Net_Success on success, or a code indicating the failure
@@ -76,6 +183,8 @@
 	eNetReturn_t W5500NetTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pClientSck);
 	
 	/**	@brief		Closes down a client socket
+		@details	The socket freed is set listening if the server is short of
+			listening sockets.
 		@param		pTCPServ		Pointer to the Wiznet5500 TCP server interface object
 		@param		pSck			Pointer to the socket to close
 		@return		Net_Success on success, or a code indicating the failure
@@ -83,12 +192,51 @@
 	*/
 	eNetReturn_t W5500NetTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck);
 	
+	/**	@brief		Set sockets listening until the server has as many as it should
+		@details	Stops early if there are no free sockets.  The host socket is
+			updated to the first socket listening.
+		@param		pTCPServ		Pointer to the Wiznet5500 TCP server interface object
+		@return		Sockets listening for the server, bit 0 for socket 0 and so on
+		@ingroup	w5500driver
+	*/
+	uint8_t W5500NetTCPServArm(sTCPServ_t *pTCPServ);
+	
 	eNetReturn_t W5500NetTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
 	
 	eNetReturn_t W5500NetTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nDataBytes, void *pData);
 	
+	eNetReturn_t W5500NetTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nVecCnt, sNetVec_t *pVecs);
+	
+	/**	@brief		Connect to a TCP server and wait for the connection to be made
+		@param		pTCPClient		Pointer to hte TCP Client object to use
+		@param		pConn			Connection information of the TCP server
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	w5500driver
+	*/
 	eNetReturn_t W5500NetTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
 	
+	/**	@brief		Begin a connection to a TCP server without waiting
+		@details	Any socket the client has open is closed first.
+		@param		pTCPClient		Pointer to hte TCP Client object to use
+		@param		pConn			Connection information of the TCP server
+		@return		NetWarn_InProgress once the connect is issued, or a code indicating
+			the type of error encountered
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+	
+	/**	@brief		Check on a connection begun with W5500NetTCPClientConnectStart()
+		@details	The part does not say why a connection attempt failed, a socket 
+			that closes before it was ever established is reported as refused.  A 
+			failed socket is closed so it can be used again.
+		@param		pTCPClient		Pointer to hte TCP Client object to use
+		@return		Net_Success if connected, NetWarn_InProgress while connecting, 
+			NetFail_ConnRefuse if the attempt failed, or NetFail_SocketState if the
+			connection was lost
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetTCPClientConnectCheck(sTCPClient_t *pTCPClient);
+	
 	/**	@brief		Closes the TCP connection
 		@param		pTCPClient		Pointer to hte TCP Client object to use
 		@return		Net_Success on succeess, or a code indicating the type of error encountered
@@ -114,16 +262,78 @@
 		@ingroup	networkgeniface
 	*/
 	eNetReturn_t W5500NetTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData);
+	
+	/**	@brief		Send data gathered from several buffers to a TCP server
+		@param		pTCPClient		Pointer to hte TCP Client object to use
+		@param		nVecCnt			Number of pieces in the list
+		@param		pVecs			List of pieces of data to send
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	eNetReturn_t W5500NetTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs);
+	
+	/**	@brief		Opens a UDP socket on the requested port
+		@details	As with TCP the IP address in pConn is not checked.
+		@param		pUDPServ		Pointer to the Wiznet5500 UDP server interface object
+		@param		pConn			Connection information on the socket to bind
+		@return		Net_Success on success, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn);
+	
+	/**	@brief		Closes the UDP socket
+		@param		pUDPServ		Pointer to the Wiznet5500 UDP server interface object
+		@return		Net_Success on success, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetUDPServCloseHost(sUDPServ_t *pUDPServ);
+	
+	/**	@brief		Waits for and receives one datagram
+		@details	The part stores each datagram behind a header giving its source
+			and length.  The header is read first, then the data, and the read 
+			pointer is moved past the whole datagram.
+		@param		pUDPServ		Pointer to the Wiznet5500 UDP server interface object
+		@param		pConn			Returns the address and port the datagram came from
+		@param		nDataBytes		Number of bytes the data buffer can hold
+		@param		pData			Pointer to the bufer to receive the data 
+		@param		pnBytesRecv		Returns the number of data bytes received
+		@return		Net_Success on success, NetFail_BuffSize if the datagram was cut 
+			short to fit the buffer, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+	
+	/**	@brief		Sends one datagram
+		@param		pUDPServ		Pointer to the Wiznet5500 UDP server interface object
+		@param		pConn			Address and port to send to
+		@param		nDataBytes		Number of bytes to send
+		@param		pData			Buffer holding the data to send
+		@return		Net_Success on success, NetFail_BuffSize if the datagram can not 
+			fit in the transmit buffer, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eNetReturn_t W5500NetUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
 
 /***** Functions	*****/
 eW5500Return_t W5500Initialize(sW5500Obj_t *pDev, sSPIIface_t *pSpiBus, sGPIOIface_t *pIOObj, uint8_t nCSPin) {
-	uint8_t nCtr, nModeReg, nCmd, nControl;
+	uint8_t nCtr, nModeReg, nCmd, nBuffSz, nControl;
 	
 	//Set up module object
 	pDev->pGPIO = pIOObj;
 	pDev->pSPI = pSpiBus;
 	pDev->nChipSelectPin = nCSPin;
 	pDev->nNextPort = W5500_HIGHPORTSTART;
+	pDev->nIntPin = 0;
+	pDev->bEvents = false;
+	pDev->bIntPending = false;
+	pDev->nSckUsed = 0;
+	
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		pDev->aRXBuffKB[nCtr] = 2;
+		pDev->aTXBuffKB[nCtr] = 2;
+		pDev->aSckFlags[nCtr] = 0;
+		W5500EventSetHandlers(pDev, nCtr, NULL);
+	}
 	
 	//Prep the chip select pin
 	pDev->pGPIO->pfSetModeByPin(pDev->pGPIO, pDev->nChipSelectPin, GPIO_DigitalOutput);
@@ -151,11 +361,9 @@ eW5500Return_t W5500Initialize(sW5500Obj_t *pDev, sSPIIface_t *pSpiBus, sGPIOIfa
 		W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &nCmd, 1);
 		
 		//Set all buffers to 2K, evenly spreads out available space
-		nCmd = W5500SckBuff_2KB;
-		W5500WriteData(pDev, W5500SckReg_RXBuffSize, (eW5500Control_t)nControl, &nCmd, 1);
-		
-		nCmd = W5500SckBuff_2KB;
-		W5500WriteData(pDev, W5500SckReg_TXBuffSize, (eW5500Control_t)nControl, &nCmd, 1);
+		nBuffSz = W5500SckBuff_2KB;
+		W5500WriteData(pDev, W5500SckReg_RXBuffSize, (eW5500Control_t)nControl, &nBuffSz, 1);
+		W5500WriteData(pDev, W5500SckReg_TXBuffSize, (eW5500Control_t)nControl, &nBuffSz, 1);
 	}
 	
 	//Check the SPI Mode
@@ -258,68 +466,156 @@ eW5500Return_t W5500LinkStatus(sW5500Obj_t *pDev, bool *pbIsUp) {
 	return W5500_Success;
 }
 
-eW5500Return_t W5500SocketListen(sW5500Obj_t *pDev, uint8_t *pnSocket, uint16_t nPort, eW5500SckProt_t eProtocol) {
+eW5500Return_t W5500SetBufferSizes(sW5500Obj_t *pDev, const uint8_t aRXKB[W5500_NUMSOCKETS], const uint8_t aTXKB[W5500_NUMSOCKETS]) {
 	uint8_t nCtr, nControl;
-	uint8_t anRegVal[2];
+	uint16_t nRXTotal, nTXTotal;
 	
-	//Look for an unused socket
+	//Sizes must be ones the part has and fit in its memory
+	nRXTotal = 0;
+	nTXTotal = 0;
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		if ((aRXKB[nCtr] > W5500_BUFFMEMKB) || ((aRXKB[nCtr] & (aRXKB[nCtr] - 1)) != 0)) {
+			return W5500Fail_BuffSize;
+		}
+		
+		if ((aTXKB[nCtr] > W5500_BUFFMEMKB) || ((aTXKB[nCtr] & (aTXKB[nCtr] - 1)) != 0)) {
+			return W5500Fail_BuffSize;
+		}
+		
+		nRXTotal += aRXKB[nCtr];
+		nTXTotal += aTXKB[nCtr];
+	}
+	
+	if ((nRXTotal > W5500_BUFFMEMKB) || (nTXTotal > W5500_BUFFMEMKB)) {
+		return W5500Fail_BuffSize;
+	}
+	
+	//The size register holds the KB count directly
 	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
 		nControl = nCtr << W5500BSB_SocketLShift;
 		nControl |= W5500BSB_Register;
-		W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &anRegVal[0], 1);
 		
-		if (anRegVal[0] == W5500SckStat_Closed) {
-			break;
+		W5500WriteData(pDev, W5500SckReg_RXBuffSize, (eW5500Control_t)nControl, &(aRXKB[nCtr]), 1);
+		W5500WriteData(pDev, W5500SckReg_TXBuffSize, (eW5500Control_t)nControl, &(aTXKB[nCtr]), 1);
+		
+		pDev->aRXBuffKB[nCtr] = aRXKB[nCtr];
+		pDev->aTXBuffKB[nCtr] = aTXKB[nCtr];
+	}
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500SocketAllocate(sW5500Obj_t *pDev, uint8_t nBuffKB, uint8_t *pnSocket) {
+	uint8_t nCtr, nBest;
+	uint16_t nSize, nBestSize;
+	
+	if (nBuffKB == 0) { //Any socket with memory will do
+		nBuffKB = 1;
+	}
+	
+	//Best fit, leave the big sockets for those that need them
+	nBest = W5500_NOSOCKET;
+	nBestSize = 0;
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		if ((pDev->nSckUsed & (1 << nCtr)) != 0) {
+			continue;
+		}
+		
+		if ((pDev->aRXBuffKB[nCtr] < nBuffKB) || (pDev->aTXBuffKB[nCtr] < nBuffKB)) {
+			continue;
+		}
+		
+		nSize = pDev->aRXBuffKB[nCtr] + pDev->aTXBuffKB[nCtr];
+		if ((nBest == W5500_NOSOCKET) || (nSize < nBestSize)) {
+			nBest = nCtr;
+			nBestSize = nSize;
 		}
 	}
 	
-	if (nCtr >= W5500_NUMSOCKETS) { //All sockets are in use
+	if (nBest == W5500_NOSOCKET) {
 		return W5500Fail_NoSockets;
-	} else {
-		*pnSocket = nCtr;
 	}
 	
-	//Found a socket to use, get it setup
-	nControl = (*pnSocket) << W5500BSB_SocketLShift;
+	pDev->nSckUsed |= 1 << nBest;
+	*pnSocket = nBest;
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500SocketOpen(sW5500Obj_t *pDev, uint8_t nSocket, uint16_t nPort, uint8_t nMode) {
+	uint8_t nCtr, nControl;
+	uint8_t anRegVal[2];
+	
+	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_Register;
 	
 	anRegVal[0] = W5500SckInt_AllMask; //Clear any pending interrupts
 	W5500WriteData(pDev, W5500SckReg_Interrupt, (eW5500Control_t)nControl, &anRegVal[0], 1);
+	pDev->aSckFlags[nSocket] = 0;
 	
 	anRegVal[0] = nPort >> 8;
 	anRegVal[1] = nPort & 0xFF;
 	W5500WriteData(pDev, W5500SckReg_SourcePort0, (eW5500Control_t)nControl, anRegVal, 2);
 	
+	W5500WriteData(pDev, W5500SckReg_Mode, (eW5500Control_t)nControl, &nMode, 1);
+	
+	anRegVal[0] = W5500SckCmd_Open; //Command it to open to establish the socket
+	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &anRegVal[0], 1);
+	
+	//Should move the socket to INIT status
+	anRegVal[0] = W5500SckStat_Closed;
+	nCtr = 0;
+	while ((anRegVal[0] == W5500SckStat_Closed) && (nCtr < 10)) {
+		W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &anRegVal[0], 1);
+		if (anRegVal[0] == W5500SckStat_Closed) {
+			DELAYMILLISEC(1);
+		}
+		nCtr += 1;
+	}
+	
+	if (anRegVal[0] == W5500SckStat_Closed) {
+		return W5500Fail_Unknown;
+	}
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500SocketListen(sW5500Obj_t *pDev, uint8_t *pnSocket, uint16_t nPort, eW5500SckProt_t eProtocol, uint8_t nBuffKB) {
+	eW5500Return_t eResult;
+	uint8_t nControl, nMode;
+	
 	switch (eProtocol) { //Set the socket to the requested protocol
 		case IPPROTO_TCP:
-			anRegVal[0] = W5500SckMode_ProtTCP | W5500SckMode_NDMCMMB;
+			nMode = W5500SckMode_ProtTCP | W5500SckMode_NDMCMMB;
 			break;
 			
 		case IPPROTO_UDP:
-			anRegVal[0] = W5500SckMode_ProtUDP;
+			nMode = W5500SckMode_ProtUDP;
 			break;
 			
 		default:
 			return W5500Fail_Unsupported;
 	}
 	
-	W5500WriteData(pDev, W5500SckReg_Mode, (eW5500Control_t)nControl, &(anRegVal[0]), 1);
-	
-	anRegVal[0] = W5500SckCmd_Open; //Command it to open to establish the socket
-	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &anRegVal[0], 1);
+	//Look for an unused socket
+	eResult = W5500SocketAllocate(pDev, nBuffKB, pnSocket);
+	if (eResult != W5500_Success) {
+		return eResult;
+	}
 	
-	//Should move the socket to INIT status
-	anRegVal[0] = W5500SckStat_Closed;
-	nCtr = 0;
-	while ((anRegVal[0] == W5500SckStat_Closed) && (nCtr < 10)) {
-		W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &anRegVal[0], 1);
-		DELAYMILLISEC(1);
-		nCtr += 1;
+	//Found a socket to use, get it setup
+	eResult = W5500SocketOpen(pDev, *pnSocket, nPort, nMode);
+	if (eResult != W5500_Success) {
+		W5500CloseSocket(pDev, *pnSocket);
+		return eResult;
 	}
 	
 	if (eProtocol == IPPROTO_TCP) { //Must command TCP sockets to listen next
-		anRegVal[0] = W5500SckCmd_Listen;
-		W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &anRegVal[0], 1);
+		nControl = (*pnSocket) << W5500BSB_SocketLShift;
+		nControl |= W5500BSB_Register;
+		
+		nMode = W5500SckCmd_Listen;
+		W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &nMode, 1);
 	}
 	
 	if (pDev->nNextPort == nPort) { //Just in case don't clobber next outbound
@@ -332,26 +628,15 @@ eW5500Return_t W5500SocketListen(sW5500Obj_t *pDev, uint8_t *pnSocket, uint16_t
 	return W5500_Success;
 }
 
-eW5500Return_t W5500SocketConnect(sW5500Obj_t *pDev, uint8_t *pnSocket, IN_ADDR *Address, uint16_t nPort) {
-	uint8_t nControl = W5500BSB_Register;
+eW5500Return_t W5500SocketConnect(sW5500Obj_t *pDev, uint8_t *pnSocket, IN_ADDR *Address, uint16_t nPort, uint8_t nBuffKB) {
+	eW5500Return_t eResult;
+	uint8_t nControl;
 	uint8_t anBytes[2];
-	uint16_t nCtr;
 	
 	//Look for an unused socket
-	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
-		nControl = nCtr << W5500BSB_SocketLShift;
-		nControl |= W5500BSB_Register;
-		W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &anBytes[0], 1);
-		
-		if (anBytes[0] == W5500SckStat_Closed) {
-			break;
-		}
-	}
-	
-	if (nCtr >= W5500_NUMSOCKETS) { //All sockets are in use
-		return W5500Fail_NoSockets;
-	} else {
-		*pnSocket = nCtr;
+	eResult = W5500SocketAllocate(pDev, nBuffKB, pnSocket);
+	if (eResult != W5500_Success) {
+		return eResult;
 	}
 	
 	//Found a socket to use, get it setup
@@ -364,35 +649,38 @@ eW5500Return_t W5500SocketConnect(sW5500Obj_t *pDev, uint8_t *pnSocket, IN_ADDR
 	anBytes[1] = nPort & 0xFF;
 	W5500WriteData(pDev, W5500SckReg_DestPort0, (eW5500Control_t)nControl, anBytes, 2);
 	
-	anBytes[0] = pDev->nNextPort >> 8;
-	anBytes[1] = pDev->nNextPort& 0xFF;
-	W5500WriteData(pDev, W5500SckReg_SourcePort0, (eW5500Control_t)nControl, anBytes, 2);
-	
 	//Open the port, then command it to connect
-	anBytes[0] = W5500SckCmd_Open;
-	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &anBytes[0], 1);
+	eResult = W5500SocketOpen(pDev, *pnSocket, pDev->nNextPort, W5500SckMode_ProtTCP | W5500SckMode_NDMCMMB);
+	if (eResult != W5500_Success) {
+		W5500CloseSocket(pDev, *pnSocket);
+		return eResult;
+	}
+	
+	//Each connection gets its own source port
+	pDev->nNextPort += 1;
+	if (pDev->nNextPort == 0) {
+		pDev->nNextPort = W5500_HIGHPORTSTART;
+	}
 	
 	anBytes[0] = W5500SckCmd_Connect;
 	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &anBytes[0], 1);
 	
-	///@todo Verify that the connection was made and return that status. W5500SckStat_Establish on connect W5500SckStat_Closed on failure
-	
 	return W5500_Success;
 }
 
 eW5500Return_t W5500SocketStatus(sW5500Obj_t *pDev, uint8_t nSocket, eW5500SckProt_t *eProtocol, eW5500SckStat_t *eCurrState, uint16_t *nBytesWaiting, SOCKADDR_IN *pConnAddr, uint8_t nConnAddrLen) {
 	uint8_t nControl;
 	uint8_t aBytes[4];
-	uint16_t nVerify;
 	
 	if (nSocket >= W5500_NUMSOCKETS) {
 		return W5500Fail_InvalidSocket;
 	}
 	
-	//Read the status of the socket
+	//Read the status of the socket, the enum is wider than the register
 	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_Register;
-	W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, (uint8_t *)eCurrState, 1);
+	W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &(aBytes[0]), 1);
+	*eCurrState = (eW5500SckStat_t)aBytes[0];
 
 	//Read the mode to get the protocol
 	W5500ReadData(pDev, W5500SckReg_Mode, (eW5500Control_t)nControl, &(aBytes[0]), 1);
@@ -406,8 +694,10 @@ eW5500Return_t W5500SocketStatus(sW5500Obj_t *pDev, uint8_t nSocket, eW5500SckPr
 		*eProtocol = IPPROTO_INVALID;
 	}
 	
-	//Look for bytes waiting in the socket
+	//Look for bytes waiting in the socket, data arriving mid-read can only make this low
 	W5500ReadData(pDev, W5500SckReg_RXRecvSize0, (eW5500Control_t)nControl, aBytes, 2);
+	(*nBytesWaiting) = aBytes[0] << 8;
+	(*nBytesWaiting) |= aBytes[1];
 	
 	//Read connected socket infromation (TCP only)
 	pConnAddr->sin_familiy = AF_INET; //Always AF_INET
@@ -418,19 +708,6 @@ eW5500Return_t W5500SocketStatus(sW5500Obj_t *pDev, uint8_t nSocket, eW5500SckPr
 		
 		pConnAddr->sin_port = aBytes[0] << 8;
 		pConnAddr->sin_port |= aBytes[1];
-			
-		//Read the recv byte count. it can change mid-read, read until we get a matched reading
-		nVerify = 0;
-		W5500ReadData(pDev, W5500SckReg_RXRecvSize0, (eW5500Control_t)nControl, aBytes, 2);
-		(*nBytesWaiting) = aBytes[0] << 8;
-		(*nBytesWaiting) |= aBytes[1];
-		while (nVerify != (*nBytesWaiting)) {
-			nVerify = (*nBytesWaiting);
-			
-			W5500ReadData(pDev, W5500SckReg_RXRecvSize0, (eW5500Control_t)nControl, aBytes, 2);
-			(*nBytesWaiting) = aBytes[0] << 8;
-			(*nBytesWaiting) |= aBytes[1];
-		}
 		
 		W5500ReadData(pDev, W5500SckReg_DestIPAddr0, (eW5500Control_t)nControl, aBytes, 4);
 		pConnAddr->sin_addr.S_un.S_un_b.s_b1 = aBytes[0];
@@ -458,29 +735,21 @@ eW5500Return_t W5500SocketReceive(sW5500Obj_t *pDev, uint8_t nSocket, uint8_t *p
 	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_Register;
 	
-	//Find out how many bytes are available
-	nReadAddr = 0;
-	W5500ReadData(pDev, W5500SckReg_RXRecvSize0, (eW5500Control_t)nControl, aBytes, 2);
+	//Find out how many bytes are available and where they start, the registers
+	//are next to each other.  The count only grows while data arrives, so a read
+	//torn by new data can only come up short.  Anything left is read next time, 
+	//the part raises the receive interrupt again for it.
+	W5500ReadData(pDev, W5500SckReg_RXRecvSize0, (eW5500Control_t)nControl, aBytes, 4);
 	nAvail = aBytes[0] << 8;
 	nAvail |= aBytes[1];
-	while (nReadAddr != nAvail) { //Read till we get a match in case data is arriving
-		nReadAddr = nAvail;
-		
-		W5500ReadData(pDev, W5500SckReg_RXRecvSize0, (eW5500Control_t)nControl, aBytes, 2);
-		nAvail = aBytes[0] << 8;
-		nAvail |= aBytes[1];
-	}
+	nReadAddr = aBytes[2] << 8;
+	nReadAddr |= aBytes[3];
 	
 	if (nBuffSize > nAvail) { //Can't read more data than what is available
 		nBuffSize = nAvail;
 	}
 	
-	//Get the RX read address
-	W5500ReadData(pDev, W5500SckReg_RXReadPtr0, (eW5500Control_t)nControl, aBytes, 2);
-	nReadAddr = aBytes[0] << 8;
-	nReadAddr |= aBytes[1];
-	
-	//Read from the RX buffer at RX read address (up to RX write or 0xFFFF)
+	//Read from the RX buffer at RX read address, the part wraps it in the buffer
 	*pnBytesRead = nBuffSize;
 	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_RXBuffer;
@@ -502,130 +771,249 @@ eW5500Return_t W5500SocketReceive(sW5500Obj_t *pDev, uint8_t nSocket, uint8_t *p
 	return W5500_Success;
 }
 
-eW5500Return_t W5500SocketTCPSend(sW5500Obj_t *pDev, uint8_t nSocket, uint8_t *pBuff, uint16_t nBuffSize) {
+eW5500Return_t W5500SocketTXRoom(sW5500Obj_t *pDev, uint8_t nSocket, uint16_t *pnFree, uint16_t *pnWrite) {
 	uint8_t nControl;
-	uint8_t aBytes[4];
-	uint16_t nTXAddr, nAvail;
-	
-	if (nSocket >= W5500_NUMSOCKETS) {
-		return W5500Fail_InvalidSocket;
-	}
+	uint8_t aBytes[6];
+	uint16_t nTXRead;
 	
 	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_Register;
 	
-	//Find out how many bytes are available
-	W5500ReadData(pDev, W5500SckReg_TXFreeSize0, (eW5500Control_t)nControl, aBytes, 2);
-	nAvail = aBytes[0] << 8;
-	nAvail |= aBytes[1];
-	
-	if (nBuffSize > nAvail) { //Can't send more data than what is available
-		return W5500Fail_TXFreeSpace;
+	//Free size, read pointer, then write pointer
+	W5500ReadData(pDev, W5500SckReg_TXFreeSize0, (eW5500Control_t)nControl, aBytes, 6);
+	*pnFree = aBytes[0] << 8;
+	*pnFree |= aBytes[1];
+	nTXRead = aBytes[2] << 8;
+	nTXRead |= aBytes[3];
+	*pnWrite = aBytes[4] << 8;
+	*pnWrite |= aBytes[5];
+	
+	if (nTXRead != *pnWrite) { //Last send has not gone out yet
+		*pnFree = 0;
+		return W5500Warn_Partial;
 	}
 	
-	//Get the TX write address
-	W5500ReadData(pDev, W5500SckReg_TXWritePtr0, (eW5500Control_t)nControl, aBytes, 2);
-	nTXAddr = aBytes[0] << 8;
-	nTXAddr |= aBytes[1];
+	return W5500_Success;
+}
+
+eW5500Return_t W5500SocketTCPSend(sW5500Obj_t *pDev, uint8_t nSocket, uint8_t *pBuff, uint16_t nBuffSize) {
+	eW5500Return_t eResult;
+	uint16_t nSent;
 	
-	//Read from the RX buffer at RX read address (up to RX write or 0xFFFF)
-	nControl = nSocket << W5500BSB_SocketLShift;
-	nControl |= W5500BSB_TXBuffer;
-	W5500WriteData(pDev, nTXAddr, (eW5500Control_t)nControl, pBuff, nBuffSize);
+	if (nSocket >= W5500_NUMSOCKETS) {
+		return W5500Fail_InvalidSocket;
+	}
 	
-	//Update RX Read address with where we've read to
-	nControl = nSocket << W5500BSB_SocketLShift;
-	nControl |= W5500BSB_Register;
+	if (nBuffSize > ((uint32_t)pDev->aTXBuffKB[nSocket]) * 1024) { //Could never fit
+		return W5500Fail_TXFreeSpace;
+	}
 	
-	nTXAddr += nBuffSize;
-	aBytes[0] = nTXAddr >> 8;
-	aBytes[1] = nTXAddr & 0xFF;
-	W5500WriteData(pDev, W5500SckReg_TXWritePtr0, (eW5500Control_t)nControl, aBytes, 2);
+	eResult = W5500SocketTCPSendPart(pDev, nSocket, pBuff, nBuffSize, &nSent);
 	
-	//Issue RECV command to take receipt of the data
-	aBytes[0] = W5500SckCmd_Send;
-	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, aBytes, 1);
+	if ((eResult == W5500Warn_Partial) && (nSent == 0)) { //Nothing taken, as it was before
+		return W5500Fail_TXFreeSpace;
+	}
 	
-	return W5500_Success;
+	return eResult;
 }
 
-eW5500Return_t W5500SocketUDPSend(sW5500Obj_t *pDev, uint8_t nSocket, IN_ADDR *pAddr, uint16_t nPort, uint8_t *pBuff, uint16_t nBuffSize) {
-	uint8_t nControl;
-	uint8_t aBytes[4];
+eW5500Return_t W5500SocketTCPSendPart(sW5500Obj_t *pDev, uint8_t nSocket, const uint8_t *pBuff, uint16_t nBuffSize, uint16_t *pnSent) {
 	uint16_t nTXAddr, nAvail;
 	
+	*pnSent = 0;
+	
 	if (nSocket >= W5500_NUMSOCKETS) {
 		return W5500Fail_InvalidSocket;
 	}
 	
-	nControl = nSocket << W5500BSB_SocketLShift;
-	nControl |= W5500BSB_Register;
-	
-	//Setup the IP and port to send to
-	aBytes[0] = pAddr->S_un.S_un_b.s_b1;
-	aBytes[1] = pAddr->S_un.S_un_b.s_b2;
-	aBytes[2] = pAddr->S_un.S_un_b.s_b3;
-	aBytes[3] = pAddr->S_un.S_un_b.s_b4;
-	W5500WriteData(pDev, W5500SckReg_DestIPAddr0, (eW5500Control_t)nControl, aBytes, 4);
-	
-	aBytes[0] = nPort >> 8;
-	aBytes[1] = nPort & 0xFF;;
-	W5500WriteData(pDev, W5500SckReg_DestPort0, (eW5500Control_t)nControl, aBytes, 2);
+	W5500SocketTXRoom(pDev, nSocket, &nAvail, &nTXAddr);
 	
-	//Find out how many bytes are available
-	W5500ReadData(pDev, W5500SckReg_TXFreeSize0, (eW5500Control_t)nControl, aBytes, 2);
-	nAvail = aBytes[0] << 8;
-	nAvail |= aBytes[1];
+	if (nBuffSize <= nAvail) {
+		W5500SocketTXWrite(pDev, nSocket, nTXAddr, pBuff, nBuffSize);
+		*pnSent = nBuffSize;
+		
+		return W5500_Success;
+	}
 	
-	if (nBuffSize > nAvail) { //Can't send more data than what is available
-		return W5500Fail_TXFreeSpace;
+	//Take what fits, the rest goes next time
+	if (nAvail > 0) {
+		W5500SocketTXWrite(pDev, nSocket, nTXAddr, pBuff, nAvail);
+		*pnSent = nAvail;
 	}
 	
-	//Get the TX write address
-	W5500ReadData(pDev, W5500SckReg_TXWritePtr0, (eW5500Control_t)nControl, aBytes, 2);
-	nTXAddr = aBytes[0] << 8;
-	nTXAddr |= aBytes[1];
+	return W5500Warn_Partial;
+}
+
+void W5500SocketTXWrite(sW5500Obj_t *pDev, uint8_t nSocket, uint16_t nTXAddr, const uint8_t *pBuff, uint16_t nBytes) {
+	uint8_t nControl;
+	uint8_t aBytes[2];
 	
-	//Read from the RX buffer at RX read address (up to RX write or 0xFFFF)
+	//Write to the TX buffer at the TX write address, the part wraps it in the buffer
 	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_TXBuffer;
-	W5500WriteData(pDev, nTXAddr, (eW5500Control_t)nControl, pBuff, nBuffSize);
+	W5500WriteData(pDev, nTXAddr, (eW5500Control_t)nControl, pBuff, nBytes);
 	
-	//Update RX Read address with where we've read to
+	//Update TX write address with what was written
 	nControl = nSocket << W5500BSB_SocketLShift;
 	nControl |= W5500BSB_Register;
 	
-	nTXAddr += nBuffSize;
+	nTXAddr += nBytes;
 	aBytes[0] = nTXAddr >> 8;
 	aBytes[1] = nTXAddr & 0xFF;
 	W5500WriteData(pDev, W5500SckReg_TXWritePtr0, (eW5500Control_t)nControl, aBytes, 2);
 	
-	//Issue RECV command to take receipt of the data
+	//Issue SEND command to transmit it
 	aBytes[0] = W5500SckCmd_Send;
 	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, aBytes, 1);
-	
-	return W5500_Success;
 }
 
-eW5500Return_t W5500CloseSocket(sW5500Obj_t *pDev, uint8_t nSocket) {
-	uint8_t nSetting, nControl;
+void W5500SendCursorInit(sW5500SendCursor_t *pCursor, const void *pData, uint32_t nBytes) {
+	pCursor->pData = (const uint8_t *)pData;
+	pCursor->nBytes = nBytes;
+	pCursor->nSent = 0;
+	pCursor->bSending = false;
+}
+
+eW5500Return_t W5500SocketTCPSendContinue(sW5500Obj_t *pDev, uint8_t nSocket, sW5500SendCursor_t *pCursor) {
+	eW5500Return_t eResult;
+	uint32_t nLeft;
+	uint16_t nTXAddr, nAvail;
 	
 	if (nSocket >= W5500_NUMSOCKETS) {
 		return W5500Fail_InvalidSocket;
 	}
 	
-	nControl = nSocket << W5500BSB_SocketLShift;
-	
+	nLeft = pCursor->nBytes - pCursor->nSent;
+	if (nLeft == 0) {
+		return W5500_Success;
+	}
+	
+	eResult = W5500SocketTXRoom(pDev, nSocket, &nAvail, &nTXAddr);
+	pCursor->bSending = (eResult == W5500Warn_Partial);
+	
+	if (nAvail == 0) {
+		return W5500Warn_Partial;
+	}
+	
+	if (nLeft > nAvail) {
+		nLeft = nAvail;
+	}
+	
+	W5500SocketTXWrite(pDev, nSocket, nTXAddr, &(pCursor->pData[pCursor->nSent]), (uint16_t)nLeft);
+	pCursor->nSent += nLeft;
+	pCursor->bSending = true;
+	
+	if (pCursor->nSent < pCursor->nBytes) {
+		return W5500Warn_Partial;
+	}
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500SocketTCPSendV(sW5500Obj_t *pDev, uint8_t nSocket, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	uint8_t nControl;
+	uint8_t aBytes[4];
+	uint16_t nTXAddr, nAvail;
+	uint32_t nVec, nTotal;
+	
+	if (nSocket >= W5500_NUMSOCKETS) {
+		return W5500Fail_InvalidSocket;
+	}
+	
+	nTotal = 0;
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		nTotal += pVecs[nVec].nBytes;
+	}
+	
+	//Find out how many bytes are available and where they go
+	W5500SocketTXRoom(pDev, nSocket, &nAvail, &nTXAddr);
+	
+	if (nTotal > nAvail) { //All of the pieces must fit to go out in one send
+		return W5500Fail_TXFreeSpace;
+	}
+	
+	//Write each piece into the TX buffer right behind the last one
+	nControl = nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_TXBuffer;
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		W5500WriteData(pDev, nTXAddr, (eW5500Control_t)nControl, (uint8_t *)pVecs[nVec].pData, pVecs[nVec].nBytes);
+		nTXAddr += pVecs[nVec].nBytes;
+	}
+	
+	//Update TX write address once for everything written
+	nControl = nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	
+	aBytes[0] = nTXAddr >> 8;
+	aBytes[1] = nTXAddr & 0xFF;
+	W5500WriteData(pDev, W5500SckReg_TXWritePtr0, (eW5500Control_t)nControl, aBytes, 2);
+	
+	//Issue SEND command to transmit all of it
+	aBytes[0] = W5500SckCmd_Send;
+	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, aBytes, 1);
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500SocketUDPSend(sW5500Obj_t *pDev, uint8_t nSocket, IN_ADDR *pAddr, uint16_t nPort, uint8_t *pBuff, uint16_t nBuffSize) {
+	uint8_t nControl;
+	uint8_t aBytes[4];
+	uint16_t nTXAddr, nAvail;
+	
+	if (nSocket >= W5500_NUMSOCKETS) {
+		return W5500Fail_InvalidSocket;
+	}
+	
+	//Find out how many bytes are available, the destination can't change mid send
+	W5500SocketTXRoom(pDev, nSocket, &nAvail, &nTXAddr);
+	
+	if (nBuffSize > nAvail) { //Can't send more data than what is available
+		return W5500Fail_TXFreeSpace;
+	}
+	
+	nControl = nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	
+	//Setup the IP and port to send to
+	aBytes[0] = pAddr->S_un.S_un_b.s_b1;
+	aBytes[1] = pAddr->S_un.S_un_b.s_b2;
+	aBytes[2] = pAddr->S_un.S_un_b.s_b3;
+	aBytes[3] = pAddr->S_un.S_un_b.s_b4;
+	W5500WriteData(pDev, W5500SckReg_DestIPAddr0, (eW5500Control_t)nControl, aBytes, 4);
+	
+	aBytes[0] = nPort >> 8;
+	aBytes[1] = nPort & 0xFF;
+	W5500WriteData(pDev, W5500SckReg_DestPort0, (eW5500Control_t)nControl, aBytes, 2);
+	
+	//Write the datagram and send it
+	W5500SocketTXWrite(pDev, nSocket, nTXAddr, pBuff, nBuffSize);
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500CloseSocket(sW5500Obj_t *pDev, uint8_t nSocket) {
+	uint8_t nSetting, nControl;
+	
+	if (nSocket >= W5500_NUMSOCKETS) {
+		return W5500Fail_InvalidSocket;
+	}
+	
+	nControl = nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	
 	nSetting = W5500SckCmd_Close; //Command it to close down any connections
 	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, &nSetting, 1);
 	
+	pDev->nSckUsed &= ~(1 << nSocket);
+	pDev->aSckFlags[nSocket] = 0;
+	
 	return W5500_Success;
 }
 
-eW5500Return_t W5500ReadData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, uint8_t *pBuff, uint8_t nBytes) {
+eW5500Return_t W5500ReadData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, uint8_t *pBuff, uint16_t nBytes) {
 	sGPIOIface_t *pGPIO = pDev->pGPIO;
 	sSPIIface_t *pSPI = pDev->pSPI;
-	uint8_t nSend[3], nCtr;
+	uint8_t nSend[3];
 	
 	nSend[0] = nAddress >> 8;
 	nSend[1] = nAddress & 0x00FF;
@@ -653,15 +1041,9 @@ eW5500Return_t W5500ReadData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control
 	pGPIO->pfDigitalWriteByPin(pGPIO, pDev->nChipSelectPin, false);
 	pSPI->pfBeginTransfer(pSPI);
 	
-	//Send the address and control
-	for (nCtr = 0; nCtr < 3; nCtr++) {
-		pSPI->pfTransferByte(pSPI, nSend[nCtr], &(pBuff[0]));
-	}
-	
-	//Read out the data
-	for (nCtr = 0; nCtr < nBytes; nCtr++) {
-		pSPI->pfTransferByte(pSPI, 0xFF, &(pBuff[nCtr]));
-	}
+	//Send the address and control, then read out the data
+	pSPI->pfTransferBlock(pSPI, nSend, NULL, 3);
+	pSPI->pfTransferBlock(pSPI, NULL, pBuff, nBytes);
 	
 	//End SPI transaction
 	pSPI->pfEndTransfer(pSPI);
@@ -670,10 +1052,10 @@ eW5500Return_t W5500ReadData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control
 	return W5500_Success;
 }
 
-eW5500Return_t W5500WriteData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, const uint8_t *pBuff, uint8_t nBytes) {
+eW5500Return_t W5500WriteData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Control_t eControl, const uint8_t *pBuff, uint16_t nBytes) {
 	sGPIOIface_t *pGPIO = pDev->pGPIO;
 	sSPIIface_t *pSPI = pDev->pSPI;
-	uint8_t nSend[3], nRecv, nCtr;
+	uint8_t nSend[3];
 	
 	nSend[0] = nAddress >> 8;
 	nSend[1] = nAddress & 0x00FF;
@@ -701,15 +1083,9 @@ eW5500Return_t W5500WriteData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Contro
 	pGPIO->pfDigitalWriteByPin(pGPIO, pDev->nChipSelectPin, false);
 	pSPI->pfBeginTransfer(pSPI);
 
-	//Send the address and control
-	for (nCtr = 0; nCtr < 3; nCtr++) {
-		pSPI->pfTransferByte(pSPI, nSend[nCtr], &nRecv);
-	}
-	
-	//Write out the data
-	for (nCtr = 0; nCtr < nBytes; nCtr++) {
-		pSPI->pfTransferByte(pSPI, pBuff[nCtr], &nRecv);
-	}
+	//Send the address and control, then write out the data
+	pSPI->pfTransferBlock(pSPI, nSend, NULL, 3);
+	pSPI->pfTransferBlock(pSPI, pBuff, NULL, nBytes);
 
 	//End SPI transaction
 	pSPI->pfEndTransfer(pSPI);
@@ -719,16 +1095,268 @@ eW5500Return_t W5500WriteData(sW5500Obj_t *pDev, uint16_t nAddress, eW5500Contro
 	return W5500_Success;
 }
 
-eW5500Return_t W5500CreateTCPServer(sW5500Obj_t *pDev, sTCPServ_t *pTCPServ) {
+eW5500Return_t W5500EventInitialize(sW5500Obj_t *pDev, uint8_t nIntPin) {
+	eGPIOReturn_t eResult;
+	uint8_t nCtr, nMask;
+	
+	pDev->nIntPin = nIntPin;
+	
+	//Hook the interrupt before the part is allowed to assert it
+	pDev->pGPIO->pfSetModeByPin(pDev->pGPIO, nIntPin, GPIO_DigitalInput);
+	eResult = pDev->pGPIO->pfSetInterrupt(pDev->pGPIO, nIntPin, &W5500EventIntHandler, true, pDev);
+	if (eResult != GPIO_Success) {
+		return W5500Fail_NoInterrupt;
+	}
+	
+	pDev->bEvents = true;
+	
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		pDev->aSckFlags[nCtr] = 0;
+		W5500EventSetMask(pDev, nCtr);
+	}
+	
+	nMask = 0xFF; //Every socket can assert INTn
+	W5500WriteData(pDev, W5500CmnReg_SockIntMask, W5500BSB_CommonRegister, &nMask, 1);
+	
+	//INTn may have fallen before the handler was hooked, look once to be sure
+	pDev->bIntPending = true;
+	
+	return W5500_Success;
+}
+
+eW5500Return_t W5500EventSetHandlers(sW5500Obj_t *pDev, uint8_t nSocket, const sW5500SckEvents_t *pEvents) {
+	sW5500SckEvents_t *pSckEvents;
+	
+	if (nSocket >= W5500_NUMSOCKETS) {
+		return W5500Fail_InvalidSocket;
+	}
+	
+	pSckEvents = &(pDev->aSckEvents[nSocket]);
+	
+	if (pEvents != NULL) {
+		*pSckEvents = *pEvents;
+	} else {
+		pSckEvents->pfConnect = NULL;
+		pSckEvents->pfReceive = NULL;
+		pSckEvents->pfSendOK = NULL;
+		pSckEvents->pfDisconnect = NULL;
+		pSckEvents->pParam = NULL;
+	}
+	
+	if (pDev->bEvents == true) {
+		W5500EventSetMask(pDev, nSocket);
+	}
+	
+	return W5500_Success;
+}
+
+bool W5500EventPending(sW5500Obj_t *pDev) {
+	return pDev->bIntPending;
+}
+
+eW5500Return_t W5500EventService(sW5500Obj_t *pDev) {
+	sW5500SckEvents_t *pEvents;
+	uint8_t nSockInt, nFlags, nSck, nControl;
+	bool bIntHigh;
+	
+	if (pDev->bIntPending == false) { //INTn has not signalled, nothing to read
+		return W5500_Success;
+	}
+	
+	do {
+		//Clear first, an interrupt during the service will then get another look
+		pDev->bIntPending = false;
+		
+		//One read finds every socket with flags raised
+		W5500ReadData(pDev, W5500CmnReg_SockInt, W5500BSB_CommonRegister, &nSockInt, 1);
+		
+		for (nSck = 0; nSck < W5500_NUMSOCKETS; nSck++) {
+			if ((nSockInt & (1 << nSck)) != 0) {
+				nControl = nSck << W5500BSB_SocketLShift;
+				nControl |= W5500BSB_Register;
+				
+				//Clear just the flags read, any raised since will hold INTn low
+				W5500ReadData(pDev, W5500SckReg_Interrupt, (eW5500Control_t)nControl, &nFlags, 1);
+				W5500WriteData(pDev, W5500SckReg_Interrupt, (eW5500Control_t)nControl, &nFlags, 1);
+				
+				pDev->aSckFlags[nSck] |= nFlags;
+				pEvents = &(pDev->aSckEvents[nSck]);
+				
+				if ((CheckAllBitsInMask(nFlags, W5500SckInt_Connect) == true) && (pEvents->pfConnect != NULL)) {
+					pEvents->pfConnect(pDev, nSck, pEvents->pParam);
+				}
+				
+				if ((CheckAllBitsInMask(nFlags, W5500SckInt_Recv) == true) && (pEvents->pfReceive != NULL)) {
+					pEvents->pfReceive(pDev, nSck, pEvents->pParam);
+				}
+				
+				if ((CheckAllBitsInMask(nFlags, W5500SckInt_SendOK) == true) && (pEvents->pfSendOK != NULL)) {
+					pEvents->pfSendOK(pDev, nSck, pEvents->pParam);
+				}
+				
+				if (((nFlags & (W5500SckInt_Disconnect | W5500SckInt_Timeout)) != 0) && (pEvents->pfDisconnect != NULL)) {
+					pEvents->pfDisconnect(pDev, nSck, pEvents->pParam);
+				}
+			}
+		}
+		
+		//Flags raised during the handlers keep INTn low without a new edge
+		bIntHigh = true;
+		pDev->pGPIO->pfDigitalReadByPin(pDev->pGPIO, pDev->nIntPin, &bIntHigh);
+	} while ((bIntHigh == false) && (nSockInt != 0));
+	
+	return W5500_Success;
+}
+
+void W5500EventIntHandler(sGPIOIface_t *pIface, GPIOID_t nPin, void *pParam) {
+	sW5500Obj_t *pDev = (sW5500Obj_t *)pParam;
+	bool bIntHigh = false;
+	
+	//Pins that interrupt on both edges also report INTn being released
+	pIface->pfDigitalReadByPin(pIface, nPin, &bIntHigh);
+	if (bIntHigh == false) {
+		pDev->bIntPending = true;
+	}
+}
+
+uint8_t W5500EventWait(sW5500Obj_t *pDev, uint8_t nSckMask, uint8_t nIntMask) {
+	uint8_t nSck, nSeen;
+	
+	nSeen = 0;
+	while (nSeen == 0) {
+		for (nSck = 0; nSck < W5500_NUMSOCKETS; nSck++) {
+			if (((nSckMask & (1 << nSck)) != 0) && ((pDev->aSckFlags[nSck] & nIntMask) != 0)) {
+				nSeen |= 1 << nSck;
+				pDev->aSckFlags[nSck] &= ~nIntMask;
+			}
+		}
+		
+		if (nSeen == 0) {
+			while (pDev->bIntPending == false) {
+				//Nothing to do until INTn falls
+			}
+			
+			W5500EventService(pDev);
+		}
+	}
+	
+	return nSeen;
+}
+
+void W5500EventSetMask(sW5500Obj_t *pDev, uint8_t nSocket) {
+	uint8_t nMask, nControl;
+	
+	nControl = nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	
+	//Send ok comes with every send, only take it if someone wants it
+	nMask = W5500SckInt_EventMask;
+	if (pDev->aSckEvents[nSocket].pfSendOK != NULL) {
+		nMask |= W5500SckInt_SendOK;
+	}
+	
+	W5500WriteData(pDev, W5500SckReg_IntMask, (eW5500Control_t)nControl, &nMask, 1);
+}
+
+eNetReturn_t W5500NetTCPSendAll(sW5500Obj_t *pDev, uint8_t nSocket, const uint8_t *pData, uint32_t nBytes) {
+	eW5500Return_t eResult;
+	eNetReturn_t eNetResult;
+	sW5500SendCursor_t Cursor;
+	uint8_t nControl, nState;
+	
+	nControl = nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	
+	if (pDev->bEvents == true) { //Send ok is only unmasked for its handler, wake on it while streaming
+		nState = W5500SckInt_EventMask | W5500SckInt_SendOK;
+		W5500WriteData(pDev, W5500SckReg_IntMask, (eW5500Control_t)nControl, &nState, 1);
+	}
+	
+	W5500SendCursorInit(&Cursor, pData, nBytes);
+	eNetResult = Net_Success;
+	
+	do {
+		//Make sure the connection is still there before each piece
+		W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &nState, 1);
+		if (nState != W5500SckStat_Establish) {
+			eNetResult = NetFail_SocketState;
+			break;
+		}
+		
+		eResult = W5500SocketTCPSendContinue(pDev, nSocket, &Cursor);
+		if (eResult < W5500_Success) {
+			eNetResult = NetFail_Unknown;
+			break;
+		}
+		
+		if ((eResult == W5500Warn_Partial) && (Cursor.bSending == true) && (pDev->bEvents == true)) {
+			//Sleep on INTn until the piece in flight goes out
+			W5500EventWait(pDev, 1 << nSocket, W5500SckInt_SendOK | W5500SckInt_Disconnect | W5500SckInt_Timeout);
+		}
+	} while (eResult == W5500Warn_Partial);
+	
+	if (pDev->bEvents == true) {
+		W5500EventSetMask(pDev, nSocket);
+	}
+	
+	return eNetResult;
+}
+
+eNetReturn_t W5500NetWaitData(sW5500Obj_t *pDev, uint8_t nSocket, eW5500SckStat_t eOpenState, uint16_t *pnAvail) {
+	eW5500Return_t eResult;
+	eW5500SckProt_t eProt;
+	eW5500SckStat_t eState;
+	SOCKADDR_IN ConnAddr;
+	
+	//Wait for data to arrive or the socket to close
+	*pnAvail = 0;
+	eState = eOpenState;
+	while ((eState == eOpenState) && (*pnAvail == 0)) {
+		eResult = W5500SocketStatus(pDev, nSocket, &eProt, &eState, pnAvail, &ConnAddr, sizeof(SOCKADDR_IN));
+		
+		if (eResult != W5500_Success) { //failed to get socket information
+			return NetFail_Unknown;
+		}
+		
+		if ((eState == eOpenState) && (*pnAvail == 0) && (pDev->bEvents == true)) {
+			//Sleep on INTn until something arrives rather than reading the status again
+			W5500EventWait(pDev, 1 << nSocket, W5500SckInt_Recv | W5500SckInt_Disconnect | W5500SckInt_Timeout);
+		}
+	}
+	
+	if (eState != eOpenState) {
+		return NetFail_SocketState;
+	}
+	
+	return Net_Success;
+}
+
+eW5500Return_t W5500CreateTCPServer(sW5500Obj_t *pDev, sTCPServ_t *pTCPServ, sW5500IfaceInfo_t *pInfo, uint8_t nBuffKB, uint8_t nListenCnt) {
+	uint8_t nCtr;
+	
 	//Start with a clean structure
 	IfaceTCPServObjInitialize(pTCPServ);
 	
+	if (nListenCnt == 0) {
+		nListenCnt = 1;
+	} else if (nListenCnt > W5500_NUMSOCKETS) {
+		nListenCnt = W5500_NUMSOCKETS;
+	}
+	
+	pInfo->pDev = pDev;
+	pInfo->nBuffKB = nBuffKB;
+	pInfo->nListenCnt = nListenCnt;
+	pInfo->bConnected = false;
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		pInfo->aListen[nCtr] = W5500_NOSOCKET;
+	}
+	
 	//Fill in structure variables
 	pTCPServ->eCapabilities = W5500_TCPSERVCAPS;
 	pTCPServ->HostSck.nSocket = SOCKET_INVALID;
 	pTCPServ->HostSck.Conn.Port = 0;
 	pTCPServ->HostSck.Conn.Addr.nNetLong = 0;
-	pTCPServ->pHWInfo = (void *)pDev;
+	pTCPServ->pHWInfo = (void *)pInfo;
 	
 	//Fill in function pointers
 	pTCPServ->pfBind = &W5500NetTCPServBind;
@@ -737,44 +1365,83 @@ eW5500Return_t W5500CreateTCPServer(sW5500Obj_t *pDev, sTCPServ_t *pTCPServ) {
 	pTCPServ->pfCloseSocket = &W5500NetTCPServCloseSocket;
 	pTCPServ->pfReceive = &W5500NetTCPServReceive;
 	pTCPServ->pfSend = &W5500NetTCPServSend;
+	pTCPServ->pfSendV = &W5500NetTCPServSendV;
 	
 	return W5500_Success;
 }
 
-eNetReturn_t W5500NetTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn) {
+uint8_t W5500NetTCPServArm(sTCPServ_t *pTCPServ) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
 	eW5500Return_t eResult;
-	sW5500Obj_t * pDev = (sW5500Obj_t *)pTCPServ->pHWInfo;
+	uint8_t nCtr, nSck, nListening;
+	
+	nListening = 0;
+	pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+	
+	for (nCtr = 0; nCtr < pInfo->nListenCnt; nCtr++) {
+		if (pInfo->aListen[nCtr] == W5500_NOSOCKET) {
+			eResult = W5500SocketListen(pInfo->pDev, &nSck, pTCPServ->HostSck.Conn.Port, IPPROTO_TCP, pInfo->nBuffKB);
+			
+			if (eResult == W5500_Success) {
+				pInfo->aListen[nCtr] = nSck;
+			}
+		}
+		
+		if (pInfo->aListen[nCtr] != W5500_NOSOCKET) {
+			nListening |= 1 << pInfo->aListen[nCtr];
+			
+			if (pTCPServ->HostSck.nSocket == SOCKET_INVALID) {
+				pTCPServ->HostSck.nSocket = pInfo->aListen[nCtr];
+			}
+		}
+	}
+	
+	return nListening;
+}
+
+eNetReturn_t W5500NetTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
 	IN_ADDR IPAddr;
-	uint8_t nSck;
 	
-	W5500ReadIPAddress(pDev, &IPAddr);
+	if (pTCPServ->HostSck.Conn.Port != 0) { //Already bound
+		return NetFail_BindErr;
+	}
 	
-	eResult = W5500SocketListen(pDev, &nSck, pConn->Port, IPPROTO_TCP);
-	pTCPServ->HostSck.nSocket = nSck;
+	W5500ReadIPAddress(pInfo->pDev, &IPAddr);
 	
-	if (eResult < W5500_Success) {
+	pTCPServ->HostSck.Conn.Port = pConn->Port;
+	pTCPServ->HostSck.Conn.Addr.nNetLong = IPAddr.S_un.S_addr;
+	
+	if (W5500NetTCPServArm(pTCPServ) == 0) { //Not a single socket to listen on
 		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
 		pTCPServ->HostSck.Conn.Port = 0;
 		pTCPServ->HostSck.Conn.Addr.nNetLong = 0;
 		
 		return NetFail_BindErr;
-	} else {
-		pTCPServ->HostSck.Conn.Port = pConn->Port;
-		pTCPServ->HostSck.Conn.Addr.nNetLong = IPAddr.S_un.S_addr;
-		
-		return Net_Success;
 	}
+	
+	return Net_Success;
 }
 
 eNetReturn_t W5500NetTCPServCloseHost(sTCPServ_t *pTCPServ) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
 	eW5500Return_t eResult;
-	sW5500Obj_t * pDev = (sW5500Obj_t *)pTCPServ->pHWInfo;
+	uint8_t nCtr;
 	
-	if (pTCPServ->HostSck.nSocket == SOCKET_INVALID) {
+	if (pTCPServ->HostSck.Conn.Port == 0) {
 		return NetFail_InvSocket;
 	}
 	
-	eResult = W5500CloseSocket(pDev, pTCPServ->HostSck.nSocket);
+	eResult = W5500_Success;
+	for (nCtr = 0; nCtr < pInfo->nListenCnt; nCtr++) {
+		if (pInfo->aListen[nCtr] != W5500_NOSOCKET) {
+			if (W5500CloseSocket(pInfo->pDev, pInfo->aListen[nCtr]) < W5500_Success) {
+				eResult = W5500Fail_Unknown;
+			}
+			
+			pInfo->aListen[nCtr] = W5500_NOSOCKET;
+		}
+	}
 	
 	pTCPServ->HostSck.nSocket = SOCKET_INVALID;
 	pTCPServ->HostSck.Conn.Port = 0;
@@ -788,13 +1455,13 @@ eNetReturn_t W5500NetTCPServCloseHost(sTCPServ_t *pTCPServ) {
 }
 
 eNetReturn_t W5500NetTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pClientSck) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
+	sW5500Obj_t *pDev = pInfo->pDev;
 	eW5500Return_t eResult;
-	sW5500Obj_t *pDev = (sW5500Obj_t *)pTCPServ->pHWInfo;
-	uint16_t nCount, nServPort;
-	uint32_t nIPAddr;
-	uint8_t nSck;
+	uint16_t nCount;
+	uint8_t nCtr, nSck, nControl, nState, nListening;
 	eW5500SckProt_t eProt;
-	eW5500SckStat_t eState, eLastState;
+	eW5500SckStat_t eState;
 	SOCKADDR_IN ConnAddr;
 	
 	//Clear socket info in case of failure
@@ -802,64 +1469,84 @@ eNetReturn_t W5500NetTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pClien
 	pClientSck->Conn.Port = 0;
 	pClientSck->Conn.Addr.nNetLong = 0;
 	
-	//Get port host is listening on
-	nServPort = pTCPServ->HostSck.Conn.Port;
-	nIPAddr = pTCPServ->HostSck.Conn.Addr.nNetLong;
+	if (pTCPServ->HostSck.Conn.Port == 0) { //Not bound
+		return NetFail_InvSocket;
+	}
 	
-	//Wait for a connection request
-	eState = W5500SckStat_Listen;
-	while (eState == W5500SckStat_Listen) {
-		eResult = W5500SocketStatus(pDev, pTCPServ->HostSck.nSocket, &eProt, &eState, &nCount, &ConnAddr, sizeof(SOCKADDR_IN));
-		
-		if (eResult != W5500_Success) { //failed to get socket information
-			return NetFail_Unknown;
+	//Wait for any of the listening sockets to take a connection
+	nSck = W5500_NOSOCKET;
+	while (nSck == W5500_NOSOCKET) {
+		//Replace any listeners given out or lost, then see what they are doing
+		nListening = W5500NetTCPServArm(pTCPServ);
+		if (nListening == 0) {
+			return NetFail_BindErr;
 		}
 		
-		if (eState != eLastState) {
-			eLastState = eState;
+		for (nCtr = 0; nCtr < pInfo->nListenCnt; nCtr++) {
+			if (pInfo->aListen[nCtr] == W5500_NOSOCKET) {
+				continue;
+			}
+			
+			nControl = pInfo->aListen[nCtr] << W5500BSB_SocketLShift;
+			nControl |= W5500BSB_Register;
+			W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &nState, 1);
 			
-			if (eLastState != W5500SckStat_Establish) {
+			if (nState == W5500SckStat_Establish) {
+				nSck = pInfo->aListen[nCtr];
+				pInfo->aListen[nCtr] = W5500_NOSOCKET;
+				break;
+			} else if ((nState != W5500SckStat_Listen) && (nState != W5500SckStat_SynRecv)) {
 				//Need to confirm a state change to avoid spurious read error
-				eState = W5500SckStat_Listen;
+				W5500ReadData(pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &nState, 1);
+				
+				if ((nState != W5500SckStat_Listen) && (nState != W5500SckStat_SynRecv) && (nState != W5500SckStat_Establish)) {
+					//The attempt failed, free the socket to listen again
+					W5500CloseSocket(pDev, pInfo->aListen[nCtr]);
+					pInfo->aListen[nCtr] = W5500_NOSOCKET;
+				}
 			}
 		}
+		
+		if ((nSck == W5500_NOSOCKET) && (pDev->bEvents == true)) {
+			//Nothing has happened, sleep on INTn rather than reading the status again
+			W5500EventWait(pDev, nListening, W5500SckInt_Connect | W5500SckInt_Disconnect | W5500SckInt_Timeout);
+		}
 	}
 	
-	if (eState != W5500SckStat_Establish) {
-		return NetFail_SocketState;
+	//Pull back the connection information
+	eResult = W5500SocketStatus(pDev, nSck, &eProt, &eState, &nCount, &ConnAddr, sizeof(SOCKADDR_IN));
+	if (eResult != W5500_Success) {
+		W5500CloseSocket(pDev, nSck);
+		return NetFail_Unknown;
 	}
 	
-	//Pull back the connection information
-	pClientSck->nSocket = pTCPServ->HostSck.nSocket;
+	pClientSck->nSocket = nSck;
 	pClientSck->Conn.Port = ConnAddr.sin_port;
 	pClientSck->Conn.Addr.nNetLong = ConnAddr.sin_addr.S_un.S_addr;
 	
-	//Start a new host socket listening
-	eResult = W5500SocketListen(pDev, &nSck, nServPort, IPPROTO_TCP);
-	pTCPServ->HostSck.nSocket = nSck;
-	pTCPServ->HostSck.Conn.Port = nServPort;
-	pTCPServ->HostSck.Conn.Addr.nNetLong = nIPAddr;
+	//Start a new socket listening in its place, the others kept listening meanwhile
+	W5500NetTCPServArm(pTCPServ);
 	
-	if (eResult < W5500_Success) {
-		return NetFail_BindErr;
-	} else {
-		return Net_Success;
-	}
+	return Net_Success;
 }
 
 eNetReturn_t W5500NetTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
 	eW5500Return_t eResult;
-	sW5500Obj_t * pDev = (sW5500Obj_t *)pTCPServ->pHWInfo;
 	
 	if (pSck->nSocket == SOCKET_INVALID) {
 		return NetFail_InvSocket;
 	}
 	
-	eResult = W5500CloseSocket(pDev, pSck->nSocket);
+	eResult = W5500CloseSocket(pInfo->pDev, pSck->nSocket);
 	pSck->nSocket = SOCKET_INVALID;
 	pSck->Conn.Port = 0;
 	pSck->Conn.Addr.nNetLong = 0;
 	
+	if (pTCPServ->HostSck.Conn.Port != 0) { //Server may have run out of sockets to listen on
+		W5500NetTCPServArm(pTCPServ);
+	}
+	
 	if (eResult < W5500_Success) {
 		return NetFail_Unknown;
 	} else {
@@ -868,33 +1555,25 @@ eNetReturn_t W5500NetTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
 }
 
 eNetReturn_t W5500NetTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
 	eW5500Return_t eResult;
-	sW5500Obj_t *pDev = (sW5500Obj_t *)pTCPServ->pHWInfo;
+	eNetReturn_t eNetResult;
 	uint16_t nCount;
-	eW5500SckProt_t eProt;
-	eW5500SckStat_t eState;
-	SOCKADDR_IN ConnAddr;
 	
 	//Set error return just in case
 	*pnBytesRecv = 0;
 	
-	//Wait for data to arrive or the socket to close
-	nCount = 0;
-	eState = W5500SckStat_Establish;
-	while ((eState == W5500SckStat_Establish) && (nCount == 0)) {
-		eResult = W5500SocketStatus(pDev, pClientSck->nSocket, &eProt, &eState, &nCount, &ConnAddr, sizeof(SOCKADDR_IN));
-		
-		if (eResult != W5500_Success) { //failed to get socket information
-			return NetFail_Unknown;
-		}
+	eNetResult = W5500NetWaitData(pInfo->pDev, pClientSck->nSocket, W5500SckStat_Establish, &nCount);
+	if (eNetResult != Net_Success) {
+		return eNetResult;
 	}
 	
-	if (eState != W5500SckStat_Establish) {
-		return NetFail_SocketState;
+	if (nDataBytes > 0xFFFF) { //The part can't hold more than this anyway
+		nDataBytes = 0xFFFF;
 	}
 	
 	//Receive the data waiting	
-	eResult = W5500SocketReceive(pDev, pClientSck->nSocket, (uint8_t *)pData, nDataBytes, &nCount);
+	eResult = W5500SocketReceive(pInfo->pDev, pClientSck->nSocket, (uint8_t *)pData, nDataBytes, &nCount);
 	*pnBytesRecv = nCount;
 	
 	if (eResult < W5500_Success) {
@@ -905,15 +1584,27 @@ eNetReturn_t W5500NetTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pClientSck,
 }
 
 eNetReturn_t W5500NetTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nDataBytes, void *pData) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
+	
+	if (pClientSck->nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
+	return W5500NetTCPSendAll(pInfo->pDev, pClientSck->nSocket, (const uint8_t *)pData, nDataBytes);
+}
+
+eNetReturn_t W5500NetTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPServ->pHWInfo;
 	eW5500Return_t eResult;
-	sW5500Obj_t *pDev = (sW5500Obj_t *)pTCPServ->pHWInfo;
+	eNetReturn_t eNetResult;
+	uint32_t nVec;
 	uint16_t nAvail;
 	eW5500SckProt_t eProt;
 	eW5500SckStat_t eState;
 	SOCKADDR_IN ConnAddr;
 	
 	//Make sure the socket is in a valid state
-	eResult = W5500SocketStatus(pDev, pClientSck->nSocket, &eProt, &eState, &nAvail, &ConnAddr, sizeof(SOCKADDR_IN));
+	eResult = W5500SocketStatus(pInfo->pDev, pClientSck->nSocket, &eProt, &eState, &nAvail, &ConnAddr, sizeof(SOCKADDR_IN));
 		
 	if (eResult != W5500_Success) { //failed to get socket information
 		return NetFail_Unknown;
@@ -921,68 +1612,154 @@ eNetReturn_t W5500NetTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, ui
 		return NetFail_SocketState;
 	}
 	
-	//Ship out the data
-	eResult = W5500SocketTCPSend(pDev, pClientSck->nSocket, (uint8_t *)pData, nDataBytes);
-	
-	if (eResult < W5500_Success) {
-		return NetFail_Unknown;
-	} else {
+	//Ship out all the pieces together
+	eResult = W5500SocketTCPSendV(pInfo->pDev, pClientSck->nSocket, nVecCnt, pVecs);
+	if (eResult == W5500_Success) {
 		return Net_Success;
+	} else if (eResult != W5500Fail_TXFreeSpace) {
+		return NetFail_Unknown;
+	}
+	
+	//No room for all of them at once, stream them out in order instead
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		eNetResult = W5500NetTCPSendAll(pInfo->pDev, pClientSck->nSocket, (const uint8_t *)pVecs[nVec].pData, pVecs[nVec].nBytes);
+		if (eNetResult != Net_Success) {
+			return eNetResult;
+		}
 	}
+	
+	return Net_Success;
 }
 
-eW5500Return_t W5500CreateTCPClient(sW5500Obj_t *pDev, sTCPClient_t *pTCPClient) {
+eW5500Return_t W5500CreateTCPClient(sW5500Obj_t *pDev, sTCPClient_t *pTCPClient, sW5500IfaceInfo_t *pInfo, uint8_t nBuffKB) {
+	uint8_t nCtr;
+	
 	//Start with sane structure
 	IfaceTCPClientObjInitialize(pTCPClient);
-
+	
+	pInfo->pDev = pDev;
+	pInfo->nBuffKB = nBuffKB;
+	pInfo->nListenCnt = 0;
+	pInfo->bConnected = false;
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		pInfo->aListen[nCtr] = W5500_NOSOCKET;
+	}
+	
 	//Fill out the structure variables
 	pTCPClient->Sck.nSocket = SOCKET_INVALID;
 	pTCPClient->Sck.Conn.Port = 0;
 	pTCPClient->Sck.Conn.Addr.nNetLong = 0;
-	pTCPClient->pHWInfo = (void *)pDev;
+	pTCPClient->pHWInfo = (void *)pInfo;
 	pTCPClient->eCapabilities = W5500_TCPCLIENTCAPS;
-
+	
 	//Fill out function pointers
 	pTCPClient->pfConnect = &W5500NetTCPClientConnect;
+	pTCPClient->pfConnectStart = &W5500NetTCPClientConnectStart;
+	pTCPClient->pfConnectCheck = &W5500NetTCPClientConnectCheck;
 	pTCPClient->pfClose = &W5500NetTCPClientClose;
 	pTCPClient->pfReceive = &W5500NetTCPClientReceive;
 	pTCPClient->pfSend = &W5500NetTCPClientSend;
+	pTCPClient->pfSendV = &W5500NetTCPClientSendV;
 	
 	return W5500_Success;
 }
 
 eNetReturn_t W5500NetTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
-	sW5500Obj_t *pDev = (sW5500Obj_t *)pTCPClient->pHWInfo;
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
+	eNetReturn_t eResult;
+	
+	eResult = W5500NetTCPClientConnectStart(pTCPClient, pConn);
+	
+	while (eResult == NetWarn_InProgress) {
+		if (pInfo->pDev->bEvents == true) {
+			//Sleep on INTn until the connection is made or fails
+			W5500EventWait(pInfo->pDev, 1 << pTCPClient->Sck.nSocket, W5500SckInt_Connect | W5500SckInt_Disconnect | W5500SckInt_Timeout);
+		}
+		
+		eResult = W5500NetTCPClientConnectCheck(pTCPClient);
+	}
+	
+	return eResult;
+}
+
+eNetReturn_t W5500NetTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
 	eW5500Return_t eResult;
 	IN_ADDR IPServ;
 	uint8_t nSck;
 	
+	if (pTCPClient->Sck.nSocket != SOCKET_INVALID) { //Drop any earlier connection
+		W5500NetTCPClientClose(pTCPClient);
+	}
+	
 	IPServ.S_un.S_addr = pConn->Addr.nNetLong;
 	
-	eResult = W5500SocketConnect(pDev, &nSck, &IPServ, pConn->Port);
+	eResult = W5500SocketConnect(pInfo->pDev, &nSck, &IPServ, pConn->Port, pInfo->nBuffKB);
 	
-	if (eResult == W5500_Success) {
-		pTCPClient->Sck.Conn.Port = pConn->Port;
-		pTCPClient->Sck.Addr.nNetLong = pConn->Addr.nNetLong;
-		pTCPClient->Sck.nSocket = nSck;
-		return Net_Success;
-	} else {
+	if (eResult != W5500_Success) {
 		return NetFail_Unknown;
 	}
+	
+	pTCPClient->Sck.Conn.Port = pConn->Port;
+	pTCPClient->Sck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+	pTCPClient->Sck.nSocket = nSck;
+	pInfo->bConnected = false;
+	
+	return NetWarn_InProgress;
 }
+
+eNetReturn_t W5500NetTCPClientConnectCheck(sTCPClient_t *pTCPClient) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
+	uint8_t nControl, nState;
+	
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
 	
+	nControl = pTCPClient->Sck.nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	W5500ReadData(pInfo->pDev, W5500SckReg_Status, (eW5500Control_t)nControl, &nState, 1);
+	
+	switch (nState) {
+		case W5500SckStat_Establish:
+			pInfo->bConnected = true;
+			return Net_Success;
+			
+		case W5500SckStat_Init:
+		case W5500SckStat_SynSent:
+			if (pInfo->bConnected == false) {
+				return NetWarn_InProgress;
+			}
+			break;
+			
+		default:
+			break;
+	}
+	
+	//Anything else means the connection is gone or never came up
+	if (pInfo->bConnected == false) {
+		W5500NetTCPClientClose(pTCPClient);
+		return NetFail_ConnRefuse;
+	} else if (nState == W5500SckStat_Closed) {
+		W5500NetTCPClientClose(pTCPClient);
+	}
+	
+	return NetFail_SocketState;
+}
+
 eNetReturn_t W5500NetTCPClientClose(sTCPClient_t *pTCPClient) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
 	eW5500Return_t eResult;
-	sW5500Obj_t * pDev = (sW5500Obj_t *)pTCPClient->pHWInfo;
 	
 	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
 		return NetFail_InvSocket;
 	}
 	
-	eResult = W5500CloseSocket(pDev, pTCPClient->Sck.nSocket);
+	eResult = W5500CloseSocket(pInfo->pDev, pTCPClient->Sck.nSocket);
 	pTCPClient->Sck.nSocket = SOCKET_INVALID;
 	pTCPClient->Sck.Conn.Port = 0;
 	pTCPClient->Sck.Conn.Addr.nNetLong = 0;
+	pInfo->bConnected = false;
 	
 	if (eResult != W5500_Success) {
 		return NetFail_Unknown;
@@ -990,45 +1767,65 @@ eNetReturn_t W5500NetTCPClientClose(sTCPClient_t *pTCPClient) {
 		return Net_Success;
 	}
 }
-	
+
 eNetReturn_t W5500NetTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
-	sW5500Obj_t *pDev = (sW5500Obj_t *)pTCPClient->pHWInfo;
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
 	eW5500Return_t eResult;
+	eNetReturn_t eNetResult;
 	uint16_t nAvail;
-	eW5500SckProt_t eProt;
-	eW5500SckStat_t eState;
-	SOCKADDR_IN ConnAddr;
 	
 	(*pnBytesRecv) = 0;
 	
-	//Make sure the socket is in a valid state
-	eResult = W5500SocketStatus(pDev, pTCPClient->Sck.nSocket, &eProt, &eState, &nAvail, &ConnAddr, sizeof(SOCKADDR_IN));
-		
-	if (eResult != W5500_Success) { //failed to get socket information
-		return NetFail_Unknown;
-	} else if (eState != W5500SckStat_Establish) {
-		return NetFail_SocketState;
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
+	eNetResult = W5500NetWaitData(pInfo->pDev, pTCPClient->Sck.nSocket, W5500SckStat_Establish, &nAvail);
+	if (eNetResult != Net_Success) {
+		return eNetResult;
+	}
+	
+	if (nDataBytes > 0xFFFF) { //The part can't hold more than this anyway
+		nDataBytes = 0xFFFF;
 	}
 	
 	//Socket looks good, accept out the data
-	eResult = W5500SocketReceive(pDev, pTCPClient->Sck.nSocket, pData, nDataBytes, pnBytesRead);
+	eResult = W5500SocketReceive(pInfo->pDev, pTCPClient->Sck.nSocket, pData, nDataBytes, &nAvail);
+	(*pnBytesRecv) = nAvail;
+	
 	if (eResult < W5500_Success) {
 		return NetFail_Unknown;
 	} else {
 		return Net_Success;
 	}
 }
-	
+
 eNetReturn_t W5500NetTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData) {
-	sW5500Obj_t *pDev = (sW5500Obj_t *)pTCPClient->pHWInfo;
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
+	
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
+	return W5500NetTCPSendAll(pInfo->pDev, pTCPClient->Sck.nSocket, (const uint8_t *)pData, nDataBytes);
+}
+
+eNetReturn_t W5500NetTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pTCPClient->pHWInfo;
 	eW5500Return_t eResult;
+	eNetReturn_t eNetResult;
+	uint32_t nVec;
 	uint16_t nAvail;
 	eW5500SckProt_t eProt;
 	eW5500SckStat_t eState;
 	SOCKADDR_IN ConnAddr;
 	
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
 	//Make sure the socket is in a valid state
-	eResult = W5500SocketStatus(pDev, pTCPClient->Sck.nSocket, &eProt, &eState, &nAvail, &ConnAddr, sizeof(SOCKADDR_IN));
+	eResult = W5500SocketStatus(pInfo->pDev, pTCPClient->Sck.nSocket, &eProt, &eState, &nAvail, &ConnAddr, sizeof(SOCKADDR_IN));
 		
 	if (eResult != W5500_Success) { //failed to get socket information
 		return NetFail_Unknown;
@@ -1036,8 +1833,93 @@ eNetReturn_t W5500NetTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes
 		return NetFail_SocketState;
 	}
 	
-	//Socket looks good, ship out the data
-	eResult = W5500SocketTCPSend(pDev, pTCPClient->Sck.nSocket, pData, nDataBytes);
+	//Socket looks good, ship out all the pieces together
+	eResult = W5500SocketTCPSendV(pInfo->pDev, pTCPClient->Sck.nSocket, nVecCnt, pVecs);
+	if (eResult == W5500_Success) {
+		return Net_Success;
+	} else if (eResult != W5500Fail_TXFreeSpace) {
+		return NetFail_Unknown;
+	}
+	
+	//No room for all of them at once, stream them out in order instead
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		eNetResult = W5500NetTCPSendAll(pInfo->pDev, pTCPClient->Sck.nSocket, (const uint8_t *)pVecs[nVec].pData, pVecs[nVec].nBytes);
+		if (eNetResult != Net_Success) {
+			return eNetResult;
+		}
+	}
+	
+	return Net_Success;
+}
+
+eW5500Return_t W5500CreateUDPServer(sW5500Obj_t *pDev, sUDPServ_t *pUDPServ, sW5500IfaceInfo_t *pInfo, uint8_t nBuffKB) {
+	uint8_t nCtr;
+	
+	//Start with a clean structure
+	IfaceUDPServObjInitialize(pUDPServ);
+	
+	pInfo->pDev = pDev;
+	pInfo->nBuffKB = nBuffKB;
+	pInfo->nListenCnt = 0;
+	pInfo->bConnected = false;
+	for (nCtr = 0; nCtr < W5500_NUMSOCKETS; nCtr++) {
+		pInfo->aListen[nCtr] = W5500_NOSOCKET;
+	}
+	
+	//Fill in structure variables
+	pUDPServ->eCapabilities = W5500_UDPSERVCAPS;
+	pUDPServ->HostSck.nSocket = SOCKET_INVALID;
+	pUDPServ->HostSck.Conn.Port = 0;
+	pUDPServ->HostSck.Conn.Addr.nNetLong = 0;
+	pUDPServ->pHWInfo = (void *)pInfo;
+	
+	//Fill in function pointers
+	pUDPServ->pfBind = &W5500NetUDPServBind;
+	pUDPServ->pfCloseHost = &W5500NetUDPServCloseHost;
+	pUDPServ->pfReceive = &W5500NetUDPServReceive;
+	pUDPServ->pfSend = &W5500NetUDPServSend;
+	
+	return W5500_Success;
+}
+
+eNetReturn_t W5500NetUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pUDPServ->pHWInfo;
+	eW5500Return_t eResult;
+	IN_ADDR IPAddr;
+	uint8_t nSck;
+	
+	if (pUDPServ->HostSck.nSocket != SOCKET_INVALID) { //Already bound
+		return NetFail_BindErr;
+	}
+	
+	W5500ReadIPAddress(pInfo->pDev, &IPAddr);
+	
+	eResult = W5500SocketListen(pInfo->pDev, &nSck, pConn->Port, IPPROTO_UDP, pInfo->nBuffKB);
+	if (eResult < W5500_Success) {
+		return NetFail_BindErr;
+	}
+	
+	pUDPServ->HostSck.nSocket = nSck;
+	pUDPServ->HostSck.Conn.Port = pConn->Port;
+	pUDPServ->HostSck.Conn.Addr.nNetLong = IPAddr.S_un.S_addr;
+	
+	return Net_Success;
+}
+
+eNetReturn_t W5500NetUDPServCloseHost(sUDPServ_t *pUDPServ) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pUDPServ->pHWInfo;
+	eW5500Return_t eResult;
+	
+	if (pUDPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
+	eResult = W5500CloseSocket(pInfo->pDev, pUDPServ->HostSck.nSocket);
+	
+	pUDPServ->HostSck.nSocket = SOCKET_INVALID;
+	pUDPServ->HostSck.Conn.Port = 0;
+	pUDPServ->HostSck.Conn.Addr.nNetLong = 0;
+	
 	if (eResult < W5500_Success) {
 		return NetFail_Unknown;
 	} else {
@@ -1045,3 +1927,101 @@ eNetReturn_t W5500NetTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes
 	}
 }
 
+eNetReturn_t W5500NetUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pUDPServ->pHWInfo;
+	sW5500Obj_t *pDev = pInfo->pDev;
+	eNetReturn_t eResult;
+	uint8_t nControl, nBuffCtrl;
+	uint8_t aHeader[W5500_UDPHEADER];
+	uint16_t nAvail, nReadAddr, nLength;
+	
+	*pnBytesRecv = 0;
+	
+	if (pUDPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
+	eResult = W5500NetWaitData(pDev, pUDPServ->HostSck.nSocket, W5500SckStat_UDP, &nAvail);
+	if (eResult != Net_Success) {
+		return eResult;
+	}
+	
+	if (nAvail < W5500_UDPHEADER) { //The part always stores the header with the datagram
+		return NetFail_Unknown;
+	}
+	
+	nControl = pUDPServ->HostSck.nSocket << W5500BSB_SocketLShift;
+	nControl |= W5500BSB_Register;
+	nBuffCtrl = pUDPServ->HostSck.nSocket << W5500BSB_SocketLShift;
+	nBuffCtrl |= W5500BSB_RXBuffer;
+	
+	W5500ReadData(pDev, W5500SckReg_RXReadPtr0, (eW5500Control_t)nControl, aHeader, 2);
+	nReadAddr = aHeader[0] << 8;
+	nReadAddr |= aHeader[1];
+	
+	//Header holds the source address, port, then the datagram length
+	W5500ReadData(pDev, nReadAddr, (eW5500Control_t)nBuffCtrl, aHeader, W5500_UDPHEADER);
+	nReadAddr += W5500_UDPHEADER;
+	
+	pConn->Addr.aBytes[0] = aHeader[0];
+	pConn->Addr.aBytes[1] = aHeader[1];
+	pConn->Addr.aBytes[2] = aHeader[2];
+	pConn->Addr.aBytes[3] = aHeader[3];
+	pConn->Port = aHeader[4] << 8;
+	pConn->Port |= aHeader[5];
+	nLength = aHeader[6] << 8;
+	nLength |= aHeader[7];
+	
+	if (nLength > nAvail - W5500_UDPHEADER) { //Header doesn't fit what arrived
+		return NetFail_Unknown;
+	}
+	
+	//Read what fits, the rest of the datagram is skipped over
+	if (nDataBytes > nLength) {
+		nDataBytes = nLength;
+	}
+	
+	W5500ReadData(pDev, nReadAddr, (eW5500Control_t)nBuffCtrl, (uint8_t *)pData, nDataBytes);
+	*pnBytesRecv = nDataBytes;
+	nReadAddr += nLength;
+	
+	aHeader[0] = nReadAddr >> 8;
+	aHeader[1] = nReadAddr & 0xFF;
+	W5500WriteData(pDev, W5500SckReg_RXReadPtr0, (eW5500Control_t)nControl, aHeader, 2);
+	
+	aHeader[0] = W5500SckCmd_Recv;
+	W5500WriteData(pDev, W5500SckReg_Command, (eW5500Control_t)nControl, aHeader, 1);
+	
+	if (nDataBytes < nLength) {
+		return NetFail_BuffSize;
+	}
+	
+	return Net_Success;
+}
+
+eNetReturn_t W5500NetUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData) {
+	sW5500IfaceInfo_t *pInfo = (sW5500IfaceInfo_t *)pUDPServ->pHWInfo;
+	eW5500Return_t eResult;
+	IN_ADDR IPDest;
+	
+	if (pUDPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+	
+	if (nDataBytes > ((uint32_t)pInfo->pDev->aTXBuffKB[pUDPServ->HostSck.nSocket]) * 1024) {
+		return NetFail_BuffSize;
+	}
+	
+	IPDest.S_un.S_addr = pConn->Addr.nNetLong;
+	
+	//It always fits, only a datagram still going out can hold it up
+	do {
+		eResult = W5500SocketUDPSend(pInfo->pDev, pUDPServ->HostSck.nSocket, &IPDest, pConn->Port, (uint8_t *)pData, nDataBytes);
+	} while (eResult == W5500Fail_TXFreeSpace);
+	
+	if (eResult < W5500_Success) {
+		return NetFail_Unknown;
+	} else {
+		return Net_Success;
+	}
+}
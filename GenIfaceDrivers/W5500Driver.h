@@ -1,6 +1,6 @@
 /**	@defgroup	w5500driver
 	@brief		Driver for the Wizner W5500 Ethernet device
-	@details	v0.4
+	@details	v0.8
 	# Description #
 		This is an ethernet device that includes buffers for transmit/receive as well as includes
 		the entire Ethernet stack.  It will allow 8 sockets to be used for Ethernet communication
@@ -17,6 +17,44 @@
 		see the condition of the socker.
 		
 		The part requires SPI Mode 0 or 3
+		
+		Every register or buffer access is a single chip select frame moved with
+		the bus's pfTransferBlock, so a full socket buffer goes out in one burst.
+		Buses with the SPI_BiDirBlock capability do this in one call, others fall
+		back on a byte at a time.  SPI_W5500Simulated in RasPiHeaders models the
+		part for testing without hardware.
+		
+		If the part's INTn pin is wired to a GPIO that supports interrupts call
+		W5500EventInitialize() after W5500Initialize().  The interrupt handler only
+		notes that INTn fell, all bus traffic happens in W5500EventService() which
+		the application calls from its main loop.  While W5500EventPending() is 
+		false there is nothing for the part to report and the processor may sleep.
+		Each service reads the socket interrupt register once, then reads and 
+		clears the flags of only the sockets it names, and calls that socket's
+		connect, receive, send ok, and disconnect handlers.  The blocking accept 
+		and receive calls wait on these events instead of reading the socket 
+		status over and over.
+		
+		The part's 16 KB of transmit and 16 KB of receive memory is split 2 KB to
+		each socket by W5500Initialize().  W5500SetBufferSizes() divides it to suit 
+		the workload, such as one 8 KB socket for bulk data and small sockets for 
+		control traffic.  Each interface is created with the smallest buffer its 
+		sockets need and is given the free socket that fits most closely, which
+		keeps the large sockets free for the work that needs them.
+		
+		A TCP server can keep several sockets listening on its port.  When one 
+		accepts a connection the others are still listening, so there is no gap
+		where a client is refused, and a replacement listener is opened as soon 
+		as a socket is free.
+		
+		The part wraps buffer offsets within each socket's buffer itself, so a
+		span that runs past the end of a buffer is still moved in one burst.
+		Sends are streamed: W5500SocketTCPSendContinue() moves as much of a 
+		send as the transmit buffer has room for and keeps its place in a 
+		sW5500SendCursor_t, so a send of any size goes out in pieces without 
+		blocking.  A new piece is only handed to the part once the last one is 
+		sent.  The interface send functions use this to take data larger than 
+		the transmit buffer, waiting on the send ok event between pieces.
 	
 	# File Info #
 		File:	W5500Driver.c
@@ -40,22 +78,22 @@
 	/**	@brief		TCP Server interface capabilites available
 		@ingroup	w5500driver
 	*/
-	#define W5500_TCPSERVCAPS		((eTCPServerCapabilities_t)(TCPServ_Bind | TCPServ_CloseHost | TCPServ_CloseClient | TCPServ_AcceptConn | TCPServ_Receive | TCPServ_Send))
+	#define W5500_TCPSERVCAPS		((eTCPServerCapabilities_t)(TCPServ_Bind | TCPServ_CloseHost | TCPServ_CloseClient | TCPServ_AcceptConn | TCPServ_Receive | TCPServ_Send | TCPServ_SendV))
 	
 	/**	@brief		TCP Client interface capabilites available
 		@ingroup	w5500driver
 	*/
-	#define W5500_TCPCLIENTCAPS		((eTCPClientCapabilities_t)(TCPClient_None))
+	#define W5500_TCPCLIENTCAPS		((eTCPClientCapabilities_t)(TCPClient_Connect | TCPClient_Close | TCPClient_Receive | TCPClient_Send | TCPClient_SendV | TCPClient_ConnStart))
 	
 	/**	@brief		UDP Server interface capabilites available
 		@ingroup	w5500driver
 	*/
-	#define W5500_UDPSERVCAPS		((eUDPServerCapabilities_t)(UDPServ_None))
+	#define W5500_UDPSERVCAPS		((eUDPServerCapabilities_t)(UDPServ_Bind | UDPServ_CloseHost | UDPServ_Receive | UDPServ_Send))
 	
 	/**	@brief		UDP Client interface capabilites available
 		@ingroup	w5500driver
 	*/
-	#define W5500_TCPCLIENTCAPS		((eUDPClientCapabilities_t)(UDPClient_None))
+	#define W5500_UDPCLIENTCAPS		((eUDPClientCapabilities_t)(UDPClient_None))
 
 	/**	@brief		W5500 Version register always indicates version 0x04
 		@ingroup	w5500driver
@@ -78,10 +116,27 @@
 	*/
 	#define W5500_HIGHPORTSTART		50000
 	
+	/**	@brief		KB of transmit memory, and of receive memory, the sockets share
+		@ingroup	w5500driver
+	*/
+	#define W5500_BUFFMEMKB			16
+	
+	/**	@brief		Marks an unused entry in a list of sockets
+		@ingroup	w5500driver
+	*/
+	#define W5500_NOSOCKET			0xFF
+	
+	/**	@brief		Bytes the part puts ahead of each datagram in a UDP receive buffer
+		@details	4 bytes of source address, 2 of source port, and 2 of length
+		@ingroup	w5500driver
+	*/
+	#define W5500_UDPHEADER			8
+	
 	/**	@brief		All return codes for the W5500 driver 
 		@ingroup	w5500driver
 	*/
 	typedef enum eW5500Return_t {
+		W5500Warn_Partial		= 2,	/**< Only part of the data could be taken, the rest must wait for room */
 		W5500Warn_Unknown		= 1,	/**< An unknown but recoverable error happened during the operation */
 		W5500_Success			= 0,	/**< The operation completed successfully */
 		W5500Fail_Unknown		= -1,	/**< An unknown and unrecoverable error happened during the operation */
@@ -92,6 +147,8 @@
 		W5500Fail_InvalidSocket	= -6,	/**< A request was made for an invalid socket number */
 		W5500Fail_TXFreeSpace	= -7,	/**< Transmit data size was too large */
 		W5500Fail_SpiMode		= -8,	/**< SPI Mode is incorrect for this device */
+		W5500Fail_NoInterrupt	= -9,	/**< The GPIO interface can not provide an interrupt on the INTn pin */
+		W5500Fail_BuffSize		= -10,	/**< Buffer sizes the part does not support, or more than its memory */
 	} eW5500Return_t;
 	
 	/**	@brief		Control codes for area of memory in W5500 to access
@@ -299,6 +356,7 @@
 		W5500SckInt_Connect		= 0x01,
 		
 		W5500SckInt_AllMask		= 0x1F,	/**< Mask of all interrupt bits */
+		W5500SckInt_EventMask	= 0x0F,	/**< Interrupts the event engine always takes, send ok only when handled */
 	} eW5500SckInt_t;
 	
 	/**	@brief		Individual socket status register values
@@ -362,6 +420,27 @@
 		IPPROTO_INVALID,	/**< Unknown or invalid protocol */
 	} eW5500SckProt_t;
 	
+	typedef struct sW5500Obj_t sW5500Obj_t; //Declaring this early, will define it later
+	
+	/**	@brief		Function called when a socket event is serviced
+		@param		pDev		Pointer to the W5500 driver object that owns the socket
+		@param		nSocket		Socket the event happened on
+		@param		pParam		Parameter given when the handlers were set
+		@ingroup	w5500driver
+	*/
+	typedef void (*pfW5500SckEvent_t)(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam);
+	
+	/**	@brief		Handlers for the events of one socket, any may be NULL
+		@ingroup	w5500driver
+	*/
+	typedef struct sW5500SckEvents_t {
+		pfW5500SckEvent_t pfConnect;	/**< A connection was established */
+		pfW5500SckEvent_t pfReceive;	/**< Data is waiting in the receive buffer */
+		pfW5500SckEvent_t pfSendOK;		/**< The last send command completed */
+		pfW5500SckEvent_t pfDisconnect;	/**< The connection was closed or timed out */
+		void *pParam;					/**< Parameter passed to every handler */
+	} sW5500SckEvents_t;
+	
 	/**	@brief		Object representing the W5500 device
 		@ingroup	w5500driver
 	*/
@@ -370,8 +449,39 @@
 		uint8_t nChipSelectPin;		/**< Chip select pin in the GPIO module */
 		sSPIIface_t *pSPI;			/**< Pointer to SPI device for bus communication */
 		uint16_t nNextPort;			/**< Next port to use for outbound communications */
+		uint8_t aRXBuffKB[W5500_NUMSOCKETS];	/**< KB of receive memory each socket has */
+		uint8_t aTXBuffKB[W5500_NUMSOCKETS];	/**< KB of transmit memory each socket has */
+		uint8_t nSckUsed;			/**< Bit set for each socket given out and not yet closed */
+		
+		uint8_t nIntPin;			/**< INTn pin in the GPIO module */
+		bool bEvents;				/**< True if the event engine is handling the INTn pin */
+		volatile bool bIntPending;	/**< Set by the INTn interrupt, cleared when the events are serviced */
+		uint8_t aSckFlags[W5500_NUMSOCKETS];			/**< Socket interrupts serviced but not yet waited on */
+		sW5500SckEvents_t aSckEvents[W5500_NUMSOCKETS];	/**< Handlers for each socket's events */
 	} sW5500Obj_t;
 	
+	/**	@brief		W5500 details for one network interface object
+		@details	The interface object's pHWInfo points to this.
+		@ingroup	w5500driver
+	*/
+	typedef struct sW5500IfaceInfo_t {
+		sW5500Obj_t *pDev;						/**< Device the interface uses */
+		uint8_t nBuffKB;						/**< Smallest buffer, in KB, a socket needs for this interface */
+		uint8_t nListenCnt;						/**< TCP servers only, number of sockets to keep listening */
+		uint8_t aListen[W5500_NUMSOCKETS];		/**< TCP servers only, sockets listening, W5500_NOSOCKET if unused */
+		bool bConnected;						/**< TCP clients only, true once the connection was established */
+	} sW5500IfaceInfo_t;
+	
+	/**	@brief		Place in a send that is moved into the part a piece at a time
+		@ingroup	w5500driver
+	*/
+	typedef struct sW5500SendCursor_t {
+		const uint8_t *pData;		/**< Data being sent */
+		uint32_t nBytes;			/**< Total number of bytes to send */
+		uint32_t nSent;				/**< Bytes the part has taken so far */
+		bool bSending;				/**< The last attempt found the part still sending a piece */
+	} sW5500SendCursor_t;
+	
 	/**	@breif		Standard BSD sockets stucture for holding addresses
 		@details	Netowork order is Big Endian, byte 1 is most significat byte
 		@ingroup	w5500driver
@@ -400,7 +510,7 @@
 	*/
 	typedef struct sockaddr_in {
 		uint8_t sin_familiy;	/**< Always AF_INET */
-		uint8_t sin_port;		/**< Service port */
+		uint16_t sin_port;		/**< Service port */
 		IN_ADDR sin_addr;		/**< IP address */
 		uint8_t sin_zero[8];	/**< Unused reserved space */
 	} SOCKADDR_IN;
@@ -487,6 +597,19 @@
 		@ingroup	w5500driver
 	*/
 	eW5500Return_t W5500ReadIPAddress(sW5500Obj_t *pDev, IN_ADDR *Address);
+	
+	/**	@brief		Divide the part's buffer memory between the sockets
+		@details	Sizes must be 0, 1, 2, 4, 8, or 16 KB and each direction can total
+			no more than W5500_BUFFMEMKB.  The memory of an open socket moves when
+			sizes change, so this should be called while all sockets are closed.
+		@param		pDev		Pointer to the W5500 driver object to configure
+		@param		aRXKB		KB of receive memory for each socket
+		@param		aTXKB		KB of transmit memory for each socket
+		@return		W5500_Success if the sizes are set, W5500Fail_BuffSize if they are
+			not allowed
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SetBufferSizes(sW5500Obj_t *pDev, const uint8_t aRXKB[W5500_NUMSOCKETS], const uint8_t aTXKB[W5500_NUMSOCKETS]);
 		
 	/**	@brief		Sets a socket to listen for incoming connections
 		@details	For TCP sockets it will listen for connection requests.  The first request 
@@ -494,26 +617,34 @@
 			dedicated to that connection.  The status will need to be checked to determine when 
 			this connection request came in.
 			For UDP sockets there is no connection, so it will begin acceptign data on that port.
+			
+			Of the closed sockets with at least nBuffKB of receive and transmit memory
+			the one with the least memory is used.
 		@param		pDev		Pointer to the W5500 driver object that owns this socket
 		@param		pnSocket	Returns socket that is listening on the requested port
 		@param		nPort		The local port the socket should listen on
+		@param		eProtocol	Protocol the socket is to use
+		@param		nBuffKB		Smallest buffers, in KB, the socket may have
 		@return		W5500_Success if the port is correctly bind, an error or warning code will
 			be provided to indicate the failure
 		@ingroup	w5500driver
 	*/
-	eW5500Return_t W5500SocketListen(sW5500Obj_t *pDev, uint8_t *pnSocket, uint16_t nPort, eW5500SckProt_t eProtocol);
+	eW5500Return_t W5500SocketListen(sW5500Obj_t *pDev, uint8_t *pnSocket, uint16_t nPort, eW5500SckProt_t eProtocol, uint8_t nBuffKB);
 
 	/**	@brief		Attempt a connection to a TCP Server
-		@details	Used for TCP connection only.  
+		@details	Used for TCP connection only.  Returns once the connect command is
+			issued, the socket status shows when the connection is made.  The socket
+			is chosen as it is for W5500SocketListen().
 		@param		pDev		Pointer to the W5500 driver object that owns this socket
 		@param		pnSocket	Returns socket that is connected to the requested server
 		@param		Address		IP Address of the server to connect to
 		@param		nPort		Port number on the server to connect to
+		@param		nBuffKB		Smallest buffers, in KB, the socket may have
 		@return		W5500_Success if the port is correctly bind, an error or warning code will
 			be provided to indicate the failure
 		@ingroup	w5500driver
 	*/
-	eW5500Return_t W5500SocketConnect(sW5500Obj_t *pDev, uint8_t *pnSocket, IN_ADDR *Address, uint16_t nPort);
+	eW5500Return_t W5500SocketConnect(sW5500Obj_t *pDev, uint8_t *pnSocket, IN_ADDR *Address, uint16_t nPort, uint8_t nBuffKB);
 
 	/**	@brief		Retrieve information regarding a created socket
 		@details	The state of socket is the main indicator or connection status.  Outside of
@@ -534,7 +665,9 @@
 	
 	/**	@brief		Reads in any data waiting for a specific socket
 		@details	The W5500 does not provide information on the source of the data.  Will read
-			until either the buffer is filled or all available data has been read.
+			until either the buffer is filled or all available data has been read.  Data
+			that wraps around the end of the receive buffer is read in the same burst,
+			the part wraps the offset itself.
 		@param		pDev		Pointer to the W5500 driver object that owns this socket
 		@param		nSocket		The iedintifier of the socket to read from
 		@param		pBuff		Pointer to the buffer that will receive the data
@@ -546,7 +679,66 @@
 	*/
 	eW5500Return_t W5500SocketReceive(sW5500Obj_t *pDev, uint8_t nSocket, uint8_t *pBuff, uint16_t nBuffSize, uint16_t *pnBytesRead);
 	
+	/**	@brief		Sends data through a TCP socket if all of it fits
+		@param		pDev		Pointer to the W5500 driver object that owns this socket
+		@param		nSocket		The iedintifier of the socket to send through
+		@param		pBuff		Data to send
+		@param		nBuffSize	Number of bytes to send
+		@return		W5500_Success if the data was sent, W5500Fail_TXFreeSpace if the 
+			transmit buffer can not hold all of it or is still sending, or another 
+			code indicating the failure
+		@ingroup	w5500driver
+	*/
 	eW5500Return_t W5500SocketTCPSend(sW5500Obj_t *pDev, uint8_t nSocket, uint8_t *pBuff, uint16_t nBuffSize);
+	
+	/**	@brief		Sends as much of the data through a TCP socket as there is room for
+		@details	Never waits.  Nothing is taken while the part is still sending an
+			earlier piece.
+		@param		pDev		Pointer to the W5500 driver object that owns this socket
+		@param		nSocket		The iedintifier of the socket to send through
+		@param		pBuff		Data to send
+		@param		nBuffSize	Number of bytes to send
+		@param		pnSent		Returns the number of bytes taken
+		@return		W5500_Success if all of it was taken, W5500Warn_Partial if only 
+			some or none was, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SocketTCPSendPart(sW5500Obj_t *pDev, uint8_t nSocket, const uint8_t *pBuff, uint16_t nBuffSize, uint16_t *pnSent);
+	
+	/**	@brief		Prepare a cursor to stream data out of a socket
+		@param		pCursor		Cursor to prepare
+		@param		pData		Data to send, must remain until the send completes
+		@param		nBytes		Number of bytes to send
+		@ingroup	w5500driver
+	*/
+	void W5500SendCursorInit(sW5500SendCursor_t *pCursor, const void *pData, uint32_t nBytes);
+	
+	/**	@brief		Move the next piece of a streamed send into the part
+		@details	Never waits, call again when the part has finished sending or 
+			made room to move the rest.  The cursor records how far it got.
+		@param		pDev		Pointer to the W5500 driver object that owns this socket
+		@param		nSocket		The iedintifier of the socket to send through
+		@param		pCursor		Cursor of the send
+		@return		W5500_Success once all of the data is taken, W5500Warn_Partial 
+			while some remains, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SocketTCPSendContinue(sW5500Obj_t *pDev, uint8_t nSocket, sW5500SendCursor_t *pCursor);
+	
+	/**	@brief		Sends data gathered from several buffers through a TCP socket
+		@details	Every piece is written into the socket's transmit buffer one after
+			the other, then the write pointer is updated and the send command issued
+			once for all of them.
+		@param		pDev		Pointer to the W5500 driver object that owns this socket
+		@param		nSocket		The iedintifier of the socket to send through
+		@param		nVecCnt		Number of pieces in the list
+		@param		pVecs		List of pieces of data to send
+		@return		W5500_Success if the data was sent, W5500Fail_TXFreeSpace if the 
+			transmit buffer can not hold all of the pieces or is still sending, or 
+			another code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500SocketTCPSendV(sW5500Obj_t *pDev, uint8_t nSocket, uint32_t nVecCnt, sNetVec_t *pVecs);
 
 	eW5500Return_t W5500SocketUDPSend(sW5500Obj_t *pDev, uint8_t nSocket, IN_ADDR *pAddr, uint16_t nPort, uint8_t *pBuff, uint16_t nBuffSize);
 	
@@ -558,18 +750,90 @@
 	*/
 	eW5500Return_t W5500CloseSocket(sW5500Obj_t *pDev, uint8_t nSocket);
 	
+	/**	@brief		Start the event engine on the part's INTn pin
+		@details	Sets the pin as an input and hooks its interrupt, then enables the
+			connect, receive, disconnect, and timeout interrupts on every socket.
+			Must be called after W5500Initialize() as resetting the part clears the
+			interrupt masks.
+		@param		pDev		Pointer to the W5500 driver object
+		@param		nIntPin		Identifier for the GPIO pin wired to INTn
+		@return		W5500_Success if the engine is running, W5500Fail_NoInterrupt if the 
+			GPIO interface can not interrupt on the pin
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500EventInitialize(sW5500Obj_t *pDev, uint8_t nIntPin);
+	
+	/**	@brief		Set the handlers called for one socket's events
+		@details	Send ok interrupts are only enabled on the part while a send ok
+			handler is set, so sends do not cost an extra event otherwise.
+		@param		pDev		Pointer to the W5500 driver object
+		@param		nSocket		Socket the handlers are for
+		@param		pEvents		Handlers to use, NULL to remove them all
+		@return		W5500_Success if the handlers are set, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500EventSetHandlers(sW5500Obj_t *pDev, uint8_t nSocket, const sW5500SckEvents_t *pEvents);
+	
+	/**	@brief		Reports if INTn has signalled since events were last serviced
+		@details	Makes no bus access, safe to check before putting the processor
+			to sleep.
+		@param		pDev		Pointer to the W5500 driver object
+		@return		True if W5500EventService() has work to do
+		@ingroup	w5500driver
+	*/
+	bool W5500EventPending(sW5500Obj_t *pDev);
+	
+	/**	@brief		Read and clear the part's interrupts and call the socket handlers
+		@details	Returns without any bus access if INTn has not signalled.  The
+			socket interrupt register is read once, then each socket it names has 
+			its flags read and cleared before the handlers are called, so anything
+			that happens during a handler raises INTn again.  Handlers are called in
+			the order connect, receive, send ok, disconnect.  Repeats until INTn 
+			reads high.
+		@param		pDev		Pointer to the W5500 driver object
+		@return		W5500_Success once all events are handled, or a code indicating the 
+			failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500EventService(sW5500Obj_t *pDev);
+	
 	/**	@brief		Create a TCP Server interface object through the Wiznet 5500
 		@details	Establishes an implementation of the TCP Server Network Interface
 			using the Ethernet connection provided by the Wiznet 5500 peripheral.
+			Binding opens nListenCnt sockets listening on the port, as many as 
+			there are free sockets for, and the host socket is the first of them.
 		@param		pDev		Pointer to the Wiznet 5500 device object
 		@param		pTCPServ	TCP Server interface structure to put the implementation in
+		@param		pInfo		Holds the W5500 details of the server, must last as long as it
+		@param		nBuffKB		Smallest buffers, in KB, the server's sockets may have
+		@param		nListenCnt	Number of sockets to keep listening for connections
 		@return		W5500_Success if the port is interface is created, an error or warning code
 			will be provided to indicate the failure
 		@ingroup	w5500driver
 	*/
-	eW5500Return_t W5500CreateTCPServer(sW5500Obj_t *pDev, sTCPServ_t *pTCPServ);
+	eW5500Return_t W5500CreateTCPServer(sW5500Obj_t *pDev, sTCPServ_t *pTCPServ, sW5500IfaceInfo_t *pInfo, uint8_t nBuffKB, uint8_t nListenCnt);
+	
+	/**	@brief		Create a TCP Client interface object through the Wiznet 5500
+		@param		pDev		Pointer to the Wiznet 5500 device object
+		@param		pTCPClient	TCP Client interface structure to put the implementation in
+		@param		pInfo		Holds the W5500 details of the client, must last as long as it
+		@param		nBuffKB		Smallest buffers, in KB, the client's socket may have
+		@return		W5500_Success if the interface is created, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500CreateTCPClient(sW5500Obj_t *pDev, sTCPClient_t *pTCPClient, sW5500IfaceInfo_t *pInfo, uint8_t nBuffKB);
 	
-	eW5500Return_t W5500CreateTCPClient(sW5500Obj_t *pDev, sTCPClient_t *pTCPClient);
+	/**	@brief		Create a UDP Server interface object through the Wiznet 5500
+		@details	Each receive returns one datagram.  A datagram larger than the 
+			buffer given is cut short and the rest of it discarded.
+		@param		pDev		Pointer to the Wiznet 5500 device object
+		@param		pUDPServ	UDP Server interface structure to put the implementation in
+		@param		pInfo		Holds the W5500 details of the server, must last as long as it
+		@param		nBuffKB		Smallest buffers, in KB, the server's socket may have
+		@return		W5500_Success if the interface is created, or a code indicating the failure
+		@ingroup	w5500driver
+	*/
+	eW5500Return_t W5500CreateUDPServer(sW5500Obj_t *pDev, sUDPServ_t *pUDPServ, sW5500IfaceInfo_t *pInfo, uint8_t nBuffKB);
 	
 /***** Functions	*****/
 
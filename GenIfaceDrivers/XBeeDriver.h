@@ -1,7 +1,15 @@
 /**	@defgroup	xbeedriver
 	@brief		Driver for the XBee ZigBee radio in API mode
 	@details	
+		Received bytes are decoded as they arrive, the decoder never waits on 
+		the UART.  Bytes can be fed in from anywhere with XBeeReceiveBytes(), or 
+		XBeeReadMessage() will take whatever the UART has waiting.  Frames that 
+		pass their checksum are held in a queue until XBeeNextMessage() copies 
+		the oldest into the data buffer for XBeeParseMessage().
 		
+		Set bEscaped after initializing if the radio is in API mode 2 (AP=2).
+		Received frames are then unescaped and sent frames escaped, and a start
+		byte anywhere restarts the decoder.
 */
 
 #ifndef __XBEEDRIVER
@@ -40,7 +48,29 @@
 
 #define XBEE_STARTBYTE			0x7E
 
-#define XBEE_TIMEOUTLOOPS		20
+/**	@brief		Byte that marks the next byte as escaped in API mode 2
+	@ingroup	xbeedriver
+*/
+#define XBEE_ESCAPEBYTE			0x7D
+
+/**	@brief		Value an escaped byte is XOR'd with
+	@ingroup	xbeedriver
+*/
+#define XBEE_ESCAPEXOR			0x20
+
+#ifndef XBEE_RXQUEUEBYTES
+	/**	@brief		Bytes held for received frames waiting to be read
+		@details	Must hold at least one frame of XBEE_RECVBUFFERSIZE plus
+			XBEE_READCHUNK bytes.
+		@ingroup	xbeedriver
+	*/
+	#define XBEE_RXQUEUEBYTES	(2 * XBEE_RECVBUFFERSIZE)
+#endif
+
+/**	@brief		Most bytes moved to or from the UART in one call
+	@ingroup	xbeedriver
+*/
+#define XBEE_READCHUNK			32
 
 #define XBEE_FRAMEIDNORESPONSE	0x00
 
@@ -60,8 +90,22 @@ typedef enum eXBeeReturn_t {
 	XBFail_Unknown	= -1,
 	XBFail_Checksum	= -2,
 	XBFail_MsgSize	= -3,
+	XBFail_Truncated= -4,	/**< A frame was cut off by the start of another */
+	XBFail_QueueFull= -5,	/**< A frame arrived with no room left to hold it */
 } eXBeeReturn_t;
 
+/**	@brief		Steps of decoding a received frame
+	@ingroup	xbeedriver
+*/
+typedef enum eXBeeRXState_t {
+	XBRX_Start				= 0,	/**< Waiting for a start byte */
+	XBRX_LengthMSB			= 1,	/**< Waiting for the high byte of the length */
+	XBRX_LengthLSB			= 2,	/**< Waiting for the low byte of the length */
+	XBRX_Data				= 3,	/**< Receiving the frame data */
+	XBRX_Checksum			= 4,	/**< Waiting for the checksum */
+	XBRX_Skip				= 5,	/**< Passing over a frame that can't be kept */
+} eXBeeRXState_t;
+
 typedef enum eXBeeFrameIndexes_t {
 	XBIdx_Start				= 0,
 	XBIdx_LengthMSB			= 1,
@@ -169,6 +213,21 @@ typedef struct sXBeeObject_t {
 	uint8_t nResetPin;
 	uint8_t nFrameID;
 	uint8_t anDataBuffer[XBEE_RECVBUFFERSIZE];
+	bool bEscaped;				/**< Radio is in API mode 2, escaping its frames */
+	
+	eXBeeRXState_t eRXState;	/**< Step the decoder is at */
+	bool bRXEscNext;			/**< Next byte received was escaped */
+	uint16_t nRXLen;			/**< Data bytes in the frame being received */
+	uint16_t nRXLeft;			/**< Data bytes still to come in the frame being received */
+	uint16_t nRXWrite;			/**< Where the next byte of the frame being received goes in the queue */
+	uint8_t nRXSum;				/**< Sum of the data bytes received so far */
+	eXBeeReturn_t eRXError;		/**< Why the last frame was dropped, until it is reported */
+	uint32_t nRXDropped;		/**< Count of frames dropped */
+	
+	uint8_t anRXQueue[XBEE_RXQUEUEBYTES];	/**< Received frames waiting to be read, back to back */
+	uint16_t nQueueHead;		/**< Index of the oldest frame in the queue */
+	uint16_t nQueueBytes;		/**< Bytes of complete frames in the queue */
+	uint16_t nQueueFrames;		/**< Complete frames in the queue */
 	
 	sUARTIface_t *pUART;
 } sXBeeObject_t;
@@ -249,8 +308,43 @@ eXBeeReturn_t XBeeInitialize(sXBeeObject_t *pXbeeObj, sUARTIface_t *pUART, uint8
 
 uint8_t XBeeAPIChecksum(uint8_t *paMsg);
 
+/**	@brief		Take any bytes waiting in the UART and read out the next frame
+	@details	Never waits for data.  Bytes are read only while no frame is 
+		queued, anything left stays in the UART for the next call.
+	@param		pXbeeObj	XBee object to read for
+	@return		XB_Success if a frame was copied into the data buffer, 
+		XBWarn_NoMessage if none is complete yet, or the reason a frame was 
+		dropped since the last call
+	@ingroup	xbeedriver
+*/
 eXBeeReturn_t XBeeReadMessage(sXBeeObject_t *pXbeeObj);
 
+/**	@brief		Decode received bytes, queuing any frames they complete
+	@details	The bytes can end anywhere in a frame, decoding picks up where it
+		left off on the next call.
+	@param		pXbeeObj	XBee object to decode for
+	@param		pData		Bytes received from the radio
+	@param		nBytes		Number of bytes received
+	@return		XB_Success if a frame is waiting in the queue, XBWarn_NoMessage if 
+		not
+	@ingroup	xbeedriver
+*/
+eXBeeReturn_t XBeeReceiveBytes(sXBeeObject_t *pXbeeObj, const uint8_t *pData, uint16_t nBytes);
+
+/**	@brief		Copy the oldest queued frame into the data buffer
+	@param		pXbeeObj	XBee object to read for
+	@return		XB_Success if a frame was copied, XBWarn_NoMessage if the queue is
+		empty, or the reason a frame was dropped since the last call
+	@ingroup	xbeedriver
+*/
+eXBeeReturn_t XBeeNextMessage(sXBeeObject_t *pXbeeObj);
+
+void XBeeDecodeByte(sXBeeObject_t *pXbeeObj, uint8_t nByte);
+
+void XBeeQueuePut(sXBeeObject_t *pXbeeObj, uint8_t nByte);
+
+void XBeeSendFrame(sXBeeObject_t *pXbeeObj, uint16_t nFrameLen);
+
 eXBeeReturn_t XBeeParseMessage(sXBeeObject_t *pXbeeObj, sXBeeFrameRecv_t *pFrameRecv);
 
 eXBeeReturn_t XBeeParseNetworkDiscoveryData(const uint8_t *pATCmdData, sXBeeNetDiscovResult_t *pNetworkDevice);
@@ -268,6 +362,16 @@ eXBeeReturn_t XBeeInitialize(sXBeeObject_t *pXbeeObj, sUARTIface_t *pUART, uint8
 	pXbeeObj->nResetPin = nRstPin;
 	pXbeeObj->nFrameID = 1; //Must start at 1, zero means no reply needed
 	pXbeeObj->pUART = pUART;
+	pXbeeObj->bEscaped = false;
+	
+	pXbeeObj->eRXState = XBRX_Start;
+	pXbeeObj->bRXEscNext = false;
+	pXbeeObj->eRXError = XB_Success;
+	pXbeeObj->nRXDropped = 0;
+	
+	pXbeeObj->nQueueHead = 0;
+	pXbeeObj->nQueueBytes = 0;
+	pXbeeObj->nQueueFrames = 0;
 	
 	return XB_Success;
 }
@@ -290,92 +394,227 @@ uint8_t XBeeAPIChecksum(uint8_t *paMsg) {
 }
 
 eXBeeReturn_t XBeeReadMessage(sXBeeObject_t *pXbeeObj) {
-	uint16_t nBytes, nRead, nCtr, nBuffIdx, nMsgLen;
+	uint8_t aChunk[XBEE_READCHUNK];
+	uint16_t nBytes, nRead;
 	
-	pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-	for (nCtr = 0; nCtr < XBEE_TIMEOUTLOOPS && nBytes == 0; nCtr++) {
-		pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-		mSecDelay(1);
+	//The UART holds anything past the first frame until it's asked for
+	while (pXbeeObj->nQueueFrames == 0) {
+		if (pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes) != UART_Success) {
+			break;
+		}
+		
+		if (nBytes == 0) {
+			break;
+		} else if (nBytes > XBEE_READCHUNK) {
+			nBytes = XBEE_READCHUNK;
+		}
+		
+		pXbeeObj->pUART->pfUARTReadData(pXbeeObj->pUART, nBytes, aChunk, &nRead);
+		if (nRead == 0) {
+			break;
+		}
+		
+		XBeeReceiveBytes(pXbeeObj, aChunk, nRead);
 	}
 	
-	if (nBytes == 0) {
-		return XBWarn_NoData;
-	}
+	return XBeeNextMessage(pXbeeObj);
+}
+
+eXBeeReturn_t XBeeReceiveBytes(sXBeeObject_t *pXbeeObj, const uint8_t *pData, uint16_t nBytes) {
+	uint16_t nCtr;
+	uint8_t nByte;
 	
-	pXbeeObj->anDataBuffer[0] = 0;
-	//Look for start of message characters
-	pXbeeObj->pUART->pfUARTReadData(pXbeeObj->pUART, 1, pXbeeObj->anDataBuffer, &nRead);
-	for (nCtr = 0; (nCtr < nBytes) && (pXbeeObj->anDataBuffer[0] != XBEE_STARTBYTE); nCtr++) {
-		pXbeeObj->pUART->pfUARTReadData(pXbeeObj->pUART, 1, pXbeeObj->anDataBuffer, &nRead);
-		mSecDelay(1);
+	for (nCtr = 0; nCtr < nBytes; nCtr++) {
+		nByte = pData[nCtr];
+		
+		if (pXbeeObj->bEscaped == true) {
+			if (nByte == XBEE_STARTBYTE) { //Never escaped, so it always begins a frame
+				if (pXbeeObj->eRXState != XBRX_Start) {
+					pXbeeObj->eRXError = XBFail_Truncated;
+					pXbeeObj->nRXDropped += 1;
+					pXbeeObj->eRXState = XBRX_Start;
+				}
+				
+				pXbeeObj->bRXEscNext = false;
+			} else if (nByte == XBEE_ESCAPEBYTE) {
+				pXbeeObj->bRXEscNext = true;
+				continue;
+			} else if (pXbeeObj->bRXEscNext == true) {
+				nByte ^= XBEE_ESCAPEXOR;
+				pXbeeObj->bRXEscNext = false;
+			}
+		}
+		
+		XBeeDecodeByte(pXbeeObj, nByte);
 	}
 	
-	if (pXbeeObj->anDataBuffer[0] != XBEE_STARTBYTE) {
-		//No message was waiting
-		return XBWarn_NoMessage;
+	if (pXbeeObj->nQueueFrames > 0) {
+		return XB_Success;
 	} else {
-		nBytes -= nCtr; //Adjust the number of bytes waiting to be read
-		nBuffIdx = 1; //Write the next point for data to go
+		return XBWarn_NoMessage;
 	}
-	
-	//Now read out the number of data bytes
-	pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-	for (nCtr = 0; nCtr < XBEE_TIMEOUTLOOPS && nBytes < 2; nCtr++) { //Loop till the length bytes exist
-		pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-		mSecDelay(1);
+}
+
+void XBeeDecodeByte(sXBeeObject_t *pXbeeObj, uint8_t nByte) {
+	switch (pXbeeObj->eRXState) {
+		case XBRX_Start:
+			if (nByte == XBEE_STARTBYTE) { //Anything else is noise between frames
+				pXbeeObj->eRXState = XBRX_LengthMSB;
+			}
+			
+			break;
+		case XBRX_LengthMSB:
+			pXbeeObj->nRXLen = nByte << 8;
+			pXbeeObj->eRXState = XBRX_LengthLSB;
+			
+			break;
+		case XBRX_LengthLSB:
+			pXbeeObj->nRXLen |= nByte;
+			pXbeeObj->nRXLeft = pXbeeObj->nRXLen;
+			pXbeeObj->nRXSum = 0;
+			
+			if (pXbeeObj->nRXLen == 0) { //Every frame has at least its type
+				pXbeeObj->eRXError = XBFail_MsgSize;
+				pXbeeObj->nRXDropped += 1;
+				pXbeeObj->eRXState = XBRX_Start;
+			} else if (pXbeeObj->nRXLen > XBEE_RECVBUFFERSIZE - XBEE_MSGBASELENGTH) { //Too big for the data buffer
+				pXbeeObj->eRXError = XBFail_MsgSize;
+				pXbeeObj->nRXDropped += 1;
+				pXbeeObj->eRXState = XBRX_Skip;
+			} else if (pXbeeObj->nRXLen + XBEE_MSGBASELENGTH > XBEE_RXQUEUEBYTES - pXbeeObj->nQueueBytes) {
+				pXbeeObj->eRXError = XBFail_QueueFull;
+				pXbeeObj->nRXDropped += 1;
+				pXbeeObj->eRXState = XBRX_Skip;
+			} else { //Frame goes straight into the queue behind the last one
+				pXbeeObj->nRXWrite = (pXbeeObj->nQueueHead + pXbeeObj->nQueueBytes) % XBEE_RXQUEUEBYTES;
+				XBeeQueuePut(pXbeeObj, XBEE_STARTBYTE);
+				XBeeQueuePut(pXbeeObj, pXbeeObj->nRXLen >> 8);
+				XBeeQueuePut(pXbeeObj, pXbeeObj->nRXLen & 0xFF);
+				pXbeeObj->eRXState = XBRX_Data;
+			}
+			
+			break;
+		case XBRX_Data:
+			XBeeQueuePut(pXbeeObj, nByte);
+			pXbeeObj->nRXSum += nByte;
+			pXbeeObj->nRXLeft -= 1;
+			
+			if (pXbeeObj->nRXLeft == 0) {
+				pXbeeObj->eRXState = XBRX_Checksum;
+			}
+			
+			break;
+		case XBRX_Checksum:
+			pXbeeObj->eRXState = XBRX_Start;
+			
+			if ((uint8_t)(pXbeeObj->nRXSum + nByte) != 0xFF) { //Data plus checksum always totals 0xFF
+				pXbeeObj->eRXError = XBFail_Checksum;
+				pXbeeObj->nRXDropped += 1;
+				break;
+			}
+			
+			//Frame is good, it's now part of the queue
+			XBeeQueuePut(pXbeeObj, nByte);
+			pXbeeObj->nQueueBytes += pXbeeObj->nRXLen + XBEE_MSGBASELENGTH;
+			pXbeeObj->nQueueFrames += 1;
+			
+			break;
+		case XBRX_Skip:
+			if (pXbeeObj->nRXLeft == 0) { //This is the checksum, frame is over
+				pXbeeObj->eRXState = XBRX_Start;
+			} else {
+				pXbeeObj->nRXLeft -= 1;
+			}
+			
+			break;
+		default :
+			pXbeeObj->eRXState = XBRX_Start;
+			
+			break;
 	}
+}
+
+void XBeeQueuePut(sXBeeObject_t *pXbeeObj, uint8_t nByte) {
+	pXbeeObj->anRXQueue[pXbeeObj->nRXWrite] = nByte;
 	
-	if (nCtr >= XBEE_TIMEOUTLOOPS) {
-		//Never got our length, no message
-		return XBWarn_NoMessage;
+	pXbeeObj->nRXWrite += 1;
+	if (pXbeeObj->nRXWrite >= XBEE_RXQUEUEBYTES) {
+		pXbeeObj->nRXWrite = 0;
 	}
+}
 
-	pXbeeObj->pUART->pfUARTReadData(pXbeeObj->pUART, 2, &(pXbeeObj->anDataBuffer[nBuffIdx]), &nRead);
-	nMsgLen = pXbeeObj->anDataBuffer[nBuffIdx] << 8;
-	nMsgLen |= pXbeeObj->anDataBuffer[nBuffIdx + 1];
-	nMsgLen += XBEE_MSGBASELENGTH; //Add in non-data byres
-	nBuffIdx += 2;
+eXBeeReturn_t XBeeNextMessage(sXBeeObject_t *pXbeeObj) {
+	eXBeeReturn_t eError;
+	uint16_t nMsgLen, nFirst;
 	
-	if (nMsgLen > XBEE_RECVBUFFERSIZE) { //Message is to obig for the buffer
-		pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-		nRead = 0;
+	if (pXbeeObj->nQueueFrames == 0) {
+		//Let the caller know if something was lost
+		eError = pXbeeObj->eRXError;
+		pXbeeObj->eRXError = XB_Success;
 		
-		//Read out all of the message and dump it
-		for (nCtr = 0; (nCtr < nMsgLen) && (nBytes > 0); nCtr += nRead) {
-			if (nBytes > XBEE_RECVBUFFERSIZE) {
-				nBytes = XBEE_RECVBUFFERSIZE;
-			}
-			
-			pXbeeObj->pUART->pfUARTReadData(pXbeeObj->pUART, nBytes, pXbeeObj->anDataBuffer, &nRead);
-			pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
+		if (eError != XB_Success) {
+			return eError;
+		} else {
+			return XBWarn_NoMessage;
 		}
-		
-		return XBFail_MsgSize;
 	}
 	
-	//Wait for and read in the rest of the message
-	pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-	for (nCtr = 0; (nCtr < XBEE_TIMEOUTLOOPS) && (nBytes < nMsgLen - 3); nCtr++) { //Loop till the msg received (already read in 3 bytes)
-		pXbeeObj->pUART->pfUARTDataAvailable(pXbeeObj->pUART, &nBytes);
-		mSecDelay(1);
-	}
+	nMsgLen = pXbeeObj->anRXQueue[(pXbeeObj->nQueueHead + XBIdx_LengthMSB) % XBEE_RXQUEUEBYTES] << 8;
+	nMsgLen |= pXbeeObj->anRXQueue[(pXbeeObj->nQueueHead + XBIdx_LengthLSB) % XBEE_RXQUEUEBYTES];
+	nMsgLen += XBEE_MSGBASELENGTH;
 	
-	if (nCtr >= XBEE_TIMEOUTLOOPS) {
-		//Never got our length, no message
-		return XBWarn_NoMessage;
+	//Frame may wrap around the end of the queue
+	nFirst = XBEE_RXQUEUEBYTES - pXbeeObj->nQueueHead;
+	if (nFirst > nMsgLen) {
+		nFirst = nMsgLen;
 	}
 	
-	pXbeeObj->pUART->pfUARTReadData(pXbeeObj->pUART, nMsgLen - 3, &(pXbeeObj->anDataBuffer[nBuffIdx]), &nRead);
+	memcpy(pXbeeObj->anDataBuffer, &(pXbeeObj->anRXQueue[pXbeeObj->nQueueHead]), nFirst);
+	memcpy(&(pXbeeObj->anDataBuffer[nFirst]), pXbeeObj->anRXQueue, nMsgLen - nFirst);
+	
+	pXbeeObj->nQueueHead = (pXbeeObj->nQueueHead + nMsgLen) % XBEE_RXQUEUEBYTES;
+	pXbeeObj->nQueueBytes -= nMsgLen;
+	pXbeeObj->nQueueFrames -= 1;
 	
-	//Verify data integrity
-	nCtr = XBeeAPIChecksum(pXbeeObj->anDataBuffer);
+	return XB_Success;
+}
+
+void XBeeSendFrame(sXBeeObject_t *pXbeeObj, uint16_t nFrameLen) {
+	uint8_t aChunk[XBEE_READCHUNK];
+	uint16_t nCtr, nChunk;
 	
-	if (nCtr != pXbeeObj->anDataBuffer[nMsgLen - 1]) {
-		//Checsum didn't match, bad message
-		return XBFail_Checksum;
+	if (pXbeeObj->bEscaped == false) {
+		pXbeeObj->pUART->pfUARTWriteData(pXbeeObj->pUART, nFrameLen, pXbeeObj->anDataBuffer);
+	} else { //Everything after the start byte is escaped
+		aChunk[0] = XBEE_STARTBYTE;
+		nChunk = 1;
+		
+		for (nCtr = 1; nCtr < nFrameLen; nCtr++) {
+			if (nChunk >= XBEE_READCHUNK - 1) { //Leave room for an escaped pair
+				pXbeeObj->pUART->pfUARTWriteData(pXbeeObj->pUART, nChunk, aChunk);
+				nChunk = 0;
+			}
+			
+			switch (pXbeeObj->anDataBuffer[nCtr]) {
+				case XBEE_STARTBYTE:
+				case XBEE_ESCAPEBYTE:
+				case 0x11: //XON
+				case 0x13: //XOFF
+					aChunk[nChunk] = XBEE_ESCAPEBYTE;
+					aChunk[nChunk + 1] = pXbeeObj->anDataBuffer[nCtr] ^ XBEE_ESCAPEXOR;
+					nChunk += 2;
+					break;
+				default :
+					aChunk[nChunk] = pXbeeObj->anDataBuffer[nCtr];
+					nChunk += 1;
+					break;
+			}
+		}
+		
+		pXbeeObj->pUART->pfUARTWriteData(pXbeeObj->pUART, nChunk, aChunk);
 	}
 	
-	return XB_Success;
+	pXbeeObj->pUART->pfUARTWaitDataSend(pXbeeObj->pUART);
 }
 
 eXBeeReturn_t XBeeParseMessage(sXBeeObject_t *pXbeeObj, sXBeeFrameRecv_t *pFrameRecv) {
@@ -554,8 +793,7 @@ eXBeeReturn_t XBeeATQueryCommand(sXBeeObject_t *pXbeeObj, const char ATCmd[2], u
 	pXbeeObj->anDataBuffer[XBIdx_DataStart + nDataLen] = XBeeAPIChecksum(pXbeeObj->anDataBuffer);
 	
 	//Send the message
-	pXbeeObj->pUART->pfUARTWriteData(pXbeeObj->pUART, XBEE_MSGBASELENGTH + nDataLen, pXbeeObj->anDataBuffer);
-	pXbeeObj->pUART->pfUARTWaitDataSend(pXbeeObj->pUART);
+	XBeeSendFrame(pXbeeObj, XBEE_MSGBASELENGTH + nDataLen);
 	
 	//Increment the frame ID for the next message
 	*pnFrameID = pXbeeObj->nFrameID;
@@ -606,8 +844,7 @@ eXBeeReturn_t XBeeTXReqest(sXBeeObject_t *pXbeeObj, uint64_t nDestAddr, uint16_t
 	pXbeeObj->anDataBuffer[XBIdx_DataStart + nDataLen] = XBeeAPIChecksum(pXbeeObj->anDataBuffer);
 	
 	//Send the message
-	pXbeeObj->pUART->pfUARTWriteData(pXbeeObj->pUART, XBEE_MSGBASELENGTH + nDataLen, pXbeeObj->anDataBuffer);
-	pXbeeObj->pUART->pfUARTWaitDataSend(pXbeeObj->pUART);
+	XBeeSendFrame(pXbeeObj, XBEE_MSGBASELENGTH + nDataLen);
 	
 	//Increment the frame ID for the next message
 	*pnFrameID = pXbeeObj->nFrameID;
@@ -22,6 +22,21 @@
 */
 uint16_t GetCRC16TableEntry(uint16_t Index, eCRC16Types_t Type);
 
+/** Runs the table driven CRC algorithm over a block of data
+	No algorithm specific adjustments are made to the CRC value.
+	@param pCtx The context holding the lookup tables
+	@param pBytes The data to include in the calculation
+	@param nDataLen Number of bytes to include
+	@param nCRC The CRC register value to begin with
+	@return The updated CRC register value
+	@ingroup	crc16
+*/
+static crc16_t CRC16ContextProcess(const sCRC16Context_t *pCtx, const uint8_t *pBytes, uint32_t nDataLen, crc16_t nCRC);
+
+#if (CRC16_SLICES != 1) && (CRC16_SLICES != 4) && (CRC16_SLICES != 8)
+	#error	CRC16_SLICES must be 1, 4, or 8
+#endif
+
 /***** Protected Variables 	*****/
 
 /***** Function Code 		*****/
@@ -97,3 +112,145 @@ crc16_t CalculateCRC16(eCRC16Types_t Type, void *DataBuffer, uint32_t DataLength
 
 	return ContinueCalculateCRC16Buffer(Type, DataBuffer, DataLength, CrcVal);
 }
+
+eReturn_t CRC16ContextInitialize(sCRC16Context_t *pCtx, eCRC16Types_t eType) {
+	uint32_t nIdx, nSlice;
+	uint16_t nEntry;
+
+	if (pCtx == NULL) {
+		return Fail_Invalid;
+	}
+
+	pCtx->eType = eType;
+	pCtx->nInitial = GetInitialCRC16(eType);
+
+	for (nIdx = 0; nIdx < 256; nIdx++) {
+		pCtx->aTable[0][nIdx] = GetCRC16TableEntry(nIdx, eType);
+	}
+
+	//Each following table is the previous one advanced by another zero byte
+	for (nSlice = 1; nSlice < CRC16_SLICES; nSlice++) {
+		for (nIdx = 0; nIdx < 256; nIdx++) {
+			nEntry = pCtx->aTable[nSlice - 1][nIdx];
+			pCtx->aTable[nSlice][nIdx] = (nEntry >> 8) ^ pCtx->aTable[0][nEntry & 0x00FF];
+		}
+	}
+
+	return Success;
+}
+
+static crc16_t CRC16ContextProcess(const sCRC16Context_t *pCtx, const uint8_t *pBytes, uint32_t nDataLen, crc16_t nCRC) {
+	#if CRC16_SLICES == 8
+		while (nDataLen >= 8) {
+			nCRC ^= pBytes[0] | ((uint16_t)pBytes[1] << 8);
+
+			nCRC = pCtx->aTable[7][nCRC & 0x00FF] ^ pCtx->aTable[6][nCRC >> 8] ^
+				pCtx->aTable[5][pBytes[2]] ^ pCtx->aTable[4][pBytes[3]] ^
+				pCtx->aTable[3][pBytes[4]] ^ pCtx->aTable[2][pBytes[5]] ^
+				pCtx->aTable[1][pBytes[6]] ^ pCtx->aTable[0][pBytes[7]];
+
+			pBytes += 8;
+			nDataLen -= 8;
+		}
+	#elif CRC16_SLICES == 4
+		while (nDataLen >= 4) {
+			nCRC ^= pBytes[0] | ((uint16_t)pBytes[1] << 8);
+
+			nCRC = pCtx->aTable[3][nCRC & 0x00FF] ^ pCtx->aTable[2][nCRC >> 8] ^
+				pCtx->aTable[1][pBytes[2]] ^ pCtx->aTable[0][pBytes[3]];
+
+			pBytes += 4;
+			nDataLen -= 4;
+		}
+	#endif
+
+	while (nDataLen > 0) {
+		nCRC = (nCRC >> 8) ^ pCtx->aTable[0][(nCRC ^ *pBytes) & 0x00FF];
+
+		pBytes++;
+		nDataLen--;
+	}
+
+	return nCRC;
+}
+
+crc16_t CRC16ContextContinue(const sCRC16Context_t *pCtx, const void *pData, uint32_t nDataLen, crc16_t nPrevCRC) {
+	if ((nPrevCRC != 0) && (pCtx->eType == CRC_DNP)) { //Revert the DNP CRC to the format used by the calculations
+		nPrevCRC = FlipBytesUInt16(nPrevCRC);
+		nPrevCRC = ~nPrevCRC;
+	}
+
+	nPrevCRC = CRC16ContextProcess(pCtx, (const uint8_t *)pData, nDataLen, nPrevCRC);
+
+	if (pCtx->eType == CRC_DNP) {
+		nPrevCRC = ~nPrevCRC;
+		nPrevCRC = FlipBytesUInt16(nPrevCRC);
+	}
+
+	return nPrevCRC;
+}
+
+crc16_t CRC16ContextCalculate(const sCRC16Context_t *pCtx, const void *pData, uint32_t nDataLen) {
+	return CRC16ContextContinue(pCtx, pData, nDataLen, pCtx->nInitial);
+}
+
+eReturn_t CRC16VerifyDNPFrame(const sCRC16Context_t *pCtx, const uint8_t *pFrame, uint32_t nFrameLen, uint32_t *pnBadBlock) {
+	uint32_t nUserLen, nExpLen, nBlock, nBlockLen;
+	crc16_t nCRC, nFrameCRC;
+
+	if ((pCtx == NULL) || (pCtx->eType != CRC_DNP)) {
+		return Fail_Invalid;
+	}
+
+	if (pnBadBlock != NULL) {
+		*pnBadBlock = 0;
+	}
+
+	if (nFrameLen < CRC16_DNPHEADERSIZE) {
+		return Fail_BufferSize;
+	}
+
+	//Length byte counts control, destination, and source (5 bytes) plus the user data
+	if (pFrame[2] < 5) {
+		return Fail_Invalid;
+	}
+
+	nUserLen = pFrame[2] - 5;
+	nExpLen = CRC16_DNPHEADERSIZE + nUserLen;
+	nExpLen += ((nUserLen + CRC16_DNPBLOCKSIZE - 1) / CRC16_DNPBLOCKSIZE) * sizeof(crc16_t);
+
+	if (nFrameLen < nExpLen) {
+		return Fail_BufferSize;
+	}
+
+	//CRC is transmitted LSB first, compare against the complemented register
+	nCRC = CRC16ContextProcess(pCtx, pFrame, CRC16_DNPHEADERSIZE - sizeof(crc16_t), pCtx->nInitial);
+	nCRC = ~nCRC;
+	nFrameCRC = pFrame[CRC16_DNPHEADERSIZE - 2] | ((uint16_t)pFrame[CRC16_DNPHEADERSIZE - 1] << 8);
+	if (nCRC != nFrameCRC) {
+		return Fail_Invalid;
+	}
+
+	pFrame += CRC16_DNPHEADERSIZE;
+	nBlock = 1;
+	while (nUserLen > 0) {
+		nBlockLen = GetSmallerNum(nUserLen, CRC16_DNPBLOCKSIZE);
+
+		nCRC = CRC16ContextProcess(pCtx, pFrame, nBlockLen, pCtx->nInitial);
+		nCRC = ~nCRC;
+		nFrameCRC = pFrame[nBlockLen] | ((uint16_t)pFrame[nBlockLen + 1] << 8);
+		if (nCRC != nFrameCRC) {
+			if (pnBadBlock != NULL) {
+				*pnBadBlock = nBlock;
+			}
+
+			return Fail_Invalid;
+		}
+
+		pFrame += nBlockLen + sizeof(crc16_t);
+		nUserLen -= nBlockLen;
+		nBlock++;
+	}
+
+	return Success;
+}
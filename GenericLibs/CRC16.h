@@ -18,6 +18,26 @@
 /***** Includes    *****/
 	#include "CommonUtils.h"
 
+/***** Defines     *****/
+	#ifndef CRC16_SLICES
+		/** Number of lookup tables each CRC context holds.  Must be 1, 4, or 8.  Each table is 512 bytes, more tables
+			allows more bytes to be processed per loop iteration at the cost of memory.  Microcontroller builds should
+			keep the single table, hosts with memory to spare can define this as 8.
+			@ingroup	crc16
+		*/
+		#define CRC16_SLICES		1
+	#endif
+
+	/** Number of bytes in each block of DNP user data that is followed by a CRC
+		@ingroup	crc16
+	*/
+	#define CRC16_DNPBLOCKSIZE	16
+
+	/** Number of bytes in a DNP link header, including its CRC
+		@ingroup	crc16
+	*/
+	#define CRC16_DNPHEADERSIZE	10
+
 /***** Constants   *****/
 	#ifdef CRC16_USETABLE
 		/** 16 bit CRC lookup table generated for DNP CRCs.  Uses 0xA6BC (CRC_DNP lower 2 bytes) as the polynomial. */
@@ -81,6 +101,18 @@
 	/** A standardized type to use when storing CRC values */
 	typedef uint16_t crc16_t;
 
+	/** @brief Precomputed state for calculating CRC values of a single algorithm type
+		The tables are built once when the context is initialized so that no per byte algorithm selection or table
+		generation is needed while calculating.  Table 0 is the standard byte table, each following table advances
+		the CRC by one additional zero byte so that CRC16_SLICES bytes can be processed at a time.
+		@ingroup	crc16
+	*/
+	typedef struct sCRC16Context_t {
+		eCRC16Types_t eType;					/**< The CRC algorithm this context calculates */
+		crc16_t nInitial;						/**< Value the CRC calculation begins with */
+		uint16_t aTable[CRC16_SLICES][256];		/**< Lookup tables used for the calculations */
+	} sCRC16Context_t;
+
 /***** Prototypes  *****/
 	/** @brief Calculates the CRC value for a block of data
 		This will determine the initial CRC value to begin the algorithm with based on the algorithm specified.  It
@@ -119,4 +151,49 @@
 		@return The calculated CRC value
 	*/
 	crc16_t ContinueCalculateCRC16Byte(eCRC16Types_t Type, uint8_t Byte, crc16_t PreviousCRC);
+
+	/** @brief Prepares a CRC context to calculate values with the specified algorithm
+		Builds all lookup tables for the algorithm.  This only needs done once, the context can then be used for any
+		number of calculations.
+		@ingroup	crc16
+		@param pCtx The context to initialize
+		@param eType The CRC algorithm type the context will calculate
+		@return Success if the context is ready to use, Fail_Invalid if the parameters are not usable
+	*/
+	eReturn_t CRC16ContextInitialize(sCRC16Context_t *pCtx, eCRC16Types_t eType);
+
+	/** @brief Calculates the CRC value for a block of data using a prepared context
+		Produces the same result as CalculateCRC16() for the context's algorithm type.
+		@ingroup	crc16
+		@param pCtx The initialized context for the CRC algorithm to use
+		@param pData Pointer to the block of data to calculate the CRC value of
+		@param nDataLen The number of bytes in the data buffer
+		@return The calculated CRC value
+	*/
+	crc16_t CRC16ContextCalculate(const sCRC16Context_t *pCtx, const void *pData, uint32_t nDataLen);
+
+	/** @brief Continues a CRC calculation using a prepared context
+		Produces the same result as ContinueCalculateCRC16Buffer() for the context's algorithm type.
+		@ingroup	crc16
+		@param pCtx The initialized context for the CRC algorithm to use
+		@param pData Pointer to the block of data to include in the calculated CRC value
+		@param nDataLen The number of bytes in the data buffer
+		@param nPrevCRC The CRC number calculated previously for this data set
+		@return The calculated CRC value
+	*/
+	crc16_t CRC16ContextContinue(const sCRC16Context_t *pCtx, const void *pData, uint32_t nDataLen, crc16_t nPrevCRC);
+
+	/** @brief Verifies every CRC in a complete DNP link layer frame
+		The frame must begin with the 10 byte link header.  The header CRC is checked, then the length byte is used
+		to find each 16 byte block of user data (the last may be shorter) and its trailing CRC.
+		@ingroup	crc16
+		@param pCtx An initialized context for the CRC_DNP algorithm
+		@param pFrame Buffer holding the complete link frame
+		@param nFrameLen Number of bytes in the frame buffer
+		@param pnBadBlock Receives the block that failed the check, 0 for the header and 1 for the first data block.
+			May be NULL if this is not needed.
+		@return Success if all CRC values match, Fail_Invalid if any CRC does not match or the context is not for DNP,
+			Fail_BufferSize if the buffer does not hold the number of bytes the header specifies
+	*/
+	eReturn_t CRC16VerifyDNPFrame(const sCRC16Context_t *pCtx, const uint8_t *pFrame, uint32_t nFrameLen, uint32_t *pnBadBlock);
  #endif
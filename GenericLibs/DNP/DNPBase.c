@@ -4,39 +4,173 @@
 */
 
 /*****	Includes	*****/
+	#include <string.h>
+
 	#include "DNPBase.h"
 
 /*****	Defines		*****/
-
+	#if defined(__SIZEOF_DOUBLE__) && (__SIZEOF_DOUBLE__ != 8)
+		/**	@brief		Decoder for double precision analogs, none where double can't hold one
+		 *	@details	AVR compilers make double 4 bytes, these targets are left
+		 *		the raw bytes of the value.
+		 *	@ingroup	dnp
+		 */
+		#define DNP_DECODEDOUBLE	NULL
+	#else
+		#define DNP_DECODEDOUBLE	DNPDecodeAnalogDoubleFlags
+	#endif
 
 /*****	Definitions	*****/
+	/**	@brief		Rows of the data object descriptor table, one for each group
+	 *	@ingroup	dnp
+	 */
+	typedef enum eDNPObjRow_t {
+		DNPRow_None = 0,			/**< Group is not recognized */
+		DNPRow_DeviceAttrib,
+		DNPRow_BinaryInput,
+		DNPRow_BinaryInputEvent,
+		DNPRow_BinaryOutput,
+		DNPRow_BinaryOutputCmd,
+		DNPRow_Counter,
+		DNPRow_AnalogInput,
+		DNPRow_AnalogInputEvent,
+		DNPRow_AnalogOutput,
+		DNPRow_AnalogOutputBlock,
+
+		DNPRow_Count,				/**< Number of rows in the table */
+	} eDNPObjRow_t;
 
+/*****	Prototypes 	*****/
+	/**	@brief		Decode a 32 bit integer analog value with flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeAnalog32Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
-/*****	Constants	*****/
-	/**	@brief		Constant array holding the size in bits of recognized DNP data objects
+	/**	@brief		Decode a 16 bit integer analog value with flags
 	 *	@ingroup	dnp
 	 */
-	const sDNPDataObjBitSize_t gDNPObjSize[] = {
-		{ .eGroup =  DNPGrp_DeviceAttrib,		.nVariation = 0,	.nBits = 8,	},	//Device attributes
+	static void DNPDecodeAnalog16Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
-		{ .eGroup = DNPGrp_BinaryInput,			.nVariation = 1,	.nBits = 1, },	//Packed format
-		{ .eGroup = DNPGrp_BinaryInput,			.nVariation = 2,	.nBits = 8, },	//With flags
+	/**	@brief		Decode a 32 bit integer analog value without flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeAnalog32(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
-		{ .eGroup = DNPGrp_BinaryInputEvent,	.nVariation = 1,	.nBits = 8, },	//Without time
-		{ .eGroup = DNPGrp_BinaryInputEvent,	.nVariation = 2,	.nBits = 56, },	//Absolute time
-		{ .eGroup = DNPGrp_BinaryInputEvent,	.nVariation = 3,	.nBits = 24, },	//Relative time
+	/**	@brief		Decode a 16 bit integer analog value without flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeAnalog16(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
-		{ .eGroup = DNPGrp_BinaryOutput,		.nVariation = 1,	.nBits = 1, },	//Packed format
-		{ .eGroup = DNPGrp_BinaryOutput,		.nVariation = 2,	.nBits = 8, },	//With flags
+	/**	@brief		Decode a single precision floating point analog value with flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeAnalogFloatFlags(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
-		{ .eGroup = DNPGrp_BinaryOutputCmd,		.nVariation = 1,	.nBits = 88, },	//Control relay output block (CROB)
-		{ .eGroup = DNPGrp_BinaryOutputCmd,		.nVariation = 2,	.nBits = 88, },	//Pattern control block (PCB)
-	};
+	#if !defined(__SIZEOF_DOUBLE__) || (__SIZEOF_DOUBLE__ == 8)
+		/**	@brief		Decode a double precision floating point analog value with flags
+		 *	@ingroup	dnp
+		 */
+		static void DNPDecodeAnalogDoubleFlags(const uint8_t *pBytes, uDNPDataBlock_t *pData);
+	#endif
 
-/*****	Globals		*****/
+	/**	@brief		Decode a 32 bit counter value with flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeCounter32Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
+	/**	@brief		Decode a 16 bit counter value with flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeCounter16Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData);
 
-/*****	Prototypes 	*****/
+	/**	@brief		Decode a 32 bit counter value without flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeCounter32(const uint8_t *pBytes, uDNPDataBlock_t *pData);
+
+	/**	@brief		Decode a 16 bit counter value without flags
+	 *	@ingroup	dnp
+	 */
+	static void DNPDecodeCounter16(const uint8_t *pBytes, uDNPDataBlock_t *pData);
+
+/*****	Constants	*****/
+	/**	@brief		Row in the descriptor table for each group
+	 *	@ingroup	dnp
+	 */
+	static const uint8_t gDNPObjGroupRow[256] = {
+		[DNPGrp_DeviceAttrib]		= DNPRow_DeviceAttrib,
+		[DNPGrp_BinaryInput]		= DNPRow_BinaryInput,
+		[DNPGrp_BinaryInputEvent]	= DNPRow_BinaryInputEvent,
+		[DNPGrp_BinaryOutput]		= DNPRow_BinaryOutput,
+		[DNPGrp_BinaryOutputCmd]	= DNPRow_BinaryOutputCmd,
+		[DNPGrp_Counter]			= DNPRow_Counter,
+		[DNPGrp_AnalogInput]		= DNPRow_AnalogInput,
+		[DNPGrp_AnalogInputEvent]	= DNPRow_AnalogInputEvent,
+		[DNPGrp_AnalogOutput]		= DNPRow_AnalogOutput,
+		[DNPGrp_AnalogOutputBlock]	= DNPRow_AnalogOutputBlock,
+	};
+
+	/**	@brief		Descriptors of all recognized data objects, indexed by group row
+	 *		then variation
+	 *	@details	Entries left empty have a size of 0 and are not recognized
+	 *	@ingroup	dnp
+	 */
+	static const sDNPObjDescriptor_t gDNPObjDesc[DNPRow_Count][DNP_OBJVARIATIONMAX] = {
+		[DNPRow_DeviceAttrib] = {
+			[0] = { .nBits = 8,		.eFlags = DNPObjDesc_Variable,	.pfDecode = NULL, },	//Device attributes, all variations
+		},
+		[DNPRow_BinaryInput] = {
+			[1] = { .nBits = 1,		.eFlags = DNPObjDesc_Packed,	.pfDecode = NULL, },	//Packed format
+			[2] = { .nBits = 8,		.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//With flags
+		},
+		[DNPRow_BinaryInputEvent] = {
+			[1] = { .nBits = 8,		.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Without time
+			[2] = { .nBits = 56,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Absolute time
+			[3] = { .nBits = 24,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Relative time
+		},
+		[DNPRow_BinaryOutput] = {
+			[1] = { .nBits = 1,		.eFlags = DNPObjDesc_Packed,	.pfDecode = NULL, },	//Packed format
+			[2] = { .nBits = 8,		.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//With flags
+		},
+		[DNPRow_BinaryOutputCmd] = {
+			[1] = { .nBits = 88,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Control relay output block (CROB)
+			[2] = { .nBits = 88,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Pattern control block (PCB)
+		},
+		[DNPRow_Counter] = {
+			[1] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeCounter32Flags, },	//32 bit with flags
+			[2] = { .nBits = 24,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeCounter16Flags, },	//16 bit with flags
+			[5] = { .nBits = 32,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeCounter32, },		//32 bit without flags
+			[6] = { .nBits = 16,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeCounter16, },		//16 bit without flags
+		},
+		[DNPRow_AnalogInput] = {
+			[1] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog32Flags, },		//32 bit with flags
+			[2] = { .nBits = 24,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog16Flags, },		//16 bit with flags
+			[3] = { .nBits = 32,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog32, },			//32 bit without flags
+			[4] = { .nBits = 16,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog16, },			//16 bit without flags
+			[5] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalogFloatFlags, },	//Single precision with flags
+			[6] = { .nBits = 72,	.eFlags = DNPObjDesc_None,		.pfDecode = DNP_DECODEDOUBLE, },	//Double precision with flags
+		},
+		[DNPRow_AnalogInputEvent] = {
+			[1] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog32Flags, },		//32 bit without time
+			[2] = { .nBits = 24,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog16Flags, },		//16 bit without time
+			[5] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalogFloatFlags, },	//Single precision without time
+			[6] = { .nBits = 72,	.eFlags = DNPObjDesc_None,		.pfDecode = DNP_DECODEDOUBLE, },	//Double precision without time
+		},
+		[DNPRow_AnalogOutput] = {
+			[1] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog32Flags, },		//32 bit with flags
+			[2] = { .nBits = 24,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalog16Flags, },		//16 bit with flags
+			[3] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = DNPDecodeAnalogFloatFlags, },	//Single precision with flags
+			[4] = { .nBits = 72,	.eFlags = DNPObjDesc_None,		.pfDecode = DNP_DECODEDOUBLE, },	//Double precision with flags
+		},
+		[DNPRow_AnalogOutputBlock] = { //Value followed by a status code
+			[1] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//32 bit
+			[2] = { .nBits = 24,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//16 bit
+			[3] = { .nBits = 40,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Single precision
+			[4] = { .nBits = 72,	.eFlags = DNPObjDesc_None,		.pfDecode = NULL, },	//Double precision
+		},
+	};
+
+/*****	Globals		*****/
 
 
 /*****	Functions	*****/
@@ -95,7 +229,7 @@ uint32_t BytesToUInt32(uint8_t *pBuffer, bool bLSBFirst, uint32_t nBuffOffset, u
 
 	if (bLSBFirst == true) {
 		for (nCtr = 0; nCtr < nLength; nCtr++) {
-			nValue += pBuffer[nBuffOffset + nCtr] << (nCtr * 8);
+			nValue += (uint32_t)pBuffer[nBuffOffset + nCtr] << (nCtr * 8);
 		}
 	} else {
 		for (nCtr = 0; nCtr < nLength; nCtr++) {
@@ -117,6 +251,7 @@ eReturn_t DNPBufferNewMessage(sDNPMsgBuffer_t *pMsg) {
 	pMsg->eIntIndicators = DNPIntInd_None;
 	pMsg->eControlCode = DNPCtrl_Response;
 	pMsg->eDataControl = DNPData_Direction | DNPData_Primary | DNPData_UnconfirmData;
+	pMsg->bConfirmExpect = false;
 
 	//Each message should get a new sequence number, where they start isn't important
 	pMsg->nTransportSequence += 1;
@@ -133,24 +268,129 @@ eReturn_t DNPBufferNewMessage(sDNPMsgBuffer_t *pMsg) {
 	pMsg->sDataObj.nTotalBytes = 0;
 	pMsg->sDataObj.nPrefixBytes = 0;
 	pMsg->sDataObj.nCurrPoint = 0;
+	pMsg->sDataObj.pDesc = NULL;
 
 	return Success;
 }
 
 uint16_t DNPGetDataObjectBitSize(eDNPGroup_t eGroup, uint8_t nVariation) {
-	uint32_t nCtr;
+	const sDNPObjDescriptor_t *pDesc = DNPGetDataObjectDescriptor(eGroup, nVariation);
 
-	for (nCtr = 0; nCtr < sizeof(gDNPObjSize) / sizeof(sDNPDataObjBitSize_t); nCtr++) {
-		if ((gDNPObjSize[nCtr].eGroup == eGroup) && (gDNPObjSize[nCtr].nVariation == nVariation)) {
-			//Found the requested data object
-			return gDNPObjSize[nCtr].nBits;
-		}
+	if (pDesc == NULL) {
+		return 0; //Couldn't find the requested object type
+	}
 
-		if ((gDNPObjSize[nCtr].eGroup == eGroup) && (gDNPObjSize[nCtr].nVariation == 0)) {
-			//Found a catch all data object for this group
-			return gDNPObjSize[nCtr].nBits;
-		}
+	return pDesc->nBits;
+}
+
+const sDNPObjDescriptor_t *DNPGetDataObjectDescriptor(eDNPGroup_t eGroup, uint8_t nVariation) {
+	uint8_t nRow = gDNPObjGroupRow[(uint8_t)eGroup];
+
+	if (nRow == DNPRow_None) {
+		return NULL;
+	}
+
+	if ((nVariation < DNP_OBJVARIATIONMAX) && (gDNPObjDesc[nRow][nVariation].nBits != 0)) {
+		//Found the requested data object
+		return &(gDNPObjDesc[nRow][nVariation]);
+	}
+
+	if (gDNPObjDesc[nRow][0].nBits != 0) {
+		//Found a catch all data object for this group
+		return &(gDNPObjDesc[nRow][0]);
 	}
 
-	return 0; //Couldn't find the requested object type
+	return NULL;
+}
+
+static void DNPDecodeAnalog32Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Analog.eFlags = (eDNPObjAnaInFlags_t)pBytes[0];
+	pData->Analog.nValue = (int32_t)BytesToUInt32((uint8_t *)pBytes, true, 1, 4);
+	pData->Analog.dValue = pData->Analog.nValue;
+
+	return;
+}
+
+static void DNPDecodeAnalog16Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Analog.eFlags = (eDNPObjAnaInFlags_t)pBytes[0];
+	pData->Analog.nValue = (int16_t)BytesToUInt16((uint8_t *)pBytes, true, 1);
+	pData->Analog.dValue = pData->Analog.nValue;
+
+	return;
+}
+
+static void DNPDecodeAnalog32(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Analog.eFlags = DNPAnaInFlag_Online;
+	pData->Analog.nValue = (int32_t)BytesToUInt32((uint8_t *)pBytes, true, 0, 4);
+	pData->Analog.dValue = pData->Analog.nValue;
+
+	return;
+}
+
+static void DNPDecodeAnalog16(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Analog.eFlags = DNPAnaInFlag_Online;
+	pData->Analog.nValue = (int16_t)BytesToUInt16((uint8_t *)pBytes, true, 0);
+	pData->Analog.dValue = pData->Analog.nValue;
+
+	return;
+}
+
+static void DNPDecodeAnalogFloatFlags(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	uint32_t nRaw;
+	float fValue;
+
+	nRaw = BytesToUInt32((uint8_t *)pBytes, true, 1, 4);
+	memcpy(&fValue, &nRaw, sizeof(float)); //Same IEEE-754 layout as the wire
+
+	pData->Analog.eFlags = (eDNPObjAnaInFlags_t)pBytes[0];
+	pData->Analog.dValue = fValue;
+	pData->Analog.nValue = (int32_t)fValue;
+
+	return;
+}
+
+#if !defined(__SIZEOF_DOUBLE__) || (__SIZEOF_DOUBLE__ == 8)
+static void DNPDecodeAnalogDoubleFlags(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	uint64_t nRaw;
+	double dValue;
+
+	nRaw = BytesToUInt32((uint8_t *)pBytes, true, 5, 4);
+	nRaw <<= 32;
+	nRaw |= BytesToUInt32((uint8_t *)pBytes, true, 1, 4);
+	memcpy(&dValue, &nRaw, sizeof(double)); //Same IEEE-754 layout as the wire
+
+	pData->Analog.eFlags = (eDNPObjAnaInFlags_t)pBytes[0];
+	pData->Analog.dValue = dValue;
+	pData->Analog.nValue = (int32_t)dValue;
+
+	return;
+}
+#endif
+
+static void DNPDecodeCounter32Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Counter.nFlags = pBytes[0];
+	pData->Counter.nValue = BytesToUInt32((uint8_t *)pBytes, true, 1, 4);
+
+	return;
+}
+
+static void DNPDecodeCounter16Flags(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Counter.nFlags = pBytes[0];
+	pData->Counter.nValue = BytesToUInt16((uint8_t *)pBytes, true, 1);
+
+	return;
+}
+
+static void DNPDecodeCounter32(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Counter.nFlags = DNPAnaInFlag_Online; //Counters share the online flag bit
+	pData->Counter.nValue = BytesToUInt32((uint8_t *)pBytes, true, 0, 4);
+
+	return;
+}
+
+static void DNPDecodeCounter16(const uint8_t *pBytes, uDNPDataBlock_t *pData) {
+	pData->Counter.nFlags = DNPAnaInFlag_Online; //Counters share the online flag bit
+	pData->Counter.nValue = BytesToUInt16((uint8_t *)pBytes, true, 0);
+
+	return;
 }
@@ -80,6 +80,11 @@
 	 */
 	#define DNP_OBJECTDATASIZE		64
 
+	/**	@brief		Number of variations per group held in the object descriptor table
+	 *	@ingroup	dnp
+	 */
+	#define DNP_OBJVARIATIONMAX		8
+
 /*****	Definitions	*****/
 	/**	@brief		Indexes of values in the Data Link Layer header
 	 *	@ingroup	dnpmsgparse
@@ -106,6 +111,7 @@
 	} eDNPAddresses_t;
 
 	typedef enum eDNPControlCodes_t {
+		DNPCtrl_Confirm			= 0,
 		DNPCtrl_Read			= 1,
 		DNPCtrl_Write			= 2,
 		DNPCtrl_Select			= 3,
@@ -114,6 +120,8 @@
 		DNPCtrl_FreezeAndClear	= 9,
 		DNPCtrl_ColdRestart		= 13,
 		DNPCtrl_WarmRestart		= 14,
+		DNPCtrl_EnableUnsolicited	= 20,
+		DNPCtrl_DisableUnsolicited	= 21,
 		DNPCtrl_FileOpen		= 25,
 		DNPCtrl_FileClose		= 26,
 		DNPCtrl_Response		= 129,
@@ -138,7 +146,8 @@
 		DNPAppHdr_FirstMsg		= 0x80,
 		DNPAppHdr_LastMsg		= 0x40,
 		DNPAppHdr_ConfirmExpect	= 0x20,
-		DNPAppHdr_SequenceMask	= 0x1F,
+		DNPAppHdr_Unsolicited	= 0x10,
+		DNPAppHdr_SequenceMask	= 0x0F,
 	} eDNPAppHeader_t;
 
 	typedef enum eDNPQualifier_t {
@@ -200,6 +209,7 @@
 		DNPGrp_Counter					= 0x14,
 		DNPGrp_AnalogInput				= 0x1E,
 		DNPGrp_FrozenAnalogInput		= 0x1F,
+		DNPGrp_AnalogInputEvent			= 0x20,
 		DNPGrp_AnalogInputDeadband		= 0x22,
 		DNPGrp_AnalogOutput				= 0x28,
 		DNPGrp_AnalogOutputBlock		= 0x29,
@@ -217,10 +227,29 @@
 		DNPBinOutCtrl_PulseOff			= 0x02,
 		DNPBinOutCtrl_LatchOn			= 0x03,
 		DNPBinOutCtrl_LatchOff			= 0x04,
+		DNPBinOutCtrl_Clear				= 0x20,
 		DNPBinOutCtrl_Close				= 0x40,
 		DNPBinOutCtrl_Trip				= 0x80,
+
+		DNPBinOutCtrl_OpTypeMask		= 0x0F,	/**< Bits holding the operation type */
+		DNPBinOutCtrl_TripCloseMask		= 0xC0,	/**< Bits selecting trip or close */
 	} eDNPBinOutControlCode_t;
 
+	/**	@brief		Status codes reported in a control relay output block
+	 *	@ingroup	dnp
+	 */
+	typedef enum eDNPCmdStatus_t {
+		DNPCmdStat_Success			= 0,	/**< Command was accepted */
+		DNPCmdStat_Timeout			= 1,	/**< Operate arrived after the select expired */
+		DNPCmdStat_NoSelect			= 2,	/**< Operate did not match a previous select */
+		DNPCmdStat_FormatError		= 3,	/**< Request was not formed correctly */
+		DNPCmdStat_NotSupported		= 4,	/**< Operation is not supported by this point */
+		DNPCmdStat_AlreadyActive	= 5,	/**< Point is still carrying out an earlier operation */
+		DNPCmdStat_HardwareError	= 6,	/**< Output could not be driven */
+		DNPCmdStat_Local			= 7,	/**< Point is under local control */
+		DNPCmdStat_TooManyObjs		= 8,	/**< Request holds more commands than can be handled */
+	} eDNPCmdStatus_t;
+
 	typedef enum eDNPDevAttrVar_t {
 		DNPDevAttr_SecureAuthVer		= 0xD1,
 		DNPDevAttr_SecureStatsPerAssoc	= 0xD2,
@@ -272,6 +301,42 @@
 		DNPBinInFlag_State			= 0x80,	/**< State of the point, set is latched */
 	} eDNPObjBinInFlags_t;
 
+	typedef enum eDNPObjAnaInFlags_t {
+		DNPAnaInFlag_Online			= 0x01,	/**< Point is online, data is reliable */
+		DNPAnaInFlag_Restart		= 0x02,	/**< Data has not been updated since the device reset */
+		DNPAnaInFlag_CommLost		= 0x04,	/**< Communications lost between originating and repeating devices */
+		DNPAnaInFlag_RemoteForce	= 0x08,	/**< Point is forced by a remote/repeater/non-originating station */
+		DNPAnaInFlag_LocalForce		= 0x10,	/**< Point is forced by the local/measuring/originating station */
+		DNPAnaInFlag_OverRange		= 0x20,	/**< Value exceeds the range the point can report */
+		DNPAnaInFlag_ReferenceErr	= 0x40,	/**< Value may not be accurate due to a reference error */
+	} eDNPObjAnaInFlags_t;
+
+	/**	@brief		Classes that data points and events are assigned to
+	 *	@details	Class 0 is the static data, the other classes hold events
+	 *	@ingroup	dnp
+	 */
+	typedef enum eDNPPollClass_t {
+		DNPPoll_None		= 0x00,
+		DNPPoll_Class0		= 0x01,		/**< Static data */
+		DNPPoll_Class1		= 0x02,		/**< Class 1 events */
+		DNPPoll_Class2		= 0x04,		/**< Class 2 events */
+		DNPPoll_Class3		= 0x08,		/**< Class 3 events */
+
+		DNPPoll_Events		= 0x0E,		/**< All event classes */
+		DNPPoll_Integrity	= 0x0F,		/**< Static data and all events */
+	} eDNPPollClass_t;
+
+	/**	@brief		Properties of a data object type held in its descriptor
+	 *	@ingroup	dnp
+	 */
+	typedef enum eDNPObjDescFlags_t {
+		DNPObjDesc_None			= 0x00,
+		DNPObjDesc_Packed		= 0x01,	/**< Values are single bits packed into bytes, no prefixes allowed */
+		DNPObjDesc_Variable		= 0x02,	/**< Value size is given in the data, the bit size is a minimum */
+	} eDNPObjDescFlags_t;
+
+	typedef struct sDNPObjDescriptor_t sDNPObjDescriptor_t;
+
 	/**	@brief		Details of the current data object being parsed from the message
 	 *	@ingroup	dnpmsgparse
 	 */
@@ -286,6 +351,7 @@
 		uint32_t nDataBytes;			/**< Number of bytes of data in this object */
 		uint32_t nTotalBytes;			/**< Number of user data bytes comprising this data object */
 		uint32_t nCurrPoint;			/**< Last data point number that was read out */
+		const sDNPObjDescriptor_t *pDesc;	/**< Descriptor of this object type, NULL if it is not recognized */
 	} sDNPDataObject_t;
 
 	typedef struct __attribute__((__packed__)) sDNPObjGrp000Type01_t {
@@ -313,6 +379,29 @@
 		uint8_t nStatusCode;
 	} sDNPObjGrp012Var01_t;
 
+	/**	@brief		Decoded value of an analog input, analog input event, or analog
+	 *		output status
+	 *	@details	Every variation is decoded to both an integer and a floating
+	 *		point value.  Variations without flags report the point as online.
+	 *		Double precision variations are only decoded where double is 8 
+	 *		bytes, on AVR they are left as raw bytes.
+	 *	@ingroup	dnpmsgparse
+	 */
+	typedef struct sDNPObjAnalog_t {
+		eDNPObjAnaInFlags_t eFlags;		/**< Point flags */
+		int32_t nValue;					/**< Value as an integer, floating point values are truncated */
+		double dValue;					/**< Value as floating point */
+	} sDNPObjAnalog_t;
+
+	/**	@brief		Decoded value of a counter
+	 *	@details	Variations without flags report the point as online.
+	 *	@ingroup	dnpmsgparse
+	 */
+	typedef struct sDNPObjCounter_t {
+		uint8_t nFlags;					/**< Point flags */
+		uint32_t nValue;				/**< Count value */
+	} sDNPObjCounter_t;
+
 	/**	@brief		Union to parse the values from the data in a data object
 	 *	@details	The parsing structures only work if the processor uses the correct
 	 *		byte orders.  DNP stipulates that all values are passed low byte first
@@ -325,8 +414,26 @@
 		sDNPObjGrp001Var02_t BinInValue;
 		sDNPObjGrp010Var02_t BinOutValue;
 		sDNPObjGrp012Var01_t BinOutCmd;
+		sDNPObjAnalog_t Analog;			/**< Groups 30, 32, 40, and 41 */
+		sDNPObjCounter_t Counter;		/**< Group 20 */
 	} uDNPDataBlock_t;
 
+	/**	@brief		Function to convert the raw bytes of a value into its typed form
+	 *	@param		pBytes		Raw bytes of the value, least significant first
+	 *	@param		pData		Returns the decoded value
+	 *	@ingroup	dnpmsgparse
+	 */
+	typedef void (*pfDNPObjDecode_t)(const uint8_t *pBytes, uDNPDataBlock_t *pData);
+
+	/**	@brief		Description of a single group and variation of data object
+	 *	@ingroup	dnp
+	 */
+	typedef struct sDNPObjDescriptor_t {
+		uint16_t nBits;					/**< Bits in each value */
+		eDNPObjDescFlags_t eFlags;		/**< Properties of the object type */
+		pfDNPObjDecode_t pfDecode;		/**< Converts values to their typed form, NULL to copy the raw bytes */
+	} sDNPObjDescriptor_t;
+
 	/**	@brief		Details of a single data point in a data object
 	 *	@ingroup	dnpmsgparse
 	 */
@@ -345,9 +452,9 @@
 	 *	@ingroup	dnp
 	 */
 	typedef struct sDNPMsgBuffer_t {
-		uint8_t aDNPMessage[DNP_MESSAGESIZEMAX];	/**< Buffer to hold the full DNP message */
+		uint8_t aDNPMessage[DNP_MESSAGESIZEMAX];	/**< Built DNP message, when parsing only a frame split across receives */
 		uint32_t nDNPMsgLen;						/**< Index of last byte of the DNP Message */
-		uint32_t nFramgentIdx;						/**< Index in the message buffer the current fragment began */
+		uint32_t nFramgentIdx;						/**< Index in the message buffer the current fragment began, always 0 when parsing */
 		uint8_t aUserData[DNP_USERDATAMAX];			/**< Buffer to hold all user data in the message */
 		uint32_t nUserDataLen;						/**< Index of last byte of user data */
 		uint32_t nUserDataIdx;						/**< Index of last processed byte in the user data */
@@ -358,15 +465,10 @@
 		eDNPControlCodes_t eControlCode;			/**< Control code used in this message */
 		eDNPInternalIndicators_t eIntIndicators;	/**< Internal indicators to set in this message */
 		eDNPDataControl_t eDataControl;				/**< Data Control code for this message */
+		bool bConfirmExpect;						/**< Set to ask the receiver to confirm a response */
 		sDNPDataObject_t sDataObj;					/**< Storage space for data object manipulation */
 	} sDNPMsgBuffer_t;
 
-	typedef struct sDNPDataObjBitSize_t {
-		eDNPGroup_t eGroup;
-		uint8_t nVariation;
-		uint16_t nBits;
-	} sDNPDataObjBitSize_t;
-
 /*****	Constants	*****/
 
 
@@ -419,6 +521,17 @@
 	 */
 	uint16_t DNPGetDataObjectBitSize(eDNPGroup_t eGroup, uint8_t nVariation);
 
+	/**	@brief		Find the descriptor of a data object type
+	 *	@details	Variations that are not described use the group's variation 0
+	 *		descriptor if it has one
+	 *	@param		eGroup		Data object group number
+	 *	@param		nVariation	Data object variation type
+	 *	@return		Pointer to the descriptor, or NULL if the object type is not
+	 *		recognized
+	 *	@ingroup	dnp
+	 */
+	const sDNPObjDescriptor_t *DNPGetDataObjectDescriptor(eDNPGroup_t eGroup, uint8_t nVariation);
+
 /*****	Functions	*****/
 
 
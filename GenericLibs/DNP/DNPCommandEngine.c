@@ -0,0 +1,470 @@
+/**	File:	DNPCommandEngine.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "DNPCommandEngine.h"
+
+/*****	Defines		*****/
+	/**	@brief		Determine if a tick count has been reached, allowing for wrap
+	 *	@ingroup	dnpcommand
+	 */
+	#define DNPCommandTickReached(nNow, nTick)	((int32_t)((nNow) - (nTick)) >= 0)
+
+	/**	@brief		Find the wheel slot an edge due at a tick count belongs in
+	 *	@ingroup	dnpcommand
+	 */
+	#define DNPCommandWheelSlot(nTick)			((nTick) & (DNPCMD_WHEELSLOTS - 1))
+
+	/**	@brief		Index of the status byte in a CROB, the only byte a response changes
+	 *	@ingroup	dnpcommand
+	 */
+	#define DNPCMD_CROBSTATUSIDX		10
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Drive an output to the GPIO pin it is mapped to
+	 *	@ingroup	dnpcommand
+	 */
+	static eReturn_t DNPCommandWriteGPIO(void *pTarget, uint16_t nChannel, bool bActive);
+
+	/**	@brief		Drive an output and remember its state
+	 *	@ingroup	dnpcommand
+	 */
+	static eReturn_t DNPCommandDrive(sDNPCmdOutput_t *pOut, bool bActive);
+
+	/**	@brief		Work out what a CROB control code asks for
+	 *	@param		nCode		Control code from the CROB
+	 *	@param		pbPulse		Returns true for a pulse, false for a latch
+	 *	@param		pbLevel		Returns the state to pulse or latch the output to
+	 *	@return		DNPCmdStat_Success if the code is supported
+	 *	@ingroup	dnpcommand
+	 */
+	static eDNPCmdStatus_t DNPCommandDecode(uint8_t nCode, bool *pbPulse, bool *pbLevel);
+
+	/**	@brief		Check if a CROB can be carried out, without acting on it
+	 *	@ingroup	dnpcommand
+	 */
+	static eDNPCmdStatus_t DNPCommandCheck(sDNPCommandEngine_t *pCmd, sDNPCmdSelect_t *pCROB);
+
+	/**	@brief		Carry out a CROB that passed its checks
+	 *	@ingroup	dnpcommand
+	 */
+	static eDNPCmdStatus_t DNPCommandExecute(sDNPCommandEngine_t *pCmd, sDNPCmdSelect_t *pCROB, uint32_t nNow);
+
+	/**	@brief		Carry out every edge of an output that is due, then place its
+	 *		next edge in the wheel
+	 *	@ingroup	dnpcommand
+	 */
+	static eReturn_t DNPCommandEdges(sDNPCommandEngine_t *pCmd, uint16_t nIndex, uint32_t nNow);
+
+	/**	@brief		Stop a running pulse train, leaving the output in its rest state
+	 *	@ingroup	dnpcommand
+	 */
+	static eReturn_t DNPCommandStopPulse(sDNPCommandEngine_t *pCmd, uint16_t nIndex);
+
+/*****	Functions	*****/
+eReturn_t DNPCommandInitialize(sDNPCommandEngine_t *pCmd, sDNPCmdOutput_t *pOutputs, uint16_t nOutputCnt, uint32_t nSelectTimeout, uint32_t nNow) {
+	uint32_t nCtr;
+
+	if (((nOutputCnt != 0) && (pOutputs == NULL)) || (nOutputCnt == DNPCMD_NOLINK)) {
+		return Fail_Invalid;
+	}
+
+	pCmd->pOutputs = pOutputs;
+	pCmd->nOutputCnt = nOutputCnt;
+
+	for (nCtr = 0; nCtr < nOutputCnt; nCtr++) {
+		memset(&(pOutputs[nCtr]), 0, sizeof(sDNPCmdOutput_t));
+		pOutputs[nCtr].pfWrite = NULL;
+		pOutputs[nCtr].pTarget = NULL;
+		pOutputs[nCtr].nNext = DNPCMD_NOLINK;
+	}
+
+	for (nCtr = 0; nCtr < DNPCMD_WHEELSLOTS; nCtr++) {
+		pCmd->aWheel[nCtr] = DNPCMD_NOLINK;
+	}
+
+	pCmd->nLastTick = nNow;
+	pCmd->nActivePulses = 0;
+
+	pCmd->bSelected = false;
+	pCmd->nSelectTimeout = nSelectTimeout;
+	pCmd->nSelectCnt = 0;
+
+	return Success;
+}
+
+eReturn_t DNPCommandMapOutput(sDNPCommandEngine_t *pCmd, uint16_t nIndex, pfDNPOutputWrite_t pfWrite, void *pTarget, uint16_t nChannel) {
+	if (nIndex >= pCmd->nOutputCnt) {
+		return Fail_Invalid;
+	}
+
+	pCmd->pOutputs[nIndex].pfWrite = pfWrite;
+	pCmd->pOutputs[nIndex].pTarget = pTarget;
+	pCmd->pOutputs[nIndex].nChannel = nChannel;
+
+	return Success;
+}
+
+eReturn_t DNPCommandMapGPIO(sDNPCommandEngine_t *pCmd, uint16_t nIndex, sGPIOIface_t *pGpio, GPIOID_t nPin) {
+	return DNPCommandMapOutput(pCmd, nIndex, &DNPCommandWriteGPIO, pGpio, nPin);
+}
+
+eReturn_t DNPCommandRequest(sDNPCommandEngine_t *pCmd, sDNPMsgBuffer_t *pReq, sDNPMsgBuffer_t *pResp, uint32_t nNow, eDNPInternalIndicators_t *peIIN) {
+	sDNPCmdSelect_t aCROBs[DNPCMD_SELECTMAX];
+	eDNPCmdStatus_t aStatus[DNPCMD_SELECTMAX];
+	sDNPDataValue_t sValue;
+	uint32_t nCnt = 0, nCtr;
+	bool bTooMany = false, bMatch, bAllGood = true;
+
+	*peIIN = DNPIntInd_None;
+
+	if ((pReq->eControlCode != DNPCtrl_Select) && (pReq->eControlCode != DNPCtrl_Operate) && (pReq->eControlCode != DNPCtrl_DirectOperate)) {
+		return Fail_Invalid;
+	}
+
+	//Gather every CROB before acting on any of them
+	while (DNPParserNextDataObject(pReq) == Success) {
+		if ((pReq->sDataObj.eGroup != DNPGrp_BinaryOutputCmd) || (pReq->sDataObj.nVariation != 1)) {
+			*peIIN |= DNPIntInd_ObjectUnknown; //Only CROBs are handled
+			continue;
+		}
+
+		while (DNPParserNextDataValue(pReq, &sValue) == Success) {
+			if (nCnt == DNPCMD_SELECTMAX) {
+				bTooMany = true;
+				break;
+			}
+
+			if ((pReq->sDataObj.nPrefixBytes > 0) && ((pReq->sDataObj.eQualifier & DNPQual_IndexMask) <= DNPQual_IndexPrefix4Bytes)) {
+				//Point index is in the prefix, anything too large to hold is out of range anyway
+				aCROBs[nCnt].nIndex = GetSmallerNum(BytesToUInt32(sValue.nPrefix, true, 0, pReq->sDataObj.nPrefixBytes), DNPCMD_NOLINK);
+			} else {
+				aCROBs[nCnt].nIndex = GetSmallerNum(sValue.nAddress, DNPCMD_NOLINK);
+			}
+
+			memcpy(aCROBs[nCnt].aCROB, sValue.Data.aBytes, DNPCMD_CROBLEN);
+			nCnt += 1;
+		}
+	}
+
+	for (nCtr = 0; nCtr < nCnt; nCtr++) {
+		if (bTooMany == true) {
+			aStatus[nCtr] = DNPCmdStat_TooManyObjs;
+		} else {
+			aStatus[nCtr] = DNPCommandCheck(pCmd, &(aCROBs[nCtr]));
+		}
+
+		if (aCROBs[nCtr].nIndex >= pCmd->nOutputCnt) {
+			*peIIN |= DNPIntInd_OutOfRange;
+		}
+
+		if (aStatus[nCtr] != DNPCmdStat_Success) {
+			bAllGood = false;
+		}
+	}
+
+	switch (pReq->eControlCode) {
+		case DNPCtrl_Select:
+			//Only remember a select that could be operated in full
+			pCmd->bSelected = bAllGood && (nCnt > 0);
+			pCmd->nSelectSeq = pReq->nApplicationSequence;
+			pCmd->nSelectTick = nNow;
+			pCmd->nSelectCnt = nCnt;
+			memcpy(pCmd->aSelected, aCROBs, nCnt * sizeof(sDNPCmdSelect_t));
+			break;
+		case DNPCtrl_Operate:
+			//Operate must follow its select and repeat it exactly
+			bMatch = (pCmd->bSelected == true) && (pReq->nApplicationSequence == ((pCmd->nSelectSeq + 1) & DNPAppHdr_SequenceMask)) && (nCnt == pCmd->nSelectCnt);
+
+			for (nCtr = 0; (bMatch == true) && (nCtr < nCnt); nCtr++) {
+				if ((aCROBs[nCtr].nIndex != pCmd->aSelected[nCtr].nIndex) || (memcmp(aCROBs[nCtr].aCROB, pCmd->aSelected[nCtr].aCROB, DNPCMD_CROBSTATUSIDX) != 0)) {
+					bMatch = false;
+				}
+			}
+
+			for (nCtr = 0; nCtr < nCnt; nCtr++) {
+				if (aStatus[nCtr] != DNPCmdStat_Success) {
+					continue;
+				}
+
+				if (bMatch == false) {
+					aStatus[nCtr] = DNPCmdStat_NoSelect;
+				} else if (DNPCommandTickReached(nNow, pCmd->nSelectTick + pCmd->nSelectTimeout) == true) {
+					aStatus[nCtr] = DNPCmdStat_Timeout;
+				} else {
+					aStatus[nCtr] = DNPCommandExecute(pCmd, &(aCROBs[nCtr]), nNow);
+				}
+			}
+
+			pCmd->bSelected = false; //A select is only good for one operate
+			break;
+		default: //Direct operate
+			for (nCtr = 0; nCtr < nCnt; nCtr++) {
+				if (aStatus[nCtr] == DNPCmdStat_Success) {
+					aStatus[nCtr] = DNPCommandExecute(pCmd, &(aCROBs[nCtr]), nNow);
+				}
+			}
+			break;
+	}
+
+	//Echo each CROB back with its status
+	for (nCtr = 0; nCtr < nCnt; nCtr++) {
+		aCROBs[nCtr].aCROB[DNPCMD_CROBSTATUSIDX] = aStatus[nCtr];
+
+		DNPBuilderAddIndexedObjectHeader(pResp, DNPGrp_BinaryOutputCmd, 1, 1);
+		if (DNPBuilderAddIndexedValue(pResp, aCROBs[nCtr].nIndex, aCROBs[nCtr].aCROB, DNPCMD_CROBLEN) != Success) {
+			return Fail_BufferSize;
+		}
+	}
+
+	return Success;
+}
+
+eReturn_t DNPCommandProcess(sDNPCommandEngine_t *pCmd, uint32_t nNow) {
+	sDNPCmdOutput_t *pOut;
+	uint32_t nSteps, nCtr;
+	uint16_t nIdx, *pnLink;
+	eReturn_t eResult = Success;
+
+	if (DNPCommandTickReached(pCmd->nLastTick, nNow) == true) { //No time has passed
+		return Success;
+	}
+
+	nSteps = nNow - pCmd->nLastTick;
+
+	if (pCmd->nActivePulses == 0) { //Nothing is waiting, skip the walk
+		pCmd->nLastTick = nNow;
+		return Success;
+	}
+
+	if (nSteps > DNPCMD_WHEELSLOTS) { //Fell behind by a full turn, every slot is visited once
+		nSteps = DNPCMD_WHEELSLOTS;
+	}
+
+	//Visit the slot for each tick that passed
+	for (nCtr = nSteps; nCtr > 0; nCtr--) {
+		pnLink = &(pCmd->aWheel[DNPCommandWheelSlot(nNow - nCtr + 1)]);
+
+		while (*pnLink != DNPCMD_NOLINK) {
+			nIdx = *pnLink;
+			pOut = &(pCmd->pOutputs[nIdx]);
+
+			if (DNPCommandTickReached(nNow, pOut->nDue) == false) { //Due on a later turn of the wheel
+				pnLink = &(pOut->nNext);
+				continue;
+			}
+
+			*pnLink = pOut->nNext; //Take it out of the slot, it goes back in wherever its next edge falls
+
+			if (DNPCommandEdges(pCmd, nIdx, nNow) != Success) {
+				eResult = Fail_Unknown;
+			}
+		}
+	}
+
+	pCmd->nLastTick = nNow;
+
+	return eResult;
+}
+
+bool DNPCommandOutputActive(sDNPCommandEngine_t *pCmd, uint16_t nIndex) {
+	if (nIndex >= pCmd->nOutputCnt) {
+		return false;
+	}
+
+	return pCmd->pOutputs[nIndex].bActive;
+}
+
+static eReturn_t DNPCommandWriteGPIO(void *pTarget, uint16_t nChannel, bool bActive) {
+	sGPIOIface_t *pGpio = (sGPIOIface_t *)pTarget;
+
+	if (pGpio->pfDigitalWriteByPin(pGpio, nChannel, bActive) != GPIO_Success) {
+		return Fail_CommError;
+	}
+
+	return Success;
+}
+
+static eReturn_t DNPCommandDrive(sDNPCmdOutput_t *pOut, bool bActive) {
+	pOut->bActive = bActive; //Kept even on failure so a pulse train still moves on
+
+	return pOut->pfWrite(pOut->pTarget, pOut->nChannel, bActive);
+}
+
+static eDNPCmdStatus_t DNPCommandDecode(uint8_t nCode, bool *pbPulse, bool *pbLevel) {
+	uint8_t nOpType = nCode & DNPBinOutCtrl_OpTypeMask;
+
+	switch (nCode & DNPBinOutCtrl_TripCloseMask) {
+		case 0:
+			switch (nOpType) {
+				case DNPBinOutCtrl_PulseOn:
+				case DNPBinOutCtrl_PulseOff:
+					*pbPulse = true;
+					*pbLevel = (nOpType == DNPBinOutCtrl_PulseOn);
+					return DNPCmdStat_Success;
+				case DNPBinOutCtrl_LatchOn:
+				case DNPBinOutCtrl_LatchOff:
+					*pbPulse = false;
+					*pbLevel = (nOpType == DNPBinOutCtrl_LatchOn);
+					return DNPCmdStat_Success;
+				default:
+					return DNPCmdStat_NotSupported;
+			}
+		case DNPBinOutCtrl_Close:
+		case DNPBinOutCtrl_Trip:
+			*pbLevel = ((nCode & DNPBinOutCtrl_TripCloseMask) == DNPBinOutCtrl_Close);
+
+			if ((nOpType == DNPBinOutCtrl_None) || (nOpType == DNPBinOutCtrl_PulseOn)) {
+				*pbPulse = true;
+			} else if (nOpType == DNPBinOutCtrl_LatchOn) {
+				*pbPulse = false;
+			} else {
+				return DNPCmdStat_NotSupported;
+			}
+
+			return DNPCmdStat_Success;
+		default: //Both trip and close is reserved
+			return DNPCmdStat_NotSupported;
+	}
+}
+
+static eDNPCmdStatus_t DNPCommandCheck(sDNPCommandEngine_t *pCmd, sDNPCmdSelect_t *pCROB) {
+	sDNPCmdOutput_t *pOut;
+	bool bPulse, bLevel;
+
+	if ((pCROB->nIndex >= pCmd->nOutputCnt) || (pCmd->pOutputs[pCROB->nIndex].pfWrite == NULL)) {
+		return DNPCmdStat_NotSupported;
+	}
+
+	pOut = &(pCmd->pOutputs[pCROB->nIndex]);
+
+	if (CheckAllBitsInMask(pCROB->aCROB[0], DNPBinOutCtrl_Clear) == true) { //Stopping a pulse train is always allowed
+		return DNPCmdStat_Success;
+	}
+
+	if (pOut->bPulsing == true) {
+		return DNPCmdStat_AlreadyActive;
+	}
+
+	return DNPCommandDecode(pCROB->aCROB[0], &bPulse, &bLevel);
+}
+
+static eDNPCmdStatus_t DNPCommandExecute(sDNPCommandEngine_t *pCmd, sDNPCmdSelect_t *pCROB, uint32_t nNow) {
+	sDNPCmdOutput_t *pOut = &(pCmd->pOutputs[pCROB->nIndex]);
+	bool bPulse, bLevel;
+
+	if (CheckAllBitsInMask(pCROB->aCROB[0], DNPBinOutCtrl_Clear) == true) {
+		if ((pOut->bPulsing == true) && (DNPCommandStopPulse(pCmd, pCROB->nIndex) != Success)) {
+			return DNPCmdStat_HardwareError;
+		}
+
+		return DNPCmdStat_Success;
+	}
+
+	//An earlier CROB of the same request may have started a train since the checks
+	if (pOut->bPulsing == true) {
+		return DNPCmdStat_AlreadyActive;
+	}
+
+	DNPCommandDecode(pCROB->aCROB[0], &bPulse, &bLevel);
+
+	if (pCROB->aCROB[1] == 0) { //Count of 0 means do nothing
+		return DNPCmdStat_Success;
+	}
+
+	if (DNPCommandDrive(pOut, bLevel) != Success) {
+		return DNPCmdStat_HardwareError;
+	}
+
+	if (bPulse == false) { //Latched, nothing more to do
+		return DNPCmdStat_Success;
+	}
+
+	pOut->bPulseLevel = bLevel;
+	pOut->nRemaining = pCROB->aCROB[1];
+	pOut->nPulseTime = BytesToUInt32(pCROB->aCROB, true, 2, 4);
+	pOut->nRestTime = BytesToUInt32(pCROB->aCROB, true, 6, 4);
+	pOut->nDue = nNow + pOut->nPulseTime;
+	pOut->bPulsing = true;
+	pCmd->nActivePulses += 1;
+
+	//Requests can carry an older tick count than the wheel has reached
+	if (DNPCommandTickReached(pCmd->nLastTick, nNow) == true) {
+		nNow = pCmd->nLastTick;
+	}
+
+	if (DNPCommandEdges(pCmd, pCROB->nIndex, nNow) != Success) {
+		return DNPCmdStat_HardwareError;
+	}
+
+	return DNPCmdStat_Success;
+}
+
+static eReturn_t DNPCommandEdges(sDNPCommandEngine_t *pCmd, uint16_t nIndex, uint32_t nNow) {
+	sDNPCmdOutput_t *pOut = &(pCmd->pOutputs[nIndex]);
+	uint32_t nSlot;
+	eReturn_t eResult = Success;
+
+	//Catch up on every edge that is due, a late call still ends the train on time
+	while ((pOut->bPulsing == true) && (DNPCommandTickReached(nNow, pOut->nDue) == true)) {
+		if (pOut->bActive == pOut->bPulseLevel) { //End of a pulse
+			if (DNPCommandDrive(pOut, !pOut->bPulseLevel) != Success) {
+				eResult = Fail_CommError;
+			}
+
+			pOut->nRemaining -= 1;
+			if (pOut->nRemaining == 0) {
+				pOut->bPulsing = false;
+				pCmd->nActivePulses -= 1;
+			} else {
+				pOut->nDue += pOut->nRestTime;
+			}
+		} else { //Start of the next pulse
+			if (DNPCommandDrive(pOut, pOut->bPulseLevel) != Success) {
+				eResult = Fail_CommError;
+			}
+
+			pOut->nDue += pOut->nPulseTime;
+		}
+	}
+
+	if (pOut->bPulsing == true) {
+		nSlot = DNPCommandWheelSlot(pOut->nDue);
+		pOut->nNext = pCmd->aWheel[nSlot];
+		pCmd->aWheel[nSlot] = nIndex;
+	}
+
+	return eResult;
+}
+
+static eReturn_t DNPCommandStopPulse(sDNPCommandEngine_t *pCmd, uint16_t nIndex) {
+	sDNPCmdOutput_t *pOut = &(pCmd->pOutputs[nIndex]);
+	uint16_t *pnLink = &(pCmd->aWheel[DNPCommandWheelSlot(pOut->nDue)]);
+
+	while (*pnLink != DNPCMD_NOLINK) {
+		if (*pnLink == nIndex) {
+			*pnLink = pOut->nNext;
+			break;
+		}
+
+		pnLink = &(pCmd->pOutputs[*pnLink].nNext);
+	}
+
+	pOut->nNext = DNPCMD_NOLINK;
+	pOut->bPulsing = false;
+	pCmd->nActivePulses -= 1;
+
+	return DNPCommandDrive(pOut, !pOut->bPulseLevel);
+}
+
@@ -0,0 +1,219 @@
+/**	@defgroup	dnpcommand		DNP Command Engine
+	@ingroup	dnp
+	@brief		Carries out control relay output blocks on behalf of an outstation
+	@details	v0.1
+	#Description
+		Handles select, operate, and direct operate requests holding group 12
+		variation 1 control relay output blocks (CROBs).  Each binary output
+		point is mapped to a function that drives it, GPIO pins are mapped
+		directly and other outputs such as PCA9685 channels are mapped through
+		a small write function supplied by the application.
+		A select is remembered along with the CROBs it carried.  The operate
+		that follows must use the next application sequence, repeat the same
+		CROBs exactly, and arrive before the select times out.
+		Pulse trains never block.  Every pulse edge is placed in a single timer
+		wheel, an array of slots indexed by the tick count the edge is due.
+		Each call to DNPCommandProcess() only visits the slots for the ticks that
+		passed since the last call, so any number of pulsing outputs share one
+		tick source and cost nothing while they wait.  Edges are scheduled from
+		when the last edge was due rather than when it was carried out, so late
+		processing does not stretch the rest of the train.
+
+		Pulse On holds the output active for the on time, then inactive for the
+		off time between repeats.  Pulse Off does the same with the levels
+		swapped.  Latch On and Latch Off set the output and leave it.  Close and
+		Trip with a Null or Pulse On operation pulse the output active or
+		inactive, with Latch On they latch it.  The Clear bit stops a running
+		pulse train.  A count of 0 is accepted and does nothing.
+
+	#Usage
+		Ticks from the time interface are taken as milliseconds, the unit of
+		the CROB on and off times.  Initialize the engine with an array of
+		outputs, map each point, then give the engine to the outstation with
+		DNPOutstationSetCommands().  The outstation runs the scheduler each time
+		it is processed, call DNPCommandProcess() more often than that if pulse
+		edges need to be closer to the requested times.
+
+	#File Information
+		File:	DNPCommandEngine.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPCOMMANDENGINE_H
+	#define __DNPCOMMANDENGINE_H
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "GPIOGeneralInterface.h"
+
+	#include "DNPBase.h"
+	#include "DNPMessageBuilder.h"
+	#include "DNPMessageParser.h"
+
+/*****	Defines		*****/
+	#ifndef DNPCMD_WHEELSLOTS
+		/**	@brief		Number of slots in the pulse timer wheel, must be a power of 2
+		 *	@details	Edges due further out than this many ticks wait for the
+		 *		wheel to come around again.
+		 *	@ingroup	dnpcommand
+		 */
+		#define DNPCMD_WHEELSLOTS		64
+	#endif
+
+	#ifndef DNPCMD_SELECTMAX
+		/**	@brief		Number of CROBs a single request can carry
+		 *	@ingroup	dnpcommand
+		 */
+		#define DNPCMD_SELECTMAX		8
+	#endif
+
+	/**	@brief		Number of bytes in a control relay output block
+	 *	@ingroup	dnpcommand
+	 */
+	#define DNPCMD_CROBLEN			11
+
+	/**	@brief		Marks the end of a list of outputs in a wheel slot
+	 *	@ingroup	dnpcommand
+	 */
+	#define DNPCMD_NOLINK			0xFFFF
+
+/*****	Definitions	*****/
+	/**	@brief		Function that drives a single output
+	 *	@param		pTarget		Device the output belongs to
+	 *	@param		nChannel	Output on the device to drive
+	 *	@param		bActive		True to energize the output
+	 *	@return		Success if the output was driven
+	 *	@ingroup	dnpcommand
+	 */
+	typedef eReturn_t (*pfDNPOutputWrite_t)(void *pTarget, uint16_t nChannel, bool bActive);
+
+	/**	@brief		Mapping and pulse state of a single binary output point
+	 *	@ingroup	dnpcommand
+	 */
+	typedef struct sDNPCmdOutput_t {
+		pfDNPOutputWrite_t pfWrite;				/**< Drives the output, NULL if the point is not mapped */
+		void *pTarget;							/**< Device the output belongs to */
+		uint16_t nChannel;						/**< Output on the device */
+		bool bActive;							/**< Last state the output was driven to */
+
+		bool bPulsing;							/**< True while a pulse train is scheduled */
+		bool bPulseLevel;						/**< State held for the pulse time */
+		uint8_t nRemaining;						/**< Pulses left to complete */
+		uint32_t nPulseTime;					/**< Ticks the pulse level is held */
+		uint32_t nRestTime;						/**< Ticks the opposite level is held between pulses */
+		uint32_t nDue;							/**< Tick count the next edge is due */
+		uint16_t nNext;							/**< Next output in the same wheel slot */
+	} sDNPCmdOutput_t;
+
+	/**	@brief		A CROB remembered from a select request
+	 *	@ingroup	dnpcommand
+	 */
+	typedef struct sDNPCmdSelect_t {
+		uint16_t nIndex;						/**< Point the CROB controls */
+		uint8_t aCROB[DNPCMD_CROBLEN];			/**< Bytes of the CROB as they were received */
+	} sDNPCmdSelect_t;
+
+	/**	@brief		State of a DNP command engine
+	 *	@ingroup	dnpcommand
+	 */
+	typedef struct sDNPCommandEngine_t {
+		sDNPCmdOutput_t *pOutputs;				/**< Binary output points */
+		uint16_t nOutputCnt;					/**< Number of binary output points */
+
+		uint16_t aWheel[DNPCMD_WHEELSLOTS];		/**< First output with an edge due in each slot */
+		uint32_t nLastTick;						/**< Tick count the wheel was last advanced to */
+		uint32_t nActivePulses;					/**< Number of outputs with a pulse train running */
+
+		bool bSelected;							/**< True while a select waits for its operate */
+		uint8_t nSelectSeq;						/**< Application sequence of the select */
+		uint32_t nSelectTick;					/**< Tick count the select was received */
+		uint32_t nSelectTimeout;				/**< Ticks an operate is accepted after its select */
+		uint32_t nSelectCnt;					/**< Number of CROBs in the select */
+		sDNPCmdSelect_t aSelected[DNPCMD_SELECTMAX];	/**< CROBs in the select */
+	} sDNPCommandEngine_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare a command engine for use
+	 *	@details	All points start unmapped and inactive
+	 *	@param		pCmd			Command engine to initialize
+	 *	@param		pOutputs		Array to hold the state of each binary output
+	 *	@param		nOutputCnt		Number of binary outputs
+	 *	@param		nSelectTimeout	Ticks an operate is accepted after its select
+	 *	@param		nNow			Current tick count
+	 *	@return		Success if the engine is ready, Fail_Invalid if a parameter
+	 *		can not be used
+	 *	@ingroup	dnpcommand
+	 */
+	eReturn_t DNPCommandInitialize(sDNPCommandEngine_t *pCmd, sDNPCmdOutput_t *pOutputs, uint16_t nOutputCnt, uint32_t nSelectTimeout, uint32_t nNow);
+
+	/**	@brief		Map a binary output point to an output driven by a function
+	 *	@details	Use this for outputs that are not GPIO pins.  A PCA9685 channel
+	 *		is mapped with a function that calls PCA9685SetDigital().
+	 *	@param		pCmd			Command engine holding the point
+	 *	@param		nIndex			Index of the binary output point
+	 *	@param		pfWrite			Function to drive the output
+	 *	@param		pTarget			Device passed to the function
+	 *	@param		nChannel		Output on the device passed to the function
+	 *	@return		Success if the point was mapped, Fail_Invalid if the index
+	 *		does not exist
+	 *	@ingroup	dnpcommand
+	 */
+	eReturn_t DNPCommandMapOutput(sDNPCommandEngine_t *pCmd, uint16_t nIndex, pfDNPOutputWrite_t pfWrite, void *pTarget, uint16_t nChannel);
+
+	/**	@brief		Map a binary output point to a GPIO pin
+	 *	@details	The pin must already be set as a digital output
+	 *	@param		pCmd			Command engine holding the point
+	 *	@param		nIndex			Index of the binary output point
+	 *	@param		pGpio			GPIO interface the pin belongs to
+	 *	@param		nPin			Pin to drive
+	 *	@return		Success if the point was mapped, Fail_Invalid if the index
+	 *		does not exist
+	 *	@ingroup	dnpcommand
+	 */
+	eReturn_t DNPCommandMapGPIO(sDNPCommandEngine_t *pCmd, uint16_t nIndex, sGPIOIface_t *pGpio, GPIOID_t nPin);
+
+	/**	@brief		Handle a select, operate, or direct operate request
+	 *	@details	The request's objects are read and a copy of each CROB is
+	 *		added to the response with its status filled in.
+	 *	@param		pCmd			Command engine to carry out the request
+	 *	@param		pReq			Complete request from the master
+	 *	@param		pResp			Response being built, the objects are added to it
+	 *	@param		nNow			Current tick count
+	 *	@param		peIIN			Returns internal indicators the response should raise
+	 *	@return		Success if the request was handled, Fail_Invalid if it is not
+	 *		a command request, or Fail_BufferSize if the response ran out of room
+	 *	@ingroup	dnpcommand
+	 */
+	eReturn_t DNPCommandRequest(sDNPCommandEngine_t *pCmd, sDNPMsgBuffer_t *pReq, sDNPMsgBuffer_t *pResp, uint32_t nNow, eDNPInternalIndicators_t *peIIN);
+
+	/**	@brief		Carry out all pulse edges that have come due
+	 *	@param		pCmd			Command engine to process
+	 *	@param		nNow			Current tick count
+	 *	@return		Success if all edges were carried out, Fail_Unknown if an
+	 *		output could not be driven
+	 *	@ingroup	dnpcommand
+	 */
+	eReturn_t DNPCommandProcess(sDNPCommandEngine_t *pCmd, uint32_t nNow);
+
+	/**	@brief		Check if a binary output point is active
+	 *	@param		pCmd			Command engine holding the point
+	 *	@param		nIndex			Index of the binary output point
+	 *	@return		True if the output was last driven active
+	 *	@ingroup	dnpcommand
+	 */
+	bool DNPCommandOutputActive(sDNPCommandEngine_t *pCmd, uint16_t nIndex);
+
+/*****	Functions	*****/
+
+
+#endif
+
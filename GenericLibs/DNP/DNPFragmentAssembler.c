@@ -0,0 +1,165 @@
+/**	File:	DNPFragmentAssembler.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "DNPFragmentAssembler.h"
+
+/*****	Defines		*****/
+	/**	@brief		Bytes in the application header of a request
+	 *	@ingroup	dnpassembler
+	 */
+	#define DNPASM_REQHEADERLEN		2
+
+	/**	@brief		Bytes in the application header of a response, including the
+	 *		internal indicators
+	 *	@ingroup	dnpassembler
+	 */
+	#define DNPASM_RESPHEADERLEN	4
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Describe the gathered fragment for the caller
+	 *	@ingroup	dnpassembler
+	 */
+	static eReturn_t DNPAssemblerComplete(sDNPAssembler_t *pAsm, sDNPAppFragment_t *pFrag);
+
+/*****	Functions	*****/
+eReturn_t DNPAssemblerInitialize(sDNPAssembler_t *pAsm, uint8_t *pPool, uint32_t nPoolSize) {
+	if ((pPool == NULL) || (nPoolSize < DNPASM_RESPHEADERLEN)) {
+		return Fail_Invalid;
+	}
+
+	pAsm->pPool = pPool;
+	pAsm->nPoolSize = GetSmallerNum(nPoolSize, DNP_APPFRAGMENTMAX);
+	pAsm->nFragments = 0;
+	pAsm->nDropped = 0;
+
+	DNPAssemblerReset(pAsm);
+
+	return Success;
+}
+
+void DNPAssemblerReset(sDNPAssembler_t *pAsm) {
+	pAsm->nLen = 0;
+	pAsm->bActive = false;
+
+	return;
+}
+
+eReturn_t DNPAssemblerAddFrame(sDNPAssembler_t *pAsm, const sDNPLinkFrame_t *pFrame, sDNPAppFragment_t *pFrag) {
+	uint8_t nSeq;
+	uint32_t nCtr;
+
+	if (pFrame->bHasTransport == false) { //Link layer only, nothing to gather
+		return Warn_Incomplete;
+	}
+
+	nSeq = pFrame->nTransportHdr & DNPTransHdr_SequenceMask;
+
+	if (CheckAllBitsInMask(pFrame->nTransportHdr, DNPTransHdr_FirstMsg) == true) {
+		if (pAsm->bActive == true) { //Previous fragment never finished
+			pAsm->nDropped += 1;
+		}
+
+		pAsm->nLen = 0;
+		pAsm->bActive = true;
+		pAsm->nDestAddr = pFrame->nDestAddr;
+		pAsm->nSourceAddr = pFrame->nSourceAddr;
+	} else if (pAsm->bActive == false) { //Missed the first segment, can't use this
+		return Warn_Incomplete;
+	} else if ((nSeq != pAsm->nNextSeq) || (pFrame->nSourceAddr != pAsm->nSourceAddr)) {
+		//Segment was lost or belongs to another fragment, this one can't be completed
+		pAsm->nDropped += 1;
+		DNPAssemblerReset(pAsm);
+		return Fail_Invalid;
+	}
+
+	if (pAsm->nLen + pFrame->nUserDataLen > pAsm->nPoolSize) {
+		pAsm->nDropped += 1;
+		DNPAssemblerReset(pAsm);
+		return Fail_BufferSize;
+	}
+
+	//Copy straight out of the frame, between the CRC values
+	for (nCtr = 0; nCtr < pFrame->nSpanCnt; nCtr++) {
+		memcpy(&(pAsm->pPool[pAsm->nLen]), pFrame->aSpans[nCtr].pData, pFrame->aSpans[nCtr].nLen);
+		pAsm->nLen += pFrame->aSpans[nCtr].nLen;
+	}
+
+	pAsm->nNextSeq = (nSeq + 1) & DNPTransHdr_SequenceMask;
+
+	if (CheckAllBitsInMask(pFrame->nTransportHdr, DNPTransHdr_LastMsg) == false) {
+		return Warn_Incomplete; //More segments coming
+	}
+
+	pAsm->bActive = false;
+
+	return DNPAssemblerComplete(pAsm, pFrag);
+}
+
+eReturn_t DNPAssemblerReceive(sDNPAssembler_t *pAsm, sDNPDeframer_t *pDefr, const uint8_t *pData, uint32_t nDataLen, uint32_t *pnDataUsed, sDNPAppFragment_t *pFrag) {
+	uint32_t nIdx = 0, nUsed;
+	eReturn_t eResult = Warn_Incomplete;
+	sDNPLinkFrame_t sFrame;
+
+	while (nIdx < nDataLen) {
+		eResult = DNPDeframerReceive(pDefr, &(pData[nIdx]), nDataLen - nIdx, &nUsed, &sFrame);
+		nIdx += nUsed;
+
+		if (eResult == Success) {
+			eResult = DNPAssemblerAddFrame(pAsm, &sFrame, pFrag);
+		}
+
+		if (eResult != Warn_Incomplete) { //Completed a fragment or the caller needs to know of a failure
+			break;
+		}
+	}
+
+	*pnDataUsed = nIdx;
+	return eResult;
+}
+
+static eReturn_t DNPAssemblerComplete(sDNPAssembler_t *pAsm, sDNPAppFragment_t *pFrag) {
+	if (pAsm->nLen < DNPASM_REQHEADERLEN) { //No room for a function code
+		pAsm->nDropped += 1;
+		return Fail_Invalid;
+	}
+
+	pFrag->pData = pAsm->pPool;
+	pFrag->nLen = pAsm->nLen;
+	pFrag->nDestAddr = pAsm->nDestAddr;
+	pFrag->nSourceAddr = pAsm->nSourceAddr;
+	pFrag->nAppHeader = pAsm->pPool[0];
+	pFrag->nSequence = pAsm->pPool[0] & DNPAppHdr_SequenceMask;
+	pFrag->eControlCode = (eDNPControlCodes_t)pAsm->pPool[1];
+	pFrag->nIdx = DNPASM_REQHEADERLEN;
+
+	//Responses carry internal indicators after the function code
+	if ((pFrag->eControlCode == DNPCtrl_Response) || (pFrag->eControlCode == DNPCtrl_Unsolicited)) {
+		if (pAsm->nLen < DNPASM_RESPHEADERLEN) {
+			pAsm->nDropped += 1;
+			return Fail_Invalid;
+		}
+
+		pFrag->eIntIndicators = (eDNPInternalIndicators_t)(pAsm->pPool[2] | ((uint16_t)pAsm->pPool[3] << 8));
+		pFrag->nIdx = DNPASM_RESPHEADERLEN;
+	} else {
+		pFrag->eIntIndicators = DNPIntInd_None;
+	}
+
+	memset(&(pFrag->sDataObj), 0, sizeof(sDNPDataObject_t));
+	pFrag->sDataObj.eGroup = DNPGrp_Unknown; //No object has been read
+	pAsm->nFragments += 1;
+
+	return Success;
+}
@@ -0,0 +1,138 @@
+/**	@defgroup	dnpassembler		DNP Fragment Assembler
+	@ingroup	dnp
+	@brief		Reassembles application fragments into a caller supplied pool
+	@details	v0.1
+	#Description
+		The message buffer holds room for a fixed number of link frames and their
+		user data whether or not they are used, and can not hold an application
+		fragment larger than that.  The assembler instead gathers the transport
+		segments of an application fragment directly into a pool given to it by
+		the caller.  Only the application data is kept, the link headers and CRC
+		values are left behind in the deframer, so the pool only needs to be as
+		large as the biggest fragment expected.  Up to DNP_APPFRAGMENTMAX bytes
+		are supported, the most the protocol allows.
+		Segments must arrive in transport sequence order from a single source.
+		A segment out of order discards the fragment being gathered.
+		Responses made of several application fragments are delivered one
+		fragment at a time, the application header flags tell if more follow.
+
+	#Usage
+		Initialize the assembler with a pool, then either pass it received
+		bytes along with a deframer or pass it link frames that have already
+		been deframed.  When a fragment is complete it is described by an
+		sDNPAppFragment_t that can be walked with DNPParserFragmentNextObject().
+		The fragment data stays in the pool until the next call that gives the
+		assembler more data.
+
+	#File Information
+		File:	DNPFragmentAssembler.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPFRAGMENTASSEMBLER_H
+	#define __DNPFRAGMENTASSEMBLER_H
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+
+	#include "DNPBase.h"
+	#include "DNPLinkDeframer.h"
+
+/*****	Defines		*****/
+	/**	@brief		Largest application fragment the protocol allows
+	 *	@ingroup	dnpassembler
+	 */
+	#define DNP_APPFRAGMENTMAX		2048
+
+/*****	Definitions	*****/
+	/**	@brief		A complete application fragment held in an assembler pool
+	 *	@ingroup	dnpassembler
+	 */
+	typedef struct sDNPAppFragment_t {
+		const uint8_t *pData;						/**< Application data, starting with the application header */
+		uint32_t nLen;								/**< Number of bytes of application data */
+		uint32_t nIdx;								/**< Index of the next unread byte */
+		uint16_t nDestAddr;							/**< Destination address of the fragment */
+		uint16_t nSourceAddr;						/**< Source address of the fragment */
+		uint8_t nAppHeader;							/**< Application header byte, holds the FIR, FIN, CON, and UNS flags */
+		uint8_t nSequence;							/**< Application sequence number */
+		eDNPControlCodes_t eControlCode;			/**< Function code of the fragment */
+		eDNPInternalIndicators_t eIntIndicators;	/**< Internal indicators, only in responses */
+		sDNPDataObject_t sDataObj;					/**< Details of the data object being read */
+	} sDNPAppFragment_t;
+
+	/**	@brief		State of a fragment assembler
+	 *	@ingroup	dnpassembler
+	 */
+	typedef struct sDNPAssembler_t {
+		uint8_t *pPool;								/**< Caller supplied storage for the fragment */
+		uint32_t nPoolSize;							/**< Number of bytes in the pool */
+		uint32_t nLen;								/**< Number of bytes gathered in the pool */
+		bool bActive;								/**< True while a fragment is being gathered */
+		uint8_t nNextSeq;							/**< Transport sequence expected in the next segment */
+		uint16_t nDestAddr;							/**< Destination address of the fragment being gathered */
+		uint16_t nSourceAddr;						/**< Source address of the fragment being gathered */
+		uint32_t nFragments;						/**< Count of fragments completed */
+		uint32_t nDropped;							/**< Count of fragments discarded */
+	} sDNPAssembler_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare an assembler for use
+	 *	@param		pAsm		Assembler object to initialize
+	 *	@param		pPool		Storage to gather fragments in
+	 *	@param		nPoolSize	Number of bytes in the pool, no more than
+	 *		DNP_APPFRAGMENTMAX are used
+	 *	@return		Success if the assembler is ready, Fail_Invalid if the pool
+	 *		can not hold an application header
+	 *	@ingroup	dnpassembler
+	 */
+	eReturn_t DNPAssemblerInitialize(sDNPAssembler_t *pAsm, uint8_t *pPool, uint32_t nPoolSize);
+
+	/**	@brief		Discard any partially gathered fragment
+	 *	@param		pAsm		Assembler object to reset
+	 *	@ingroup	dnpassembler
+	 */
+	void DNPAssemblerReset(sDNPAssembler_t *pAsm);
+
+	/**	@brief		Add the user data of a link frame to the fragment
+	 *	@param		pAsm		Assembler gathering the fragment
+	 *	@param		pFrame		Validated link frame
+	 *	@param		pFrag		Returns the completed fragment
+	 *	@return		Success if the frame completed a fragment, Warn_Incomplete if
+	 *		more segments are needed, Fail_BufferSize if the fragment is too
+	 *		large for the pool, or Fail_Invalid if the segment was out of order
+	 *		or the fragment is damaged
+	 *	@ingroup	dnpassembler
+	 */
+	eReturn_t DNPAssemblerAddFrame(sDNPAssembler_t *pAsm, const sDNPLinkFrame_t *pFrame, sDNPAppFragment_t *pFrag);
+
+	/**	@brief		Process received data looking for a complete fragment
+	 *	@details	Returns as soon as a fragment is completed, call again with the
+	 *		unused data to continue.
+	 *	@param		pAsm		Assembler gathering the fragment
+	 *	@param		pDefr		Deframer extracting link frames from the data
+	 *	@param		pData		Buffer holding the newly received data
+	 *	@param		nDataLen	Number of bytes in the buffer
+	 *	@param		pnDataUsed	Returns the number of bytes consumed from the buffer
+	 *	@param		pFrag		Returns the completed fragment
+	 *	@return		Success if a fragment was completed, Warn_Incomplete if all
+	 *		data was consumed without completing one, or a failure code if a
+	 *		frame or fragment was discarded
+	 *	@ingroup	dnpassembler
+	 */
+	eReturn_t DNPAssemblerReceive(sDNPAssembler_t *pAsm, sDNPDeframer_t *pDefr, const uint8_t *pData, uint32_t nDataLen, uint32_t *pnDataUsed, sDNPAppFragment_t *pFrag);
+
+/*****	Functions	*****/
+
+
+#endif
+
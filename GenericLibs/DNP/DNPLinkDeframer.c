@@ -0,0 +1,278 @@
+/**	File:	DNPLinkDeframer.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "DNPLinkDeframer.h"
+
+/*****	Defines		*****/
+	#define DNPLINK_STARTBYTE0		((uint8_t)(DNP_MSGSTARTBYTES >> 8))
+
+	#define DNPLINK_STARTBYTE1		((uint8_t)(DNP_MSGSTARTBYTES & 0x00FF))
+
+	/**	@brief		Number of bytes the length byte counts that are not user data
+	 *	@ingroup	dnplinkdeframer
+	 */
+	#define DNPLINK_LENHEADERBYTES	5
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static sCRC16Context_t gDNPLinkCRC;
+
+	static bool gbDNPLinkCRCReady = false;
+
+/*****	Prototypes 	*****/
+	static bool DNPLinkCRCMatch(const uint8_t *pBytes, uint32_t nLen);
+
+/*****	Functions	*****/
+const sCRC16Context_t *DNPLinkCRCContext(void) {
+	if (gbDNPLinkCRCReady == false) {
+		CRC16ContextInitialize(&gDNPLinkCRC, CRC_DNP);
+		gbDNPLinkCRCReady = true;
+	}
+
+	return &gDNPLinkCRC;
+}
+
+static bool DNPLinkCRCMatch(const uint8_t *pBytes, uint32_t nLen) {
+	crc16_t nCRCVal, nMsgCRC;
+
+	nCRCVal = CRC16ContextCalculate(&gDNPLinkCRC, pBytes, nLen);
+	nMsgCRC = ((uint16_t)pBytes[nLen] << 8) | pBytes[nLen + 1]; //CRC that follows the data
+
+	return (nCRCVal == nMsgCRC);
+}
+
+uint32_t DNPLinkFrameSize(uint8_t nLengthByte) {
+	uint32_t nUserLen;
+
+	if (nLengthByte < DNPLINK_LENHEADERBYTES) {
+		return 0;
+	}
+
+	nUserLen = nLengthByte - DNPLINK_LENHEADERBYTES;
+
+	//Every full or partial chunk of user data gets a CRC
+	return DNP_MSGHEADERLEN + nUserLen + (((nUserLen + DNP_DATACRCCHUNKSIZE - 1) / DNP_DATACRCCHUNKSIZE) * sizeof(crc16_t));
+}
+
+uint32_t DNPLinkFindStart(const uint8_t *pData, uint32_t nDataLen) {
+	const uint8_t *pCurr = pData;
+	const uint8_t *pEnd = pData + nDataLen;
+
+	while (pCurr < pEnd) {
+		//Let the library do the byte search, it is far quicker than checking each pair
+		pCurr = memchr(pCurr, DNPLINK_STARTBYTE0, pEnd - pCurr);
+		if (pCurr == NULL) {
+			return nDataLen;
+		}
+
+		if ((pCurr + 1 == pEnd) || (pCurr[1] == DNPLINK_STARTBYTE1)) {
+			return pCurr - pData;
+		}
+
+		pCurr += 1;
+	}
+
+	return nDataLen;
+}
+
+uint32_t DNPLinkResync(uint8_t *pBytes, uint32_t nLen) {
+	uint32_t nStart;
+
+	if (nLen <= 1) {
+		return 0;
+	}
+
+	//Skip the false start byte and look for another
+	nStart = 1 + DNPLinkFindStart(&(pBytes[1]), nLen - 1);
+
+	memmove(pBytes, &(pBytes[nStart]), nLen - nStart);
+
+	return nLen - nStart;
+}
+
+uint32_t DNPLinkHeaderCheck(const uint8_t *pHeader) {
+	DNPLinkCRCContext(); //Make sure the tables are ready
+
+	if ((pHeader[DNPHdrIdx_StartBytes] != DNPLINK_STARTBYTE0) || (pHeader[DNPHdrIdx_StartBytes + 1] != DNPLINK_STARTBYTE1)) {
+		return 0;
+	}
+
+	if (DNPLinkCRCMatch(pHeader, DNPHdrIdx_CRC) == false) {
+		return 0;
+	}
+
+	return DNPLinkFrameSize(pHeader[DNPHdrIdx_DataLength]);
+}
+
+eReturn_t DNPLinkFrameDecode(const uint8_t *pBytes, sDNPLinkFrame_t *pFrame) {
+	uint32_t nUserLen, nBlockLen, nIdx;
+	sDNPSpan_t *pSpan;
+
+	pFrame->nFrameLen = DNPLinkHeaderCheck(pBytes);
+	if (pFrame->nFrameLen == 0) {
+		return Fail_Invalid;
+	}
+
+	pFrame->pFrame = pBytes;
+	pFrame->nDestAddr = pBytes[DNPHdrIdx_DestAddr] | ((uint16_t)pBytes[DNPHdrIdx_DestAddr + 1] << 8);
+	pFrame->nSourceAddr = pBytes[DNPHdrIdx_SourceAddr] | ((uint16_t)pBytes[DNPHdrIdx_SourceAddr + 1] << 8);
+	pFrame->eDataControl = (eDNPDataControl_t)pBytes[DNPHdrIdx_DataControl];
+	pFrame->bHasTransport = false;
+	pFrame->nTransportHdr = 0;
+	pFrame->nUserDataLen = 0;
+	pFrame->nSpanCnt = 0;
+
+	nUserLen = pBytes[DNPHdrIdx_DataLength] - DNPLINK_LENHEADERBYTES;
+	nIdx = DNP_MSGHEADERLEN;
+
+	while (nUserLen > 0) {
+		nBlockLen = GetSmallerNum(nUserLen, DNP_DATACRCCHUNKSIZE);
+
+		if (DNPLinkCRCMatch(&(pBytes[nIdx]), nBlockLen) == false) {
+			return Fail_Invalid;
+		}
+
+		pSpan = &(pFrame->aSpans[pFrame->nSpanCnt]);
+		pSpan->pData = &(pBytes[nIdx]);
+		pSpan->nLen = nBlockLen;
+
+		if (nIdx == DNP_MSGHEADERLEN) { //First byte of user data is the transport header
+			pFrame->bHasTransport = true;
+			pFrame->nTransportHdr = pBytes[nIdx];
+			pSpan->pData += 1;
+			pSpan->nLen -= 1;
+		}
+
+		if (pSpan->nLen > 0) {
+			pFrame->nUserDataLen += pSpan->nLen;
+			pFrame->nSpanCnt += 1;
+		}
+
+		nIdx += nBlockLen + sizeof(crc16_t);
+		nUserLen -= nBlockLen;
+	}
+
+	return Success;
+}
+
+eReturn_t DNPLinkFrameCopyUserData(const sDNPLinkFrame_t *pFrame, uint8_t *pDest, uint32_t nDestSize) {
+	uint32_t nCtr;
+
+	if (pFrame->nUserDataLen > nDestSize) {
+		return Fail_BufferSize;
+	}
+
+	for (nCtr = 0; nCtr < pFrame->nSpanCnt; nCtr++) {
+		memcpy(pDest, pFrame->aSpans[nCtr].pData, pFrame->aSpans[nCtr].nLen);
+		pDest += pFrame->aSpans[nCtr].nLen;
+	}
+
+	return Success;
+}
+
+eReturn_t DNPDeframerInitialize(sDNPDeframer_t *pDefr) {
+	DNPLinkCRCContext(); //Build the CRC tables now rather than on the first frame
+	pDefr->nBadFrames = 0;
+
+	DNPDeframerReset(pDefr);
+
+	return Success;
+}
+
+void DNPDeframerReset(sDNPDeframer_t *pDefr) {
+	pDefr->nFrameLen = 0;
+	pDefr->nFrameSize = 0;
+
+	return;
+}
+
+eReturn_t DNPDeframerReceive(sDNPDeframer_t *pDefr, const uint8_t *pData, uint32_t nDataLen, uint32_t *pnDataUsed, sDNPLinkFrame_t *pFrame) {
+	uint32_t nUsed = 0, nCopy, nFrameSize;
+	eReturn_t eResult;
+
+	*pnDataUsed = 0; //Set the return in case of failure
+
+	if ((pData == NULL) || (pFrame == NULL)) {
+		return Fail_Invalid;
+	}
+
+	while (nUsed < nDataLen) {
+		if (pDefr->nFrameLen == 0) { //Looking for the start of a new frame
+			nUsed += DNPLinkFindStart(&(pData[nUsed]), nDataLen - nUsed);
+			if (nUsed == nDataLen) {
+				break;
+			}
+
+			if (nDataLen - nUsed >= DNP_MSGHEADERLEN) { //Header is all here, maybe the whole frame is
+				nFrameSize = DNPLinkHeaderCheck(&(pData[nUsed]));
+
+				if (nFrameSize == 0) { //Not a real header, skip these start bytes and resume the search
+					pDefr->nBadFrames += 1;
+					*pnDataUsed = nUsed + 1;
+					return Fail_Invalid;
+				}
+
+				if (nDataLen - nUsed >= nFrameSize) { //Entire frame is here, no need to gather it
+					eResult = DNPLinkFrameDecode(&(pData[nUsed]), pFrame);
+					*pnDataUsed = nUsed + nFrameSize;
+
+					if (eResult != Success) {
+						pDefr->nBadFrames += 1;
+					}
+
+					return eResult;
+				}
+			}
+		} else if ((pDefr->nFrameLen == 1) && (pData[nUsed] != DNPLINK_STARTBYTE1)) {
+			//Gathered byte was not the beginning of a frame, search again
+			pDefr->nFrameLen = 0;
+			continue;
+		}
+
+		//Frame is split across receives, gather it in the buffer
+		if (pDefr->nFrameSize == 0) {
+			nCopy = GetSmallerNum(DNP_MSGHEADERLEN - pDefr->nFrameLen, nDataLen - nUsed);
+		} else {
+			nCopy = GetSmallerNum(pDefr->nFrameSize - pDefr->nFrameLen, nDataLen - nUsed);
+		}
+
+		memcpy(&(pDefr->aFrame[pDefr->nFrameLen]), &(pData[nUsed]), nCopy);
+		pDefr->nFrameLen += nCopy;
+		nUsed += nCopy;
+
+		if ((pDefr->nFrameSize == 0) && (pDefr->nFrameLen == DNP_MSGHEADERLEN)) {
+			pDefr->nFrameSize = DNPLinkHeaderCheck(pDefr->aFrame);
+
+			if (pDefr->nFrameSize == 0) { //Header is damaged, drop it but keep any start bytes inside it
+				pDefr->nBadFrames += 1;
+				pDefr->nFrameLen = DNPLinkResync(pDefr->aFrame, pDefr->nFrameLen);
+
+				*pnDataUsed = nUsed;
+				return Fail_Invalid;
+			}
+		}
+
+		if ((pDefr->nFrameSize != 0) && (pDefr->nFrameLen == pDefr->nFrameSize)) {
+			eResult = DNPLinkFrameDecode(pDefr->aFrame, pFrame);
+			DNPDeframerReset(pDefr); //Buffer contents stay valid until the next receive
+
+			if (eResult != Success) {
+				pDefr->nBadFrames += 1;
+			}
+
+			*pnDataUsed = nUsed;
+			return eResult;
+		}
+	}
+
+	*pnDataUsed = nUsed;
+	return Warn_Incomplete;
+}
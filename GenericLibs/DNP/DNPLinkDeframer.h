@@ -0,0 +1,187 @@
+/**	@defgroup	dnplinkdeframer		DNP Link Layer Deframer
+	@ingroup	dnp
+	@brief		Streaming extraction of DNP link layer frames
+	@details	v0.1
+	#Description
+		Scans received data for DNP link frames and checks their CRC values where
+		the bytes already are.  Rather than copying the user data out of the frame
+		a list of spans is produced that locate each piece of user data between
+		the CRC values.
+		When a complete frame is in the received data the spans point directly into
+		that buffer.  Frames that are split across receives are gathered into the
+		deframer's buffer and the spans point there instead.  Either way the spans
+		are only valid until the next call into the deframer and while the received
+		data buffer is unchanged.
+
+	#File Information
+		File:	DNPLinkDeframer.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPLINKDEFRAMER_H
+	#define __DNPLINKDEFRAMER_H
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+
+	#include "CRC16.h"
+	#include "DNPBase.h"
+
+/*****	Defines		*****/
+	/**	@brief		Largest number of user data bytes a single link frame can carry
+	 *	@details	The length byte counts 5 header bytes as well as the user data
+	 *	@ingroup	dnplinkdeframer
+	 */
+	#define DNP_LINKUSERDATAMAX		250
+
+	/**	@brief		Largest number of CRC protected blocks in a link frame
+	 *	@ingroup	dnplinkdeframer
+	 */
+	#define DNP_LINKBLOCKSMAX		((DNP_LINKUSERDATAMAX + DNP_DATACRCCHUNKSIZE - 1) / DNP_DATACRCCHUNKSIZE)
+
+	/**	@brief		Largest number of bytes a complete link frame can use
+	 *	@ingroup	dnplinkdeframer
+	 */
+	#define DNP_LINKFRAMEMAX		(DNP_MSGHEADERLEN + DNP_LINKUSERDATAMAX + (DNP_LINKBLOCKSMAX * sizeof(crc16_t)))
+
+/*****	Definitions	*****/
+	/**	@brief		Location of a contiguous piece of user data
+	 *	@ingroup	dnplinkdeframer
+	 */
+	typedef struct sDNPSpan_t {
+		const uint8_t *pData;		/**< First byte of the user data */
+		uint32_t nLen;				/**< Number of user data bytes */
+	} sDNPSpan_t;
+
+	/**	@brief		Description of a validated link frame
+	 *	@details	The transport header is removed from the spans and stored on
+	 *		its own, the spans only cover application layer data.
+	 *	@ingroup	dnplinkdeframer
+	 */
+	typedef struct sDNPLinkFrame_t {
+		const uint8_t *pFrame;					/**< First byte of the frame, the start bytes */
+		uint32_t nFrameLen;						/**< Total bytes in the frame including all CRCs */
+		uint16_t nDestAddr;						/**< Destination address from the header */
+		uint16_t nSourceAddr;					/**< Source address from the header */
+		eDNPDataControl_t eDataControl;			/**< Data control byte from the header */
+		bool bHasTransport;						/**< True if the frame carried user data and a transport header */
+		uint8_t nTransportHdr;					/**< Transport header byte, 0 if there was none */
+		uint32_t nUserDataLen;					/**< Total bytes covered by all spans */
+		uint32_t nSpanCnt;						/**< Number of spans in use */
+		sDNPSpan_t aSpans[DNP_LINKBLOCKSMAX];	/**< Locations of the user data */
+	} sDNPLinkFrame_t;
+
+	/**	@brief		State of a streaming link frame deframer
+	 *	@ingroup	dnplinkdeframer
+	 */
+	typedef struct sDNPDeframer_t {
+		uint8_t aFrame[DNP_LINKFRAMEMAX];		/**< Gathers frames split across receives */
+		uint32_t nFrameLen;						/**< Number of bytes gathered in the buffer */
+		uint32_t nFrameSize;					/**< Expected size of the gathered frame, 0 until the header is valid */
+		uint32_t nBadFrames;					/**< Count of frames discarded for failing a check */
+	} sDNPDeframer_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Retrieve the shared CRC context for DNP calculations
+	 *	@details	The context tables are built on the first call
+	 *	@return		Pointer to the CRC context
+	 *	@ingroup	dnplinkdeframer
+	 */
+	const sCRC16Context_t *DNPLinkCRCContext(void);
+
+	/**	@brief		Calculate the total size of a link frame from its length byte
+	 *	@param		nLengthByte		Value of the length byte in the link header
+	 *	@return		Total bytes in the frame, or 0 if the length is not valid
+	 *	@ingroup	dnplinkdeframer
+	 */
+	uint32_t DNPLinkFrameSize(uint8_t nLengthByte);
+
+	/**	@brief		Locate the start bytes of a link frame
+	 *	@details	If the final byte in the buffer could be the first of the
+	 *		start bytes its index is returned.
+	 *	@param		pData		Buffer to search
+	 *	@param		nDataLen	Number of bytes in the buffer
+	 *	@return		Index of the start bytes, or nDataLen if they were not found
+	 *	@ingroup	dnplinkdeframer
+	 */
+	uint32_t DNPLinkFindStart(const uint8_t *pData, uint32_t nDataLen);
+
+	/**	@brief		Discard a gathered header that failed its check, keeping any
+	 *		later start bytes it holds
+	 *	@details	Start bytes can appear in the data before a real frame, so the
+	 *		real frame may begin inside the rejected header.
+	 *	@param		pBytes		Gathered bytes, the first being a false start
+	 *	@param		nLen		Number of gathered bytes
+	 *	@return		Number of bytes kept, moved to the front of the buffer
+	 *	@ingroup	dnplinkdeframer
+	 */
+	uint32_t DNPLinkResync(uint8_t *pBytes, uint32_t nLen);
+
+	/**	@brief		Verify a link header and determine the size of its frame
+	 *	@param		pHeader		Buffer holding the 10 header bytes
+	 *	@return		Total bytes in the frame, or 0 if the header is not valid
+	 *	@ingroup	dnplinkdeframer
+	 */
+	uint32_t DNPLinkHeaderCheck(const uint8_t *pHeader);
+
+	/**	@brief		Verify a complete link frame and locate its user data
+	 *	@param		pBytes		Buffer holding the complete frame
+	 *	@param		pFrame		Returns the frame details and user data spans
+	 *	@return		Success if the frame is valid, Fail_Invalid if any CRC does
+	 *		not match
+	 *	@ingroup	dnplinkdeframer
+	 */
+	eReturn_t DNPLinkFrameDecode(const uint8_t *pBytes, sDNPLinkFrame_t *pFrame);
+
+	/**	@brief		Copy all user data in a frame into a single buffer
+	 *	@param		pFrame		Frame holding the user data spans
+	 *	@param		pDest		Buffer to copy the user data into
+	 *	@param		nDestSize	Number of bytes available in the buffer
+	 *	@return		Success if all data was copied, Fail_BufferSize if the buffer
+	 *		is too small
+	 *	@ingroup	dnplinkdeframer
+	 */
+	eReturn_t DNPLinkFrameCopyUserData(const sDNPLinkFrame_t *pFrame, uint8_t *pDest, uint32_t nDestSize);
+
+	/**	@brief		Prepare a deframer for use
+	 *	@param		pDefr		Deframer object to initialize
+	 *	@return		Success if the deframer is ready to use
+	 *	@ingroup	dnplinkdeframer
+	 */
+	eReturn_t DNPDeframerInitialize(sDNPDeframer_t *pDefr);
+
+	/**	@brief		Discard any partially gathered frame
+	 *	@param		pDefr		Deframer object to reset
+	 *	@ingroup	dnplinkdeframer
+	 */
+	void DNPDeframerReset(sDNPDeframer_t *pDefr);
+
+	/**	@brief		Process received data looking for a complete link frame
+	 *	@details	Returns as soon as a frame is completed, call again with the
+	 *		unused data to continue.
+	 *	@param		pDefr		Deframer object processing the stream
+	 *	@param		pData		Buffer holding the newly received data
+	 *	@param		nDataLen	Number of bytes in the buffer
+	 *	@param		pnDataUsed	Returns the number of bytes consumed from the buffer
+	 *	@param		pFrame		Returns the details of a completed frame
+	 *	@return		Success if a valid frame was completed, Warn_Incomplete if all
+	 *		data was consumed without completing a frame, or Fail_Invalid if a
+	 *		frame was discarded for failing a check
+	 *	@ingroup	dnplinkdeframer
+	 */
+	eReturn_t DNPDeframerReceive(sDNPDeframer_t *pDefr, const uint8_t *pData, uint32_t nDataLen, uint32_t *pnDataUsed, sDNPLinkFrame_t *pFrame);
+
+/*****	Functions	*****/
+
+
+#endif
+
@@ -0,0 +1,393 @@
+/**	File:	DNPMaster.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "DNPMaster.h"
+
+/*****	Defines		*****/
+	/**	@brief		Determine if a tick count has been reached, allowing for wrap
+	 *	@ingroup	dnpmaster
+	 */
+	#define DNPMasterTickReached(nNow, nTick)	((int32_t)((nNow) - (nTick)) >= 0)
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Find the classes that need polled in a session
+	 *	@param		pSession	Session to check
+	 *	@param		nNow		Current tick count
+	 *	@param		pnOverdue	Returns how many ticks the oldest class is overdue
+	 *	@return		All classes that need polled
+	 *	@ingroup	dnpmaster
+	 */
+	static eDNPPollClass_t DNPMasterDueClasses(sDNPSession_t *pSession, uint32_t nNow, uint32_t *pnOverdue);
+
+	/**	@brief		Set the next poll time for classes that were just polled
+	 *	@ingroup	dnpmaster
+	 */
+	static void DNPMasterReschedule(sDNPSession_t *pSession, eDNPPollClass_t eClasses, uint32_t nNow);
+
+	/**	@brief		Build and send a read request for classes of data
+	 *	@ingroup	dnpmaster
+	 */
+	static eReturn_t DNPMasterSendPoll(sDNPMaster_t *pMaster, sDNPSession_t *pSession, eDNPPollClass_t eClasses, uint32_t nNow);
+
+	/**	@brief		Route a link frame to the session it came from
+	 *	@ingroup	dnpmaster
+	 */
+	static eReturn_t DNPMasterReceiveFrame(sDNPMaster_t *pMaster, sDNPLinkFrame_t *pFrame, uint32_t nNow);
+
+	/**	@brief		Handle a fully reassembled response from an outstation
+	 *	@ingroup	dnpmaster
+	 */
+	static eReturn_t DNPMasterResponseComplete(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag, uint32_t nNow);
+
+/*****	Functions	*****/
+eReturn_t DNPMasterInitialize(sDNPMaster_t *pMaster, sIOConnect_t *pChannel, sTimeIface_t *pTime, uint16_t nMasterAddr, uint8_t nMaxOutstanding, uint32_t nTimeout, pfDNPMasterResponse_t pfResponse) {
+	uint32_t nCtr;
+
+	if ((pChannel == NULL) || (pTime == NULL) || (nMaxOutstanding == 0)) {
+		return Fail_Invalid;
+	}
+
+	pMaster->pChannel = pChannel;
+	pMaster->pTime = pTime;
+	pMaster->nMasterAddr = nMasterAddr;
+	pMaster->nMaxOutstanding = nMaxOutstanding;
+	pMaster->nTimeout = nTimeout;
+	pMaster->pfResponse = pfResponse;
+
+	for (nCtr = 0; nCtr < DNPMASTER_MAXSESSIONS; nCtr++) {
+		pMaster->aSessions[nCtr].bInUse = false;
+	}
+
+	DNPDeframerInitialize(&(pMaster->sDeframer));
+	DNPBufferNewMessage(&(pMaster->sMsg));
+
+	return Success;
+}
+
+eReturn_t DNPMasterAddSession(sDNPMaster_t *pMaster, uint16_t nOutstation, uint8_t *pPool, uint32_t nPoolSize, sDNPSession_t **ppSession) {
+	uint32_t nCtr;
+	sDNPSession_t *pSession = NULL;
+
+	if (DNPMasterFindSession(pMaster, nOutstation) != NULL) {
+		return Fail_Invalid;
+	}
+
+	for (nCtr = 0; nCtr < DNPMASTER_MAXSESSIONS; nCtr++) {
+		if (pMaster->aSessions[nCtr].bInUse == false) {
+			pSession = &(pMaster->aSessions[nCtr]);
+			break;
+		}
+	}
+
+	if (pSession == NULL) {
+		return Fail_BufferSize;
+	}
+
+	memset(pSession, 0, sizeof(sDNPSession_t));
+	if (DNPAssemblerInitialize(&(pSession->sAssembler), pPool, nPoolSize) != Success) {
+		return Fail_Invalid;
+	}
+
+	pSession->bInUse = true;
+	pSession->nOutstationAddr = nOutstation;
+
+	if (ppSession != NULL) {
+		*ppSession = pSession;
+	}
+
+	return Success;
+}
+
+eReturn_t DNPMasterRemoveSession(sDNPMaster_t *pMaster, sDNPSession_t *pSession) {
+	pSession->bInUse = false;
+	pSession->bAwaiting = false;
+
+	return Success;
+}
+
+sDNPSession_t *DNPMasterFindSession(sDNPMaster_t *pMaster, uint16_t nOutstation) {
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < DNPMASTER_MAXSESSIONS; nCtr++) {
+		if ((pMaster->aSessions[nCtr].bInUse == true) && (pMaster->aSessions[nCtr].nOutstationAddr == nOutstation)) {
+			return &(pMaster->aSessions[nCtr]);
+		}
+	}
+
+	return NULL;
+}
+
+eReturn_t DNPMasterSetPollPeriod(sDNPMaster_t *pMaster, sDNPSession_t *pSession, eDNPPollClass_t eClasses, uint32_t nPeriod) {
+	uint32_t nCtr, nNow;
+
+	nNow = pMaster->pTime->pfGetTicks();
+
+	for (nCtr = 0; nCtr < DNPMASTER_NUMCLASSES; nCtr++) {
+		if (CheckAllBitsInMask(eClasses, 1 << nCtr) == true) {
+			pSession->aPeriod[nCtr] = nPeriod;
+			pSession->aNextDue[nCtr] = nNow; //First poll is due now
+		}
+	}
+
+	return Success;
+}
+
+eReturn_t DNPMasterRequestPoll(sDNPSession_t *pSession, eDNPPollClass_t eClasses) {
+	pSession->eRequested |= eClasses & DNPPoll_Integrity;
+
+	return Success;
+}
+
+eReturn_t DNPMasterProcess(sDNPMaster_t *pMaster) {
+	uint32_t nNow, nRead, nIdx, nUsed, nCtr, nOverdue, nBestOverdue = 0, nOutstanding;
+	eReturn_t eResult;
+	eDNPPollClass_t eClasses, eBestClasses = DNPPoll_None;
+	sDNPSession_t *pSession, *pBest;
+	sDNPLinkFrame_t sFrame;
+
+	//Take in everything the channel has received
+	do {
+		eResult = pMaster->pChannel->pfReadData(pMaster->pChannel, pMaster->aRxBuff, DNPMASTER_RXBUFFSIZE, &nRead);
+		if (eResult < Success) {
+			return eResult;
+		}
+
+		nNow = pMaster->pTime->pfGetTicks();
+
+		nIdx = 0;
+		while (nIdx < nRead) {
+			eResult = DNPDeframerReceive(&(pMaster->sDeframer), &(pMaster->aRxBuff[nIdx]), nRead - nIdx, &nUsed, &sFrame);
+			nIdx += nUsed;
+
+			if (eResult == Success) {
+				eResult = DNPMasterReceiveFrame(pMaster, &sFrame, nNow);
+				if (eResult < Success) {
+					return eResult;
+				}
+			}
+		}
+	} while (nRead == DNPMASTER_RXBUFFSIZE); //Filled the buffer, there may be more waiting
+
+	nNow = pMaster->pTime->pfGetTicks();
+
+	//Expire any requests that went unanswered
+	nOutstanding = 0;
+	for (nCtr = 0; nCtr < DNPMASTER_MAXSESSIONS; nCtr++) {
+		pSession = &(pMaster->aSessions[nCtr]);
+
+		if ((pSession->bInUse == false) || (pSession->bAwaiting == false)) {
+			continue;
+		}
+
+		if (DNPMasterTickReached(nNow, pSession->nSentTick + pMaster->nTimeout) == true) {
+			pSession->nTimeouts += 1;
+			pSession->bAwaiting = false;
+			DNPAssemblerReset(&(pSession->sAssembler));
+			DNPMasterReschedule(pSession, pSession->eOutstanding, nNow);
+		} else {
+			nOutstanding += 1;
+		}
+	}
+
+	//Keep the channel busy, most overdue session goes first
+	while (nOutstanding < pMaster->nMaxOutstanding) {
+		pBest = NULL;
+
+		for (nCtr = 0; nCtr < DNPMASTER_MAXSESSIONS; nCtr++) {
+			pSession = &(pMaster->aSessions[nCtr]);
+
+			if ((pSession->bInUse == false) || (pSession->bAwaiting == true)) {
+				continue;
+			}
+
+			eClasses = DNPMasterDueClasses(pSession, nNow, &nOverdue);
+			if ((eClasses != DNPPoll_None) && ((pBest == NULL) || (nOverdue > nBestOverdue))) {
+				pBest = pSession;
+				eBestClasses = eClasses;
+				nBestOverdue = nOverdue;
+			}
+		}
+
+		if (pBest == NULL) { //Nothing is due
+			break;
+		}
+
+		eResult = DNPMasterSendPoll(pMaster, pBest, eBestClasses, nNow);
+		if (eResult != Success) {
+			return eResult;
+		}
+
+		nOutstanding += 1;
+	}
+
+	return Success;
+}
+
+static eDNPPollClass_t DNPMasterDueClasses(sDNPSession_t *pSession, uint32_t nNow, uint32_t *pnOverdue) {
+	uint32_t nCtr;
+	eDNPPollClass_t eDue = pSession->eRequested;
+
+	if (eDue != DNPPoll_None) { //Requested polls go ahead of the schedule
+		*pnOverdue = UINT32_MAX;
+	} else {
+		*pnOverdue = 0;
+	}
+
+	for (nCtr = 0; nCtr < DNPMASTER_NUMCLASSES; nCtr++) {
+		if ((pSession->aPeriod[nCtr] == 0) || (DNPMasterTickReached(nNow, pSession->aNextDue[nCtr]) == false)) {
+			continue;
+		}
+
+		eDue |= 1 << nCtr;
+		*pnOverdue = GetLargerNum(*pnOverdue, nNow - pSession->aNextDue[nCtr]);
+	}
+
+	return eDue;
+}
+
+static void DNPMasterReschedule(sDNPSession_t *pSession, eDNPPollClass_t eClasses, uint32_t nNow) {
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < DNPMASTER_NUMCLASSES; nCtr++) {
+		if ((CheckAllBitsInMask(eClasses, 1 << nCtr) == true) && (pSession->aPeriod[nCtr] != 0)) {
+			pSession->aNextDue[nCtr] = nNow + pSession->aPeriod[nCtr];
+		}
+	}
+
+	return;
+}
+
+static eReturn_t DNPMasterSendPoll(sDNPMaster_t *pMaster, sDNPSession_t *pSession, eDNPPollClass_t eClasses, uint32_t nNow) {
+	sDNPMsgBuffer_t *pMsg = &(pMaster->sMsg);
+	eReturn_t eResult;
+
+	DNPBufferNewMessage(pMsg);
+	pMsg->nDestAddr = pSession->nOutstationAddr;
+	pMsg->nSourceAddr = pMaster->nMasterAddr;
+	pMsg->eControlCode = DNPCtrl_Read;
+	pMsg->nApplicationSequence = pSession->nAppSequence;
+	pMsg->nTransportSequence = pSession->nTransportSequence;
+
+	//Events are requested ahead of static data so the static values are the newest
+	if (CheckAllBitsInMask(eClasses, DNPPoll_Class1) == true) {
+		DNPBuilderAddDataObjectRequest(pMsg, DNPGrp_ClassObjects, 2, 0, 0);
+	}
+
+	if (CheckAllBitsInMask(eClasses, DNPPoll_Class2) == true) {
+		DNPBuilderAddDataObjectRequest(pMsg, DNPGrp_ClassObjects, 3, 0, 0);
+	}
+
+	if (CheckAllBitsInMask(eClasses, DNPPoll_Class3) == true) {
+		DNPBuilderAddDataObjectRequest(pMsg, DNPGrp_ClassObjects, 4, 0, 0);
+	}
+
+	if (CheckAllBitsInMask(eClasses, DNPPoll_Class0) == true) {
+		DNPBuilderAddDataObjectRequest(pMsg, DNPGrp_ClassObjects, 1, 0, 0);
+	}
+
+	eResult = DNPBuilderGenerateDNP(pMsg);
+	if (eResult != Success) {
+		return eResult;
+	}
+
+	eResult = pMaster->pChannel->pfWriteData(pMaster->pChannel, pMsg->aDNPMessage, pMsg->nDNPMsgLen);
+	if (eResult != Success) {
+		return eResult;
+	}
+
+	pSession->bAwaiting = true;
+	DNPAssemblerReset(&(pSession->sAssembler));
+	pSession->eOutstanding = eClasses;
+	pSession->eRequested &= ~eClasses;
+	pSession->nOutstandingSeq = pSession->nAppSequence;
+	pSession->nSentTick = nNow;
+	pSession->nRequests += 1;
+
+	pSession->nAppSequence = (pSession->nAppSequence + 1) & DNPAppHdr_SequenceMask;
+	pSession->nTransportSequence = pMsg->nTransportSequence; //Builder advanced it past the fragments sent
+
+	return Success;
+}
+
+static eReturn_t DNPMasterReceiveFrame(sDNPMaster_t *pMaster, sDNPLinkFrame_t *pFrame, uint32_t nNow) {
+	sDNPSession_t *pSession;
+	sDNPAppFragment_t sFrag;
+
+	if ((pFrame->nDestAddr != pMaster->nMasterAddr) || (pFrame->bHasTransport == false)) {
+		return Success; //Not for us, or link layer only
+	}
+
+	pSession = DNPMasterFindSession(pMaster, pFrame->nSourceAddr);
+	if (pSession == NULL) { //Not an outstation we know
+		return Success;
+	}
+
+	if (pSession->bAwaiting == true) { //Still hearing from it, restart the time out
+		pSession->nSentTick = nNow;
+	}
+
+	//Out of sequence segments and responses too large for the pool are dropped by the assembler
+	if (DNPAssemblerAddFrame(&(pSession->sAssembler), pFrame, &sFrag) != Success) {
+		return Success;
+	}
+
+	return DNPMasterResponseComplete(pMaster, pSession, &sFrag, nNow);
+}
+
+static eReturn_t DNPMasterResponseComplete(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag, uint32_t nNow) {
+	sDNPMsgBuffer_t *pMsg = &(pMaster->sMsg);
+	uint32_t nCtr;
+
+	if ((pFrag->eControlCode != DNPCtrl_Response) && (pFrag->eControlCode != DNPCtrl_Unsolicited)) {
+		return Success; //Not a response the master can use
+	}
+
+	if ((pFrag->eControlCode == DNPCtrl_Response) && (pSession->bAwaiting == true) && (pFrag->nSequence == pSession->nOutstandingSeq)) {
+		pSession->nResponses += 1;
+
+		if (CheckAllBitsInMask(pFrag->nAppHeader, DNPAppHdr_LastMsg) == true) { //Request is finished, free the channel
+			pSession->bAwaiting = false;
+			DNPMasterReschedule(pSession, pSession->eOutstanding, nNow);
+		} else { //More fragments follow, each carries the next sequence
+			pSession->nOutstandingSeq = (pSession->nOutstandingSeq + 1) & DNPAppHdr_SequenceMask;
+		}
+	}
+
+	//Outstation has events waiting, poll them if those classes are being polled
+	for (nCtr = 1; nCtr < DNPMASTER_NUMCLASSES; nCtr++) {
+		if ((CheckAllBitsInMask(pFrag->eIntIndicators, DNPIntInd_Class1Data << (nCtr - 1)) == true) && (pSession->aPeriod[nCtr] != 0)) {
+			pSession->eRequested |= 1 << nCtr;
+		}
+	}
+
+	if (pMaster->pfResponse != NULL) {
+		pMaster->pfResponse(pMaster, pSession, pFrag);
+	}
+
+	if (CheckAllBitsInMask(pFrag->nAppHeader, DNPAppHdr_ConfirmExpect) == true) {
+		DNPBufferNewMessage(pMsg);
+		pMsg->nDestAddr = pSession->nOutstationAddr;
+		pMsg->nSourceAddr = pMaster->nMasterAddr;
+		pMsg->nApplicationSequence = pFrag->nSequence;
+		pMsg->nTransportSequence = pSession->nTransportSequence;
+		pSession->nTransportSequence = (pSession->nTransportSequence + 1) & DNPTransHdr_SequenceMask;
+
+		DNPBuilderGenerateConfirm(pMsg, (pFrag->eControlCode == DNPCtrl_Unsolicited));
+
+		return pMaster->pChannel->pfWriteData(pMaster->pChannel, pMsg->aDNPMessage, pMsg->nDNPMsgLen);
+	}
+
+	return Success;
+}
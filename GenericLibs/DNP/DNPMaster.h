@@ -0,0 +1,224 @@
+/**	@defgroup	dnpmaster		DNP Master
+	@ingroup	dnp
+	@brief		Polls many DNP outstations sharing a single channel
+	@details	v0.1
+	#Description
+		The master owns a set of outstation sessions, each identified by the
+		outstation's address.  Every session has its own poll periods for class 0
+		(static data) and classes 1, 2, and 3 (event data) and tracks its own
+		application and transport sequence numbers.
+		The channel is never left idle waiting for a poll period.  As soon as a
+		response completes, or times out, the most overdue session has its
+		request sent.  Channels able to carry requests to several outstations at
+		once (such as a TCP gateway) may allow more than one request to be
+		outstanding, each session will still only have one.
+		Responses are reassembled per session so fragments from different
+		outstations may be interleaved on the channel.  Each session gathers its
+		responses with a fragment assembler into a pool supplied by the caller,
+		so the pool only needs to be as large as the responses that outstation
+		sends, up to the DNP_APPFRAGMENTMAX the protocol allows.  A segment that
+		does not carry the next transport sequence, lost or repeated, discards
+		the partial response.
+		When an outstation reports that it has event data in its internal
+		indications the matching event poll is scheduled immediately.
+
+	#Usage
+		Initialize the master with the channel and time interface, add a session
+		for each outstation along with its reassembly pool, then set the poll
+		periods.  Call DNPMasterProcess() regularly, it does not block.
+		Completed responses are given to the response handler as an application
+		fragment that can be read with DNPParserFragmentNextObject().
+
+	#File Information
+		File:	DNPMaster.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPMASTER_H
+	#define __DNPMASTER_H
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "TimeGeneralInterface.h"
+	#include "Terminal.h"
+
+	#include "DNPBase.h"
+	#include "DNPLinkDeframer.h"
+	#include "DNPFragmentAssembler.h"
+	#include "DNPMessageBuilder.h"
+	#include "DNPMessageParser.h"
+
+/*****	Defines		*****/
+	#ifndef DNPMASTER_MAXSESSIONS
+		/**	@brief		Number of outstation sessions a master can hold
+		 *	@ingroup	dnpmaster
+		 */
+		#define DNPMASTER_MAXSESSIONS	8
+	#endif
+
+	#ifndef DNPMASTER_RXBUFFSIZE
+		/**	@brief		Number of bytes read from the channel at a time
+		 *	@details	Raise this for network channels, datagrams larger than the
+		 *		buffer are cut short
+		 *	@ingroup	dnpmaster
+		 */
+		#define DNPMASTER_RXBUFFSIZE	DNP_LINKFRAMEMAX
+	#endif
+
+	/**	@brief		Number of separate classes of data that can be polled
+	 *	@ingroup	dnpmaster
+	 */
+	#define DNPMASTER_NUMCLASSES	4
+
+/*****	Definitions	*****/
+	typedef struct sDNPMaster_t sDNPMaster_t;
+
+	typedef struct sDNPSession_t sDNPSession_t;
+
+	/**	@brief		Handler for completed responses from an outstation
+	 *	@details	The fragment is ready for DNPParserFragmentNextObject(), its
+	 *		data is only valid until the handler returns.
+	 *	@param		pMaster		Master that received the response
+	 *	@param		pSession	Session of the outstation that responded
+	 *	@param		pFrag		Application fragment of the response
+	 *	@ingroup	dnpmaster
+	 */
+	typedef void (*pfDNPMasterResponse_t)(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag);
+
+	/**	@brief		State of a single outstation polled by the master
+	 *	@ingroup	dnpmaster
+	 */
+	typedef struct sDNPSession_t {
+		bool bInUse;								/**< True if this session slot is in use */
+		uint16_t nOutstationAddr;					/**< DNP address of the outstation */
+		uint8_t nAppSequence;						/**< Next application sequence to use in a request */
+		uint8_t nTransportSequence;					/**< Next transport sequence to use in a request */
+
+		uint32_t aPeriod[DNPMASTER_NUMCLASSES];		/**< Ticks between polls of each class, 0 to disable */
+		uint32_t aNextDue[DNPMASTER_NUMCLASSES];	/**< Tick count when each class is next due */
+		eDNPPollClass_t eRequested;					/**< Classes requested outside the schedule */
+
+		bool bAwaiting;								/**< True while a request is outstanding */
+		eDNPPollClass_t eOutstanding;				/**< Classes in the outstanding request */
+		uint8_t nOutstandingSeq;					/**< Application sequence expected in the next response fragment */
+		uint32_t nSentTick;							/**< Tick count the last request or fragment arrived */
+
+		sDNPAssembler_t sAssembler;					/**< Reassembly of a response across transport segments */
+
+		uint32_t nRequests;							/**< Count of requests sent */
+		uint32_t nResponses;						/**< Count of responses received */
+		uint32_t nTimeouts;							/**< Count of requests that were not answered */
+		void *pParam;								/**< User specified value for this outstation */
+	} sDNPSession_t;
+
+	/**	@brief		State of a DNP master
+	 *	@ingroup	dnpmaster
+	 */
+	typedef struct sDNPMaster_t {
+		sIOConnect_t *pChannel;						/**< Channel all outstations are reached through */
+		sTimeIface_t *pTime;						/**< Time interface to use for scheduling */
+		uint16_t nMasterAddr;						/**< DNP address of this master */
+		uint8_t nMaxOutstanding;					/**< Number of requests allowed to be outstanding at once */
+		uint32_t nTimeout;							/**< Ticks to wait for a response */
+
+		pfDNPMasterResponse_t pfResponse;			/**< Handler for completed responses */
+
+		sDNPSession_t aSessions[DNPMASTER_MAXSESSIONS];	/**< All outstation sessions */
+
+		sDNPDeframer_t sDeframer;					/**< Extracts link frames from the channel data */
+		uint8_t aRxBuff[DNPMASTER_RXBUFFSIZE];		/**< Data read from the channel */
+		sDNPMsgBuffer_t sMsg;						/**< Buffer for building requests and confirmations */
+	} sDNPMaster_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare a master for use
+	 *	@param		pMaster			Master object to initialize
+	 *	@param		pChannel		Channel all outstations are reached through
+	 *	@param		pTime			Time interface with tick counts
+	 *	@param		nMasterAddr		DNP address of this master
+	 *	@param		nMaxOutstanding	Number of requests allowed to be outstanding,
+	 *		use 1 for half duplex channels such as multi-drop serial lines
+	 *	@param		nTimeout		Ticks to wait for a response
+	 *	@param		pfResponse		Handler for completed responses, may be NULL
+	 *	@return		Success if the master is ready, Fail_Invalid if a parameter
+	 *		can not be used
+	 *	@ingroup	dnpmaster
+	 */
+	eReturn_t DNPMasterInitialize(sDNPMaster_t *pMaster, sIOConnect_t *pChannel, sTimeIface_t *pTime, uint16_t nMasterAddr, uint8_t nMaxOutstanding, uint32_t nTimeout, pfDNPMasterResponse_t pfResponse);
+
+	/**	@brief		Add an outstation for the master to poll
+	 *	@details	The session starts with all polls disabled
+	 *	@param		pMaster			Master object to add the session to
+	 *	@param		nOutstation		DNP address of the outstation
+	 *	@param		pPool			Storage to reassemble responses in, must stay
+	 *		valid until the session is removed
+	 *	@param		nPoolSize		Number of bytes in the pool, responses larger
+	 *		than this are dropped
+	 *	@param		ppSession		Returns the session created
+	 *	@return		Success if the session was added, Fail_BufferSize if there is
+	 *		no room for another, Fail_Invalid if the address is already in use or
+	 *		the pool can not be used
+	 *	@ingroup	dnpmaster
+	 */
+	eReturn_t DNPMasterAddSession(sDNPMaster_t *pMaster, uint16_t nOutstation, uint8_t *pPool, uint32_t nPoolSize, sDNPSession_t **ppSession);
+
+	/**	@brief		Remove an outstation from the master
+	 *	@param		pMaster			Master object to remove the session from
+	 *	@param		pSession		Session to remove
+	 *	@return		Success if the session was removed
+	 *	@ingroup	dnpmaster
+	 */
+	eReturn_t DNPMasterRemoveSession(sDNPMaster_t *pMaster, sDNPSession_t *pSession);
+
+	/**	@brief		Locate the session for an outstation
+	 *	@param		pMaster			Master object to search
+	 *	@param		nOutstation		DNP address of the outstation
+	 *	@return		Pointer to the session, or NULL if there is none
+	 *	@ingroup	dnpmaster
+	 */
+	sDNPSession_t *DNPMasterFindSession(sDNPMaster_t *pMaster, uint16_t nOutstation);
+
+	/**	@brief		Set how frequently classes of data are polled
+	 *	@details	The first poll of the classes is due immediately
+	 *	@param		pMaster			Master object holding the session
+	 *	@param		pSession		Session to configure
+	 *	@param		eClasses		All classes to set the period of
+	 *	@param		nPeriod			Ticks between polls, 0 to disable polling
+	 *	@return		Success if the period was set
+	 *	@ingroup	dnpmaster
+	 */
+	eReturn_t DNPMasterSetPollPeriod(sDNPMaster_t *pMaster, sDNPSession_t *pSession, eDNPPollClass_t eClasses, uint32_t nPeriod);
+
+	/**	@brief		Request classes be polled as soon as the channel allows
+	 *	@param		pSession		Session to poll
+	 *	@param		eClasses		All classes to poll
+	 *	@return		Success if the poll was requested
+	 *	@ingroup	dnpmaster
+	 */
+	eReturn_t DNPMasterRequestPoll(sDNPSession_t *pSession, eDNPPollClass_t eClasses);
+
+	/**	@brief		Service the channel and send any polls that are due
+	 *	@details	Reads all available data, delivers completed responses,
+	 *		expires requests that were not answered, then sends requests
+	 *		until the channel has as many outstanding as it allows.
+	 *	@param		pMaster			Master object to process
+	 *	@return		Success if the processing completed, or a failure code if
+	 *		the channel reported an error
+	 *	@ingroup	dnpmaster
+	 */
+	eReturn_t DNPMasterProcess(sDNPMaster_t *pMaster);
+
+/*****	Functions	*****/
+
+
+#endif
+
@@ -68,7 +68,7 @@ eReturn_t DNPBuilderAddData(sDNPMsgBuffer_t *pMsg, uint8_t *pData, uint32_t nDat
 
 eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg) {
 	uint32_t nUserDataCnt, nFragDataCnt, nChunkCnt, nFragCnt, nChunkStartIdx;
-	uint32_t nMsgSizeIndex, nMsgHdrStartIdx;
+	uint32_t nMsgSizeIndex, nMsgHdrStartIdx, nTransHdrIdx;
 	crc16_t nCRCVal;
 
 	//Start at the beginning
@@ -78,8 +78,8 @@ eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg) {
 	nChunkCnt = 0;		//Count of data bytes in current 16-byte CRC chunk
 	nFragCnt = 0;		//Count of message fragments in this message
 
-	//Build the message header
-	while (nUserDataCnt < pMsg->nUserDataLen) {
+	//Build the message header, a message without user data still needs one fragment
+	while ((nUserDataCnt < pMsg->nUserDataLen) || (nFragCnt == 0)) {
 		if (pMsg->nDNPMsgLen + 10 >= DNP_MESSAGESIZEMAX) { //Not enough space to fit the header for this fragment
 			return Fail_BufferSize;
 		}
@@ -87,38 +87,40 @@ eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg) {
 		nMsgHdrStartIdx = pMsg->nDNPMsgLen;
 
 		//Add in headers and framing for Transport and application layers
-		if (nFragDataCnt == 0) { //Starting a new fragment
-			pMsg->aDNPMessage[pMsg->nDNPMsgLen + DNPHdrIdx_DataControl] = pMsg->eDataControl;
+		pMsg->aDNPMessage[pMsg->nDNPMsgLen + DNPHdrIdx_DataControl] = pMsg->eDataControl;
 
-			UInt16ToBytes(DNP_MSGSTARTBYTES, false, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_StartBytes);
-			UInt16ToBytes(pMsg->nDestAddr, true, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_DestAddr);
-			UInt16ToBytes(pMsg->nSourceAddr, true, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_SourceAddr);
+		UInt16ToBytes(DNP_MSGSTARTBYTES, false, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_StartBytes);
+		UInt16ToBytes(pMsg->nDestAddr, true, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_DestAddr);
+		UInt16ToBytes(pMsg->nSourceAddr, true, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_SourceAddr);
 
-			nMsgSizeIndex = pMsg->nDNPMsgLen + DNPHdrIdx_DataLength; //Once this data size of this fragment is know, put it here
+		nMsgSizeIndex = pMsg->nDNPMsgLen + DNPHdrIdx_DataLength; //Once this data size of this fragment is know, put it here
 
-			nFragDataCnt = 5; //The header always uses 5 bytes
-			pMsg->nDNPMsgLen += 10; //Header uses up 10 bytes
-		}
+		nFragDataCnt = 5; //The header always uses 5 bytes
+		pMsg->nDNPMsgLen += 10; //Header uses up 10 bytes
 
 		nChunkStartIdx = pMsg->nDNPMsgLen; //CRC for 16 bytes of data starts here
 
-		if (nFragCnt == 0) { //First fragment, application and transport headers needed
-			//Transport header
-			pMsg->aDNPMessage[pMsg->nDNPMsgLen] = DNPTransHdr_FirstMsg | (pMsg->nTransportSequence & DNPTransHdr_SequenceMask);
-			if (pMsg->nUserDataLen - nUserDataCnt < DNP_MAXDATABYTES) { //The remaining data fits in this fragment
-				pMsg->aDNPMessage[pMsg->nDNPMsgLen] |= DNPTransHdr_LastMsg;
-			}
+		//Transport header, each fragment gets the next sequence number
+		nTransHdrIdx = pMsg->nDNPMsgLen;
+		pMsg->aDNPMessage[nTransHdrIdx] = (pMsg->nTransportSequence + nFragCnt) & DNPTransHdr_SequenceMask;
+		if (nFragCnt == 0) {
+			pMsg->aDNPMessage[nTransHdrIdx] |= DNPTransHdr_FirstMsg;
+		}
 
-			pMsg->nDNPMsgLen += 1;
-			nFragDataCnt += 1;
-			nChunkCnt += 1;
+		pMsg->nDNPMsgLen += 1;
+		nFragDataCnt += 1;
+		nChunkCnt += 1;
 
-			//Application header
+		if (nFragCnt == 0) { //First fragment, application header needed
 			pMsg->aDNPMessage[pMsg->nDNPMsgLen] = DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | (DNPAppHdr_SequenceMask & pMsg->nApplicationSequence);
-			if (pMsg->eControlCode != DNPCtrl_Response) { //Responses don't require a confirmation response
+			if ((pMsg->eControlCode == DNPCtrl_Unsolicited) || (pMsg->bConfirmExpect == true)) { //Unsolicited responses always require confirmation
 				pMsg->aDNPMessage[pMsg->nDNPMsgLen] |= DNPAppHdr_ConfirmExpect;
 			}
 
+			if (pMsg->eControlCode == DNPCtrl_Unsolicited) {
+				pMsg->aDNPMessage[pMsg->nDNPMsgLen] |= DNPAppHdr_Unsolicited;
+			}
+
 			pMsg->nDNPMsgLen += 1;
 			nFragDataCnt += 1;
 			nChunkCnt += 1;
@@ -129,28 +131,22 @@ eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg) {
 			nFragDataCnt += 1;
 			nChunkCnt += 1;
 
-			if (pMsg->eControlCode == DNPCtrl_Response) { //Responses must include internal indicators
-				UInt16ToBytes(pMsg->eIntIndicators, true, pMsg->aDNPMessage, pMsg->nDNPMsgLen + DNPHdrIdx_DestAddr);
+			if ((pMsg->eControlCode == DNPCtrl_Response) || (pMsg->eControlCode == DNPCtrl_Unsolicited)) { //Responses must include internal indicators
+				UInt16ToBytes(pMsg->eIntIndicators, true, pMsg->aDNPMessage, pMsg->nDNPMsgLen);
 
 				pMsg->nDNPMsgLen += 2;
 				nFragDataCnt += 2;
 				nChunkCnt += 2;
 			}
-		} else { //Subsequent fragment, transport header only
-			//Transport header
-			pMsg->aDNPMessage[pMsg->nDNPMsgLen] = (pMsg->nTransportSequence & DNPTransHdr_SequenceMask);
-			if (pMsg->nUserDataLen - nUserDataCnt < DNP_MAXDATABYTES) { //The remaining data fits in this fragment
-				pMsg->aDNPMessage[pMsg->nDNPMsgLen] |= DNPTransHdr_LastMsg;
-			}
+		}
 
-			pMsg->nDNPMsgLen += 1;
-			nFragDataCnt += 1;
-			nChunkCnt += 1;
+		if (pMsg->nUserDataLen - nUserDataCnt <= DNP_MAXDATABYTES - nFragDataCnt) { //The remaining data fits in this fragment
+			pMsg->aDNPMessage[nTransHdrIdx] |= DNPTransHdr_LastMsg;
 		}
 
 		//All the formalities are over, start stuffing in the actual data
-		while ((nFragDataCnt < DNP_MAXDATABYTES) && (nUserDataCnt < pMsg->nUserDataLen)) {
-			while ((nChunkCnt < DNP_DATACRCCHUNKSIZE) && (nUserDataCnt < pMsg->nUserDataLen)) {
+		do {
+			while ((nChunkCnt < DNP_DATACRCCHUNKSIZE) && (nFragDataCnt < DNP_MAXDATABYTES) && (nUserDataCnt < pMsg->nUserDataLen)) {
 				pMsg->aDNPMessage[pMsg->nDNPMsgLen] = pMsg->aUserData[nUserDataCnt];
 
 				pMsg->nDNPMsgLen += 1;
@@ -175,15 +171,11 @@ eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg) {
 			//Update counters for the next chunk
 			nChunkStartIdx = pMsg->nDNPMsgLen;
 			nChunkCnt = 0;
-		}
+		} while ((nFragDataCnt < DNP_MAXDATABYTES) && (nUserDataCnt < pMsg->nUserDataLen));
 
 		//Finished a fragment, set the size and header CRC
 		pMsg->aDNPMessage[nMsgSizeIndex] = nFragDataCnt;
 
-		if (pMsg->nDNPMsgLen + 2 >= DNP_MESSAGESIZEMAX) { //There isn't room for the CRC bytes
-			return Fail_BufferSize;
-		}
-
 		//CRC header up to where the CRC bytes go
 		nCRCVal = CalculateCRC16(CRC_DNP, &(pMsg->aDNPMessage[nMsgHdrStartIdx]), DNPHdrIdx_CRC);
 		UInt16ToBytes(nCRCVal, false, pMsg->aDNPMessage, nMsgHdrStartIdx + DNPHdrIdx_CRC);
@@ -194,10 +186,44 @@ eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg) {
 		nFragCnt += 1;
 	}
 
+	//Following message picks up after the sequence numbers used here
+	pMsg->nTransportSequence = (pMsg->nTransportSequence + nFragCnt) & DNPTransHdr_SequenceMask;
+
 	//All message fragments are prepared and ready
 	return Success;
 }
 
+eReturn_t DNPBuilderGenerateConfirm(sDNPMsgBuffer_t *pMsg, bool bUnsolicited) {
+	crc16_t nCRCVal;
+
+	//Link header
+	UInt16ToBytes(DNP_MSGSTARTBYTES, false, pMsg->aDNPMessage, DNPHdrIdx_StartBytes);
+	pMsg->aDNPMessage[DNPHdrIdx_DataLength] = 5 + 3; //Header data plus transport, application, and control bytes
+	pMsg->aDNPMessage[DNPHdrIdx_DataControl] = pMsg->eDataControl;
+	UInt16ToBytes(pMsg->nDestAddr, true, pMsg->aDNPMessage, DNPHdrIdx_DestAddr);
+	UInt16ToBytes(pMsg->nSourceAddr, true, pMsg->aDNPMessage, DNPHdrIdx_SourceAddr);
+
+	nCRCVal = CalculateCRC16(CRC_DNP, pMsg->aDNPMessage, DNPHdrIdx_CRC);
+	UInt16ToBytes(nCRCVal, false, pMsg->aDNPMessage, DNPHdrIdx_CRC);
+
+	//Single chunk of data with the transport and application headers
+	pMsg->aDNPMessage[DNPHdrIdx_TransportHdr] = DNPTransHdr_FirstMsg | DNPTransHdr_LastMsg | (pMsg->nTransportSequence & DNPTransHdr_SequenceMask);
+
+	pMsg->aDNPMessage[DNPHdrIdx_AppHdr] = DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | (pMsg->nApplicationSequence & DNPAppHdr_SequenceMask);
+	if (bUnsolicited == true) {
+		pMsg->aDNPMessage[DNPHdrIdx_AppHdr] |= DNPAppHdr_Unsolicited;
+	}
+
+	pMsg->aDNPMessage[DNPHdrIdx_ControlCode] = DNPCtrl_Confirm;
+
+	nCRCVal = CalculateCRC16(CRC_DNP, &(pMsg->aDNPMessage[DNPHdrIdx_TransportHdr]), 3);
+	UInt16ToBytes(nCRCVal, false, pMsg->aDNPMessage, DNPHdrIdx_ControlCode + 1);
+
+	pMsg->nDNPMsgLen = DNPHdrIdx_ControlCode + 1 + sizeof(crc16_t);
+
+	return Success;
+}
+
 eReturn_t DNPBuilderAddDataObjectRequest(sDNPMsgBuffer_t *pMsg, eDNPGroup_t eGroup, uint8_t nVariation, uint16_t nCountStart, uint16_t nCountStop) {
 	unsigned char aCntBytes[4];
 	eDNPQualifier_t eQualifier;
@@ -439,3 +465,63 @@ eReturn_t DNPBuilderAddDeviceAttributeValue(sDNPMsgBuffer_t *pMsg, eDNPDevAttrVa
 
 	return Success;
 }
+
+eReturn_t DNPBuilderAddAnalogInputDataObject(sDNPMsgBuffer_t *pMsg, uint8_t nVariation, uint8_t nNumPoints, int32_t *pnValues, eDNPObjAnaInFlags_t *peFlags, uint16_t nStartAddress) {
+	uint16_t nCtr;
+	uint8_t aBytes[4];
+
+	if ((nVariation != 1) && (nVariation != 3)) {
+		return Fail_Invalid;
+	}
+
+	//build up the data object
+	DNPBuilderAddByte(pMsg, DNPGrp_AnalogInput); //Group
+	DNPBuilderAddByte(pMsg, nVariation);
+	DNPBuilderAddByte(pMsg, DNPQual_IndexPrefixNone | DNPQual_CodeAddrStopAndStart2Bytes);
+
+	//Range start
+	UInt16ToBytes(nStartAddress, true, aBytes, 0);
+	DNPBuilderAddData(pMsg, aBytes, 2);
+
+	//Range stop
+	UInt16ToBytes(nStartAddress + (nNumPoints - 1), true, aBytes, 0);
+	DNPBuilderAddData(pMsg, aBytes, 2);
+
+	//Now fill in all the data points
+	for (nCtr = 0; nCtr < nNumPoints; nCtr++) {
+		if (nVariation == 1) {
+			DNPBuilderAddByte(pMsg, (uint8_t)(peFlags[nCtr]));
+		}
+
+		UInt32ToBytes((uint32_t)pnValues[nCtr], true, aBytes, 0);
+		if (DNPBuilderAddData(pMsg, aBytes, 4) != Success) {
+			return Fail_BufferSize;
+		}
+	}
+
+	return Success;
+}
+
+eReturn_t DNPBuilderAddIndexedObjectHeader(sDNPMsgBuffer_t *pMsg, eDNPGroup_t eGroup, uint8_t nVariation, uint16_t nCount) {
+	uint8_t aBytes[2];
+
+	DNPBuilderAddByte(pMsg, eGroup);
+	DNPBuilderAddByte(pMsg, nVariation);
+	DNPBuilderAddByte(pMsg, DNPQual_IndexPrefix2Bytes | DNPQual_CodeSingleVal2Bytes);
+
+	UInt16ToBytes(nCount, true, aBytes, 0); //Quantity of values
+	return DNPBuilderAddData(pMsg, aBytes, 2);
+}
+
+eReturn_t DNPBuilderAddIndexedValue(sDNPMsgBuffer_t *pMsg, uint16_t nIndex, uint8_t *pData, uint32_t nDataLen) {
+	uint8_t aBytes[2];
+
+	if (pMsg->nUserDataLen + 2 + nDataLen >= DNP_USERDATAMAX) {
+		return Fail_BufferSize;
+	}
+
+	UInt16ToBytes(nIndex, true, aBytes, 0); //Prefix is the point index
+	DNPBuilderAddData(pMsg, aBytes, 2);
+
+	return DNPBuilderAddData(pMsg, pData, nDataLen);
+}
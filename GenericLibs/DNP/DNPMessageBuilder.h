@@ -36,7 +36,9 @@
 	 *	@details	After adding data objects and setting properties in the
 	 *		message buffer call this function to have it correctly framed in
 	 *		the DNP syntax.
-	 *		The DNP message created will be stored inside pMsg.
+	 *		The DNP message created will be stored inside pMsg.  Each
+	 *		fragment uses the next transport sequence number, when finished
+	 *		nTransportSequence holds the number for the following message.
 	 *	@param		pMsg		Message buffer to create the message from
 	 *	@return		Success upon DNP message creation.  Or a code indicating
 	 *		the failure encountered.
@@ -44,6 +46,17 @@
 	 */
 	eReturn_t DNPBuilderGenerateDNP(sDNPMsgBuffer_t *pMsg);
 
+	/**	@brief		Create an application layer confirm message
+	 *	@details	The addresses, data control, and sequence numbers are
+	 *		taken from the message buffer.  Any user data is ignored.
+	 *		The DNP message created will be stored inside pMsg.
+	 *	@param		pMsg			Message buffer to create the message in
+	 *	@param		bUnsolicited	True if confirming an unsolicited response
+	 *	@return		Success upon DNP message creation
+	 *	@ingroup	dnpmsgbuild
+	 */
+	eReturn_t DNPBuilderGenerateConfirm(sDNPMsgBuffer_t *pMsg, bool bUnsolicited);
+
 	/**	@brief		Add a data object request to the DNP message buffer
 	 *	@details	This is a request for information packet, it does not
 	 *		contain any data in it.  The receiving device is expected to
@@ -108,6 +121,45 @@
 
 	eReturn_t DNPBuilderAddDeviceAttributeValue(sDNPMsgBuffer_t *pMsg, eDNPDevAttrVar_t eAttr, const char *pValue);
 
+	/**	@brief		Add analog input values, group 30, to the DNP message buffer
+	 *	@param		pMsg			Message buffer to add the data object to
+	 *	@param		nVariation		Variation 1 for 32 bit values with flags, or 3
+	 *		for 32 bit values without flags
+	 *	@param		nNumPoints		Number of points to add
+	 *	@param		pnValues		Array of values for each point
+	 *	@param		peFlags			Array of flags for each point, only used by
+	 *		variation 1
+	 *	@param		nStartAddress	Address of the first point
+	 *	@return		Success if the object is added.  Or a code indicating
+	 *		the failure encountered.
+	 *	@ingroup	dnpmsgbuild
+	 */
+	eReturn_t DNPBuilderAddAnalogInputDataObject(sDNPMsgBuffer_t *pMsg, uint8_t nVariation, uint8_t nNumPoints, int32_t *pnValues, eDNPObjAnaInFlags_t *peFlags, uint16_t nStartAddress);
+
+	/**	@brief		Begin a data object where each value has a 2 byte index prefix
+	 *	@details	This is the form used for event data.  Follow this with
+	 *		exactly nCount calls to DNPBuilderAddIndexedValue().
+	 *	@param		pMsg			Message buffer to add the data object to
+	 *	@param		eGroup			Group of the data object
+	 *	@param		nVariation		Variation of the data object
+	 *	@param		nCount			Number of values that will follow
+	 *	@return		Success if the object is added.  Or a code indicating
+	 *		the failure encountered.
+	 *	@ingroup	dnpmsgbuild
+	 */
+	eReturn_t DNPBuilderAddIndexedObjectHeader(sDNPMsgBuffer_t *pMsg, eDNPGroup_t eGroup, uint8_t nVariation, uint16_t nCount);
+
+	/**	@brief		Add a value with its index prefix to the DNP message buffer
+	 *	@param		pMsg			Message buffer to add the value to
+	 *	@param		nIndex			Point index of the value
+	 *	@param		pData			Bytes of the value, least significant first
+	 *	@param		nDataLen		Number of bytes in the value
+	 *	@return		Success if the value is added.  Or a code indicating
+	 *		the failure encountered.
+	 *	@ingroup	dnpmsgbuild
+	 */
+	eReturn_t DNPBuilderAddIndexedValue(sDNPMsgBuffer_t *pMsg, uint16_t nIndex, uint8_t *pData, uint32_t nDataLen);
+
 /*****	Functions	*****/
 
 
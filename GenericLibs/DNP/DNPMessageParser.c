@@ -10,22 +10,126 @@
 
 
 /*****	Definitions	*****/
-
+	/**	@brief		How the range field of a qualifier is interpreted
+	 *	@ingroup	dnpmsgparser
+	 */
+	typedef enum eDNPRangeType_t {
+		DNPRange_Invalid	= 0,	/**< Qualifier code is not supported */
+		DNPRange_StartStop,			/**< Range holds start and stop addresses */
+		DNPRange_Count,				/**< Range holds a count of values */
+		DNPRange_None,				/**< Object has no range and no values */
+	} eDNPRangeType_t;
+
+	/**	@brief		Layout of the range field for a qualifier code
+	 *	@ingroup	dnpmsgparser
+	 */
+	typedef struct sDNPQualRange_t {
+		uint8_t nStartBytes;		/**< Bytes in the start address */
+		uint8_t nStopBytes;			/**< Bytes in the stop address or count */
+		eDNPRangeType_t eType;		/**< How the range is interpreted */
+	} sDNPQualRange_t;
 
 /*****	Constants	*****/
+	/**	@brief		Range layout for each qualifier code, indexed by the code
+	 *	@ingroup	dnpmsgparser
+	 */
+	static const sDNPQualRange_t gDNPQualRange[DNPQual_CodeMask + 1] = {
+		[DNPQual_CodeCountStopAndStart1Bytes]	= { .nStartBytes = 1, .nStopBytes = 1, .eType = DNPRange_StartStop, },
+		[DNPQual_CodeCountStopAndStart2Bytes]	= { .nStartBytes = 2, .nStopBytes = 2, .eType = DNPRange_StartStop, },
+		[DNPQual_CodeCountStopAndStart4Bytes]	= { .nStartBytes = 4, .nStopBytes = 4, .eType = DNPRange_StartStop, },
+		[DNPQual_CodeAddrStopAndStart1Bytes]	= { .nStartBytes = 1, .nStopBytes = 1, .eType = DNPRange_StartStop, },
+		[DNPQual_CodeAddrStopAndStart2Bytes]	= { .nStartBytes = 2, .nStopBytes = 2, .eType = DNPRange_StartStop, },
+		[DNPQual_CodeAddrStopAndStart4Bytes]	= { .nStartBytes = 4, .nStopBytes = 4, .eType = DNPRange_StartStop, },
+		[DNPQual_CodeNoRange]					= { .nStartBytes = 0, .nStopBytes = 0, .eType = DNPRange_None, },
+		[DNPQual_CodeSingleVal1Bytes]			= { .nStartBytes = 0, .nStopBytes = 1, .eType = DNPRange_Count, },
+		[DNPQual_CodeSingleVal2Bytes]			= { .nStartBytes = 0, .nStopBytes = 2, .eType = DNPRange_Count, },
+		[DNPQual_CodeSingleVal4Bytes]			= { .nStartBytes = 0, .nStopBytes = 4, .eType = DNPRange_Count, },
+		[DNPQual_CodeFreeFormat]				= { .nStartBytes = 0, .nStopBytes = 1, .eType = DNPRange_None, },
+	};
+
+	/**	@brief		Prefix bytes for each qualifier index code, 0xFF if not supported
+	 *	@ingroup	dnpmsgparser
+	 */
+	static const uint8_t gDNPQualPrefix[(DNPQual_IndexMask >> 4) + 1] = {
+		0, 1, 2, 4, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	};
 
 
 /*****	Globals		*****/
 
 
 /*****	Prototypes 	*****/
+	/**	@brief		Add a completed link frame to the message being built
+	 *	@details	The frame is decoded where it sits, either in the caller's
+	 *		receive buffer or in the message buffer if it arrived in pieces.
+	 *	@param		pMsg		DNP message object holding the fragment
+	 *	@param		pFrameBytes	First byte of the complete link frame
+	 *	@return		Success if the message is complete, Warn_Incomplete if more
+	 *		fragments are needed, or a failure code if the message was damaged
+	 *	@ingroup	dnpmsgparser
+	 */
+	static eReturn_t DNPParserFragmentComplete(sDNPMsgBuffer_t *pMsg, const uint8_t *pFrameBytes);
+
+	/**	@brief		Read the header of the next data object in user data
+	 *	@param		pData		Buffer holding the application user data
+	 *	@param		nDataLen	Number of bytes of user data
+	 *	@param		pnIdx		Index of the next unread byte, updated as bytes are read
+	 *	@param		eCode		Function code of the message holding the object
+	 *	@param		pObj		Details of the current data object, updated to the next
+	 *	@return		Success if an object was read, Warn_EndOfData if there are no
+	 *		more objects, or Fail_Invalid if the object is damaged
+	 *	@ingroup	dnpmsgparser
+	 */
+	static eReturn_t DNPParserObjectHeader(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj);
+
+	/**	@brief		Read the next value from the current data object in user data
+	 *	@ingroup	dnpmsgparser
+	 */
+	static eReturn_t DNPParserObjectValue(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj, sDNPDataValue_t *pValue);
+
+	/**	@brief		Work out how many points a batch read can decode
+	 *	@details	The batch is also limited to the points whose bytes are all in
+	 *		the user data.
+	 *	@param		nDataLen	Number of bytes of user data
+	 *	@param		nIdx		Index of the current point in the user data
+	 *	@param		eCode		Function code of the message holding the object
+	 *	@param		pObj		Details of the current data object
+	 *	@param		nMaxPoints	Number of points the caller has room for
+	 *	@return		Number of points to decode, 0 if the object has none left
+	 *	@ingroup	dnpmsgparser
+	 */
+	static uint32_t DNPParserBatchSize(uint32_t nDataLen, uint32_t nIdx, eDNPControlCodes_t eCode, const sDNPDataObject_t *pObj, uint32_t nMaxPoints);
+
+	/**	@brief		Read the index of a point from its prefix
+	 *	@ingroup	dnpmsgparser
+	 */
+	static uint32_t DNPParserPrefixIndex(const uint8_t *pPrefix, uint32_t nPrefixBytes);
+
+	/**	@brief		Expand packed bits into one flags byte per point
+	 *	@details	Set bits become DNPBinInFlag_State, clear bits become 0.  Whole
+	 *		bytes are expanded eight points at a time.
+	 *	@param		pBits		First byte of the packed data
+	 *	@param		nFirstBit	Number of the first bit to expand
+	 *	@param		nCount		Number of bits to expand
+	 *	@param		pnFlags		Returns the flags of each point
+	 *	@ingroup	dnpmsgparser
+	 */
+	static void DNPParserUnpackBits(const uint8_t *pBits, uint32_t nFirstBit, uint32_t nCount, uint8_t *pnFlags);
+
+	/**	@brief		Decode a run of binary points from the current data object
+	 *	@ingroup	dnpmsgparser
+	 */
+	static eReturn_t DNPParserBinaryPoints(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj, uint32_t *pnIndexes, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints);
+
+	/**	@brief		Decode a run of analog points from the current data object
+	 *	@ingroup	dnpmsgparser
+	 */
+	static eReturn_t DNPParserAnalogPoints(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj, uint32_t *pnIndexes, int32_t *pnValues, float *pfValues, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints);
 
 
 /*****	Functions	*****/
 eReturn_t DNPParserReceivedData(sDNPMsgBuffer_t *pMsg, uint8_t *pData, uint32_t nDataStart, uint32_t nDataLen, uint32_t *pnDataUsed) {
-	uint32_t nCtr, nShiftCtr, nChunkStartIdx, nCurrIndex = nDataStart;
-	uint16_t nU16Val, nExpMsgSize;
-	crc16_t nCRCVal;
+	uint32_t nCopy, nFragLen, nFrameSize, nCurrIndex = nDataStart;
 
 	*pnDataUsed = 0; //Set the return in case of failure
 
@@ -34,377 +138,568 @@ eReturn_t DNPParserReceivedData(sDNPMsgBuffer_t *pMsg, uint8_t *pData, uint32_t
 		return Fail_Invalid;
 	}
 
-	if (pMsg->nDNPMsgLen == 0) { //We're starting a new message, look for start bytes
-		for (nCtr = nDataStart + 1; nCtr < nDataLen; nCtr++) {
-			nU16Val = pData[nCtr - 1] << 8;
-			nU16Val |= pData[nCtr];
+	//Only a frame split between calls is gathered, it always starts at the beginning
+	pMsg->nFramgentIdx = 0;
 
-			if (nU16Val == DNP_MSGSTARTBYTES) { //Found the start of the message in nCtr - 1
-				UInt16ToBytes(DNP_MSGSTARTBYTES, false, pMsg->aDNPMessage, DNPHdrIdx_StartBytes);
-				pMsg->nFramgentIdx = pMsg->nDNPMsgLen;
-				pMsg->nDNPMsgLen += 2;
-				*pnDataUsed += 2;
-				nCurrIndex = nCtr + 1; //Set the index to right after the start bytes
+	while (nCurrIndex < nDataLen) {
+		nFragLen = pMsg->nDNPMsgLen;
 
+		if (nFragLen == 0) { //Look for the start bytes of the next fragment
+			nCurrIndex += DNPLinkFindStart(&(pData[nCurrIndex]), nDataLen - nCurrIndex);
+			if (nCurrIndex == nDataLen) {
 				break;
 			}
-		}
 
-		if (nCurrIndex == 0) { //No DNP message data could be found
-			*pnDataUsed = nDataLen; //We went through all the data
-			return Warn_Incomplete; //Message is still incomplete
+			if (nDataLen - nCurrIndex >= DNP_MSGHEADERLEN) {
+				nFrameSize = DNPLinkHeaderCheck(&(pData[nCurrIndex]));
+
+				if (nFrameSize == 0) { //Header is invalid, look for start bytes after this one
+					DNPBufferNewMessage(pMsg);
+					nCurrIndex += 1;
+					*pnDataUsed = nCurrIndex - nDataStart;
+					return Warn_Incomplete;
+				}
+
+				if (nDataLen - nCurrIndex >= nFrameSize) { //Whole frame is here, decode it in place
+					nCurrIndex += nFrameSize;
+					*pnDataUsed = nCurrIndex - nDataStart;
+
+					return DNPParserFragmentComplete(pMsg, &(pData[nCurrIndex - nFrameSize]));
+				}
+			}
+		} else if ((nFragLen == 1) && (pData[nCurrIndex] != (DNP_MSGSTARTBYTES & 0x00FF))) {
+			//Byte held from the last call was not really a start byte
+			pMsg->nDNPMsgLen = 0;
+			continue;
 		}
-	}
 
-	if ((pMsg->nDNPMsgLen - pMsg->nFramgentIdx < DNP_MSGHEADERLEN) && (nCurrIndex < nDataLen)) { //Need to get the rest of the header
-		//Loop until we fill the header or run out of data
-		for (nCtr = 0; (pMsg->nDNPMsgLen + nCtr < DNP_MSGHEADERLEN) && (nCurrIndex + nCtr < nDataLen); nCtr++) {
-			pMsg->aDNPMessage[nCtr + pMsg->nDNPMsgLen] = pData[nCtr + nCurrIndex];
+		//Frame runs past the end of this data, gather it until the rest arrives
+		if (nFragLen < DNP_MSGHEADERLEN) {
+			nFrameSize = DNP_MSGHEADERLEN;
+		} else {
+			nFrameSize = DNPLinkFrameSize(pMsg->aDNPMessage[DNPHdrIdx_DataLength]);
 		}
 
-		//Mark off the data pulled out
-		*pnDataUsed += nCtr;
-		nCurrIndex += nCtr;
-		pMsg->nDNPMsgLen += nCtr;
+		nCopy = GetSmallerNum(nFrameSize - nFragLen, nDataLen - nCurrIndex);
+		memcpy(&(pMsg->aDNPMessage[nFragLen]), &(pData[nCurrIndex]), nCopy);
+		pMsg->nDNPMsgLen += nCopy;
+		nCurrIndex += nCopy;
+		nFragLen += nCopy;
 
-		//Did we get all of the header?
-		if (pMsg->nDNPMsgLen == DNP_MSGHEADERLEN) { //Yes, should be all of the header check its CRC
-			nU16Val = BytesToUInt16(pMsg->aDNPMessage, false, DNPHdrIdx_CRC); //CRC in message
-			nCRCVal = CalculateCRC16(CRC_DNP, pMsg->aDNPMessage, DNPHdrIdx_CRC); //Calculated CRC
+		if ((nFragLen == DNP_MSGHEADERLEN) && (nFrameSize == DNP_MSGHEADERLEN)) { //Have the header, make sure its valid
+			nFrameSize = DNPLinkHeaderCheck(pMsg->aDNPMessage);
 
-			if (nCRCVal != nU16Val) { //CRC mismatch
-				DNPBufferNewMessage(pMsg); //This message is invalid, start over
+			if (nFrameSize == 0) { //Header is invalid, start over but keep any start bytes inside it
+				*pnDataUsed = nCurrIndex - nDataStart;
+				nCopy = DNPLinkResync(pMsg->aDNPMessage, DNP_MSGHEADERLEN);
+
+				DNPBufferNewMessage(pMsg);
+				pMsg->nDNPMsgLen = nCopy;
 				return Warn_Incomplete;
 			}
+		}
 
-			//Header is valid, pull out the values
-			pMsg->nDestAddr = BytesToUInt16(pMsg->aDNPMessage, true, DNPHdrIdx_DestAddr);
-			pMsg->nSourceAddr = BytesToUInt16(pMsg->aDNPMessage, true, DNPHdrIdx_SourceAddr);
+		if (nFragLen == nFrameSize) { //Fragment is complete
+			*pnDataUsed = nCurrIndex - nDataStart;
+			pMsg->nDNPMsgLen = 0;
 
-			pMsg->eDataControl = pMsg->aDNPMessage[DNPHdrIdx_DataControl];
-		} else if (pMsg->nDNPMsgLen < DNP_MSGHEADERLEN) { //Message is still incomplete
-			return Warn_Incomplete; //Message is still incomplete
-		} else { //Index is past the header length, something went wrong
-			DNPBufferNewMessage(pMsg); //This message is screwed, start over
-			return Fail_Unknown;
+			return DNPParserFragmentComplete(pMsg, pMsg->aDNPMessage);
 		}
 	}
 
-	//We have the header, figure out how much data we should have
-	nExpMsgSize = pMsg->aDNPMessage[DNPHdrIdx_DataLength] - 5; //Take out the header data bytes
+	*pnDataUsed = nCurrIndex - nDataStart;
+	return Warn_Incomplete; //Message is still incomplete and we're out of data
+}
 
-	if ((nExpMsgSize % DNP_DATACRCCHUNKSIZE) != 0) {
-		nExpMsgSize += (nExpMsgSize / DNP_DATACRCCHUNKSIZE) * 2; //2 CRC bytes for every full data chunk
-		nExpMsgSize += 2; //CRC bytes for the partial chunk
-	} else {
-		nExpMsgSize += (nExpMsgSize / DNP_DATACRCCHUNKSIZE) * 2; //2 CRC bytes for every full data chunk
-	}
+static eReturn_t DNPParserFragmentComplete(sDNPMsgBuffer_t *pMsg, const uint8_t *pFrameBytes) {
+	sDNPLinkFrame_t sFrame;
+	uint32_t nCtr;
 
-	nExpMsgSize += 10; //Add the full header size, not just its data, to get a total message size
+	if (DNPLinkFrameDecode(pFrameBytes, &sFrame) != Success) { //CRC mismatch
+		DNPBufferNewMessage(pMsg); //This message is invalid, start over
+		return Warn_Incomplete;
+	}
 
-	//Do we have all of this message?
-	if ((pMsg->nDNPMsgLen < nExpMsgSize) && (nCurrIndex < nDataLen)) { //Fill up more of the expected data
-		//Figure out where the current data chunk started
-		nChunkStartIdx = pMsg->nDNPMsgLen - 10; //Remove the header bytes
-		nChunkStartIdx -= nChunkStartIdx % (DNP_DATACRCCHUNKSIZE + sizeof(crc16_t)); //The remainder is the partial chunk
-		nChunkStartIdx += 10; //Put the header bytes back in
+	if (sFrame.bHasTransport == false) { //Link layer only frame, nothing for this message
+		return Warn_Incomplete;
+	}
 
-		//Go through the data adding to the message
-		for (nCtr = 0; (pMsg->nDNPMsgLen < nExpMsgSize) && (nCurrIndex + nCtr < nDataLen); nCtr++) {
-			pMsg->aDNPMessage[pMsg->nDNPMsgLen] = pData[nCtr + nCurrIndex];
-			pMsg->nDNPMsgLen += 1;
+	if (CheckAllBitsInMask(sFrame.nTransportHdr, DNPTransHdr_FirstMsg) == true) {
+		pMsg->nUserDataLen = 0; //Previous message never finished, drop it
+	} else if (pMsg->nUserDataLen == 0) { //Missed the first frame, this message can't be used
+		return Warn_Incomplete;
+	} else if ((sFrame.nTransportHdr & DNPTransHdr_SequenceMask) != ((pMsg->nTransportSequence + 1) & DNPTransHdr_SequenceMask)) {
+		DNPBufferNewMessage(pMsg); //A frame in between was lost, this message can't be used
+		return Warn_Incomplete;
+	}
 
-			pMsg->aUserData[pMsg->nUserDataLen] = pData[nCtr + nCurrIndex]; //Fill out the user data too
-			pMsg->nUserDataLen += 1;
+	if (pMsg->nUserDataLen + sFrame.nUserDataLen > DNP_USERDATAMAX) {
+		DNPBufferNewMessage(pMsg);
+		return Fail_BufferSize;
+	}
 
-			if (pMsg->nDNPMsgLen - nChunkStartIdx >= DNP_DATACRCCHUNKSIZE + sizeof(crc16_t)) {
-				nU16Val = BytesToUInt16(pMsg->aDNPMessage, false, pMsg->nDNPMsgLen - 2); //CRC in message
-				nCRCVal = CalculateCRC16(CRC_DNP, &(pMsg->aDNPMessage[nChunkStartIdx]), DNP_DATACRCCHUNKSIZE); //Calculated CRC
-				pMsg->nUserDataLen -= 2; //The CRC value was copied into the user data, overwrite it
-				nChunkStartIdx = pMsg->nDNPMsgLen; //Begin a new chunk
+	pMsg->nDestAddr = sFrame.nDestAddr;
+	pMsg->nSourceAddr = sFrame.nSourceAddr;
+	pMsg->eDataControl = sFrame.eDataControl;
+	pMsg->nTransportSequence = sFrame.nTransportHdr;
 
-				if (nCRCVal != nU16Val) { //CRC mismatch
-					DNPBufferNewMessage(pMsg); //This message is invalid, start over
-					return Warn_Incomplete;
-				}
+	//Spans go straight from the frame into the user data, transport header is already left out
+	for (nCtr = 0; nCtr < sFrame.nSpanCnt; nCtr++) {
+		memcpy(&(pMsg->aUserData[pMsg->nUserDataLen]), sFrame.aSpans[nCtr].pData, sFrame.aSpans[nCtr].nLen);
+		pMsg->nUserDataLen += sFrame.aSpans[nCtr].nLen;
+	}
 
-				//First byte of data section is the transport header, don't put that into user data
-				if (pMsg->nDNPMsgLen - pMsg->nFramgentIdx == DNP_MSGHEADERLEN + DNP_DATACRCCHUNKSIZE + sizeof(crc16_t)) {
-					pMsg->nTransportSequence = pMsg->aUserData[pMsg->nUserDataLen - 16];
+	if (CheckAllBitsInMask(pMsg->nTransportSequence, DNPTransHdr_LastMsg) == false) {
+		return Warn_Incomplete; //This fragment is complete, but the message isn't
+	}
 
-					//Shift the chunk bytes down by 1 to squeeze out the transport header
-					for (nShiftCtr = pMsg->nUserDataLen - 16; nShiftCtr < pMsg->nUserDataLen; nShiftCtr++) {
-						pMsg->aUserData[nShiftCtr] = pMsg->aUserData[nShiftCtr + 1];
-					}
+	pMsg->nTransportSequence &= DNPTransHdr_SequenceMask; //Now filter to just get the sequence
 
-					pMsg->nUserDataLen -= 1; //Remove 1 byte for the discard transport header
-				}
-			}
-		}
+	if (pMsg->nUserDataLen < 2) { //No room for the application header
+		DNPBufferNewMessage(pMsg);
+		return Fail_Invalid;
+	}
 
-		//Mark off the data pulled out
-		*pnDataUsed += nCtr;
-		nCurrIndex += nCtr;
+	//This fragment ends the message, the application header leads the user data
+	pMsg->nApplicationSequence = pMsg->aUserData[0] & DNPAppHdr_SequenceMask;
+	pMsg->eControlCode = pMsg->aUserData[1];
 
-		//Did we get the entire message?
-		if (pMsg->nDNPMsgLen == nExpMsgSize) { //Yup, its at least a full fragment
-			if (nChunkStartIdx != pMsg->nDNPMsgLen) { //Ended with a partial chunk, check its CRC
-				nU16Val = BytesToUInt16(pMsg->aDNPMessage, false, pMsg->nDNPMsgLen - 2); //CRC in message
-				nCRCVal = CalculateCRC16(CRC_DNP, &(pMsg->aDNPMessage[nChunkStartIdx]), pMsg->nDNPMsgLen - (nChunkStartIdx + 2)); //Calculated CRC
+	pMsg->nUserDataIdx = 2; //The application header bytes are processed
 
-				if (nCRCVal != nU16Val) { //CRC mismatch
-					DNPBufferNewMessage(pMsg); //This message is invalid, start over
-					return Warn_Incomplete;
-				}
+	//If the message includes internal indicators, pull those out
+	if ((pMsg->eControlCode == DNPCtrl_Response) || (pMsg->eControlCode == DNPCtrl_Unsolicited)) {
+		if (pMsg->nUserDataLen < 4) { //Responses must carry the indicators
+			DNPBufferNewMessage(pMsg);
+			return Fail_Invalid;
+		}
 
-				pMsg->nUserDataLen -= 2; //The CRC value was copied into the user data, overwrite it
-			}
+		pMsg->eIntIndicators = BytesToUInt16(pMsg->aUserData, true, 2);
+		pMsg->nUserDataIdx += 2; //The internal indicators bytes are processed
+	} else {
+		pMsg->eIntIndicators = DNPIntInd_None;
+	}
 
-			//Transport header indicates if this is the last fragment, make sure we have it
-			if (pMsg->nDNPMsgLen - pMsg->nFramgentIdx < DNP_MSGHEADERLEN + DNP_DATACRCCHUNKSIZE + sizeof(crc16_t)) {
-				//Message didn't have a full chunk, so transport header wasn't extracted yet
-				pMsg->nTransportSequence = pMsg->aDNPMessage[pMsg->nFramgentIdx + DNPHdrIdx_TransportHdr];
+	return Success;
+}
 
-				//Shift the chunk bytes down by 1 to squeeze out the transport header
-				nChunkStartIdx = pMsg->nDNPMsgLen - (nChunkStartIdx + 2); //Calculate the bytes in this chunk
-				for (nShiftCtr = pMsg->nUserDataLen - nChunkStartIdx; nShiftCtr < pMsg->nUserDataLen; nShiftCtr++) {
-					pMsg->aUserData[nShiftCtr] = pMsg->aUserData[nShiftCtr + 1];
-				}
+eReturn_t DNPParserNextDataObject(sDNPMsgBuffer_t *pMsg) {
+	return DNPParserObjectHeader(pMsg->aUserData, pMsg->nUserDataLen, &(pMsg->nUserDataIdx), pMsg->eControlCode, &(pMsg->sDataObj));
+}
 
-				pMsg->nUserDataLen -= 1; //Remove 1 byte for the discard transport header
-			}
+eReturn_t DNPParserNextDataValue(sDNPMsgBuffer_t * pMsg, sDNPDataValue_t *pValue) {
+	return DNPParserObjectValue(pMsg->aUserData, pMsg->nUserDataLen, &(pMsg->nUserDataIdx), pMsg->eControlCode, &(pMsg->sDataObj), pValue);
+}
 
-			if (CheckAllBitsInMask(pMsg->nTransportSequence, DNPTransHdr_LastMsg) == true) {
-				pMsg->nTransportSequence &= DNPTransHdr_SequenceMask; //Now filter to just get the sequence
+eReturn_t DNPParserFragmentNextObject(sDNPAppFragment_t *pFrag) {
+	return DNPParserObjectHeader(pFrag->pData, pFrag->nLen, &(pFrag->nIdx), pFrag->eControlCode, &(pFrag->sDataObj));
+}
 
-				//This fragment ends the message, get the application sequence
-				pMsg->nApplicationSequence = pMsg->aDNPMessage[DNPHdrIdx_AppHdr] & DNPAppHdr_SequenceMask;
-				pMsg->eControlCode = pMsg->aDNPMessage[DNPHdrIdx_ControlCode];
+eReturn_t DNPParserFragmentNextValue(sDNPAppFragment_t *pFrag, sDNPDataValue_t *pValue) {
+	return DNPParserObjectValue(pFrag->pData, pFrag->nLen, &(pFrag->nIdx), pFrag->eControlCode, &(pFrag->sDataObj), pValue);
+}
 
-				pMsg->nUserDataIdx = 2; //The application header bytes are processed
+eReturn_t DNPParserReadBinaryPoints(sDNPMsgBuffer_t *pMsg, uint32_t *pnIndexes, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints) {
+	return DNPParserBinaryPoints(pMsg->aUserData, pMsg->nUserDataLen, &(pMsg->nUserDataIdx), pMsg->eControlCode, &(pMsg->sDataObj), pnIndexes, pnFlags, nMaxPoints, pnPoints);
+}
 
-				//If the message includes internal indicators, pull those out
-				if ((pMsg->eControlCode == DNPCtrl_Response) || (pMsg->eControlCode == DNPCtrl_Unsolicited)) {
-					pMsg->eIntIndicators = BytesToUInt16(pMsg->aDNPMessage, true, DNPHdrIdx_IntIndicators);
-					pMsg->nUserDataIdx += 2; //The internal indicators bytes are processed
-				} else {
-					pMsg->eIntIndicators = DNPIntInd_None;
-				}
+eReturn_t DNPParserReadAnalogPoints(sDNPMsgBuffer_t *pMsg, uint32_t *pnIndexes, int32_t *pnValues, float *pfValues, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints) {
+	return DNPParserAnalogPoints(pMsg->aUserData, pMsg->nUserDataLen, &(pMsg->nUserDataIdx), pMsg->eControlCode, &(pMsg->sDataObj), pnIndexes, pnValues, pfValues, pnFlags, nMaxPoints, pnPoints);
+}
 
-				return Success;
-			} else { //This fragment is complete, but the message isn't
-				return Warn_Incomplete;
-			}
-		} else if (pMsg->nDNPMsgLen < nExpMsgSize) { //Still missing some
-			pMsg->nFramgentIdx = pMsg->nDNPMsgLen + 1; //Next bytes should be a new fragment
-			return Warn_Incomplete; //Current fragment is incomplete
-		} else { //We have too much data in this message?
-			DNPBufferNewMessage(pMsg); //This message is screwed, start over
-			return Fail_Unknown;
-		}
-	}
+eReturn_t DNPParserFragmentReadBinaryPoints(sDNPAppFragment_t *pFrag, uint32_t *pnIndexes, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints) {
+	return DNPParserBinaryPoints(pFrag->pData, pFrag->nLen, &(pFrag->nIdx), pFrag->eControlCode, &(pFrag->sDataObj), pnIndexes, pnFlags, nMaxPoints, pnPoints);
+}
 
-	//Only should get here if we run out of data in the buffer
-	return Warn_Incomplete; //Message is still incomplete and we're out of data
+eReturn_t DNPParserFragmentReadAnalogPoints(sDNPAppFragment_t *pFrag, uint32_t *pnIndexes, int32_t *pnValues, float *pfValues, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints) {
+	return DNPParserAnalogPoints(pFrag->pData, pFrag->nLen, &(pFrag->nIdx), pFrag->eControlCode, &(pFrag->sDataObj), pnIndexes, pnValues, pfValues, pnFlags, nMaxPoints, pnPoints);
 }
 
-eReturn_t DNPParserNextDataObject(sDNPMsgBuffer_t *pMsg) {
-	uint8_t nStartBytes, nStopBytes;
-	uint32_t nCtr;
-	eDNPQualifier_t eQualPart;
+static eReturn_t DNPParserObjectHeader(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj) {
+	const sDNPQualRange_t *pRange;
+	uint32_t nCtr, nValues, nPointBytes, nValueBytes;
 
-	if (pMsg->sDataObj.eGroup != DNPGrp_Unknown) {
+	if (pObj->eGroup != DNPGrp_Unknown) {
 		//Advance to the end of the current object
-		pMsg->nUserDataIdx = pMsg->sDataObj.nIdxStart + pMsg->sDataObj.nTotalBytes;
+		*pnIdx = pObj->nIdxStart + pObj->nTotalBytes;
 	}
 
-	if (pMsg->nUserDataIdx >= pMsg->nUserDataLen) {
-		memset(&(pMsg->sDataObj), 0, sizeof(sDNPDataObject_t));
+	if (*pnIdx >= nDataLen) {
+		memset(pObj, 0, sizeof(sDNPDataObject_t));
+		pObj->eGroup = DNPGrp_Unknown; //Leave the index at the end
 		return Warn_EndOfData;
 	}
 
 	//Save off the starting point of the data object
-	pMsg->sDataObj.nIdxStart = pMsg->nUserDataIdx;
+	pObj->nIdxStart = *pnIdx;
 
 	//Start pulling out data description values
-	pMsg->sDataObj.eGroup = pMsg->aUserData[pMsg->nUserDataIdx];
-	pMsg->nUserDataIdx += 1;
+	pObj->eGroup = pData[*pnIdx];
+	*pnIdx += 1;
 
-	if ((pMsg->sDataObj.eGroup == DNPGrp_VirtualTerminalOut) || (pMsg->sDataObj.eGroup == DNPGrp_VirtualTerminalEvent)) {
+	if ((pObj->eGroup == DNPGrp_VirtualTerminalOut) || (pObj->eGroup == DNPGrp_VirtualTerminalEvent)) {
 		//Virtual terminal stuff doesn't have qualifier or variation, next byte is data length
-		pMsg->sDataObj.nVariation = 0;
-		pMsg->sDataObj.eQualifier = DNPQual_IndexPrefixNone | DNPQual_CodeSingleVal1Bytes;
+		pObj->nVariation = 0;
+		pObj->eQualifier = DNPQual_IndexPrefixNone | DNPQual_CodeSingleVal1Bytes;
 	} else {
-		//All other types have variation and qualifier bytes
-		pMsg->sDataObj.nVariation = pMsg->aUserData[pMsg->nUserDataIdx];
-		pMsg->nUserDataIdx += 1;
-
-		pMsg->sDataObj.eQualifier = pMsg->aUserData[pMsg->nUserDataIdx];
-		pMsg->nUserDataIdx += 1;
-	}
-
-	//The qualifier tells us what the range bytes look like
-	eQualPart = pMsg->sDataObj.eQualifier & DNPQual_CodeMask;
-	switch (eQualPart) {
-		case DNPQual_CodeCountStopAndStart1Bytes:
-		case DNPQual_CodeAddrStopAndStart1Bytes:
-			nStartBytes = 1;
-			nStopBytes = 1;
-			break;
-		case DNPQual_CodeCountStopAndStart2Bytes:
-		case DNPQual_CodeAddrStopAndStart2Bytes:
-			nStartBytes = 2;
-			nStopBytes = 2;
-			break;
-		case DNPQual_CodeCountStopAndStart4Bytes:
-		case DNPQual_CodeAddrStopAndStart4Bytes:
-			nStartBytes = 4;
-			nStopBytes = 4;
-			break;
-		case DNPQual_CodeFreeFormat:
-		case DNPQual_CodeSingleVal1Bytes:
-			nStartBytes = 0;
-			nStopBytes = 1;
-			break;
-		case DNPQual_CodeSingleVal2Bytes:
-			nStartBytes = 0;
-			nStopBytes = 2;
-			break;
-		case DNPQual_CodeSingleVal4Bytes:
-			nStartBytes = 0;
-			nStopBytes = 4;
-			break;
-		case DNPQual_CodeNoRange:
-			nStartBytes = 0;
-			nStopBytes = 0;
-			break;
-		default:
-			//Unrecognized Qualifier code
+		if (*pnIdx + 2 > nDataLen) { //Object header is cut short
 			return Fail_Invalid;
+		}
+
+		//All other types have variation and qualifier bytes
+		pObj->nVariation = pData[*pnIdx];
+		*pnIdx += 1;
+
+		pObj->eQualifier = pData[*pnIdx];
+		*pnIdx += 1;
+	}
+
+	pObj->pDesc = DNPGetDataObjectDescriptor(pObj->eGroup, pObj->nVariation);
+
+	//The qualifier tells us what the range and prefix bytes look like
+	pRange = &(gDNPQualRange[pObj->eQualifier & DNPQual_CodeMask]);
+	pObj->nPrefixBytes = gDNPQualPrefix[(pObj->eQualifier & DNPQual_IndexMask) >> 4];
+
+	if ((pRange->eType == DNPRange_Invalid) || (pObj->nPrefixBytes == 0xFF)) {
+		//Unrecognized Qualifier code
+		return Fail_Invalid;
+	}
+
+	if (*pnIdx + pRange->nStartBytes + pRange->nStopBytes > nDataLen) { //Range is cut short
+		return Fail_Invalid;
 	}
 
 	//Extract the start and stop addresses
-	pMsg->sDataObj.nAddressStart = 0;
-	for (nCtr = 0; nCtr < nStartBytes; nCtr++) {
-		pMsg->sDataObj.nAddressStart |= (pMsg->aUserData[pMsg->nUserDataIdx] << (8 * nCtr));
-		pMsg->nUserDataIdx += 1;
+	pObj->nAddressStart = 0;
+	for (nCtr = 0; nCtr < pRange->nStartBytes; nCtr++) {
+		pObj->nAddressStart |= ((uint32_t)pData[*pnIdx] << (8 * nCtr));
+		*pnIdx += 1;
 	}
 
-	if ((eQualPart == DNPQual_CodeSingleVal1Bytes) || (eQualPart == DNPQual_CodeSingleVal2Bytes) || (eQualPart == DNPQual_CodeSingleVal4Bytes)) {
-		//Single count values must start at 0 to preserve the count
-		pMsg->sDataObj.nAddressStart = 0;
+	pObj->nAddressEnd = 0;
+	for (nCtr = 0; nCtr < pRange->nStopBytes; nCtr++) {
+		pObj->nAddressEnd |= ((uint32_t)pData[*pnIdx] << (8 * nCtr));
+		*pnIdx += 1;
 	}
 
-	pMsg->sDataObj.nAddressEnd = 0;
-	for (nCtr = 0; nCtr < nStopBytes; nCtr++) {
-		pMsg->sDataObj.nAddressEnd |= (pMsg->aUserData[pMsg->nUserDataIdx] << (8 * nCtr));
-		pMsg->nUserDataIdx += 1;
+	//Work out how many values follow the header
+	if (pRange->eType == DNPRange_Count) {
+		//Single count values start at 0 so the addresses cover the count
+		nValues = pObj->nAddressEnd;
+		pObj->nAddressStart = 0;
+		pObj->nAddressEnd = (nValues > 0) ? nValues - 1 : 0;
+	} else if (pRange->eType == DNPRange_None) {
+		nValues = 0;
+	} else if (pObj->nAddressEnd >= pObj->nAddressStart) {
+		nValues = pObj->nAddressEnd - pObj->nAddressStart + 1;
+	} else { //Stop before the start
+		return Fail_Invalid;
 	}
 
-	//Get the number of bits in each value
-	nCtr = pMsg->sDataObj.nAddressEnd - pMsg->sDataObj.nAddressStart; //Number of values
-	pMsg->sDataObj.nDataBytes = DNPGetDataObjectBitSize(pMsg->sDataObj.eGroup, pMsg->sDataObj.nVariation);
+	if ((eCode == DNPCtrl_Read) || (eCode == DNPCtrl_FreezeAndClear)) {
+		//Read and freeze and clear requests do not have any data in the object
+		nValues = 0;
+	}
 
-	if (pMsg->sDataObj.eGroup == DNPGrp_DeviceAttrib) {
-		//Device attributes have a variable size, figure out how big it really is
-		pMsg->sDataObj.nDataBytes = pMsg->aUserData[pMsg->nUserDataIdx + 2]; //Skip over prefix index and type to get length
-		pMsg->sDataObj.nDataBytes += 2; //Don't forget those bytes we skipped
-		pMsg->sDataObj.nDataBytes *= 8; //Switch to bits for a moment
+	pObj->nCurrPoint = 0; //Reset to get first point
+	pObj->nTotalBytes = *pnIdx - pObj->nIdxStart; //Header bytes, the values are added next
+
+	if (nValues == 0) {
+		pObj->nDataBytes = 0;
+		return Success;
 	}
 
-	if (pMsg->sDataObj.nDataBytes == 1) { //Packed bits should not have a prefix
-		pMsg->sDataObj.nTotalBytes = pMsg->sDataObj.nDataBytes / 8;
+	if (pObj->pDesc == NULL) { //Values of an unknown size, the next object can't be found
+		return Fail_Invalid;
+	}
+
+	if (CheckAllBitsInMask(pObj->pDesc->eFlags, DNPObjDesc_Packed) == true) {
+		//Packed bits should not have a prefix
+		pObj->nDataBytes = 0;
+		nValueBytes = (nValues / 8) + (((nValues % 8) != 0) ? 1 : 0);
+	} else {
+		if (CheckAllBitsInMask(pObj->pDesc->eFlags, DNPObjDesc_Variable) == true) {
+			//Device attributes have a variable size, figure out how big it really is
+			if (*pnIdx + pObj->nPrefixBytes + 2 > nDataLen) {
+				return Fail_Invalid;
+			}
 
-		if (pMsg->sDataObj.nDataBytes % 8 != 0) {
-			pMsg->sDataObj.nTotalBytes += 1;
+			pObj->nDataBytes = pData[*pnIdx + pObj->nPrefixBytes + 1] + 2; //Type and length bytes come first
+		} else {
+			pObj->nDataBytes = pObj->pDesc->nBits / 8;
 		}
 
-		pMsg->sDataObj.nDataBytes /= 8; //Convert from bits to bytes
-	} else { //Regular data is in even bytes
-		pMsg->sDataObj.nDataBytes /= 8; //Convert from bits to byte
-
-		pMsg->sDataObj.nTotalBytes = pMsg->sDataObj.nDataBytes * nCtr;
-	}
-
-	//Add in any prefix data
-	eQualPart = pMsg->sDataObj.eQualifier & DNPQual_IndexMask;
-	switch(eQualPart) {
-		case DNPQual_IndexPrefixNone:
-			pMsg->sDataObj.nPrefixBytes = 0;
-			break;
-		case DNPQual_IndexPrefix1Bytes:
-			pMsg->sDataObj.nPrefixBytes = 1;
-			break;
-		case DNPQual_IndexPrefix2Bytes:
-			pMsg->sDataObj.nPrefixBytes = 2;
-			break;
-		case DNPQual_IndexPrefix4Bytes:
-			pMsg->sDataObj.nPrefixBytes = 4;
-			break;
-		default :
+		//Divide rather than multiply, a hostile count would overflow the product
+		nPointBytes = pObj->nDataBytes + pObj->nPrefixBytes;
+		if ((nPointBytes != 0) && (nValues > (nDataLen - *pnIdx) / nPointBytes)) {
 			return Fail_Invalid;
+		}
+
+		nValueBytes = nPointBytes * nValues;
+	}
+
+	if (nValueBytes > nDataLen - *pnIdx) { //Object runs past the end of the data
+		return Fail_Invalid;
 	}
 
-	pMsg->sDataObj.nTotalBytes += pMsg->sDataObj.nPrefixBytes * nCtr;
+	pObj->nTotalBytes += nValueBytes;
 
-	pMsg->sDataObj.nCurrPoint = 0; //Reset to get first point
 	return Success;
 }
 
-eReturn_t DNPParserNextDataValue(sDNPMsgBuffer_t * pMsg, sDNPDataValue_t *pValue) {
+static eReturn_t DNPParserObjectValue(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj, sDNPDataValue_t *pValue) {
 	uint32_t nCtr, nObjBits;
 
-	if (pMsg->sDataObj.eGroup == DNPGrp_Unknown) {
-		//No data object was prepared
+	if ((pObj->eGroup == DNPGrp_Unknown) || (pObj->pDesc == NULL)) {
+		//No data object was prepared, or its values can't be read
 		return Fail_Invalid;
 	}
 
-	if (pMsg->sDataObj.nCurrPoint > pMsg->sDataObj.nAddressEnd - pMsg->sDataObj.nAddressStart) {
+	if (pObj->nCurrPoint > pObj->nAddressEnd - pObj->nAddressStart) {
 		//Out of points in this data object
 		return Warn_EndOfData;
 	}
 
-	if (pMsg->nUserDataIdx + pMsg->sDataObj.nDataBytes >= pMsg->nUserDataLen) {
+	if (*pnIdx + pObj->nPrefixBytes + pObj->nDataBytes > nDataLen) {
 		//Not enough user data left to read this point
 		return Fail_BufferSize;
 	}
 
-	if ((pMsg->eControlCode == DNPCtrl_Read) || (pMsg->eControlCode == DNPCtrl_FreezeAndClear)) {
+	if ((eCode == DNPCtrl_Read) || (eCode == DNPCtrl_FreezeAndClear)) {
 		//Read and freeze and clear requests do not have any data in the object
 		return Warn_EndOfData;
 	}
 
 	//Everything seems to be in order, pull out the point: prefix first
-	for (nCtr = 0; nCtr < pMsg->sDataObj.nPrefixBytes; nCtr++) {
-		pValue->nPrefix[nCtr] = pMsg->aUserData[pMsg->nUserDataIdx]; //Prefix is least significant byte first
-		pMsg->nUserDataIdx += 1;
+	for (nCtr = 0; nCtr < pObj->nPrefixBytes; nCtr++) {
+		pValue->nPrefix[nCtr] = pData[*pnIdx]; //Prefix is least significant byte first
+		*pnIdx += 1;
 	}
 
 	//Next is the data
-	nObjBits = DNPGetDataObjectBitSize(pMsg->sDataObj.eGroup, pMsg->sDataObj.nVariation);
-	if (nObjBits < 8) { //Object uses packed bits
-		nCtr = pMsg->sDataObj.nCurrPoint / 8; // Figure out what byte its in
-		nObjBits = 1 << (pMsg->sDataObj.nCurrPoint % 8); //Which bit in that byte?
+	if (CheckAllBitsInMask(pObj->pDesc->eFlags, DNPObjDesc_Packed) == true) { //Object uses packed bits
+		nCtr = pObj->nCurrPoint / 8; // Figure out what byte its in
+		nObjBits = 1 << (pObj->nCurrPoint % 8); //Which bit in that byte?
 
-		if ((pMsg->aUserData[pMsg->nUserDataIdx + nCtr] & nObjBits) != 0) {
+		if (*pnIdx + nCtr >= nDataLen) {
+			return Fail_BufferSize;
+		}
+
+		if ((pData[*pnIdx + nCtr] & nObjBits) != 0) {
 			pValue->Data.aBytes[0] = DNPBinOutFlag_State;
 		} else {
 			pValue->Data.aBytes[0] = 0;
 		}
-	} else { //Object uses full bytes
-		for (nCtr = 0; nCtr < pMsg->sDataObj.nDataBytes; nCtr++) {
-			pValue->Data.aBytes[nCtr] = pMsg->aUserData[pMsg->nUserDataIdx]; //Data is least significant byte first
-			pMsg->nUserDataIdx += 1;
-		}
+	} else if (pObj->pDesc->pfDecode != NULL) { //Object has a typed form
+		pObj->pDesc->pfDecode(&(pData[*pnIdx]), &(pValue->Data));
+		*pnIdx += pObj->nDataBytes;
+	} else { //Object uses full bytes, keep what fits in the data block
+		memcpy(pValue->Data.aBytes, &(pData[*pnIdx]), GetSmallerNum(pObj->nDataBytes, DNP_OBJECTDATASIZE)); //Data is least significant byte first
+		*pnIdx += pObj->nDataBytes;
 	}
 
 	//Copy in all the object details
-	pValue->eControl = pMsg->eControlCode;
-	pValue->eGroup = pMsg->sDataObj.eGroup;
-	pValue->nVariation = pMsg->sDataObj.nVariation;
-	pValue->nAddress = pMsg->sDataObj.nAddressStart + pMsg->sDataObj.nCurrPoint;
+	pValue->eControl = eCode;
+	pValue->eGroup = pObj->eGroup;
+	pValue->nVariation = pObj->nVariation;
+	pValue->nAddress = pObj->nAddressStart + pObj->nCurrPoint;
+
+	pObj->nCurrPoint += 1; //update to get the next point
+
+	return Success;
+}
+
+static uint32_t DNPParserBatchSize(uint32_t nDataLen, uint32_t nIdx, eDNPControlCodes_t eCode, const sDNPDataObject_t *pObj, uint32_t nMaxPoints) {
+	uint32_t nRemain, nFits, nPointBytes;
+	uint64_t nBits;
+
+	if ((eCode == DNPCtrl_Read) || (eCode == DNPCtrl_FreezeAndClear)) {
+		//Read and freeze and clear requests do not have any data in the object
+		return 0;
+	}
+
+	if ((pObj->eGroup == DNPGrp_Unknown) || (pObj->nCurrPoint > pObj->nAddressEnd - pObj->nAddressStart)) {
+		//No object, or out of points in this one
+		return 0;
+	}
+
+	if (nIdx >= nDataLen) {
+		return 0;
+	}
+
+	nRemain = pObj->nAddressEnd - pObj->nAddressStart + 1 - pObj->nCurrPoint;
+	nRemain = GetSmallerNum(nRemain, nMaxPoints);
+
+	//Never decode past the user data, even if the header said the points fit
+	if (CheckAllBitsInMask(pObj->pDesc->eFlags, DNPObjDesc_Packed) == true) {
+		//The index stays on the first byte of bits, count the bits left after the current point
+		nBits = (uint64_t)(nDataLen - nIdx) * 8;
+		nFits = (nBits > pObj->nCurrPoint) ? (uint32_t)GetSmallerNum(nBits - pObj->nCurrPoint, nRemain) : 0;
+	} else {
+		nPointBytes = pObj->nDataBytes + pObj->nPrefixBytes;
+		nFits = (nPointBytes != 0) ? (nDataLen - nIdx) / nPointBytes : nRemain;
+	}
+
+	return GetSmallerNum(nRemain, nFits);
+}
+
+static uint32_t DNPParserPrefixIndex(const uint8_t *pPrefix, uint32_t nPrefixBytes) {
+	uint32_t nCtr, nIndex = 0;
+
+	for (nCtr = 0; nCtr < nPrefixBytes; nCtr++) {
+		nIndex |= (uint32_t)pPrefix[nCtr] << (8 * nCtr); //Prefix is least significant byte first
+	}
+
+	return nIndex;
+}
+
+static void DNPParserUnpackBits(const uint8_t *pBits, uint32_t nFirstBit, uint32_t nCount, uint8_t *pnFlags) {
+	const uint8_t *pByte = &(pBits[nFirstBit / 8]);
+	uint32_t nBit = nFirstBit % 8;
+	uint8_t nCurr;
+
+	//Finish off a byte that was partly read
+	while ((nBit != 0) && (nCount > 0)) {
+		*pnFlags = (uint8_t)(*pByte << (7 - nBit)) & DNPBinInFlag_State;
+		pnFlags += 1;
+		nCount -= 1;
+
+		nBit = (nBit + 1) % 8;
+		if (nBit == 0) {
+			pByte += 1;
+		}
+	}
+
+	//Whole bytes, move each bit up to the state flag position
+	while (nCount >= 8) {
+		nCurr = *pByte;
+
+		pnFlags[0] = (uint8_t)(nCurr << 7) & DNPBinInFlag_State;
+		pnFlags[1] = (uint8_t)(nCurr << 6) & DNPBinInFlag_State;
+		pnFlags[2] = (uint8_t)(nCurr << 5) & DNPBinInFlag_State;
+		pnFlags[3] = (uint8_t)(nCurr << 4) & DNPBinInFlag_State;
+		pnFlags[4] = (uint8_t)(nCurr << 3) & DNPBinInFlag_State;
+		pnFlags[5] = (uint8_t)(nCurr << 2) & DNPBinInFlag_State;
+		pnFlags[6] = (uint8_t)(nCurr << 1) & DNPBinInFlag_State;
+		pnFlags[7] = nCurr & DNPBinInFlag_State;
+
+		pnFlags += 8;
+		pByte += 1;
+		nCount -= 8;
+	}
+
+	//Leftover bits at the start of the last byte
+	for (nBit = 0; nBit < nCount; nBit++) {
+		pnFlags[nBit] = (uint8_t)(*pByte << (7 - nBit)) & DNPBinInFlag_State;
+	}
+
+	return;
+}
+
+static eReturn_t DNPParserBinaryPoints(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj, uint32_t *pnIndexes, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints) {
+	uint32_t nCtr, nCount;
+
+	*pnPoints = 0;
+
+	if ((pObj->eGroup == DNPGrp_Unknown) || (pObj->pDesc == NULL)) {
+		//No data object was prepared, or its values can't be read
+		return Fail_Invalid;
+	}
+
+	if (CheckAllBitsInMask(pObj->pDesc->eFlags, DNPObjDesc_Packed) == true) {
+		nCount = DNPParserBatchSize(nDataLen, *pnIdx, eCode, pObj, nMaxPoints);
+		if (nCount == 0) {
+			return Warn_EndOfData;
+		}
+
+		//Packed bits have no prefix, the index stays on the first byte of bits
+		DNPParserUnpackBits(&(pData[*pnIdx]), pObj->nCurrPoint, nCount, pnFlags);
+
+		if (pnIndexes != NULL) {
+			for (nCtr = 0; nCtr < nCount; nCtr++) {
+				pnIndexes[nCtr] = pObj->nAddressStart + pObj->nCurrPoint + nCtr;
+			}
+		}
+	} else if ((pObj->eGroup == DNPGrp_BinaryInput) || (pObj->eGroup == DNPGrp_BinaryInputEvent) || (pObj->eGroup == DNPGrp_BinaryOutput)) {
+		nCount = DNPParserBatchSize(nDataLen, *pnIdx, eCode, pObj, nMaxPoints);
+		if (nCount == 0) {
+			return Warn_EndOfData;
+		}
+
+		//Flags are the first byte of each point, anything after is a time stamp
+		for (nCtr = 0; nCtr < nCount; nCtr++) {
+			if (pnIndexes != NULL) {
+				if (pObj->nPrefixBytes != 0) {
+					pnIndexes[nCtr] = DNPParserPrefixIndex(&(pData[*pnIdx]), pObj->nPrefixBytes);
+				} else {
+					pnIndexes[nCtr] = pObj->nAddressStart + pObj->nCurrPoint + nCtr;
+				}
+			}
+
+			*pnIdx += pObj->nPrefixBytes;
+			pnFlags[nCtr] = pData[*pnIdx];
+			*pnIdx += pObj->nDataBytes;
+		}
+	} else { //Not a binary object
+		return Fail_Invalid;
+	}
+
+	pObj->nCurrPoint += nCount;
+	*pnPoints = nCount;
+
+	return Success;
+}
+
+static eReturn_t DNPParserAnalogPoints(const uint8_t *pData, uint32_t nDataLen, uint32_t *pnIdx, eDNPControlCodes_t eCode, sDNPDataObject_t *pObj, uint32_t *pnIndexes, int32_t *pnValues, float *pfValues, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints) {
+	uint32_t nCtr, nCount;
+	uDNPDataBlock_t uPoint;
+
+	*pnPoints = 0;
+
+	if ((pObj->eGroup == DNPGrp_Unknown) || (pObj->pDesc == NULL) || (pObj->pDesc->pfDecode == NULL)) {
+		//No data object was prepared, or its values can't be decoded
+		return Fail_Invalid;
+	}
+
+	if ((pObj->eGroup != DNPGrp_AnalogInput) && (pObj->eGroup != DNPGrp_AnalogInputEvent) && (pObj->eGroup != DNPGrp_AnalogOutput)) {
+		//Not an analog object
+		return Fail_Invalid;
+	}
+
+	nCount = DNPParserBatchSize(nDataLen, *pnIdx, eCode, pObj, nMaxPoints);
+	if (nCount == 0) {
+		return Warn_EndOfData;
+	}
+
+	for (nCtr = 0; nCtr < nCount; nCtr++) {
+		if (pnIndexes != NULL) {
+			if (pObj->nPrefixBytes != 0) {
+				pnIndexes[nCtr] = DNPParserPrefixIndex(&(pData[*pnIdx]), pObj->nPrefixBytes);
+			} else {
+				pnIndexes[nCtr] = pObj->nAddressStart + pObj->nCurrPoint + nCtr;
+			}
+		}
+
+		*pnIdx += pObj->nPrefixBytes;
+
+		//Decoders only write the analog members, the rest of the block is untouched
+		pObj->pDesc->pfDecode(&(pData[*pnIdx]), &uPoint);
+		*pnIdx += pObj->nDataBytes;
+
+		if (pnValues != NULL) {
+			pnValues[nCtr] = uPoint.Analog.nValue;
+		}
+
+		if (pfValues != NULL) {
+			pfValues[nCtr] = (float)uPoint.Analog.dValue;
+		}
+
+		if (pnFlags != NULL) {
+			pnFlags[nCtr] = uPoint.Analog.eFlags;
+		}
+	}
 
-	pMsg->sDataObj.nCurrPoint += 1; //update to get the next point
+	pObj->nCurrPoint += nCount;
+	*pnPoints = nCount;
 
 	return Success;
 }
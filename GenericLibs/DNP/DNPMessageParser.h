@@ -20,6 +20,8 @@
 
 	#include "CRC16.h"
 	#include "DNPBase.h"
+	#include "DNPLinkDeframer.h"
+	#include "DNPFragmentAssembler.h"
 
 /*****	Defines		*****/
 
@@ -66,6 +68,94 @@
 	 */
 	eReturn_t DNPParserNextDataValue(sDNPMsgBuffer_t * pMsg, sDNPDataValue_t *pValue);
 
+	/**	@brief		Read the next data object from an assembled application fragment
+	 *	@param		pFrag		Fragment to read from
+	 *	@return		Success if an object was read, Warn_EndOfData if the last
+	 *		object had been returned, or a failure code if the fragment was
+	 *		invalid or damaged
+	 *	@ingroup	dnpmsgparser
+	 */
+	eReturn_t DNPParserFragmentNextObject(sDNPAppFragment_t *pFrag);
+
+	/**	@brief		Read the next data point from the current object of a fragment
+	 *	@param		pFrag		Fragment to read from
+	 *	@param		pValue		Returns the data point information
+	 *	@return		Success if a point was read, Warn_EndOfData if the object has
+	 *		no more points, or a failure code if the fragment was damaged
+	 *	@ingroup	dnpmsgparser
+	 */
+	eReturn_t DNPParserFragmentNextValue(sDNPAppFragment_t *pFrag, sDNPDataValue_t *pValue);
+
+	/**	@brief		Decode a run of binary points from the current data object
+	 *	@details	Points are written straight into the caller's arrays rather than
+	 *		one sDNPDataValue_t at a time.  Packed objects, such as binary input
+	 *		group 1 variation 1, are unpacked eight points per byte and return
+	 *		DNPBinInFlag_State or 0.  Objects with flags return the flags byte of
+	 *		each point.  Decoding picks up after the last point read, so this
+	 *		may be mixed with DNPParserNextDataValue().
+	 *	@param		pMsg		DNP message object to read from
+	 *	@param		pnIndexes	Returns the index of each point, the prefix if the
+	 *		object has one, may be NULL
+	 *	@param		pnFlags		Returns the flags of each point
+	 *	@param		nMaxPoints	Number of points the arrays can hold
+	 *	@param		pnPoints	Returns the number of points decoded
+	 *	@return		Success if any points were decoded, Warn_EndOfData if the
+	 *		object has no more points, or Fail_Invalid if the object does not hold
+	 *		binary points
+	 *	@ingroup	dnpmsgparser
+	 */
+	eReturn_t DNPParserReadBinaryPoints(sDNPMsgBuffer_t *pMsg, uint32_t *pnIndexes, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints);
+
+	/**	@brief		Decode a run of analog points from the current data object
+	 *	@details	Handles analog inputs, analog input events, and analog output
+	 *		status of every variation with a decoder.  Any of the output arrays may
+	 *		be NULL if that part of the point is not wanted.  Variations without
+	 *		flags report DNPAnaInFlag_Online.
+	 *	@param		pMsg		DNP message object to read from
+	 *	@param		pnIndexes	Returns the index of each point, the prefix if the
+	 *		object has one
+	 *	@param		pnValues	Returns the integer value of each point
+	 *	@param		pfValues	Returns the floating point value of each point
+	 *	@param		pnFlags		Returns the flags of each point
+	 *	@param		nMaxPoints	Number of points the arrays can hold
+	 *	@param		pnPoints	Returns the number of points decoded
+	 *	@return		Success if any points were decoded, Warn_EndOfData if the
+	 *		object has no more points, or Fail_Invalid if the object does not hold
+	 *		analog points
+	 *	@ingroup	dnpmsgparser
+	 */
+	eReturn_t DNPParserReadAnalogPoints(sDNPMsgBuffer_t *pMsg, uint32_t *pnIndexes, int32_t *pnValues, float *pfValues, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints);
+
+	/**	@brief		Decode a run of binary points from the current object of a fragment
+	 *	@details	Behaves the same as DNPParserReadBinaryPoints()
+	 *	@param		pFrag		Fragment to read from
+	 *	@param		pnIndexes	Returns the index of each point, may be NULL
+	 *	@param		pnFlags		Returns the flags of each point
+	 *	@param		nMaxPoints	Number of points the arrays can hold
+	 *	@param		pnPoints	Returns the number of points decoded
+	 *	@return		Success if any points were decoded, Warn_EndOfData if the
+	 *		object has no more points, or Fail_Invalid if the object does not hold
+	 *		binary points
+	 *	@ingroup	dnpmsgparser
+	 */
+	eReturn_t DNPParserFragmentReadBinaryPoints(sDNPAppFragment_t *pFrag, uint32_t *pnIndexes, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints);
+
+	/**	@brief		Decode a run of analog points from the current object of a fragment
+	 *	@details	Behaves the same as DNPParserReadAnalogPoints()
+	 *	@param		pFrag		Fragment to read from
+	 *	@param		pnIndexes	Returns the index of each point, may be NULL
+	 *	@param		pnValues	Returns the integer value of each point, may be NULL
+	 *	@param		pfValues	Returns the floating point value of each point, may be NULL
+	 *	@param		pnFlags		Returns the flags of each point, may be NULL
+	 *	@param		nMaxPoints	Number of points the arrays can hold
+	 *	@param		pnPoints	Returns the number of points decoded
+	 *	@return		Success if any points were decoded, Warn_EndOfData if the
+	 *		object has no more points, or Fail_Invalid if the object does not hold
+	 *		analog points
+	 *	@ingroup	dnpmsgparser
+	 */
+	eReturn_t DNPParserFragmentReadAnalogPoints(sDNPAppFragment_t *pFrag, uint32_t *pnIndexes, int32_t *pnValues, float *pfValues, uint8_t *pnFlags, uint32_t nMaxPoints, uint32_t *pnPoints);
+
 /*****	Functions	*****/
 
 
@@ -0,0 +1,349 @@
+/**	File:	DNPNetChannel.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "DNPNetChannel.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Claim a free connection slot and prepare its connection object
+	 *	@param		pChan		Channel to take the slot from
+	 *	@param		eType		Kind of connection the slot will hold
+	 *	@return		Pointer to the claimed slot, or NULL if all are in use
+	 *	@ingroup	dnpnetchannel
+	 */
+	static sDNPNetConn_t *DNPNetChannelClaim(sDNPNetChannel_t *pChan, eDNPNetConnType_t eType);
+
+	/**	@brief		Convert a network return code, marking the connection lost on failure
+	 *	@ingroup	dnpnetchannel
+	 */
+	static eReturn_t DNPNetChannelResult(sDNPNetConn_t *pConn, eNetReturn_t eResult, uint32_t nWanted, uint32_t nDone);
+
+	/**	@brief		Read data from a connection straight into the caller's buffer
+	 *	@ingroup	dnpnetchannel
+	 */
+	static eReturn_t DNPNetChannelReadData(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize);
+
+	/**	@brief		Send data through a connection in a single request
+	 *	@ingroup	dnpnetchannel
+	 */
+	static eReturn_t DNPNetChannelWriteData(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
+
+	/**	@brief		Read a single byte from a connection
+	 *	@ingroup	dnpnetchannel
+	 */
+	static eReturn_t DNPNetChannelReadByte(sIOConnect_t *pIOObj, uint8_t *pnByte);
+
+	/**	@brief		Send a single byte through a connection
+	 *	@ingroup	dnpnetchannel
+	 */
+	static eReturn_t DNPNetChannelWriteByte(sIOConnect_t *pIOObj, uint8_t nByte);
+
+/*****	Functions	*****/
+eReturn_t DNPNetChannelInitialize(sDNPNetChannel_t *pChan, uint32_t nRecvTimeout) {
+	uint32_t nCtr;
+
+	pChan->pTCPServ = NULL;
+	pChan->nRecvTimeout = nRecvTimeout;
+
+	for (nCtr = 0; nCtr < DNPNET_MAXCONNS; nCtr++) {
+		pChan->aConns[nCtr].eType = DNPNet_Unused;
+		pChan->aConns[nCtr].bOpen = false;
+		pChan->aConns[nCtr].bFixedPeer = false;
+		pChan->aConns[nCtr].sSck.nSocket = SOCKET_INVALID;
+		pChan->aConns[nCtr].pTCPClient = NULL;
+		pChan->aConns[nCtr].pUDPServ = NULL;
+
+		IOCnctObjectInitialize(&(pChan->aConns[nCtr].sIO));
+		pChan->aConns[nCtr].sIO.pClient = NULL;
+	}
+
+	return Success;
+}
+
+eReturn_t DNPNetChannelListenTCP(sDNPNetChannel_t *pChan, sTCPServ_t *pTCPServ, sConnInfo_t *pBind) {
+	sConnInfo_t sBind = *pBind;
+
+	if (sBind.Port == 0) {
+		sBind.Port = DNPNET_PORT;
+	}
+
+	if (pTCPServ->pfBind(pTCPServ, &sBind) != Net_Success) {
+		return Fail_CommError;
+	}
+
+	pChan->pTCPServ = pTCPServ;
+
+	return Success;
+}
+
+eReturn_t DNPNetChannelAcceptTCP(sDNPNetChannel_t *pChan, sIOConnect_t **ppIO) {
+	sDNPNetConn_t *pConn;
+	sSocket_t sSck;
+
+	*ppIO = NULL;
+
+	if (pChan->pTCPServ == NULL) {
+		return Fail_Invalid;
+	}
+
+	if (pChan->pTCPServ->pfAcceptClient(pChan->pTCPServ, &sSck) != Net_Success) {
+		return Fail_CommError;
+	}
+
+	pConn = DNPNetChannelClaim(pChan, DNPNet_TCPServ);
+	if (pConn == NULL) { //No room for another master, turn it away
+		pChan->pTCPServ->pfCloseSocket(pChan->pTCPServ, &sSck);
+		return Fail_BufferSize;
+	}
+
+	pConn->sSck = sSck;
+
+	//Reads must not hold up the master or outstation for long, not all implementations can
+	pChan->pTCPServ->pfSetRecvTimeout(pChan->pTCPServ, &(pConn->sSck), pChan->nRecvTimeout);
+
+	*ppIO = &(pConn->sIO);
+
+	return Success;
+}
+
+eReturn_t DNPNetChannelConnectTCP(sDNPNetChannel_t *pChan, sTCPClient_t *pTCPClient, sConnInfo_t *pServer, sIOConnect_t **ppIO) {
+	sDNPNetConn_t *pConn;
+	sConnInfo_t sServer = *pServer;
+
+	*ppIO = NULL;
+
+	if (sServer.Port == 0) {
+		sServer.Port = DNPNET_PORT;
+	}
+
+	pConn = DNPNetChannelClaim(pChan, DNPNet_TCPClient);
+	if (pConn == NULL) {
+		return Fail_BufferSize;
+	}
+
+	if (pTCPClient->pfConnect(pTCPClient, &sServer) != Net_Success) {
+		pConn->eType = DNPNet_Unused;
+		pConn->bOpen = false;
+		return Fail_CommError;
+	}
+
+	pTCPClient->pfSetRecvTimeout(pTCPClient, pChan->nRecvTimeout);
+
+	pConn->pTCPClient = pTCPClient;
+	pConn->sSck = pTCPClient->Sck;
+	*ppIO = &(pConn->sIO);
+
+	return Success;
+}
+
+eReturn_t DNPNetChannelOpenUDP(sDNPNetChannel_t *pChan, sUDPServ_t *pUDPServ, sConnInfo_t *pBind, sConnInfo_t *pPeer, sIOConnect_t **ppIO) {
+	sDNPNetConn_t *pConn;
+	sConnInfo_t sBind = *pBind;
+
+	*ppIO = NULL;
+
+	if (sBind.Port == 0) {
+		sBind.Port = DNPNET_PORT;
+	}
+
+	pConn = DNPNetChannelClaim(pChan, DNPNet_UDP);
+	if (pConn == NULL) {
+		return Fail_BufferSize;
+	}
+
+	if (pUDPServ->pfBind(pUDPServ, &sBind) != Net_Success) {
+		pConn->eType = DNPNet_Unused;
+		pConn->bOpen = false;
+		return Fail_CommError;
+	}
+
+	//Reads must not hold up the master or outstation for long, not all implementations can
+	pUDPServ->pfSetRecvTimeout(pUDPServ, pChan->nRecvTimeout);
+
+	pConn->pUDPServ = pUDPServ;
+	pConn->sSck.nSocket = pUDPServ->HostSck.nSocket;
+
+	if (pPeer != NULL) {
+		pConn->sSck.Conn = *pPeer;
+		pConn->bFixedPeer = true;
+	} else { //No one to answer until a datagram arrives
+		pConn->sSck.Conn.Addr.nNetLong = 0;
+		pConn->sSck.Conn.Port = 0;
+		pConn->bFixedPeer = false;
+	}
+
+	*ppIO = &(pConn->sIO);
+
+	return Success;
+}
+
+bool DNPNetChannelIsOpen(sIOConnect_t *pIO) {
+	sDNPNetConn_t *pConn = (sDNPNetConn_t *)pIO->pClient;
+
+	if (pConn == NULL) {
+		return false;
+	}
+
+	return pConn->bOpen;
+}
+
+eReturn_t DNPNetChannelClose(sIOConnect_t *pIO) {
+	sDNPNetChannel_t *pChan = (sDNPNetChannel_t *)pIO->pHWInfo;
+	sDNPNetConn_t *pConn = (sDNPNetConn_t *)pIO->pClient;
+
+	if ((pChan == NULL) || (pConn == NULL) || (pConn->eType == DNPNet_Unused)) {
+		return Fail_Invalid;
+	}
+
+	switch (pConn->eType) {
+		case DNPNet_TCPServ:
+			pChan->pTCPServ->pfCloseSocket(pChan->pTCPServ, &(pConn->sSck));
+			break;
+		case DNPNet_TCPClient:
+			pConn->pTCPClient->pfClose(pConn->pTCPClient);
+			break;
+		case DNPNet_UDP:
+			pConn->pUDPServ->pfCloseHost(pConn->pUDPServ);
+			break;
+		default:
+			break;
+	}
+
+	pConn->eType = DNPNet_Unused;
+	pConn->bOpen = false;
+	pConn->sSck.nSocket = SOCKET_INVALID;
+
+	return Success;
+}
+
+static sDNPNetConn_t *DNPNetChannelClaim(sDNPNetChannel_t *pChan, eDNPNetConnType_t eType) {
+	uint32_t nCtr;
+	sDNPNetConn_t *pConn;
+
+	for (nCtr = 0; nCtr < DNPNET_MAXCONNS; nCtr++) {
+		pConn = &(pChan->aConns[nCtr]);
+
+		if (pConn->eType == DNPNet_Unused) {
+			pConn->eType = eType;
+			pConn->bOpen = true;
+			pConn->bFixedPeer = false;
+
+			IOCnctObjectInitialize(&(pConn->sIO));
+			pConn->sIO.pfReadByte = &DNPNetChannelReadByte;
+			pConn->sIO.pfWriteByte = &DNPNetChannelWriteByte;
+			pConn->sIO.pfReadData = &DNPNetChannelReadData;
+			pConn->sIO.pfWriteData = &DNPNetChannelWriteData;
+			pConn->sIO.pHWInfo = pChan;
+			pConn->sIO.pClient = pConn;
+
+			return pConn;
+		}
+	}
+
+	return NULL;
+}
+
+static eReturn_t DNPNetChannelResult(sDNPNetConn_t *pConn, eNetReturn_t eResult, uint32_t nWanted, uint32_t nDone) {
+	if (eResult < Net_Success) { //Network says this connection is no good
+		pConn->bOpen = false;
+		return Fail_CommError;
+	}
+
+	if (nDone < nWanted) {
+		return Warn_EndOfData;
+	}
+
+	return Success;
+}
+
+static eReturn_t DNPNetChannelReadData(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize) {
+	sDNPNetChannel_t *pChan = (sDNPNetChannel_t *)pIOObj->pHWInfo;
+	sDNPNetConn_t *pConn = (sDNPNetConn_t *)pIOObj->pClient;
+	sConnInfo_t sPeer;
+	eNetReturn_t eResult;
+
+	*pnReadSize = 0;
+
+	if (pConn->bOpen == false) {
+		return Fail_CommError;
+	}
+
+	switch (pConn->eType) {
+		case DNPNet_TCPServ:
+			eResult = pChan->pTCPServ->pfReceive(pChan->pTCPServ, &(pConn->sSck), nBuffSize, pnDataBuff, pnReadSize);
+			break;
+		case DNPNet_TCPClient:
+			eResult = pConn->pTCPClient->pfReceive(pConn->pTCPClient, nBuffSize, pnDataBuff, pnReadSize);
+			break;
+		case DNPNet_UDP:
+			eResult = pConn->pUDPServ->pfReceive(pConn->pUDPServ, &sPeer, nBuffSize, pnDataBuff, pnReadSize);
+
+			if ((eResult >= Net_Success) && (*pnReadSize > 0)) {
+				if (pConn->bFixedPeer == false) { //Answer whoever sent this
+					pConn->sSck.Conn = sPeer;
+				} else if ((sPeer.Addr.nNetLong != pConn->sSck.Conn.Addr.nNetLong) || (sPeer.Port != pConn->sSck.Conn.Port)) {
+					*pnReadSize = 0; //Not our peer, drop the datagram
+				}
+			}
+			break;
+		default:
+			return Fail_Invalid;
+	}
+
+	return DNPNetChannelResult(pConn, eResult, nBuffSize, *pnReadSize);
+}
+
+static eReturn_t DNPNetChannelWriteData(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	sDNPNetChannel_t *pChan = (sDNPNetChannel_t *)pIOObj->pHWInfo;
+	sDNPNetConn_t *pConn = (sDNPNetConn_t *)pIOObj->pClient;
+	eNetReturn_t eResult;
+
+	if (pConn->bOpen == false) {
+		return Fail_CommError;
+	}
+
+	switch (pConn->eType) {
+		case DNPNet_TCPServ:
+			eResult = pChan->pTCPServ->pfSend(pChan->pTCPServ, &(pConn->sSck), nDataLen, pnData);
+			break;
+		case DNPNet_TCPClient:
+			eResult = pConn->pTCPClient->pfSend(pConn->pTCPClient, nDataLen, pnData);
+			break;
+		case DNPNet_UDP:
+			if (pConn->sSck.Conn.Port == 0) { //Nobody has spoken to us yet
+				return Fail_Blocked;
+			}
+
+			eResult = pConn->pUDPServ->pfSend(pConn->pUDPServ, &(pConn->sSck.Conn), nDataLen, pnData);
+			break;
+		default:
+			return Fail_Invalid;
+	}
+
+	return DNPNetChannelResult(pConn, eResult, nDataLen, nDataLen);
+}
+
+static eReturn_t DNPNetChannelReadByte(sIOConnect_t *pIOObj, uint8_t *pnByte) {
+	uint32_t nRead;
+
+	return DNPNetChannelReadData(pIOObj, pnByte, 1, &nRead);
+}
+
+static eReturn_t DNPNetChannelWriteByte(sIOConnect_t *pIOObj, uint8_t nByte) {
+	return DNPNetChannelWriteData(pIOObj, &nByte, 1);
+}
+
@@ -0,0 +1,182 @@
+/**	@defgroup	dnpnetchannel		DNP Network Channel
+	@ingroup	dnp
+	@brief		Carries DNP over TCP and UDP using the network general interface
+	@details	v0.1
+	#Description
+		The master and outstation only deal with an sIOConnect_t, this module
+		provides those objects on top of the TCP server, TCP client, and UDP
+		server general interfaces so DNP can run over any implementation of
+		them, such as the Raspberry Pi sockets or the W5500 driver.
+		Received data is read straight into the buffer the master or outstation
+		hands to the channel, nothing is copied or held by the channel.  Every
+		response is given to the network in a single send.
+		A channel holds a pool of connections.  An outstation listening on TCP
+		can accept a connection from several masters at once, each connection
+		gets its own sIOConnect_t.  DNP expects each master to have its own
+		association with the outstation, so each connection should be given
+		its own sDNPOutstation_t with its own event queues.
+		UDP has no connections, a single sIOConnect_t either answers whoever
+		sent the last datagram or only talks with a fixed peer.  Datagrams
+		larger than the buffer given to the read are cut short, so the receive
+		buffer of the master or outstation should be raised to hold the largest
+		datagram expected.
+
+	#Usage
+		Initialize the channel, then either have it listen for TCP connections,
+		connect to a TCP server, or open a UDP port.  Give the sIOConnect_t
+		returned for each connection to a master or outstation.  When the
+		master or outstation reports a failure from its channel check
+		DNPNetChannelIsOpen() and close the connection if it was lost.
+		The general interface does not offer a way to check for pending
+		connections, so DNPNetChannelAcceptTCP() waits until a master connects.
+
+	#File Information
+		File:	DNPNetChannel.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPNETCHANNEL_H
+	#define __DNPNETCHANNEL_H
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "NetworkGeneralInterface.h"
+	#include "Terminal.h"
+
+	#include "DNPBase.h"
+
+/*****	Defines		*****/
+	/**	@brief		Port assigned to DNP over TCP and UDP
+	 *	@ingroup	dnpnetchannel
+	 */
+	#define DNPNET_PORT				20000
+
+	#ifndef DNPNET_MAXCONNS
+		/**	@brief		Number of connections a channel can hold at once
+		 *	@ingroup	dnpnetchannel
+		 */
+		#define DNPNET_MAXCONNS		4
+	#endif
+
+/*****	Definitions	*****/
+	typedef struct sDNPNetChannel_t sDNPNetChannel_t;
+
+	/**	@brief		Kinds of network connection a channel can hold
+	 *	@ingroup	dnpnetchannel
+	 */
+	typedef enum eDNPNetConnType_t {
+		DNPNet_Unused		= 0,	/**< Connection slot is free */
+		DNPNet_TCPServ		= 1,	/**< Client connected to a listening TCP server */
+		DNPNet_TCPClient	= 2,	/**< Connection made to a TCP server */
+		DNPNet_UDP			= 3,	/**< Datagrams through a UDP server */
+	} eDNPNetConnType_t;
+
+	/**	@brief		A single connection held by a channel
+	 *	@ingroup	dnpnetchannel
+	 */
+	typedef struct sDNPNetConn_t {
+		sIOConnect_t sIO;							/**< Connection object handed to the master or outstation */
+		eDNPNetConnType_t eType;					/**< Kind of connection in this slot */
+		sSocket_t sSck;								/**< Client socket for TCP servers, remote peer for UDP */
+		sTCPClient_t *pTCPClient;					/**< TCP client holding the connection, TCP clients only */
+		sUDPServ_t *pUDPServ;						/**< UDP server datagrams pass through, UDP only */
+		bool bOpen;									/**< True until the network reports the connection failed */
+		bool bFixedPeer;							/**< UDP only, true to ignore datagrams from other peers */
+	} sDNPNetConn_t;
+
+	/**	@brief		State of a DNP network channel
+	 *	@ingroup	dnpnetchannel
+	 */
+	typedef struct sDNPNetChannel_t {
+		sTCPServ_t *pTCPServ;						/**< TCP server accepting connections, NULL if not listening */
+		uint32_t nRecvTimeout;						/**< Milliseconds a read waits for data */
+		sDNPNetConn_t aConns[DNPNET_MAXCONNS];		/**< Connections held by the channel */
+	} sDNPNetChannel_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare a channel for use
+	 *	@param		pChan			Channel object to initialize
+	 *	@param		nRecvTimeout	Milliseconds a read waits for data, keep this
+	 *		short as the master and outstation poll their channel
+	 *	@return		Success if the channel is ready
+	 *	@ingroup	dnpnetchannel
+	 */
+	eReturn_t DNPNetChannelInitialize(sDNPNetChannel_t *pChan, uint32_t nRecvTimeout);
+
+	/**	@brief		Listen for TCP connections from masters
+	 *	@param		pChan			Channel to listen with
+	 *	@param		pTCPServ		Initialized TCP server to listen through
+	 *	@param		pBind			Address and port to listen on, a port of 0 uses
+	 *		DNPNET_PORT
+	 *	@return		Success if the port is listening, or Fail_CommError if it could
+	 *		not be bound
+	 *	@ingroup	dnpnetchannel
+	 */
+	eReturn_t DNPNetChannelListenTCP(sDNPNetChannel_t *pChan, sTCPServ_t *pTCPServ, sConnInfo_t *pBind);
+
+	/**	@brief		Wait for a master to connect
+	 *	@param		pChan			Channel that is listening
+	 *	@param		ppIO			Returns the connection object for the new master
+	 *	@return		Success if a master connected, Fail_BufferSize if the channel
+	 *		has no free connections and the master was turned away, or
+	 *		Fail_CommError if the accept failed
+	 *	@ingroup	dnpnetchannel
+	 */
+	eReturn_t DNPNetChannelAcceptTCP(sDNPNetChannel_t *pChan, sIOConnect_t **ppIO);
+
+	/**	@brief		Connect to an outstation listening on TCP
+	 *	@param		pChan			Channel to hold the connection
+	 *	@param		pTCPClient		Initialized TCP client to connect with
+	 *	@param		pServer			Address and port of the outstation, a port of 0
+	 *		uses DNPNET_PORT
+	 *	@param		ppIO			Returns the connection object
+	 *	@return		Success if the connection was made, Fail_BufferSize if the
+	 *		channel has no free connections, or Fail_CommError if the connection
+	 *		failed
+	 *	@ingroup	dnpnetchannel
+	 */
+	eReturn_t DNPNetChannelConnectTCP(sDNPNetChannel_t *pChan, sTCPClient_t *pTCPClient, sConnInfo_t *pServer, sIOConnect_t **ppIO);
+
+	/**	@brief		Open a UDP port to exchange DNP datagrams
+	 *	@param		pChan			Channel to hold the connection
+	 *	@param		pUDPServ		Initialized UDP server to send and receive with
+	 *	@param		pBind			Address and port to receive on, a port of 0 uses
+	 *		DNPNET_PORT
+	 *	@param		pPeer			Only peer to talk with, or NULL to answer whoever
+	 *		sent the last datagram
+	 *	@param		ppIO			Returns the connection object
+	 *	@return		Success if the port is open, Fail_BufferSize if the channel has
+	 *		no free connections, or Fail_CommError if the port could not be bound
+	 *	@ingroup	dnpnetchannel
+	 */
+	eReturn_t DNPNetChannelOpenUDP(sDNPNetChannel_t *pChan, sUDPServ_t *pUDPServ, sConnInfo_t *pBind, sConnInfo_t *pPeer, sIOConnect_t **ppIO);
+
+	/**	@brief		Check if a connection is still usable
+	 *	@param		pIO				Connection object returned by the channel
+	 *	@return		True if the connection is open, false if it was lost or closed
+	 *	@ingroup	dnpnetchannel
+	 */
+	bool DNPNetChannelIsOpen(sIOConnect_t *pIO);
+
+	/**	@brief		Close a connection and free its slot in the channel
+	 *	@param		pIO				Connection object returned by the channel
+	 *	@return		Success if the connection was closed, Fail_Invalid if it does
+	 *		not belong to a channel
+	 *	@ingroup	dnpnetchannel
+	 */
+	eReturn_t DNPNetChannelClose(sIOConnect_t *pIO);
+
+/*****	Functions	*****/
+
+
+#endif
+
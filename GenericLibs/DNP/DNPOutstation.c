@@ -0,0 +1,662 @@
+/**	File:	DNPOutstation.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "DNPOutstation.h"
+
+/*****	Defines		*****/
+	/**	@brief		Bytes used by an event object header: group, variation,
+	 *		qualifier, and a 2 byte count
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOUTSTATION_EVTHEADERLEN	5
+
+	/**	@brief		Bytes used by a static object header: group, variation,
+	 *		qualifier, and 2 byte start and stop addresses
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOUTSTATION_STATHEADERLEN	7
+
+	/**	@brief		Largest number of points the builder takes in one static object
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOUTSTATION_STATPOINTMAX	255
+
+	/**	@brief		Determine if a tick count has been reached, allowing for wrap
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOutstationTickReached(nNow, nTick)	((int32_t)((nNow) - (nTick)) >= 0)
+
+	/**	@brief		Locate an event in a class queue, counting from the oldest
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOutstationEventAt(pQueue, nIdx)	(&((pQueue)->aEvents[((pQueue)->nHead + (nIdx)) % DNPOUTSTATION_EVENTMAX]))
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Record an event in the queue for its class
+	 *	@details	If the queue is full the oldest event is discarded
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationPushEvent(sDNPOutstation_t *pOut, eDNPPollClass_t eClass, eDNPGroup_t eGroup, uint16_t nIndex, uint8_t nFlags, int32_t nValue);
+
+	/**	@brief		Find the internal indicators to report in a response
+	 *	@ingroup	dnpoutstation
+	 */
+	static eDNPInternalIndicators_t DNPOutstationIndicators(sDNPOutstation_t *pOut);
+
+	/**	@brief		Start a new response in the transmit buffer
+	 *	@ingroup	dnpoutstation
+	 */
+	static void DNPOutstationBeginResponse(sDNPOutstation_t *pOut, eDNPControlCodes_t eCode, uint8_t nSequence);
+
+	/**	@brief		Generate the message in the transmit buffer and send it
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationSend(sDNPOutstation_t *pOut);
+
+	/**	@brief		Add unsent events from the queues of some classes
+	 *	@details	Consecutive events of the same group share one object header.
+	 *		Events that are added are marked as sent.
+	 *	@return		Number of events added to the response
+	 *	@ingroup	dnpoutstation
+	 */
+	static uint32_t DNPOutstationAddEvents(sDNPOutstation_t *pOut, eDNPPollClass_t eClasses);
+
+	/**	@brief		Add the static values of all points
+	 *	@ingroup	dnpoutstation
+	 */
+	static void DNPOutstationAddStatic(sDNPOutstation_t *pOut, bool bBinary, bool bAnalog);
+
+	/**	@brief		Handle a complete request from the master
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationRequest(sDNPOutstation_t *pOut, uint32_t nNow);
+
+	/**	@brief		Answer a read request
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationRead(sDNPOutstation_t *pOut, uint8_t nSequence, uint32_t nNow);
+
+	/**	@brief		Answer a select, operate, or direct operate request
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationControl(sDNPOutstation_t *pOut, uint8_t nSequence, uint32_t nNow);
+
+	/**	@brief		Apply an enable or disable unsolicited request
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationUnsolControl(sDNPOutstation_t *pOut, eDNPControlCodes_t eCode, uint8_t nSequence);
+
+	/**	@brief		Remove the events the master confirmed from the queues
+	 *	@ingroup	dnpoutstation
+	 */
+	static void DNPOutstationConfirmed(sDNPOutstation_t *pOut);
+
+	/**	@brief		Forget which events were sent so they go out again
+	 *	@ingroup	dnpoutstation
+	 */
+	static void DNPOutstationUnsend(sDNPOutstation_t *pOut);
+
+	/**	@brief		Send an unsolicited response if the batch is ready
+	 *	@ingroup	dnpoutstation
+	 */
+	static eReturn_t DNPOutstationCheckUnsol(sDNPOutstation_t *pOut, uint32_t nNow);
+
+/*****	Functions	*****/
+eReturn_t DNPOutstationInitialize(sDNPOutstation_t *pOut, sIOConnect_t *pChannel, sTimeIface_t *pTime, uint16_t nAddr, uint16_t nMasterAddr, eDNPObjBinInFlags_t *peBinInputs, uint16_t nBinInputCnt, int32_t *pnAnaInputs, eDNPObjAnaInFlags_t *peAnaFlags, uint16_t nAnaInputCnt, uint32_t nConfirmTimeout) {
+	uint32_t nCtr;
+
+	if ((pChannel == NULL) || (pTime == NULL)) {
+		return Fail_Invalid;
+	}
+
+	if (((nBinInputCnt != 0) && (peBinInputs == NULL)) || ((nAnaInputCnt != 0) && ((pnAnaInputs == NULL) || (peAnaFlags == NULL)))) {
+		return Fail_Invalid;
+	}
+
+	pOut->pChannel = pChannel;
+	pOut->pTime = pTime;
+	pOut->nAddr = nAddr;
+	pOut->nMasterAddr = nMasterAddr;
+
+	pOut->peBinInputs = peBinInputs;
+	pOut->nBinInputCnt = nBinInputCnt;
+	pOut->pnAnaInputs = pnAnaInputs;
+	pOut->peAnaFlags = peAnaFlags;
+	pOut->nAnaInputCnt = nAnaInputCnt;
+	pOut->pCommands = NULL;
+
+	for (nCtr = 0; nCtr < DNPOUTSTATION_NUMCLASSES; nCtr++) {
+		pOut->aQueues[nCtr].nHead = 0;
+		pOut->aQueues[nCtr].nCount = 0;
+		pOut->aQueues[nCtr].nSent = 0;
+	}
+
+	pOut->eIntIndicators = DNPIntInd_None;
+
+	pOut->eUnsolClasses = DNPPoll_None;
+	pOut->nUnsolHold = 0;
+	pOut->nUnsolThreshold = 1;
+	pOut->nConfirmTimeout = nConfirmTimeout;
+
+	pOut->bConfirmPending = false;
+	pOut->bConfirmUnsol = false;
+	pOut->nUnsolSequence = 0;
+	pOut->nTransportSequence = 0;
+
+	DNPBufferNewMessage(&(pOut->sRxMsg));
+	DNPBufferNewMessage(&(pOut->sTxMsg));
+
+	return Success;
+}
+
+eReturn_t DNPOutstationUpdateBinary(sDNPOutstation_t *pOut, uint16_t nIndex, eDNPObjBinInFlags_t eFlags, eDNPPollClass_t eClass) {
+	if (nIndex >= pOut->nBinInputCnt) {
+		return Fail_Invalid;
+	}
+
+	if (pOut->peBinInputs[nIndex] == eFlags) { //No change, no event
+		return Success;
+	}
+
+	pOut->peBinInputs[nIndex] = eFlags;
+
+	return DNPOutstationPushEvent(pOut, eClass, DNPGrp_BinaryInputEvent, nIndex, (uint8_t)eFlags, 0);
+}
+
+eReturn_t DNPOutstationUpdateAnalog(sDNPOutstation_t *pOut, uint16_t nIndex, int32_t nValue, eDNPObjAnaInFlags_t eFlags, eDNPPollClass_t eClass) {
+	if (nIndex >= pOut->nAnaInputCnt) {
+		return Fail_Invalid;
+	}
+
+	if ((pOut->pnAnaInputs[nIndex] == nValue) && (pOut->peAnaFlags[nIndex] == eFlags)) { //No change, no event
+		return Success;
+	}
+
+	pOut->pnAnaInputs[nIndex] = nValue;
+	pOut->peAnaFlags[nIndex] = eFlags;
+
+	return DNPOutstationPushEvent(pOut, eClass, DNPGrp_AnalogInputEvent, nIndex, (uint8_t)eFlags, nValue);
+}
+
+eReturn_t DNPOutstationSetUnsolicited(sDNPOutstation_t *pOut, uint32_t nHold, uint32_t nThreshold) {
+	pOut->nUnsolHold = nHold;
+	pOut->nUnsolThreshold = GetLargerNum(nThreshold, 1);
+
+	return Success;
+}
+
+eReturn_t DNPOutstationSetCommands(sDNPOutstation_t *pOut, sDNPCommandEngine_t *pCommands) {
+	pOut->pCommands = pCommands;
+
+	return Success;
+}
+
+eReturn_t DNPOutstationProcess(sDNPOutstation_t *pOut) {
+	uint32_t nNow, nRead, nIdx, nUsed;
+	eReturn_t eResult;
+
+	//Take in everything the channel has received
+	do {
+		eResult = pOut->pChannel->pfReadData(pOut->pChannel, pOut->aRxBuff, DNPOUTSTATION_RXBUFFSIZE, &nRead);
+		if (eResult < Success) {
+			return eResult;
+		}
+
+		nNow = pOut->pTime->pfGetTicks();
+
+		nIdx = 0;
+		while (nIdx < nRead) {
+			eResult = DNPParserReceivedData(&(pOut->sRxMsg), pOut->aRxBuff, nIdx, nRead, &nUsed);
+			nIdx += nUsed;
+
+			if (eResult == Success) {
+				eResult = DNPOutstationRequest(pOut, nNow);
+				DNPBufferNewMessage(&(pOut->sRxMsg));
+
+				if (eResult < Success) {
+					return eResult;
+				}
+			} else if (eResult < Success) { //Damaged message was discarded, keep going
+				if (nUsed == 0) {
+					nIdx += 1;
+				}
+			}
+		}
+	} while (nRead == DNPOUTSTATION_RXBUFFSIZE); //Filled the buffer, there may be more waiting
+
+	nNow = pOut->pTime->pfGetTicks();
+
+	if (pOut->pCommands != NULL) { //Run any pulse edges that came due
+		DNPCommandProcess(pOut->pCommands, nNow);
+	}
+
+	//Master never confirmed, the events go out again with the next response
+	if ((pOut->bConfirmPending == true) && (DNPOutstationTickReached(nNow, pOut->nConfirmTick + pOut->nConfirmTimeout) == true)) {
+		if (pOut->bConfirmUnsol == true) {
+			pOut->nUnsolSequence = (pOut->nUnsolSequence + 1) & DNPAppHdr_SequenceMask;
+		}
+
+		DNPOutstationUnsend(pOut);
+	}
+
+	return DNPOutstationCheckUnsol(pOut, nNow);
+}
+
+static eReturn_t DNPOutstationPushEvent(sDNPOutstation_t *pOut, eDNPPollClass_t eClass, eDNPGroup_t eGroup, uint16_t nIndex, uint8_t nFlags, int32_t nValue) {
+	sDNPEventQueue_t *pQueue;
+	sDNPEvent_t *pEvent;
+
+	switch (eClass) {
+		case DNPPoll_None:
+		case DNPPoll_Class0: //Static only, no event to record
+			return Success;
+		case DNPPoll_Class1:
+			pQueue = &(pOut->aQueues[0]);
+			break;
+		case DNPPoll_Class2:
+			pQueue = &(pOut->aQueues[1]);
+			break;
+		case DNPPoll_Class3:
+			pQueue = &(pOut->aQueues[2]);
+			break;
+		default: //Events only belong to a single class
+			return Fail_Invalid;
+	}
+
+	if (pQueue->nCount == DNPOUTSTATION_EVENTMAX) { //Queue is full, lose the oldest
+		pQueue->nHead = (pQueue->nHead + 1) % DNPOUTSTATION_EVENTMAX;
+		pQueue->nCount -= 1;
+
+		if (pQueue->nSent > 0) {
+			pQueue->nSent -= 1;
+		}
+
+		pOut->eIntIndicators |= DNPIntInd_BufferOverflow;
+	}
+
+	pEvent = DNPOutstationEventAt(pQueue, pQueue->nCount);
+	pEvent->eGroup = eGroup;
+	pEvent->nIndex = nIndex;
+	pEvent->nFlags = nFlags;
+	pEvent->nValue = nValue;
+	pEvent->nTick = pOut->pTime->pfGetTicks();
+
+	pQueue->nCount += 1;
+
+	return Success;
+}
+
+static eDNPInternalIndicators_t DNPOutstationIndicators(sDNPOutstation_t *pOut) {
+	eDNPInternalIndicators_t eIIN = pOut->eIntIndicators;
+	uint32_t nCtr;
+
+	//Tell the master which classes still have events for it
+	for (nCtr = 0; nCtr < DNPOUTSTATION_NUMCLASSES; nCtr++) {
+		if (pOut->aQueues[nCtr].nCount > pOut->aQueues[nCtr].nSent) {
+			eIIN |= DNPIntInd_Class1Data << nCtr;
+		}
+	}
+
+	return eIIN;
+}
+
+static void DNPOutstationBeginResponse(sDNPOutstation_t *pOut, eDNPControlCodes_t eCode, uint8_t nSequence) {
+	sDNPMsgBuffer_t *pMsg = &(pOut->sTxMsg);
+
+	DNPBufferNewMessage(pMsg);
+	pMsg->nDestAddr = pOut->nMasterAddr;
+	pMsg->nSourceAddr = pOut->nAddr;
+	pMsg->eDataControl = DNPData_Primary | DNPData_UnconfirmData;
+	pMsg->eControlCode = eCode;
+	pMsg->nApplicationSequence = nSequence;
+
+	return;
+}
+
+static eReturn_t DNPOutstationSend(sDNPOutstation_t *pOut) {
+	sDNPMsgBuffer_t *pMsg = &(pOut->sTxMsg);
+	eReturn_t eResult;
+
+	//Indicators are taken last so they reflect the events in this response
+	pMsg->eIntIndicators = DNPOutstationIndicators(pOut);
+	pMsg->nTransportSequence = pOut->nTransportSequence;
+
+	eResult = DNPBuilderGenerateDNP(pMsg);
+	if (eResult != Success) {
+		return eResult;
+	}
+
+	pOut->nTransportSequence = pMsg->nTransportSequence; //Builder advanced it past the fragments sent
+
+	return pOut->pChannel->pfWriteData(pOut->pChannel, pMsg->aDNPMessage, pMsg->nDNPMsgLen);
+}
+
+static uint32_t DNPOutstationAddEvents(sDNPOutstation_t *pOut, eDNPPollClass_t eClasses) {
+	sDNPMsgBuffer_t *pMsg = &(pOut->sTxMsg);
+	sDNPEventQueue_t *pQueue;
+	sDNPEvent_t *pEvent;
+	eDNPGroup_t eGroup;
+	uint32_t nClass, nRun, nFit, nValueLen, nCtr, nAdded = 0;
+	uint8_t aBytes[5];
+
+	for (nClass = 0; nClass < DNPOUTSTATION_NUMCLASSES; nClass++) {
+		if (CheckAllBitsInMask(eClasses, DNPPoll_Class1 << nClass) == false) {
+			continue;
+		}
+
+		pQueue = &(pOut->aQueues[nClass]);
+
+		while (pQueue->nSent < pQueue->nCount) {
+			eGroup = DNPOutstationEventAt(pQueue, pQueue->nSent)->eGroup;
+
+			if (eGroup == DNPGrp_BinaryInputEvent) {
+				nValueLen = 1; //Flags
+			} else {
+				nValueLen = 5; //Flags and a 32 bit value
+			}
+
+			//Gather the run of events that share this group
+			nRun = 1;
+			while ((pQueue->nSent + nRun < pQueue->nCount) && (DNPOutstationEventAt(pQueue, pQueue->nSent + nRun)->eGroup == eGroup)) {
+				nRun += 1;
+			}
+
+			//Only take as many as the response has room for
+			if (pMsg->nUserDataLen + DNPOUTSTATION_EVTHEADERLEN >= DNPOUTSTATION_RESPDATAMAX) {
+				return nAdded;
+			}
+
+			nFit = (DNPOUTSTATION_RESPDATAMAX - pMsg->nUserDataLen - DNPOUTSTATION_EVTHEADERLEN) / (2 + nValueLen);
+			nRun = GetSmallerNum(nRun, nFit);
+			if (nRun == 0) {
+				return nAdded;
+			}
+
+			DNPBuilderAddIndexedObjectHeader(pMsg, eGroup, 1, nRun);
+
+			for (nCtr = 0; nCtr < nRun; nCtr++) {
+				pEvent = DNPOutstationEventAt(pQueue, pQueue->nSent);
+
+				aBytes[0] = pEvent->nFlags;
+				UInt32ToBytes((uint32_t)pEvent->nValue, true, aBytes, 1);
+
+				DNPBuilderAddIndexedValue(pMsg, pEvent->nIndex, aBytes, nValueLen);
+				pQueue->nSent += 1;
+			}
+
+			nAdded += nRun;
+		}
+	}
+
+	return nAdded;
+}
+
+static void DNPOutstationAddStatic(sDNPOutstation_t *pOut, bool bBinary, bool bAnalog) {
+	sDNPMsgBuffer_t *pMsg = &(pOut->sTxMsg);
+	uint32_t nStart, nCount, nFit;
+
+	//Binary inputs with flags, 1 byte per point
+	nStart = 0;
+	while ((bBinary == true) && (nStart < pOut->nBinInputCnt)) {
+		if (pMsg->nUserDataLen + DNPOUTSTATION_STATHEADERLEN >= DNPOUTSTATION_RESPDATAMAX) {
+			pOut->eIntIndicators |= DNPIntInd_BufferOverflow; //Response can't hold all points
+			return;
+		}
+
+		nFit = DNPOUTSTATION_RESPDATAMAX - pMsg->nUserDataLen - DNPOUTSTATION_STATHEADERLEN;
+		nCount = GetSmallerNum(pOut->nBinInputCnt - nStart, DNPOUTSTATION_STATPOINTMAX);
+		nCount = GetSmallerNum(nCount, nFit);
+
+		DNPBuilderAddBinaryInputDataObject(pMsg, 2, nCount, &(pOut->peBinInputs[nStart]), false, nStart);
+		nStart += nCount;
+	}
+
+	//Analog inputs with flags, 5 bytes per point
+	nStart = 0;
+	while ((bAnalog == true) && (nStart < pOut->nAnaInputCnt)) {
+		nFit = 0;
+		if (pMsg->nUserDataLen + DNPOUTSTATION_STATHEADERLEN < DNPOUTSTATION_RESPDATAMAX) {
+			nFit = (DNPOUTSTATION_RESPDATAMAX - pMsg->nUserDataLen - DNPOUTSTATION_STATHEADERLEN) / 5;
+		}
+
+		if (nFit == 0) {
+			pOut->eIntIndicators |= DNPIntInd_BufferOverflow; //Response can't hold all points
+			return;
+		}
+
+		nCount = GetSmallerNum(pOut->nAnaInputCnt - nStart, DNPOUTSTATION_STATPOINTMAX);
+		nCount = GetSmallerNum(nCount, nFit);
+
+		DNPBuilderAddAnalogInputDataObject(pMsg, 1, nCount, &(pOut->pnAnaInputs[nStart]), &(pOut->peAnaFlags[nStart]), nStart);
+		nStart += nCount;
+	}
+
+	return;
+}
+
+static eReturn_t DNPOutstationRequest(sDNPOutstation_t *pOut, uint32_t nNow) {
+	sDNPMsgBuffer_t *pReq = &(pOut->sRxMsg);
+	uint8_t nAppHdr;
+	eReturn_t eResult;
+
+	if ((pReq->nDestAddr != pOut->nAddr) || (pReq->nUserDataLen < 2)) {
+		return Success; //Not for us, or not a request
+	}
+
+	nAppHdr = pReq->aUserData[0];
+
+	switch (pReq->eControlCode) {
+		case DNPCtrl_Confirm:
+			//Only the confirm for the response that is waiting matters
+			if ((pOut->bConfirmPending == true) && (pReq->nApplicationSequence == pOut->nConfirmSeq) && (CheckAllBitsInMask(nAppHdr, DNPAppHdr_Unsolicited) == pOut->bConfirmUnsol)) {
+				if (pOut->bConfirmUnsol == true) {
+					pOut->nUnsolSequence = (pOut->nUnsolSequence + 1) & DNPAppHdr_SequenceMask;
+				}
+
+				DNPOutstationConfirmed(pOut);
+			}
+
+			return Success;
+		case DNPCtrl_Read:
+			return DNPOutstationRead(pOut, pReq->nApplicationSequence, nNow);
+		case DNPCtrl_EnableUnsolicited:
+		case DNPCtrl_DisableUnsolicited:
+			return DNPOutstationUnsolControl(pOut, pReq->eControlCode, pReq->nApplicationSequence);
+		case DNPCtrl_Select:
+		case DNPCtrl_Operate:
+		case DNPCtrl_DirectOperate:
+			if (pOut->pCommands != NULL) {
+				return DNPOutstationControl(pOut, pReq->nApplicationSequence, nNow);
+			}
+			//Fall through - without a command engine controls are not implemented
+		default:
+			DNPOutstationBeginResponse(pOut, DNPCtrl_Response, pReq->nApplicationSequence);
+			pOut->eIntIndicators |= DNPIntInd_NotImplemented;
+			eResult = DNPOutstationSend(pOut);
+			pOut->eIntIndicators &= ~DNPIntInd_NotImplemented; //Only reported in this response
+
+			return eResult;
+	}
+}
+
+static eReturn_t DNPOutstationRead(sDNPOutstation_t *pOut, uint8_t nSequence, uint32_t nNow) {
+	sDNPMsgBuffer_t *pReq = &(pOut->sRxMsg);
+	eDNPPollClass_t eEvents = DNPPoll_None;
+	bool bBinary = false, bAnalog = false, bUnknown = false;
+	eReturn_t eResult;
+
+	//Work out everything requested before building anything
+	while (DNPParserNextDataObject(pReq) == Success) {
+		switch (pReq->sDataObj.eGroup) {
+			case DNPGrp_ClassObjects:
+				if (pReq->sDataObj.nVariation == 1) { //Class 0 is all static data
+					bBinary = true;
+					bAnalog = true;
+				} else if ((pReq->sDataObj.nVariation >= 2) && (pReq->sDataObj.nVariation <= 4)) {
+					eEvents |= DNPPoll_Class1 << (pReq->sDataObj.nVariation - 2);
+				} else {
+					bUnknown = true;
+				}
+				break;
+			case DNPGrp_BinaryInput:
+				bBinary = true;
+				break;
+			case DNPGrp_AnalogInput:
+				bAnalog = true;
+				break;
+			default:
+				bUnknown = true;
+				break;
+		}
+	}
+
+	if ((pOut->bConfirmPending == true) && (pOut->bConfirmUnsol == false)) {
+		//New request means the last response will never be confirmed
+		DNPOutstationUnsend(pOut);
+	}
+
+	DNPOutstationBeginResponse(pOut, DNPCtrl_Response, nSequence);
+
+	if ((eEvents != DNPPoll_None) && (pOut->bConfirmPending == false)) {
+		//Events go ahead of static data so the static values are the newest
+		if (DNPOutstationAddEvents(pOut, eEvents) > 0) {
+			pOut->sTxMsg.bConfirmExpect = true;
+			pOut->bConfirmPending = true;
+			pOut->bConfirmUnsol = false;
+			pOut->nConfirmSeq = nSequence;
+			pOut->nConfirmTick = nNow;
+		}
+	}
+
+	DNPOutstationAddStatic(pOut, bBinary, bAnalog);
+
+	if (bUnknown == true) {
+		pOut->eIntIndicators |= DNPIntInd_ObjectUnknown;
+	}
+
+	eResult = DNPOutstationSend(pOut);
+	pOut->eIntIndicators &= ~DNPIntInd_ObjectUnknown; //Only reported in this response
+
+	return eResult;
+}
+
+static eReturn_t DNPOutstationControl(sDNPOutstation_t *pOut, uint8_t nSequence, uint32_t nNow) {
+	eDNPInternalIndicators_t eIIN;
+	eReturn_t eResult;
+
+	DNPOutstationBeginResponse(pOut, DNPCtrl_Response, nSequence);
+
+	eResult = DNPCommandRequest(pOut->pCommands, &(pOut->sRxMsg), &(pOut->sTxMsg), nNow, &eIIN);
+	if (eResult != Success) {
+		return eResult;
+	}
+
+	pOut->eIntIndicators |= eIIN;
+	eResult = DNPOutstationSend(pOut);
+	pOut->eIntIndicators &= ~eIIN; //Only reported in this response
+
+	return eResult;
+}
+
+static eReturn_t DNPOutstationUnsolControl(sDNPOutstation_t *pOut, eDNPControlCodes_t eCode, uint8_t nSequence) {
+	sDNPMsgBuffer_t *pReq = &(pOut->sRxMsg);
+	eDNPPollClass_t eClasses = DNPPoll_None;
+
+	while (DNPParserNextDataObject(pReq) == Success) {
+		if ((pReq->sDataObj.eGroup == DNPGrp_ClassObjects) && (pReq->sDataObj.nVariation >= 2) && (pReq->sDataObj.nVariation <= 4)) {
+			eClasses |= DNPPoll_Class1 << (pReq->sDataObj.nVariation - 2);
+		}
+	}
+
+	if (eCode == DNPCtrl_EnableUnsolicited) {
+		pOut->eUnsolClasses |= eClasses;
+	} else {
+		pOut->eUnsolClasses &= ~eClasses;
+	}
+
+	DNPOutstationBeginResponse(pOut, DNPCtrl_Response, nSequence);
+
+	return DNPOutstationSend(pOut);
+}
+
+static void DNPOutstationConfirmed(sDNPOutstation_t *pOut) {
+	sDNPEventQueue_t *pQueue;
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < DNPOUTSTATION_NUMCLASSES; nCtr++) {
+		pQueue = &(pOut->aQueues[nCtr]);
+
+		pQueue->nHead = (pQueue->nHead + pQueue->nSent) % DNPOUTSTATION_EVENTMAX;
+		pQueue->nCount -= pQueue->nSent;
+		pQueue->nSent = 0;
+	}
+
+	//Master has what was kept, any loss has been reported
+	pOut->eIntIndicators &= ~DNPIntInd_BufferOverflow;
+	pOut->bConfirmPending = false;
+
+	return;
+}
+
+static void DNPOutstationUnsend(sDNPOutstation_t *pOut) {
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < DNPOUTSTATION_NUMCLASSES; nCtr++) {
+		pOut->aQueues[nCtr].nSent = 0;
+	}
+
+	pOut->bConfirmPending = false;
+
+	return;
+}
+
+static eReturn_t DNPOutstationCheckUnsol(sDNPOutstation_t *pOut, uint32_t nNow) {
+	sDNPEventQueue_t *pQueue;
+	uint32_t nCtr, nWaiting = 0;
+	bool bHeldLongEnough = false;
+
+	if ((pOut->bConfirmPending == true) || (pOut->eUnsolClasses == DNPPoll_None)) {
+		return Success;
+	}
+
+	for (nCtr = 0; nCtr < DNPOUTSTATION_NUMCLASSES; nCtr++) {
+		pQueue = &(pOut->aQueues[nCtr]);
+
+		if ((CheckAllBitsInMask(pOut->eUnsolClasses, DNPPoll_Class1 << nCtr) == false) || (pQueue->nCount == 0)) {
+			continue;
+		}
+
+		nWaiting += pQueue->nCount;
+
+		//Oldest event in each queue sets the deadline for the whole batch
+		if (DNPOutstationTickReached(nNow, DNPOutstationEventAt(pQueue, 0)->nTick + pOut->nUnsolHold) == true) {
+			bHeldLongEnough = true;
+		}
+	}
+
+	if ((nWaiting == 0) || ((nWaiting < pOut->nUnsolThreshold) && (bHeldLongEnough == false))) {
+		return Success; //Keep gathering
+	}
+
+	DNPOutstationBeginResponse(pOut, DNPCtrl_Unsolicited, pOut->nUnsolSequence);
+	DNPOutstationAddEvents(pOut, pOut->eUnsolClasses);
+
+	pOut->bConfirmPending = true;
+	pOut->bConfirmUnsol = true;
+	pOut->nConfirmSeq = pOut->nUnsolSequence;
+	pOut->nConfirmTick = nNow;
+
+	return DNPOutstationSend(pOut);
+}
@@ -0,0 +1,228 @@
+/**	@defgroup	dnpoutstation		DNP Outstation
+	@ingroup	dnp
+	@brief		Answers DNP requests and reports events from a set of points
+	@details	v0.1
+	#Description
+		The outstation serves binary inputs and analog inputs held in arrays
+		owned by the caller.  Whenever a point is updated with a changed value an
+		event is recorded in the queue for the class the point is assigned to.
+		Each class has a fixed size ring buffer of events so class polls are
+		answered straight from the queue without looking over every point.  If a
+		queue fills the oldest event is discarded and the buffer overflow
+		indicator is raised.
+		Events are only removed from a queue once the master confirms the
+		response that carried them.
+		Unsolicited reporting is batched.  Once the master enables a class its
+		events are held until either enough of them have gathered or the oldest
+		has waited the hold time, then they are all sent in one unsolicited
+		response.
+
+	#Usage
+		Initialize the outstation with the channel, time interface, and the
+		point arrays.  Report changes through DNPOutstationUpdateBinary() and
+		DNPOutstationUpdateAnalog() rather than writing the arrays directly.  Call
+		DNPOutstationProcess() regularly, it does not block.  To accept controls
+		attach a command engine with DNPOutstationSetCommands().
+
+	#File Information
+		File:	DNPOutstation.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPOUTSTATION_H
+	#define __DNPOUTSTATION_H
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "TimeGeneralInterface.h"
+	#include "Terminal.h"
+
+	#include "DNPBase.h"
+	#include "DNPCommandEngine.h"
+	#include "DNPLinkDeframer.h"
+	#include "DNPMessageBuilder.h"
+	#include "DNPMessageParser.h"
+
+/*****	Defines		*****/
+	#ifndef DNPOUTSTATION_EVENTMAX
+		/**	@brief		Number of events each class queue can hold
+		 *	@ingroup	dnpoutstation
+		 */
+		#define DNPOUTSTATION_EVENTMAX		32
+	#endif
+
+	/**	@brief		Number of classes that record events, classes 1 through 3
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOUTSTATION_NUMCLASSES	3
+
+	#ifndef DNPOUTSTATION_RXBUFFSIZE
+		/**	@brief		Number of bytes read from the channel at a time
+		 *	@details	Raise this for network channels, datagrams larger than the
+		 *		buffer are cut short
+		 *	@ingroup	dnpoutstation
+		 */
+		#define DNPOUTSTATION_RXBUFFSIZE	DNP_LINKFRAMEMAX
+	#endif
+
+	/**	@brief		Number of object bytes a response can carry
+	 *	@details	Every fragment loses a byte to the transport header, and the
+	 *		first also carries the application header and internal indicators
+	 *	@ingroup	dnpoutstation
+	 */
+	#define DNPOUTSTATION_RESPDATAMAX	((DNP_MAXFRAGMENTMAX * (DNP_LINKUSERDATAMAX - 1)) - 4)
+
+/*****	Definitions	*****/
+	/**	@brief		A single change recorded for a point
+	 *	@ingroup	dnpoutstation
+	 */
+	typedef struct sDNPEvent_t {
+		eDNPGroup_t eGroup;							/**< Event group, binary input or analog input event */
+		uint16_t nIndex;							/**< Index of the point that changed */
+		uint8_t nFlags;								/**< Flags of the point after the change */
+		int32_t nValue;								/**< Value of the point after the change, analog only */
+		uint32_t nTick;								/**< Tick count when the change was recorded */
+	} sDNPEvent_t;
+
+	/**	@brief		Ring buffer of events for a single class
+	 *	@ingroup	dnpoutstation
+	 */
+	typedef struct sDNPEventQueue_t {
+		sDNPEvent_t aEvents[DNPOUTSTATION_EVENTMAX];	/**< Storage for the events */
+		uint32_t nHead;								/**< Index of the oldest event */
+		uint32_t nCount;							/**< Number of events in the queue */
+		uint32_t nSent;								/**< Number of events, from the oldest, sent but not yet confirmed */
+	} sDNPEventQueue_t;
+
+	/**	@brief		State of a DNP outstation
+	 *	@ingroup	dnpoutstation
+	 */
+	typedef struct sDNPOutstation_t {
+		sIOConnect_t *pChannel;						/**< Channel the master is reached through */
+		sTimeIface_t *pTime;						/**< Time interface to use for event times and time outs */
+		uint16_t nAddr;								/**< DNP address of this outstation */
+		uint16_t nMasterAddr;						/**< DNP address of the master to report to */
+
+		eDNPObjBinInFlags_t *peBinInputs;			/**< Current flags of all binary inputs */
+		uint16_t nBinInputCnt;						/**< Number of binary inputs */
+		int32_t *pnAnaInputs;						/**< Current values of all analog inputs */
+		eDNPObjAnaInFlags_t *peAnaFlags;			/**< Current flags of all analog inputs */
+		uint16_t nAnaInputCnt;						/**< Number of analog inputs */
+		sDNPCommandEngine_t *pCommands;				/**< Carries out control requests, NULL if controls are not supported */
+
+		sDNPEventQueue_t aQueues[DNPOUTSTATION_NUMCLASSES];	/**< Event queues for classes 1, 2, and 3 */
+		eDNPInternalIndicators_t eIntIndicators;	/**< Indicators held until they are cleared */
+
+		eDNPPollClass_t eUnsolClasses;				/**< Classes the master enabled for unsolicited reporting */
+		uint32_t nUnsolHold;						/**< Ticks the oldest event is held before it is reported */
+		uint32_t nUnsolThreshold;					/**< Number of events that are reported without waiting */
+		uint32_t nConfirmTimeout;					/**< Ticks to wait for the master to confirm a response */
+
+		bool bConfirmPending;						/**< True while events were sent and await confirmation */
+		bool bConfirmUnsol;							/**< True if the pending confirm is for an unsolicited response */
+		uint8_t nConfirmSeq;						/**< Application sequence of the response awaiting confirmation */
+		uint32_t nConfirmTick;						/**< Tick count the response awaiting confirmation was sent */
+
+		uint8_t nUnsolSequence;						/**< Application sequence of the next unsolicited response */
+		uint8_t nTransportSequence;					/**< Next transport sequence to send */
+
+		uint8_t aRxBuff[DNPOUTSTATION_RXBUFFSIZE];	/**< Data read from the channel */
+		sDNPMsgBuffer_t sRxMsg;						/**< Gathers requests from the master */
+		sDNPMsgBuffer_t sTxMsg;						/**< Builds responses to the master */
+	} sDNPOutstation_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare an outstation for use
+	 *	@details	Unsolicited reporting starts disabled for all classes
+	 *	@param		pOut			Outstation object to initialize
+	 *	@param		pChannel		Channel the master is reached through
+	 *	@param		pTime			Time interface with tick counts
+	 *	@param		nAddr			DNP address of this outstation
+	 *	@param		nMasterAddr		DNP address of the master
+	 *	@param		peBinInputs		Array holding the flags of each binary input
+	 *	@param		nBinInputCnt	Number of binary inputs
+	 *	@param		pnAnaInputs		Array holding the value of each analog input
+	 *	@param		peAnaFlags		Array holding the flags of each analog input
+	 *	@param		nAnaInputCnt	Number of analog inputs
+	 *	@param		nConfirmTimeout	Ticks to wait for the master to confirm events
+	 *	@return		Success if the outstation is ready, Fail_Invalid if a
+	 *		parameter can not be used
+	 *	@ingroup	dnpoutstation
+	 */
+	eReturn_t DNPOutstationInitialize(sDNPOutstation_t *pOut, sIOConnect_t *pChannel, sTimeIface_t *pTime, uint16_t nAddr, uint16_t nMasterAddr, eDNPObjBinInFlags_t *peBinInputs, uint16_t nBinInputCnt, int32_t *pnAnaInputs, eDNPObjAnaInFlags_t *peAnaFlags, uint16_t nAnaInputCnt, uint32_t nConfirmTimeout);
+
+	/**	@brief		Update the state of a binary input
+	 *	@details	An event is only recorded if the flags changed
+	 *	@param		pOut			Outstation holding the point
+	 *	@param		nIndex			Index of the binary input
+	 *	@param		eFlags			New flags of the binary input
+	 *	@param		eClass			Class the event is reported in, DNPPoll_None or
+	 *		DNPPoll_Class0 to record no event
+	 *	@return		Success if the point was updated, Fail_Invalid if the index
+	 *		or class can not be used
+	 *	@ingroup	dnpoutstation
+	 */
+	eReturn_t DNPOutstationUpdateBinary(sDNPOutstation_t *pOut, uint16_t nIndex, eDNPObjBinInFlags_t eFlags, eDNPPollClass_t eClass);
+
+	/**	@brief		Update the value of an analog input
+	 *	@details	An event is only recorded if the value or flags changed
+	 *	@param		pOut			Outstation holding the point
+	 *	@param		nIndex			Index of the analog input
+	 *	@param		nValue			New value of the analog input
+	 *	@param		eFlags			New flags of the analog input
+	 *	@param		eClass			Class the event is reported in, DNPPoll_None or
+	 *		DNPPoll_Class0 to record no event
+	 *	@return		Success if the point was updated, Fail_Invalid if the index
+	 *		or class can not be used
+	 *	@ingroup	dnpoutstation
+	 */
+	eReturn_t DNPOutstationUpdateAnalog(sDNPOutstation_t *pOut, uint16_t nIndex, int32_t nValue, eDNPObjAnaInFlags_t eFlags, eDNPPollClass_t eClass);
+
+	/**	@brief		Configure how unsolicited events are batched
+	 *	@details	The master still needs to enable unsolicited reporting for the
+	 *		classes before any are sent
+	 *	@param		pOut			Outstation to configure
+	 *	@param		nHold			Ticks the oldest event waits for others to join it
+	 *	@param		nThreshold		Number of events that are sent without waiting,
+	 *		0 or 1 to send every event as soon as possible
+	 *	@return		Success if the configuration was applied
+	 *	@ingroup	dnpoutstation
+	 */
+	eReturn_t DNPOutstationSetUnsolicited(sDNPOutstation_t *pOut, uint32_t nHold, uint32_t nThreshold);
+
+	/**	@brief		Give the outstation a command engine to carry out control requests
+	 *	@details	Without one select, operate, and direct operate requests are
+	 *		answered as not implemented.  The engine's pulse scheduler is run
+	 *		each time the outstation is processed.
+	 *	@param		pOut			Outstation to configure
+	 *	@param		pCommands		Initialized command engine, or NULL to refuse controls
+	 *	@return		Success if the engine was applied
+	 *	@ingroup	dnpoutstation
+	 */
+	eReturn_t DNPOutstationSetCommands(sDNPOutstation_t *pOut, sDNPCommandEngine_t *pCommands);
+
+	/**	@brief		Service the channel, answer requests, and report events
+	 *	@details	Reads all available data and answers every complete request,
+	 *		expires a response that was not confirmed, then sends an unsolicited
+	 *		response if the enabled classes have events ready to report.
+	 *	@param		pOut			Outstation object to process
+	 *	@return		Success if the processing completed, or a failure code if
+	 *		the channel reported an error
+	 *	@ingroup	dnpoutstation
+	 */
+	eReturn_t DNPOutstationProcess(sDNPOutstation_t *pOut);
+
+/*****	Functions	*****/
+
+
+#endif
+
@@ -0,0 +1,210 @@
+/**	File:	NetworkClientPool.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "NetworkClientPool.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+eNetReturn_t NetPoolServiceConn(sNetPool_t *pPool, sNetPoolConn_t *pEntry, uint32_t nNow);
+void NetPoolConnected(sNetPoolConn_t *pEntry, uint32_t nNow);
+void NetPoolConnFailed(sNetPoolConn_t *pEntry, uint32_t nNow);
+void NetPoolConnDropped(sNetPoolConn_t *pEntry, uint32_t nNow);
+
+/*****	Functions	*****/
+eNetReturn_t NetPoolInitialize(sNetPool_t *pPool, pfGetCurrentTicks_t pfGetTicks) {
+	pPool->pfGetTicks = pfGetTicks;
+	pPool->nConnCnt = 0;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetPoolAddClient(sNetPool_t *pPool, sTCPClient_t *pClient, sConnInfo_t *pConn) {
+	sNetPoolConn_t *pEntry;
+
+	if (pPool->nConnCnt >= NETPOOL_MAXCONNS) {
+		return NetFail_BuffSize;
+	}
+
+	pEntry = &(pPool->aConns[pPool->nConnCnt]);
+	pPool->nConnCnt += 1;
+
+	pEntry->pClient = pClient;
+	pEntry->Conn = *pConn;
+	pEntry->eState = NetPool_Closed;
+	pEntry->nStateTime = pPool->pfGetTicks();
+	pEntry->nWaitTime = 0; //Connect as soon as possible
+	pEntry->nRetryDelay = NETPOOL_RETRYMIN;
+	pEntry->nConnectCnt = 0;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetPoolService(sNetPool_t *pPool) {
+	uint32_t nCtr, nNow;
+
+	nNow = pPool->pfGetTicks();
+
+	for (nCtr = 0; nCtr < pPool->nConnCnt; nCtr++) {
+		NetPoolServiceConn(pPool, &(pPool->aConns[nCtr]), nNow);
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t NetPoolLease(sNetPool_t *pPool, sConnInfo_t *pConn, sTCPClient_t **ppClient) {
+	sNetPoolConn_t *pEntry;
+	uint32_t nCtr, nNow;
+	bool bKnownServ = false;
+
+	*ppClient = NULL;
+	nNow = pPool->pfGetTicks();
+
+	for (nCtr = 0; nCtr < pPool->nConnCnt; nCtr++) {
+		pEntry = &(pPool->aConns[nCtr]);
+
+		if ((pEntry->Conn.Addr.nNetLong != pConn->Addr.nNetLong) || (pEntry->Conn.Port != pConn->Port)) {
+			continue;
+		}
+
+		bKnownServ = true;
+
+		if (pEntry->eState == NetPool_Ready) { //Make sure the server hasn't closed it while idle
+			if (pEntry->pClient->pfConnectCheck(pEntry->pClient) != Net_Success) {
+				NetPoolConnDropped(pEntry, nNow);
+			}
+		}
+
+		NetPoolServiceConn(pPool, pEntry, nNow);
+
+		if (pEntry->eState == NetPool_Ready) {
+			pEntry->eState = NetPool_Leased;
+			pEntry->nStateTime = nNow;
+
+			*ppClient = pEntry->pClient;
+			return Net_Success;
+		}
+	}
+
+	if (bKnownServ == true) {
+		return NetWarn_InProgress;
+	} else {
+		return NetFail_InvSocket;
+	}
+}
+
+eNetReturn_t NetPoolRelease(sNetPool_t *pPool, sTCPClient_t *pClient, bool bFailed) {
+	sNetPoolConn_t *pEntry;
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < pPool->nConnCnt; nCtr++) {
+		pEntry = &(pPool->aConns[nCtr]);
+
+		if ((pEntry->pClient != pClient) || (pEntry->eState != NetPool_Leased)) {
+			continue;
+		}
+
+		if (bFailed == true) {
+			NetPoolConnDropped(pEntry, pPool->pfGetTicks());
+		} else {
+			pEntry->eState = NetPool_Ready;
+		}
+
+		return Net_Success;
+	}
+
+	return NetFail_InvSocket;
+}
+
+eNetReturn_t NetPoolCloseAll(sNetPool_t *pPool) {
+	uint32_t nCtr, nNow;
+
+	nNow = pPool->pfGetTicks();
+
+	for (nCtr = 0; nCtr < pPool->nConnCnt; nCtr++) {
+		if (pPool->aConns[nCtr].eState != NetPool_Leased) {
+			NetPoolConnDropped(&(pPool->aConns[nCtr]), nNow);
+		}
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t NetPoolServiceConn(sNetPool_t *pPool, sNetPoolConn_t *pEntry, uint32_t nNow) {
+	eNetReturn_t eResult;
+
+	switch (pEntry->eState) {
+		case NetPool_Closed:
+			if (nNow - pEntry->nStateTime < pEntry->nWaitTime) { //Not time to try again
+				break;
+			}
+
+			eResult = pEntry->pClient->pfConnectStart(pEntry->pClient, &(pEntry->Conn));
+
+			if (eResult == Net_Success) {
+				NetPoolConnected(pEntry, nNow);
+			} else if (eResult == NetWarn_InProgress) {
+				pEntry->eState = NetPool_Connecting;
+				pEntry->nStateTime = nNow;
+			} else {
+				NetPoolConnFailed(pEntry, nNow);
+			}
+			break;
+		case NetPool_Connecting:
+			eResult = pEntry->pClient->pfConnectCheck(pEntry->pClient);
+
+			if (eResult == Net_Success) {
+				NetPoolConnected(pEntry, nNow);
+			} else if ((eResult != NetWarn_InProgress) || (nNow - pEntry->nStateTime >= NETPOOL_CONNECTTIME)) {
+				NetPoolConnFailed(pEntry, nNow);
+			}
+			break;
+		default: //Connected, nothing to do
+			break;
+	}
+
+	return Net_Success;
+}
+
+void NetPoolConnected(sNetPoolConn_t *pEntry, uint32_t nNow) {
+	pEntry->eState = NetPool_Ready;
+	pEntry->nStateTime = nNow;
+	pEntry->nRetryDelay = NETPOOL_RETRYMIN;
+	pEntry->nConnectCnt += 1;
+}
+
+void NetPoolConnFailed(sNetPoolConn_t *pEntry, uint32_t nNow) {
+	pEntry->pClient->pfClose(pEntry->pClient);
+
+	pEntry->eState = NetPool_Closed;
+	pEntry->nStateTime = nNow;
+	pEntry->nWaitTime = pEntry->nRetryDelay;
+
+	//Each failure in a row doubles the wait before the next attempt
+	pEntry->nRetryDelay *= 2;
+	if (pEntry->nRetryDelay > NETPOOL_RETRYMAX) {
+		pEntry->nRetryDelay = NETPOOL_RETRYMAX;
+	}
+}
+
+void NetPoolConnDropped(sNetPoolConn_t *pEntry, uint32_t nNow) {
+	//The connection worked, so it is reopened without waiting
+	pEntry->pClient->pfClose(pEntry->pClient);
+
+	pEntry->eState = NetPool_Closed;
+	pEntry->nStateTime = nNow;
+	pEntry->nWaitTime = 0;
+}
@@ -0,0 +1,169 @@
+/**	@defgroup	netclientpool	TCP client connection pool
+	@brief		Keeps TCP client connections open for reuse
+	@details	v0.1
+	#Description
+		Holds a set of TCP clients, each tied to one server address, and keeps
+		them connected so that short repeated uploads do not pay for a new
+		connection each time.  Callers lease a connected client, use it, then
+		release it back to the pool.
+
+		Connections are made without waiting when the client's implementation
+		has the TCPClient_ConnStart capability.  The pool only moves forward
+		when NetPoolService() or NetPoolLease() is called, so it fits in a
+		polling main loop.  A connection attempt that fails is retried after a
+		delay that doubles with each failure, from NETPOOL_RETRYMIN up to
+		NETPOOL_RETRYMAX.  A connection the server closes is reopened right
+		away.
+
+		Several clients can be added for the same address to allow that many
+		leases to it at once.
+
+	#File Information
+		File:	NetworkClientPool.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __NETWORKCLIENTPOOL_H
+	#define __NETWORKCLIENTPOOL_H
+
+/*****	Includes	*****/
+	#include "CommonUtils.h"
+	#include "NetworkGeneralInterface.h"
+	#include "TimeGeneralInterface.h"
+
+/*****	Defines		*****/
+	#ifndef NETPOOL_MAXCONNS
+		/**	@brief		Number of clients one pool can hold
+			@ingroup	netclientpool
+		*/
+		#define NETPOOL_MAXCONNS	8
+	#endif
+
+	#ifndef NETPOOL_RETRYMIN
+		/**	@brief		Milliseconds to wait after the first failed connection attempt
+			@ingroup	netclientpool
+		*/
+		#define NETPOOL_RETRYMIN	250
+	#endif
+
+	#ifndef NETPOOL_RETRYMAX
+		/**	@brief		Most milliseconds to wait between connection attempts
+			@ingroup	netclientpool
+		*/
+		#define NETPOOL_RETRYMAX	30000
+	#endif
+
+	#ifndef NETPOOL_CONNECTTIME
+		/**	@brief		Milliseconds a connection attempt is given before it is failed
+			@ingroup	netclientpool
+		*/
+		#define NETPOOL_CONNECTTIME	5000
+	#endif
+
+/*****	Definitions	*****/
+	/**	@brief		States a pooled connection moves through
+		@ingroup	netclientpool
+	*/
+	typedef enum eNetPoolState_t {
+		NetPool_Closed		= 0,	/**< Not connected, an attempt is made once the wait time passes */
+		NetPool_Connecting	= 1,	/**< Connection is being made */
+		NetPool_Ready		= 2,	/**< Connected and free to lease */
+		NetPool_Leased		= 3,	/**< Connected and in use by a caller */
+	} eNetPoolState_t;
+
+	/**	@brief		One client held by the pool
+		@ingroup	netclientpool
+	*/
+	typedef struct sNetPoolConn_t {
+		sTCPClient_t *pClient;		/**< Client that makes the connection */
+		sConnInfo_t Conn;			/**< Server address the client connects to */
+		eNetPoolState_t eState;		/**< What the connection is doing */
+		uint32_t nStateTime;		/**< Tick count when the current state began */
+		uint32_t nWaitTime;			/**< Milliseconds to wait while closed before connecting */
+		uint32_t nRetryDelay;		/**< Milliseconds to wait after the next failed attempt */
+		uint32_t nConnectCnt;		/**< Connections made, including reconnects */
+	} sNetPoolConn_t;
+
+	/**	@brief		Pool of TCP client connections
+		@ingroup	netclientpool
+	*/
+	typedef struct sNetPool_t {
+		pfGetCurrentTicks_t pfGetTicks;				/**< Returns the current time in milliseconds */
+		uint32_t nConnCnt;							/**< Clients in the pool */
+		sNetPoolConn_t aConns[NETPOOL_MAXCONNS];	/**< Clients and their state */
+	} sNetPool_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare an empty pool
+		@param		pPool		Pool to initialize
+		@param		pfGetTicks	Function returning the current time in milliseconds
+		@return		Net_Success once the pool is ready
+		@ingroup	netclientpool
+	*/
+	eNetReturn_t NetPoolInitialize(sNetPool_t *pPool, pfGetCurrentTicks_t pfGetTicks);
+
+	/**	@brief		Add a client to the pool
+		@details	The client must be initialized by its implementation and not be
+			connected.  The first connection attempt is made on the next service
+			or lease.
+		@param		pPool		Pool to add to
+		@param		pClient		Client to hold connections to the server
+		@param		pConn		Address of the server
+		@return		Net_Success if added, NetFail_BuffSize if the pool is full
+		@ingroup	netclientpool
+	*/
+	eNetReturn_t NetPoolAddClient(sNetPool_t *pPool, sTCPClient_t *pClient, sConnInfo_t *pConn);
+
+	/**	@brief		Move every connection that is not leased forward without waiting
+		@details	Starts connections that are due and checks on those being made.
+			Call regularly so connections are ready before they are leased.
+		@param		pPool		Pool to service
+		@return		Net_Success
+		@ingroup	netclientpool
+	*/
+	eNetReturn_t NetPoolService(sNetPool_t *pPool);
+
+	/**	@brief		Lease a connected client to a server
+		@details	A ready connection is checked before it is leased, if the server
+			has closed it a new one is started.  The client must be given back
+			with NetPoolRelease().
+		@param		pPool		Pool to lease from
+		@param		pConn		Address of the server wanted
+		@param		ppClient	Returns the leased client, NULL if none
+		@return		Net_Success if a client was leased, NetWarn_InProgress if no
+			connection to the server is ready yet, or NetFail_InvSocket if the
+			pool has no client for the server
+		@ingroup	netclientpool
+	*/
+	eNetReturn_t NetPoolLease(sNetPool_t *pPool, sConnInfo_t *pConn, sTCPClient_t **ppClient);
+
+	/**	@brief		Give a leased client back to the pool
+		@param		pPool		Pool the client was leased from
+		@param		pClient		Client being given back
+		@param		bFailed		True if using the connection failed, it will be
+			closed and reopened
+		@return		Net_Success if returned, NetFail_InvSocket if the client was not
+			leased from this pool
+		@ingroup	netclientpool
+	*/
+	eNetReturn_t NetPoolRelease(sNetPool_t *pPool, sTCPClient_t *pClient, bool bFailed);
+
+	/**	@brief		Close every connection in the pool that is not leased
+		@details	Connections are reopened by the next service or lease.
+		@param		pPool		Pool to close
+		@return		Net_Success
+		@ingroup	netclientpool
+	*/
+	eNetReturn_t NetPoolCloseAll(sNetPool_t *pPool);
+
+/*****	Functions	*****/
+
+
+#endif
@@ -4,6 +4,8 @@
 */
 
 /*****	Includes	*****/
+	#include <string.h>
+	
 	#include "NetworkGeneralInterface.h"
 
 /*****	Defines		*****/
@@ -26,14 +28,18 @@ eNetReturn_t IfaceTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck);
 eNetReturn_t IfaceTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pClientSck);
 eNetReturn_t IfaceTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nNumBytes, void *pData, uint32_t *pnBytesRecv);
 eNetReturn_t IfaceTcpServSend(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nDataBytes, void *pData);
+eNetReturn_t IfaceTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nVecCnt, sNetVec_t *pVecs);
 eNetReturn_t IfaceTCPServGetClientInfo(sTCPServ_t *pTCPServ, sConnInfo_t *pConn);
 eNetReturn_t IfaceTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nMillisec);
 
 eNetReturn_t IfaceTCPClientInitialize(sTCPClient_t *pTCPClient);
 eNetReturn_t IfaceTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t IfaceTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t IfaceTCPClientConnectCheck(sTCPClient_t *pTCPClient);
 eNetReturn_t IfaceTCPClientClose(sTCPClient_t *pTCPClient);
 eNetReturn_t IfaceTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nNumBytes, void *pData, uint32_t *pnBytesRecv);
 eNetReturn_t IfaceTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData);
+eNetReturn_t IfaceTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs);
 eNetReturn_t IfaceTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec);
 
 eNetReturn_t IfaceUDPServInitialize(sUDPServ_t *pUDPServ);
@@ -41,6 +47,10 @@ eNetReturn_t IfaceUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn);
 eNetReturn_t IfaceUDPServCloseHost(sUDPServ_t *pUDPServ);
 eNetReturn_t IfaceUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
 eNetReturn_t IfaceUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
+eNetReturn_t IfaceUDPServSendV(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs);
+eNetReturn_t IfaceUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv);
+eNetReturn_t IfaceUDPServSendBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent);
+eNetReturn_t IfaceUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec);
 
 eNetReturn_t IfaceUDPClientInitialize(sUDPClient_t *pUDPClient);
 eNetReturn_t IfaceUDPClientSetServer(sUDPClient_t *pUDPClient, sConnInfo_t *pConn);
@@ -62,6 +72,7 @@ eNetReturn_t IfaceTCPServObjInitialize(sTCPServ_t *pTCPServ) {
 	pTCPServ->pfAcceptClient = &IfaceTCPServAcceptClient;
 	pTCPServ->pfReceive = &IfaceTCPServReceive;
 	pTCPServ->pfSend = &IfaceTcpServSend;
+	pTCPServ->pfSendV = &IfaceTCPServSendV;
 	pTCPServ->pfSetRecvTimeout = &IfaceTCPServSetRecvTimeOut;
 	
 	return Net_Success;
@@ -99,6 +110,41 @@ eNetReturn_t IfaceTcpServSend(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint3
 	return NetFail_NotImplem;
 }
 
+eNetReturn_t IfaceTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	uint8_t aBuff[NETIFACE_SENDVBUFFSIZE];
+	uint32_t nVec, nUsed;
+	eNetReturn_t eResult;
+	
+	//Small pieces are gathered into the buffer, large ones go straight to send
+	nUsed = 0;
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		if ((nUsed > 0) && (nUsed + pVecs[nVec].nBytes > NETIFACE_SENDVBUFFSIZE)) {
+			eResult = pTCPServ->pfSend(pTCPServ, pClientSck, nUsed, aBuff);
+			if (eResult != Net_Success) {
+				return eResult;
+			}
+			
+			nUsed = 0;
+		}
+		
+		if (pVecs[nVec].nBytes >= NETIFACE_SENDVBUFFSIZE) {
+			eResult = pTCPServ->pfSend(pTCPServ, pClientSck, pVecs[nVec].nBytes, pVecs[nVec].pData);
+			if (eResult != Net_Success) {
+				return eResult;
+			}
+		} else {
+			memcpy(&(aBuff[nUsed]), pVecs[nVec].pData, pVecs[nVec].nBytes);
+			nUsed += pVecs[nVec].nBytes;
+		}
+	}
+	
+	if (nUsed > 0) {
+		return pTCPServ->pfSend(pTCPServ, pClientSck, nUsed, aBuff);
+	}
+	
+	return Net_Success;
+}
+
 eNetReturn_t IfaceTCPClientObjInitialize(sTCPClient_t *pTCPClient) {
 	pTCPClient->Sck.nSocket = SOCKET_INVALID;
 	pTCPClient->eCapabilities = TCPClient_None;
@@ -106,9 +152,12 @@ eNetReturn_t IfaceTCPClientObjInitialize(sTCPClient_t *pTCPClient) {
 	
 	pTCPClient->pfInitialize = &IfaceTCPClientInitialize;
 	pTCPClient->pfConnect = &IfaceTCPClientConnect;
+	pTCPClient->pfConnectStart = &IfaceTCPClientConnectStart;
+	pTCPClient->pfConnectCheck = &IfaceTCPClientConnectCheck;
 	pTCPClient->pfClose = &IfaceTCPClientClose;
 	pTCPClient->pfReceive = &IfaceTCPClientReceive;
 	pTCPClient->pfSend = &IfaceTCPClientSend;
+	pTCPClient->pfSendV = &IfaceTCPClientSendV;
 	pTCPClient->pfSetRecvTimeout = &IfaceTCPClientSetRecvTimeOut;
 	
 	return Net_Success;
@@ -122,6 +171,19 @@ eNetReturn_t IfaceTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn)
 	return NetFail_NotImplem;
 }
 
+eNetReturn_t IfaceTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
+	//Without a native way the connection is waited for
+	return pTCPClient->pfConnect(pTCPClient, pConn);
+}
+
+eNetReturn_t IfaceTCPClientConnectCheck(sTCPClient_t *pTCPClient) {
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_SocketState;
+	}
+	
+	return Net_Success;
+}
+
 eNetReturn_t IfaceTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nNumBytes, void *pData, uint32_t *pnBytesRecv) {
 	return NetFail_NotImplem;
 }
@@ -130,6 +192,41 @@ eNetReturn_t IfaceTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, v
 	return NetFail_NotImplem;
 }
 
+eNetReturn_t IfaceTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	uint8_t aBuff[NETIFACE_SENDVBUFFSIZE];
+	uint32_t nVec, nUsed;
+	eNetReturn_t eResult;
+	
+	//Small pieces are gathered into the buffer, large ones go straight to send
+	nUsed = 0;
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		if ((nUsed > 0) && (nUsed + pVecs[nVec].nBytes > NETIFACE_SENDVBUFFSIZE)) {
+			eResult = pTCPClient->pfSend(pTCPClient, nUsed, aBuff);
+			if (eResult != Net_Success) {
+				return eResult;
+			}
+			
+			nUsed = 0;
+		}
+		
+		if (pVecs[nVec].nBytes >= NETIFACE_SENDVBUFFSIZE) {
+			eResult = pTCPClient->pfSend(pTCPClient, pVecs[nVec].nBytes, pVecs[nVec].pData);
+			if (eResult != Net_Success) {
+				return eResult;
+			}
+		} else {
+			memcpy(&(aBuff[nUsed]), pVecs[nVec].pData, pVecs[nVec].nBytes);
+			nUsed += pVecs[nVec].nBytes;
+		}
+	}
+	
+	if (nUsed > 0) {
+		return pTCPClient->pfSend(pTCPClient, nUsed, aBuff);
+	}
+	
+	return Net_Success;
+}
+
 eNetReturn_t IfaceTCPClientClose(sTCPClient_t *pTCPClient) {
 	return NetFail_NotImplem;
 }
@@ -150,6 +247,10 @@ eNetReturn_t IfaceUDPServObjInitialize(sUDPServ_t *pUDPServ) {
 	pUDPServ->pfCloseHost = &IfaceUDPServCloseHost;
 	pUDPServ->pfReceive = &IfaceUDPServReceive;
 	pUDPServ->pfSend = &IfaceUDPServSend;
+	pUDPServ->pfSendV = &IfaceUDPServSendV;
+	pUDPServ->pfReceiveBatch = &IfaceUDPServReceiveBatch;
+	pUDPServ->pfSendBatch = &IfaceUDPServSendBatch;
+	pUDPServ->pfSetRecvTimeout = &IfaceUDPServSetRecvTimeOut;
 	
 	return Net_Success;
 }
@@ -174,6 +275,65 @@ eNetReturn_t IfaceUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t
 	return NetFail_NotImplem;
 }
 
+eNetReturn_t IfaceUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec) {
+	return NetFail_NotImplem;
+}
+
+eNetReturn_t IfaceUDPServSendV(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	uint8_t aBuff[NETIFACE_SENDVBUFFSIZE];
+	uint32_t nVec, nUsed;
+	
+	if (nVecCnt == 1) { //Nothing to gather
+		return pUDPServ->pfSend(pUDPServ, pConn, pVecs[0].nBytes, pVecs[0].pData);
+	}
+	
+	//A datagram can't be split, it all must fit in the buffer
+	nUsed = 0;
+	for (nVec = 0; nVec < nVecCnt; nVec++) {
+		if (pVecs[nVec].nBytes > NETIFACE_SENDVBUFFSIZE - nUsed) {
+			return NetFail_BuffSize;
+		}
+		
+		memcpy(&(aBuff[nUsed]), pVecs[nVec].pData, pVecs[nVec].nBytes);
+		nUsed += pVecs[nVec].nBytes;
+	}
+	
+	return pUDPServ->pfSend(pUDPServ, pConn, nUsed, aBuff);
+}
+
+eNetReturn_t IfaceUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv) {
+	eNetReturn_t eResult;
+	
+	*pnPktsRecv = 0;
+	if (nPktCnt == 0) {
+		return Net_Success;
+	}
+	
+	//A second receive could block, so only take one datagram
+	eResult = pUDPServ->pfReceive(pUDPServ, &(pPkts[0].Conn), pPkts[0].nBuffSize, pPkts[0].pData, &(pPkts[0].nBytes));
+	if ((eResult == Net_Success) && (pPkts[0].nBytes > 0)) {
+		*pnPktsRecv = 1;
+	}
+	
+	return eResult;
+}
+
+eNetReturn_t IfaceUDPServSendBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent) {
+	eNetReturn_t eResult;
+	uint32_t nPkt;
+	
+	for (nPkt = 0; nPkt < nPktCnt; nPkt++) {
+		eResult = pUDPServ->pfSend(pUDPServ, &(pPkts[nPkt].Conn), pPkts[nPkt].nBytes, pPkts[nPkt].pData);
+		if (eResult != Net_Success) {
+			*pnPktsSent = nPkt;
+			return eResult;
+		}
+	}
+	
+	*pnPktsSent = nPktCnt;
+	return Net_Success;
+}
+
 eNetReturn_t IfaceUDPClientObjInitialize(sUDPClient_t *pUDPClient) {
 	pUDPClient->Sck.nSocket = SOCKET_INVALID;
 	pUDPClient->Sck.Conn.Addr.nNetLong = 0;
@@ -22,6 +22,15 @@
 	*/
 	#define SOCKET_INVALID	-1
 	
+	#ifndef NETIFACE_SENDVBUFFSIZE
+		/**	@brief		Bytes gathered at a time by the copying SendV fallback
+			@details	Interfaces without native gathered sends copy the pieces into
+				a buffer of this size on the stack and pass it to their send function.
+			@ingroup	networkgeniface
+		*/
+		#define NETIFACE_SENDVBUFFSIZE	256
+	#endif
+	
 /*****	Definitions	*****/
 	typedef struct sTCPServ_t sTCPServ_t;
 	typedef struct sTCPClient_t sTCPClient_t;
@@ -29,11 +38,13 @@
 	typedef struct sUDPClient_t sUDPClient_t;
 	typedef struct sConnInfo_t sConnInfo_t;
 	typedef struct sSocket_t sSocket_t;
+	typedef struct sNetPacket_t sNetPacket_t;
 
 	/**	@brief		Enumeration of all return codes for ethernet functions
 		@ingroup	networkgeniface
 	*/
 	typedef enum eNetReturn_t {
+		NetWarn_InProgress	= 5,	/**< The operation was started and has not finished yet */
 		NetWarn_EndOfData	= 4,	/**< A read attempt requested more data than was received */
 		NetWarn_WrongPort	= 3,	/**< Data was received from an unexpected port */
 		NetWarn_WrongIP		= 2,	/**< Data was received from an unexpected IP Address */
@@ -45,6 +56,7 @@
 		NetFail_BindErr		= -4,	/**< Unable to bind to the requested port */
 		NetFail_SocketState	= -5,	/**< Socket was in the wrong state for the request */
 		NetFail_ConnRefuse	= -6,	/**< A connection attempt was refused by the server */
+		NetFail_BuffSize	= -7,	/**< Data was too large for the buffer or datagram */
 	} eNetReturn_t;
 	
 	/**	@brief		Enumeration of all capabilities the TCP Server General Interface defines
@@ -59,6 +71,7 @@
 		TCPServ_Send		= 0x10,
 		TCPServ_CloseClient	= 0x20,
 		TCPServ_SetRecvTO	= 0x40,
+		TCPServ_SendV		= 0x80,	/**< Gathered sends are native, no copy is made */
 	} eTCPServerCapabilities_t;
 	
 	/**	@brief		Enumeration of all capabilities the TCP Client General Interface defines
@@ -71,6 +84,8 @@
 		TCPClient_Receive	= 0x04,
 		TCPClient_Send		= 0x08,
 		TCPClient_SetRecvTO	= 0x10,
+		TCPClient_SendV		= 0x20,	/**< Gathered sends are native, no copy is made */
+		TCPClient_ConnStart	= 0x40,	/**< Connections are made without waiting, and can be checked on */
 	} eTCPClientCapabilities_t;
 	
 	/**	@brief		Enumeration of all capabilities the UDP Server General Interface defines
@@ -82,6 +97,9 @@
 		UDPServ_CloseHost	= 0x02,
 		UDPServ_Receive		= 0x04,
 		UDPServ_Send		= 0x08,
+		UDPServ_SendV		= 0x10,	/**< Gathered sends are native, no copy is made */
+		UDPServ_RecvBatch	= 0x20,	/**< Batch receives take every waiting datagram in one call */
+		UDPServ_SendBatch	= 0x40,	/**< Batch sends go out in one call */
 	} eUDPServerCapabilities_t;
 	
 	/**	@brief		Enumeration of all capabilities the UDP Client General Interface defines
@@ -99,6 +117,14 @@
 	*/
 	typedef uint16_t Port_t;
 	
+	/**	@brief		One piece of the data given to a gathered send
+		@ingroup	networkgeniface
+	*/
+	typedef struct sNetVec_t {
+		void *pData;		/**< Bytes in this piece */
+		uint32_t nBytes;	/**< Number of bytes in this piece */
+	} sNetVec_t;
+	
 	/**	@brief		Function that initializes the TCP Server object and readies it for use
 		@param		pTCPServ		Pointer to the TCP Server object to prepare
 		@return		Net_Success on succeess, or a code indicating the type of error encountered
@@ -161,6 +187,19 @@
 	*/
 	typedef eNetReturn_t (*pfNetTCPServSend_t)(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nDataBytes, void *pData);
 	
+	/**	@brief		Send data gathered from several buffers to a client connection
+		@details	The pieces are sent in order as if they were one buffer.  If the 
+			capabilities do not include TCPServ_SendV the pieces are copied together 
+			and handed to the send function.
+		@param		pTCPServ		Pointer to the TCP Server object to use
+		@param		pClientSock		Pointer to the client socket to send the data through
+		@param		nVecCnt			Number of pieces in the list
+		@param		pVecs			List of pieces of data to send
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetTCPServSendV_t)(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nVecCnt, sNetVec_t *pVecs);
+	
 	/**	@brief		Set tme out duration on receive attempts
 		@param		pTCPServ		Pointer to TCP Server object to use
 		@param		pClientSck		Pointer to client socket to modify
@@ -185,6 +224,28 @@
 	*/
 	typedef eNetReturn_t (*pfNetTCPClientConnect_t)(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
 	
+	/**	@brief		Begins a connection to a TCP server without waiting for it to finish
+		@details	If the capabilities do not include TCPClient_ConnStart this waits 
+			for the connection like pfConnect does.
+		@param		pTCPClient		Pointer to the TCP Client object to use
+		@param		pConn			Connection information of the TCP server
+		@return		Net_Success if already connected, NetWarn_InProgress if the 
+			connection is being made, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetTCPClientConnectStart_t)(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+	
+	/**	@brief		Checks on a connection without waiting
+		@details	Reports if a connection begun with pfConnectStart has finished, and
+			if an established connection is still open.
+		@param		pTCPClient		Pointer to the TCP Client object to use
+		@return		Net_Success if connected, NetWarn_InProgress if the connection is
+			still being made, NetFail_ConnRefuse if the server refused it, or
+			NetFail_SocketState if the connection failed or was closed
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetTCPClientConnectCheck_t)(sTCPClient_t *pTCPClient);
+	
 	/**	@brief		Closes the TCP connection
 		@param		pTCPClient		Pointer to hte TCP Client object to use
 		@return		Net_Success on succeess, or a code indicating the type of error encountered
@@ -211,6 +272,18 @@
 	*/
 	typedef eNetReturn_t (*pfNetTCPClientSend_t)(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData);
 	
+	/**	@brief		Send data gathered from several buffers to a TCP server
+		@details	The pieces are sent in order as if they were one buffer.  If the 
+			capabilities do not include TCPClient_SendV the pieces are copied together 
+			and handed to the send function.
+		@param		pTCPClient		Pointer to hte TCP Client object to use
+		@param		nVecCnt			Number of pieces in the list
+		@param		pVecs			List of pieces of data to send
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetTCPClientSendV_t)(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs);
+	
 	/**	@brief		Set tme out duration on receive attempts
 		@param		pTCPClient		Pointer to TCP Client object to use
 		@param		nMillisec		Number of milliseconds to set as the timeout period
@@ -225,6 +298,54 @@
 	typedef eNetReturn_t (*pfNetUDPServReceive_t)(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
 	typedef eNetReturn_t (*pfNetUDPServSend_t)(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
 	
+	/**	@brief		Set time out duration on receive attempts
+		@details	A receive that times out succeeds with no bytes
+		@param		pUDPServ		Pointer to the UDP Server object to use
+		@param		nMillisec		Number of milliseconds to set as the timeout period
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetUDPServSetRecvTimeOut_t)(sUDPServ_t *pUDPServ, uint32_t nMillisec);
+	
+	/**	@brief		Send one datagram gathered from several buffers
+		@details	If the capabilities do not include UDPServ_SendV the pieces are 
+			copied together and must fit in NETIFACE_SENDVBUFFSIZE bytes.
+		@param		pUDPServ		Pointer to the UDP Server object to use
+		@param		pConn			Address and port to send the datagram to
+		@param		nVecCnt			Number of pieces in the list
+		@param		pVecs			List of pieces of data to send
+		@return		Net_Success on succeess, NetFail_BuffSize if the pieces would not 
+			fit in the copy buffer, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetUDPServSendV_t)(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs);
+	
+	/**	@brief		Receive several datagrams in one call
+		@details	Waits for the first datagram like the receive function, then 
+			takes any others already waiting without waiting further.  If the 
+			capabilities do not include UDPServ_RecvBatch only one datagram is 
+			returned per call, as the receive function may block waiting for more.
+		@param		pUDPServ		Pointer to the UDP Server object to use
+		@param		nPktCnt			Number of packets in the list
+		@param		pPkts			List of packets, returns the data, size, and source of each
+		@param		pnPktsRecv		Returns the number of packets that were filled in
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetUDPServReceiveBatch_t)(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv);
+	
+	/**	@brief		Send several datagrams in one call
+		@details	If the capabilities do not include UDPServ_SendBatch each packet
+			is handed to the send function in turn.
+		@param		pUDPServ		Pointer to the UDP Server object to use
+		@param		nPktCnt			Number of packets in the list
+		@param		pPkts			List of packets, each with its data, size, and destination
+		@param		pnPktsSent		Returns the number of packets sent before any error
+		@return		Net_Success on succeess, or a code indicating the type of error encountered
+		@ingroup	networkgeniface
+	*/
+	typedef eNetReturn_t (*pfNetUDPServSendBatch_t)(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent);
+	
 	typedef eNetReturn_t (*pfNetUDPClientInitialize_t)(sUDPClient_t *pUDPClient);
 	typedef eNetReturn_t (*pgNetUDPClientSetServer_t)(sUDPClient_t *pUDPClient, sConnInfo_t *pConn);
 	typedef eNetReturn_t (*pfNetUDPClientClose_t)(sUDPClient_t *pUDPClient);
@@ -264,6 +385,18 @@
 		sConnInfo_t Conn;	/**< Information on the remote system, unused by interface */
 	} sSocket_t;
 	
+	/**	@brief		One datagram in a batch receive or send
+		@details	Callers keep an array of these, each with its own buffer, and
+			reuse it as a ring of packets from one batch to the next.
+		@ingroup	networkgeniface
+	*/
+	typedef struct sNetPacket_t {
+		sConnInfo_t Conn;	/**< Where the datagram came from, or where to send it */
+		void *pData;		/**< Buffer holding the datagram */
+		uint32_t nBuffSize;	/**< Bytes the buffer can hold when receiving */
+		uint32_t nBytes;	/**< Bytes of data in the datagram */
+	} sNetPacket_t;
+	
 	/**	@brief		TCP Server object
 		@ingroup	networkgeniface
 	*/
@@ -278,6 +411,7 @@
 		pfNetTCPServAcceptClient_t pfAcceptClient;	/**< Function to wait for an accept an client connection */
 		pfNetTCPServReceive_t pfReceive;			/**< Function to receive data from a client connection */
 		pfNetTCPServSend_t pfSend;					/**< Function to send data to a client connection */
+		pfNetTCPServSendV_t pfSendV;				/**< Function to send data gathered from several buffers */
 		pfNetTCPServSetRecvTimeOut_t pfSetRecvTimeout;	/**< Function to set timeout on receive requests */
 		
 		void *pHWInfo;								/**< Information for use by the implementation */
@@ -292,9 +426,12 @@
 		
 		pfNetTCPClientInitialize_t pfInitialize;	/**< Function to initialize the implementation */
 		pfNetTCPClientConnect_t pfConnect;			/**< Function to establish the connection through */
+		pfNetTCPClientConnectStart_t pfConnectStart;	/**< Function to begin a connection without waiting */
+		pfNetTCPClientConnectCheck_t pfConnectCheck;	/**< Function to check on the connection without waiting */
 		pfNetTCPClientClose_t pfClose;				/**< Function to close the connection */
 		pfNetTCPClientReceive_t pfReceive;			/**< Function to receive data from the server */
 		pfNetTCPClientSend_t pfSend;				/**< Function to send data to the server */
+		pfNetTCPClientSendV_t pfSendV;				/**< Function to send data gathered from several buffers */
 		pfNetTCPClientSetRecvTimeOut_t pfSetRecvTimeout;	/**< Function to set timeout on receive requests */
 		
 		void *pHWInfo;								/**< Information for use by the implementation */
@@ -309,6 +446,10 @@
 		pfNetUDPServCloseHost_t pfCloseHost;
 		pfNetUDPServReceive_t pfReceive;
 		pfNetUDPServSend_t pfSend;
+		pfNetUDPServSendV_t pfSendV;
+		pfNetUDPServReceiveBatch_t pfReceiveBatch;
+		pfNetUDPServSendBatch_t pfSendBatch;
+		pfNetUDPServSetRecvTimeOut_t pfSetRecvTimeout;	/**< Function to set timeout on receive requests */
 		
 		void *pHWInfo;
 	} sUDPServ_t;
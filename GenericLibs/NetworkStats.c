@@ -0,0 +1,826 @@
+/**	File:	NetworkStats.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "NetworkStats.h"
+
+/*****	Defines		*****/
+	/**	@brief		Longest line written in a terminal report
+		@ingroup	netstats
+	*/
+	#define NETSTATS_LINELEN	160
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	/**	@brief		First of the statistics readable from a terminal
+		@ingroup	netstats
+	*/
+	sNetStats_t *gpNetStatsList = NULL;
+
+/*****	Prototypes 	*****/
+eNetReturn_t NetStatsTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn);
+eNetReturn_t NetStatsTCPServCloseHost(sTCPServ_t *pTCPServ);
+eNetReturn_t NetStatsTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSocket);
+eNetReturn_t NetStatsTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSocket);
+eNetReturn_t NetStatsTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t NetStatsTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nDataBytes, void *pData);
+eNetReturn_t NetStatsTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nVecCnt, sNetVec_t *pVecs);
+eNetReturn_t NetStatsTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nMillisec);
+
+eNetReturn_t NetStatsTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t NetStatsTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t NetStatsTCPClientConnectCheck(sTCPClient_t *pTCPClient);
+eNetReturn_t NetStatsTCPClientClose(sTCPClient_t *pTCPClient);
+eNetReturn_t NetStatsTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t NetStatsTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData);
+eNetReturn_t NetStatsTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs);
+eNetReturn_t NetStatsTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec);
+
+eNetReturn_t NetStatsUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn);
+eNetReturn_t NetStatsUDPServCloseHost(sUDPServ_t *pUDPServ);
+eNetReturn_t NetStatsUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t NetStatsUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
+eNetReturn_t NetStatsUDPServSendV(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs);
+eNetReturn_t NetStatsUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv);
+eNetReturn_t NetStatsUDPServSendBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent);
+eNetReturn_t NetStatsUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec);
+
+eNetReturn_t NetStatsInitialize(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, void *pInner);
+sNetStatsSock_t *NetStatsFindSocket(sNetStats_t *pStats, int32_t nSocket, sConnInfo_t *pConn, bool bCreate);
+eNetReturn_t NetStatsCloseSocket(sNetStats_t *pStats, sNetStatsSock_t *pSock);
+eNetReturn_t NetStatsClearSocket(sNetStatsSock_t *pSock);
+eNetReturn_t NetStatsAddDir(sNetStatsDir_t *pTotal, sNetStatsDir_t *pDir);
+eNetReturn_t NetStatsRecord(sNetStatsDir_t *pDir, eNetReturn_t eResult, uint32_t nWanted, uint32_t nDone, uint32_t nTicks);
+uint32_t NetStatsVecBytes(uint32_t nVecCnt, sNetVec_t *pVecs);
+eReturn_t NetStatsTermReport(sTerminal_t *pTerminal, sNetStats_t *pStats);
+eReturn_t NetStatsTermReportDir(sTerminal_t *pTerminal, const char *pLabel, sNetStatsDir_t *pDir);
+bool NetStatsNameMatches(const char *pName, const char *pKey);
+
+/*****	Functions	*****/
+eNetReturn_t NetStatsWrapTCPServ(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, sTCPServ_t *pInner, sTCPServ_t *pOuter) {
+	NetStatsInitialize(pStats, pName, pfGetTicks, pInner);
+
+	IfaceTCPServObjInitialize(pOuter);
+
+	pOuter->HostSck = pInner->HostSck;
+	pOuter->eCapabilities = pInner->eCapabilities;
+	pOuter->pfInitialize = pInner->pfInitialize;
+	pOuter->pfBind = &NetStatsTCPServBind;
+	pOuter->pfCloseHost = &NetStatsTCPServCloseHost;
+	pOuter->pfCloseSocket = &NetStatsTCPServCloseSocket;
+	pOuter->pfAcceptClient = &NetStatsTCPServAcceptClient;
+	pOuter->pfReceive = &NetStatsTCPServReceive;
+	pOuter->pfSend = &NetStatsTCPServSend;
+	pOuter->pfSendV = &NetStatsTCPServSendV;
+	pOuter->pfSetRecvTimeout = &NetStatsTCPServSetRecvTimeOut;
+	pOuter->pHWInfo = pStats;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsWrapTCPClient(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, sTCPClient_t *pInner, sTCPClient_t *pOuter) {
+	NetStatsInitialize(pStats, pName, pfGetTicks, pInner);
+
+	IfaceTCPClientObjInitialize(pOuter);
+
+	pOuter->Sck = pInner->Sck;
+	pOuter->eCapabilities = pInner->eCapabilities;
+	pOuter->pfInitialize = pInner->pfInitialize;
+	pOuter->pfConnect = &NetStatsTCPClientConnect;
+	pOuter->pfConnectStart = &NetStatsTCPClientConnectStart;
+	pOuter->pfConnectCheck = &NetStatsTCPClientConnectCheck;
+	pOuter->pfClose = &NetStatsTCPClientClose;
+	pOuter->pfReceive = &NetStatsTCPClientReceive;
+	pOuter->pfSend = &NetStatsTCPClientSend;
+	pOuter->pfSendV = &NetStatsTCPClientSendV;
+	pOuter->pfSetRecvTimeout = &NetStatsTCPClientSetRecvTimeOut;
+	pOuter->pHWInfo = pStats;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsWrapUDPServ(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, sUDPServ_t *pInner, sUDPServ_t *pOuter) {
+	NetStatsInitialize(pStats, pName, pfGetTicks, pInner);
+
+	IfaceUDPServObjInitialize(pOuter);
+
+	pOuter->HostSck = pInner->HostSck;
+	pOuter->eCapabilities = pInner->eCapabilities;
+	pOuter->pfInitialize = pInner->pfInitialize;
+	pOuter->pfBind = &NetStatsUDPServBind;
+	pOuter->pfCloseHost = &NetStatsUDPServCloseHost;
+	pOuter->pfReceive = &NetStatsUDPServReceive;
+	pOuter->pfSend = &NetStatsUDPServSend;
+	pOuter->pfSendV = &NetStatsUDPServSendV;
+	pOuter->pfReceiveBatch = &NetStatsUDPServReceiveBatch;
+	pOuter->pfSendBatch = &NetStatsUDPServSendBatch;
+	pOuter->pfSetRecvTimeout = &NetStatsUDPServSetRecvTimeOut;
+	pOuter->pHWInfo = pStats;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	eResult = pInner->pfBind(pInner, pConn);
+	pTCPServ->HostSck = pInner->HostSck;
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPServCloseHost(sTCPServ_t *pTCPServ) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	eResult = pInner->pfCloseHost(pInner);
+	pTCPServ->HostSck = pInner->HostSck;
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSocket) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+
+	NetStatsCloseSocket(pStats, NetStatsFindSocket(pStats, pSocket->nSocket, NULL, false));
+
+	return pInner->pfCloseSocket(pInner, pSocket);
+}
+
+eNetReturn_t NetStatsTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSocket) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	eResult = pInner->pfAcceptClient(pInner, pSocket);
+
+	if (eResult == Net_Success) { //A new client to count
+		NetStatsFindSocket(pStats, pSocket->nSocket, &(pSocket->Conn), true);
+	}
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfReceive(pInner, pSocket, nDataBytes, pData, pnBytesRecv);
+
+	pSock = NetStatsFindSocket(pStats, pSocket->nSocket, NULL, true);
+	NetStatsRecord(&(pSock->Recv), eResult, nDataBytes, *pnBytesRecv, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nDataBytes, void *pData) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSend(pInner, pSocket, nDataBytes, pData);
+
+	pSock = NetStatsFindSocket(pStats, pSocket->nSocket, NULL, true);
+	NetStatsRecord(&(pSock->Send), eResult, nDataBytes, nDataBytes, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart, nBytes;
+
+	nBytes = NetStatsVecBytes(nVecCnt, pVecs);
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSendV(pInner, pSocket, nVecCnt, pVecs);
+
+	pSock = NetStatsFindSocket(pStats, pSocket->nSocket, NULL, true);
+	NetStatsRecord(&(pSock->Send), eResult, nBytes, nBytes, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pSocket, uint32_t nMillisec) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPServ->pHWInfo;
+	sTCPServ_t *pInner = (sTCPServ_t *)pStats->pInner;
+
+	return pInner->pfSetRecvTimeout(pInner, pSocket, nMillisec);
+}
+
+eNetReturn_t NetStatsTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	//A reconnect closes the old socket
+	NetStatsCloseSocket(pStats, NetStatsFindSocket(pStats, pInner->Sck.nSocket, NULL, false));
+
+	eResult = pInner->pfConnect(pInner, pConn);
+	pTCPClient->Sck = pInner->Sck;
+
+	if (eResult == Net_Success) {
+		NetStatsFindSocket(pStats, pInner->Sck.nSocket, pConn, true);
+	}
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	NetStatsCloseSocket(pStats, NetStatsFindSocket(pStats, pInner->Sck.nSocket, NULL, false));
+
+	eResult = pInner->pfConnectStart(pInner, pConn);
+	pTCPClient->Sck = pInner->Sck;
+
+	if ((eResult == Net_Success) || (eResult == NetWarn_InProgress)) {
+		NetStatsFindSocket(pStats, pInner->Sck.nSocket, pConn, true);
+	}
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientConnectCheck(sTCPClient_t *pTCPClient) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	eResult = pInner->pfConnectCheck(pInner);
+	pTCPClient->Sck = pInner->Sck;
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientClose(sTCPClient_t *pTCPClient) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	NetStatsCloseSocket(pStats, NetStatsFindSocket(pStats, pInner->Sck.nSocket, NULL, false));
+
+	eResult = pInner->pfClose(pInner);
+	pTCPClient->Sck = pInner->Sck;
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfReceive(pInner, nDataBytes, pData, pnBytesRecv);
+
+	pSock = NetStatsFindSocket(pStats, pInner->Sck.nSocket, NULL, true);
+	NetStatsRecord(&(pSock->Recv), eResult, nDataBytes, *pnBytesRecv, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSend(pInner, nDataBytes, pData);
+
+	pSock = NetStatsFindSocket(pStats, pInner->Sck.nSocket, NULL, true);
+	NetStatsRecord(&(pSock->Send), eResult, nDataBytes, nDataBytes, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart, nBytes;
+
+	nBytes = NetStatsVecBytes(nVecCnt, pVecs);
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSendV(pInner, nVecCnt, pVecs);
+
+	pSock = NetStatsFindSocket(pStats, pInner->Sck.nSocket, NULL, true);
+	NetStatsRecord(&(pSock->Send), eResult, nBytes, nBytes, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec) {
+	sNetStats_t *pStats = (sNetStats_t *)pTCPClient->pHWInfo;
+	sTCPClient_t *pInner = (sTCPClient_t *)pStats->pInner;
+
+	return pInner->pfSetRecvTimeout(pInner, nMillisec);
+}
+
+eNetReturn_t NetStatsUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	eNetReturn_t eResult;
+
+	eResult = pInner->pfBind(pInner, pConn);
+	pUDPServ->HostSck = pInner->HostSck;
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServCloseHost(sUDPServ_t *pUDPServ) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	eNetReturn_t eResult;
+	uint32_t nCtr;
+
+	//Every peer went through the host socket
+	for (nCtr = 0; nCtr < NETSTATS_MAXSOCKETS; nCtr++) {
+		if (pStats->aSocks[nCtr].nSocket != SOCKET_INVALID) {
+			NetStatsCloseSocket(pStats, &(pStats->aSocks[nCtr]));
+		}
+	}
+
+	eResult = pInner->pfCloseHost(pInner);
+	pUDPServ->HostSck = pInner->HostSck;
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfReceive(pInner, pConn, nDataBytes, pData, pnBytesRecv);
+
+	if ((eResult >= Net_Success) && (*pnBytesRecv > 0)) { //Sender is known
+		pSock = NetStatsFindSocket(pStats, pInner->HostSck.nSocket, pConn, true);
+	} else {
+		pSock = &(pStats->Other);
+	}
+
+	NetStatsRecord(&(pSock->Recv), eResult, nDataBytes, *pnBytesRecv, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSend(pInner, pConn, nDataBytes, pData);
+
+	pSock = NetStatsFindSocket(pStats, pInner->HostSck.nSocket, pConn, true);
+	NetStatsRecord(&(pSock->Send), eResult, nDataBytes, nDataBytes, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServSendV(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart, nBytes;
+
+	nBytes = NetStatsVecBytes(nVecCnt, pVecs);
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSendV(pInner, pConn, nVecCnt, pVecs);
+
+	pSock = NetStatsFindSocket(pStats, pInner->HostSck.nSocket, pConn, true);
+	NetStatsRecord(&(pSock->Send), eResult, nBytes, nBytes, pStats->pfGetTicks() - nStart);
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart, nTicks, nCtr;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfReceiveBatch(pInner, nPktCnt, pPkts, pnPktsRecv);
+	nTicks = pStats->pfGetTicks() - nStart;
+
+	if (*pnPktsRecv == 0) { //Nothing came in, no sender to count it against
+		NetStatsRecord(&(pStats->Other.Recv), eResult, 1, 0, nTicks);
+		return eResult;
+	}
+
+	//The time of the call is shared between the datagrams it returned
+	nTicks /= *pnPktsRecv;
+	for (nCtr = 0; nCtr < *pnPktsRecv; nCtr++) {
+		pSock = NetStatsFindSocket(pStats, pInner->HostSck.nSocket, &(pPkts[nCtr].Conn), true);
+		NetStatsRecord(&(pSock->Recv), Net_Success, pPkts[nCtr].nBytes, pPkts[nCtr].nBytes, nTicks);
+	}
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServSendBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+	sNetStatsSock_t *pSock;
+	eNetReturn_t eResult;
+	uint32_t nStart, nTicks, nCtr;
+
+	nStart = pStats->pfGetTicks();
+	eResult = pInner->pfSendBatch(pInner, nPktCnt, pPkts, pnPktsSent);
+	nTicks = pStats->pfGetTicks() - nStart;
+
+	if (nPktCnt > 0) {
+		nTicks /= nPktCnt;
+	}
+
+	//Datagrams past those sent are counted as errors
+	for (nCtr = 0; nCtr < nPktCnt; nCtr++) {
+		pSock = NetStatsFindSocket(pStats, pInner->HostSck.nSocket, &(pPkts[nCtr].Conn), true);
+
+		if (nCtr < *pnPktsSent) {
+			NetStatsRecord(&(pSock->Send), Net_Success, pPkts[nCtr].nBytes, pPkts[nCtr].nBytes, nTicks);
+		} else {
+			NetStatsRecord(&(pSock->Send), NetFail_Unknown, pPkts[nCtr].nBytes, 0, nTicks);
+		}
+	}
+
+	return eResult;
+}
+
+eNetReturn_t NetStatsUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec) {
+	sNetStats_t *pStats = (sNetStats_t *)pUDPServ->pHWInfo;
+	sUDPServ_t *pInner = (sUDPServ_t *)pStats->pInner;
+
+	return pInner->pfSetRecvTimeout(pInner, nMillisec);
+}
+
+eNetReturn_t NetStatsSnapshot(sNetStats_t *pStats, sNetStatsSock_t *pSocks, uint32_t nSockMax, uint32_t *pnSockCnt) {
+	uint32_t nCtr;
+
+	*pnSockCnt = 0;
+
+	for (nCtr = 0; nCtr < NETSTATS_MAXSOCKETS; nCtr++) {
+		if (pStats->aSocks[nCtr].nSocket == SOCKET_INVALID) {
+			continue;
+		}
+
+		if (*pnSockCnt >= nSockMax) {
+			return NetFail_BuffSize;
+		}
+
+		pSocks[*pnSockCnt] = pStats->aSocks[nCtr];
+		*pnSockCnt += 1;
+	}
+
+	if (*pnSockCnt >= nSockMax) {
+		return NetFail_BuffSize;
+	}
+
+	pSocks[*pnSockCnt] = pStats->Other;
+	*pnSockCnt += 1;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsReset(sNetStats_t *pStats) {
+	int32_t nSocket;
+	sConnInfo_t Conn;
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < NETSTATS_MAXSOCKETS; nCtr++) {
+		nSocket = pStats->aSocks[nCtr].nSocket;
+		Conn = pStats->aSocks[nCtr].Conn;
+
+		NetStatsClearSocket(&(pStats->aSocks[nCtr]));
+
+		pStats->aSocks[nCtr].nSocket = nSocket;
+		pStats->aSocks[nCtr].Conn = Conn;
+	}
+
+	NetStatsClearSocket(&(pStats->Other));
+
+	return Net_Success;
+}
+
+uint32_t NetStatsPercentile(sNetStatsDir_t *pDir, uint32_t nPercent) {
+	uint64_t nTotal, nWanted, nSeen;
+	uint32_t nCtr;
+
+	nTotal = 0;
+	for (nCtr = 0; nCtr < NETSTATS_LATBUCKETS; nCtr++) {
+		nTotal += pDir->anLatency[nCtr];
+	}
+
+	if (nTotal == 0) {
+		return 0;
+	}
+
+	//Round up so the percentile call itself is included
+	nWanted = ((nTotal * nPercent) + 99) / 100;
+	if (nWanted == 0) {
+		nWanted = 1;
+	}
+
+	nSeen = 0;
+	for (nCtr = 0; nCtr < NETSTATS_LATBUCKETS - 1; nCtr++) {
+		nSeen += pDir->anLatency[nCtr];
+
+		if (nSeen >= nWanted) {
+			return 1UL << nCtr;
+		}
+	}
+
+	return pDir->nMaxTicks; //Only the longest calls are past the last bucket
+}
+
+eNetReturn_t NetStatsRegister(sNetStats_t *pStats) {
+	sNetStats_t *pCurr;
+
+	for (pCurr = gpNetStatsList; pCurr != NULL; pCurr = pCurr->pNext) {
+		if (pCurr == pStats) { //Already in the list
+			return Net_Success;
+		}
+	}
+
+	pStats->pNext = gpNetStatsList;
+	gpNetStatsList = pStats;
+
+	return Net_Success;
+}
+
+eReturn_t NetStatsTermGetHandler(sTerminal_t *pTerminal, const char *pKey) {
+	sNetStats_t *pCurr;
+	bool bAll;
+	bool bFound = false;
+
+	bAll = NetStatsNameMatches("netstats", pKey);
+
+	for (pCurr = gpNetStatsList; pCurr != NULL; pCurr = pCurr->pNext) {
+		if ((bAll == true) || (NetStatsNameMatches(pCurr->pName, pKey) == true)) {
+			NetStatsTermReport(pTerminal, pCurr);
+			bFound = true;
+		}
+	}
+
+	if ((bAll == true) && (bFound == false)) {
+		pTerminal->pfWriteTextLine(pTerminal, "No network statistics registered");
+		return Success;
+	}
+
+	if (bFound == true) {
+		return Success;
+	} else {
+		return Fail_Invalid;
+	}
+}
+
+eNetReturn_t NetStatsInitialize(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, void *pInner) {
+	uint32_t nCtr;
+
+	pStats->pName = pName;
+	pStats->pfGetTicks = pfGetTicks;
+	pStats->pInner = pInner;
+	pStats->pNext = NULL;
+
+	for (nCtr = 0; nCtr < NETSTATS_MAXSOCKETS; nCtr++) {
+		NetStatsClearSocket(&(pStats->aSocks[nCtr]));
+	}
+
+	NetStatsClearSocket(&(pStats->Other));
+
+	return Net_Success;
+}
+
+sNetStatsSock_t *NetStatsFindSocket(sNetStats_t *pStats, int32_t nSocket, sConnInfo_t *pConn, bool bCreate) {
+	sNetStatsSock_t *pFree = NULL;
+	sNetStatsSock_t *pSock;
+	uint32_t nCtr;
+
+	if (nSocket == SOCKET_INVALID) {
+		return &(pStats->Other);
+	}
+
+	for (nCtr = 0; nCtr < NETSTATS_MAXSOCKETS; nCtr++) {
+		pSock = &(pStats->aSocks[nCtr]);
+
+		if (pSock->nSocket == SOCKET_INVALID) {
+			if (pFree == NULL) {
+				pFree = pSock;
+			}
+
+			continue;
+		}
+
+		if (pSock->nSocket != nSocket) {
+			continue;
+		}
+
+		//Without an address any entry on the socket will do
+		if ((pConn == NULL) || ((pSock->Conn.Addr.nNetLong == pConn->Addr.nNetLong) && (pSock->Conn.Port == pConn->Port))) {
+			return pSock;
+		}
+	}
+
+	if ((bCreate == false) || (pFree == NULL)) {
+		return &(pStats->Other);
+	}
+
+	NetStatsClearSocket(pFree);
+	pFree->nSocket = nSocket;
+	if (pConn != NULL) {
+		pFree->Conn = *pConn;
+	}
+
+	return pFree;
+}
+
+eNetReturn_t NetStatsCloseSocket(sNetStats_t *pStats, sNetStatsSock_t *pSock) {
+	if (pSock == &(pStats->Other)) { //Already counted there
+		return Net_Success;
+	}
+
+	NetStatsAddDir(&(pStats->Other.Send), &(pSock->Send));
+	NetStatsAddDir(&(pStats->Other.Recv), &(pSock->Recv));
+
+	NetStatsClearSocket(pSock);
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsClearSocket(sNetStatsSock_t *pSock) {
+	memset(pSock, 0, sizeof(sNetStatsSock_t));
+	pSock->nSocket = SOCKET_INVALID;
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsAddDir(sNetStatsDir_t *pTotal, sNetStatsDir_t *pDir) {
+	uint32_t nCtr;
+
+	pTotal->nBytes += pDir->nBytes;
+	pTotal->nCalls += pDir->nCalls;
+	pTotal->nPartial += pDir->nPartial;
+	pTotal->nWouldBlock += pDir->nWouldBlock;
+	pTotal->nErrors += pDir->nErrors;
+
+	if (pTotal->nMaxTicks < pDir->nMaxTicks) {
+		pTotal->nMaxTicks = pDir->nMaxTicks;
+	}
+
+	for (nCtr = 0; nCtr < NETSTATS_LATBUCKETS; nCtr++) {
+		pTotal->anLatency[nCtr] += pDir->anLatency[nCtr];
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t NetStatsRecord(sNetStatsDir_t *pDir, eNetReturn_t eResult, uint32_t nWanted, uint32_t nDone, uint32_t nTicks) {
+	uint32_t nBucket;
+
+	pDir->nCalls += 1;
+
+	if (eResult < Net_Success) {
+		pDir->nErrors += 1;
+	} else {
+		pDir->nBytes += nDone;
+
+		if ((nDone == 0) && (nWanted > 0)) {
+			pDir->nWouldBlock += 1;
+		} else if ((eResult != Net_Success) || (nDone < nWanted)) {
+			pDir->nPartial += 1;
+		}
+	}
+
+	//Bucket N holds times below 2^N
+	nBucket = 0;
+	while ((nBucket < NETSTATS_LATBUCKETS - 1) && ((nTicks >> nBucket) != 0)) {
+		nBucket += 1;
+	}
+
+	pDir->anLatency[nBucket] += 1;
+
+	if (pDir->nMaxTicks < nTicks) {
+		pDir->nMaxTicks = nTicks;
+	}
+
+	return Net_Success;
+}
+
+uint32_t NetStatsVecBytes(uint32_t nVecCnt, sNetVec_t *pVecs) {
+	uint32_t nCtr, nBytes;
+
+	nBytes = 0;
+	for (nCtr = 0; nCtr < nVecCnt; nCtr++) {
+		nBytes += pVecs[nCtr].nBytes;
+	}
+
+	return nBytes;
+}
+
+eReturn_t NetStatsTermReport(sTerminal_t *pTerminal, sNetStats_t *pStats) {
+	char strLine[NETSTATS_LINELEN];
+	sNetStatsSock_t *pSock;
+	uint8_t *pAddr;
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr <= NETSTATS_MAXSOCKETS; nCtr++) {
+		if (nCtr < NETSTATS_MAXSOCKETS) {
+			pSock = &(pStats->aSocks[nCtr]);
+
+			if (pSock->nSocket == SOCKET_INVALID) {
+				continue;
+			}
+
+			//Address is kept in network order
+			pAddr = (uint8_t *)&(pSock->Conn.Addr.nNetLong);
+			snprintf(strLine, NETSTATS_LINELEN, "%s socket %ld %u.%u.%u.%u:%u", pStats->pName, (long)pSock->nSocket, pAddr[0], pAddr[1], pAddr[2], pAddr[3], pSock->Conn.Port);
+		} else {
+			pSock = &(pStats->Other);
+
+			if ((pSock->Send.nCalls == 0) && (pSock->Recv.nCalls == 0)) { //Nothing to show
+				continue;
+			}
+
+			snprintf(strLine, NETSTATS_LINELEN, "%s other", pStats->pName);
+		}
+
+		pTerminal->pfWriteTextLine(pTerminal, strLine);
+		NetStatsTermReportDir(pTerminal, "  send", &(pSock->Send));
+		NetStatsTermReportDir(pTerminal, "  recv", &(pSock->Recv));
+	}
+
+	return Success;
+}
+
+eReturn_t NetStatsTermReportDir(sTerminal_t *pTerminal, const char *pLabel, sNetStatsDir_t *pDir) {
+	char strLine[NETSTATS_LINELEN];
+
+	snprintf(strLine, NETSTATS_LINELEN, "%s %llu bytes %lu calls %lu partial %lu block %lu err p50 %lu p99 %lu max %lu",
+		pLabel, (unsigned long long)pDir->nBytes, (unsigned long)pDir->nCalls, (unsigned long)pDir->nPartial,
+		(unsigned long)pDir->nWouldBlock, (unsigned long)pDir->nErrors, (unsigned long)NetStatsPercentile(pDir, 50),
+		(unsigned long)NetStatsPercentile(pDir, 99), (unsigned long)pDir->nMaxTicks);
+
+	return pTerminal->pfWriteTextLine(pTerminal, strLine);
+}
+
+bool NetStatsNameMatches(const char *pName, const char *pKey) {
+	uint32_t nIdx;
+	char cName, cKey;
+
+	for (nIdx = 0; (pName[nIdx] != '\0') && (pKey[nIdx] != '\0'); nIdx++) {
+		cName = pName[nIdx];
+		cKey = pKey[nIdx];
+
+		if ((cName >= 'A') && (cName <= 'Z')) {
+			cName = cName - 'A' + 'a';
+		}
+
+		if ((cKey >= 'A') && (cKey <= 'Z')) {
+			cKey = cKey - 'A' + 'a';
+		}
+
+		if (cName != cKey) {
+			return false;
+		}
+	}
+
+	return (pName[nIdx] == pKey[nIdx]);
+}
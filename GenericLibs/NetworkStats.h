@@ -0,0 +1,191 @@
+/**	@defgroup	netstats	Network traffic statistics
+	@brief		Records traffic through any network interface object
+	@details	v0.1
+	#Description
+		Wraps a TCP server, TCP client, or UDP server object from any
+		implementation and counts what passes through it, per socket.  For
+		sends and receives it keeps bytes, calls, partial transfers, calls
+		that found nothing to do, errors, and a histogram of how long each
+		call took.
+
+		The wrapper is an ordinary interface object, so code using it does not
+		change.  Bind, connect, and accept through the wrapper as well so the
+		sockets it reports are known.
+
+		Call times come from the tick function given.  Histogram bucket N
+		counts calls taking less than 2^N ticks and at least half that, so a
+		microsecond tick gives buckets of 1us, 2us, 4us and so on.
+
+		A partial transfer is a receive that returned less than was asked for,
+		or a send the implementation reported as incomplete.  A call that found
+		nothing to do is a receive that timed out or would have blocked.
+
+		Register the statistics with NetStatsRegister() and add
+		NetStatsTermGetHandler() to a terminal to read them with GET netstats,
+		or GET with the name of one wrapper.
+
+		Sockets are kept in a fixed table.  When a socket is closed, or there is
+		no room for another, its counts are added to the Other entry.
+
+	#File Information
+		File:	NetworkStats.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __NETWORKSTATS_H
+	#define __NETWORKSTATS_H
+
+/*****	Includes	*****/
+	#include <stdio.h>
+
+	#include "CommonUtils.h"
+	#include "NetworkGeneralInterface.h"
+	#include "TimeGeneralInterface.h"
+	#include "Terminal.h"
+
+/*****	Defines		*****/
+	#ifndef NETSTATS_MAXSOCKETS
+		/**	@brief		Sockets one wrapper keeps separate counts for
+			@ingroup	netstats
+		*/
+		#define NETSTATS_MAXSOCKETS		16
+	#endif
+
+	#ifndef NETSTATS_LATBUCKETS
+		/**	@brief		Buckets in each call time histogram, the last holds all longer calls
+			@ingroup	netstats
+		*/
+		#define NETSTATS_LATBUCKETS		24
+	#endif
+
+/*****	Definitions	*****/
+	typedef struct sNetStats_t sNetStats_t;
+
+	/**	@brief		Counts for one direction of traffic
+		@ingroup	netstats
+	*/
+	typedef struct sNetStatsDir_t {
+		uint64_t nBytes;							/**< Bytes moved */
+		uint32_t nCalls;							/**< Calls made */
+		uint32_t nPartial;							/**< Calls that moved less than asked */
+		uint32_t nWouldBlock;						/**< Calls that found nothing to move */
+		uint32_t nErrors;							/**< Calls that failed */
+		uint32_t nMaxTicks;							/**< Longest call */
+		uint32_t anLatency[NETSTATS_LATBUCKETS];	/**< Calls by how long they took */
+	} sNetStatsDir_t;
+
+	/**	@brief		Counts for one socket
+		@ingroup	netstats
+	*/
+	typedef struct sNetStatsSock_t {
+		int32_t nSocket;			/**< Socket counted, SOCKET_INVALID for an unused or Other entry */
+		sConnInfo_t Conn;			/**< Address of the other end, zero if not known */
+		sNetStatsDir_t Send;		/**< Traffic sent */
+		sNetStatsDir_t Recv;		/**< Traffic received */
+	} sNetStatsSock_t;
+
+	/**	@brief		Statistics of one wrapped interface object
+		@ingroup	netstats
+	*/
+	typedef struct sNetStats_t {
+		const char *pName;							/**< Name used in reports and to GET it */
+		pfGetCurrentTicks_t pfGetTicks;				/**< Time source for call times */
+		void *pInner;								/**< Object being wrapped */
+
+		sNetStatsSock_t aSocks[NETSTATS_MAXSOCKETS];	/**< Sockets being counted */
+		sNetStatsSock_t Other;						/**< Closed sockets and those that did not fit */
+
+		sNetStats_t *pNext;							/**< Next registered statistics */
+	} sNetStats_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Wrap a TCP server to count its traffic
+		@param		pStats		Statistics to keep, initialized by this call
+		@param		pName		Name used in reports, must remain valid
+		@param		pfGetTicks	Time source for call times
+		@param		pInner		Initialized TCP server to wrap
+		@param		pOuter		Returns the server object to use in its place
+		@return		Net_Success once the wrapper is ready
+		@ingroup	netstats
+	*/
+	eNetReturn_t NetStatsWrapTCPServ(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, sTCPServ_t *pInner, sTCPServ_t *pOuter);
+
+	/**	@brief		Wrap a TCP client to count its traffic
+		@param		pStats		Statistics to keep, initialized by this call
+		@param		pName		Name used in reports, must remain valid
+		@param		pfGetTicks	Time source for call times
+		@param		pInner		Initialized TCP client to wrap
+		@param		pOuter		Returns the client object to use in its place
+		@return		Net_Success once the wrapper is ready
+		@ingroup	netstats
+	*/
+	eNetReturn_t NetStatsWrapTCPClient(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, sTCPClient_t *pInner, sTCPClient_t *pOuter);
+
+	/**	@brief		Wrap a UDP server to count its traffic
+		@details	Each peer address is counted as its own socket.
+		@param		pStats		Statistics to keep, initialized by this call
+		@param		pName		Name used in reports, must remain valid
+		@param		pfGetTicks	Time source for call times
+		@param		pInner		Initialized UDP server to wrap
+		@param		pOuter		Returns the server object to use in its place
+		@return		Net_Success once the wrapper is ready
+		@ingroup	netstats
+	*/
+	eNetReturn_t NetStatsWrapUDPServ(sNetStats_t *pStats, const char *pName, pfGetCurrentTicks_t pfGetTicks, sUDPServ_t *pInner, sUDPServ_t *pOuter);
+
+	/**	@brief		Copy the current counts
+		@details	Sockets in use are copied first, the Other entry last.
+		@param		pStats		Statistics to copy
+		@param		pSocks		Buffer to receive the counts
+		@param		nSockMax	Entries the buffer can hold
+		@param		pnSockCnt	Returns the number of entries copied
+		@return		Net_Success if everything was copied, NetFail_BuffSize if the
+			buffer was too small for all of it
+		@ingroup	netstats
+	*/
+	eNetReturn_t NetStatsSnapshot(sNetStats_t *pStats, sNetStatsSock_t *pSocks, uint32_t nSockMax, uint32_t *pnSockCnt);
+
+	/**	@brief		Clear all counts, the sockets in use stay known
+		@param		pStats		Statistics to clear
+		@return		Net_Success once cleared
+		@ingroup	netstats
+	*/
+	eNetReturn_t NetStatsReset(sNetStats_t *pStats);
+
+	/**	@brief		Estimate a percentile of call times from a histogram
+		@param		pDir		Counts to read
+		@param		nPercent	Percentile wanted, 0 to 100
+		@return		Upper tick bound of the bucket holding the percentile, 0 if
+			there were no calls
+		@ingroup	netstats
+	*/
+	uint32_t NetStatsPercentile(sNetStatsDir_t *pDir, uint32_t nPercent);
+
+	/**	@brief		Make statistics readable from a terminal
+		@param		pStats		Statistics to add
+		@return		Net_Success once added
+		@ingroup	netstats
+	*/
+	eNetReturn_t NetStatsRegister(sNetStats_t *pStats);
+
+	/**	@brief		Terminal GET handler reporting registered statistics
+		@details	Key netstats reports every registered wrapper, the name of a
+			wrapper reports just that one.
+		@param		pTerminal	Terminal to write the report to
+		@param		pKey		Key requested
+		@return		Success if reported, Fail_Invalid if the key is not known
+		@ingroup	netstats
+	*/
+	eReturn_t NetStatsTermGetHandler(sTerminal_t *pTerminal, const char *pKey);
+
+/*****	Functions	*****/
+
+
+#endif
@@ -26,6 +26,7 @@ eSPIReturn_t SPIInterfaceInitialize(sSPIIface_t *pIface) {
 	pIface->pfEndTransfer = &SPIEndTransfer;
 	pIface->pfTransferByte = &SPITransferByte;
 	pIface->pfTransfer2Bytes = &SPITransfer2Bytes;
+	pIface->pfTransferBlock = &SPITransferBlock;
 	pIface->pfGetCapabilities = &SPIGetCapabilities;
 
 	pIface->nBusClockFreq = 5000000;
@@ -56,6 +57,31 @@ eSPIReturn_t SPITransfer2Bytes(sSPIIface_t *pIface, const uint8_t *anSendBytes,
 	return SPIFail_Unsupported;
 }
 
+eSPIReturn_t SPITransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes) {
+	eSPIReturn_t eResult;
+	uint32_t nCtr;
+	uint8_t nSend, nRead;
+	
+	//Fall back on single bytes for buses that can't do better
+	nSend = 0xFF;
+	for (nCtr = 0; nCtr < nBytes; nCtr++) {
+		if (pSendBytes != NULL) {
+			nSend = pSendBytes[nCtr];
+		}
+		
+		eResult = pIface->pfTransferByte(pIface, nSend, &nRead);
+		if (eResult != SPI_Success) {
+			return eResult;
+		}
+		
+		if (pReadBytes != NULL) {
+			pReadBytes[nCtr] = nRead;
+		}
+	}
+	
+	return SPI_Success;
+}
+
 eSPICapabilities_t SPIGetCapabilities(sSPIIface_t *pIface) {
 	return SPI_NoCapabilities;
 }
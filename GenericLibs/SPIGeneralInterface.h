@@ -1,6 +1,6 @@
 /**	@defgroup	spiiface
 	@brief		General interface for using the SPI bus
-	@details	v0.4
+	@details	v0.5
 	# Intent #
 		This module is to create a common interface for interacting with a SPI bus.  Drivers 
 		for devices that operate over this bus should use this interface to operate the 
@@ -68,6 +68,7 @@
 		SPI_EndTransfer		= 0x00000004,	/**< SPI bus driver allows user to end a data transfer */
 		SPI_BiDir1Byte		= 0x00000008,	/**< SPI bus driver allows user to bi-directionally transfer 1 byte */
 		SPI_BiDir2Bytes		= 0x00000010,	/**< SPI bus driver allows user to bi-directionally transfer 2 bytes */
+		SPI_BiDirBlock		= 0x00000020,	/**< SPI bus driver transfers a block of bytes in one call, without this it is done a byte at a time */
 	} eSPICapabilities_t;
 
 	/**	@brief		Enumeration of markers to indicate the order the bus sends data out 
@@ -116,6 +117,7 @@
 		
 		eSPIReturn_t (*pfTransferByte)(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t *pnReadByte);
 		eSPIReturn_t (*pfTransfer2Bytes)(sSPIIface_t *pIface, const uint8_t *anSendBytes, uint8_t *anReadBytes);
+		eSPIReturn_t (*pfTransferBlock)(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes);
 		
 		eSPICapabilities_t (*pfGetCapabilities)(sSPIIface_t *pIface);
 
@@ -145,6 +147,21 @@
 
 	eSPIReturn_t SPITransfer2Bytes(sSPIIface_t *pIface, const uint8_t *anSendBytes, uint8_t *anReadBytes);
 
+	/**	@brief		Transfer a block of bytes in both directions
+		@details	Either buffer may be NULL.  With no send buffer a filler byte is
+			sent for each byte, with no read buffer the bytes read are discarded.  Buses
+			that do not have the SPI_BiDirBlock capability get this default, which
+			transfers the block through pfTransferByte one byte at a time.
+		@param		pIface		Pointer to the SPI interface object
+		@param		pSendBytes	Bytes to send, or NULL
+		@param		pReadBytes	Buffer to receive the bytes read, or NULL
+		@param		nBytes		Number of bytes to transfer
+		@return		SPI_Success if all bytes were transferred, or a code indicating
+			the failure
+		@ingroup	spiiface
+	*/
+	eSPIReturn_t SPITransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes);
+
 	eSPICapabilities_t SPIGetCapabilities(sSPIIface_t *pIface);
 
 /***** Functions	*****/
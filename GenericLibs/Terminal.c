@@ -7,6 +7,10 @@
 	#include "Terminal.h"
 
 /*****	Defines		*****/
+	/**	@brief		Words of a line that are located, one more than SET uses to spot extras
+		@ingroup	terminal
+	*/
+	#define TERMINAL_MAXTOKENS	4
 
 
 /*****	Definitions	*****/
@@ -33,7 +37,13 @@ eReturn_t IOCnctWriteDataUART(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nD
 eReturn_t TerminalWriteTextLine(sTerminal_t *pTerminal, const char *pText);
 eReturn_t TerminalReadInput(sTerminal_t *pTerminal);
 
-eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, uint32_t nCmdLen);
+eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, char *pLine, uint32_t nCmdLen);
+
+uint16_t TermDispatchFind(sTermDispatch_t *pTable, const char *pName, uint32_t nLen, bool bCreate);
+bool TermNameMatches(const char *pName, uint32_t nLen, const char *pLowerName);
+bool TermNameIsValid(const char *pName, uint32_t nLen);
+bool TermIsWhiteSpace(char cChar);
+char TermLowerCase(char cChar);
 
 eReturn_t TerminalAddSetHandler(sTerminal_t *pTerminal, pfTerminalSetHandler_t pFunc);
 eReturn_t TerminalAddGetHandler(sTerminal_t *pTerminal, pfTerminalGetHandler_t pFunc);
@@ -46,8 +56,23 @@ eReturn_t TerminalDelCmdHandler(sTerminal_t *pTerminal, pfTerminalCommandHandler
 uint32_t CountStringWhiteSpace(char *aText, uint32_t nStartIdx, uint32_t nStringLen);
 uint32_t CountStringNonWhiteSpace(char *aText, uint32_t nStartIdx, uint32_t nStringLen);
 
+eReturn_t IOCnctReadByteFromData(sIOConnect_t *pIOObj, uint8_t *pnByte);
+eReturn_t IOCnctWriteByteFromData(sIOConnect_t *pIOObj, uint8_t nByte);
+eReturn_t IOCnctNetResult(eNetReturn_t eResult);
+
 eReturn_t IOCnctReadByteTCPServ(sIOConnect_t *pIOObj, uint8_t *pnByte);
 eReturn_t IOCnctWriteByteTCPServ(sIOConnect_t *pIOObj, uint8_t nByte);
+eReturn_t IOCnctReadDataTCPServ(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize);
+eReturn_t IOCnctWriteDataTCPServ(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
+
+eReturn_t IOCnctReadDataTCPClient(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize);
+eReturn_t IOCnctWriteDataTCPClient(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
+
+eReturn_t IOCnctReadDataUDPServ(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize);
+eReturn_t IOCnctWriteDataUDPServ(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
+
+eReturn_t IOCnctReadDataPipe(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize);
+eReturn_t IOCnctWriteDataPipe(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
 
 /*****	Functions	*****/
 eReturn_t IOCnctObjectInitialize(sIOConnect_t *pIOObj) {
@@ -218,7 +243,10 @@ eReturn_t TerminalInitialize(sTerminal_t *pTerm, sIOConnect_t *pIOObj) {
 	pTerm->pfRemoveCmdHandler = &TerminalDelCmdHandler;
 
 	pTerm->pIOObj = pIOObj;
-	pTerm->nBufferUsed = 0;
+	pTerm->pContext = NULL;
+	pTerm->pDispatch = NULL;
+
+	TerminalSetInputBuffer(pTerm, pTerm->aInputBuffer, TERMINAL_BUFFERSIZE);
 
 	for (nCtr = 0; nCtr < TERMINAL_MAXHANDLERS; nCtr++) {
 		pTerm->pafSetHandlers[nCtr] = NULL;
@@ -232,9 +260,18 @@ eReturn_t TerminalInitialize(sTerminal_t *pTerm, sIOConnect_t *pIOObj) {
 eReturn_t TerminalWriteTextLine(sTerminal_t *pTerminal, const char *pText) {
 	uint32_t nTextLen;
 	eReturn_t eResult;
+	char aLine[TERMINAL_WRITEBUFFSIZE];
 
 	nTextLen = strlen(pText);
 
+	if (nTextLen + 2 <= TERMINAL_WRITEBUFFSIZE) { //Send the text and line end together
+		memcpy(aLine, pText, nTextLen);
+		aLine[nTextLen] = '\r';
+		aLine[nTextLen + 1] = '\n';
+
+		return pTerminal->pIOObj->pfWriteData(pTerminal->pIOObj, (void *)aLine, nTextLen + 2);
+	}
+
 	//Write the requested data
 	eResult = pTerminal->pIOObj->pfWriteData(pTerminal->pIOObj, (void *)pText, nTextLen);
 	if (eResult < Success) {
@@ -247,75 +284,143 @@ eReturn_t TerminalWriteTextLine(sTerminal_t *pTerminal, const char *pText) {
 	return eResult;
 }
 
-eReturn_t TerminalReadInput(sTerminal_t *pTerminal) {
-	eReturn_t eResult;
-	uint32_t nReadBytes, nCtr, nCutCtr;
+eReturn_t TerminalSetInputBuffer(sTerminal_t *pTerm, char *pBuffer, uint32_t nBuffSize) {
+	if (nBuffSize < 2) { //Must hold at least one character and its line end
+		return Fail_Invalid;
+	}
 
-	//Read data from the IOConnect to fill the buffer
-	eResult = pTerminal->pIOObj->pfReadData(pTerminal->pIOObj, (void *)&(pTerminal->aInputBuffer[pTerminal->nBufferUsed]), TERMINAL_BUFFERSIZE - pTerminal->nBufferUsed, &nReadBytes);
+	pTerm->pInputBuffer = pBuffer;
+	pTerm->nBufferSize = nBuffSize;
+	pTerm->nLineStart = 0;
+	pTerm->nScanIdx = 0;
+	pTerm->nBufferUsed = 0;
+	pTerm->bDiscardLine = false;
 
-	if (eResult < Success) {
-		return Fail_CommError;
-	}
+	return Success;
+}
 
-	pTerminal->nBufferUsed += nReadBytes; //Update how much of the buffer is used
-	if (nReadBytes > 0) {
-		nCtr = 5;
-	}
+eReturn_t TerminalReadInput(sTerminal_t *pTerminal) {
+	eReturn_t eResult, eReadResult;
+	uint32_t nReadBytes, nFree;
+	char *pBuff = pTerminal->pInputBuffer;
+	char cLineEnd;
+
+	do {
+		if (pTerminal->nBufferUsed == pTerminal->nBufferSize) { //No room left at the end of the buffer
+			if (pTerminal->nLineStart > 0) { //Only the unfinished line is moved to the front
+				pTerminal->nBufferUsed -= pTerminal->nLineStart;
+				pTerminal->nScanIdx -= pTerminal->nLineStart;
+				memmove(pBuff, &(pBuff[pTerminal->nLineStart]), pTerminal->nBufferUsed);
+				pTerminal->nLineStart = 0;
+			} else { //Whole buffer is one line, it can never be processed
+				pTerminal->pfWriteTextLine(pTerminal, "Line too long");
+
+				pTerminal->bDiscardLine = true;
+				pTerminal->nScanIdx = 0;
+				pTerminal->nBufferUsed = 0;
+			}
+		}
 
-	//Look through the buffer for new line characters
-	for (nCtr = 0; nCtr < pTerminal->nBufferUsed; nCtr++) {
-		if ((pTerminal->aInputBuffer[nCtr] == '\n') || (pTerminal->aInputBuffer[nCtr] == '\r')) {
-			eResult = TerminalProcessCommand(pTerminal, nCtr);
+		//Read data from the IOConnect to fill the buffer
+		nFree = pTerminal->nBufferSize - pTerminal->nBufferUsed;
+		eReadResult = pTerminal->pIOObj->pfReadData(pTerminal->pIOObj, (void *)&(pBuff[pTerminal->nBufferUsed]), nFree, &nReadBytes);
 
-			if (eResult == Warn_Incomplete) { //Command spans multiple lines?
-				continue; //Continue to find another new line
-			} else { //Dump this command to look for another one
-				nCtr += 1; //1 character more to cut out the new line
+		if (eReadResult < Success) {
+			return Fail_CommError;
+		}
 
-				//Copy unprocessed characters to the beginning of the buffer
-				for (nCutCtr = 0; nCutCtr + nCtr < pTerminal->nBufferUsed; nCutCtr++) {
-					pTerminal->aInputBuffer[nCutCtr] = pTerminal->aInputBuffer[nCutCtr + nCtr];
-				}
-				pTerminal->aInputBuffer[nCutCtr] = '\0';//Make sure it was placed
-				pTerminal->aInputBuffer[nCtr] = '\0'; //Probably not needed, but won't hurt
+		pTerminal->nBufferUsed += nReadBytes; //Update how much of the buffer is used
 
-				//Reduce the used count
-				pTerminal->nBufferUsed -= nCtr;
+		//Each character is only checked once for a line end
+		for (; pTerminal->nScanIdx < pTerminal->nBufferUsed; pTerminal->nScanIdx++) {
+			cLineEnd = pBuff[pTerminal->nScanIdx];
+			if ((cLineEnd != '\n') && (cLineEnd != '\r')) {
+				continue;
+			}
 
-				nCtr = UINT32_MAXVALUE; //It should increment and be at zero resetting the loop
+			if (pTerminal->bDiscardLine == true) { //Found the end of the line too long
+				pTerminal->bDiscardLine = false;
+				pTerminal->nLineStart = pTerminal->nScanIdx + 1;
+				continue;
+			}
+
+			pBuff[pTerminal->nScanIdx] = '\0'; //Handlers use the line where it sits
+			eResult = TerminalProcessCommand(pTerminal, &(pBuff[pTerminal->nLineStart]), pTerminal->nScanIdx - pTerminal->nLineStart);
+
+			if (eResult == Warn_Incomplete) { //Command spans multiple lines, keep it and look for the next line end
+				pBuff[pTerminal->nScanIdx] = cLineEnd;
+			} else { //Next line begins after this line end
+				pTerminal->nLineStart = pTerminal->nScanIdx + 1;
 			}
 		}
-	}
+
+		if (pTerminal->bDiscardLine == true) { //Nothing kept from a line too long
+			pTerminal->nBufferUsed = pTerminal->nLineStart;
+			pTerminal->nScanIdx = pTerminal->nLineStart;
+		}
+
+		if (pTerminal->nLineStart == pTerminal->nBufferUsed) { //Everything is handled, start over at the front
+			pTerminal->nLineStart = 0;
+			pTerminal->nScanIdx = 0;
+			pTerminal->nBufferUsed = 0;
+		}
+	} while ((eReadResult == Success) && (nReadBytes == nFree)); //Buffer filled, there may be more waiting
 
 	return Success;
 }
 
-eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, uint32_t nCmdLen) {
+eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, char *pLine, uint32_t nCmdLen) {
 	eReturn_t eResult;
-	uint32_t nKeyIdx, nValIdx, nCtr;
-	sRegExResult_t RXResult;
+	char *pKey, *pValue;
+	uint32_t anStart[TERMINAL_MAXTOKENS], anLen[TERMINAL_MAXTOKENS];
+	uint32_t nIdx, nTokens, nCtr;
+	uint16_t nNode = TERMINAL_NONODE;
 	bool bFoundHandler = false; //Will be set true if a handler accepts the command
 
-	StrRegEx(pTerminal->aInputBuffer, "\\s*get\\s", RX_IgnoreCase, &RXResult);
-	if (RXResult.eResult == RX_Success) { //Get command
-		//Find the key
-		nKeyIdx = RXResult.nLength;
-		StrRegEx(&(pTerminal->aInputBuffer[nKeyIdx]), "\\s*(\\w+)\\s*$", RX_IgnoreCase, &RXResult);
+	//Find the words of the line in one pass
+	nIdx = 0;
+	for (nTokens = 0; nTokens < TERMINAL_MAXTOKENS; nTokens++) {
+		while (TermIsWhiteSpace(pLine[nIdx]) == true) {
+			nIdx += 1;
+		}
+
+		if (pLine[nIdx] == '\0') {
+			break;
+		}
+
+		anStart[nTokens] = nIdx;
+		while ((pLine[nIdx] != '\0') && (TermIsWhiteSpace(pLine[nIdx]) == false)) {
+			nIdx += 1;
+		}
+		anLen[nTokens] = nIdx - anStart[nTokens];
+	}
+
+	if (nTokens == 0) { //Blank line, nothing to do
+		return Success;
+	}
 
-		if (RXResult.eResult == RX_WarnNoMatch) {
+	if (TermNameMatches(&(pLine[anStart[0]]), anLen[0], "get") == true) { //Get command
+		if (nTokens != 2) {
 			pTerminal->pfWriteTextLine(pTerminal, "Get command uses the format");
 			pTerminal->pfWriteTextLine(pTerminal, "GET <Key>");
 			pTerminal->pfWriteTextLine(pTerminal, "Where <Key> is the value to look up");
 			return Fail_Invalid;
 		}
 
-		nKeyIdx += RXResult.aGroups[0][0];
-		pTerminal->aInputBuffer[nKeyIdx + RXResult.aGroups[0][1]] = '\0'; //End the key string
+		pKey = &(pLine[anStart[1]]);
+		pKey[anLen[1]] = '\0'; //End the key string
+
+		if (pTerminal->pDispatch != NULL) {
+			nNode = TermDispatchFind(pTerminal->pDispatch, pKey, anLen[1], false);
+		}
+
+		if ((nNode != TERMINAL_NONODE) && (pTerminal->pDispatch->aNodes[nNode].pfGet != NULL)) {
+			return pTerminal->pDispatch->aNodes[nNode].pfGet(pTerminal, pKey);
+		}
 
 		for (nCtr = 0; nCtr < TERMINAL_MAXHANDLERS; nCtr++) {
 			if (pTerminal->pafGetHandlers[nCtr] != NULL) {
-				eResult = pTerminal->pafGetHandlers[nCtr](pTerminal, &(pTerminal->aInputBuffer[nKeyIdx]));
+				eResult = pTerminal->pafGetHandlers[nCtr](pTerminal, pKey);
 
 				if (eResult == Success) {
 					bFoundHandler = true;
@@ -327,34 +432,37 @@ eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, uint32_t nCmdLen) {
 			return Success;
 		}else {
 			pTerminal->pfWriteTextLine(pTerminal, "Get Value Unrecognized: ");
-			pTerminal->pfWriteTextLine(pTerminal, &(pTerminal->aInputBuffer[nKeyIdx]));
+			pTerminal->pfWriteTextLine(pTerminal, pKey);
 
 			return Fail_Invalid;
 		}
 	}
 
-	StrRegEx(pTerminal->aInputBuffer, "\\s*set\\s", RX_IgnoreCase, &RXResult);
-	if (RXResult.eResult == RX_Success) { //Set command
-		nKeyIdx = RXResult.nLength; //Don't forget this offset from the first match
-		nValIdx = RXResult.nLength;
-		StrRegEx(&(pTerminal->aInputBuffer[nKeyIdx]), "\\s*(\\w+)\\s+(\\S+)\\s*$", RX_IgnoreCase, &RXResult);
-
-		if (RXResult.eResult == RX_WarnNoMatch) {
+	if (TermNameMatches(&(pLine[anStart[0]]), anLen[0], "set") == true) { //Set command
+		if (nTokens != 3) {
 			pTerminal->pfWriteTextLine(pTerminal, "Set command uses the format");
 			pTerminal->pfWriteTextLine(pTerminal, "SET <Key> <Value>");
 			pTerminal->pfWriteTextLine(pTerminal, "Where <Key> specifies what to change and <Value> is the value to set");
 			return Fail_Invalid;
 		}
 
-		nKeyIdx += RXResult.aGroups[0][0];
-		pTerminal->aInputBuffer[nKeyIdx + RXResult.aGroups[0][1]] = '\0'; //End the key string
+		pKey = &(pLine[anStart[1]]);
+		pKey[anLen[1]] = '\0'; //End the key string
+
+		pValue = &(pLine[anStart[2]]);
+		pValue[anLen[2]] = '\0'; //End the value string
 
-		nValIdx += RXResult.aGroups[1][0];
-		pTerminal->aInputBuffer[nValIdx + RXResult.aGroups[1][1]] = '\0'; //End the value string
+		if (pTerminal->pDispatch != NULL) {
+			nNode = TermDispatchFind(pTerminal->pDispatch, pKey, anLen[1], false);
+		}
+
+		if ((nNode != TERMINAL_NONODE) && (pTerminal->pDispatch->aNodes[nNode].pfSet != NULL)) {
+			return pTerminal->pDispatch->aNodes[nNode].pfSet(pTerminal, pKey, pValue);
+		}
 
 		for (nCtr = 0; nCtr < TERMINAL_MAXHANDLERS; nCtr++) {
 			if (pTerminal->pafSetHandlers[nCtr] != NULL) {
-				eResult = pTerminal->pafSetHandlers[nCtr](pTerminal, &(pTerminal->aInputBuffer[nKeyIdx]), &(pTerminal->aInputBuffer[nValIdx]));
+				eResult = pTerminal->pafSetHandlers[nCtr](pTerminal, pKey, pValue);
 
 				if (eResult == Success) {
 					bFoundHandler = true;
@@ -366,16 +474,24 @@ eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, uint32_t nCmdLen) {
 			return Success;
 		}else {
 			pTerminal->pfWriteTextLine(pTerminal, "Set Value Unrecognized: ");
-			pTerminal->pfWriteTextLine(pTerminal, &(pTerminal->aInputBuffer[nKeyIdx]));
+			pTerminal->pfWriteTextLine(pTerminal, pKey);
 
 			return Fail_Invalid;
 		}
 	}
 
-	//All other commands go to generic handlers
+	//All other commands go to the verb's handler, or the generic handlers
+	if (pTerminal->pDispatch != NULL) {
+		nNode = TermDispatchFind(pTerminal->pDispatch, &(pLine[anStart[0]]), anLen[0], false);
+	}
+
+	if ((nNode != TERMINAL_NONODE) && (pTerminal->pDispatch->aNodes[nNode].pfCmd != NULL)) {
+		return pTerminal->pDispatch->aNodes[nNode].pfCmd(pTerminal, pLine);
+	}
+
 	for (nCtr = 0; nCtr < TERMINAL_MAXHANDLERS; nCtr++) {
 		if (pTerminal->pafCmdHandlers[nCtr] != NULL) {
-			eResult = pTerminal->pafCmdHandlers[nCtr](pTerminal, pTerminal->aInputBuffer);
+			eResult = pTerminal->pafCmdHandlers[nCtr](pTerminal, pLine);
 
 			if (eResult == Success) {
 				bFoundHandler = true;
@@ -387,9 +503,175 @@ eReturn_t TerminalProcessCommand(sTerminal_t *pTerminal, uint32_t nCmdLen) {
 		return Success;
 	} else { //Nothing accepted this command, give generic error
 		pTerminal->pfWriteTextLine(pTerminal, "Command Unrecognized: ");
-		pTerminal->pfWriteTextLine(pTerminal, pTerminal->aInputBuffer);
+		pTerminal->pfWriteTextLine(pTerminal, pLine);
+		return Fail_Invalid;
+	}
+}
+
+eReturn_t TermDispatchInitialize(sTermDispatch_t *pTable) {
+	//Only the root node, it matches the empty string
+	pTable->nNodesUsed = 1;
+	pTable->aNodes[0].cChar = '\0';
+	pTable->aNodes[0].nChild = TERMINAL_NONODE;
+	pTable->aNodes[0].nSibling = TERMINAL_NONODE;
+	pTable->aNodes[0].pfCmd = NULL;
+	pTable->aNodes[0].pfGet = NULL;
+	pTable->aNodes[0].pfSet = NULL;
+
+	return Success;
+}
+
+eReturn_t TermDispatchAddCmd(sTermDispatch_t *pTable, const char *pVerb, pfTerminalCommandHandler_t pFunc) {
+	uint32_t nLen = strlen(pVerb);
+	uint16_t nNode;
+
+	if ((TermNameMatches(pVerb, nLen, "get") == true) || (TermNameMatches(pVerb, nLen, "set") == true)) {
+		return Fail_Invalid;
+	}
+
+	if (TermNameIsValid(pVerb, nLen) == false) {
 		return Fail_Invalid;
 	}
+
+	nNode = TermDispatchFind(pTable, pVerb, nLen, true);
+	if (nNode == TERMINAL_NONODE) {
+		return Fail_BufferSize;
+	}
+
+	if (pTable->aNodes[nNode].pfCmd != NULL) {
+		return Fail_Invalid;
+	}
+
+	pTable->aNodes[nNode].pfCmd = pFunc;
+	return Success;
+}
+
+eReturn_t TermDispatchAddGet(sTermDispatch_t *pTable, const char *pKey, pfTerminalGetHandler_t pFunc) {
+	uint32_t nLen = strlen(pKey);
+	uint16_t nNode;
+
+	if (TermNameIsValid(pKey, nLen) == false) {
+		return Fail_Invalid;
+	}
+
+	nNode = TermDispatchFind(pTable, pKey, nLen, true);
+	if (nNode == TERMINAL_NONODE) {
+		return Fail_BufferSize;
+	}
+
+	if (pTable->aNodes[nNode].pfGet != NULL) {
+		return Fail_Invalid;
+	}
+
+	pTable->aNodes[nNode].pfGet = pFunc;
+	return Success;
+}
+
+eReturn_t TermDispatchAddSet(sTermDispatch_t *pTable, const char *pKey, pfTerminalSetHandler_t pFunc) {
+	uint32_t nLen = strlen(pKey);
+	uint16_t nNode;
+
+	if (TermNameIsValid(pKey, nLen) == false) {
+		return Fail_Invalid;
+	}
+
+	nNode = TermDispatchFind(pTable, pKey, nLen, true);
+	if (nNode == TERMINAL_NONODE) {
+		return Fail_BufferSize;
+	}
+
+	if (pTable->aNodes[nNode].pfSet != NULL) {
+		return Fail_Invalid;
+	}
+
+	pTable->aNodes[nNode].pfSet = pFunc;
+	return Success;
+}
+
+uint16_t TermDispatchFind(sTermDispatch_t *pTable, const char *pName, uint32_t nLen, bool bCreate) {
+	sTermDispatchNode_t *pNode;
+	uint16_t nNode, nChild;
+	uint32_t nIdx;
+	char cChar;
+
+	nNode = 0; //Start at the root
+	for (nIdx = 0; nIdx < nLen; nIdx++) {
+		cChar = TermLowerCase(pName[nIdx]);
+
+		//Look through the characters that can follow this one
+		nChild = pTable->aNodes[nNode].nChild;
+		while ((nChild != TERMINAL_NONODE) && (pTable->aNodes[nChild].cChar != cChar)) {
+			nChild = pTable->aNodes[nChild].nSibling;
+		}
+
+		if (nChild == TERMINAL_NONODE) { //Name is not in the table
+			if ((bCreate == false) || (pTable->nNodesUsed >= TERMINAL_DISPATCHNODES)) {
+				return TERMINAL_NONODE;
+			}
+
+			//Add this character ahead of the others that can follow
+			nChild = pTable->nNodesUsed;
+			pTable->nNodesUsed += 1;
+
+			pNode = &(pTable->aNodes[nChild]);
+			pNode->cChar = cChar;
+			pNode->nChild = TERMINAL_NONODE;
+			pNode->nSibling = pTable->aNodes[nNode].nChild;
+			pNode->pfCmd = NULL;
+			pNode->pfGet = NULL;
+			pNode->pfSet = NULL;
+
+			pTable->aNodes[nNode].nChild = nChild;
+		}
+
+		nNode = nChild;
+	}
+
+	return nNode;
+}
+
+bool TermNameMatches(const char *pName, uint32_t nLen, const char *pLowerName) {
+	uint32_t nIdx;
+
+	for (nIdx = 0; nIdx < nLen; nIdx++) {
+		if ((pLowerName[nIdx] == '\0') || (TermLowerCase(pName[nIdx]) != pLowerName[nIdx])) {
+			return false;
+		}
+	}
+
+	return (pLowerName[nLen] == '\0');
+}
+
+bool TermNameIsValid(const char *pName, uint32_t nLen) {
+	uint32_t nIdx;
+
+	if (nLen == 0) {
+		return false;
+	}
+
+	for (nIdx = 0; nIdx < nLen; nIdx++) {
+		if (TermIsWhiteSpace(pName[nIdx]) == true) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool TermIsWhiteSpace(char cChar) {
+	if ((cChar == ' ') || (cChar == '\t') || (cChar == '\r') || (cChar == '\n')) {
+		return true;
+	}
+
+	return false;
+}
+
+char TermLowerCase(char cChar) {
+	if ((cChar >= 'A') && (cChar <= 'Z')) {
+		return cChar - 'A' + 'a';
+	}
+
+	return cChar;
 }
 
 eReturn_t TerminalAddSetHandler(sTerminal_t *pTerminal, pfTerminalSetHandler_t pFunc) {
@@ -530,8 +812,8 @@ eReturn_t IOCnctCreateFromTCPServ(sTCPServ_t *pTCPIface, sIOConnect_t *pIOObj) {
 
 	pIOObj->pfReadByte = &IOCnctReadByteTCPServ;
 	pIOObj->pfWriteByte = &IOCnctWriteByteTCPServ;
-	pIOObj->pfReadData = &IOCnctReadDataNoImplement;
-	pIOObj->pfWriteData = &IOCnctWriteDataNoImplement;
+	pIOObj->pfReadData = &IOCnctReadDataTCPServ;
+	pIOObj->pfWriteData = &IOCnctWriteDataTCPServ;
 
 	pIOObj->pHWInfo = pTCPIface;
 	pIOObj->pClient = NULL;
@@ -550,6 +832,20 @@ eReturn_t IOCnctCreateFromTCPServ(sTCPServ_t *pTCPIface, sIOConnect_t *pIOObj) {
 	return Success;
 }
 
+eReturn_t IOCnctCreateFromTCPSocket(sTCPServ_t *pTCPIface, sSocket_t *pSck, sIOConnect_t *pIOObj) {
+	IOCnctObjectInitialize(pIOObj);
+
+	pIOObj->pfReadByte = &IOCnctReadByteTCPServ;
+	pIOObj->pfWriteByte = &IOCnctWriteByteTCPServ;
+	pIOObj->pfReadData = &IOCnctReadDataTCPServ;
+	pIOObj->pfWriteData = &IOCnctWriteDataTCPServ;
+
+	pIOObj->pHWInfo = pTCPIface;
+	pIOObj->pClient = (void *)pSck->nSocket; //All we need is the socket number to comm through it
+
+	return Success;
+}
+
 eReturn_t IOCnctReadByteTCPServ(sIOConnect_t *pIOObj, uint8_t *pnByte) {
 	sSocket_t sckClient;
 	uint32_t nBytesRcv;
@@ -589,3 +885,237 @@ eReturn_t IOCnctWriteByteTCPServ(sIOConnect_t *pIOObj, uint8_t nByte) {
 	return Success;
 }
 
+eReturn_t IOCnctReadDataTCPServ(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize) {
+	sSocket_t sckClient;
+	eNetReturn_t eResult;
+
+	//Extract TCP objects
+	sTCPServ_t *pServ = (sTCPServ_t *)pIOObj->pHWInfo;
+	sckClient.nSocket = (int32_t)pIOObj->pClient;
+
+	eResult = pServ->pfReceive(pServ, &sckClient, nBuffSize, pnDataBuff, pnReadSize);
+
+	return IOCnctNetResult(eResult);
+}
+
+eReturn_t IOCnctWriteDataTCPServ(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	sSocket_t sckClient;
+	eNetReturn_t eResult;
+
+	//Extract TCP objects
+	sTCPServ_t *pServ = (sTCPServ_t *)pIOObj->pHWInfo;
+	sckClient.nSocket = (int32_t)pIOObj->pClient;
+
+	eResult = pServ->pfSend(pServ, &sckClient, nDataLen, pnData);
+
+	return IOCnctNetResult(eResult);
+}
+
+eReturn_t IOCnctCreateFromTCPClient(sTCPClient_t *pTCPClient, sIOConnect_t *pIOObj) {
+	IOCnctObjectInitialize(pIOObj);
+
+	pIOObj->pfReadByte = &IOCnctReadByteFromData;
+	pIOObj->pfWriteByte = &IOCnctWriteByteFromData;
+	pIOObj->pfReadData = &IOCnctReadDataTCPClient;
+	pIOObj->pfWriteData = &IOCnctWriteDataTCPClient;
+
+	pIOObj->pHWInfo = pTCPClient;
+	pIOObj->pClient = NULL;
+
+	return Success;
+}
+
+eReturn_t IOCnctReadDataTCPClient(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize) {
+	sTCPClient_t *pClient = (sTCPClient_t *)pIOObj->pHWInfo;
+	eNetReturn_t eResult;
+
+	eResult = pClient->pfReceive(pClient, nBuffSize, pnDataBuff, pnReadSize);
+
+	return IOCnctNetResult(eResult);
+}
+
+eReturn_t IOCnctWriteDataTCPClient(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	sTCPClient_t *pClient = (sTCPClient_t *)pIOObj->pHWInfo;
+	eNetReturn_t eResult;
+
+	eResult = pClient->pfSend(pClient, nDataLen, pnData);
+
+	return IOCnctNetResult(eResult);
+}
+
+eReturn_t IOCnctCreateFromUDPServ(sUDPServ_t *pUDPServ, sIOCnctUDP_t *pState, sIOConnect_t *pIOObj) {
+	IOCnctObjectInitialize(pIOObj);
+
+	pIOObj->pfReadByte = &IOCnctReadByteFromData;
+	pIOObj->pfWriteByte = &IOCnctWriteByteFromData;
+	pIOObj->pfReadData = &IOCnctReadDataUDPServ;
+	pIOObj->pfWriteData = &IOCnctWriteDataUDPServ;
+
+	pState->nHead = 0;
+	pState->nCount = 0;
+
+	pIOObj->pHWInfo = pUDPServ;
+	pIOObj->pClient = pState;
+
+	return Success;
+}
+
+eReturn_t IOCnctReadDataUDPServ(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize) {
+	sUDPServ_t *pServ = (sUDPServ_t *)pIOObj->pHWInfo;
+	sIOCnctUDP_t *pState = (sIOCnctUDP_t *)pIOObj->pClient;
+	sConnInfo_t Sender;
+	uint32_t nRecv;
+	eNetReturn_t eResult;
+
+	*pnReadSize = 0;
+
+	if (pState->nCount == 0) { //Nothing held, take the next datagram whole
+		eResult = pServ->pfReceive(pServ, &Sender, sizeof(pState->aDatagram), pState->aDatagram, &nRecv);
+		if (eResult < Net_Success) {
+			return Fail_CommError;
+		}
+
+		if (nRecv > TERMINAL_DATAGRAMMAX) { //Filled the spare byte, it was cut short
+			return Fail_BufferSize;
+		}
+
+		if (nRecv > 0) { //Replies go to whoever sent this
+			pState->sPeer = Sender;
+		}
+
+		pState->nHead = 0;
+		pState->nCount = nRecv;
+	}
+
+	*pnReadSize = GetSmallerNum(nBuffSize, pState->nCount);
+	memcpy(pnDataBuff, &(pState->aDatagram[pState->nHead]), *pnReadSize);
+	pState->nHead += *pnReadSize;
+	pState->nCount -= *pnReadSize;
+
+	if (*pnReadSize < nBuffSize) {
+		return Warn_EndOfData;
+	}
+
+	return Success;
+}
+
+eReturn_t IOCnctWriteDataUDPServ(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	sUDPServ_t *pServ = (sUDPServ_t *)pIOObj->pHWInfo;
+	sIOCnctUDP_t *pState = (sIOCnctUDP_t *)pIOObj->pClient;
+	eNetReturn_t eResult;
+
+	eResult = pServ->pfSend(pServ, &(pState->sPeer), nDataLen, pnData);
+
+	return IOCnctNetResult(eResult);
+}
+
+eReturn_t IOCnctPipeInitialize(sIOCnctPipe_t *pPipe, uint8_t *pBuffer, uint32_t nBuffSize) {
+	pPipe->pBuffer = pBuffer;
+	pPipe->nBuffSize = nBuffSize;
+	pPipe->nHead = 0;
+	pPipe->nCount = 0;
+
+	return Success;
+}
+
+eReturn_t IOCnctCreateFromPipes(sIOCnctPipe_t *pReadPipe, sIOCnctPipe_t *pWritePipe, sIOConnect_t *pIOObj) {
+	IOCnctObjectInitialize(pIOObj);
+
+	pIOObj->pfReadByte = &IOCnctReadByteFromData;
+	pIOObj->pfWriteByte = &IOCnctWriteByteFromData;
+	pIOObj->pfReadData = &IOCnctReadDataPipe;
+	pIOObj->pfWriteData = &IOCnctWriteDataPipe;
+
+	pIOObj->pHWInfo = pReadPipe;
+	pIOObj->pClient = pWritePipe;
+
+	return Success;
+}
+
+eReturn_t IOCnctReadDataPipe(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize) {
+	sIOCnctPipe_t *pPipe = (sIOCnctPipe_t *)pIOObj->pHWInfo;
+	uint32_t nFirst;
+
+	if (nBuffSize > pPipe->nCount) {
+		*pnReadSize = pPipe->nCount;
+	} else {
+		*pnReadSize = nBuffSize;
+	}
+
+	//Copy up to the end of the storage, then any remainder from the front
+	nFirst = pPipe->nBuffSize - pPipe->nHead;
+	if (nFirst > *pnReadSize) {
+		nFirst = *pnReadSize;
+	}
+
+	memcpy(pnDataBuff, &(pPipe->pBuffer[pPipe->nHead]), nFirst);
+	memcpy(&(pnDataBuff[nFirst]), pPipe->pBuffer, *pnReadSize - nFirst);
+
+	pPipe->nHead += *pnReadSize;
+	if (pPipe->nHead >= pPipe->nBuffSize) {
+		pPipe->nHead -= pPipe->nBuffSize;
+	}
+	pPipe->nCount -= *pnReadSize;
+
+	if (*pnReadSize < nBuffSize) {
+		return Warn_EndOfData;
+	}
+
+	return Success;
+}
+
+eReturn_t IOCnctWriteDataPipe(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	sIOCnctPipe_t *pPipe = (sIOCnctPipe_t *)pIOObj->pClient;
+	uint32_t nTail, nFirst;
+
+	if (nDataLen > pPipe->nBuffSize - pPipe->nCount) { //Not enough room for all of it
+		return Fail_BufferSize;
+	}
+
+	nTail = pPipe->nHead + pPipe->nCount;
+	if (nTail >= pPipe->nBuffSize) {
+		nTail -= pPipe->nBuffSize;
+	}
+
+	//Copy up to the end of the storage, then any remainder to the front
+	nFirst = pPipe->nBuffSize - nTail;
+	if (nFirst > nDataLen) {
+		nFirst = nDataLen;
+	}
+
+	memcpy(&(pPipe->pBuffer[nTail]), pnData, nFirst);
+	memcpy(pPipe->pBuffer, &(pnData[nFirst]), nDataLen - nFirst);
+
+	pPipe->nCount += nDataLen;
+
+	return Success;
+}
+
+eReturn_t IOCnctReadByteFromData(sIOConnect_t *pIOObj, uint8_t *pnByte) {
+	uint32_t nReadSize;
+	eReturn_t eResult;
+
+	eResult = pIOObj->pfReadData(pIOObj, pnByte, 1, &nReadSize);
+
+	if (eResult < Success) {
+		return eResult;
+	} else if (nReadSize < 1) {
+		return Warn_EndOfData;
+	}
+
+	return Success;
+}
+
+eReturn_t IOCnctWriteByteFromData(sIOConnect_t *pIOObj, uint8_t nByte) {
+	return pIOObj->pfWriteData(pIOObj, &nByte, 1);
+}
+
+eReturn_t IOCnctNetResult(eNetReturn_t eResult) {
+	if (eResult == Net_Success) {
+		return Success;
+	} else if (eResult > Net_Success) { //Warnings mean less data than asked for
+		return Warn_EndOfData;
+	} else {
+		return Fail_CommError;
+	}
+}
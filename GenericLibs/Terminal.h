@@ -21,14 +21,53 @@
 	#include "StringTools.h"
 
 /*****	Defines		*****/
-	#define TERMINAL_BUFFERSIZE		50
+	#ifndef TERMINAL_BUFFERSIZE
+		/**	@brief		Size of the input buffer held in each terminal
+			@details	A terminal can be given a larger buffer with 
+				TerminalSetInputBuffer().  The longest line accepted is one less
+				than the buffer size.
+			@ingroup	terminal
+		*/
+		#define TERMINAL_BUFFERSIZE		50
+	#endif
 
 	#define TERMINAL_MAXHANDLERS	5
 
+	#ifndef TERMINAL_WRITEBUFFSIZE
+		/**	@brief		Longest text line, with its line end, that is written in one call
+			@details	Longer lines are written in two calls, the text then the line end.
+			@ingroup	terminal
+		*/
+		#define TERMINAL_WRITEBUFFSIZE	128
+	#endif
+
+	#ifndef TERMINAL_DISPATCHNODES
+		/**	@brief		Characters of verbs and keys one dispatch table can hold
+			@details	Names sharing a beginning share its characters.
+			@ingroup	terminal
+		*/
+		#define TERMINAL_DISPATCHNODES	96
+	#endif
+
+	#ifndef TERMINAL_DATAGRAMMAX
+		/**	@brief		Largest datagram a UDP IOConnect object accepts
+			@details	A datagram is handed out over as many reads as it takes.
+			@ingroup	terminal
+		*/
+		#define TERMINAL_DATAGRAMMAX	512
+	#endif
+
+	/**	@brief		Marks the end of a branch in the dispatch table
+		@ingroup	terminal
+	*/
+	#define TERMINAL_NONODE			0xFFFF
+
 /*****	Definitions	*****/
 	typedef struct sIOConnect_t sIOConnect_t;
 	
 	typedef struct sTerminal_t sTerminal_t;
+	
+	typedef struct sTermDispatch_t sTermDispatch_t;
 
 	typedef enum eIOConnectCapabilities_t {
 		IOCnctCap_None		= 0x0000,
@@ -51,6 +90,30 @@
 		void *pClient;						/**< Pointer to client information to use */
 	} sIOConnect_t;
 
+	/**	@brief		In memory byte queue that IOConnect objects can use in place of hardware
+		@details	Two pipes make a connection, one for each direction.  Intended for 
+			tests and for joining a terminal to other code in the same program.
+		@ingroup	terminal
+	*/
+	typedef struct sIOCnctPipe_t {
+		uint8_t *pBuffer;					/**< Storage for the queued bytes */
+		uint32_t nBuffSize;					/**< Bytes the storage can hold */
+		uint32_t nHead;						/**< Index of the oldest queued byte */
+		uint32_t nCount;					/**< Bytes queued */
+	} sIOCnctPipe_t;
+
+	/**	@brief		State of an IOConnect object on a UDP server
+		@details	Holds the datagram being read so reads smaller than it do not 
+			lose the rest, and the peer that replies are sent to.
+		@ingroup	terminal
+	*/
+	typedef struct sIOCnctUDP_t {
+		sConnInfo_t sPeer;					/**< Address writes are sent to, the sender of the last datagram */
+		uint8_t aDatagram[TERMINAL_DATAGRAMMAX + 1];	/**< Datagram being read, one spare byte shows one was too large */
+		uint32_t nHead;						/**< Index of the next byte to read */
+		uint32_t nCount;					/**< Bytes of the datagram not yet read */
+	} sIOCnctUDP_t;
+
 	typedef eReturn_t (*pfTerminalWriteTextLine_t)(sTerminal_t *pTerminal, const char *pText);
 	typedef eReturn_t (*pfTerminalReadInput_t)(sTerminal_t *pTerminal);
 	typedef eReturn_t (*pfTerminalSetHandler_t)(sTerminal_t *pTerminal, const char *pKey, const char *pValue);
@@ -60,6 +123,29 @@
 	typedef eReturn_t (*pfTerminalUpdateGetHandler_t)(sTerminal_t *pTerminal, pfTerminalGetHandler_t pFunc);
 	typedef eReturn_t (*pfTerminalUpdateCmdHandler_t)(sTerminal_t *pTerminal, pfTerminalCommandHandler_t pFunc);
 
+	/**	@brief		One character of a verb or key in the dispatch table
+		@ingroup	terminal
+	*/
+	typedef struct sTermDispatchNode_t {
+		char cChar;							/**< Character this node matches, lower case */
+		uint16_t nChild;					/**< First node matching the next character */
+		uint16_t nSibling;					/**< Next node matching another character in this position */
+		pfTerminalCommandHandler_t pfCmd;	/**< Handler if the text to here is a command verb */
+		pfTerminalGetHandler_t pfGet;		/**< Handler if the text to here is a GET key */
+		pfTerminalSetHandler_t pfSet;		/**< Handler if the text to here is a SET key */
+	} sTermDispatchNode_t;
+
+	/**	@brief		Table leading each command verb and GET/SET key to its one handler
+		@details	Names are stored in a trie, so finding one takes a single pass
+			over its characters.  A table may be shared by any number of 
+			terminals.
+		@ingroup	terminal
+	*/
+	typedef struct sTermDispatch_t {
+		uint16_t nNodesUsed;								/**< Nodes holding characters, the first is the root */
+		sTermDispatchNode_t aNodes[TERMINAL_DISPATCHNODES];	/**< Characters of every name */
+	} sTermDispatch_t;
+
 	typedef struct sTerminal_t {
 		pfTerminalWriteTextLine_t pfWriteTextLine;
 		pfTerminalReadInput_t pfReadInput;
@@ -77,9 +163,16 @@
 		pfTerminalGetHandler_t pafGetHandlers[TERMINAL_MAXHANDLERS];
 		pfTerminalCommandHandler_t pafCmdHandlers[TERMINAL_MAXHANDLERS];
 
-		char aInputBuffer[TERMINAL_BUFFERSIZE];
-		uint32_t nBufferUsed;
+		char aInputBuffer[TERMINAL_BUFFERSIZE];	/**< Input storage used unless another buffer is given */
+		char *pInputBuffer;					/**< Input storage in use */
+		uint32_t nBufferSize;				/**< Bytes in the input storage in use */
+		uint32_t nLineStart;				/**< Index of the first character of the unfinished line */
+		uint32_t nScanIdx;					/**< Index of the first character not yet checked for a line end */
+		uint32_t nBufferUsed;				/**< Index just past the last character received */
+		bool bDiscardLine;					/**< True while skipping the rest of a line too long for the buffer */
 		sIOConnect_t *pIOObj;
+		void *pContext;						/**< Caller's data for the handlers, NULL if unused */
+		sTermDispatch_t *pDispatch;			/**< Table of named handlers, NULL to only use the handler lists */
 	} sTerminal_t;
 
 /*****	Constants	*****/
@@ -94,8 +187,119 @@
 	eReturn_t IOCnctCreateFromUART(sUARTIface_t *pUARTIface, sIOConnect_t *pIOObj);
 	
 	eReturn_t IOCnctCreateFromTCPServ(sTCPServ_t *pTCPIface, sIOConnect_t *pIOObj);
+	
+	/**	@brief		Create an IOConnect object on a client socket that is already accepted
+		@details	Unlike IOCnctCreateFromTCPServ() this does not wait for a client,
+			and leaves the socket's receive time out alone.
+		@param		pTCPIface	TCP server the client belongs to
+		@param		pSck		Client socket to communicate through
+		@param		pIOObj		IOConnect object to prepare
+		@return		Success once the object is ready
+		@ingroup	terminal
+	*/
+	eReturn_t IOCnctCreateFromTCPSocket(sTCPServ_t *pTCPIface, sSocket_t *pSck, sIOConnect_t *pIOObj);
+	
+	/**	@brief		Create an IOConnect object on a TCP client
+		@param		pTCPClient	TCP client that is already connected
+		@param		pIOObj		IOConnect object to prepare
+		@return		Success once the object is ready
+		@ingroup	terminal
+	*/
+	eReturn_t IOCnctCreateFromTCPClient(sTCPClient_t *pTCPClient, sIOConnect_t *pIOObj);
+	
+	/**	@brief		Create an IOConnect object on a UDP server
+		@details	A read returns bytes from one datagram at a time, a datagram 
+			larger than the read is kept and handed out by the reads that follow.
+			Datagrams larger than TERMINAL_DATAGRAMMAX are dropped and the read
+			fails with Fail_BufferSize.  The sender of each datagram is stored
+			as the peer, and writes are sent to the peer, so replies go to 
+			whoever sent last.
+		@param		pUDPServ	UDP server that is already bound
+		@param		pState		Holds the peer and the datagram being read.  Set
+			sPeer to send before anything is read.  Must remain valid as long 
+			as the IOConnect object is used.
+		@param		pIOObj		IOConnect object to prepare
+		@return		Success once the object is ready
+		@ingroup	terminal
+	*/
+	eReturn_t IOCnctCreateFromUDPServ(sUDPServ_t *pUDPServ, sIOCnctUDP_t *pState, sIOConnect_t *pIOObj);
+	
+	/**	@brief		Prepare an empty pipe
+		@param		pPipe		Pipe to initialize
+		@param		pBuffer		Storage for the queued bytes
+		@param		nBuffSize	Bytes the storage can hold
+		@return		Success once the pipe is empty
+		@ingroup	terminal
+	*/
+	eReturn_t IOCnctPipeInitialize(sIOCnctPipe_t *pPipe, uint8_t *pBuffer, uint32_t nBuffSize);
+	
+	/**	@brief		Create an IOConnect object on a pair of pipes
+		@details	Writes that do not fit in the pipe fail with Fail_BufferSize and
+			queue nothing.  Reads return Warn_EndOfData when the pipe runs out.
+		@param		pReadPipe	Pipe read from
+		@param		pWritePipe	Pipe written to
+		@param		pIOObj		IOConnect object to prepare
+		@return		Success once the object is ready
+		@ingroup	terminal
+	*/
+	eReturn_t IOCnctCreateFromPipes(sIOCnctPipe_t *pReadPipe, sIOCnctPipe_t *pWritePipe, sIOConnect_t *pIOObj);
 
 	eReturn_t TerminalInitialize(sTerminal_t *pTerm, sIOConnect_t *pIOObj);
+	
+	/**	@brief		Give a terminal its own input buffer
+		@details	Lines are handled in place in the input buffer, handlers are 
+			given pointers into it that are only good until the handler returns.
+			Any input not yet handled is thrown away.
+		@param		pTerm		Terminal to use the buffer
+		@param		pBuffer		Buffer to hold the input
+		@param		nBuffSize	Bytes in the buffer, the longest line accepted is
+			one less than this
+		@return		Success if the buffer is in use, Fail_Invalid if it is too small
+		@ingroup	terminal
+	*/
+	eReturn_t TerminalSetInputBuffer(sTerminal_t *pTerm, char *pBuffer, uint32_t nBuffSize);
+	
+	/**	@brief		Prepare an empty dispatch table
+		@details	Give it to a terminal by setting the terminal's pDispatch.  Lines 
+			whose verb or key is in the table go to that handler alone, all other
+			lines are offered to the terminal's handler lists as before.
+		@param		pTable		Table to initialize
+		@return		Success once the table is empty
+		@ingroup	terminal
+	*/
+	eReturn_t TermDispatchInitialize(sTermDispatch_t *pTable);
+	
+	/**	@brief		Add a command verb to a dispatch table
+		@details	The handler is given the whole line.  Verbs are not case 
+			sensitive, GET and SET can not be used as verbs.
+		@param		pTable		Table to add to
+		@param		pVerb		First word of lines the handler takes
+		@param		pFunc		Handler for the verb
+		@return		Success if added, Fail_Invalid if the verb is empty, has white
+			space, is taken, or is GET or SET, Fail_BufferSize if the table is full
+		@ingroup	terminal
+	*/
+	eReturn_t TermDispatchAddCmd(sTermDispatch_t *pTable, const char *pVerb, pfTerminalCommandHandler_t pFunc);
+	
+	/**	@brief		Add a GET key to a dispatch table
+		@param		pTable		Table to add to
+		@param		pKey		Key the handler reports, not case sensitive
+		@param		pFunc		Handler for the key
+		@return		Success if added, Fail_Invalid if the key is empty, has white
+			space, or is taken, Fail_BufferSize if the table is full
+		@ingroup	terminal
+	*/
+	eReturn_t TermDispatchAddGet(sTermDispatch_t *pTable, const char *pKey, pfTerminalGetHandler_t pFunc);
+	
+	/**	@brief		Add a SET key to a dispatch table
+		@param		pTable		Table to add to
+		@param		pKey		Key the handler changes, not case sensitive
+		@param		pFunc		Handler for the key
+		@return		Success if added, Fail_Invalid if the key is empty, has white
+			space, or is taken, Fail_BufferSize if the table is full
+		@ingroup	terminal
+	*/
+	eReturn_t TermDispatchAddSet(sTermDispatch_t *pTable, const char *pKey, pfTerminalSetHandler_t pFunc);
 
 /*****	Functions	*****/
 
@@ -0,0 +1,128 @@
+/**	File:	TerminalServer.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "TerminalServer.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+
+
+/*****	Functions	*****/
+eReturn_t TermServInitialize(sTermServ_t *pTermServ, sTCPServ_t *pTCPServ) {
+	uint32_t nCtr;
+
+	pTermServ->pTCPServ = pTCPServ;
+	pTermServ->pfOpened = NULL;
+	pTermServ->pfClosed = NULL;
+	pTermServ->nSessionCnt = 0;
+
+	//The template never does any IO, it only collects handlers
+	TerminalInitialize(&(pTermServ->Template), NULL);
+
+	for (nCtr = 0; nCtr < TERMSERV_MAXSESSIONS; nCtr++) {
+		pTermServ->aSessions[nCtr].bInUse = false;
+		pTermServ->aSessions[nCtr].pTermServ = pTermServ;
+		pTermServ->aSessions[nCtr].Sck.nSocket = SOCKET_INVALID;
+	}
+
+	return Success;
+}
+
+eReturn_t TermServOpenSession(sTermServ_t *pTermServ, sSocket_t *pSck, sTermSession_t **ppSession) {
+	sTermSession_t *pSession;
+	uint32_t nCtr;
+
+	*ppSession = NULL;
+
+	for (nCtr = 0; nCtr < TERMSERV_MAXSESSIONS; nCtr++) {
+		if (pTermServ->aSessions[nCtr].bInUse == false) {
+			break;
+		}
+	}
+
+	if (nCtr == TERMSERV_MAXSESSIONS) { //Every session is in use
+		return Fail_BufferSize;
+	}
+
+	pSession = &(pTermServ->aSessions[nCtr]);
+	pSession->Sck = *pSck;
+	pSession->bInUse = true;
+
+	IOCnctCreateFromTCPSocket(pTermServ->pTCPServ, &(pSession->Sck), &(pSession->IOObj));
+	TerminalInitialize(&(pSession->Term), &(pSession->IOObj));
+
+	//Give the session every handler the template holds
+	memcpy(pSession->Term.pafSetHandlers, pTermServ->Template.pafSetHandlers, sizeof(pSession->Term.pafSetHandlers));
+	memcpy(pSession->Term.pafGetHandlers, pTermServ->Template.pafGetHandlers, sizeof(pSession->Term.pafGetHandlers));
+	memcpy(pSession->Term.pafCmdHandlers, pTermServ->Template.pafCmdHandlers, sizeof(pSession->Term.pafCmdHandlers));
+	pSession->Term.pDispatch = pTermServ->Template.pDispatch; //Table is only read, it can be shared
+
+	pTermServ->nSessionCnt += 1;
+
+	if (pTermServ->pfOpened != NULL) {
+		pTermServ->pfOpened(pTermServ, &(pSession->Term));
+	}
+
+	*ppSession = pSession;
+	return Success;
+}
+
+eReturn_t TermServSessionInput(sTermSession_t *pSession) {
+	sTerminal_t *pTerm = &(pSession->Term);
+	eReturn_t eResult;
+
+	if (pSession->bInUse == false) {
+		return Fail_Invalid;
+	}
+
+	eResult = pTerm->pfReadInput(pTerm);
+	if (eResult < Success) { //Client has gone
+		return Fail_CommError;
+	}
+
+	return Success;
+}
+
+eReturn_t TermServCloseSession(sTermSession_t *pSession) {
+	sTermServ_t *pTermServ = pSession->pTermServ;
+
+	if (pSession->bInUse == false) {
+		return Success;
+	}
+
+	if (pTermServ->pfClosed != NULL) {
+		pTermServ->pfClosed(pTermServ, &(pSession->Term));
+	}
+
+	pTermServ->pTCPServ->pfCloseSocket(pTermServ->pTCPServ, &(pSession->Sck));
+
+	pSession->Sck.nSocket = SOCKET_INVALID;
+	pSession->bInUse = false;
+	pTermServ->nSessionCnt -= 1;
+
+	return Success;
+}
+
+eReturn_t TermServCloseAll(sTermServ_t *pTermServ) {
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < TERMSERV_MAXSESSIONS; nCtr++) {
+		TermServCloseSession(&(pTermServ->aSessions[nCtr]));
+	}
+
+	return Success;
+}
@@ -0,0 +1,133 @@
+/**	@defgroup	termserv	Terminal session server
+	@brief		Hosts many terminal sessions on one TCP server
+	@details	v0.1
+	#Description
+		Each client connection gets its own session holding a terminal, with its
+		own input buffer and handler context, and an IOConnect object on the
+		client's socket.  Sessions are kept in a fixed pool so the memory used
+		never grows past TERMSERV_MAXSESSIONS of them.
+
+		The server does no waiting of its own.  It is driven by whatever watches
+		the sockets: open a session when a client is accepted, pass it input when
+		its socket is readable, and close it when the client hangs up.  A
+		session that receives nothing is never touched, so idle sessions cost no
+		processing time.  RasPiEpollServeTerminals() does this for the epoll
+		event loop on Linux.
+
+		The handlers added to the server's template terminal are given to every
+		session opened afterward.  The opened and closed callbacks can be used
+		to create and release each session's handler context.
+
+	#File Information
+		File:	TerminalServer.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __TERMINALSERVER_H
+	#define __TERMINALSERVER_H
+
+/*****	Includes	*****/
+	#include "CommonUtils.h"
+	#include "NetworkGeneralInterface.h"
+	#include "Terminal.h"
+
+/*****	Defines		*****/
+	#ifndef TERMSERV_MAXSESSIONS
+		/**	@brief		Number of sessions one server can hold at once
+			@ingroup	termserv
+		*/
+		#define TERMSERV_MAXSESSIONS	8
+	#endif
+
+/*****	Definitions	*****/
+	typedef struct sTermServ_t sTermServ_t;
+
+	/**	@brief		Function called when a session is opened or closed
+		@param		pTermServ	Server the session belongs to
+		@param		pTerm		Terminal of the session, its pContext may be set or
+			released here
+		@ingroup	termserv
+	*/
+	typedef void (*pfTermServSessionEvent_t)(sTermServ_t *pTermServ, sTerminal_t *pTerm);
+
+	/**	@brief		One client connection and its terminal
+		@ingroup	termserv
+	*/
+	typedef struct sTermSession_t {
+		sTerminal_t Term;			/**< Terminal for this client, always the first member */
+		sIOConnect_t IOObj;			/**< Connection to the client's socket */
+		sSocket_t Sck;				/**< Socket the client is connected through */
+		sTermServ_t *pTermServ;		/**< Server holding this session */
+		bool bInUse;				/**< True if the session holds a client */
+	} sTermSession_t;
+
+	/**	@brief		Pool of terminal sessions on one TCP server
+		@ingroup	termserv
+	*/
+	typedef struct sTermServ_t {
+		sTCPServ_t *pTCPServ;						/**< Server the clients connect through */
+		sTerminal_t Template;						/**< Handlers added here are given to every new session */
+
+		pfTermServSessionEvent_t pfOpened;			/**< Called after a session is opened, NULL for none */
+		pfTermServSessionEvent_t pfClosed;			/**< Called before a session is closed, NULL for none */
+
+		uint32_t nSessionCnt;						/**< Sessions currently open */
+		sTermSession_t aSessions[TERMSERV_MAXSESSIONS];	/**< Session pool */
+	} sTermServ_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare a terminal server for use
+		@details	The TCP server must already be bound.  Add handlers through the
+			template terminal's functions.
+		@param		pTermServ	Terminal server to initialize
+		@param		pTCPServ	TCP server the clients connect through
+		@return		Success once the server is ready
+		@ingroup	termserv
+	*/
+	eReturn_t TermServInitialize(sTermServ_t *pTermServ, sTCPServ_t *pTCPServ);
+
+	/**	@brief		Open a session for a newly accepted client
+		@param		pTermServ	Terminal server to hold the session
+		@param		pSck		Socket of the accepted client
+		@param		ppSession	Returns the session that was opened
+		@return		Success if the session was opened, Fail_BufferSize if every
+			session is in use
+		@ingroup	termserv
+	*/
+	eReturn_t TermServOpenSession(sTermServ_t *pTermServ, sSocket_t *pSck, sTermSession_t **ppSession);
+
+	/**	@brief		Read and process input waiting for a session
+		@details	Reads until the socket has no more data, running every complete
+			line.  A line too long for the terminal's buffer is thrown away.
+		@param		pSession	Session with input waiting
+		@return		Success if the input was handled, Fail_CommError if the client
+			has gone and the session should be closed
+		@ingroup	termserv
+	*/
+	eReturn_t TermServSessionInput(sTermSession_t *pSession);
+
+	/**	@brief		Close a session and its client socket
+		@param		pSession	Session to close
+		@return		Success once the session is free for reuse
+		@ingroup	termserv
+	*/
+	eReturn_t TermServCloseSession(sTermSession_t *pSession);
+
+	/**	@brief		Close every open session
+		@param		pTermServ	Terminal server to close the sessions of
+		@return		Success once all sessions are closed
+		@ingroup	termserv
+	*/
+	eReturn_t TermServCloseAll(sTermServ_t *pTermServ);
+
+/*****	Functions	*****/
+
+
+#endif
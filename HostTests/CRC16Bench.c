@@ -0,0 +1,238 @@
+/**	File:	CRC16Bench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Checks the CRC16 context against the byte at a time calculation, then
+	measures the throughput of each.  The number of slices the context uses is
+	set when building, CRCSLICES in the makefile.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "CRC16.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Bytes of data each benchmark pass works through */
+	#define CRCBENCH_BUFFSIZE		65536
+
+	/**	@brief		Seconds each benchmark runs for */
+	#define CRCBENCH_SECONDS		1.0
+
+	/**	@brief		Bytes of user data in a full DNP link frame */
+	#define CRCBENCH_DNPUSERDATA	250
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static uint8_t gaData[CRCBENCH_BUFFSIZE];
+
+	static sCRC16Context_t gDNPCtx;
+
+	static sCRC16Context_t gModbusCtx;
+
+	/**	@brief		Keeps the results in use so the benchmarks are not optimized away */
+	static volatile crc16_t gnSink;
+
+/*****	Prototypes 	*****/
+	static void CRCBenchCheck(void);
+
+	static uint32_t CRCBenchDNPFrame(uint8_t *pFrame, const uint8_t *pUserData, uint32_t nUserLen);
+
+	static void CRCBenchReport(const char *pName, uint64_t nBytes, double nSeconds, double nBaseline);
+
+/*****	Functions	*****/
+int main(void) {
+	uint8_t aFrame[512];
+	uint32_t nFrameLen, nCtr, nPos, nBlockLen;
+	uint64_t nBytes;
+	double nStart, nTime, nOldRate;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	CRC16ContextInitialize(&gDNPCtx, CRC_DNP);
+	CRC16ContextInitialize(&gModbusCtx, CRC_Modbus);
+
+	CRCBenchCheck();
+
+	nCtr = 1;
+	HostTestRandom(&nCtr, gaData, CRCBENCH_BUFFSIZE);
+	printf("CRC16 context with %d slice(s), %d bytes of tables\n", CRC16_SLICES, (int)sizeof(gDNPCtx.aTable));
+
+	//DNP user data is checked 16 bytes at a time, measure it that way
+	nBytes = 0;
+	nStart = HostTestSeconds();
+	do {
+		for (nCtr = 0; nCtr < CRCBENCH_BUFFSIZE; nCtr += CRC16_DNPBLOCKSIZE) {
+			gnSink = CalculateCRC16(CRC_DNP, &gaData[nCtr], CRC16_DNPBLOCKSIZE);
+		}
+
+		nBytes += CRCBENCH_BUFFSIZE;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < CRCBENCH_SECONDS);
+	nOldRate = nBytes / nTime;
+	CRCBenchReport("CalculateCRC16 DNP, 16 byte blocks", nBytes, nTime, 0);
+
+	nBytes = 0;
+	nStart = HostTestSeconds();
+	do {
+		for (nCtr = 0; nCtr < CRCBENCH_BUFFSIZE; nCtr += CRC16_DNPBLOCKSIZE) {
+			gnSink = CRC16ContextCalculate(&gDNPCtx, &gaData[nCtr], CRC16_DNPBLOCKSIZE);
+		}
+
+		nBytes += CRCBENCH_BUFFSIZE;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < CRCBENCH_SECONDS);
+	CRCBenchReport("CRC16ContextCalculate DNP, 16 byte blocks", nBytes, nTime, nOldRate);
+
+	//Whole buffers, where slicing has the most room to work
+	nBytes = 0;
+	nStart = HostTestSeconds();
+	do {
+		gnSink = CalculateCRC16(CRC_Modbus, gaData, CRCBENCH_BUFFSIZE);
+
+		nBytes += CRCBENCH_BUFFSIZE;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < CRCBENCH_SECONDS);
+	nOldRate = nBytes / nTime;
+	CRCBenchReport("CalculateCRC16 Modbus, 64 KB buffer", nBytes, nTime, 0);
+
+	nBytes = 0;
+	nStart = HostTestSeconds();
+	do {
+		gnSink = CRC16ContextCalculate(&gModbusCtx, gaData, CRCBENCH_BUFFSIZE);
+
+		nBytes += CRCBENCH_BUFFSIZE;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < CRCBENCH_SECONDS);
+	CRCBenchReport("CRC16ContextCalculate Modbus, 64 KB buffer", nBytes, nTime, nOldRate);
+
+	//Full link frames, the old way checks the header and each block on its own
+	nFrameLen = CRCBenchDNPFrame(aFrame, gaData, CRCBENCH_DNPUSERDATA);
+
+	nBytes = 0;
+	nStart = HostTestSeconds();
+	do {
+		for (nCtr = 0; nCtr < 1000; nCtr++) {
+			gnSink = CalculateCRC16(CRC_DNP, aFrame, CRC16_DNPHEADERSIZE - 2);
+			for (nPos = CRC16_DNPHEADERSIZE; nPos < nFrameLen; nPos += nBlockLen + 2) {
+				nBlockLen = GetSmallerNum(nFrameLen - nPos - 2, CRC16_DNPBLOCKSIZE);
+				gnSink = CalculateCRC16(CRC_DNP, &aFrame[nPos], nBlockLen);
+			}
+		}
+
+		nBytes += 1000 * nFrameLen;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < CRCBENCH_SECONDS);
+	nOldRate = nBytes / nTime;
+	CRCBenchReport("CalculateCRC16 per block, full frames", nBytes, nTime, 0);
+
+	nBytes = 0;
+	nStart = HostTestSeconds();
+	do {
+		for (nCtr = 0; nCtr < 1000; nCtr++) {
+			gnSink = CRC16VerifyDNPFrame(&gDNPCtx, aFrame, nFrameLen, NULL);
+		}
+
+		nBytes += 1000 * nFrameLen;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < CRCBENCH_SECONDS);
+	CRCBenchReport("CRC16VerifyDNPFrame, full frames", nBytes, nTime, nOldRate);
+
+	return HostTestResult("CRC16Bench");
+}
+
+static void CRCBenchCheck(void) {
+	uint8_t aBuff[300], aFrame[512];
+	uint32_t nSeed, nCtr, nLen, nSplit, nFrameLen, nBadBlock;
+	crc16_t nPart;
+
+	//Every length and split must match the original calculation
+	nSeed = 7;
+	for (nCtr = 0; nCtr < 2000; nCtr++) {
+		nLen = HostTestRandRange(&nSeed, sizeof(aBuff));
+		HostTestRandom(&nSeed, aBuff, nLen);
+
+		HOSTCHECK(CalculateCRC16(CRC_DNP, aBuff, nLen) == CRC16ContextCalculate(&gDNPCtx, aBuff, nLen));
+		HOSTCHECK(CalculateCRC16(CRC_Modbus, aBuff, nLen) == CRC16ContextCalculate(&gModbusCtx, aBuff, nLen));
+
+		nSplit = nLen / 2;
+		nPart = CalculateCRC16(CRC_DNP, aBuff, nSplit);
+		HOSTCHECK(ContinueCalculateCRC16Buffer(CRC_DNP, &aBuff[nSplit], nLen - nSplit, nPart) == CRC16ContextContinue(&gDNPCtx, &aBuff[nSplit], nLen - nSplit, nPart));
+	}
+
+	//Frames of every user data length verify, and a flipped bit is found in its block
+	for (nLen = 0; nLen <= CRCBENCH_DNPUSERDATA; nLen++) {
+		HostTestRandom(&nSeed, aBuff, nLen);
+		nFrameLen = CRCBenchDNPFrame(aFrame, aBuff, nLen);
+
+		HOSTCHECK(CRC16VerifyDNPFrame(&gDNPCtx, aFrame, nFrameLen, &nBadBlock) == Success);
+		HOSTCHECK(CRC16VerifyDNPFrame(&gDNPCtx, aFrame, nFrameLen - 1, NULL) == Fail_BufferSize);
+
+		aFrame[3] ^= 0x10;
+		HOSTCHECK(CRC16VerifyDNPFrame(&gDNPCtx, aFrame, nFrameLen, &nBadBlock) == Fail_Invalid);
+		HOSTCHECK(nBadBlock == 0);
+		aFrame[3] ^= 0x10;
+
+		if (nLen > 0) {
+			nSplit = HostTestRandRange(&nSeed, nLen);
+			aFrame[CRC16_DNPHEADERSIZE + nSplit + ((nSplit / CRC16_DNPBLOCKSIZE) * 2)] ^= 0x01;
+			HOSTCHECK(CRC16VerifyDNPFrame(&gDNPCtx, aFrame, nFrameLen, &nBadBlock) == Fail_Invalid);
+			HOSTCHECK(nBadBlock == (nSplit / CRC16_DNPBLOCKSIZE) + 1);
+		}
+	}
+
+	HOSTCHECK(CRC16VerifyDNPFrame(&gModbusCtx, aFrame, nFrameLen, NULL) == Fail_Invalid);
+}
+
+static uint32_t CRCBenchDNPFrame(uint8_t *pFrame, const uint8_t *pUserData, uint32_t nUserLen) {
+	uint32_t nPos, nBlockLen;
+	crc16_t nCRC;
+
+	pFrame[0] = 0x05;
+	pFrame[1] = 0x64;
+	pFrame[2] = 5 + nUserLen;
+	pFrame[3] = 0xC4;
+	pFrame[4] = 0x01;
+	pFrame[5] = 0x00;
+	pFrame[6] = 0x02;
+	pFrame[7] = 0x00;
+
+	//CalculateCRC16 gives DNP CRCs in transmit order, most significant byte first
+	nCRC = CalculateCRC16(CRC_DNP, pFrame, 8);
+	pFrame[8] = nCRC >> 8;
+	pFrame[9] = nCRC & 0xFF;
+
+	nPos = CRC16_DNPHEADERSIZE;
+	while (nUserLen > 0) {
+		nBlockLen = GetSmallerNum(nUserLen, CRC16_DNPBLOCKSIZE);
+
+		memcpy(&pFrame[nPos], pUserData, nBlockLen);
+		nCRC = CalculateCRC16(CRC_DNP, &pFrame[nPos], nBlockLen);
+		pFrame[nPos + nBlockLen] = nCRC >> 8;
+		pFrame[nPos + nBlockLen + 1] = nCRC & 0xFF;
+
+		nPos += nBlockLen + 2;
+		pUserData += nBlockLen;
+		nUserLen -= nBlockLen;
+	}
+
+	return nPos;
+}
+
+static void CRCBenchReport(const char *pName, uint64_t nBytes, double nSeconds, double nBaseline) {
+	double nRate = nBytes / nSeconds;
+
+	if (nBaseline > 0) {
+		printf("  %-44s %8.1f MB/s  (%.1fx)\n", pName, nRate / 1e6, nRate / nBaseline);
+	} else {
+		printf("  %-44s %8.1f MB/s\n", pName, nRate / 1e6);
+	}
+}
@@ -0,0 +1,229 @@
+/**	File:	DNPMasterBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Loopback simulator for one master polling several outstations on a shared
+	line.  Everything the master writes is copied to the input of every
+	outstation, and all outstations write into the one pipe the master reads,
+	as on a multi-drop serial line.  Each outstation answers a class 0 poll
+	with enough points to need several link frames.  As soon as every
+	outstation has answered, all of them are asked again.  The polls per
+	second and the time taken for each of these poll cycles are reported for
+	a growing number of outstations, first one request on the line at a time and then with every
+	outstation asked at once.
+	It all runs in one thread so the figures are those of the DNP code alone.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "DNPMaster.h"
+	#include "DNPOutstation.h"
+	#include "Terminal.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds each benchmark runs for */
+	#define MASTBENCH_SECONDS		1
+
+	/**	@brief		Most outstations simulated on the line */
+	#define MASTBENCH_OUTSTATIONS	DNPMASTER_MAXSESSIONS
+
+	/**	@brief		DNP address of the master */
+	#define MASTBENCH_MASTADDR		1
+
+	/**	@brief		DNP address of the first outstation, the rest follow it */
+	#define MASTBENCH_OUTADDR		10
+
+	/**	@brief		Binary inputs each outstation reports */
+	#define MASTBENCH_BINARIES		64
+
+	/**	@brief		Analog inputs each outstation reports */
+	#define MASTBENCH_ANALOGS		64
+
+	/**	@brief		Bytes each pipe can hold, room for responses from all outstations */
+	#define MASTBENCH_PIPESIZE		(MASTBENCH_OUTSTATIONS * DNP_APPFRAGMENTMAX * 2)
+
+/*****	Definitions	*****/
+	/**	@brief		A simulated outstation and the session polling it */
+	typedef struct sMastBenchOut_t {
+		sDNPOutstation_t sOut;
+		sIOConnect_t sIO;
+		sIOConnect_t sFeedIO;						/**< Line end the master's bytes are written into */
+		sIOCnctPipe_t sInPipe;						/**< Pipe of bytes sent by the master */
+		uint8_t aInBuff[MASTBENCH_PIPESIZE];
+		uint8_t aPool[DNP_APPFRAGMENTMAX];
+		eDNPObjBinInFlags_t aBinary[MASTBENCH_BINARIES];
+		int32_t aAnalog[MASTBENCH_ANALOGS];
+		eDNPObjAnaInFlags_t aAnaFlags[MASTBENCH_ANALOGS];
+		sDNPSession_t *pSession;
+		uint32_t nResponses;						/**< Responses with all points in them */
+		bool bAnswered;								/**< Answered in the current poll cycle */
+	} sMastBenchOut_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static sMastBenchOut_t gaOuts[MASTBENCH_OUTSTATIONS];
+
+	/**	@brief		Outstations currently attached to the line */
+	static uint32_t gnOutCount;
+
+	/**	@brief		Outstations yet to answer in the current poll cycle */
+	static uint32_t gnCycleLeft;
+
+	/**	@brief		Poll cycles completed */
+	static uint32_t gnCycles;
+
+	/**	@brief		Pipe all outstations write to and the master reads */
+	static sIOCnctPipe_t gMasterPipe;
+
+	static uint8_t gaMasterBuff[MASTBENCH_PIPESIZE];
+
+	static sTimeIface_t gTime;
+
+/*****	Prototypes 	*****/
+	static uint32_t MastBenchTicks(void);
+
+	/**	@brief		Send the bytes written by the master to every outstation on the line */
+	static eReturn_t MastBenchBroadcast(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
+
+	static void MastBenchResponse(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag);
+
+	/**	@brief		Poll the outstations for the benchmark time and report the rates */
+	static void MastBenchRun(uint32_t nOutCount, uint8_t nMaxOutstanding);
+
+/*****	Functions	*****/
+int main(void) {
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	memset(&gTime, 0, sizeof(sTimeIface_t));
+	gTime.pfGetTicks = &MastBenchTicks;
+
+	printf("  %u binaries and %u analogs per outstation\n", MASTBENCH_BINARIES, MASTBENCH_ANALOGS);
+
+	MastBenchRun(1, 1);
+	MastBenchRun(4, 1);
+	MastBenchRun(MASTBENCH_OUTSTATIONS, 1);
+	MastBenchRun(4, 4);
+	MastBenchRun(MASTBENCH_OUTSTATIONS, MASTBENCH_OUTSTATIONS);
+
+	return HostTestResult("DNPMasterBench");
+}
+
+static uint32_t MastBenchTicks(void) {
+	return (uint32_t)(HostTestSeconds() * 1000);
+}
+
+static eReturn_t MastBenchBroadcast(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	uint32_t nCtr;
+	eReturn_t eResult;
+
+	for (nCtr = 0; nCtr < gnOutCount; nCtr++) {
+		eResult = gaOuts[nCtr].sFeedIO.pfWriteData(&(gaOuts[nCtr].sFeedIO), pnData, nDataLen);
+		if (eResult != Success) {
+			return eResult;
+		}
+	}
+
+	return Success;
+}
+
+static void MastBenchResponse(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag) {
+	sMastBenchOut_t *pOut = (sMastBenchOut_t *)pSession->pParam;
+	uint32_t nPoints = 0, nCtr;
+
+	while (DNPParserFragmentNextObject(pFrag) == Success) {
+		nPoints += pFrag->sDataObj.nAddressEnd - pFrag->sDataObj.nAddressStart + 1;
+	}
+
+	if (nPoints == MASTBENCH_BINARIES + MASTBENCH_ANALOGS) {
+		pOut->nResponses += 1;
+
+		if (pOut->bAnswered == false) {
+			pOut->bAnswered = true;
+			gnCycleLeft -= 1;
+		}
+	}
+
+	if (gnCycleLeft != 0) {
+		return;
+	}
+
+	//Everyone answered, start the next cycle right away to keep the line loaded
+	gnCycles += 1;
+	gnCycleLeft = gnOutCount;
+	for (nCtr = 0; nCtr < gnOutCount; nCtr++) {
+		gaOuts[nCtr].bAnswered = false;
+		DNPMasterRequestPoll(gaOuts[nCtr].pSession, DNPPoll_Class0);
+	}
+
+	return;
+}
+
+static void MastBenchRun(uint32_t nOutCount, uint8_t nMaxOutstanding) {
+	sDNPMaster_t sMaster;
+	sIOConnect_t sMasterIO;
+	uint32_t nCtr, nResponses = 0, nTimeouts = 0, nFailures = 0;
+	double nStart, nTime;
+	char aName[32];
+
+	//Master reads the shared pipe, its writes go to every outstation
+	IOCnctPipeInitialize(&gMasterPipe, gaMasterBuff, sizeof(gaMasterBuff));
+	IOCnctCreateFromPipes(&gMasterPipe, &gMasterPipe, &sMasterIO);
+	sMasterIO.pfWriteData = &MastBenchBroadcast;
+
+	DNPMasterInitialize(&sMaster, &sMasterIO, &gTime, MASTBENCH_MASTADDR, nMaxOutstanding, 500, &MastBenchResponse);
+
+	gnOutCount = nOutCount;
+	gnCycleLeft = nOutCount;
+	gnCycles = 0;
+	for (nCtr = 0; nCtr < nOutCount; nCtr++) {
+		memset(&(gaOuts[nCtr]), 0, sizeof(sMastBenchOut_t));
+
+		IOCnctPipeInitialize(&(gaOuts[nCtr].sInPipe), gaOuts[nCtr].aInBuff, sizeof(gaOuts[nCtr].aInBuff));
+		IOCnctCreateFromPipes(&(gaOuts[nCtr].sInPipe), &gMasterPipe, &(gaOuts[nCtr].sIO));
+		IOCnctCreateFromPipes(&gMasterPipe, &(gaOuts[nCtr].sInPipe), &(gaOuts[nCtr].sFeedIO));
+
+		DNPOutstationInitialize(&(gaOuts[nCtr].sOut), &(gaOuts[nCtr].sIO), &gTime, MASTBENCH_OUTADDR + nCtr, MASTBENCH_MASTADDR, gaOuts[nCtr].aBinary, MASTBENCH_BINARIES, gaOuts[nCtr].aAnalog, gaOuts[nCtr].aAnaFlags, MASTBENCH_ANALOGS, 500);
+
+		DNPMasterAddSession(&sMaster, MASTBENCH_OUTADDR + nCtr, gaOuts[nCtr].aPool, sizeof(gaOuts[nCtr].aPool), &(gaOuts[nCtr].pSession));
+		gaOuts[nCtr].pSession->pParam = &(gaOuts[nCtr]);
+
+		//Long period, the response handler asks for each cycle after the first
+		DNPMasterSetPollPeriod(&sMaster, gaOuts[nCtr].pSession, DNPPoll_Class0, 1000000);
+	}
+
+	nStart = HostTestSeconds();
+	do {
+		if (DNPMasterProcess(&sMaster) != Success) {
+			nFailures += 1;
+		}
+
+		for (nCtr = 0; nCtr < nOutCount; nCtr++) {
+			if (DNPOutstationProcess(&(gaOuts[nCtr].sOut)) != Success) {
+				nFailures += 1;
+			}
+		}
+
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < MASTBENCH_SECONDS);
+
+	for (nCtr = 0; nCtr < nOutCount; nCtr++) {
+		nResponses += gaOuts[nCtr].nResponses;
+		nTimeouts += gaOuts[nCtr].pSession->nTimeouts;
+	}
+
+	snprintf(aName, sizeof(aName), "%u out, %u at once", nOutCount, nMaxOutstanding);
+	printf("  %-18s %8.0f polls/s  %8.3f ms cycle  (%u timeouts, %u channel failures)\n", aName, nResponses / nTime, (gnCycles != 0) ? (nTime * 1000) / gnCycles : 0.0, nTimeouts, nFailures);
+
+	//Every outstation must be polled and answer every time
+	HOSTCHECK(gnCycles > 0);
+	HOSTCHECK(nTimeouts == 0);
+	HOSTCHECK(nFailures == 0);
+
+	return;
+}
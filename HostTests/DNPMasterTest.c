@@ -0,0 +1,340 @@
+/**	File:	DNPMasterTest.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Sends responses larger than the message buffer could hold to a DNP master,
+	split into many transport segments and read from the channel in pieces of
+	random size.  Each response is walked with the fragment parser to make sure
+	every point arrived.  Segments that are lost, repeated, interleaved between
+	outstations, or too large for a session pool are checked as well, as is a
+	response sent in several application fragments.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "DNPMaster.h"
+	#include "DNPMessageParser.h"
+
+	#include "HostTest.h"
+	#include "DNPTestFrames.h"
+
+/*****	Defines		*****/
+	/**	@brief		DNP address of the master */
+	#define MASTERTEST_MASTERADDR	1
+
+	/**	@brief		Analog points in a large response, over 1500 bytes of data */
+	#define MASTERTEST_BIGPOINTS	500
+
+	/**	@brief		Bytes the channel can hold waiting for the master to read */
+	#define MASTERTEST_STREAMSIZE	8192
+
+	/**	@brief		Analog points in each fragment of a multi-fragment response */
+	#define MASTERTEST_FRAGPOINTS	100
+
+	/**	@brief		Bytes of reassembly pool the small session is given */
+	#define MASTERTEST_SMALLPOOL	300
+
+/*****	Definitions	*****/
+	/**	@brief		Outstations the master polls in the test */
+	typedef enum eMasterTestOut_t {
+		MasterTest_OutA		= 10,
+		MasterTest_OutB		= 11,
+		MasterTest_OutSmall	= 12,
+	} eMasterTestOut_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	/**	@brief		Bytes waiting for the master to read */
+	static uint8_t gaStream[MASTERTEST_STREAMSIZE];
+
+	static uint32_t gnStreamLen;
+
+	static uint32_t gnStreamPos;
+
+	static uint32_t gnSeed = 11;
+
+	/**	@brief		Requests and confirmations the master has written */
+	static uint32_t gnWrites;
+
+	static uint32_t gnTicks;
+
+	/**	@brief		Counts taken by the response handler */
+	static uint32_t gnResponses;
+
+	static uint32_t gnPoints;
+
+	static uint32_t gnBadPoints;
+
+	static uint16_t gnLastSource;
+
+	static uint8_t gaPoolA[DNP_APPFRAGMENTMAX];
+
+	static uint8_t gaPoolB[DNP_APPFRAGMENTMAX];
+
+	static uint8_t gaPoolSmall[MASTERTEST_SMALLPOOL];
+
+	static sDNPMaster_t gMaster;
+
+/*****	Prototypes 	*****/
+	static eReturn_t MasterTestRead(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize);
+
+	static eReturn_t MasterTestWrite(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen);
+
+	static uint32_t MasterTestTicks(void);
+
+	static void MasterTestResponse(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag);
+
+	/**	@brief		Build the application data of a response holding analog points
+	 *	@param		pApp		Buffer to write the response to
+	 *	@param		nAppHdr		Application header byte
+	 *	@param		eCode		Response or unsolicited function code
+	 *	@param		nPoints		Number of group 30 variation 2 points to include
+	 *	@return		Number of bytes in the response
+	 */
+	static uint32_t MasterTestBuildResponse(uint8_t *pApp, uint8_t nAppHdr, eDNPControlCodes_t eCode, uint32_t nPoints);
+
+	/**	@brief		Have the master read everything waiting in the channel */
+	static void MasterTestDeliver(void);
+
+/*****	Functions	*****/
+int main(void) {
+	uint8_t aApp[DNP_APPFRAGMENTMAX], aStreamA[MASTERTEST_STREAMSIZE], aStreamB[MASTERTEST_STREAMSIZE];
+	uint32_t aOffsetsA[16], aOffsetsB[16], nLen, nLenA, nLenB, nCtr, nFrames;
+	uint32_t nWrites;
+	uint8_t nSeqA = 0, nSeqB = 0, nSeqSmall = 0, nAppSeq;
+	sIOConnect_t sChannel;
+	sTimeIface_t sTime;
+	sDNPSession_t *pOutA, *pOutB, *pOutSmall;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	memset(&sChannel, 0, sizeof(sIOConnect_t));
+	sChannel.pfReadData = &MasterTestRead;
+	sChannel.pfWriteData = &MasterTestWrite;
+
+	memset(&sTime, 0, sizeof(sTimeIface_t));
+	sTime.pfGetTicks = &MasterTestTicks;
+
+	HOSTCHECK(DNPMasterInitialize(&gMaster, &sChannel, &sTime, MASTERTEST_MASTERADDR, 3, 100000, &MasterTestResponse) == Success);
+	HOSTCHECK(DNPMasterAddSession(&gMaster, MasterTest_OutA, gaPoolA, sizeof(gaPoolA), &pOutA) == Success);
+	HOSTCHECK(DNPMasterAddSession(&gMaster, MasterTest_OutB, gaPoolB, sizeof(gaPoolB), &pOutB) == Success);
+	HOSTCHECK(DNPMasterAddSession(&gMaster, MasterTest_OutSmall, gaPoolSmall, sizeof(gaPoolSmall), &pOutSmall) == Success);
+	HOSTCHECK(DNPMasterAddSession(&gMaster, 13, NULL, 0, NULL) == Fail_Invalid);
+
+	//Each session sends its static data poll
+	DNPMasterSetPollPeriod(&gMaster, pOutA, DNPPoll_Class0, 1000000);
+	DNPMasterSetPollPeriod(&gMaster, pOutB, DNPPoll_Class0, 1000000);
+	DNPMasterSetPollPeriod(&gMaster, pOutSmall, DNPPoll_Class0, 1000000);
+	MasterTestDeliver();
+	HOSTCHECK(gnWrites == 3);
+	HOSTCHECK((pOutA->bAwaiting == true) && (pOutB->bAwaiting == true) && (pOutSmall->bAwaiting == true));
+
+	//A response in seven segments asking for confirmation
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | DNPAppHdr_ConfirmExpect | pOutA->nOutstandingSeq, DNPCtrl_Response, MASTERTEST_BIGPOINTS);
+	HOSTCHECK(nLen > DNP_USERDATAMAX);
+	gnStreamLen = DNPTestSegmentFragment(gaStream, MASTERTEST_MASTERADDR, MasterTest_OutA, &nSeqA, aApp, nLen, NULL);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 1);
+	HOSTCHECK(gnLastSource == MasterTest_OutA);
+	HOSTCHECK(gnPoints == MASTERTEST_BIGPOINTS);
+	HOSTCHECK(gnBadPoints == 0);
+	HOSTCHECK(pOutA->bAwaiting == false);
+	HOSTCHECK(pOutA->nResponses == 1);
+	HOSTCHECK(gnWrites == 4); //Confirmation was sent
+
+	//A lost segment drops the response
+	gnResponses = 0;
+	gnPoints = 0;
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | pOutB->nOutstandingSeq, DNPCtrl_Response, MASTERTEST_BIGPOINTS);
+	nLenB = DNPTestSegmentFragment(aStreamB, MASTERTEST_MASTERADDR, MasterTest_OutB, &nSeqB, aApp, nLen, aOffsetsB);
+	memcpy(gaStream, aStreamB, aOffsetsB[2]);
+	memcpy(&(gaStream[aOffsetsB[2]]), &(aStreamB[aOffsetsB[3]]), nLenB - aOffsetsB[3]);
+	gnStreamLen = nLenB - (aOffsetsB[3] - aOffsetsB[2]);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 0);
+	HOSTCHECK(pOutB->sAssembler.nDropped == 1);
+	HOSTCHECK(pOutB->bAwaiting == true);
+
+	//A repeated segment drops the response
+	nLenB = DNPTestSegmentFragment(aStreamB, MASTERTEST_MASTERADDR, MasterTest_OutB, &nSeqB, aApp, nLen, aOffsetsB);
+	memcpy(gaStream, aStreamB, aOffsetsB[2]);
+	memcpy(&(gaStream[aOffsetsB[2]]), &(aStreamB[aOffsetsB[1]]), nLenB - aOffsetsB[1]);
+	gnStreamLen = nLenB + (aOffsetsB[2] - aOffsetsB[1]);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 0);
+	HOSTCHECK(pOutB->sAssembler.nDropped == 2);
+
+	//Sent again whole it is delivered
+	gnStreamLen = DNPTestSegmentFragment(gaStream, MASTERTEST_MASTERADDR, MasterTest_OutB, &nSeqB, aApp, nLen, NULL);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 1);
+	HOSTCHECK(gnPoints == MASTERTEST_BIGPOINTS);
+	HOSTCHECK(pOutB->bAwaiting == false);
+
+	//Unsolicited responses from two outstations with their segments interleaved
+	gnResponses = 0;
+	gnPoints = 0;
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | DNPAppHdr_Unsolicited | 3, DNPCtrl_Unsolicited, MASTERTEST_BIGPOINTS);
+	nLenA = DNPTestSegmentFragment(aStreamA, MASTERTEST_MASTERADDR, MasterTest_OutA, &nSeqA, aApp, nLen, aOffsetsA);
+	nLenB = DNPTestSegmentFragment(aStreamB, MASTERTEST_MASTERADDR, MasterTest_OutB, &nSeqB, aApp, nLen, aOffsetsB);
+	nFrames = (nLen + DNPTEST_SEGMENTMAX - 1) / DNPTEST_SEGMENTMAX;
+	aOffsetsA[nFrames] = nLenA;
+	aOffsetsB[nFrames] = nLenB;
+
+	gnStreamLen = 0;
+	for (nCtr = 0; nCtr < nFrames; nCtr++) {
+		memcpy(&(gaStream[gnStreamLen]), &(aStreamA[aOffsetsA[nCtr]]), aOffsetsA[nCtr + 1] - aOffsetsA[nCtr]);
+		gnStreamLen += aOffsetsA[nCtr + 1] - aOffsetsA[nCtr];
+		memcpy(&(gaStream[gnStreamLen]), &(aStreamB[aOffsetsB[nCtr]]), aOffsetsB[nCtr + 1] - aOffsetsB[nCtr]);
+		gnStreamLen += aOffsetsB[nCtr + 1] - aOffsetsB[nCtr];
+	}
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 2);
+	HOSTCHECK(gnPoints == 2 * MASTERTEST_BIGPOINTS);
+	HOSTCHECK(gnBadPoints == 0);
+
+	//Response too large for the session pool is dropped, one that fits is delivered
+	gnResponses = 0;
+	gnPoints = 0;
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | pOutSmall->nOutstandingSeq, DNPCtrl_Response, MASTERTEST_BIGPOINTS);
+	gnStreamLen = DNPTestSegmentFragment(gaStream, MASTERTEST_MASTERADDR, MasterTest_OutSmall, &nSeqSmall, aApp, nLen, NULL);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 0);
+	HOSTCHECK(pOutSmall->sAssembler.nDropped == 1);
+
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_FirstMsg | DNPAppHdr_LastMsg | pOutSmall->nOutstandingSeq, DNPCtrl_Response, 90);
+	HOSTCHECK(nLen <= MASTERTEST_SMALLPOOL);
+	gnStreamLen = DNPTestSegmentFragment(gaStream, MASTERTEST_MASTERADDR, MasterTest_OutSmall, &nSeqSmall, aApp, nLen, NULL);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 1);
+	HOSTCHECK(gnPoints == 90);
+	HOSTCHECK(pOutSmall->bAwaiting == false);
+
+	//A response in three application fragments, each with the next sequence
+	gnResponses = 0;
+	gnPoints = 0;
+	nWrites = gnWrites;
+	DNPMasterRequestPoll(pOutA, DNPPoll_Class0);
+	MasterTestDeliver();
+	HOSTCHECK(gnWrites == nWrites + 1);
+	HOSTCHECK(pOutA->bAwaiting == true);
+
+	nAppSeq = pOutA->nOutstandingSeq;
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_FirstMsg | nAppSeq, DNPCtrl_Response, MASTERTEST_FRAGPOINTS);
+	gnStreamLen = DNPTestSegmentFragment(gaStream, MASTERTEST_MASTERADDR, MasterTest_OutA, &nSeqA, aApp, nLen, NULL);
+	nLen = MasterTestBuildResponse(aApp, (nAppSeq + 1) & DNPAppHdr_SequenceMask, DNPCtrl_Response, MASTERTEST_FRAGPOINTS);
+	gnStreamLen += DNPTestSegmentFragment(&(gaStream[gnStreamLen]), MASTERTEST_MASTERADDR, MasterTest_OutA, &nSeqA, aApp, nLen, NULL);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 2);
+	HOSTCHECK(pOutA->bAwaiting == true); //Still waiting for the final fragment
+
+	nLen = MasterTestBuildResponse(aApp, DNPAppHdr_LastMsg | ((nAppSeq + 2) & DNPAppHdr_SequenceMask), DNPCtrl_Response, MASTERTEST_FRAGPOINTS);
+	gnStreamLen = DNPTestSegmentFragment(gaStream, MASTERTEST_MASTERADDR, MasterTest_OutA, &nSeqA, aApp, nLen, NULL);
+	MasterTestDeliver();
+
+	HOSTCHECK(gnResponses == 3);
+	HOSTCHECK(gnPoints == 3 * MASTERTEST_FRAGPOINTS);
+	HOSTCHECK(gnBadPoints == 0);
+	HOSTCHECK(pOutA->nResponses == 4);
+	HOSTCHECK(pOutA->bAwaiting == false);
+	HOSTCHECK(pOutA->nTimeouts == 0);
+
+	return HostTestResult("DNPMasterTest");
+}
+
+static eReturn_t MasterTestRead(sIOConnect_t *pIOObj, uint8_t *pnDataBuff, uint32_t nBuffSize, uint32_t *pnReadSize) {
+	uint32_t nRead = GetSmallerNum(nBuffSize, gnStreamLen - gnStreamPos);
+
+	//Channels hand over whatever has arrived, which rarely lines up with frames
+	if (nRead > 0) {
+		nRead = 1 + HostTestRandRange(&gnSeed, nRead);
+	}
+
+	memcpy(pnDataBuff, &(gaStream[gnStreamPos]), nRead);
+	gnStreamPos += nRead;
+	*pnReadSize = nRead;
+
+	return Success;
+}
+
+static eReturn_t MasterTestWrite(sIOConnect_t *pIOObj, uint8_t *pnData, uint32_t nDataLen) {
+	gnWrites += 1;
+
+	return Success;
+}
+
+static uint32_t MasterTestTicks(void) {
+	return gnTicks;
+}
+
+static void MasterTestResponse(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag) {
+	sDNPDataValue_t sValue;
+
+	gnResponses += 1;
+	gnLastSource = pFrag->nSourceAddr;
+
+	while (DNPParserFragmentNextObject(pFrag) == Success) {
+		if ((pFrag->sDataObj.eGroup != DNPGrp_AnalogInput) || (pFrag->sDataObj.nVariation != 2)) {
+			gnBadPoints += 1;
+			continue;
+		}
+
+		while (DNPParserFragmentNextValue(pFrag, &sValue) == Success) {
+			if (sValue.Data.Analog.nValue != (int32_t)(sValue.nAddress * 7)) {
+				gnBadPoints += 1;
+			}
+
+			gnPoints += 1;
+		}
+	}
+
+	return;
+}
+
+static uint32_t MasterTestBuildResponse(uint8_t *pApp, uint8_t nAppHdr, eDNPControlCodes_t eCode, uint32_t nPoints) {
+	uint32_t nLen = 0, nCtr;
+
+	pApp[nLen++] = nAppHdr;
+	pApp[nLen++] = eCode;
+	pApp[nLen++] = 0x00; //No internal indications
+	pApp[nLen++] = 0x00;
+
+	pApp[nLen++] = DNPGrp_AnalogInput;
+	pApp[nLen++] = 2; //16 bit value with flags
+	pApp[nLen++] = DNPQual_CodeCountStopAndStart2Bytes;
+	pApp[nLen++] = 0;
+	pApp[nLen++] = 0;
+	pApp[nLen++] = (nPoints - 1) & 0xFF;
+	pApp[nLen++] = (nPoints - 1) >> 8;
+
+	for (nCtr = 0; nCtr < nPoints; nCtr++) {
+		pApp[nLen++] = DNPAnaInFlag_Online;
+		pApp[nLen++] = (nCtr * 7) & 0xFF;
+		pApp[nLen++] = (nCtr * 7) >> 8;
+	}
+
+	return nLen;
+}
+
+static void MasterTestDeliver(void) {
+	gnStreamPos = 0;
+
+	do {
+		gnTicks += 1;
+		HOSTCHECK(DNPMasterProcess(&gMaster) == Success);
+	} while (gnStreamPos < gnStreamLen);
+
+	gnStreamLen = 0;
+}
@@ -0,0 +1,266 @@
+/**	File:	DNPNetBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Load generator for the DNP network channel.  Masters and outstations are
+	joined over loopback, first with several TCP connections to one listening
+	outstation channel and then with a UDP pair.  Each master asks for the
+	static data again as soon as a response arrives, so the channel is never
+	idle, and the completed requests per second are reported.
+	Every master and outstation runs in its own thread as they would in
+	separate programs.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "DNPMaster.h"
+	#include "DNPOutstation.h"
+	#include "DNPNetChannel.h"
+	#include "Network_RaspberryPi.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds each benchmark runs for */
+	#define NETBENCH_SECONDS		2
+
+	/**	@brief		TCP port the outstation listens on */
+	#define NETBENCH_TCPPORT		20100
+
+	/**	@brief		UDP port the outstation receives on */
+	#define NETBENCH_UDPOUTPORT		20101
+
+	/**	@brief		UDP port the master receives on */
+	#define NETBENCH_UDPMASTPORT	20102
+
+	/**	@brief		Masters connected over TCP at once */
+	#define NETBENCH_TCPASSOCS		DNPNET_MAXCONNS
+
+	/**	@brief		DNP address of the outstations */
+	#define NETBENCH_OUTADDR		10
+
+	/**	@brief		Binary inputs each outstation reports */
+	#define NETBENCH_BINARIES		32
+
+	/**	@brief		Analog inputs each outstation reports */
+	#define NETBENCH_ANALOGS		8
+
+	/**	@brief		Milliseconds a channel read waits for data */
+	#define NETBENCH_RECVTIMEOUT	1
+
+/*****	Definitions	*****/
+	/**	@brief		A master and the outstation association it polls */
+	typedef struct sNetBenchAssoc_t {
+		sDNPMaster_t sMaster;
+		sDNPOutstation_t sOut;
+		uint8_t aPool[DNP_APPFRAGMENTMAX];
+		eDNPObjBinInFlags_t aBinary[NETBENCH_BINARIES];
+		int32_t aAnalog[NETBENCH_ANALOGS];
+		eDNPObjAnaInFlags_t aAnaFlags[NETBENCH_ANALOGS];
+		sDNPSession_t *pSession;
+		uint32_t nResponses;						/**< Responses with all points in them */
+		uint32_t nFailures;							/**< Channel failures seen by either end */
+		pthread_t hMaster;
+		pthread_t hOut;
+	} sNetBenchAssoc_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static sNetBenchAssoc_t gaAssocs[NETBENCH_TCPASSOCS];
+
+	static sTimeIface_t gTime;
+
+	/**	@brief		Cleared to have all threads finish */
+	static volatile bool gbRunning;
+
+/*****	Prototypes 	*****/
+	static uint32_t NetBenchTicks(void);
+
+	static void NetBenchResponse(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag);
+
+	/**	@brief		Prepare the master and outstation of an association on their channels */
+	static void NetBenchAssocSetup(sNetBenchAssoc_t *pAssoc, uint16_t nMasterAddr, sIOConnect_t *pMasterIO, sIOConnect_t *pOutIO);
+
+	static void *NetBenchMasterThread(void *pParam);
+
+	static void *NetBenchOutThread(void *pParam);
+
+	/**	@brief		Run the associations for the benchmark time and report the request rate */
+	static void NetBenchRun(const char *pName, sNetBenchAssoc_t *pAssocs, uint32_t nCount);
+
+/*****	Functions	*****/
+int main(void) {
+	sTCPServ_t sTCPServ;
+	sTCPClient_t aTCPClients[NETBENCH_TCPASSOCS];
+	sUDPServ_t sUDPOut, sUDPMaster;
+	sDNPNetChannel_t sOutChan, sMasterChan;
+	sConnInfo_t sOutAddr, sMasterAddr;
+	sIOConnect_t *pMasterIO, *pOutIO;
+	uint32_t nCtr;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	memset(&gTime, 0, sizeof(sTimeIface_t));
+	gTime.pfGetTicks = &NetBenchTicks;
+
+	//Several masters connect over TCP to one listening outstation channel
+	RasPiTCPServInitialize(&sTCPServ);
+	DNPNetChannelInitialize(&sOutChan, NETBENCH_RECVTIMEOUT);
+	DNPNetChannelInitialize(&sMasterChan, NETBENCH_RECVTIMEOUT);
+
+	sOutAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sOutAddr.Port = NETBENCH_TCPPORT;
+	HOSTCHECK(DNPNetChannelListenTCP(&sOutChan, &sTCPServ, &sOutAddr) == Success);
+
+	for (nCtr = 0; nCtr < NETBENCH_TCPASSOCS; nCtr++) {
+		RasPiTCPClientInitialize(&(aTCPClients[nCtr]));
+
+		if ((HOSTCHECK(DNPNetChannelConnectTCP(&sMasterChan, &(aTCPClients[nCtr]), &sOutAddr, &pMasterIO) == Success) == false) ||
+			(HOSTCHECK(DNPNetChannelAcceptTCP(&sOutChan, &pOutIO) == Success) == false)) {
+			return HostTestResult("DNPNetBench");
+		}
+
+		NetBenchAssocSetup(&(gaAssocs[nCtr]), 1 + nCtr, pMasterIO, pOutIO);
+	}
+
+	NetBenchRun("TCP, 1 master", gaAssocs, 1);
+	NetBenchRun("TCP, 4 masters", gaAssocs, NETBENCH_TCPASSOCS);
+
+	for (nCtr = 0; nCtr < NETBENCH_TCPASSOCS; nCtr++) {
+		DNPNetChannelClose(gaAssocs[nCtr].sMaster.pChannel);
+		DNPNetChannelClose(gaAssocs[nCtr].sOut.pChannel);
+	}
+
+	sTCPServ.pfCloseHost(&sTCPServ);
+
+	//UDP answers a single master
+	RasPiUDPServInitialize(&sUDPOut);
+	RasPiUDPServInitialize(&sUDPMaster);
+	DNPNetChannelInitialize(&sOutChan, NETBENCH_RECVTIMEOUT);
+	DNPNetChannelInitialize(&sMasterChan, NETBENCH_RECVTIMEOUT);
+
+	sOutAddr.Port = NETBENCH_UDPOUTPORT;
+	sMasterAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sMasterAddr.Port = NETBENCH_UDPMASTPORT;
+
+	HOSTCHECK(DNPNetChannelOpenUDP(&sOutChan, &sUDPOut, &sOutAddr, NULL, &pOutIO) == Success);
+	HOSTCHECK(DNPNetChannelOpenUDP(&sMasterChan, &sUDPMaster, &sMasterAddr, &sOutAddr, &pMasterIO) == Success);
+
+	NetBenchAssocSetup(&(gaAssocs[0]), 1, pMasterIO, pOutIO);
+	NetBenchRun("UDP, 1 master", gaAssocs, 1);
+
+	DNPNetChannelClose(pMasterIO);
+	DNPNetChannelClose(pOutIO);
+
+	return HostTestResult("DNPNetBench");
+}
+
+static uint32_t NetBenchTicks(void) {
+	return (uint32_t)(HostTestSeconds() * 1000);
+}
+
+static void NetBenchResponse(sDNPMaster_t *pMaster, sDNPSession_t *pSession, sDNPAppFragment_t *pFrag) {
+	sNetBenchAssoc_t *pAssoc = (sNetBenchAssoc_t *)pSession->pParam;
+	uint32_t nPoints = 0;
+
+	while (DNPParserFragmentNextObject(pFrag) == Success) {
+		nPoints += pFrag->sDataObj.nAddressEnd - pFrag->sDataObj.nAddressStart + 1;
+	}
+
+	if (nPoints == NETBENCH_BINARIES + NETBENCH_ANALOGS) {
+		pAssoc->nResponses += 1;
+	}
+
+	//Ask again right away to keep the channel loaded
+	DNPMasterRequestPoll(pSession, DNPPoll_Class0);
+
+	return;
+}
+
+static void NetBenchAssocSetup(sNetBenchAssoc_t *pAssoc, uint16_t nMasterAddr, sIOConnect_t *pMasterIO, sIOConnect_t *pOutIO) {
+	DNPMasterInitialize(&(pAssoc->sMaster), pMasterIO, &gTime, nMasterAddr, 1, 500, &NetBenchResponse);
+	DNPMasterAddSession(&(pAssoc->sMaster), NETBENCH_OUTADDR, pAssoc->aPool, sizeof(pAssoc->aPool), &(pAssoc->pSession));
+	pAssoc->pSession->pParam = pAssoc;
+
+	DNPOutstationInitialize(&(pAssoc->sOut), pOutIO, &gTime, NETBENCH_OUTADDR, nMasterAddr, pAssoc->aBinary, NETBENCH_BINARIES, pAssoc->aAnalog, pAssoc->aAnaFlags, NETBENCH_ANALOGS, 500);
+
+	return;
+}
+
+static void *NetBenchMasterThread(void *pParam) {
+	sNetBenchAssoc_t *pAssoc = (sNetBenchAssoc_t *)pParam;
+
+	//Long period, the response handler asks for each poll after the first
+	DNPMasterSetPollPeriod(&(pAssoc->sMaster), pAssoc->pSession, DNPPoll_Class0, 1000000);
+
+	while (gbRunning == true) {
+		if (DNPMasterProcess(&(pAssoc->sMaster)) != Success) {
+			pAssoc->nFailures += 1;
+		}
+	}
+
+	return NULL;
+}
+
+static void *NetBenchOutThread(void *pParam) {
+	sNetBenchAssoc_t *pAssoc = (sNetBenchAssoc_t *)pParam;
+
+	while (gbRunning == true) {
+		if (DNPOutstationProcess(&(pAssoc->sOut)) != Success) {
+			pAssoc->nFailures += 1;
+		}
+	}
+
+	return NULL;
+}
+
+static void NetBenchRun(const char *pName, sNetBenchAssoc_t *pAssocs, uint32_t nCount) {
+	uint32_t nCtr, nResponses = 0, nTimeouts = 0, nFailures = 0;
+	double nStart, nTime;
+
+	for (nCtr = 0; nCtr < nCount; nCtr++) {
+		pAssocs[nCtr].nResponses = 0;
+		pAssocs[nCtr].nFailures = 0;
+		pAssocs[nCtr].pSession->nTimeouts = 0;
+	}
+
+	gbRunning = true;
+	nStart = HostTestSeconds();
+
+	for (nCtr = 0; nCtr < nCount; nCtr++) {
+		pthread_create(&(pAssocs[nCtr].hOut), NULL, &NetBenchOutThread, &(pAssocs[nCtr]));
+		pthread_create(&(pAssocs[nCtr].hMaster), NULL, &NetBenchMasterThread, &(pAssocs[nCtr]));
+	}
+
+	sleep(NETBENCH_SECONDS);
+	gbRunning = false;
+
+	for (nCtr = 0; nCtr < nCount; nCtr++) {
+		pthread_join(pAssocs[nCtr].hMaster, NULL);
+		pthread_join(pAssocs[nCtr].hOut, NULL);
+
+		nResponses += pAssocs[nCtr].nResponses;
+		nTimeouts += pAssocs[nCtr].pSession->nTimeouts;
+		nFailures += pAssocs[nCtr].nFailures;
+	}
+
+	nTime = HostTestSeconds() - nStart;
+
+	printf("  %-16s %8.0f requests/s  (%u timeouts, %u channel failures)\n", pName, nResponses / nTime, nTimeouts, nFailures);
+
+	//Every association must have been served the whole time
+	for (nCtr = 0; nCtr < nCount; nCtr++) {
+		HOSTCHECK(pAssocs[nCtr].nResponses > 0);
+	}
+
+	HOSTCHECK(nFailures == 0);
+
+	return;
+}
@@ -0,0 +1,247 @@
+/**	File:	DNPParserBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Measures the DNP message builder and parser in frames and bytes per
+	second.  Each is run on a class poll, a response that fits one link frame,
+	and a response spread over several.  Parsing is measured with the whole
+	stream in one read, in 64 byte reads as a socket or UART driver would hand
+	them over, and with every point of each response decoded.  Run before and
+	after a change to the parser to see what it bought.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "DNPMessageBuilder.h"
+	#include "DNPMessageParser.h"
+
+	#include "HostTest.h"
+	#include "DNPTestFrames.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds each benchmark runs for */
+	#define PARSERBENCH_SECONDS		1.0
+
+	/**	@brief		Bytes of back to back messages parsed in each pass */
+	#define PARSERBENCH_STREAMSIZE	65536
+
+	/**	@brief		Bytes in each read when parsing in pieces */
+	#define PARSERBENCH_READSIZE	64
+
+/*****	Definitions	*****/
+	/**	@brief		Message measured by the benchmarks */
+	typedef struct sParserBenchMsg_t {
+		const char *pName;
+		uint32_t nBinaries;		/**< Binary inputs in the response, none with no analogs makes a poll */
+		uint32_t nAnalogs;		/**< Analog inputs in the response */
+	} sParserBenchMsg_t;
+
+/*****	Constants	*****/
+	static const sParserBenchMsg_t gaBenchMsgs[] = {
+		{ "class poll", 0, 0 },
+		{ "response, 1 frame", 16, 16 },
+		{ "response, 3 frames", 100, 100 },
+	};
+
+/*****	Globals		*****/
+	static sDNPMsgBuffer_t gMsg;
+
+	static sDNPTestPoints_t gPoints;
+
+	static uint8_t gaStream[PARSERBENCH_STREAMSIZE];
+
+	/**	@brief		Points decoded by the last parse */
+	static uint32_t gnPoints;
+
+	/**	@brief		Keeps the results in use so the benchmarks are not optimized away */
+	static volatile uint32_t gnSink;
+
+/*****	Prototypes 	*****/
+	/**	@brief		Build one of the benchmark messages into gMsg */
+	static eReturn_t ParserBenchBuild(const sParserBenchMsg_t *pBench);
+
+	/**	@brief		Count the link frames in a built message */
+	static uint32_t ParserBenchFrames(const uint8_t *pData, uint32_t nLen);
+
+	/**	@brief		Parse the stream in reads of the given size
+		@param		nLen		Bytes in the stream
+		@param		nReadSize	Bytes handed to the parser at once
+		@param		bDecode		True to decode every point of each message
+		@return		Number of messages parsed, the points decoded are left in
+			gnPoints
+	*/
+	static uint32_t ParserBenchParse(uint32_t nLen, uint32_t nReadSize, bool bDecode);
+
+	static void ParserBenchReport(const char *pName, uint64_t nFrames, uint64_t nBytes, double nSeconds);
+
+/*****	Functions	*****/
+int main(void) {
+	char aName[64];
+	uint32_t nCtr, nMsgLen, nMsgFrames, nCopies, nLen;
+	uint64_t nFrames, nBytes;
+	double nStart, nTime;
+	const sParserBenchMsg_t *pBench;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	for (nCtr = 0; nCtr < sizeof(gaBenchMsgs) / sizeof(sParserBenchMsg_t); nCtr++) {
+		pBench = &(gaBenchMsgs[nCtr]);
+
+		HOSTCHECK(ParserBenchBuild(pBench) == Success);
+		nMsgLen = gMsg.nDNPMsgLen;
+		nMsgFrames = ParserBenchFrames(gMsg.aDNPMessage, nMsgLen);
+		printf("%s: %u bytes in %u frame(s)\n", pBench->pName, nMsgLen, nMsgFrames);
+
+		//Building from the points to the finished frames
+		nFrames = 0;
+		nBytes = 0;
+		nStart = HostTestSeconds();
+		do {
+			ParserBenchBuild(pBench);
+			gnSink = gMsg.nDNPMsgLen;
+
+			nFrames += nMsgFrames;
+			nBytes += nMsgLen;
+			nTime = HostTestSeconds() - nStart;
+		} while (nTime < PARSERBENCH_SECONDS);
+		ParserBenchReport("build", nFrames, nBytes, nTime);
+
+		//Fill the stream with copies of the message to parse
+		nCopies = PARSERBENCH_STREAMSIZE / nMsgLen;
+		for (nLen = 0; nLen < nCopies * nMsgLen; nLen += nMsgLen) {
+			memcpy(&(gaStream[nLen]), gMsg.aDNPMessage, nMsgLen);
+		}
+
+		//Every copy must be found, with all its points
+		HOSTCHECK(ParserBenchParse(nLen, nLen, false) == nCopies);
+		HOSTCHECK(ParserBenchParse(nLen, PARSERBENCH_READSIZE, false) == nCopies);
+		HOSTCHECK(ParserBenchParse(nLen, nLen, true) == nCopies);
+		HOSTCHECK(gnPoints == nCopies * (pBench->nBinaries + pBench->nAnalogs));
+
+		nFrames = 0;
+		nBytes = 0;
+		nStart = HostTestSeconds();
+		do {
+			gnSink = ParserBenchParse(nLen, nLen, false);
+
+			nFrames += nCopies * nMsgFrames;
+			nBytes += nLen;
+			nTime = HostTestSeconds() - nStart;
+		} while (nTime < PARSERBENCH_SECONDS);
+		ParserBenchReport("parse, one read", nFrames, nBytes, nTime);
+
+		nFrames = 0;
+		nBytes = 0;
+		nStart = HostTestSeconds();
+		do {
+			gnSink = ParserBenchParse(nLen, PARSERBENCH_READSIZE, false);
+
+			nFrames += nCopies * nMsgFrames;
+			nBytes += nLen;
+			nTime = HostTestSeconds() - nStart;
+		} while (nTime < PARSERBENCH_SECONDS);
+		snprintf(aName, sizeof(aName), "parse, %d byte reads", PARSERBENCH_READSIZE);
+		ParserBenchReport(aName, nFrames, nBytes, nTime);
+
+		nFrames = 0;
+		nBytes = 0;
+		nStart = HostTestSeconds();
+		do {
+			gnSink = ParserBenchParse(nLen, nLen, true);
+
+			nFrames += nCopies * nMsgFrames;
+			nBytes += nLen;
+			nTime = HostTestSeconds() - nStart;
+		} while (nTime < PARSERBENCH_SECONDS);
+		ParserBenchReport("parse and decode points", nFrames, nBytes, nTime);
+	}
+
+	return HostTestResult("DNPParserBench");
+}
+
+static eReturn_t ParserBenchBuild(const sParserBenchMsg_t *pBench) {
+	uint32_t nCtr;
+
+	DNPBufferNewMessage(&gMsg);
+
+	if (pBench->nBinaries + pBench->nAnalogs == 0) {
+		gMsg.nDestAddr = 10;
+		gMsg.nSourceAddr = 1;
+		gMsg.eControlCode = DNPCtrl_Read;
+
+		DNPBuilderAddDataObjectRequest(&gMsg, DNPGrp_ClassObjects, 2, 0, 0);
+		DNPBuilderAddDataObjectRequest(&gMsg, DNPGrp_ClassObjects, 1, 0, 0);
+
+		return DNPBuilderGenerateDNP(&gMsg);
+	}
+
+	gMsg.nDestAddr = 1;
+	gMsg.nSourceAddr = 10;
+	gMsg.eDataControl = DNPTEST_CTRLFROMOUT;
+	gMsg.eControlCode = DNPCtrl_Response;
+
+	for (nCtr = 0; nCtr < pBench->nBinaries; nCtr++) {
+		gPoints.aBinary[nCtr] = DNPBinInFlag_Online | ((nCtr & 0x01) * DNPBinInFlag_State);
+	}
+
+	for (nCtr = 0; nCtr < pBench->nAnalogs; nCtr++) {
+		gPoints.aAnalog[nCtr] = nCtr * 1000;
+		gPoints.aAnaFlags[nCtr] = DNPAnaInFlag_Online;
+	}
+
+	DNPBuilderAddBinaryInputDataObject(&gMsg, 2, pBench->nBinaries, gPoints.aBinary, false, 0);
+	DNPBuilderAddAnalogInputDataObject(&gMsg, 1, pBench->nAnalogs, gPoints.aAnalog, gPoints.aAnaFlags, 0);
+
+	return DNPBuilderGenerateDNP(&gMsg);
+}
+
+static uint32_t ParserBenchFrames(const uint8_t *pData, uint32_t nLen) {
+	uint32_t nPos, nFrames = 0;
+
+	for (nPos = 0; nPos < nLen; nPos += DNPLinkFrameSize(pData[nPos + DNPHdrIdx_DataLength])) {
+		nFrames += 1;
+	}
+
+	return nFrames;
+}
+
+static uint32_t ParserBenchParse(uint32_t nLen, uint32_t nReadSize, bool bDecode) {
+	sDNPMsgBuffer_t *pMsg = &gMsg;
+	sDNPDataValue_t sValue;
+	uint32_t nPos, nEnd, nUsed, nMsgs = 0;
+	eReturn_t eResult;
+
+	DNPBufferNewMessage(pMsg);
+	gnPoints = 0;
+
+	for (nPos = 0; nPos < nLen; nPos = nEnd) {
+		nEnd = GetSmallerNum(nPos + nReadSize, nLen);
+
+		while (nPos < nEnd) {
+			eResult = DNPParserReceivedData(pMsg, gaStream, nPos, nEnd, &nUsed);
+			nPos += nUsed;
+
+			if (eResult == Success) {
+				nMsgs += 1;
+
+				while ((bDecode == true) && (DNPParserNextDataObject(pMsg) == Success)) {
+					while (DNPParserNextDataValue(pMsg, &sValue) == Success) {
+						gnPoints += 1;
+					}
+				}
+
+				DNPBufferNewMessage(pMsg);
+			} else if ((eResult < Success) && (nUsed == 0)) {
+				nPos += 1;
+			}
+		}
+	}
+
+	return nMsgs;
+}
+
+static void ParserBenchReport(const char *pName, uint64_t nFrames, uint64_t nBytes, double nSeconds) {
+	printf("  %-28s %10.0f frames/s %8.1f MB/s\n", pName, nFrames / nSeconds, (nBytes / nSeconds) / 1e6);
+}
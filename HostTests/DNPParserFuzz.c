@@ -0,0 +1,347 @@
+/**	File:	DNPParserFuzz.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Fuzz target for the DNP message parser.  LLVMFuzzerTestOneInput() hands
+	the input to DNPParserReceivedData() in reads whose size is set by the
+	first byte, and walks every message completed with
+	DNPParserNextDataObject() and DNPParserNextDataValue().  The user data
+	is then copied to a buffer of exactly its size and walked again with the
+	fragment batch readers, so a read past its end is caught.  A parser that
+	stops taking data or returns more objects or points than a message holds
+	aborts, so the fuzzer reports it along with any memory errors.
+
+	Built with DNPFUZZ_LIBFUZZER defined, as the makefile fuzz target does
+	with clang, libFuzzer supplies main() and guides the inputs by coverage.
+	Otherwise main() is a driver that runs each file named on the command
+	line, which is how AFL runs it, writes seed files with -w, or with no
+	arguments runs DNPFUZZ_RUNS random mutations of built messages so a plain
+	gcc build still exercises the target.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <stdlib.h>
+
+	#include "CommonUtils.h"
+	#include "DNPMessageParser.h"
+	#include "DNPFragmentAssembler.h"
+
+	#ifndef DNPFUZZ_LIBFUZZER
+		#include "HostTest.h"
+		#include "DNPTestFrames.h"
+	#endif
+
+/*****	Defines		*****/
+	/**	@brief		Most input bytes used from one fuzz case */
+	#define DNPFUZZ_INPUTMAX		(DNP_MESSAGESIZEMAX * 2)
+
+	/**	@brief		Random cases the driver runs without arguments */
+	#define DNPFUZZ_RUNS			200000
+
+	/**	@brief		Points read in each batch call, small so objects take several */
+	#define DNPFUZZ_BATCH			7
+
+	/**	@brief		Seed files the driver writes with -w */
+	#define DNPFUZZ_SEEDS			16
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static sDNPMsgBuffer_t gMsg;
+
+	/**	@brief		Copy of the input, the parser takes writable data */
+	static uint8_t gaInput[DNPFUZZ_INPUTMAX];
+
+	/**	@brief		Messages the parser completed over all cases */
+	static uint32_t gnMessages;
+
+/*****	Prototypes 	*****/
+	/**	@brief		Run one fuzz case through the parser
+		@param		pData		First byte sets the read size, the rest is the stream
+		@param		nSize		Bytes in the case
+		@return		Always 0
+	*/
+	int LLVMFuzzerTestOneInput(const uint8_t *pData, size_t nSize);
+
+	/**	@brief		Read every object and point of a completed message */
+	static void DNPFuzzWalkObjects(sDNPMsgBuffer_t *pMsg);
+
+	/**	@brief		Read every object of a completed message with the batch readers
+		@param		pMsg		Message to read, its user data is copied
+		@param		nFirstIdx	Index of the first object header in the user data
+	*/
+	static void DNPFuzzWalkBatches(const sDNPMsgBuffer_t *pMsg, uint32_t nFirstIdx);
+
+	#ifndef DNPFUZZ_LIBFUZZER
+		/**	@brief		Build a case of random messages with random damage
+			@param		pCase		Buffer for the case, DNPFUZZ_INPUTMAX bytes
+			@param		pnSeed		Random generator state
+			@param		nMutations	Number of times to damage the stream
+			@return		Bytes in the case
+		*/
+		static uint32_t DNPFuzzRandomCase(uint8_t *pCase, uint32_t *pnSeed, uint32_t nMutations);
+
+		/**	@brief		Run a case read from a file */
+		static int DNPFuzzRunFile(const char *pFileName);
+
+		/**	@brief		Write undamaged cases as a seed corpus */
+		static int DNPFuzzWriteSeeds(const char *pDir);
+	#endif
+
+/*****	Functions	*****/
+int LLVMFuzzerTestOneInput(const uint8_t *pData, size_t nSize) {
+	uint32_t nLen, nReadSize, nPos, nEnd, nUsed;
+	eReturn_t eResult;
+
+	if (nSize < 2) {
+		return 0;
+	}
+
+	nReadSize = pData[0] + 1;
+	nLen = GetSmallerNum(nSize - 1, DNPFUZZ_INPUTMAX);
+	memcpy(gaInput, &(pData[1]), nLen);
+
+	DNPBufferNewMessage(&gMsg);
+
+	//Same handling as the outstation gives each read from its channel
+	for (nPos = 0; nPos < nLen; nPos = nEnd) {
+		nEnd = GetSmallerNum(nPos + nReadSize, nLen);
+
+		while (nPos < nEnd) {
+			eResult = DNPParserReceivedData(&gMsg, gaInput, nPos, nEnd, &nUsed);
+			if (nUsed > nEnd - nPos) { //Claimed bytes it was never given
+				abort();
+			}
+
+			nPos += nUsed;
+
+			if (eResult == Success) {
+				gnMessages += 1;
+				DNPFuzzWalkObjects(&gMsg);
+				DNPBufferNewMessage(&gMsg);
+			} else if (eResult < Success) {
+				if (nUsed == 0) {
+					nPos += 1;
+				}
+			} else if ((nUsed == 0) && (nPos < nEnd)) { //Stopped taking data, the caller would spin forever
+				abort();
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void DNPFuzzWalkObjects(sDNPMsgBuffer_t *pMsg) {
+	sDNPDataValue_t sValue;
+	uint32_t nObjects = 0, nValues, nFirstIdx = pMsg->nUserDataIdx;
+
+	while (DNPParserNextDataObject(pMsg) == Success) {
+		//Every object header takes at least a byte
+		nObjects += 1;
+		if (nObjects > pMsg->nUserDataLen) {
+			abort();
+		}
+
+		nValues = 0;
+		while (DNPParserNextDataValue(pMsg, &sValue) == Success) {
+			nValues += 1;
+
+			if (pMsg->nUserDataIdx > pMsg->nUserDataLen) { //Read past the message
+				abort();
+			}
+
+			if (nValues > pMsg->sDataObj.nAddressEnd - pMsg->sDataObj.nAddressStart + 1) {
+				abort();
+			}
+		}
+	}
+
+	DNPFuzzWalkBatches(pMsg, nFirstIdx);
+
+	return;
+}
+
+static void DNPFuzzWalkBatches(const sDNPMsgBuffer_t *pMsg, uint32_t nFirstIdx) {
+	sDNPAppFragment_t sFrag;
+	uint32_t aIndexes[DNPFUZZ_BATCH], nPoints, nTotal;
+	int32_t anValues[DNPFUZZ_BATCH];
+	float afValues[DNPFUZZ_BATCH];
+	uint8_t anFlags[DNPFUZZ_BATCH], *pCopy;
+
+	//Exactly the user data, so reading past it is a heap overflow the sanitizer reports
+	pCopy = malloc(pMsg->nUserDataLen + 1);
+	if (pCopy == NULL) {
+		return;
+	}
+	memcpy(pCopy, pMsg->aUserData, pMsg->nUserDataLen);
+
+	memset(&sFrag, 0, sizeof(sFrag));
+	sFrag.pData = pCopy;
+	sFrag.nLen = pMsg->nUserDataLen;
+	sFrag.nIdx = nFirstIdx;
+	sFrag.eControlCode = pMsg->eControlCode;
+	sFrag.sDataObj.eGroup = DNPGrp_Unknown;
+
+	while (DNPParserFragmentNextObject(&sFrag) == Success) {
+		nTotal = 0;
+
+		while (DNPParserFragmentReadBinaryPoints(&sFrag, aIndexes, anFlags, DNPFUZZ_BATCH, &nPoints) == Success) {
+			nTotal += nPoints;
+		}
+
+		while (DNPParserFragmentReadAnalogPoints(&sFrag, aIndexes, anValues, afValues, anFlags, DNPFUZZ_BATCH, &nPoints) == Success) {
+			nTotal += nPoints;
+		}
+
+		if (sFrag.nIdx > sFrag.nLen) { //Read past the message
+			abort();
+		}
+
+		if ((nTotal > 0) && (nTotal > sFrag.sDataObj.nAddressEnd - sFrag.sDataObj.nAddressStart + 1)) {
+			abort();
+		}
+	}
+
+	free(pCopy);
+
+	return;
+}
+
+#ifndef DNPFUZZ_LIBFUZZER
+int main(int nArgCnt, char *aArgs[]) {
+	static uint8_t aCase[DNPFUZZ_INPUTMAX];
+	uint32_t nSeed = 23, nCtr, nLen;
+	int nArg, nResult = 0;
+	double nStart;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	if ((nArgCnt == 3) && (strcmp(aArgs[1], "-w") == 0)) {
+		return DNPFuzzWriteSeeds(aArgs[2]);
+	}
+
+	if (nArgCnt > 1) { //Replay the cases given, as AFL does
+		for (nArg = 1; nArg < nArgCnt; nArg++) {
+			nResult |= DNPFuzzRunFile(aArgs[nArg]);
+		}
+
+		return nResult;
+	}
+
+	nStart = HostTestSeconds();
+	for (nCtr = 0; nCtr < DNPFUZZ_RUNS; nCtr++) {
+		nLen = DNPFuzzRandomCase(aCase, &nSeed, 1 + HostTestRandRange(&nSeed, 8));
+		LLVMFuzzerTestOneInput(aCase, nLen);
+	}
+
+	printf("  %u random cases in %.1f s, %u messages parsed\n", DNPFUZZ_RUNS, HostTestSeconds() - nStart, gnMessages);
+
+	//Some messages in each case escape the damage, a parser finding none of them is broken
+	HOSTCHECK(gnMessages > DNPFUZZ_RUNS / 4);
+
+	return HostTestResult("DNPParserFuzz");
+}
+
+static uint32_t DNPFuzzRandomCase(uint8_t *pCase, uint32_t *pnSeed, uint32_t nMutations) {
+	static sDNPMsgBuffer_t sTxMsg;
+	sDNPTestPoints_t sPoints;
+	uint32_t nLen, nMsg, nCtr, nPos, nSpan;
+
+	pCase[0] = HostTestRandRange(pnSeed, 256);
+	nLen = 1;
+
+	//A couple of good messages to damage
+	for (nMsg = 0; nMsg < 2; nMsg++) {
+		DNPTestRandomMessage(&sTxMsg, pnSeed, &sPoints);
+
+		if (nLen + sTxMsg.nDNPMsgLen <= DNPFUZZ_INPUTMAX) {
+			memcpy(&(pCase[nLen]), sTxMsg.aDNPMessage, sTxMsg.nDNPMsgLen);
+			nLen += sTxMsg.nDNPMsgLen;
+		}
+	}
+
+	for (nCtr = 0; nCtr < nMutations; nCtr++) {
+		nPos = 1 + HostTestRandRange(pnSeed, nLen - 1);
+		nSpan = 1 + HostTestRandRange(pnSeed, 32);
+		nSpan = GetSmallerNum(nSpan, nLen - nPos);
+
+		switch (HostTestRandRange(pnSeed, 5)) {
+			case 0: //Flip a bit
+				pCase[nPos] ^= 1 << HostTestRandRange(pnSeed, 8);
+				break;
+			case 1: //Overwrite with noise
+				HostTestRandom(pnSeed, &(pCase[nPos]), nSpan);
+				break;
+			case 2: //Put in start bytes
+				pCase[nPos] = 0x05;
+				if (nPos + 1 < nLen) {
+					pCase[nPos + 1] = 0x64;
+				}
+				break;
+			case 3: //Lose some bytes
+				memmove(&(pCase[nPos]), &(pCase[nPos + nSpan]), nLen - nPos - nSpan);
+				nLen -= nSpan;
+				break;
+			default: //Repeat some bytes
+				nSpan = GetSmallerNum(nSpan, DNPFUZZ_INPUTMAX - nLen);
+				memmove(&(pCase[nPos + nSpan]), &(pCase[nPos]), nLen - nPos);
+				nLen += nSpan;
+				break;
+		}
+
+		if (nLen < 2) {
+			break;
+		}
+	}
+
+	return nLen;
+}
+
+static int DNPFuzzRunFile(const char *pFileName) {
+	static uint8_t aCase[DNPFUZZ_INPUTMAX + 1];
+	FILE *pFile;
+	size_t nLen;
+
+	pFile = fopen(pFileName, "rb");
+	if (pFile == NULL) {
+		printf("Unable to open %s\n", pFileName);
+		return 1;
+	}
+
+	nLen = fread(aCase, 1, sizeof(aCase), pFile);
+	fclose(pFile);
+
+	LLVMFuzzerTestOneInput(aCase, nLen);
+
+	return 0;
+}
+
+static int DNPFuzzWriteSeeds(const char *pDir) {
+	static uint8_t aCase[DNPFUZZ_INPUTMAX];
+	char aFileName[256];
+	uint32_t nSeed = 29, nCtr, nLen;
+	FILE *pFile;
+
+	for (nCtr = 0; nCtr < DNPFUZZ_SEEDS; nCtr++) {
+		nLen = DNPFuzzRandomCase(aCase, &nSeed, 0);
+
+		snprintf(aFileName, sizeof(aFileName), "%s/seed%02u", pDir, nCtr);
+		pFile = fopen(aFileName, "wb");
+		if (pFile == NULL) {
+			printf("Unable to write %s\n", aFileName);
+			return 1;
+		}
+
+		fwrite(aCase, 1, nLen, pFile);
+		fclose(pFile);
+	}
+
+	return 0;
+}
+#endif
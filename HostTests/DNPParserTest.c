@@ -0,0 +1,367 @@
+/**	File:	DNPParserTest.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Feeds messages from the DNP message builder to the message parser the ways
+	a channel can deliver them: whole, split at every byte boundary, a byte at
+	a time, and in reads of random size.  Messages damaged by a flipped bit,
+	noise holding start bytes, and cut off headers are put in front of good
+	ones, the parser must drop the damage and still find every good message
+	with its points intact.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "DNPMessageBuilder.h"
+	#include "DNPMessageParser.h"
+
+	#include "HostTest.h"
+	#include "DNPTestFrames.h"
+
+/*****	Defines		*****/
+	/**	@brief		Random messages checked by each test */
+	#define PARSERTEST_MESSAGES		300
+
+	/**	@brief		Messages split at every byte boundary */
+	#define PARSERTEST_SPLITMSGS	20
+
+	/**	@brief		Most noise bytes put ahead of a message */
+	#define PARSERTEST_NOISEMAX		40
+
+	/**	@brief		Bytes of stream the tests can build */
+	#define PARSERTEST_STREAMSIZE	(DNP_MESSAGESIZEMAX * 3)
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	/**	@brief		Message the parser is expected to find */
+	static sDNPMsgBuffer_t gTxMsg;
+
+	static sDNPTestPoints_t gTxPoints;
+
+	static sDNPMsgBuffer_t gRxMsg;
+
+	static uint8_t gaStream[PARSERTEST_STREAMSIZE];
+
+	/**	@brief		Parsed messages matching the one sent, points and all */
+	static uint32_t gnMatched;
+
+	/**	@brief		Parsed messages that do not match the one sent */
+	static uint32_t gnWrong;
+
+	static uint32_t gnSeed = 19;
+
+/*****	Prototypes 	*****/
+	/**	@brief		Build the next random message to send
+		@return		Number of bytes in the built message
+	*/
+	static uint32_t ParserTestNextMessage(void);
+
+	/**	@brief		Clear the parser and the counts of messages found */
+	static void ParserTestReset(void);
+
+	/**	@brief		Hand the parser one read worth of the stream
+		@details	Every message completed is compared to the one sent, down to
+			the value of each point.
+		@param		nStart		Index in the stream the read begins
+		@param		nEnd		Index in the stream after the last byte read
+	*/
+	static void ParserTestRead(uint32_t nStart, uint32_t nEnd);
+
+	/**	@brief		Hand the parser a stream in reads of random size
+		@param		nLen		Bytes in the stream
+		@param		nReadMax	Most bytes in one read
+	*/
+	static void ParserTestReadRandom(uint32_t nLen, uint32_t nReadMax);
+
+	/**	@brief		Check a parsed message against the one sent
+		@return		True if the headers and data match
+	*/
+	static bool ParserTestMatches(sDNPMsgBuffer_t *pMsg);
+
+	/**	@brief		Walk the objects of a parsed response checking every point
+		@return		True if every point sent was read back
+	*/
+	static bool ParserTestPoints(sDNPMsgBuffer_t *pMsg);
+
+	static void ParserTestValid(void);
+
+	static void ParserTestSplits(void);
+
+	static void ParserTestBadCRC(void);
+
+	static void ParserTestLostFrame(void);
+
+	static void ParserTestNoise(void);
+
+/*****	Functions	*****/
+int main(void) {
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	ParserTestValid();
+	ParserTestSplits();
+	ParserTestBadCRC();
+	ParserTestLostFrame();
+	ParserTestNoise();
+
+	return HostTestResult("DNPParserTest");
+}
+
+static uint32_t ParserTestNextMessage(void) {
+	HOSTCHECK(DNPTestRandomMessage(&gTxMsg, &gnSeed, &gTxPoints) == Success);
+
+	return gTxMsg.nDNPMsgLen;
+}
+
+static void ParserTestReset(void) {
+	DNPBufferNewMessage(&gRxMsg);
+	gnMatched = 0;
+	gnWrong = 0;
+
+	return;
+}
+
+static void ParserTestRead(uint32_t nStart, uint32_t nEnd) {
+	uint32_t nIdx = nStart, nUsed;
+	eReturn_t eResult;
+
+	//Same handling as the outstation gives each read from its channel
+	while (nIdx < nEnd) {
+		eResult = DNPParserReceivedData(&gRxMsg, gaStream, nIdx, nEnd, &nUsed);
+		nIdx += nUsed;
+
+		if (eResult == Success) {
+			if ((ParserTestMatches(&gRxMsg) == true) && (ParserTestPoints(&gRxMsg) == true)) {
+				gnMatched += 1;
+			} else {
+				gnWrong += 1;
+			}
+
+			DNPBufferNewMessage(&gRxMsg);
+		} else if ((eResult < Success) && (nUsed == 0)) {
+			nIdx += 1;
+		}
+	}
+
+	return;
+}
+
+static void ParserTestReadRandom(uint32_t nLen, uint32_t nReadMax) {
+	uint32_t nPos, nRead;
+
+	for (nPos = 0; nPos < nLen; nPos += nRead) {
+		nRead = 1 + HostTestRandRange(&gnSeed, nReadMax);
+		nRead = GetSmallerNum(nRead, nLen - nPos);
+		ParserTestRead(nPos, nPos + nRead);
+	}
+
+	return;
+}
+
+static bool ParserTestMatches(sDNPMsgBuffer_t *pMsg) {
+	if ((pMsg->nDestAddr != gTxMsg.nDestAddr) || (pMsg->nSourceAddr != gTxMsg.nSourceAddr)) {
+		return false;
+	}
+
+	if ((pMsg->eControlCode != gTxMsg.eControlCode) || (pMsg->nApplicationSequence != gTxMsg.nApplicationSequence)) {
+		return false;
+	}
+
+	//Parsed user data leads with the application header, the built data does not
+	if (pMsg->nUserDataLen - pMsg->nUserDataIdx != gTxMsg.nUserDataLen) {
+		return false;
+	}
+
+	return (memcmp(&(pMsg->aUserData[pMsg->nUserDataIdx]), gTxMsg.aUserData, gTxMsg.nUserDataLen) == 0);
+}
+
+static bool ParserTestPoints(sDNPMsgBuffer_t *pMsg) {
+	sDNPDataValue_t sValue;
+	uint32_t nBinaries = 0, nAnalogs = 0;
+	bool bMatched = true;
+
+	while (DNPParserNextDataObject(pMsg) == Success) {
+		while (DNPParserNextDataValue(pMsg, &sValue) == Success) {
+			if ((pMsg->sDataObj.eGroup == DNPGrp_BinaryInput) && (sValue.nAddress < gTxPoints.nBinaries)) {
+				//Flags are copied as the raw byte, the rest of the value is left as it was
+				bMatched &= (sValue.Data.aBytes[0] == gTxPoints.aBinary[sValue.nAddress]);
+				nBinaries += 1;
+			} else if ((pMsg->sDataObj.eGroup == DNPGrp_AnalogInput) && (sValue.nAddress < gTxPoints.nAnalogs)) {
+				bMatched &= (sValue.Data.Analog.nValue == gTxPoints.aAnalog[sValue.nAddress]);
+				nAnalogs += 1;
+			} else { //Nothing else was sent
+				bMatched = false;
+			}
+		}
+	}
+
+	return (bMatched == true) && (nBinaries == gTxPoints.nBinaries) && (nAnalogs == gTxPoints.nAnalogs);
+}
+
+static void ParserTestValid(void) {
+	uint32_t nCtr, nLen;
+
+	//Whole messages, one read each
+	for (nCtr = 0; nCtr < PARSERTEST_MESSAGES; nCtr++) {
+		nLen = ParserTestNextMessage();
+		memcpy(gaStream, gTxMsg.aDNPMessage, nLen);
+
+		ParserTestReset();
+		ParserTestRead(0, nLen);
+
+		HOSTCHECK((gnMatched == 1) && (gnWrong == 0));
+	}
+
+	//Many messages back to back in one read
+	nLen = 0;
+	for (nCtr = 0; nCtr < 3; nCtr++) {
+		ParserTestNextMessage();
+		memcpy(&(gaStream[nLen]), gTxMsg.aDNPMessage, gTxMsg.nDNPMsgLen);
+		nLen += gTxMsg.nDNPMsgLen;
+	}
+
+	ParserTestReset();
+	ParserTestRead(0, nLen);
+	HOSTCHECK(gnMatched + gnWrong == 3);
+	HOSTCHECK(gnMatched == 1); //Only the last is the one held in gTxMsg
+
+	return;
+}
+
+static void ParserTestSplits(void) {
+	uint32_t nCtr, nLen, nSplit, nPos, nMissed;
+
+	for (nCtr = 0; nCtr < PARSERTEST_SPLITMSGS; nCtr++) {
+		nLen = ParserTestNextMessage();
+		memcpy(gaStream, gTxMsg.aDNPMessage, nLen);
+
+		//Two reads meeting at every byte of the message
+		nMissed = 0;
+		for (nSplit = 1; nSplit < nLen; nSplit++) {
+			ParserTestReset();
+			ParserTestRead(0, nSplit);
+			ParserTestRead(nSplit, nLen);
+
+			if ((gnMatched != 1) || (gnWrong != 0)) {
+				nMissed += 1;
+			}
+		}
+
+		HOSTCHECK(nMissed == 0);
+
+		//A byte at a time, as a UART would deliver it
+		ParserTestReset();
+		for (nPos = 0; nPos < nLen; nPos++) {
+			ParserTestRead(nPos, nPos + 1);
+		}
+
+		HOSTCHECK((gnMatched == 1) && (gnWrong == 0));
+	}
+
+	for (nCtr = 0; nCtr < PARSERTEST_MESSAGES; nCtr++) {
+		nLen = ParserTestNextMessage();
+		memcpy(gaStream, gTxMsg.aDNPMessage, nLen);
+
+		ParserTestReset();
+		ParserTestReadRandom(nLen, 64);
+		HOSTCHECK((gnMatched == 1) && (gnWrong == 0));
+	}
+
+	return;
+}
+
+static void ParserTestBadCRC(void) {
+	uint32_t nCtr, nLen, nBit;
+
+	//Any flipped bit fails a CRC, the damaged message is dropped and the good copy after it is found
+	for (nCtr = 0; nCtr < PARSERTEST_MESSAGES; nCtr++) {
+		nLen = ParserTestNextMessage();
+		memcpy(gaStream, gTxMsg.aDNPMessage, nLen);
+		memcpy(&(gaStream[nLen]), gTxMsg.aDNPMessage, nLen);
+
+		nBit = HostTestRandRange(&gnSeed, nLen * 8);
+		gaStream[nBit / 8] ^= 1 << (nBit % 8);
+
+		ParserTestReset();
+		ParserTestReadRandom(nLen * 2, 300);
+		HOSTCHECK((gnMatched == 1) && (gnWrong == 0));
+	}
+
+	return;
+}
+
+static void ParserTestLostFrame(void) {
+	uint32_t nCtr, nLen, nFirst, nSecond, nTested = 0;
+
+	//A frame that vanishes, such as one whose start bytes were damaged, must not join the frames around it
+	for (nCtr = 0; nCtr < PARSERTEST_MESSAGES; nCtr++) {
+		nLen = ParserTestNextMessage();
+
+		nFirst = DNPLinkFrameSize(gTxMsg.aDNPMessage[DNPHdrIdx_DataLength]);
+		if (nFirst >= nLen) { //Only one frame
+			continue;
+		}
+
+		nSecond = DNPLinkFrameSize(gTxMsg.aDNPMessage[nFirst + DNPHdrIdx_DataLength]);
+		if (nFirst + nSecond >= nLen) { //Losing the final frame leaves nothing to join
+			continue;
+		}
+
+		memcpy(gaStream, gTxMsg.aDNPMessage, nFirst);
+		memcpy(&(gaStream[nFirst]), &(gTxMsg.aDNPMessage[nFirst + nSecond]), nLen - nFirst - nSecond);
+		memcpy(&(gaStream[nLen - nSecond]), gTxMsg.aDNPMessage, nLen);
+
+		ParserTestReset();
+		ParserTestReadRandom((nLen * 2) - nSecond, 300);
+		HOSTCHECK((gnMatched == 1) && (gnWrong == 0));
+		nTested += 1;
+	}
+
+	HOSTCHECK(nTested > 0);
+
+	return;
+}
+
+static void ParserTestNoise(void) {
+	uint32_t nCtr, nLen, nNoise, nPos;
+
+	for (nCtr = 0; nCtr < PARSERTEST_MESSAGES; nCtr++) {
+		nLen = ParserTestNextMessage();
+
+		//Noise where start bytes are common
+		nNoise = HostTestRandRange(&gnSeed, PARSERTEST_NOISEMAX);
+		HostTestRandom(&gnSeed, gaStream, nNoise);
+		for (nPos = 0; nPos + 1 < nNoise; nPos += 1 + HostTestRandRange(&gnSeed, 4)) {
+			gaStream[nPos] = 0x05;
+			gaStream[nPos + 1] = 0x64;
+		}
+
+		//Then the start of a real header, cut off before its CRC
+		nPos = HostTestRandRange(&gnSeed, DNP_MSGHEADERLEN);
+		memcpy(&(gaStream[nNoise]), gTxMsg.aDNPMessage, nPos);
+		nNoise += nPos;
+
+		memcpy(&(gaStream[nNoise]), gTxMsg.aDNPMessage, nLen);
+
+		ParserTestReset();
+		ParserTestReadRandom(nNoise + nLen, 1 + HostTestRandRange(&gnSeed, 300));
+		HOSTCHECK((gnMatched == 1) && (gnWrong == 0));
+	}
+
+	//Noise alone, nothing is found
+	ParserTestReset();
+	for (nCtr = 0; nCtr < PARSERTEST_MESSAGES; nCtr++) {
+		HostTestRandom(&gnSeed, gaStream, PARSERTEST_STREAMSIZE);
+		ParserTestReadRandom(PARSERTEST_STREAMSIZE, 300);
+	}
+
+	HOSTCHECK(gnMatched + gnWrong == 0);
+
+	return;
+}
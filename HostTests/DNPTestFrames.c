@@ -0,0 +1,151 @@
+/**	File:	DNPTestFrames.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "CRC16.h"
+
+	#include "HostTest.h"
+	#include "DNPTestFrames.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+
+
+/*****	Functions	*****/
+uint32_t DNPTestLinkFrame(uint8_t *pFrame, uint16_t nDest, uint16_t nSource, uint8_t nTransHdr, const uint8_t *pAppData, uint32_t nAppLen) {
+	uint8_t aUserData[DNPTEST_SEGMENTMAX + 1];
+	uint32_t nUserLen, nPos, nBlockLen, nCtr;
+	crc16_t nCRC;
+
+	aUserData[0] = nTransHdr;
+	memcpy(&(aUserData[1]), pAppData, nAppLen);
+	nUserLen = nAppLen + 1;
+
+	pFrame[DNPHdrIdx_StartBytes] = 0x05;
+	pFrame[DNPHdrIdx_StartBytes + 1] = 0x64;
+	pFrame[DNPHdrIdx_DataLength] = 5 + nUserLen;
+	pFrame[DNPHdrIdx_DataControl] = DNPTEST_CTRLFROMOUT;
+	pFrame[DNPHdrIdx_DestAddr] = nDest & 0xFF;
+	pFrame[DNPHdrIdx_DestAddr + 1] = nDest >> 8;
+	pFrame[DNPHdrIdx_SourceAddr] = nSource & 0xFF;
+	pFrame[DNPHdrIdx_SourceAddr + 1] = nSource >> 8;
+
+	//CalculateCRC16 gives DNP CRCs in transmit order, most significant byte first
+	nCRC = CalculateCRC16(CRC_DNP, pFrame, DNPHdrIdx_CRC);
+	pFrame[DNPHdrIdx_CRC] = nCRC >> 8;
+	pFrame[DNPHdrIdx_CRC + 1] = nCRC & 0xFF;
+
+	nPos = DNP_MSGHEADERLEN;
+	for (nCtr = 0; nCtr < nUserLen; nCtr += nBlockLen) {
+		nBlockLen = GetSmallerNum(nUserLen - nCtr, CRC16_DNPBLOCKSIZE);
+
+		memcpy(&(pFrame[nPos]), &(aUserData[nCtr]), nBlockLen);
+		nCRC = CalculateCRC16(CRC_DNP, &(pFrame[nPos]), nBlockLen);
+		pFrame[nPos + nBlockLen] = nCRC >> 8;
+		pFrame[nPos + nBlockLen + 1] = nCRC & 0xFF;
+
+		nPos += nBlockLen + 2;
+	}
+
+	return nPos;
+}
+
+uint32_t DNPTestSegmentFragment(uint8_t *pStream, uint16_t nDest, uint16_t nSource, uint8_t *pnSeq, const uint8_t *pAppData, uint32_t nAppLen, uint32_t *pnOffsets) {
+	uint32_t nSent = 0, nSegLen, nLen = 0, nFrame = 0;
+	uint8_t nTransHdr;
+
+	do {
+		nSegLen = GetSmallerNum(nAppLen - nSent, DNPTEST_SEGMENTMAX);
+
+		nTransHdr = *pnSeq & DNPTransHdr_SequenceMask;
+		if (nSent == 0) {
+			nTransHdr |= DNPTransHdr_FirstMsg;
+		}
+
+		if (nSent + nSegLen == nAppLen) {
+			nTransHdr |= DNPTransHdr_LastMsg;
+		}
+
+		if (pnOffsets != NULL) {
+			pnOffsets[nFrame] = nLen;
+		}
+
+		nLen += DNPTestLinkFrame(&(pStream[nLen]), nDest, nSource, nTransHdr, &(pAppData[nSent]), nSegLen);
+		nSent += nSegLen;
+		nFrame += 1;
+		*pnSeq = (*pnSeq + 1) & DNPTransHdr_SequenceMask;
+	} while (nSent < nAppLen);
+
+	return nLen;
+}
+
+eReturn_t DNPTestRandomMessage(sDNPMsgBuffer_t *pMsg, uint32_t *pnSeed, sDNPTestPoints_t *pPoints) {
+	uint32_t nCtr;
+
+	DNPBufferNewMessage(pMsg);
+	pMsg->nApplicationSequence = HostTestRandRange(pnSeed, DNPAppHdr_SequenceMask + 1);
+	pMsg->nTransportSequence = HostTestRandRange(pnSeed, DNPTransHdr_SequenceMask + 1);
+
+	pPoints->nBinaries = 0;
+	pPoints->nAnalogs = 0;
+
+	if (HostTestRandRange(pnSeed, 4) == 0) { //Master polling for events and static data
+		pMsg->nDestAddr = 10;
+		pMsg->nSourceAddr = 1;
+		pMsg->eDataControl = DNPData_Primary | DNPData_UnconfirmData | DNPData_Direction;
+		pMsg->eControlCode = DNPCtrl_Read;
+
+		DNPBuilderAddDataObjectRequest(pMsg, DNPGrp_ClassObjects, 2, 0, 0);
+		DNPBuilderAddDataObjectRequest(pMsg, DNPGrp_ClassObjects, 1, 0, 0);
+
+		return DNPBuilderGenerateDNP(pMsg);
+	}
+
+	pMsg->nDestAddr = 1;
+	pMsg->nSourceAddr = 10;
+	pMsg->eDataControl = DNPTEST_CTRLFROMOUT;
+	pMsg->eControlCode = DNPCtrl_Response;
+	pMsg->bConfirmExpect = (HostTestRandRange(pnSeed, 2) == 0);
+
+	pPoints->nBinaries = HostTestRandRange(pnSeed, DNPTEST_POINTSMAX + 1);
+	for (nCtr = 0; nCtr < pPoints->nBinaries; nCtr++) {
+		pPoints->aBinary[nCtr] = DNPBinInFlag_Online | (HostTestRandRange(pnSeed, 2) * DNPBinInFlag_State);
+	}
+
+	pPoints->nAnalogs = HostTestRandRange(pnSeed, DNPTEST_POINTSMAX + 1);
+	for (nCtr = 0; nCtr < pPoints->nAnalogs; nCtr++) {
+		if (HostTestRandRange(pnSeed, 4) == 0) {
+			pPoints->aAnalog[nCtr] = DNPTEST_STARTVALUE;
+		} else {
+			HostTestRandom(pnSeed, (uint8_t *)&(pPoints->aAnalog[nCtr]), sizeof(int32_t));
+		}
+
+		pPoints->aAnaFlags[nCtr] = DNPAnaInFlag_Online;
+	}
+
+	if (pPoints->nBinaries > 0) {
+		DNPBuilderAddBinaryInputDataObject(pMsg, 2, pPoints->nBinaries, pPoints->aBinary, false, 0);
+	}
+
+	if (pPoints->nAnalogs > 0) {
+		DNPBuilderAddAnalogInputDataObject(pMsg, 1, pPoints->nAnalogs, pPoints->aAnalog, pPoints->aAnaFlags, 0);
+	}
+
+	return DNPBuilderGenerateDNP(pMsg);
+}
@@ -0,0 +1,123 @@
+/**	@defgroup	dnptestframes	DNP Test Frames
+	@ingroup	hosttest
+	@brief		Builds DNP link frames for the host tests
+	@details	v0.1
+	#Description
+		Produces link frames byte for byte as they would appear on the wire, so
+		the tests can send the receiving code things the message builder will
+		not make: application fragments larger than the message buffer,
+		segments out of sequence, and frames from several outstations mixed
+		together.  Random requests and responses can also be made with the
+		message builder for the parser tests and benchmarks.
+
+	#File Information
+		File:	DNPTestFrames.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __DNPTESTFRAMES_H
+	#define __DNPTESTFRAMES_H
+
+/*****	Includes	*****/
+	#include <stdint.h>
+	#include <stdbool.h>
+
+	#include "DNPBase.h"
+	#include "DNPLinkDeframer.h"
+	#include "DNPMessageBuilder.h"
+
+/*****	Defines		*****/
+	/**	@brief		Most application bytes a single link frame can carry
+	 *	@details	The link frame holds 250 bytes of user data, one of them is the
+	 *		transport header.
+	 *	@ingroup	dnptestframes
+	 */
+	#define DNPTEST_SEGMENTMAX		249
+
+	/**	@brief		Data control byte of an unconfirmed frame from an outstation
+	 *	@ingroup	dnptestframes
+	 */
+	#define DNPTEST_CTRLFROMOUT		(DNPData_Primary | DNPData_UnconfirmData)
+
+	/**	@brief		Most binary or analog points in a random response
+	 *	@details	A full response of both stays inside DNP_USERDATAMAX.
+	 *	@ingroup	dnptestframes
+	 */
+	#define DNPTEST_POINTSMAX		100
+
+	/**	@brief		Analog value whose bytes carry the link start bytes
+	 *	@ingroup	dnptestframes
+	 */
+	#define DNPTEST_STARTVALUE		0x05640564
+
+/*****	Definitions	*****/
+	/**	@brief		Points carried by a random response
+	 *	@details	Binary inputs are sent as group 1 variation 2 and analog inputs
+	 *		as group 30 variation 1, both starting at index 0.
+	 *	@ingroup	dnptestframes
+	 */
+	typedef struct sDNPTestPoints_t {
+		uint32_t nBinaries;								/**< Binary inputs in the response */
+		uint32_t nAnalogs;								/**< Analog inputs in the response */
+		eDNPObjBinInFlags_t aBinary[DNPTEST_POINTSMAX];
+		int32_t aAnalog[DNPTEST_POINTSMAX];
+		eDNPObjAnaInFlags_t aAnaFlags[DNPTEST_POINTSMAX];
+	} sDNPTestPoints_t;
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Build one link frame carrying a transport segment
+	 *	@param		pFrame		Buffer to write the frame to, DNP_LINKFRAMEMAX bytes
+	 *	@param		nDest		Destination address
+	 *	@param		nSource		Source address
+	 *	@param		nTransHdr	Transport header byte
+	 *	@param		pAppData	Application bytes to carry
+	 *	@param		nAppLen		Number of application bytes, at most DNPTEST_SEGMENTMAX
+	 *	@return		Number of bytes in the frame
+	 *	@ingroup	dnptestframes
+	 */
+	uint32_t DNPTestLinkFrame(uint8_t *pFrame, uint16_t nDest, uint16_t nSource, uint8_t nTransHdr, const uint8_t *pAppData, uint32_t nAppLen);
+
+	/**	@brief		Split an application fragment into transport segments
+	 *	@details	Each segment is written as its own link frame, one after
+	 *		another, with the first and final flags set and the sequence
+	 *		advancing with each.
+	 *	@param		pStream		Buffer to write the frames to
+	 *	@param		nDest		Destination address
+	 *	@param		nSource		Source address
+	 *	@param		pnSeq		Transport sequence of the first segment, returns
+	 *		the sequence for the segment after the last
+	 *	@param		pAppData	Application fragment to send
+	 *	@param		nAppLen		Number of bytes in the fragment
+	 *	@param		pnOffsets	Returns the offset of each frame in the stream,
+	 *		may be NULL
+	 *	@return		Number of bytes written to the stream
+	 *	@ingroup	dnptestframes
+	 */
+	uint32_t DNPTestSegmentFragment(uint8_t *pStream, uint16_t nDest, uint16_t nSource, uint8_t *pnSeq, const uint8_t *pAppData, uint32_t nAppLen, uint32_t *pnOffsets);
+
+	/**	@brief		Build a random request or response with the message builder
+	 *	@details	One message in four is a class poll, the rest are responses
+	 *		with a random number of points.  Some analog values are
+	 *		DNPTEST_STARTVALUE so start bytes show up inside the frames.  The
+	 *		message is left in aDNPMessage for sending.
+	 *	@param		pMsg		Message buffer to build in
+	 *	@param		pnSeed		Random generator state, updated by the call
+	 *	@param		pPoints		Returns the points in the response, none for a
+	 *		request
+	 *	@return		Result of generating the message
+	 *	@ingroup	dnptestframes
+	 */
+	eReturn_t DNPTestRandomMessage(sDNPMsgBuffer_t *pMsg, uint32_t *pnSeed, sDNPTestPoints_t *pPoints);
+
+/*****	Functions	*****/
+
+
+#endif
@@ -0,0 +1,227 @@
+/**	File:	EpollBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Loopback benchmark for the epoll TCP server.  One thread runs the event
+	loop with a handler that echoes whatever each client sends.  The main
+	thread opens EPOLLBENCH_CONNS clients through the plain sockets driver,
+	checks the loop is holding every one of them, then sends a message on
+	each and collects the echoes as fast as it can.  The connections held and
+	the messages per second are reported.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "Network_RaspberryPi.h"
+	#include "NetworkEpoll_RaspberryPi.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds the echo benchmark runs for */
+	#define EPOLLBENCH_SECONDS		2.0
+
+	/**	@brief		TCP port the server listens on */
+	#define EPOLLBENCH_PORT			20110
+
+	/**	@brief		Clients connected at once, the loop also holds the listening socket */
+	#define EPOLLBENCH_CONNS		400
+
+	/**	@brief		Bytes in each message */
+	#define EPOLLBENCH_MSGSIZE		64
+
+	/**	@brief		Seconds to wait for the server to see every connection come or go */
+	#define EPOLLBENCH_SETTLE		2.0
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	/**	@brief		Event loop, too large for the stack */
+	static sRasPiEpoll_t gLoop;
+
+	static sTCPClient_t gaClients[EPOLLBENCH_CONNS];
+
+	/**	@brief		Clients the server has open */
+	static volatile uint32_t gnConns;
+
+	/**	@brief		Cleared to have the server thread finish */
+	static volatile bool gbRunning;
+
+/*****	Prototypes 	*****/
+	/**	@brief		Echoes everything received on a client back to it */
+	static void EpollBenchHandler(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam);
+
+	static void *EpollBenchServerThread(void *pParam);
+
+	/**	@brief		Wait for the server to have the given number of clients open
+		@return		True if it got there before EPOLLBENCH_SETTLE seconds passed
+	*/
+	static bool EpollBenchWaitConns(uint32_t nConns);
+
+	/**	@brief		Receive a whole message from a client
+		@return		True if the message arrived
+	*/
+	static bool EpollBenchRecvMsg(sTCPClient_t *pClient, uint8_t *pMsg);
+
+/*****	Functions	*****/
+int main(void) {
+	sTCPServ_t sTCPServ;
+	sConnInfo_t sAddr;
+	pthread_t hServer;
+	uint8_t aMsg[EPOLLBENCH_MSGSIZE], aEcho[EPOLLBENCH_MSGSIZE];
+	uint32_t nCtr, nConnected, nSeed = 11;
+	uint64_t nMsgs, nBad;
+	double nStart, nTime;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	if (HOSTCHECK(RasPiEpollInitialize(&gLoop) == Net_Success) == false) {
+		return HostTestResult("EpollBench");
+	}
+
+	RasPiEpollCreateTCPServer(&gLoop, &sTCPServ);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = EPOLLBENCH_PORT;
+	if (HOSTCHECK(sTCPServ.pfBind(&sTCPServ, &sAddr) == Net_Success) == false) {
+		return HostTestResult("EpollBench");
+	}
+
+	HOSTCHECK(RasPiEpollSetHandler(&sTCPServ, &(sTCPServ.HostSck), &EpollBenchHandler, NULL) == Net_Success);
+
+	gbRunning = true;
+	pthread_create(&hServer, NULL, &EpollBenchServerThread, NULL);
+
+	//Every client is handled by the one server thread
+	nConnected = 0;
+	nStart = HostTestSeconds();
+	for (nCtr = 0; nCtr < EPOLLBENCH_CONNS; nCtr++) {
+		RasPiTCPClientInitialize(&(gaClients[nCtr]));
+
+		if (gaClients[nCtr].pfConnect(&(gaClients[nCtr]), &sAddr) == Net_Success) {
+			nConnected += 1;
+		}
+	}
+	HOSTCHECK(nConnected == EPOLLBENCH_CONNS);
+	HOSTCHECK(EpollBenchWaitConns(EPOLLBENCH_CONNS) == true);
+	printf("  connections held %u of %u, connected in %.3f s\n", gnConns, EPOLLBENCH_CONNS, HostTestSeconds() - nStart);
+
+	//One message out on every client then all the echoes back, round after round
+	nMsgs = 0;
+	nBad = 0;
+	nStart = HostTestSeconds();
+	do {
+		for (nCtr = 0; nCtr < nConnected; nCtr++) {
+			HostTestRandom(&nSeed, aMsg, EPOLLBENCH_MSGSIZE);
+			memcpy(&(aMsg[0]), &nCtr, sizeof(nCtr)); //Lets the echo be matched to its client
+
+			if (gaClients[nCtr].pfSend(&(gaClients[nCtr]), EPOLLBENCH_MSGSIZE, aMsg) != Net_Success) {
+				nBad += 1;
+			}
+		}
+
+		for (nCtr = 0; nCtr < nConnected; nCtr++) {
+			if ((EpollBenchRecvMsg(&(gaClients[nCtr]), aEcho) == false) || (memcmp(&(aEcho[0]), &nCtr, sizeof(nCtr)) != 0)) {
+				nBad += 1;
+			}
+
+			nMsgs += 1;
+		}
+
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < EPOLLBENCH_SECONDS);
+
+	HOSTCHECK(nBad == 0);
+	printf("  %u clients echoing %d byte messages: %10.0f messages/s\n", nConnected, EPOLLBENCH_MSGSIZE, nMsgs / nTime);
+
+	//The server must see every client leave
+	for (nCtr = 0; nCtr < EPOLLBENCH_CONNS; nCtr++) {
+		gaClients[nCtr].pfClose(&(gaClients[nCtr]));
+	}
+	HOSTCHECK(EpollBenchWaitConns(0) == true);
+
+	gbRunning = false;
+	pthread_join(hServer, NULL);
+
+	RasPiEpollClose(&gLoop);
+
+	return HostTestResult("EpollBench");
+}
+
+static void EpollBenchHandler(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam) {
+	static uint8_t aBuff[RASPIEPOLL_TXBUFFSIZE + 1];
+	uint32_t nRecv;
+	eNetReturn_t eResult;
+
+	if (eEvents == RasPiEpoll_Accepted) {
+		if (gnConns == 0) { //Once is enough, a send too large to hold must not go out at all
+			HOSTCHECK(pTCPServ->pfSend(pTCPServ, pSck, sizeof(aBuff), aBuff) == NetFail_BuffSize);
+			HOSTCHECK(RasPiEpollTxPending(pTCPServ, pSck) == 0);
+		}
+
+		gnConns += 1;
+		return;
+	}
+
+	if ((eEvents & RasPiEpoll_Readable) != 0) {
+		do {
+			eResult = pTCPServ->pfReceive(pTCPServ, pSck, RASPIEPOLL_TXBUFFSIZE, aBuff, &nRecv);
+
+			if ((nRecv > 0) && (pTCPServ->pfSend(pTCPServ, pSck, nRecv, aBuff) != Net_Success)) {
+				eResult = NetFail_SocketState;
+			}
+		} while (eResult == Net_Success);
+
+		if (eResult != NetWarn_EndOfData) { //Client is gone
+			pTCPServ->pfCloseSocket(pTCPServ, pSck);
+			gnConns -= 1;
+		}
+	}
+
+	return;
+}
+
+static void *EpollBenchServerThread(void *pParam) {
+	while (gbRunning == true) {
+		RasPiEpollProcess(&gLoop, 10);
+	}
+
+	return NULL;
+}
+
+static bool EpollBenchWaitConns(uint32_t nConns) {
+	double nStart = HostTestSeconds();
+
+	while (gnConns != nConns) {
+		if (HostTestSeconds() - nStart > EPOLLBENCH_SETTLE) {
+			return false;
+		}
+
+		usleep(1000);
+	}
+
+	return true;
+}
+
+static bool EpollBenchRecvMsg(sTCPClient_t *pClient, uint8_t *pMsg) {
+	uint32_t nHave = 0, nRecv;
+
+	while (nHave < EPOLLBENCH_MSGSIZE) {
+		if (pClient->pfReceive(pClient, EPOLLBENCH_MSGSIZE - nHave, &(pMsg[nHave]), &nRecv) < Net_Success) {
+			return false;
+		}
+
+		nHave += nRecv;
+	}
+
+	return true;
+}
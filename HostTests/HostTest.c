@@ -0,0 +1,77 @@
+/**	File:	HostTest.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include <time.h>
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static uint32_t gnHostTestChecks = 0;
+
+	static uint32_t gnHostTestFails = 0;
+
+/*****	Prototypes 	*****/
+
+
+/*****	Functions	*****/
+bool HostTestCheck(bool bPassed, const char *pCond, const char *pFile, int nLine) {
+	gnHostTestChecks += 1;
+
+	if (bPassed == false) {
+		gnHostTestFails += 1;
+		printf("FAIL %s:%d: %s\n", pFile, nLine, pCond);
+	}
+
+	return bPassed;
+}
+
+int HostTestResult(const char *pName) {
+	if (gnHostTestFails == 0) {
+		printf("%s: all %u checks passed\n", pName, gnHostTestChecks);
+		return 0;
+	} else {
+		printf("%s: %u of %u checks FAILED\n", pName, gnHostTestFails, gnHostTestChecks);
+		return 1;
+	}
+}
+
+double HostTestSeconds(void) {
+	struct timespec tNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &tNow);
+
+	return (double)tNow.tv_sec + ((double)tNow.tv_nsec / 1e9);
+}
+
+uint32_t HostTestRandRange(uint32_t *pnSeed, uint32_t nRange) {
+	//xorshift32, the same sequence on every host for a given seed
+	*pnSeed ^= *pnSeed << 13;
+	*pnSeed ^= *pnSeed >> 17;
+	*pnSeed ^= *pnSeed << 5;
+
+	if (nRange == 0) {
+		return 0;
+	}
+
+	return *pnSeed % nRange;
+}
+
+void HostTestRandom(uint32_t *pnSeed, uint8_t *pBuff, uint32_t nBytes) {
+	uint32_t nCtr;
+
+	for (nCtr = 0; nCtr < nBytes; nCtr++) {
+		pBuff[nCtr] = (uint8_t)HostTestRandRange(pnSeed, 256);
+	}
+}
@@ -0,0 +1,87 @@
+/**	@defgroup	hosttest	Host Test Support
+	@brief		Shared helpers for the Linux host tests and benchmarks
+	@details	v0.1
+	#Description
+		The programs in this folder build the general libraries and drivers for
+		a Linux host so they can be checked and measured without the target
+		hardware.  Each program is stand alone, these helpers count failed
+		checks and time the work being measured.
+
+	#Usage
+		Use HOSTCHECK() for each condition a test expects.  Finish main() by
+		returning HostTestResult(), which reports the number of failures and
+		returns non-zero if there were any so make stops on a failed test.
+
+	#File Information
+		File:	HostTest.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __HOSTTEST_H
+	#define __HOSTTEST_H
+
+/*****	Includes	*****/
+	#include <stdio.h>
+	#include <stdint.h>
+	#include <stdbool.h>
+
+/*****	Defines		*****/
+	/**	@brief		Checks a condition the test expects, counting and reporting it if false
+		@ingroup	hosttest
+	*/
+	#define HOSTCHECK(bCond)	HostTestCheck((bCond), #bCond, __FILE__, __LINE__)
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Records the result of one check
+		@param		bPassed		True if the check passed
+		@param		pCond		Text of the condition checked
+		@param		pFile		Source file of the check
+		@param		nLine		Line of the check
+		@return		The value of bPassed
+		@ingroup	hosttest
+	*/
+	bool HostTestCheck(bool bPassed, const char *pCond, const char *pFile, int nLine);
+
+	/**	@brief		Reports the outcome of all checks made
+		@param		pName		Name of the test to report
+		@return		0 if every check passed, 1 otherwise
+		@ingroup	hosttest
+	*/
+	int HostTestResult(const char *pName);
+
+	/**	@brief		Reads a monotonic clock
+		@return		Seconds since an arbitrary point
+		@ingroup	hosttest
+	*/
+	double HostTestSeconds(void);
+
+	/**	@brief		Fills a buffer with repeatable pseudo random bytes
+		@param		pnSeed		Generator state, must start non-zero, updated by the call
+		@param		pBuff		Buffer to fill
+		@param		nBytes		Number of bytes to fill
+		@ingroup	hosttest
+	*/
+	void HostTestRandom(uint32_t *pnSeed, uint8_t *pBuff, uint32_t nBytes);
+
+	/**	@brief		Produces a repeatable pseudo random number
+		@param		pnSeed		Generator state, must start non-zero, updated by the call
+		@param		nRange		Number of values to choose from
+		@return		A value from 0 to nRange - 1
+		@ingroup	hosttest
+	*/
+	uint32_t HostTestRandRange(uint32_t *pnSeed, uint32_t nRange);
+
+/*****	Functions	*****/
+
+
+#endif
@@ -0,0 +1,294 @@
+/**	File:	NetPoolTest.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Tests the TCP client connection pool against a loopback server that
+	counts the connections it accepts and the bytes it receives.  The server
+	is the epoll TCP server running in its own thread.  Short uploads are made
+	first with a new connection each, then through a pool of two clients,
+	which must use only two connections for all of them.  The server is then
+	stopped to check reconnect attempts back off, and started again to check
+	the pool reconnects.  No uploaded byte may be lost.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "Network_RaspberryPi.h"
+	#include "NetworkEpoll_RaspberryPi.h"
+	#include "NetworkClientPool.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		TCP port the counting server listens on */
+	#define NETPOOLTEST_PORT		20150
+
+	/**	@brief		Uploads made with a new connection each */
+	#define NETPOOLTEST_DIRECT		100
+
+	/**	@brief		Uploads made through the pool */
+	#define NETPOOLTEST_POOLED		2000
+
+	/**	@brief		Clients in the pool, all to the same server */
+	#define NETPOOLTEST_CLIENTS		2
+
+	/**	@brief		Milliseconds the server is kept down */
+	#define NETPOOLTEST_DOWNTIME	2000
+
+	/**	@brief		Milliseconds allowed for the pool to reconnect */
+	#define NETPOOLTEST_RECONNECT	5000
+
+	/**	@brief		Milliseconds for the server to catch up on what was sent */
+	#define NETPOOLTEST_SETTLE		100
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+	/**	@brief		Sent in each upload */
+	static const char gaUpload[] = "temp=21.5 hum=40\n";
+
+/*****	Globals		*****/
+	/**	@brief		Event loop, too large for the stack */
+	static sRasPiEpoll_t gLoop;
+
+	static sTCPServ_t gTCPServ;
+
+	static pthread_t ghServer;
+
+	/**	@brief		Cleared to have the server thread finish */
+	static volatile bool gbRunning;
+
+	/**	@brief		Connections the server has accepted */
+	static volatile uint32_t gnAccepts;
+
+	/**	@brief		Bytes the server has received */
+	static volatile uint64_t gnBytes;
+
+	static sTCPClient_t gaPoolClients[NETPOOLTEST_CLIENTS];
+
+	static sNetPool_t gPool;
+
+/*****	Prototypes 	*****/
+	static uint32_t NetPoolTestTicks(void);
+
+	/**	@brief		Counts connections and bytes, closing clients that hang up */
+	static void NetPoolTestHandler(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam);
+
+	static void *NetPoolTestServerThread(void *pParam);
+
+	/**	@brief		Start the counting server in its own thread
+		@return		True if the server is listening
+	*/
+	static bool NetPoolTestServerStart(sConnInfo_t *pAddr);
+
+	/**	@brief		Stop the server thread and close every socket it has */
+	static void NetPoolTestServerStop(void);
+
+/*****	Functions	*****/
+int main(void) {
+	sTCPClient_t sClient, *pClient;
+	sConnInfo_t sAddr, sOther;
+	eNetReturn_t eResult;
+	uint32_t nCtr, nAccepts, nFailed, nStart, nLastWait, nRetries, nReconnect;
+	uint64_t nSent;
+	double nTime;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = NETPOOLTEST_PORT;
+	if (HOSTCHECK(NetPoolTestServerStart(&sAddr) == true) == false) {
+		return HostTestResult("NetPoolTest");
+	}
+
+	//A new connection for every upload, as callers did without the pool
+	nSent = 0;
+	nFailed = 0;
+	RasPiTCPClientInitialize(&sClient);
+	nTime = HostTestSeconds();
+	for (nCtr = 0; nCtr < NETPOOLTEST_DIRECT; nCtr++) {
+		if (sClient.pfConnect(&sClient, &sAddr) != Net_Success) {
+			nFailed += 1;
+			continue;
+		}
+
+		if (sClient.pfSend(&sClient, sizeof(gaUpload) - 1, (void *)gaUpload) == Net_Success) {
+			nSent += sizeof(gaUpload) - 1;
+		}
+
+		sClient.pfClose(&sClient);
+	}
+	nTime = HostTestSeconds() - nTime;
+	usleep(NETPOOLTEST_SETTLE * 1000);
+
+	HOSTCHECK(nFailed == 0);
+	HOSTCHECK(gnAccepts == NETPOOLTEST_DIRECT);
+	printf("  connect per upload: %u uploads, %u connections, %.1f us/upload\n", NETPOOLTEST_DIRECT, gnAccepts, (nTime * 1e6) / NETPOOLTEST_DIRECT);
+
+	//The pool keeps its clients connected between uploads
+	nAccepts = gnAccepts;
+	NetPoolInitialize(&gPool, &NetPoolTestTicks);
+	for (nCtr = 0; nCtr < NETPOOLTEST_CLIENTS; nCtr++) {
+		RasPiTCPClientInitialize(&(gaPoolClients[nCtr]));
+		HOSTCHECK(NetPoolAddClient(&gPool, &(gaPoolClients[nCtr]), &sAddr) == Net_Success);
+	}
+
+	nFailed = 0;
+	nTime = HostTestSeconds();
+	for (nCtr = 0; nCtr < NETPOOLTEST_POOLED; nCtr++) {
+		do { //Connections are made without waiting, lease until one is ready
+			eResult = NetPoolLease(&gPool, &sAddr, &pClient);
+		} while (eResult == NetWarn_InProgress);
+
+		if (eResult != Net_Success) {
+			nFailed += 1;
+			continue;
+		}
+
+		eResult = pClient->pfSend(pClient, sizeof(gaUpload) - 1, (void *)gaUpload);
+		if (eResult == Net_Success) {
+			nSent += sizeof(gaUpload) - 1;
+		}
+
+		NetPoolRelease(&gPool, pClient, (eResult != Net_Success) ? true : false);
+	}
+	nTime = HostTestSeconds() - nTime;
+	usleep(NETPOOLTEST_SETTLE * 1000);
+
+	HOSTCHECK(nFailed == 0);
+	HOSTCHECK(gnAccepts - nAccepts == NETPOOLTEST_CLIENTS);
+	printf("  pooled: %u uploads, %u connections, %.1f us/upload\n", NETPOOLTEST_POOLED, gnAccepts - nAccepts, (nTime * 1e6) / NETPOOLTEST_POOLED);
+
+	//Only servers the pool holds clients for can be leased, and only leased clients released
+	sOther = sAddr;
+	sOther.Port = NETPOOLTEST_PORT + 1;
+	HOSTCHECK(NetPoolLease(&gPool, &sOther, &pClient) == NetFail_InvSocket);
+	HOSTCHECK(NetPoolRelease(&gPool, &(gaPoolClients[0]), false) == NetFail_InvSocket);
+
+	//With the server gone each failed attempt waits longer before the next
+	NetPoolTestServerStop();
+	usleep(NETPOOLTEST_SETTLE * 1000);
+
+	HOSTCHECK(NetPoolLease(&gPool, &sAddr, &pClient) != Net_Success);
+
+	nRetries = 0;
+	nLastWait = gPool.aConns[0].nWaitTime;
+	nStart = NetPoolTestTicks();
+	while (NetPoolTestTicks() - nStart < NETPOOLTEST_DOWNTIME) {
+		NetPoolService(&gPool);
+
+		if (gPool.aConns[0].nWaitTime != nLastWait) {
+			nLastWait = gPool.aConns[0].nWaitTime;
+			nRetries += 1;
+		}
+
+		usleep(1000);
+	}
+
+	HOSTCHECK(nRetries > 0);
+	HOSTCHECK(gPool.aConns[0].nWaitTime > NETPOOL_RETRYMIN);
+	printf("  server down %u ms: %u retries, waiting %u ms before the next\n", NETPOOLTEST_DOWNTIME, nRetries, gPool.aConns[0].nWaitTime);
+
+	//Back up, the pool must find it again on its own
+	nAccepts = gnAccepts;
+	HOSTCHECK(NetPoolTestServerStart(&sAddr) == true);
+
+	nStart = NetPoolTestTicks();
+	do {
+		eResult = NetPoolLease(&gPool, &sAddr, &pClient);
+		if (eResult != Net_Success) {
+			usleep(1000);
+		}
+	} while ((eResult != Net_Success) && (NetPoolTestTicks() - nStart < NETPOOLTEST_RECONNECT));
+	nReconnect = NetPoolTestTicks() - nStart;
+
+	if (HOSTCHECK(eResult == Net_Success) == true) {
+		if (pClient->pfSend(pClient, sizeof(gaUpload) - 1, (void *)gaUpload) == Net_Success) {
+			nSent += sizeof(gaUpload) - 1;
+		}
+
+		HOSTCHECK(NetPoolRelease(&gPool, pClient, false) == Net_Success);
+		HOSTCHECK(NetPoolRelease(&gPool, pClient, false) == NetFail_InvSocket);
+	}
+	usleep(NETPOOLTEST_SETTLE * 1000);
+
+	HOSTCHECK(gnAccepts > nAccepts);
+	printf("  server back: reconnected after %u ms\n", nReconnect);
+
+	NetPoolCloseAll(&gPool);
+	usleep(NETPOOLTEST_SETTLE * 1000);
+	NetPoolTestServerStop();
+
+	HOSTCHECK(gnBytes == nSent);
+
+	return HostTestResult("NetPoolTest");
+}
+
+static uint32_t NetPoolTestTicks(void) {
+	return (uint32_t)(HostTestSeconds() * 1000);
+}
+
+static void NetPoolTestHandler(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam) {
+	uint8_t aBuff[1024];
+	uint32_t nRecv;
+	eNetReturn_t eResult;
+
+	if (eEvents == RasPiEpoll_Accepted) {
+		gnAccepts += 1;
+		return;
+	}
+
+	if ((eEvents & RasPiEpoll_Readable) != 0) {
+		do {
+			eResult = pTCPServ->pfReceive(pTCPServ, pSck, sizeof(aBuff), aBuff, &nRecv);
+			gnBytes += nRecv;
+		} while (eResult == Net_Success);
+
+		if (eResult != NetWarn_EndOfData) { //Client is gone
+			pTCPServ->pfCloseSocket(pTCPServ, pSck);
+		}
+	}
+
+	return;
+}
+
+static void *NetPoolTestServerThread(void *pParam) {
+	while (gbRunning == true) {
+		RasPiEpollProcess(&gLoop, 10);
+	}
+
+	return NULL;
+}
+
+static bool NetPoolTestServerStart(sConnInfo_t *pAddr) {
+	if (RasPiEpollInitialize(&gLoop) != Net_Success) {
+		return false;
+	}
+
+	RasPiEpollCreateTCPServer(&gLoop, &gTCPServ);
+	if ((gTCPServ.pfBind(&gTCPServ, pAddr) != Net_Success) ||
+		(RasPiEpollSetHandler(&gTCPServ, &(gTCPServ.HostSck), &NetPoolTestHandler, NULL) != Net_Success)) {
+		RasPiEpollClose(&gLoop);
+		return false;
+	}
+
+	gbRunning = true;
+	pthread_create(&ghServer, NULL, &NetPoolTestServerThread, NULL);
+
+	return true;
+}
+
+static void NetPoolTestServerStop(void) {
+	gbRunning = false;
+	pthread_join(ghServer, NULL);
+
+	RasPiEpollClose(&gLoop);
+
+	return;
+}
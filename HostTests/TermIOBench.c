@@ -0,0 +1,223 @@
+/**	File:	TermIOBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Bytes per second through the IOConnect adapters, writing terminal sized
+	lines with one block call and then with one call per byte as the
+	NoImplement fallbacks do.  Each line is read back before the next is
+	written, in reads smaller than the line as a terminal with little free
+	input space would, and must arrive whole.  The memory pipe, both ends of
+	a loopback TCP connection, and a pair of UDP servers are measured.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "Network_RaspberryPi.h"
+	#include "Terminal.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds each adapter and way of calling is measured for */
+	#define TERMIOBENCH_SECONDS		0.5
+
+	/**	@brief		TCP port the server listens on */
+	#define TERMIOBENCH_TCPPORT		20150
+
+	/**	@brief		UDP port lines are sent to */
+	#define TERMIOBENCH_RXPORT		20151
+
+	/**	@brief		UDP port lines are sent from */
+	#define TERMIOBENCH_TXPORT		20152
+
+	/**	@brief		Bytes in each line, with the line end */
+	#define TERMIOBENCH_LINELEN		46
+
+	/**	@brief		Bytes asked for in each block read, less than a line */
+	#define TERMIOBENCH_READSIZE	16
+
+	/**	@brief		Milliseconds a read waits for data */
+	#define TERMIOBENCH_TIMEOUT		100
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static uint8_t gaLine[TERMIOBENCH_LINELEN];
+
+/*****	Prototypes 	*****/
+	/**	@brief		Send lines for the benchmark time and report the rate
+		@param		pName		Name to report the run under
+		@param		pWriter		Connection the lines are written to
+		@param		pReader		Connection the lines are read back from
+		@param		bBlock		True to use the block calls, false for one call per byte
+		@return		Bytes per second moved
+	*/
+	static double TermIOBenchRun(const char *pName, sIOConnect_t *pWriter, sIOConnect_t *pReader, bool bBlock);
+
+	/**	@brief		Measure one connection both ways of calling
+		@param		pName		Name to report the runs under
+		@param		pWriter		Connection the lines are written to
+		@param		pReader		Connection the lines are read back from
+	*/
+	static void TermIOBenchCompare(const char *pName, sIOConnect_t *pWriter, sIOConnect_t *pReader);
+
+/*****	Functions	*****/
+int main(void) {
+	static uint8_t aPipeBuff[1024];
+	static sIOCnctUDP_t sUDPTx, sUDPRx;
+	sIOCnctPipe_t sPipe;
+	sTCPServ_t sTCPServ;
+	sTCPClient_t sTCPClient;
+	sUDPServ_t sUDPServTx, sUDPServRx;
+	sSocket_t sSck;
+	sConnInfo_t sAddr;
+	sIOConnect_t sWriter, sReader;
+	uint32_t nCtr;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	for (nCtr = 0; nCtr < TERMIOBENCH_LINELEN - 2; nCtr++) {
+		gaLine[nCtr] = 'A' + (nCtr % 26);
+	}
+	gaLine[nCtr++] = '\r';
+	gaLine[nCtr++] = '\n';
+
+	//Both ends share one pipe so lines written are read straight back
+	IOCnctPipeInitialize(&sPipe, aPipeBuff, sizeof(aPipeBuff));
+	IOCnctCreateFromPipes(&sPipe, &sPipe, &sWriter);
+	IOCnctCreateFromPipes(&sPipe, &sPipe, &sReader);
+	TermIOBenchCompare("pipe", &sWriter, &sReader);
+
+	//TCP connection over loopback, measured from each end
+	RasPiTCPServInitialize(&sTCPServ);
+	RasPiTCPClientInitialize(&sTCPClient);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = TERMIOBENCH_TCPPORT;
+	if ((HOSTCHECK(sTCPServ.pfBind(&sTCPServ, &sAddr) == Net_Success) == false) ||
+		(HOSTCHECK(sTCPClient.pfConnect(&sTCPClient, &sAddr) == Net_Success) == false) ||
+		(HOSTCHECK(sTCPServ.pfAcceptClient(&sTCPServ, &sSck) == Net_Success) == false)) {
+		return HostTestResult("TermIOBench");
+	}
+
+	sTCPServ.pfSetRecvTimeout(&sTCPServ, &sSck, TERMIOBENCH_TIMEOUT);
+	sTCPClient.pfSetRecvTimeout(&sTCPClient, TERMIOBENCH_TIMEOUT);
+
+	IOCnctCreateFromTCPSocket(&sTCPServ, &sSck, &sWriter);
+	IOCnctCreateFromTCPClient(&sTCPClient, &sReader);
+	TermIOBenchCompare("TCP server", &sWriter, &sReader);
+	TermIOBenchCompare("TCP client", &sReader, &sWriter);
+
+	sTCPClient.pfClose(&sTCPClient);
+	sTCPServ.pfCloseSocket(&sTCPServ, &sSck);
+	sTCPServ.pfCloseHost(&sTCPServ);
+
+	//UDP servers, the sender's peer is the receiver
+	RasPiUDPServInitialize(&sUDPServTx);
+	RasPiUDPServInitialize(&sUDPServRx);
+
+	sAddr.Port = TERMIOBENCH_RXPORT;
+	if (HOSTCHECK(sUDPServRx.pfBind(&sUDPServRx, &sAddr) == Net_Success) == false) {
+		return HostTestResult("TermIOBench");
+	}
+	sUDPServRx.pfSetRecvTimeout(&sUDPServRx, TERMIOBENCH_TIMEOUT);
+
+	sAddr.Port = TERMIOBENCH_TXPORT;
+	if (HOSTCHECK(sUDPServTx.pfBind(&sUDPServTx, &sAddr) == Net_Success) == false) {
+		return HostTestResult("TermIOBench");
+	}
+
+	IOCnctCreateFromUDPServ(&sUDPServTx, &sUDPTx, &sWriter);
+	IOCnctCreateFromUDPServ(&sUDPServRx, &sUDPRx, &sReader);
+	sUDPTx.sPeer.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sUDPTx.sPeer.Port = TERMIOBENCH_RXPORT;
+	TermIOBenchCompare("UDP server", &sWriter, &sReader);
+
+	HOSTCHECK(sUDPRx.sPeer.Port == TERMIOBENCH_TXPORT); //Replies would go back to the sender
+
+	sUDPServTx.pfCloseHost(&sUDPServTx);
+	sUDPServRx.pfCloseHost(&sUDPServRx);
+
+	return HostTestResult("TermIOBench");
+}
+
+static void TermIOBenchCompare(const char *pName, sIOConnect_t *pWriter, sIOConnect_t *pReader) {
+	double nBlock, nByte;
+
+	nBlock = TermIOBenchRun(pName, pWriter, pReader, true);
+	nByte = TermIOBenchRun(pName, pWriter, pReader, false);
+
+	if (nByte > 0) {
+		printf("  %-12s block calls are %.1f times faster\n", pName, nBlock / nByte);
+	}
+
+	return;
+}
+
+static double TermIOBenchRun(const char *pName, sIOConnect_t *pWriter, sIOConnect_t *pReader, bool bBlock) {
+	uint8_t aRead[TERMIOBENCH_LINELEN];
+	uint64_t nLines = 0, nBad = 0;
+	uint32_t nCtr, nLen, nRead;
+	double nStart, nTime;
+	eReturn_t eResult;
+
+	nStart = HostTestSeconds();
+	do {
+		//Write the line
+		if (bBlock == true) {
+			eResult = pWriter->pfWriteData(pWriter, gaLine, TERMIOBENCH_LINELEN);
+		} else {
+			for (nCtr = 0; nCtr < TERMIOBENCH_LINELEN; nCtr++) {
+				eResult = pWriter->pfWriteByte(pWriter, gaLine[nCtr]);
+				if (eResult != Success) {
+					break;
+				}
+			}
+		}
+
+		if (eResult != Success) {
+			nBad += 1;
+			break;
+		}
+
+		//Read it back, a read that finds nothing means bytes were lost
+		nLen = 0;
+		while (nLen < TERMIOBENCH_LINELEN) {
+			if (bBlock == true) {
+				eResult = pReader->pfReadData(pReader, &(aRead[nLen]), GetSmallerNum(TERMIOBENCH_READSIZE, TERMIOBENCH_LINELEN - nLen), &nRead);
+			} else {
+				eResult = pReader->pfReadByte(pReader, &(aRead[nLen]));
+				nRead = (eResult == Success) ? 1 : 0;
+			}
+
+			if ((eResult < Success) || (nRead == 0)) {
+				break;
+			}
+
+			nLen += nRead;
+		}
+
+		if ((nLen != TERMIOBENCH_LINELEN) || (memcmp(aRead, gaLine, TERMIOBENCH_LINELEN) != 0)) {
+			nBad += 1;
+			break;
+		}
+
+		nLines += 1;
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < TERMIOBENCH_SECONDS);
+
+	nTime = HostTestSeconds() - nStart;
+
+	printf("  %-12s %-14s %8.2f MB/s\n", pName, (bBlock == true) ? "block calls" : "call per byte", (nLines * TERMIOBENCH_LINELEN) / nTime / 1e6);
+	HOSTCHECK(nBad == 0);
+	HOSTCHECK(nLines > 0);
+
+	return (nLines * TERMIOBENCH_LINELEN) / nTime;
+}
@@ -0,0 +1,104 @@
+/**	File:	TermServClient.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Client for TermServTest.sh that does what bash can't: half closes.  Opens
+	the number of connections given to the port given, one after another.
+	Each sends "get who", shuts down its sending side, reads the reply, and
+	closes.  The request and the shut down usually reach the server together,
+	and no reset follows since the reply is read, so the server must notice
+	the hang up with the request to free the session.
+*/
+
+/*****	Includes	*****/
+	#include <stdlib.h>
+	#include <string.h>
+	#include <sys/socket.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "Network_RaspberryPi.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		TCP port connected to when none is given */
+	#define TERMSERVCLIENT_PORT		20140
+
+	/**	@brief		Connections made when no count is given */
+	#define TERMSERVCLIENT_COUNT	50
+
+	/**	@brief		Milliseconds to wait for a reply */
+	#define TERMSERVCLIENT_TIMEOUT	2000
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+	/**	@brief		Request each client sends */
+	static const char gaRequest[] = "get who\r\n";
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Make one connection, send the request, half close, and read the reply
+		@param		pAddr		Server to connect to
+		@return		True if a whole reply line came back
+	*/
+	static bool TermServClientRequest(sConnInfo_t *pAddr);
+
+/*****	Functions	*****/
+int main(int nArgCnt, char *aArgs[]) {
+	sConnInfo_t sAddr;
+	uint32_t nCount, nCtr, nReplies = 0;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = (nArgCnt > 1) ? atoi(aArgs[1]) : TERMSERVCLIENT_PORT;
+	nCount = (nArgCnt > 2) ? atoi(aArgs[2]) : TERMSERVCLIENT_COUNT;
+
+	for (nCtr = 0; nCtr < nCount; nCtr++) {
+		if (TermServClientRequest(&sAddr) == true) {
+			nReplies += 1;
+		}
+	}
+
+	printf("%u clients half closed, %u replies read\n", nCount, nReplies);
+	HOSTCHECK(nReplies == nCount);
+
+	return HostTestResult("TermServClient");
+}
+
+static bool TermServClientRequest(sConnInfo_t *pAddr) {
+	sTCPClient_t sClient;
+	char aReply[64];
+	uint32_t nLen = 0, nRecv;
+	bool bLine = false;
+
+	RasPiTCPClientInitialize(&sClient);
+	if (sClient.pfConnect(&sClient, pAddr) != Net_Success) {
+		return false;
+	}
+
+	sClient.pfSetRecvTimeout(&sClient, TERMSERVCLIENT_TIMEOUT);
+
+	if (sClient.pfSend(&sClient, sizeof(gaRequest) - 1, (void *)gaRequest) == Net_Success) {
+		//The interface has no half close, the socket is used directly
+		shutdown(sClient.Sck.nSocket, SHUT_WR);
+
+		while ((bLine == false) && (nLen < sizeof(aReply))) {
+			if ((sClient.pfReceive(&sClient, sizeof(aReply) - nLen, &(aReply[nLen]), &nRecv) < Net_Success) || (nRecv == 0)) {
+				break;
+			}
+
+			bLine = (memchr(&(aReply[nLen]), '\n', nRecv) != NULL) ? true : false;
+			nLen += nRecv;
+		}
+	}
+
+	sClient.pfClose(&sClient);
+
+	return bLine;
+}
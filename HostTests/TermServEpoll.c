@@ -0,0 +1,153 @@
+/**	File:	TermServEpoll.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Terminal session server on the epoll event loop for TermServTest.sh.
+	Listens on the port given, or TERMSERVEPOLL_PORT, and prints "ready" once
+	clients can connect.  Each session is named in the order it opened, with
+	the name kept as its handler context, and answers two requests:
+		get who			replies with the session's name
+		get sessions	replies with the number of sessions open
+	Runs until SIGTERM or SIGINT, then closes everything and checks that
+	every session opened was closed.
+*/
+
+/*****	Includes	*****/
+	#include <stdlib.h>
+	#include <string.h>
+	#include <signal.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "TerminalServer.h"
+	#include "TerminalEpoll_RaspberryPi.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		TCP port listened on when none is given */
+	#define TERMSERVEPOLL_PORT		20140
+
+	/**	@brief		Longest session name */
+	#define TERMSERVEPOLL_NAMELEN	16
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	/**	@brief		Event loop, too large for the stack */
+	static sRasPiEpoll_t gLoop;
+
+	static sTCPServ_t gTCPServ;
+
+	static sTermServ_t gTermServ;
+
+	/**	@brief		Handler context of each session, fixed like the session pool */
+	static char gaNames[TERMSERV_MAXSESSIONS][TERMSERVEPOLL_NAMELEN];
+
+	static uint32_t gnOpened;
+
+	static uint32_t gnClosed;
+
+	/**	@brief		Cleared by a signal to stop serving */
+	static volatile sig_atomic_t gbRunning;
+
+/*****	Prototypes 	*****/
+	static void TermServEpollOpened(sTermServ_t *pTermServ, sTerminal_t *pTerm);
+
+	static void TermServEpollClosed(sTermServ_t *pTermServ, sTerminal_t *pTerm);
+
+	/**	@brief		Answers the who and sessions requests */
+	static eReturn_t TermServEpollGet(sTerminal_t *pTerm, const char *pKey);
+
+	static void TermServEpollStop(int nSignal);
+
+/*****	Functions	*****/
+int main(int nArgCnt, char *aArgs[]) {
+	sConnInfo_t sAddr;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	signal(SIGTERM, &TermServEpollStop);
+	signal(SIGINT, &TermServEpollStop);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = (nArgCnt > 1) ? atoi(aArgs[1]) : TERMSERVEPOLL_PORT;
+
+	if (HOSTCHECK(RasPiEpollInitialize(&gLoop) == Net_Success) == false) {
+		return HostTestResult("TermServEpoll");
+	}
+
+	RasPiEpollCreateTCPServer(&gLoop, &gTCPServ);
+	if (HOSTCHECK(gTCPServ.pfBind(&gTCPServ, &sAddr) == Net_Success) == false) {
+		return HostTestResult("TermServEpoll");
+	}
+
+	TermServInitialize(&gTermServ, &gTCPServ);
+	gTermServ.pfOpened = &TermServEpollOpened;
+	gTermServ.pfClosed = &TermServEpollClosed;
+	gTermServ.Template.pfAddGetHandler(&(gTermServ.Template), &TermServEpollGet);
+
+	if (HOSTCHECK(RasPiEpollServeTerminals(&gTermServ) == Success) == false) {
+		return HostTestResult("TermServEpoll");
+	}
+
+	gbRunning = true;
+	printf("ready\n");
+
+	while (gbRunning == true) {
+		RasPiEpollProcess(&gLoop, 1000);
+	}
+
+	printf("opened %u, closed %u, still open %u\n", gnOpened, gnClosed, gTermServ.nSessionCnt);
+
+	TermServCloseAll(&gTermServ);
+	HOSTCHECK(gnOpened == gnClosed);
+	HOSTCHECK(gTermServ.nSessionCnt == 0);
+
+	RasPiEpollClose(&gLoop);
+
+	return HostTestResult("TermServEpoll");
+}
+
+static void TermServEpollOpened(sTermServ_t *pTermServ, sTerminal_t *pTerm) {
+	//Terminal is the first member of its session, the session's place in the pool picks its name
+	uint32_t nIdx = (sTermSession_t *)pTerm - pTermServ->aSessions;
+
+	snprintf(gaNames[nIdx], TERMSERVEPOLL_NAMELEN, "s%u", gnOpened);
+	pTerm->pContext = gaNames[nIdx];
+	gnOpened += 1;
+
+	return;
+}
+
+static void TermServEpollClosed(sTermServ_t *pTermServ, sTerminal_t *pTerm) {
+	pTerm->pContext = NULL;
+	gnClosed += 1;
+
+	return;
+}
+
+static eReturn_t TermServEpollGet(sTerminal_t *pTerm, const char *pKey) {
+	char aText[TERMSERVEPOLL_NAMELEN];
+
+	if (strcmp(pKey, "who") == 0) {
+		return pTerm->pfWriteTextLine(pTerm, (char *)pTerm->pContext);
+	}
+
+	if (strcmp(pKey, "sessions") == 0) {
+		snprintf(aText, sizeof(aText), "%u", gTermServ.nSessionCnt);
+		return pTerm->pfWriteTextLine(pTerm, aText);
+	}
+
+	return Fail_Invalid;
+}
+
+static void TermServEpollStop(int nSignal) {
+	gbRunning = false;
+
+	return;
+}
@@ -0,0 +1,123 @@
+#!/bin/bash
+#	File:	TermServTest.sh
+#	Author:	J. Beighel
+#	Date:	2026-10-18
+#
+#	Opens 200 terminal sessions on TermServEpoll.exe at once and checks:
+#		every session answers with its own handler context,
+#		a request split across two writes is put back together,
+#		the server uses no CPU while all sessions sit idle,
+#		closing clients frees their sessions,
+#		clients that send a request and half close free theirs too,
+#		the server closes every session it opened when stopped.
+#	Needs only bash, its /dev/tcp redirection makes the connections.  Bash
+#	can't half close, TermServClient.exe makes those connections.
+
+PORT=${1:-20140}
+SESSIONS=200
+CLOSED=100
+HITANDRUN=50
+IDLESECS=2
+IDLETICKS=2
+
+FAILS=0
+SERVLOG=$(mktemp)
+CLIENTLOG=$(mktemp)
+
+#Report a failed check and count it
+fail() {
+	echo "FAILED: $1"
+	FAILS=$((FAILS + 1))
+}
+
+#Send a request on a session and read back the one line reply into REPLY
+request() {
+	printf '%s\r\n' "$2" >&"$1"
+	REPLY=""
+	read -r -t 2 -u "$1" REPLY
+	REPLY=${REPLY%$'\r'}
+}
+
+#User and system CPU ticks the server has used
+cputicks() {
+	local STAT
+	read -r -a STAT < /proc/$SERVPID/stat
+	echo $((STAT[13] + STAT[14]))
+}
+
+./TermServEpoll.exe "$PORT" > "$SERVLOG" &
+SERVPID=$!
+
+for TRY in $(seq 50); do
+	grep -q ready "$SERVLOG" && break
+	sleep 0.1
+done
+
+if ! grep -q ready "$SERVLOG"; then
+	echo "FAILED: server did not start"
+	kill $SERVPID 2> /dev/null
+	rm -f "$SERVLOG" "$CLIENTLOG"
+	exit 1
+fi
+
+#Every session stays open for the whole test
+FDS=()
+for N in $(seq $SESSIONS); do
+	if ! exec {FD}<>/dev/tcp/127.0.0.1/$PORT; then
+		fail "session $N did not connect"
+		break
+	fi
+	FDS+=($FD)
+done
+echo "  $SESSIONS sessions connected"
+
+declare -A NAMES
+for FD in "${FDS[@]}"; do
+	request $FD "get who"
+	NAMES[$REPLY]=1
+done
+[ ${#NAMES[@]} -eq $SESSIONS ] || fail "${#NAMES[@]} distinct replies from $SESSIONS sessions"
+
+#Half a request, a pause, then the rest
+printf 'get w' >&${FDS[1]}
+sleep 0.1
+printf 'ho\r\n' >&${FDS[1]}
+read -r -t 2 -u ${FDS[1]} SPLIT
+SPLIT=${SPLIT%$'\r'}
+request ${FDS[1]} "get who"
+[ -n "$SPLIT" ] && [ "$SPLIT" = "$REPLY" ] || fail "split request answered '$SPLIT', expected '$REPLY'"
+
+START=$(cputicks)
+sleep $IDLESECS
+IDLE=$(($(cputicks) - START))
+echo "  server CPU over ${IDLESECS} s with $SESSIONS idle sessions: $IDLE ticks"
+[ $IDLE -le $IDLETICKS ] || fail "idle sessions used $IDLE ticks"
+
+for FD in "${FDS[@]:0:$CLOSED}"; do
+	exec {FD}>&-
+done
+sleep 0.3
+
+request ${FDS[$CLOSED]} "get sessions"
+[ "$REPLY" = "$((SESSIONS - CLOSED))" ] || fail "$REPLY sessions open after closing $CLOSED of $SESSIONS"
+
+#The request and the close can reach the server together, the session must still close
+./TermServClient.exe "$PORT" $HITANDRUN > "$CLIENTLOG" || fail "half closed clients were not answered"
+sed 's/^/  /' "$CLIENTLOG"
+sleep 0.3
+
+request ${FDS[$CLOSED]} "get sessions"
+[ "$REPLY" = "$((SESSIONS - CLOSED))" ] || fail "$REPLY sessions open after $HITANDRUN clients sent a request and closed"
+
+kill -TERM $SERVPID
+wait $SERVPID || fail "server reported failures"
+sed 's/^/  /' "$SERVLOG"
+rm -f "$SERVLOG" "$CLIENTLOG"
+
+if [ $FAILS -ne 0 ]; then
+	echo "TermServTest: $FAILS checks failed"
+	exit 1
+fi
+
+echo "TermServTest: all checks passed"
+exit 0
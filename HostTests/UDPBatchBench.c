@@ -0,0 +1,210 @@
+/**	File:	UDPBatchBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Loopback packets per second benchmark for the UDP server batch calls.
+	One server sends UDPBATCHBENCH_PKTSIZE byte datagrams to another, first
+	one pfSend() and pfReceive() per datagram and then UDPBATCHBENCH_BATCH
+	at a time with pfSendBatch() and pfReceiveBatch().  Each round sends
+	UDPBATCHBENCH_ROUND datagrams, few enough for the receiving socket to
+	hold, then drains them so sending and receiving are timed apart.  Every
+	datagram must arrive whole and from the sender.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "Network_RaspberryPi.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds each way of sending is measured for */
+	#define UDPBATCHBENCH_SECONDS	1.0
+
+	/**	@brief		UDP port datagrams are sent to */
+	#define UDPBATCHBENCH_RXPORT	20130
+
+	/**	@brief		UDP port datagrams are sent from */
+	#define UDPBATCHBENCH_TXPORT	20131
+
+	/**	@brief		Bytes in each datagram */
+	#define UDPBATCHBENCH_PKTSIZE	64
+
+	/**	@brief		Datagrams handed over in each batch call */
+	#define UDPBATCHBENCH_BATCH		64
+
+	/**	@brief		Datagrams sent before the receiver drains them */
+	#define UDPBATCHBENCH_ROUND		256
+
+	/**	@brief		Milliseconds a receive waits before the round is counted as short */
+	#define UDPBATCHBENCH_TIMEOUT	100
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	static sUDPServ_t gRx;
+
+	static sUDPServ_t gTx;
+
+	static uint8_t gaTxData[UDPBATCHBENCH_BATCH][UDPBATCHBENCH_PKTSIZE];
+
+	/**	@brief		Receive buffers, larger than the datagrams to catch any that grew */
+	static uint8_t gaRxData[UDPBATCHBENCH_BATCH][UDPBATCHBENCH_PKTSIZE * 2];
+
+	static sNetPacket_t gaTxPkts[UDPBATCHBENCH_BATCH];
+
+	static sNetPacket_t gaRxPkts[UDPBATCHBENCH_BATCH];
+
+/*****	Prototypes 	*****/
+	/**	@brief		Send and drain rounds for the benchmark time and report the rates
+		@param		pName		Name to report the run under
+		@param		bBatch		True to use the batch calls, false for one datagram per call
+	*/
+	static void UDPBatchBenchRun(const char *pName, bool bBatch);
+
+	/**	@brief		Send one round of datagrams
+		@param		bBatch		True to use the batch call
+		@return		Number of datagrams the socket took
+	*/
+	static uint32_t UDPBatchBenchSend(bool bBatch);
+
+	/**	@brief		Receive the datagrams of one round
+		@param		bBatch		True to use the batch call
+		@param		nExpected	Datagrams sent in the round
+		@param		pnBad		Incremented for each datagram that is the wrong size or from elsewhere
+		@return		Number of datagrams received
+	*/
+	static uint32_t UDPBatchBenchDrain(bool bBatch, uint32_t nExpected, uint64_t *pnBad);
+
+/*****	Functions	*****/
+int main(void) {
+	sConnInfo_t sAddr;
+	uint32_t nCtr, nSeed = 3;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	RasPiUDPServInitialize(&gRx);
+	RasPiUDPServInitialize(&gTx);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = UDPBATCHBENCH_RXPORT;
+	if (HOSTCHECK(gRx.pfBind(&gRx, &sAddr) == Net_Success) == false) {
+		return HostTestResult("UDPBatchBench");
+	}
+	gRx.pfSetRecvTimeout(&gRx, UDPBATCHBENCH_TIMEOUT);
+
+	sAddr.Port = UDPBATCHBENCH_TXPORT;
+	if (HOSTCHECK(gTx.pfBind(&gTx, &sAddr) == Net_Success) == false) {
+		return HostTestResult("UDPBatchBench");
+	}
+
+	for (nCtr = 0; nCtr < UDPBATCHBENCH_BATCH; nCtr++) {
+		HostTestRandom(&nSeed, gaTxData[nCtr], UDPBATCHBENCH_PKTSIZE);
+
+		gaTxPkts[nCtr].Conn.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+		gaTxPkts[nCtr].Conn.Port = UDPBATCHBENCH_RXPORT;
+		gaTxPkts[nCtr].pData = gaTxData[nCtr];
+		gaTxPkts[nCtr].nBytes = UDPBATCHBENCH_PKTSIZE;
+
+		gaRxPkts[nCtr].pData = gaRxData[nCtr];
+		gaRxPkts[nCtr].nBuffSize = sizeof(gaRxData[nCtr]);
+	}
+
+	HOSTCHECK(CheckAllBitsInMask(gRx.eCapabilities, UDPServ_RecvBatch | UDPServ_SendBatch) == true);
+
+	UDPBatchBenchRun("one datagram per call", false);
+	UDPBatchBenchRun("batches of 64", true);
+
+	gRx.pfCloseHost(&gRx);
+	gTx.pfCloseHost(&gTx);
+
+	return HostTestResult("UDPBatchBench");
+}
+
+static void UDPBatchBenchRun(const char *pName, bool bBatch) {
+	uint64_t nSent = 0, nRecv = 0, nBad = 0;
+	uint32_t nRound;
+	double nStart, nSendTime = 0, nRecvTime = 0;
+
+	do {
+		nStart = HostTestSeconds();
+		nRound = UDPBatchBenchSend(bBatch);
+		nSendTime += HostTestSeconds() - nStart;
+		nSent += nRound;
+
+		nStart = HostTestSeconds();
+		nRecv += UDPBatchBenchDrain(bBatch, nRound, &nBad);
+		nRecvTime += HostTestSeconds() - nStart;
+	} while (nSendTime + nRecvTime < UDPBATCHBENCH_SECONDS);
+
+	HOSTCHECK(nSent > 0);
+	HOSTCHECK(nRecv == nSent);
+	HOSTCHECK(nBad == 0);
+	printf("  %-24s send %10.0f packets/s, receive %10.0f packets/s\n", pName, nSent / nSendTime, nRecv / nRecvTime);
+
+	return;
+}
+
+static uint32_t UDPBatchBenchSend(bool bBatch) {
+	uint32_t nSent = 0, nTaken;
+
+	while (nSent < UDPBATCHBENCH_ROUND) {
+		if (bBatch == true) {
+			if (gTx.pfSendBatch(&gTx, UDPBATCHBENCH_BATCH, gaTxPkts, &nTaken) != Net_Success) {
+				break;
+			}
+		} else {
+			for (nTaken = 0; nTaken < UDPBATCHBENCH_BATCH; nTaken++) {
+				if (gTx.pfSend(&gTx, &(gaTxPkts[nTaken].Conn), gaTxPkts[nTaken].nBytes, gaTxPkts[nTaken].pData) != Net_Success) {
+					break;
+				}
+			}
+		}
+
+		nSent += nTaken;
+		if (nTaken < UDPBATCHBENCH_BATCH) {
+			break;
+		}
+	}
+
+	return nSent;
+}
+
+static uint32_t UDPBatchBenchDrain(bool bBatch, uint32_t nExpected, uint64_t *pnBad) {
+	uint32_t nRecv = 0, nGot, nCtr;
+
+	while (nRecv < nExpected) {
+		if (bBatch == true) {
+			if (gRx.pfReceiveBatch(&gRx, UDPBATCHBENCH_BATCH, gaRxPkts, &nGot) != Net_Success) {
+				break;
+			}
+		} else {
+			if (gRx.pfReceive(&gRx, &(gaRxPkts[0].Conn), gaRxPkts[0].nBuffSize, gaRxPkts[0].pData, &(gaRxPkts[0].nBytes)) != Net_Success) {
+				break;
+			}
+
+			nGot = (gaRxPkts[0].nBytes > 0) ? 1 : 0;
+		}
+
+		if (nGot == 0) { //Timed out, the rest were lost
+			break;
+		}
+
+		for (nCtr = 0; nCtr < nGot; nCtr++) {
+			if ((gaRxPkts[nCtr].nBytes != UDPBATCHBENCH_PKTSIZE) || (gaRxPkts[nCtr].Conn.Port != UDPBATCHBENCH_TXPORT)) {
+				*pnBad += 1;
+			}
+		}
+
+		nRecv += nGot;
+	}
+
+	return nRecv;
+}
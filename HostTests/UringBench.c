@@ -0,0 +1,256 @@
+/**	File:	UringBench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Compares the io_uring network interface with the plain sockets one over
+	loopback.  A TCP client and a UDP client of each kind send
+	URINGBENCH_FRAMESIZE byte frames through the general interface as fast
+	as they can, to a plain sockets receiver running in its own thread so
+	both are measured against the same far end.  Frames sent per second are
+	reported, TCP must deliver every byte while UDP reports what arrived.
+	The io_uring runs are skipped if the kernel can't run the ring.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <arpa/inet.h>
+
+	#include "CommonUtils.h"
+	#include "Network_RaspberryPi.h"
+	#include "NetworkUring_RaspberryPi.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Seconds each client sends for */
+	#define URINGBENCH_SECONDS		1.0
+
+	/**	@brief		TCP port the receiver listens on */
+	#define URINGBENCH_TCPPORT		20120
+
+	/**	@brief		UDP port the receiver listens on */
+	#define URINGBENCH_UDPPORT		20121
+
+	/**	@brief		Bytes in each frame sent */
+	#define URINGBENCH_FRAMESIZE	64
+
+	/**	@brief		Milliseconds of quiet that end a UDP run at the receiver */
+	#define URINGBENCH_UDPQUIET		200
+
+/*****	Definitions	*****/
+	/**	@brief		Receiver state shared with the sending side */
+	typedef struct sUringBenchSink_t {
+		sTCPServ_t sTCPServ;
+		sUDPServ_t sUDPServ;
+		pthread_t hThread;
+		uint64_t nBytes;				/**< Bytes the receiver took in */
+		uint64_t nPackets;				/**< Datagrams the receiver took in */
+	} sUringBenchSink_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+	/**	@brief		Ring holds every buffer, too large for the stack */
+	static sRasPiUring_t gRing;
+
+	static sUringBenchSink_t gSink;
+
+/*****	Prototypes 	*****/
+	/**	@brief		Accept one client and count bytes until it closes */
+	static void *UringBenchTCPSink(void *pParam);
+
+	/**	@brief		Count datagrams until none arrive for URINGBENCH_UDPQUIET */
+	static void *UringBenchUDPSink(void *pParam);
+
+	/**	@brief		Send frames on a TCP client for the benchmark time and check they all arrive
+		@param		pName		Name to report the run under
+		@param		pClient		Client to connect and send with
+		@param		pRing		Ring the client runs on, NULL for plain sockets
+	*/
+	static void UringBenchTCP(const char *pName, sTCPClient_t *pClient, sRasPiUring_t *pRing);
+
+	/**	@brief		Send frames on a UDP client for the benchmark time
+		@param		pName		Name to report the run under
+		@param		pClient		Client to send with
+		@param		pRing		Ring the client runs on, NULL for plain sockets
+	*/
+	static void UringBenchUDP(const char *pName, sUDPClient_t *pClient, sRasPiUring_t *pRing);
+
+/*****	Functions	*****/
+int main(void) {
+	sTCPClient_t sTCPClient;
+	sUDPClient_t sUDPClient;
+	sConnInfo_t sAddr;
+	eNetReturn_t eResult;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	RasPiTCPServInitialize(&(gSink.sTCPServ));
+	RasPiUDPServInitialize(&(gSink.sUDPServ));
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = URINGBENCH_TCPPORT;
+	if (HOSTCHECK(gSink.sTCPServ.pfBind(&(gSink.sTCPServ), &sAddr) == Net_Success) == false) {
+		return HostTestResult("UringBench");
+	}
+
+	sAddr.Port = URINGBENCH_UDPPORT;
+	if (HOSTCHECK(gSink.sUDPServ.pfBind(&(gSink.sUDPServ), &sAddr) == Net_Success) == false) {
+		return HostTestResult("UringBench");
+	}
+	gSink.sUDPServ.pfSetRecvTimeout(&(gSink.sUDPServ), URINGBENCH_UDPQUIET);
+
+	RasPiTCPClientInitialize(&sTCPClient);
+	UringBenchTCP("TCP client, plain sockets", &sTCPClient, NULL);
+
+	RasPiUDPClientInitialize(&sUDPClient);
+	UringBenchUDP("UDP client, plain sockets", &sUDPClient, NULL);
+	close(sUDPClient.Sck.nSocket);
+
+	eResult = RasPiUringInitialize(&gRing);
+	if (eResult == Net_Success) {
+		RasPiUringCreateTCPClient(&gRing, &sTCPClient);
+		UringBenchTCP("TCP client, io_uring", &sTCPClient, &gRing);
+
+		RasPiUringCreateUDPClient(&gRing, &sUDPClient);
+		UringBenchUDP("UDP client, io_uring", &sUDPClient, &gRing);
+
+		RasPiUringClose(&gRing);
+	} else { //Programs fall back to plain sockets the same way
+		printf("  io_uring not available (%d), runs skipped\n", eResult);
+	}
+
+	gSink.sTCPServ.pfCloseHost(&(gSink.sTCPServ));
+	gSink.sUDPServ.pfCloseHost(&(gSink.sUDPServ));
+
+	return HostTestResult("UringBench");
+}
+
+static void *UringBenchTCPSink(void *pParam) {
+	static uint8_t aBuff[65536];
+	sUringBenchSink_t *pSink = (sUringBenchSink_t *)pParam;
+	sSocket_t sClient;
+	uint32_t nRecv;
+	eNetReturn_t eResult;
+
+	pSink->nBytes = 0;
+	if (pSink->sTCPServ.pfAcceptClient(&(pSink->sTCPServ), &sClient) != Net_Success) {
+		return NULL;
+	}
+
+	do {
+		eResult = pSink->sTCPServ.pfReceive(&(pSink->sTCPServ), &sClient, sizeof(aBuff), aBuff, &nRecv);
+		pSink->nBytes += nRecv;
+	} while (eResult >= Net_Success);
+
+	pSink->sTCPServ.pfCloseSocket(&(pSink->sTCPServ), &sClient);
+
+	return NULL;
+}
+
+static void *UringBenchUDPSink(void *pParam) {
+	sUringBenchSink_t *pSink = (sUringBenchSink_t *)pParam;
+	uint8_t aBuff[URINGBENCH_FRAMESIZE];
+	sConnInfo_t sFrom;
+	uint32_t nRecv;
+	eNetReturn_t eResult;
+
+	pSink->nPackets = 0;
+	while (true) {
+		eResult = pSink->sUDPServ.pfReceive(&(pSink->sUDPServ), &sFrom, sizeof(aBuff), aBuff, &nRecv);
+
+		if ((eResult < Net_Success) || (nRecv == 0)) { //Sender has stopped
+			break;
+		}
+
+		pSink->nPackets += 1;
+	}
+
+	return NULL;
+}
+
+static void UringBenchTCP(const char *pName, sTCPClient_t *pClient, sRasPiUring_t *pRing) {
+	uint8_t aFrame[URINGBENCH_FRAMESIZE];
+	uint64_t nFrames = 0, nFailed = 0;
+	uint32_t nSeed = 5;
+	sConnInfo_t sAddr;
+	double nStart, nTime;
+
+	pthread_create(&(gSink.hThread), NULL, &UringBenchTCPSink, &gSink);
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = URINGBENCH_TCPPORT;
+	if (HOSTCHECK(pClient->pfConnect(pClient, &sAddr) == Net_Success) == false) {
+		pthread_cancel(gSink.hThread);
+		return;
+	}
+
+	HostTestRandom(&nSeed, aFrame, sizeof(aFrame));
+
+	nStart = HostTestSeconds();
+	do {
+		if (pClient->pfSend(pClient, sizeof(aFrame), aFrame) != Net_Success) {
+			nFailed += 1;
+		}
+		nFrames += 1;
+
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < URINGBENCH_SECONDS);
+
+	//Close waits for anything still queued, so count it in the time
+	pClient->pfClose(pClient);
+	nTime = HostTestSeconds() - nStart;
+
+	pthread_join(gSink.hThread, NULL);
+
+	HOSTCHECK(nFailed == 0);
+	HOSTCHECK(gSink.nBytes == nFrames * URINGBENCH_FRAMESIZE);
+	printf("  %-28s %10.0f frames/s\n", pName, nFrames / nTime);
+
+	return;
+}
+
+static void UringBenchUDP(const char *pName, sUDPClient_t *pClient, sRasPiUring_t *pRing) {
+	uint8_t aFrame[URINGBENCH_FRAMESIZE];
+	uint64_t nFrames = 0, nFailed = 0;
+	uint32_t nSeed = 7;
+	sConnInfo_t sAddr;
+	double nStart, nTime;
+
+	sAddr.Addr.nNetLong = htonl(INADDR_LOOPBACK);
+	sAddr.Port = URINGBENCH_UDPPORT;
+	if (HOSTCHECK(pClient->pfSetServer(pClient, &sAddr) == Net_Success) == false) {
+		return;
+	}
+
+	pthread_create(&(gSink.hThread), NULL, &UringBenchUDPSink, &gSink);
+
+	HostTestRandom(&nSeed, aFrame, sizeof(aFrame));
+
+	nStart = HostTestSeconds();
+	do {
+		if (pClient->pfSend(pClient, sizeof(aFrame), aFrame) != Net_Success) {
+			nFailed += 1;
+		}
+		nFrames += 1;
+
+		nTime = HostTestSeconds() - nStart;
+	} while (nTime < URINGBENCH_SECONDS);
+
+	if (pRing != NULL) { //Hand over whatever is still queued
+		RasPiUringProcess(pRing, 0);
+	}
+	nTime = HostTestSeconds() - nStart;
+
+	pthread_join(gSink.hThread, NULL);
+
+	//Loopback drops datagrams once the receiver falls behind, some must still arrive
+	HOSTCHECK(nFailed == 0);
+	HOSTCHECK(gSink.nPackets > 0);
+	printf("  %-28s %10.0f frames/s, %.1f%% received\n", pName, nFrames / nTime, (100.0 * gSink.nPackets) / nFrames);
+
+	return;
+}
@@ -0,0 +1,535 @@
+/**	File:	W5500Bench.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Cost of driving the W5500 through the simulated part.  TCP messages are
+	sent and received through the server interface at three sizes, on a bus
+	with block transfers and again with the one call per byte fallback, and
+	the bus calls and bus bytes spent on each MB of payload are reported.
+	Then the listener pool is measured: a burst of connects made before any
+	accept against one listener and against a pool, datagrams that wrap a 2
+	KB receive buffer, and the frames a blocking accept and receive spend
+	waiting 50 ms for the peer when polling and when sleeping on INTn.  Last
+	64 KB is streamed through a 2 KB transmit buffer both ways, without
+	blocking against a peer that only holds a little at a time, through the
+	receive buffer wrap, and into a peer that hangs up part way.  Every byte
+	moved is checked.
+*/
+
+/*****	Includes	*****/
+	#include "GPIO_Simulated.h"		//Sets the POSIX level, must come before system headers
+
+	#include <string.h>
+	#include <time.h>
+	#include <pthread.h>
+
+	#include "CommonUtils.h"
+	#include "SPI_W5500Simulated.h"
+	#include "W5500Driver.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Simulated pin used as the chip select */
+	#define W5500BENCH_CSPIN		5
+
+	/**	@brief		Simulated pin wired to INTn */
+	#define W5500BENCH_INTPIN		6
+
+	/**	@brief		Port the servers are bound to */
+	#define W5500BENCH_PORT			8000
+
+	/**	@brief		Payload moved each way for each message size */
+	#define W5500BENCH_PAYLOAD		(1024 * 1024)
+
+	/**	@brief		Largest message sent */
+	#define W5500BENCH_MSGMAX		8192
+
+	/**	@brief		Bytes streamed through the small buffers */
+	#define W5500BENCH_STREAM		(64 * 1024)
+
+	/**	@brief		Bytes the slow peer holds before it must be read */
+	#define W5500BENCH_WINDOW		333
+
+	/**	@brief		Bytes asked for in each streamed receive, not a divisor of the buffer */
+	#define W5500BENCH_RECVSIZE		700
+
+	/**	@brief		Connects made before the first accept */
+	#define W5500BENCH_BURST		3
+
+	/**	@brief		Datagrams sent through the UDP server */
+	#define W5500BENCH_DATAGRAMS	300
+
+	/**	@brief		Largest datagram sent */
+	#define W5500BENCH_DGRAMMAX		100
+
+	/**	@brief		Milliseconds the peer waits before acting on a blocked call */
+	#define W5500BENCH_DELAYMS		50
+
+	#if W5500SIM_PEERBUFF < W5500BENCH_STREAM
+		#error The simulated peer must hold a whole stream, build with W5500SIM_PEERBUFF of 64 KB or more
+	#endif
+
+/*****	Definitions	*****/
+	/**	@brief		What the peer does once its wait is over */
+	typedef enum eW5500BenchAct_t {
+		W5500BenchAct_Connect,		/**< Connect to the first socket in aSockets that is listening */
+		W5500BenchAct_Write,		/**< Deliver pData to the first socket in aSockets */
+		W5500BenchAct_Close,		/**< Hang up the connection on the first socket in aSockets */
+	} eW5500BenchAct_t;
+
+	/**	@brief		A peer acting from its own thread while the driver is blocked */
+	typedef struct sW5500BenchPeer_t {
+		pthread_t hThread;
+		eW5500BenchAct_t eAction;
+		uint8_t aSockets[W5500_NUMSOCKETS];		/**< Sockets to act on, W5500_NOSOCKET if unused */
+		const uint8_t *pData;					/**< Data to deliver */
+		uint32_t nBytes;						/**< Bytes in pData */
+		bool bDone;								/**< The action succeeded */
+	} sW5500BenchPeer_t;
+
+/*****	Constants	*****/
+	static const uint8_t gaPeerAddr[4] = { 192, 168, 1, 20 };
+
+/*****	Globals		*****/
+	static sW5500SimInfo_t gSim;
+
+	static sGPIOSimInfo_t gPins;
+
+	static sSPIIface_t gSpi;
+
+	static sGPIOIface_t gGpio;
+
+	static sW5500Obj_t gDev;
+
+	static uint8_t gaSend[W5500BENCH_STREAM];
+
+	static uint8_t gaRecv[W5500BENCH_STREAM];
+
+/*****	Prototypes 	*****/
+	/**	@brief		Reset the part and bring the driver up on it
+		@param		bEvents		True to drive the driver from INTn, false to poll
+		@param		aKB			Buffer KB for each socket, both ways, NULL for the default
+		@return		True if the driver is ready
+	*/
+	static bool W5500BenchSetup(bool bEvents, const uint8_t *aKB);
+
+	/**	@brief		Bind a TCP server and have the peer connect to it
+		@param		pServ		Server to bind
+		@param		pInfo		Interface information of the server
+		@param		pSck		Returns the accepted connection
+		@return		True if the connection was accepted
+	*/
+	static bool W5500BenchConnect(sTCPServ_t *pServ, sW5500IfaceInfo_t *pInfo, sSocket_t *pSck);
+
+	/**	@brief		Start a peer that acts on the part after W5500BENCH_DELAYMS */
+	static void W5500BenchPeerStart(sW5500BenchPeer_t *pPeer);
+
+	static void *W5500BenchPeerThread(void *pParam);
+
+	/**	@brief		Echo messages through the server interface and report the bus cost
+		@param		nMsgLen		Bytes in each message
+		@param		bBlock		True to use the bus block transfers, false for one call per byte
+		@return		Bus calls made for each MB of payload
+	*/
+	static double W5500BenchMessages(uint32_t nMsgLen, bool bBlock);
+
+	/**	@brief		Connect a burst before any accept and count those the server takes
+		@param		nListenCnt	Sockets the server keeps listening
+		@return		Connections accepted
+	*/
+	static uint32_t W5500BenchBurst(uint8_t nListenCnt);
+
+	/**	@brief		Pass datagrams of random lengths through a 2 KB receive buffer */
+	static void W5500BenchDatagrams(void);
+
+	/**	@brief		Frames spent in an accept and a receive that wait on the peer
+		@param		bEvents		True to sleep on INTn, false to poll
+	*/
+	static void W5500BenchWaits(bool bEvents);
+
+	/**	@brief		Stream 64 KB through 2 KB buffers
+		@param		bEvents		True to sleep on INTn, false to poll
+	*/
+	static void W5500BenchStream(bool bEvents);
+
+/*****	Functions	*****/
+int main(void) {
+	uint32_t nSeed = 21, nCtr;
+	double nByte, nBlock;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	HostTestRandom(&nSeed, gaSend, sizeof(gaSend));
+
+	for (nCtr = 200; nCtr <= W5500BENCH_MSGMAX; nCtr = (nCtr == 200) ? 2048 : nCtr * 4) {
+		nByte = W5500BenchMessages(nCtr, false);
+		nBlock = W5500BenchMessages(nCtr, true);
+		HOSTCHECK(nBlock < nByte);
+	}
+
+	printf("  %u connects before an accept, 1 listener took %u", W5500BENCH_BURST, W5500BenchBurst(1));
+	printf(", a pool of %u took %u\n", W5500BENCH_BURST, W5500BenchBurst(W5500BENCH_BURST));
+
+	W5500BenchDatagrams();
+
+	W5500BenchWaits(false);
+	W5500BenchWaits(true);
+
+	W5500BenchStream(false);
+	W5500BenchStream(true);
+
+	return HostTestResult("W5500Bench");
+}
+
+static bool W5500BenchSetup(bool bEvents, const uint8_t *aKB) {
+	GPIOSimPortInitialize(&gGpio, &gPins);
+	W5500SimPortInitialize(&gSpi, &gSim, 1000000, SPI_MSBFirst, SPI_Mode0);
+
+	if (W5500Initialize(&gDev, &gSpi, &gGpio, W5500BENCH_CSPIN) != W5500_Success) {
+		return false;
+	}
+
+	if ((aKB != NULL) && (W5500SetBufferSizes(&gDev, aKB, aKB) != W5500_Success)) {
+		return false;
+	}
+
+	if (bEvents == true) {
+		W5500SimAttachInterrupt(&gSim, &gPins, W5500BENCH_INTPIN);
+
+		if (W5500EventInitialize(&gDev, W5500BENCH_INTPIN) != W5500_Success) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool W5500BenchConnect(sTCPServ_t *pServ, sW5500IfaceInfo_t *pInfo, sSocket_t *pSck) {
+	sConnInfo_t sAddr;
+
+	sAddr.Addr.nNetLong = 0;
+	sAddr.Port = W5500BENCH_PORT;
+	if (pServ->pfBind(pServ, &sAddr) != Net_Success) {
+		return false;
+	}
+
+	if (W5500SimPeerConnect(&gSim, pInfo->aListen[0], gaPeerAddr, 40000) == false) {
+		return false;
+	}
+
+	if (pServ->pfAcceptClient(pServ, pSck) != Net_Success) {
+		return false;
+	}
+
+	return true;
+}
+
+static void W5500BenchPeerStart(sW5500BenchPeer_t *pPeer) {
+	pPeer->bDone = false;
+	pthread_create(&(pPeer->hThread), NULL, &W5500BenchPeerThread, pPeer);
+
+	return;
+}
+
+static void *W5500BenchPeerThread(void *pParam) {
+	sW5500BenchPeer_t *pPeer = (sW5500BenchPeer_t *)pParam;
+	struct timespec tWait;
+	uint8_t nCtr;
+
+	tWait.tv_sec = 0;
+	tWait.tv_nsec = W5500BENCH_DELAYMS * 1000000L;
+	nanosleep(&tWait, NULL);
+
+	switch (pPeer->eAction) {
+		case W5500BenchAct_Connect:
+			for (nCtr = 0; (nCtr < W5500_NUMSOCKETS) && (pPeer->bDone == false); nCtr++) {
+				pPeer->bDone = W5500SimPeerConnect(&gSim, pPeer->aSockets[nCtr], gaPeerAddr, 40000);
+			}
+			break;
+
+		case W5500BenchAct_Write:
+			pPeer->bDone = (W5500SimPeerWrite(&gSim, pPeer->aSockets[0], pPeer->pData, pPeer->nBytes) == pPeer->nBytes) ? true : false;
+			break;
+
+		case W5500BenchAct_Close:
+			pPeer->bDone = W5500SimPeerClose(&gSim, pPeer->aSockets[0]);
+			break;
+	}
+
+	return NULL;
+}
+
+static double W5500BenchMessages(uint32_t nMsgLen, bool bBlock) {
+	static const uint8_t aKB[W5500_NUMSOCKETS] = { 8, 2, 2, 2, 2, 0, 0, 0 };
+	sTCPServ_t sServ;
+	sW5500IfaceInfo_t sInfo;
+	sSocket_t sSck;
+	uint64_t nCalls, nBusBytes;
+	uint32_t nMoved, nLen, nRecv, nBad = 0;
+	double nPerMB;
+	char aName[32];
+
+	if (HOSTCHECK(W5500BenchSetup(false, aKB) == true) == false) {
+		return 0;
+	}
+
+	if (bBlock == false) { //Bus without block transfers, every byte is its own call
+		gSpi.pfTransferBlock = &SPITransferBlock;
+	}
+
+	W5500CreateTCPServer(&gDev, &sServ, &sInfo, 8, 1);
+	if (HOSTCHECK(W5500BenchConnect(&sServ, &sInfo, &sSck) == true) == false) {
+		return 0;
+	}
+
+	nCalls = gSim.nBusCalls;
+	nBusBytes = gSim.nBusBytes;
+	for (nMoved = 0; nMoved < W5500BENCH_PAYLOAD; nMoved += nMsgLen) {
+		//Send a message out to the peer
+		if ((sServ.pfSend(&sServ, &sSck, nMsgLen, gaSend) != Net_Success) ||
+			(W5500SimPeerRead(&gSim, sSck.nSocket, gaRecv, nMsgLen) != nMsgLen) ||
+			(memcmp(gaRecv, gaSend, nMsgLen) != 0)) {
+			nBad += 1;
+			break;
+		}
+
+		//Take one back in
+		if (W5500SimPeerWrite(&gSim, sSck.nSocket, &(gaSend[1]), nMsgLen) != nMsgLen) {
+			nBad += 1;
+			break;
+		}
+
+		for (nLen = 0; nLen < nMsgLen; nLen += nRecv) {
+			if ((sServ.pfReceive(&sServ, &sSck, nMsgLen - nLen, &(gaRecv[nLen]), &nRecv) != Net_Success) || (nRecv == 0)) {
+				break;
+			}
+		}
+
+		if ((nLen != nMsgLen) || (memcmp(gaRecv, &(gaSend[1]), nMsgLen) != 0)) {
+			nBad += 1;
+			break;
+		}
+	}
+
+	nCalls = gSim.nBusCalls - nCalls;
+	nBusBytes = gSim.nBusBytes - nBusBytes;
+	nPerMB = nCalls / (nMoved * 2 / 1e6);
+
+	snprintf(aName, sizeof(aName), "%u byte messages", nMsgLen);
+	printf("  %-20s %-14s %10.0f bus calls per MB  %.3f bus bytes per payload byte\n", aName, (bBlock == true) ? "block calls" : "call per byte", nPerMB, (double)nBusBytes / (nMoved * 2));
+	HOSTCHECK(nBad == 0);
+
+	return nPerMB;
+}
+
+static uint32_t W5500BenchBurst(uint8_t nListenCnt) {
+	sTCPServ_t sServ;
+	sW5500IfaceInfo_t sInfo;
+	sSocket_t aSck[W5500BENCH_BURST];
+	sConnInfo_t sAddr;
+	uint32_t nCtr, nConnected = 0, nAccepted = 0;
+	uint8_t nLstn;
+
+	if (HOSTCHECK(W5500BenchSetup(false, NULL) == true) == false) {
+		return 0;
+	}
+
+	W5500CreateTCPServer(&gDev, &sServ, &sInfo, 2, nListenCnt);
+	sAddr.Addr.nNetLong = 0;
+	sAddr.Port = W5500BENCH_PORT;
+	HOSTCHECK(sServ.pfBind(&sServ, &sAddr) == Net_Success);
+
+	//Each connect takes a socket still listening, if there is one
+	for (nCtr = 0; nCtr < W5500BENCH_BURST; nCtr++) {
+		for (nLstn = 0; nLstn < nListenCnt; nLstn++) {
+			if (W5500SimPeerConnect(&gSim, sInfo.aListen[nLstn], gaPeerAddr, 40000 + nCtr) == true) {
+				nConnected += 1;
+				break;
+			}
+		}
+	}
+
+	for (nCtr = 0; nCtr < nConnected; nCtr++) {
+		if (sServ.pfAcceptClient(&sServ, &(aSck[nCtr])) == Net_Success) {
+			nAccepted += 1;
+		}
+	}
+
+	HOSTCHECK(nAccepted == GetSmallerNum(nListenCnt, W5500BENCH_BURST));
+
+	return nAccepted;
+}
+
+static void W5500BenchDatagrams(void) {
+	sUDPServ_t sServ;
+	sW5500IfaceInfo_t sInfo;
+	sConnInfo_t sAddr;
+	uint32_t nCtr, nLen, nRecv, nTotal = 0, nBad = 0, nSeed = 23;
+	uint16_t nSent;
+
+	if (HOSTCHECK(W5500BenchSetup(false, NULL) == true) == false) {
+		return;
+	}
+
+	W5500CreateUDPServer(&gDev, &sServ, &sInfo, 2);
+	sAddr.Addr.nNetLong = 0;
+	sAddr.Port = W5500BENCH_PORT;
+	HOSTCHECK(sServ.pfBind(&sServ, &sAddr) == Net_Success);
+
+	for (nCtr = 0; nCtr < W5500BENCH_DATAGRAMS; nCtr++) {
+		nLen = 1 + HostTestRandRange(&nSeed, W5500BENCH_DGRAMMAX);
+		nSent = 30000 + nCtr;
+
+		if ((W5500SimPeerSendTo(&gSim, sServ.HostSck.nSocket, gaPeerAddr, nSent, &(gaSend[nCtr]), nLen) != nLen) ||
+			(sServ.pfReceive(&sServ, &sAddr, sizeof(gaRecv), gaRecv, &nRecv) != Net_Success) ||
+			(nRecv != nLen) || (sAddr.Port != nSent) ||
+			(memcmp(gaRecv, &(gaSend[nCtr]), nLen) != 0)) {
+			nBad += 1;
+		}
+
+		nTotal += nLen;
+	}
+
+	printf("  %u datagrams, %u bytes through a 2 KB buffer, %u corrupted\n", W5500BENCH_DATAGRAMS, nTotal, nBad);
+	HOSTCHECK(nBad == 0);
+	HOSTCHECK(nTotal > 2048); //The buffer must have wrapped
+
+	return;
+}
+
+static void W5500BenchWaits(bool bEvents) {
+	sTCPServ_t sServ;
+	sW5500IfaceInfo_t sInfo;
+	sSocket_t sSck;
+	sConnInfo_t sAddr;
+	sW5500BenchPeer_t sPeer;
+	uint32_t nFrames, nRecv;
+	const char *pHow = (bEvents == true) ? "events" : "polling";
+
+	if (HOSTCHECK(W5500BenchSetup(bEvents, NULL) == true) == false) {
+		return;
+	}
+
+	W5500CreateTCPServer(&gDev, &sServ, &sInfo, 2, W5500BENCH_BURST);
+	sAddr.Addr.nNetLong = 0;
+	sAddr.Port = W5500BENCH_PORT;
+	HOSTCHECK(sServ.pfBind(&sServ, &sAddr) == Net_Success);
+
+	//Accept blocks until the peer connects to one of the pool
+	sPeer.eAction = W5500BenchAct_Connect;
+	memcpy(sPeer.aSockets, sInfo.aListen, W5500_NUMSOCKETS);
+	W5500BenchPeerStart(&sPeer);
+
+	nFrames = gSim.nFrames;
+	HOSTCHECK(sServ.pfAcceptClient(&sServ, &sSck) == Net_Success);
+	nFrames = gSim.nFrames - nFrames;
+	pthread_join(sPeer.hThread, NULL);
+
+	printf("  Pool accept after %u ms, %-8s %8u SPI frames\n", W5500BENCH_DELAYMS, pHow, nFrames);
+	HOSTCHECK(sPeer.bDone == true);
+
+	//Receive blocks until the peer sends
+	sPeer.eAction = W5500BenchAct_Write;
+	sPeer.aSockets[0] = sSck.nSocket;
+	sPeer.pData = gaSend;
+	sPeer.nBytes = 100;
+	W5500BenchPeerStart(&sPeer);
+
+	nFrames = gSim.nFrames;
+	HOSTCHECK(sServ.pfReceive(&sServ, &sSck, sizeof(gaRecv), gaRecv, &nRecv) == Net_Success);
+	nFrames = gSim.nFrames - nFrames;
+	pthread_join(sPeer.hThread, NULL);
+
+	printf("  Receive after %u ms,     %-8s %8u SPI frames\n", W5500BENCH_DELAYMS, pHow, nFrames);
+	HOSTCHECK((nRecv == 100) && (memcmp(gaRecv, gaSend, 100) == 0));
+
+	if (bEvents == true) { //Woken once for the connect and once for the data
+		HOSTCHECK(nFrames < 50);
+	}
+
+	return;
+}
+
+static void W5500BenchStream(bool bEvents) {
+	sTCPServ_t sServ;
+	sW5500IfaceInfo_t sInfo;
+	sSocket_t sSck;
+	sW5500SendCursor_t sCursor;
+	sW5500BenchPeer_t sPeer;
+	eW5500Return_t eResult;
+	uint32_t nFrames, nCalls, nLen, nRecv, nPut;
+	const char *pHow = (bEvents == true) ? "events" : "polling";
+
+	if (HOSTCHECK(W5500BenchSetup(bEvents, NULL) == true) == false) {
+		return;
+	}
+
+	W5500CreateTCPServer(&gDev, &sServ, &sInfo, 2, 1);
+	if (HOSTCHECK(W5500BenchConnect(&sServ, &sInfo, &sSck) == true) == false) {
+		return;
+	}
+
+	//Blocking send of the whole stream, the peer takes it as it comes
+	nFrames = gSim.nFrames;
+	HOSTCHECK(sServ.pfSend(&sServ, &sSck, W5500BENCH_STREAM, gaSend) == Net_Success);
+	nFrames = gSim.nFrames - nFrames;
+
+	printf("  64 KB send through 2 KB, %-8s %8u SPI frames\n", pHow, nFrames);
+	HOSTCHECK(W5500SimPeerRead(&gSim, sSck.nSocket, gaRecv, sizeof(gaRecv)) == W5500BENCH_STREAM);
+	HOSTCHECK(memcmp(gaRecv, gaSend, W5500BENCH_STREAM) == 0);
+
+	//Streamed without blocking to a peer that holds little, collected between calls
+	gSim.nPeerWindow = W5500BENCH_WINDOW;
+	W5500SendCursorInit(&sCursor, gaSend, W5500BENCH_STREAM);
+	nCalls = 0;
+	nLen = 0;
+	do {
+		eResult = W5500SocketTCPSendContinue(&gDev, sSck.nSocket, &sCursor);
+		nCalls += 1;
+
+		nLen += W5500SimPeerRead(&gSim, sSck.nSocket, &(gaRecv[nLen]), sizeof(gaRecv) - nLen);
+	} while (eResult == W5500Warn_Partial);
+
+	while (nLen < W5500BENCH_STREAM) { //Rest of the last piece
+		nRecv = W5500SimPeerRead(&gSim, sSck.nSocket, &(gaRecv[nLen]), sizeof(gaRecv) - nLen);
+		if (nRecv == 0) {
+			break;
+		}
+
+		nLen += nRecv;
+	}
+
+	printf("  64 KB to a %u byte window, %-8s %6u continue calls\n", W5500BENCH_WINDOW, pHow, nCalls);
+	HOSTCHECK(eResult == W5500_Success);
+	HOSTCHECK((nLen == W5500BENCH_STREAM) && (memcmp(gaRecv, gaSend, W5500BENCH_STREAM) == 0));
+	gSim.nPeerWindow = 0;
+
+	//Received in reads that do not line up with the buffer, so they cross its wrap
+	nPut = 0;
+	nLen = 0;
+	while (nLen < W5500BENCH_STREAM) {
+		nPut += W5500SimPeerWrite(&gSim, sSck.nSocket, &(gaSend[nPut]), W5500BENCH_STREAM - nPut);
+
+		if ((sServ.pfReceive(&sServ, &sSck, GetSmallerNum(W5500BENCH_RECVSIZE, W5500BENCH_STREAM - nLen), &(gaRecv[nLen]), &nRecv) != Net_Success) || (nRecv == 0)) {
+			break;
+		}
+
+		nLen += nRecv;
+	}
+
+	HOSTCHECK((nLen == W5500BENCH_STREAM) && (memcmp(gaRecv, gaSend, W5500BENCH_STREAM) == 0));
+
+	//A peer that stops reading then hangs up must end the blocked send
+	gSim.nPeerWindow = W5500BENCH_WINDOW;
+	sPeer.eAction = W5500BenchAct_Close;
+	sPeer.aSockets[0] = sSck.nSocket;
+	W5500BenchPeerStart(&sPeer);
+
+	HOSTCHECK(sServ.pfSend(&sServ, &sSck, W5500BENCH_STREAM, gaSend) == NetFail_SocketState);
+	pthread_join(sPeer.hThread, NULL);
+	HOSTCHECK(sPeer.bDone == true);
+	gSim.nPeerWindow = 0;
+
+	return;
+}
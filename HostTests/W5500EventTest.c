@@ -0,0 +1,219 @@
+/**	File:	W5500EventTest.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Runs the W5500 event engine against the simulated part with its INTn
+	output attached to a simulated GPIO input.  Connects, data, sends, closes
+	and a refused connect are raised by the simulated peer, and each must
+	reach the right socket handler once through W5500EventService().  Send ok
+	must only interrupt while a handler wants it, data a handler leaves
+	behind must raise receive again within the same service, and servicing
+	with nothing pending must not touch the bus.
+*/
+
+/*****	Includes	*****/
+	#include "GPIO_Simulated.h"		//Sets the POSIX level, must come before system headers
+
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "SPI_W5500Simulated.h"
+	#include "W5500Driver.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Simulated pin used as the chip select */
+	#define EVENTTEST_CSPIN			5
+
+	/**	@brief		Simulated pin wired to INTn */
+	#define EVENTTEST_INTPIN		6
+
+	/**	@brief		Port the listening socket is opened on */
+	#define EVENTTEST_PORT			8000
+
+	/**	@brief		Bytes the peer sends at once */
+	#define EVENTTEST_DATALEN		100
+
+	/**	@brief		Most bytes the receive handler reads in one call */
+	#define EVENTTEST_READLIMIT		10
+
+	/**	@brief		Service calls made with nothing pending */
+	#define EVENTTEST_IDLECALLS		100000
+
+/*****	Definitions	*****/
+	/**	@brief		What the handlers of one socket have seen */
+	typedef struct sEventTestSocket_t {
+		uint32_t nConnect;
+		uint32_t nReceive;
+		uint32_t nSendOK;
+		uint32_t nDisconnect;
+		uint8_t aData[EVENTTEST_DATALEN];		/**< Bytes read by the receive handler */
+		uint32_t nRead;							/**< Bytes in aData */
+	} sEventTestSocket_t;
+
+/*****	Constants	*****/
+	static const uint8_t gaPeerAddr[4] = { 192, 168, 1, 20 };
+
+/*****	Globals		*****/
+	static sW5500SimInfo_t gSim;
+
+	static sGPIOSimInfo_t gPins;
+
+/*****	Prototypes 	*****/
+	static void EventTestConnect(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam);
+
+	/**	@brief		Reads at most EVENTTEST_READLIMIT bytes so data is left behind */
+	static void EventTestReceive(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam);
+
+	static void EventTestSendOK(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam);
+
+	static void EventTestDisconnect(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam);
+
+/*****	Functions	*****/
+int main(void) {
+	sSPIIface_t sSpi;
+	sGPIOIface_t sGpio;
+	sW5500Obj_t sDev;
+	sW5500SckEvents_t sEvents;
+	sEventTestSocket_t sListen, sClient;
+	IN_ADDR sAddr;
+	uint8_t aData[EVENTTEST_DATALEN], aPeer[EVENTTEST_DATALEN], nSck, nClientSck;
+	uint32_t nFrames, nCtr, nSeed = 7;
+	bool bIntHigh;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	memset(&sListen, 0, sizeof(sEventTestSocket_t));
+	memset(&sClient, 0, sizeof(sEventTestSocket_t));
+	HostTestRandom(&nSeed, aData, sizeof(aData));
+
+	GPIOSimPortInitialize(&sGpio, &gPins);
+	W5500SimPortInitialize(&sSpi, &gSim, 1000000, SPI_MSBFirst, SPI_Mode0);
+	HOSTCHECK(W5500Initialize(&sDev, &sSpi, &sGpio, EVENTTEST_CSPIN) == W5500_Success);
+
+	W5500SimAttachInterrupt(&gSim, &gPins, EVENTTEST_INTPIN);
+	HOSTCHECK(W5500EventInitialize(&sDev, EVENTTEST_INTPIN) == W5500_Success);
+
+	//The first service looks once in case INTn fell before the hook, then all is quiet
+	HOSTCHECK(W5500EventService(&sDev) == W5500_Success);
+	HOSTCHECK(W5500EventPending(&sDev) == false);
+
+	nFrames = gSim.nFrames;
+	for (nCtr = 0; nCtr < EVENTTEST_IDLECALLS; nCtr++) {
+		W5500EventService(&sDev);
+	}
+	HOSTCHECK(gSim.nFrames == nFrames);
+
+	//Connect reaches its handler in one read of SIR and one read and clear of Sn_IR
+	HOSTCHECK(W5500SocketListen(&sDev, &nSck, EVENTTEST_PORT, IPPROTO_TCP, 2) == W5500_Success);
+
+	sEvents.pfConnect = &EventTestConnect;
+	sEvents.pfReceive = &EventTestReceive;
+	sEvents.pfSendOK = NULL;
+	sEvents.pfDisconnect = &EventTestDisconnect;
+	sEvents.pParam = &sListen;
+	HOSTCHECK(W5500EventSetHandlers(&sDev, nSck, &sEvents) == W5500_Success);
+
+	HOSTCHECK(W5500SimPeerConnect(&gSim, nSck, gaPeerAddr, 40000) == true);
+	HOSTCHECK(W5500EventPending(&sDev) == true);
+
+	nFrames = gSim.nFrames;
+	HOSTCHECK(W5500EventService(&sDev) == W5500_Success);
+	printf("  Connect event serviced in %u SPI frames\n", gSim.nFrames - nFrames);
+	HOSTCHECK(gSim.nFrames - nFrames == 3);
+	HOSTCHECK(sListen.nConnect == 1);
+	HOSTCHECK((sListen.nReceive == 0) && (sListen.nDisconnect == 0));
+	HOSTCHECK(W5500EventPending(&sDev) == false);
+
+	sGpio.pfDigitalReadByPin(&sGpio, EVENTTEST_INTPIN, &bIntHigh);
+	HOSTCHECK(bIntHigh == true);
+
+	//Data the handler leaves behind raises receive again until it is all read
+	HOSTCHECK(W5500SimPeerWrite(&gSim, nSck, aData, sizeof(aData)) == sizeof(aData));
+	HOSTCHECK(W5500EventPending(&sDev) == true);
+	HOSTCHECK(W5500EventService(&sDev) == W5500_Success);
+
+	HOSTCHECK(sListen.nReceive == EVENTTEST_DATALEN / EVENTTEST_READLIMIT);
+	HOSTCHECK(sListen.nRead == sizeof(aData));
+	HOSTCHECK(memcmp(sListen.aData, aData, sizeof(aData)) == 0);
+	HOSTCHECK(W5500EventPending(&sDev) == false);
+
+	sGpio.pfDigitalReadByPin(&sGpio, EVENTTEST_INTPIN, &bIntHigh);
+	HOSTCHECK(bIntHigh == true);
+
+	//Send ok is masked while no handler wants it
+	HOSTCHECK(W5500SocketTCPSend(&sDev, nSck, aData, sizeof(aData)) == W5500_Success);
+	HOSTCHECK(W5500EventPending(&sDev) == false);
+	HOSTCHECK(W5500SimPeerRead(&gSim, nSck, aPeer, sizeof(aPeer)) == sizeof(aData));
+	HOSTCHECK(memcmp(aPeer, aData, sizeof(aData)) == 0);
+
+	sEvents.pfSendOK = &EventTestSendOK;
+	HOSTCHECK(W5500EventSetHandlers(&sDev, nSck, &sEvents) == W5500_Success);
+	HOSTCHECK(W5500SocketTCPSend(&sDev, nSck, aData, sizeof(aData)) == W5500_Success);
+	HOSTCHECK(W5500EventPending(&sDev) == true);
+	HOSTCHECK(W5500EventService(&sDev) == W5500_Success);
+	HOSTCHECK(sListen.nSendOK == 1);
+	HOSTCHECK(W5500SimPeerRead(&gSim, nSck, aPeer, sizeof(aPeer)) == sizeof(aData));
+
+	//A close from the peer
+	HOSTCHECK(W5500SimPeerClose(&gSim, nSck) == true);
+	HOSTCHECK(W5500EventService(&sDev) == W5500_Success);
+	HOSTCHECK(sListen.nDisconnect == 1);
+	HOSTCHECK(sListen.nConnect == 1);
+	HOSTCHECK(W5500CloseSocket(&sDev, nSck) == W5500_Success);
+
+	//A refused connect times out, which is reported as a disconnect
+	gSim.bPeerRefuse = true;
+	sAddr.S_un.S_un_b.s_b1 = gaPeerAddr[0];
+	sAddr.S_un.S_un_b.s_b2 = gaPeerAddr[1];
+	sAddr.S_un.S_un_b.s_b3 = gaPeerAddr[2];
+	sAddr.S_un.S_un_b.s_b4 = gaPeerAddr[3];
+	HOSTCHECK(W5500SocketConnect(&sDev, &nClientSck, &sAddr, EVENTTEST_PORT, 2) == W5500_Success);
+
+	sEvents.pParam = &sClient;
+	HOSTCHECK(W5500EventSetHandlers(&sDev, nClientSck, &sEvents) == W5500_Success);
+	HOSTCHECK(W5500EventService(&sDev) == W5500_Success);
+	HOSTCHECK(sClient.nDisconnect == 1);
+	HOSTCHECK(sClient.nConnect == 0);
+	HOSTCHECK(sListen.nDisconnect == 1); //Other socket's handlers were left alone
+	HOSTCHECK(W5500EventPending(&sDev) == false);
+
+	return HostTestResult("W5500EventTest");
+}
+
+static void EventTestConnect(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam) {
+	sEventTestSocket_t *pSck = (sEventTestSocket_t *)pParam;
+
+	pSck->nConnect += 1;
+
+	return;
+}
+
+static void EventTestReceive(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam) {
+	sEventTestSocket_t *pSck = (sEventTestSocket_t *)pParam;
+	uint16_t nRead = 0;
+
+	pSck->nReceive += 1;
+
+	W5500SocketReceive(pDev, nSocket, &(pSck->aData[pSck->nRead]), GetSmallerNum(EVENTTEST_READLIMIT, EVENTTEST_DATALEN - pSck->nRead), &nRead);
+	pSck->nRead += nRead;
+
+	return;
+}
+
+static void EventTestSendOK(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam) {
+	sEventTestSocket_t *pSck = (sEventTestSocket_t *)pParam;
+
+	pSck->nSendOK += 1;
+
+	return;
+}
+
+static void EventTestDisconnect(sW5500Obj_t *pDev, uint8_t nSocket, void *pParam) {
+	sEventTestSocket_t *pSck = (sEventTestSocket_t *)pParam;
+
+	pSck->nDisconnect += 1;
+
+	return;
+}
@@ -0,0 +1,443 @@
+/**	File:	XBeeStreamTest.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+
+	Tests the XBee API frame decoder on recorded byte streams split at random
+	points.  Each stream holds XBEESTREAMTEST_FRAMES frames with noise between
+	some of them, and alternates between plain (AP=1) and escaped (AP=2)
+	framing.  Frame data is weighted toward the bytes that need escaping.
+	Some frames are damaged: bad checksums, lengths too large for the data
+	buffer, and in escaped streams frames cut off by the next start byte.
+
+	Half the streams are handed to XBeeReceiveBytes() in pieces of random
+	size, the rest are read through XBeeReadMessage() from a UART stub that
+	reports a random number of bytes waiting.  Every good frame must come out
+	whole and in order, and every damaged one must be counted as dropped.
+	Queue full dropping, the escaping of sent frames, and parsing a received
+	packet are checked after.
+*/
+
+/*****	Includes	*****/
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "UARTGeneralInterface.h"
+	#include "XBeeDriver.h"
+
+	#include "HostTest.h"
+
+/*****	Defines		*****/
+	/**	@brief		Streams generated and decoded */
+	#define XBEESTREAMTEST_STREAMS		200
+
+	/**	@brief		Frames, good or damaged, in each stream */
+	#define XBEESTREAMTEST_FRAMES		300
+
+	/**	@brief		Room for the largest stream, every byte escaped */
+	#define XBEESTREAMTEST_STREAMBYTES	(XBEESTREAMTEST_FRAMES * 2 * (XBEE_RECVBUFFERSIZE + 64))
+
+	/**	@brief		Largest piece a stream is fed to XBeeReceiveBytes() in */
+	#define XBEESTREAMTEST_SPLITMAX		64
+
+	/**	@brief		Most bytes the UART stub reports waiting */
+	#define XBEESTREAMTEST_UARTMAX		300
+
+	/**	@brief		Most data bytes in a large frame, most frames are small */
+	#define XBEESTREAMTEST_LARGEFRAME	520
+
+	/**	@brief		Most data bytes in a small frame */
+	#define XBEESTREAMTEST_SMALLFRAME	40
+
+	/**	@brief		Most noise bytes put between frames */
+	#define XBEESTREAMTEST_NOISEMAX		4
+
+	/**	@brief		Times XBeeReadMessage() must find nothing with the stream used up */
+	#define XBEESTREAMTEST_IDLEREADS	3
+
+	/**	@brief		Data bytes in each frame of the queue full check */
+	#define XBEESTREAMTEST_QUEUEDATA	5
+
+	/**	@brief		Frames fed in the queue full check, more than the queue holds */
+	#define XBEESTREAMTEST_QUEUEFRAMES	200
+
+/*****	Definitions	*****/
+	/**	@brief		A good frame the decoder must return */
+	typedef struct sXBeeStreamFrame_t {
+		uint16_t nLen;							/**< Data bytes in the frame */
+		uint8_t aData[XBEE_RECVBUFFERSIZE];		/**< Frame data, type byte first */
+	} sXBeeStreamFrame_t;
+
+/*****	Constants	*****/
+	/**	@brief		Bytes escaped in AP=2, frame data favors them */
+	static const uint8_t gaSpecial[] = { XBEE_STARTBYTE, XBEE_ESCAPEBYTE, 0x11, 0x13 };
+
+/*****	Globals		*****/
+	/**	@brief		Stream being decoded */
+	static uint8_t gaStream[XBEESTREAMTEST_STREAMBYTES];
+
+	static uint32_t gnStreamLen;
+
+	/**	@brief		Bytes of the stream the UART stub has handed over */
+	static uint32_t gnStreamPos;
+
+	/**	@brief		Bytes sent through the UART stub */
+	static uint8_t gaWritten[XBEE_RECVBUFFERSIZE * 2];
+
+	static uint32_t gnWritten;
+
+	/**	@brief		Good frames in the stream, in the order sent */
+	static sXBeeStreamFrame_t gaExpected[XBEESTREAMTEST_FRAMES];
+
+	static uint32_t gnExpected;
+
+	static uint32_t gnSeed = 25;
+
+	static sUARTIface_t gUART;
+
+	/**	@brief		Decoders, too large for the stack */
+	static sXBeeObject_t gXBee;
+
+	static sXBeeObject_t gXBeeFar;
+
+/*****	Prototypes 	*****/
+	/**	@brief		Reports a random number of the stream's bytes waiting */
+	static eUARTReturn_t XBeeStreamTestAvailable(sUARTIface_t *pUARTIface, uint16_t *pnBytesAvailable);
+
+	/**	@brief		Hands over the next bytes of the stream */
+	static eUARTReturn_t XBeeStreamTestRead(sUARTIface_t *pUARTIface, uint16_t nBuffSize, void *pDataBuff, uint16_t *pnBytesRead);
+
+	/**	@brief		Records bytes sent so they can be decoded */
+	static eUARTReturn_t XBeeStreamTestWrite(sUARTIface_t *pUARTIface, uint16_t nBuffSize, const void *pDataBuff);
+
+	static eUARTReturn_t XBeeStreamTestWaitSend(sUARTIface_t *pUARTIface);
+
+	/**	@brief		Add a byte to the stream
+		@param		nByte		Byte to add
+		@param		bEscape		True to escape it if AP=2 requires
+	*/
+	static void XBeeStreamTestPut(uint8_t nByte, bool bEscape);
+
+	/**	@brief		Generate a stream of good and damaged frames
+		@param		bEscaped	True to escape the frames as AP=2 does
+		@return		Number of damaged frames in the stream
+	*/
+	static uint32_t XBeeStreamTestBuild(bool bEscaped);
+
+	/**	@brief		Compare the frame in the data buffer with the next one expected
+		@param		nFrame		Index of the frame expected
+		@return		True if the frame matches
+	*/
+	static bool XBeeStreamTestCheckFrame(uint32_t nFrame);
+
+/*****	Functions	*****/
+int main(void) {
+	sXBeeFrameRecv_t sFrame;
+	eXBeeReturn_t eResult;
+	uint8_t aFrame[XBEE_MSGBASELENGTH + XBEESTREAMTEST_QUEUEDATA], aPacket[21], nFrameID, nSum;
+	uint32_t nStream, nDamaged, nFound, nPos, nPiece, nIdle, nCtr, nQueued;
+	uint64_t nTotal = 0;
+	bool bEscaped, bMatched;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	UARTInterfaceInitialize(&gUART);
+	gUART.pfUARTDataAvailable = &XBeeStreamTestAvailable;
+	gUART.pfUARTReadData = &XBeeStreamTestRead;
+	gUART.pfUARTWriteData = &XBeeStreamTestWrite;
+	gUART.pfUARTWaitDataSend = &XBeeStreamTestWaitSend;
+
+	//Streams split at random points, alternating plain and escaped
+	for (nStream = 0; nStream < XBEESTREAMTEST_STREAMS; nStream++) {
+		bEscaped = ((nStream % 2) == 1) ? true : false;
+		nDamaged = XBeeStreamTestBuild(bEscaped);
+
+		XBeeInitialize(&gXBee, &gUART, 0, 0);
+		gXBee.bEscaped = bEscaped;
+
+		nFound = 0;
+		bMatched = true;
+		if ((nStream % 4) < 2) { //Fed in pieces, frames read out after each
+			nPos = 0;
+			while (nPos < gnStreamLen) {
+				nPiece = 1 + HostTestRandRange(&gnSeed, XBEESTREAMTEST_SPLITMAX);
+				if (nPiece > gnStreamLen - nPos) {
+					nPiece = gnStreamLen - nPos;
+				}
+
+				XBeeReceiveBytes(&gXBee, &(gaStream[nPos]), nPiece);
+				nPos += nPiece;
+
+				while ((eResult = XBeeNextMessage(&gXBee)) != XBWarn_NoMessage) {
+					if (eResult != XB_Success) { //A damaged frame was reported
+						continue;
+					}
+
+					if (XBeeStreamTestCheckFrame(nFound) == false) {
+						bMatched = false;
+					}
+					nFound += 1;
+				}
+			}
+		} else { //Through the UART, which has a random amount waiting each time
+			nIdle = 0;
+			while (nIdle < XBEESTREAMTEST_IDLEREADS) {
+				eResult = XBeeReadMessage(&gXBee);
+
+				if (eResult == XBWarn_NoMessage) {
+					if (gnStreamPos >= gnStreamLen) {
+						nIdle += 1;
+					}
+
+					continue;
+				} else if (eResult != XB_Success) {
+					continue;
+				}
+
+				if (XBeeStreamTestCheckFrame(nFound) == false) {
+					bMatched = false;
+				}
+				nFound += 1;
+			}
+		}
+
+		HOSTCHECK(bMatched == true);
+		HOSTCHECK(nFound == gnExpected);
+		HOSTCHECK(gXBee.nQueueBytes == 0);
+
+		//A frame cut off at the end of the stream is still waiting for the rest
+		HOSTCHECK(gXBee.nRXDropped + ((gXBee.eRXState != XBRX_Start) ? 1 : 0) == nDamaged);
+
+		nTotal += nFound;
+	}
+	printf("  %u streams, %llu good frames decoded\n", XBEESTREAMTEST_STREAMS, (unsigned long long)nTotal);
+
+	//Frames arriving with the queue full are dropped, those queued are kept
+	XBeeInitialize(&gXBee, &gUART, 0, 0);
+	aFrame[XBIdx_Start] = XBEE_STARTBYTE;
+	aFrame[XBIdx_LengthMSB] = 0;
+	aFrame[XBIdx_LengthLSB] = XBEESTREAMTEST_QUEUEDATA;
+	aFrame[XBIdx_FrameType] = XBFrame_RecvPacket;
+	for (nCtr = 1; nCtr < XBEESTREAMTEST_QUEUEDATA; nCtr++) {
+		aFrame[XBIdx_FrameType + nCtr] = nCtr;
+	}
+	aFrame[sizeof(aFrame) - 1] = XBeeAPIChecksum(aFrame);
+
+	for (nCtr = 0; nCtr < XBEESTREAMTEST_QUEUEFRAMES; nCtr++) {
+		XBeeReceiveBytes(&gXBee, aFrame, sizeof(aFrame));
+	}
+
+	nQueued = gXBee.nQueueFrames;
+	HOSTCHECK(nQueued == XBEE_RXQUEUEBYTES / sizeof(aFrame));
+	HOSTCHECK(gXBee.nRXDropped == XBEESTREAMTEST_QUEUEFRAMES - nQueued);
+
+	nCtr = 0;
+	while ((eResult = XBeeNextMessage(&gXBee)) == XB_Success) {
+		nCtr += 1;
+	}
+	HOSTCHECK(nCtr == nQueued);
+	HOSTCHECK(eResult == XBFail_QueueFull);
+	HOSTCHECK(XBeeNextMessage(&gXBee) == XBWarn_NoMessage);
+	printf("  queue full: %u frames kept, %u dropped\n", nQueued, gXBee.nRXDropped);
+
+	//Sent frames decode the same at the far end, with a frame ID and command that need escaping
+	for (nCtr = 0; nCtr < 2; nCtr++) {
+		bEscaped = (nCtr == 1) ? true : false;
+
+		XBeeInitialize(&gXBee, &gUART, 0, 0);
+		gXBee.bEscaped = bEscaped;
+		gXBee.nFrameID = XBEE_ESCAPEBYTE;
+
+		XBeeInitialize(&gXBeeFar, &gUART, 0, 0);
+		gXBeeFar.bEscaped = bEscaped;
+
+		gnWritten = 0;
+		XBeeATQueryCommand(&gXBee, "\x11\x13", &nFrameID);
+
+		HOSTCHECK(XBeeReceiveBytes(&gXBeeFar, gaWritten, gnWritten) == XB_Success);
+		HOSTCHECK(XBeeNextMessage(&gXBeeFar) == XB_Success);
+		HOSTCHECK(memcmp(gXBeeFar.anDataBuffer, gXBee.anDataBuffer, XBEE_MSGBASELENGTH + 4) == 0);
+		printf("  AT command, %s: %u bytes sent\n", (bEscaped == true) ? "escaped" : "plain", gnWritten);
+	}
+
+	//A received packet fed one byte at a time parses to its data
+	XBeeInitialize(&gXBee, &gUART, 0, 0);
+	memcpy(aPacket, "\x7E\x00\x11\x90\x00\x13\xA2\x00\x40\x0A\x01\x27\xFF\xFE\x01hello", sizeof(aPacket) - 1);
+	nSum = 0;
+	for (nCtr = XBIdx_DataStart; nCtr < sizeof(aPacket) - 1; nCtr++) {
+		nSum += aPacket[nCtr];
+	}
+	aPacket[sizeof(aPacket) - 1] = 0xFF - nSum;
+
+	for (nCtr = 0; nCtr < sizeof(aPacket); nCtr++) {
+		XBeeReceiveBytes(&gXBee, &(aPacket[nCtr]), 1);
+	}
+
+	if (HOSTCHECK(XBeeNextMessage(&gXBee) == XB_Success) == true) {
+		XBeeParseMessage(&gXBee, &sFrame);
+		HOSTCHECK(sFrame.eType == XBFrame_RecvPacket);
+		HOSTCHECK(sFrame.uData.RXPacket.nDataLen == 5);
+		HOSTCHECK(memcmp(sFrame.uData.RXPacket.aData, "hello", 5) == 0);
+	}
+
+	return HostTestResult("XBeeStreamTest");
+}
+
+static eUARTReturn_t XBeeStreamTestAvailable(sUARTIface_t *pUARTIface, uint16_t *pnBytesAvailable) {
+	uint32_t nLeft = gnStreamLen - gnStreamPos;
+
+	if (nLeft == 0) {
+		*pnBytesAvailable = 0;
+	} else if (nLeft < XBEESTREAMTEST_UARTMAX) {
+		*pnBytesAvailable = 1 + HostTestRandRange(&gnSeed, nLeft);
+	} else {
+		*pnBytesAvailable = 1 + HostTestRandRange(&gnSeed, XBEESTREAMTEST_UARTMAX);
+	}
+
+	return UART_Success;
+}
+
+static eUARTReturn_t XBeeStreamTestRead(sUARTIface_t *pUARTIface, uint16_t nBuffSize, void *pDataBuff, uint16_t *pnBytesRead) {
+	uint32_t nLeft = gnStreamLen - gnStreamPos;
+
+	if (nBuffSize > nLeft) {
+		nBuffSize = nLeft;
+	}
+
+	memcpy(pDataBuff, &(gaStream[gnStreamPos]), nBuffSize);
+	gnStreamPos += nBuffSize;
+	*pnBytesRead = nBuffSize;
+
+	return UART_Success;
+}
+
+static eUARTReturn_t XBeeStreamTestWrite(sUARTIface_t *pUARTIface, uint16_t nBuffSize, const void *pDataBuff) {
+	if (gnWritten + nBuffSize > sizeof(gaWritten)) {
+		return UART_Fail_Unknown;
+	}
+
+	memcpy(&(gaWritten[gnWritten]), pDataBuff, nBuffSize);
+	gnWritten += nBuffSize;
+
+	return UART_Success;
+}
+
+static eUARTReturn_t XBeeStreamTestWaitSend(sUARTIface_t *pUARTIface) {
+	return UART_Success;
+}
+
+static void XBeeStreamTestPut(uint8_t nByte, bool bEscape) {
+	if ((bEscape == true) && ((nByte == XBEE_STARTBYTE) || (nByte == XBEE_ESCAPEBYTE) || (nByte == 0x11) || (nByte == 0x13))) {
+		gaStream[gnStreamLen] = XBEE_ESCAPEBYTE;
+		gaStream[gnStreamLen + 1] = nByte ^ XBEE_ESCAPEXOR;
+		gnStreamLen += 2;
+	} else {
+		gaStream[gnStreamLen] = nByte;
+		gnStreamLen += 1;
+	}
+
+	return;
+}
+
+static uint32_t XBeeStreamTestBuild(bool bEscaped) {
+	uint8_t aData[XBEE_RECVBUFFERSIZE + 64], nSum, nNoise;
+	uint32_t nFrame, nKind, nCtr, nSent, nDamaged = 0;
+	uint16_t nLen;
+
+	gnStreamLen = 0;
+	gnStreamPos = 0;
+	gnExpected = 0;
+
+	for (nFrame = 0; nFrame < XBEESTREAMTEST_FRAMES; nFrame++) {
+		nKind = HostTestRandRange(&gnSeed, 20);
+
+		if (nKind == 0) { //Noise between frames, without start or escape bytes that would begin one
+			nCtr = 1 + HostTestRandRange(&gnSeed, XBEESTREAMTEST_NOISEMAX);
+			while (nCtr > 0) {
+				nNoise = HostTestRandRange(&gnSeed, 256);
+				if ((nNoise == XBEE_STARTBYTE) || (nNoise == XBEE_ESCAPEBYTE)) {
+					nNoise = 0;
+				}
+
+				XBeeStreamTestPut(nNoise, false);
+				nCtr -= 1;
+			}
+
+			continue;
+		}
+
+		if (nKind == 1) { //Too large for the data buffer
+			nLen = XBEE_RECVBUFFERSIZE - XBEE_MSGBASELENGTH + 1 + HostTestRandRange(&gnSeed, 50);
+		} else if (nKind < 5) {
+			nLen = 1 + HostTestRandRange(&gnSeed, XBEESTREAMTEST_LARGEFRAME);
+		} else {
+			nLen = 1 + HostTestRandRange(&gnSeed, XBEESTREAMTEST_SMALLFRAME);
+		}
+
+		nSum = 0;
+		for (nCtr = 0; nCtr < nLen; nCtr++) {
+			if (HostTestRandRange(&gnSeed, 4) == 0) {
+				aData[nCtr] = gaSpecial[HostTestRandRange(&gnSeed, sizeof(gaSpecial))];
+			} else {
+				aData[nCtr] = HostTestRandRange(&gnSeed, 256);
+			}
+
+			nSum += aData[nCtr];
+		}
+
+		XBeeStreamTestPut(XBEE_STARTBYTE, false);
+		XBeeStreamTestPut(nLen >> 8, bEscaped);
+		XBeeStreamTestPut(nLen & 0xFF, bEscaped);
+
+		//Only escaped streams can tell a frame was cut off, by the next start byte
+		if ((bEscaped == true) && (nKind == 3)) {
+			nSent = HostTestRandRange(&gnSeed, nLen);
+		} else {
+			nSent = nLen;
+		}
+
+		for (nCtr = 0; nCtr < nSent; nCtr++) {
+			XBeeStreamTestPut(aData[nCtr], bEscaped);
+		}
+
+		if (nSent < nLen) {
+			nDamaged += 1;
+			continue;
+		}
+
+		if (nKind == 2) { //Bad checksum
+			XBeeStreamTestPut((0xFF - nSum) ^ 0x5A, bEscaped);
+		} else {
+			XBeeStreamTestPut(0xFF - nSum, bEscaped);
+		}
+
+		if ((nKind == 1) || (nKind == 2)) {
+			nDamaged += 1;
+			continue;
+		}
+
+		gaExpected[gnExpected].nLen = nLen;
+		memcpy(gaExpected[gnExpected].aData, aData, nLen);
+		gnExpected += 1;
+	}
+
+	return nDamaged;
+}
+
+static bool XBeeStreamTestCheckFrame(uint32_t nFrame) {
+	uint16_t nLen;
+
+	if (nFrame >= gnExpected) {
+		return false;
+	}
+
+	nLen = (gXBee.anDataBuffer[XBIdx_LengthMSB] << 8) | gXBee.anDataBuffer[XBIdx_LengthLSB];
+	if (nLen != gaExpected[nFrame].nLen) {
+		return false;
+	}
+
+	if (memcmp(&(gXBee.anDataBuffer[XBIdx_DataStart]), gaExpected[nFrame].aData, nLen) != 0) {
+		return false;
+	}
+
+	return (XBeeAPIChecksum(gXBee.anDataBuffer) == gXBee.anDataBuffer[XBIdx_DataStart + nLen]) ? true : false;
+}
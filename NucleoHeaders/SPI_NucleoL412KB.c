@@ -31,6 +31,7 @@ eSPIReturn_t NucleoInitializeSPIBus(sSPIIface_t *pIface, void *pHWInfo, uint32_t
 	pIface->pfBeginTransfer = &NucleoBeginTransfer;
 	pIface->pfEndTransfer = &NucleoEndTransfer;
 	pIface->pfTransferByte = NucleoTransferByte;
+	pIface->pfTransferBlock = &NucleoTransferBlock;
 	pIface->pfGetCapabilities = &NucleoGetCapabilities;
 
 	pIface->eMode = eMode;
@@ -66,3 +67,32 @@ eSPIReturn_t NucleoTransferByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t
 		return SPIFail_Unknown;
 	}
 }
+
+eSPIReturn_t NucleoTransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes) {
+	HAL_StatusTypeDef eResult;
+	uint32_t nOffset;
+	uint16_t nChunk;
+
+	for (nOffset = 0; nOffset < nBytes; nOffset += nChunk) {
+		//HAL counts are 16 bits
+		if (nBytes - nOffset > 0xFFFF) {
+			nChunk = 0xFFFF;
+		} else {
+			nChunk = nBytes - nOffset;
+		}
+
+		if (pReadBytes == NULL) {
+			eResult = HAL_SPI_Transmit(pIface->pHWInfo, (uint8_t *)(pSendBytes + nOffset), nChunk, SPI_BLOCKTIMEOUT);
+		} else if (pSendBytes == NULL) {
+			eResult = HAL_SPI_Receive(pIface->pHWInfo, pReadBytes + nOffset, nChunk, SPI_BLOCKTIMEOUT);
+		} else {
+			eResult = HAL_SPI_TransmitReceive(pIface->pHWInfo, (uint8_t *)(pSendBytes + nOffset), pReadBytes + nOffset, nChunk, SPI_BLOCKTIMEOUT);
+		}
+
+		if (eResult != HAL_OK) {
+			return SPIFail_Unknown;
+		}
+	}
+
+	return SPI_Success;
+}
@@ -30,9 +30,11 @@
 
 	#define SPI_INIT		NucleoInitializeSPIBus
 
-	#define SPI_CAPS		(SPI_BeginTransfer | SPI_EndTransfer | SPI_BiDir1Byte)
+	#define SPI_CAPS		(SPI_BeginTransfer | SPI_EndTransfer | SPI_BiDir1Byte | SPI_BiDirBlock)
 
 	#define I2C_TIMEOUT		100
+	
+	#define SPI_BLOCKTIMEOUT	1000
 
 /*****	Definitions	*****/
 
@@ -53,6 +55,8 @@
 
 	eSPIReturn_t NucleoTransferByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t *pnReadByte);
 
+	eSPIReturn_t NucleoTransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes);
+
 /*****	Functions	*****/
 
 
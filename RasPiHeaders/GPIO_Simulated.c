@@ -0,0 +1,193 @@
+/**	File:	GPIO_Simulated.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "GPIO_Simulated.h"
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	eGPIOReturn_t GPIOSimReadModeByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, eGPIOModes_t *eMode);
+
+	eGPIOReturn_t GPIOSimSetModeByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, eGPIOModes_t eMode);
+
+	eGPIOReturn_t GPIOSimDigitalReadByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, bool *bState);
+
+	eGPIOReturn_t GPIOSimDigitalWriteByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, bool bState);
+
+	eGPIOReturn_t GPIOSimSetInterrupt(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, pfGPIOInterrupt_t pHandler, bool bEnable, void *pParam);
+
+/*****	Functions	*****/
+eGPIOReturn_t GPIOSimPortInitialize(sGPIOIface_t *pIface, void *pHWInfo) {
+	sGPIOSimInfo_t *pSim = (sGPIOSimInfo_t *)pHWInfo;
+	uint16_t nCtr;
+
+	if (pSim == NULL) {
+		return GPIOFail_Unknown;
+	}
+
+	GPIOInterfaceInitialize(pIface);
+
+	memset(pSim, 0, sizeof(sGPIOSimInfo_t));
+
+	//Only add function pointers to the supported features
+	pIface->pfPortInit = &GPIOSimPortInitialize;
+	pIface->pfReadModeByPin = &GPIOSimReadModeByPin;
+	pIface->pfSetModeByPin = &GPIOSimSetModeByPin;
+	pIface->pfDigitalReadByPin = &GPIOSimDigitalReadByPin;
+	pIface->pfDigitalWriteByPin = &GPIOSimDigitalWriteByPin;
+	pIface->pfSetInterrupt = &GPIOSimSetInterrupt;
+
+	pIface->ePortCapabilities = GPIOCap_SetPinMode | GPIOCap_ReadPinMode | GPIOCap_DigitalWrite | GPIOCap_DigitalRead | GPIOCap_SetInterrupt;
+	pIface->nGPIOCnt = GPIOSIM_PINCOUNT;
+	pIface->pHWInfo = pSim;
+	pSim->pIface = pIface;
+
+	for (nCtr = 0; nCtr < GPIOSIM_PINCOUNT; nCtr++) {
+		pIface->aGPIO[nCtr].eCapabilities = GPIO_DigitalInput | GPIO_DigitalOutput;
+		pIface->aGPIO[nCtr].eMode = GPIO_DigitalInput;
+	}
+
+	return GPIO_Success;
+}
+
+eGPIOReturn_t GPIOSimSetInput(sGPIOSimInfo_t *pSim, GPIOID_t nGPIOPin, bool bState) {
+	sGPIOSimInt_t *pInt;
+
+	if (nGPIOPin >= GPIOSIM_PINCOUNT) {
+		return GPIOFail_InvalidPin;
+	}
+
+	if (pSim->aStates[nGPIOPin] == bState) { //No edge, nothing to signal
+		return GPIO_Success;
+	}
+
+	pSim->aStates[nGPIOPin] = bState;
+
+	pInt = &(pSim->aInts[nGPIOPin]);
+	if ((pInt->bEnable == true) && (pInt->pfHandler != NULL) && (pSim->pIface->aGPIO[nGPIOPin].eMode == GPIO_DigitalInput)) {
+		pInt->pfHandler(pSim->pIface, nGPIOPin, pInt->pParam);
+	}
+
+	return GPIO_Success;
+}
+
+bool GPIOSimReadEdge(sGPIOSimInfo_t *pSim, sGPIOSimEdge_t *pEdge) {
+	if (pSim->nLogCnt == 0) {
+		return false;
+	}
+
+	*pEdge = pSim->aLog[pSim->nLogHead];
+
+	pSim->nLogHead = (pSim->nLogHead + 1) % GPIOSIM_LOGMAX;
+	pSim->nLogCnt -= 1;
+
+	return true;
+}
+
+uint64_t GPIOSimTimeMicroSec(void) {
+	struct timespec TimeInfo;
+
+	clock_gettime(CLOCK_MONOTONIC, &TimeInfo);
+
+	return ((uint64_t)TimeInfo.tv_sec * 1000000) + ((uint64_t)TimeInfo.tv_nsec / 1000);
+}
+
+void GPIOSimDelayMicroSec(uint32_t nMicroSec) {
+	uint64_t nEnd = GPIOSimTimeMicroSec() + nMicroSec;
+
+	while (GPIOSimTimeMicroSec() < nEnd) {
+		//Spin until the time passes
+	}
+
+	return;
+}
+
+eGPIOReturn_t GPIOSimReadModeByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, eGPIOModes_t *eMode) {
+	if (nGPIOPin >= GPIOSIM_PINCOUNT) {
+		return GPIOFail_InvalidPin;
+	}
+
+	(*eMode) = pIface->aGPIO[nGPIOPin].eMode;
+
+	return GPIO_Success;
+}
+
+eGPIOReturn_t GPIOSimSetModeByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, eGPIOModes_t eMode) {
+	if (nGPIOPin >= GPIOSIM_PINCOUNT) {
+		return GPIOFail_InvalidPin;
+	}
+
+	if ((eMode != GPIO_DigitalInput) && (eMode != GPIO_DigitalOutput)) {
+		return GPIOFail_InvalidMode;
+	}
+
+	pIface->aGPIO[nGPIOPin].eMode = eMode;
+
+	return GPIO_Success;
+}
+
+eGPIOReturn_t GPIOSimDigitalReadByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, bool *bState) {
+	sGPIOSimInfo_t *pSim = (sGPIOSimInfo_t *)pIface->pHWInfo;
+
+	if (nGPIOPin >= GPIOSIM_PINCOUNT) {
+		return GPIOFail_InvalidPin;
+	}
+
+	*bState = pSim->aStates[nGPIOPin];
+
+	return GPIO_Success;
+}
+
+eGPIOReturn_t GPIOSimDigitalWriteByPin(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, bool bState) {
+	sGPIOSimInfo_t *pSim = (sGPIOSimInfo_t *)pIface->pHWInfo;
+	sGPIOSimEdge_t *pEdge;
+
+	if (nGPIOPin >= GPIOSIM_PINCOUNT) {
+		return GPIOFail_InvalidPin;
+	}
+
+	if (pIface->aGPIO[nGPIOPin].eMode != GPIO_DigitalOutput) {
+		return GPIOFail_InvalidOp;
+	}
+
+	pSim->aStates[nGPIOPin] = bState;
+
+	if (pSim->nLogCnt == GPIOSIM_LOGMAX) { //Keep the earliest writes, count the rest
+		pSim->nLost += 1;
+		return GPIO_Success;
+	}
+
+	pEdge = &(pSim->aLog[(pSim->nLogHead + pSim->nLogCnt) % GPIOSIM_LOGMAX]);
+	pEdge->nPin = nGPIOPin;
+	pEdge->bState = bState;
+	pEdge->nTimeUS = GPIOSimTimeMicroSec();
+
+	pSim->nLogCnt += 1;
+
+	return GPIO_Success;
+}
+
+
+eGPIOReturn_t GPIOSimSetInterrupt(sGPIOIface_t *pIface, GPIOID_t nGPIOPin, pfGPIOInterrupt_t pHandler, bool bEnable, void *pParam) {
+	sGPIOSimInfo_t *pSim = (sGPIOSimInfo_t *)pIface->pHWInfo;
+
+	if (nGPIOPin >= GPIOSIM_PINCOUNT) {
+		return GPIOFail_InvalidPin;
+	}
+
+	pSim->aInts[nGPIOPin].bEnable = bEnable;
+	pSim->aInts[nGPIOPin].pfHandler = pHandler;
+	pSim->aInts[nGPIOPin].pParam = pParam;
+
+	return GPIO_Success;
+}
@@ -0,0 +1,145 @@
+/**	@defgroup	gpiosim
+	@brief		Simulated GPIO General Interface implementation for Linux
+	@details	v0.2
+	# Description #
+		Provides GPIO pins that exist only in memory so code driving outputs
+		can run on any Linux machine.  Every write to an output is stamped with
+		the monotonic clock in microseconds and kept in a log, which lets the
+		timing of pulses and other sequences be measured against what was
+		requested.  Inputs are set by the application to stand in for external
+		signals, and any interrupt set on an input is called when it changes.
+
+	# Usage #
+		Pass an sGPIOSimInfo_t as the hardware information when initializing
+		the interface.  Read back the log of writes with GPIOSimReadEdge(), the
+		oldest write first.  If the log fills further writes are counted as lost
+		rather than stored.
+
+		Interrupt handlers are called on both edges from within
+		GPIOSimSetInput(), standing in for the pin's interrupt.
+
+	# File Information #
+		File:	GPIO_Simulated.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __GPIOSIMULATED
+	#define __GPIOSIMULATED
+
+/*****	Includes	*****/
+	#define _POSIX_C_SOURCE      199309L
+
+	#include <time.h>
+
+	#include "CommonUtils.h"
+	#include "GPIOGeneralInterface.h"
+
+/*****	Definitions	*****/
+	#ifndef GPIOSIM_LOGMAX
+		/**	@brief		Number of writes the log can hold
+			@ingroup	gpiosim
+		*/
+		#define GPIOSIM_LOGMAX		1024
+	#endif
+
+	/**	@brief		Number of simulated pins
+		@ingroup	gpiosim
+	*/
+	#define GPIOSIM_PINCOUNT		GPIO_IOCNT
+
+	/**	@brief		Millisecond delay drivers expect the platform GPIO header to provide
+		@ingroup	gpiosim
+	*/
+	#define DELAYMILLISEC(nMilliSec)	GPIOSimDelayMicroSec((uint32_t)(nMilliSec) * 1000)
+
+	/**	@brief		Microsecond delay drivers expect the platform GPIO header to provide
+		@ingroup	gpiosim
+	*/
+	#define DELAYMICROSEC			GPIOSimDelayMicroSec
+
+	/**	@brief		A single write to an output recorded in the log
+		@ingroup	gpiosim
+	*/
+	typedef struct sGPIOSimEdge_t {
+		GPIOID_t nPin;							/**< Pin that was written */
+		bool bState;							/**< State the pin was set to */
+		uint64_t nTimeUS;						/**< Monotonic time of the write in microseconds */
+	} sGPIOSimEdge_t;
+
+	/**	@brief		Interrupt set on a simulated pin
+		@ingroup	gpiosim
+	*/
+	typedef struct sGPIOSimInt_t {
+		bool bEnable;							/**< True if the handler is to be called */
+		pfGPIOInterrupt_t pfHandler;			/**< Function to call when the input changes */
+		void *pParam;							/**< Parameter given to the handler */
+	} sGPIOSimInt_t;
+
+	/**	@brief		State of the simulated pins and the log of writes
+		@ingroup	gpiosim
+	*/
+	typedef struct sGPIOSimInfo_t {
+		sGPIOIface_t *pIface;					/**< Interface these pins belong to, given to interrupt handlers */
+		bool aStates[GPIOSIM_PINCOUNT];			/**< Current state of each pin */
+		sGPIOSimInt_t aInts[GPIOSIM_PINCOUNT];	/**< Interrupt set on each pin */
+		sGPIOSimEdge_t aLog[GPIOSIM_LOGMAX];	/**< Writes to outputs, oldest first from the head */
+		uint32_t nLogHead;						/**< Index of the oldest write in the log */
+		uint32_t nLogCnt;						/**< Number of writes in the log */
+		uint32_t nLost;							/**< Writes that were not logged because it was full */
+	} sGPIOSimInfo_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare the simulated GPIO for use
+		@details	All pins start as inputs in the low state with an empty log
+		@param		pIface		Pointer to interface object to prepare for use
+		@param		pHWInfo		Pointer to the sGPIOSimInfo_t holding the pins
+		@ingroup	gpiosim
+	*/
+	eGPIOReturn_t GPIOSimPortInitialize(sGPIOIface_t *pIface, void *pHWInfo);
+
+	/**	@brief		Set the state read from an input pin
+		@details	If the state changes and the pin is an input with an interrupt
+			enabled its handler is called before returning.
+		@param		pSim		Simulated pins
+		@param		nGPIOPin	Pin to set
+		@param		bState		State the pin will read as
+		@return		GPIO_Success if the pin was set, GPIOFail_InvalidPin if it
+			does not exist
+		@ingroup	gpiosim
+	*/
+	eGPIOReturn_t GPIOSimSetInput(sGPIOSimInfo_t *pSim, GPIOID_t nGPIOPin, bool bState);
+
+	/**	@brief		Take the oldest write out of the log
+		@param		pSim		Simulated pins
+		@param		pEdge		Returns the details of the write
+		@return		True if a write was returned, false if the log is empty
+		@ingroup	gpiosim
+	*/
+	bool GPIOSimReadEdge(sGPIOSimInfo_t *pSim, sGPIOSimEdge_t *pEdge);
+
+	/**	@brief		Read the clock used to stamp the log
+		@return		Monotonic time in microseconds
+		@ingroup	gpiosim
+	*/
+	uint64_t GPIOSimTimeMicroSec(void);
+
+	/**	@brief		Wait on the clock used to stamp the log
+		@details	Spins rather than sleeping so short delays are not stretched to
+			the scheduler's resolution.
+		@param		nMicroSec	Microseconds to wait
+		@ingroup	gpiosim
+	*/
+	void GPIOSimDelayMicroSec(uint32_t nMicroSec);
+
+/*****	Functions	*****/
+
+
+#endif
+
@@ -0,0 +1,792 @@
+/**	File:	NetworkEpoll_RaspberryPi.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "NetworkEpoll_RaspberryPi.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+eNetReturn_t RasPiEpollTCPServInitialize(sTCPServ_t *pTCPServ);
+eNetReturn_t RasPiEpollTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn);
+eNetReturn_t RasPiEpollTCPServCloseHost(sTCPServ_t *pTCPServ);
+eNetReturn_t RasPiEpollTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+eNetReturn_t RasPiEpollTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+eNetReturn_t RasPiEpollTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t RasPiEpollTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiEpollTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nMillisec);
+
+/**	@brief		Place a socket in a free slot and register it with epoll
+	@param		pLoop		Loop to add the socket to
+	@param		pTCPServ	Server the socket belongs to
+	@param		nSocket		File descriptor of the socket, already non-blocking
+	@param		bListener	True if this is a listening socket
+	@return		Slot the socket was placed in, or RASPIEPOLL_NOSLOT if the loop
+		has no room for it
+	@ingroup	raspiepoll
+*/
+static uint16_t RasPiEpollAddSocket(sRasPiEpoll_t *pLoop, sTCPServ_t *pTCPServ, int32_t nSocket, bool bListener);
+
+/**	@brief		Take a socket out of epoll and free its slot
+	@details	Does not close the socket
+	@param		pLoop		Loop holding the socket
+	@param		nSlot		Slot holding the socket
+	@ingroup	raspiepoll
+*/
+static void RasPiEpollRemoveSocket(sRasPiEpoll_t *pLoop, uint16_t nSlot);
+
+/**	@brief		Find the slot holding a server's socket
+	@param		pTCPServ	Server the socket belongs to
+	@param		pSck		Socket to find
+	@return		Slot holding the socket, or RASPIEPOLL_NOSLOT if it is not in
+		the loop
+	@ingroup	raspiepoll
+*/
+static uint16_t RasPiEpollFindSlot(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+
+/**	@brief		Add a slot to the list of slots to dispatch
+	@param		pLoop		Loop holding the slot
+	@param		nSlot		Slot to add
+	@ingroup	raspiepoll
+*/
+static void RasPiEpollQueueReady(sRasPiEpoll_t *pLoop, uint16_t nSlot);
+
+/**	@brief		Accept every connection waiting on a listening socket
+	@details	Connections the loop has no room for are closed right away
+	@param		pLoop		Loop holding the listening socket
+	@param		nSlot		Slot of the listening socket
+	@ingroup	raspiepoll
+*/
+static void RasPiEpollAcceptAll(sRasPiEpoll_t *pLoop, uint16_t nSlot);
+
+/**	@brief		Write as much of a slot's transmit buffer as the socket will take
+	@param		pSlot		Slot to write out
+	@return		Net_Success if the buffer was written or the socket is full,
+		NetFail_Unknown if the socket failed
+	@ingroup	raspiepoll
+*/
+static eNetReturn_t RasPiEpollFlush(sRasPiEpollSlot_t *pSlot);
+
+/*****	Functions	*****/
+eNetReturn_t RasPiEpollInitialize(sRasPiEpoll_t *pLoop) {
+	uint32_t nCtr;
+
+	memset(pLoop, 0, sizeof(sRasPiEpoll_t));
+
+	for (nCtr = 0; nCtr < RASPIEPOLL_MAXFD; nCtr++) {
+		pLoop->aFdSlot[nCtr] = RASPIEPOLL_NOSLOT;
+	}
+
+	for (nCtr = 0; nCtr < RASPIEPOLL_MAXSOCKETS; nCtr++) {
+		pLoop->aSlots[nCtr].Sck.nSocket = SOCKET_INVALID;
+	}
+
+	pLoop->nEpollFd = epoll_create1(0);
+	if (pLoop->nEpollFd < 0) {
+		//errno has the failure code
+		return NetFail_Unknown;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollClose(sRasPiEpoll_t *pLoop) {
+	uint16_t nCtr;
+	int32_t nSocket;
+
+	for (nCtr = 0; nCtr < RASPIEPOLL_MAXSOCKETS; nCtr++) {
+		if (pLoop->aSlots[nCtr].bInUse == false) {
+			continue;
+		}
+
+		if (pLoop->aSlots[nCtr].bListener == true) {
+			pLoop->aSlots[nCtr].pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		}
+
+		nSocket = pLoop->aSlots[nCtr].Sck.nSocket;
+		RasPiEpollRemoveSocket(pLoop, nCtr);
+		close(nSocket);
+	}
+
+	if (pLoop->nEpollFd >= 0) {
+		close(pLoop->nEpollFd);
+		pLoop->nEpollFd = SOCKET_INVALID;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollCreateTCPServer(sRasPiEpoll_t *pLoop, sTCPServ_t *pTCPServ) {
+	RasPiEpollTCPServInitialize(pTCPServ);
+
+	pTCPServ->pHWInfo = pLoop;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollSetHandler(sTCPServ_t *pTCPServ, sSocket_t *pSck, pfRasPiEpollHandler_t pfHandler, void *pParam) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	sRasPiEpollSlot_t *pSlot;
+	uint16_t nSlot;
+	uint32_t nCtr, nKeep;
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, pSck);
+	if (nSlot == RASPIEPOLL_NOSLOT) {
+		return NetFail_InvSocket;
+	}
+
+	pSlot = &(pLoop->aSlots[nSlot]);
+	pSlot->pfHandler = pfHandler;
+	pSlot->pParam = pParam;
+
+	if (pfHandler == NULL) {
+		return Net_Success;
+	}
+
+	if (pSlot->bListener == false) {
+		if (pSlot->bReadable == true) { //Data arrived before there was anyone to read it
+			RasPiEpollQueueReady(pLoop, nSlot);
+		}
+
+		return Net_Success;
+	}
+
+	//Clients waiting on the accept function go to the handler now
+	nKeep = 0;
+	for (nCtr = 0; nCtr < pLoop->nPendingCnt; nCtr++) {
+		nSlot = pLoop->aPending[nCtr];
+
+		if (pLoop->aSlots[nSlot].pTCPServ != pTCPServ) {
+			pLoop->aPending[nKeep] = nSlot;
+			nKeep += 1;
+			continue;
+		}
+
+		pLoop->aSlots[nSlot].pfHandler = pfHandler;
+		pLoop->aSlots[nSlot].pParam = pParam;
+		pfHandler(pTCPServ, &(pLoop->aSlots[nSlot].Sck), RasPiEpoll_Accepted, pParam);
+
+		if ((pLoop->aSlots[nSlot].bInUse == true) && (pLoop->aSlots[nSlot].bReadable == true)) {
+			RasPiEpollQueueReady(pLoop, nSlot);
+		}
+	}
+	pLoop->nPendingCnt = nKeep;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollWantWrite(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	uint16_t nSlot;
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, pSck);
+	if (nSlot == RASPIEPOLL_NOSLOT) {
+		return NetFail_InvSocket;
+	}
+
+	pLoop->aSlots[nSlot].bWantWrite = true;
+
+	return Net_Success;
+}
+
+uint32_t RasPiEpollTxPending(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	uint16_t nSlot;
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, pSck);
+	if (nSlot == RASPIEPOLL_NOSLOT) {
+		return 0;
+	}
+
+	return pLoop->aSlots[nSlot].nTxLen;
+}
+
+eNetReturn_t RasPiEpollProcess(sRasPiEpoll_t *pLoop, uint32_t nTimeoutMS) {
+	struct epoll_event aEvents[RASPIEPOLL_EVENTBATCH];
+	sRasPiEpollSlot_t *pSlot;
+	eRasPiEpollEvent_t eEvents;
+	int nEvents, nCtr;
+	uint32_t nIdx, nCnt, nKeep;
+	uint16_t nSlot;
+
+	if (pLoop->nReadyCnt > 0) { //Sockets still hold data, only collect new events
+		nTimeoutMS = 0;
+	}
+
+	nEvents = epoll_wait(pLoop->nEpollFd, aEvents, RASPIEPOLL_EVENTBATCH, nTimeoutMS);
+	if (nEvents < 0) {
+		if (errno == EINTR) { //Interrupted by a signal, nothing happened
+			return Net_Success;
+		}
+
+		//errno has the failure code
+		return NetFail_Unknown;
+	}
+
+	//Record what each socket is ready for, handlers are called after
+	for (nCtr = 0; nCtr < nEvents; nCtr++) {
+		nSlot = (uint16_t)aEvents[nCtr].data.u32;
+		pSlot = &(pLoop->aSlots[nSlot]);
+
+		if (pSlot->bInUse == false) {
+			continue;
+		}
+
+		if (aEvents[nCtr].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+			//Errors and hangups are reported through the next receive
+			pSlot->bReadable = true;
+		}
+
+		if (aEvents[nCtr].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+			pSlot->bHangup = true;
+		}
+
+		if ((aEvents[nCtr].events & EPOLLOUT) && (pSlot->nTxLen > 0)) {
+			RasPiEpollFlush(pSlot);
+		}
+
+		if ((pSlot->bReadable == true) || ((pSlot->bWantWrite == true) && (pSlot->nTxLen == 0))) {
+			RasPiEpollQueueReady(pLoop, nSlot);
+		}
+	}
+
+	//Dispatch, anything queued by the handlers lands past nCnt
+	nCnt = pLoop->nReadyCnt;
+	nKeep = 0;
+	for (nIdx = 0; nIdx < nCnt; nIdx++) {
+		nSlot = pLoop->aReady[nIdx];
+		pSlot = &(pLoop->aSlots[nSlot]);
+		pSlot->bQueued = false;
+
+		if (pSlot->bInUse == false) {
+			continue;
+		}
+
+		if (pSlot->bListener == true) {
+			RasPiEpollAcceptAll(pLoop, nSlot);
+			continue;
+		}
+
+		if (pSlot->pfHandler == NULL) { //Waiting on the accept function, keep it readable
+			continue;
+		}
+
+		eEvents = RasPiEpoll_None;
+		if (pSlot->bReadable == true) {
+			eEvents |= RasPiEpoll_Readable;
+		}
+
+		if (pSlot->bHangup == true) {
+			eEvents |= RasPiEpoll_Hangup;
+		}
+
+		if ((pSlot->bWantWrite == true) && (pSlot->nTxLen == 0)) {
+			pSlot->bWantWrite = false;
+			eEvents |= RasPiEpoll_Writable;
+		}
+
+		if (eEvents == RasPiEpoll_None) {
+			continue;
+		}
+
+		//Everything the handler sends is gathered and written out together
+		pSlot->bCorked = true;
+		pSlot->pfHandler(pSlot->pTCPServ, &(pSlot->Sck), eEvents, pSlot->pParam);
+		pSlot->bCorked = false;
+
+		if (pSlot->bInUse == false) { //Handler closed the socket
+			continue;
+		}
+
+		RasPiEpollFlush(pSlot);
+
+		//A hang up that came with the last of the data gets no new edge, report it alone once drained
+		if (((pSlot->bReadable == true) || ((pSlot->bHangup == true) && ((eEvents & RasPiEpoll_Readable) != 0))) && (pSlot->bQueued == false)) {
+			pLoop->aReady[nKeep] = nSlot;
+			nKeep += 1;
+			pSlot->bQueued = true;
+		}
+	}
+
+	//Slide down anything the handlers queued
+	for (nIdx = nCnt; nIdx < pLoop->nReadyCnt; nIdx++) {
+		pLoop->aReady[nKeep] = pLoop->aReady[nIdx];
+		nKeep += 1;
+	}
+	pLoop->nReadyCnt = nKeep;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollTCPServInitialize(sTCPServ_t *pTCPServ) {
+	//Always begin with default settigns
+	IfaceTCPServObjInitialize(pTCPServ);
+
+	//Update the function pointers to this implementation
+	pTCPServ->pfInitialize = &RasPiEpollTCPServInitialize;
+	pTCPServ->pfBind = &RasPiEpollTCPServBind;
+	pTCPServ->pfCloseHost = &RasPiEpollTCPServCloseHost;
+	pTCPServ->pfCloseSocket = &RasPiEpollTCPServCloseSocket;
+	pTCPServ->pfAcceptClient = &RasPiEpollTCPServAcceptClient;
+	pTCPServ->pfReceive = &RasPiEpollTCPServReceive;
+	pTCPServ->pfSend = &RasPiEpollTCPServSend;
+	pTCPServ->pfSetRecvTimeout = &RasPiEpollTCPServSetRecvTimeOut;
+
+	pTCPServ->eCapabilities = TCPSERVEPOLL_CAPS;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	struct sockaddr_in sAddr;
+	int nReuse = 1;
+
+	if (pLoop == NULL) { //Server was not created on a loop
+		return NetFail_SocketState;
+	}
+
+	if (pTCPServ->HostSck.nSocket != SOCKET_INVALID) { //Socket appears open, close it
+		RasPiEpollTCPServCloseHost(pTCPServ);
+	}
+
+	//Create server socket
+	pTCPServ->HostSck.nSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	pTCPServ->HostSck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+	pTCPServ->HostSck.Conn.Port = pConn->Port;
+
+	if (pTCPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_Unknown; //errno may hold more information
+	}
+
+	setsockopt(pTCPServ->HostSck.nSocket, SOL_SOCKET, SO_REUSEADDR, &nReuse, sizeof(nReuse));
+
+	//Bind the requested port
+	memset(&sAddr, 0, sizeof(struct sockaddr_in));
+	sAddr.sin_port = htons(pConn->Port);
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_addr.s_addr = pConn->Addr.nNetLong;
+
+	if (bind(pTCPServ->HostSck.nSocket, (struct sockaddr *)&sAddr, sizeof(struct sockaddr_in)) != 0) {
+		//Returns -1 on error, errno holds code
+		close(pTCPServ->HostSck.nSocket);
+		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_BindErr;
+	}
+
+	//Many clients may connect at once, let the kernel hold them all
+	if (listen(pTCPServ->HostSck.nSocket, SOMAXCONN) != 0) {
+		//Returns -1 on error, errno holds code
+		close(pTCPServ->HostSck.nSocket);
+		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_Unknown;
+	}
+
+	if (RasPiEpollAddSocket(pLoop, pTCPServ, pTCPServ->HostSck.nSocket, true) == RASPIEPOLL_NOSLOT) {
+		close(pTCPServ->HostSck.nSocket);
+		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_Unknown;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollTCPServCloseHost(sTCPServ_t *pTCPServ) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	uint16_t nSlot;
+
+	if (pTCPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, &(pTCPServ->HostSck));
+	if (nSlot != RASPIEPOLL_NOSLOT) {
+		RasPiEpollRemoveSocket(pLoop, nSlot);
+	}
+
+	close(pTCPServ->HostSck.nSocket);
+	pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+	pTCPServ->HostSck.Conn.Addr.nNetLong = 0;
+	pTCPServ->HostSck.Conn.Port = 0;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	int32_t nSocket = pSck->nSocket;
+	uint16_t nSlot;
+
+	if (nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, pSck);
+	if (nSlot != RASPIEPOLL_NOSLOT) {
+		//Give anything still buffered one last chance to go out
+		RasPiEpollFlush(&(pLoop->aSlots[nSlot]));
+		RasPiEpollRemoveSocket(pLoop, nSlot);
+	}
+
+	close(nSocket);
+	pSck->nSocket = SOCKET_INVALID;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	eNetReturn_t eResult;
+	uint16_t nHost, nSlot;
+	uint32_t nCtr;
+
+	pSck->nSocket = SOCKET_INVALID;
+
+	while (true) {
+		nHost = RasPiEpollFindSlot(pTCPServ, &(pTCPServ->HostSck));
+		if (nHost == RASPIEPOLL_NOSLOT) { //Not listening
+			return NetFail_SocketState;
+		}
+
+		if (pLoop->aSlots[nHost].pfHandler != NULL) { //New clients all go to the handler
+			return NetFail_SocketState;
+		}
+
+		for (nCtr = 0; nCtr < pLoop->nPendingCnt; nCtr++) {
+			nSlot = pLoop->aPending[nCtr];
+
+			if (pLoop->aSlots[nSlot].pTCPServ != pTCPServ) {
+				continue;
+			}
+
+			//Take this client out of the waiting list
+			memmove(&(pLoop->aPending[nCtr]), &(pLoop->aPending[nCtr + 1]), (pLoop->nPendingCnt - nCtr - 1) * sizeof(uint16_t));
+			pLoop->nPendingCnt -= 1;
+
+			*pSck = pLoop->aSlots[nSlot].Sck;
+			return Net_Success;
+		}
+
+		//Nobody waiting, other sockets are serviced while this one blocks
+		eResult = RasPiEpollProcess(pLoop, 1000);
+		if (eResult != Net_Success) {
+			return eResult;
+		}
+	}
+}
+
+eNetReturn_t RasPiEpollTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	sRasPiEpollSlot_t *pSlot;
+	uint16_t nSlot;
+	ssize_t nResult;
+
+	*pnBytesRecv = 0;
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, pSck);
+	if (nSlot == RASPIEPOLL_NOSLOT) {
+		return NetFail_InvSocket;
+	}
+	pSlot = &(pLoop->aSlots[nSlot]);
+
+	nResult = recv(pSck->nSocket, pData, nDataBytes, 0);
+	if (nResult < 0) {
+		if (errno == EINTR) { //Interrupted, the data is still there
+			return NetWarn_EndOfData;
+		}
+
+		pSlot->bReadable = false;
+
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) { //Nothing waiting
+			return NetWarn_EndOfData;
+		}
+
+		//errno has the failure code
+		pSlot->bHangup = true;
+		return NetFail_Unknown;
+	}
+
+	if ((nResult == 0) && (nDataBytes > 0)) { //Client closed the connection
+		pSlot->bReadable = false;
+		pSlot->bHangup = true;
+		return NetFail_SocketState;
+	}
+
+	*pnBytesRecv = (uint32_t)nResult;
+
+	if (*pnBytesRecv < nDataBytes) {
+		//A short read on a stream means the socket was emptied, the next data raises a new edge
+		pSlot->bReadable = false;
+		return NetWarn_EndOfData;
+	} else {
+		return Net_Success;
+	}
+}
+
+eNetReturn_t RasPiEpollTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	sRasPiEpollSlot_t *pSlot;
+	uint16_t nSlot;
+	ssize_t nResult;
+
+	nSlot = RasPiEpollFindSlot(pTCPServ, pSck);
+	if (nSlot == RASPIEPOLL_NOSLOT) {
+		return NetFail_InvSocket;
+	}
+	pSlot = &(pLoop->aSlots[nSlot]);
+
+	if (nDataBytes > RASPIEPOLL_TXBUFFSIZE) { //Whatever the socket left could not be held, send none of it
+		return NetFail_BuffSize;
+	}
+
+	if ((pSlot->bCorked == true) || (pSlot->nTxLen > 0)) {
+		if (pSlot->nTxLen + nDataBytes > RASPIEPOLL_TXBUFFSIZE) { //Make room
+			if (RasPiEpollFlush(pSlot) != Net_Success) {
+				return NetFail_Unknown;
+			}
+		}
+
+		if (pSlot->nTxLen + nDataBytes <= RASPIEPOLL_TXBUFFSIZE) {
+			memcpy(&(pSlot->aTxBuff[pSlot->nTxLen]), pData, nDataBytes);
+			pSlot->nTxLen += nDataBytes;
+
+			return Net_Success;
+		}
+
+		//Client is not keeping up, nothing was queued
+		return NetFail_SocketState;
+	}
+
+	nResult = send(pSck->nSocket, pData, nDataBytes, MSG_NOSIGNAL);
+	if (nResult < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+			//errno has the failure code
+			return NetFail_Unknown;
+		}
+
+		nResult = 0;
+	}
+
+	nDataBytes -= (uint32_t)nResult;
+	if (nDataBytes == 0) {
+		return Net_Success;
+	}
+
+	//Hold the rest until the socket can take more, it always fits
+	memcpy(pSlot->aTxBuff, &(((uint8_t *)pData)[nResult]), nDataBytes);
+	pSlot->nTxLen = nDataBytes;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiEpollTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nMillisec) {
+	//Receives never block, the wait happens in RasPiEpollProcess()
+	return Net_Success;
+}
+
+static uint16_t RasPiEpollAddSocket(sRasPiEpoll_t *pLoop, sTCPServ_t *pTCPServ, int32_t nSocket, bool bListener) {
+	struct epoll_event Event;
+	sRasPiEpollSlot_t *pSlot;
+	uint16_t nSlot;
+
+	if ((nSocket < 0) || (nSocket >= RASPIEPOLL_MAXFD)) {
+		return RASPIEPOLL_NOSLOT;
+	}
+
+	//Slots still in the ready list are skipped so they are not queued twice
+	for (nSlot = 0; nSlot < RASPIEPOLL_MAXSOCKETS; nSlot++) {
+		if ((pLoop->aSlots[nSlot].bInUse == false) && (pLoop->aSlots[nSlot].bQueued == false)) {
+			break;
+		}
+	}
+
+	if (nSlot == RASPIEPOLL_MAXSOCKETS) {
+		return RASPIEPOLL_NOSLOT;
+	}
+
+	pSlot = &(pLoop->aSlots[nSlot]);
+	pSlot->Sck.nSocket = nSocket;
+	pSlot->pTCPServ = pTCPServ;
+	pSlot->pfHandler = NULL;
+	pSlot->pParam = NULL;
+	pSlot->bListener = bListener;
+	pSlot->bReadable = false;
+	pSlot->bHangup = false;
+	pSlot->bWantWrite = false;
+	pSlot->bCorked = false;
+	pSlot->nTxLen = 0;
+
+	memset(&Event, 0, sizeof(struct epoll_event));
+	Event.data.u32 = nSlot;
+	if (bListener == true) {
+		Event.events = EPOLLIN | EPOLLET;
+	} else {
+		Event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+	}
+
+	if (epoll_ctl(pLoop->nEpollFd, EPOLL_CTL_ADD, nSocket, &Event) != 0) {
+		//errno has the failure code
+		return RASPIEPOLL_NOSLOT;
+	}
+
+	pSlot->bInUse = true;
+	pLoop->aFdSlot[nSocket] = nSlot;
+	pLoop->nSlotsUsed += 1;
+
+	return nSlot;
+}
+
+static void RasPiEpollRemoveSocket(sRasPiEpoll_t *pLoop, uint16_t nSlot) {
+	sRasPiEpollSlot_t *pSlot = &(pLoop->aSlots[nSlot]);
+	uint32_t nCtr, nKeep;
+
+	epoll_ctl(pLoop->nEpollFd, EPOLL_CTL_DEL, pSlot->Sck.nSocket, NULL);
+
+	pLoop->aFdSlot[pSlot->Sck.nSocket] = RASPIEPOLL_NOSLOT;
+	pLoop->nSlotsUsed -= 1;
+
+	//A client nobody accepted yet must not be handed out
+	nKeep = 0;
+	for (nCtr = 0; nCtr < pLoop->nPendingCnt; nCtr++) {
+		if (pLoop->aPending[nCtr] != nSlot) {
+			pLoop->aPending[nKeep] = pLoop->aPending[nCtr];
+			nKeep += 1;
+		}
+	}
+	pLoop->nPendingCnt = nKeep;
+
+	//The ready list entry is dropped the next time it is dispatched
+	pSlot->bInUse = false;
+	pSlot->bReadable = false;
+	pSlot->Sck.nSocket = SOCKET_INVALID;
+	pSlot->nTxLen = 0;
+
+	return;
+}
+
+static uint16_t RasPiEpollFindSlot(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiEpoll_t *pLoop = (sRasPiEpoll_t *)pTCPServ->pHWInfo;
+	uint16_t nSlot;
+
+	if ((pLoop == NULL) || (pSck->nSocket < 0) || (pSck->nSocket >= RASPIEPOLL_MAXFD)) {
+		return RASPIEPOLL_NOSLOT;
+	}
+
+	nSlot = pLoop->aFdSlot[pSck->nSocket];
+	if (nSlot == RASPIEPOLL_NOSLOT) {
+		return RASPIEPOLL_NOSLOT;
+	}
+
+	if (pLoop->aSlots[nSlot].pTCPServ != pTCPServ) { //Socket belongs to another server
+		return RASPIEPOLL_NOSLOT;
+	}
+
+	return nSlot;
+}
+
+static void RasPiEpollQueueReady(sRasPiEpoll_t *pLoop, uint16_t nSlot) {
+	if (pLoop->aSlots[nSlot].bQueued == true) {
+		return;
+	}
+
+	pLoop->aSlots[nSlot].bQueued = true;
+	pLoop->aReady[pLoop->nReadyCnt] = nSlot;
+	pLoop->nReadyCnt += 1;
+
+	return;
+}
+
+static void RasPiEpollAcceptAll(sRasPiEpoll_t *pLoop, uint16_t nSlot) {
+	sRasPiEpollSlot_t *pHost = &(pLoop->aSlots[nSlot]);
+	sTCPServ_t *pTCPServ = pHost->pTCPServ;
+	struct sockaddr_in sAddr;
+	socklen_t nAddrSize;
+	int32_t nSocket;
+	uint16_t nClient;
+	int nNoDelay = 1;
+
+	//Edge triggered, so take every connection the kernel is holding
+	while (pHost->bInUse == true) {
+		nAddrSize = sizeof(struct sockaddr_in);
+		nSocket = accept(pHost->Sck.nSocket, (struct sockaddr *)&sAddr, &nAddrSize);
+
+		if (nSocket < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			//EAGAIN means all are accepted, anything else is retried on the next connection
+			pHost->bReadable = false;
+			return;
+		}
+
+		fcntl(nSocket, F_SETFL, fcntl(nSocket, F_GETFL, 0) | O_NONBLOCK);
+
+		//Sends are already gathered, don't let the kernel hold them back as well
+		setsockopt(nSocket, IPPROTO_TCP, TCP_NODELAY, &nNoDelay, sizeof(nNoDelay));
+
+		nClient = RasPiEpollAddSocket(pLoop, pTCPServ, nSocket, false);
+		if (nClient == RASPIEPOLL_NOSLOT) { //No room, turn the client away
+			close(nSocket);
+			continue;
+		}
+
+		//sAddr holds the client information
+		pLoop->aSlots[nClient].Sck.Conn.Addr.nNetLong = sAddr.sin_addr.s_addr;
+		pLoop->aSlots[nClient].Sck.Conn.Port = ntohs(sAddr.sin_port);
+
+		if (pHost->pfHandler == NULL) { //Wait for the accept function
+			pLoop->aPending[pLoop->nPendingCnt] = nClient;
+			pLoop->nPendingCnt += 1;
+			continue;
+		}
+
+		pLoop->aSlots[nClient].pfHandler = pHost->pfHandler;
+		pLoop->aSlots[nClient].pParam = pHost->pParam;
+
+		pHost->pfHandler(pTCPServ, &(pLoop->aSlots[nClient].Sck), RasPiEpoll_Accepted, pHost->pParam);
+	}
+
+	return;
+}
+
+static eNetReturn_t RasPiEpollFlush(sRasPiEpollSlot_t *pSlot) {
+	ssize_t nResult;
+
+	while (pSlot->nTxLen > 0) {
+		nResult = send(pSlot->Sck.nSocket, pSlot->aTxBuff, pSlot->nTxLen, MSG_NOSIGNAL);
+
+		if (nResult < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) { //Socket is full, EPOLLOUT will be raised when it drains
+				return Net_Success;
+			}
+
+			//errno has the failure code
+			return NetFail_Unknown;
+		}
+
+		pSlot->nTxLen -= (uint32_t)nResult;
+		if (pSlot->nTxLen > 0) {
+			memmove(pSlot->aTxBuff, &(pSlot->aTxBuff[nResult]), pSlot->nTxLen);
+		}
+	}
+
+	return Net_Success;
+}
+
@@ -0,0 +1,239 @@
+/**	@defgroup	raspiepoll
+	@brief		Event driven TCP server for Linux using epoll
+	@details	v0.1
+	#Description
+		Implements the TCP server general interface with non-blocking sockets
+		watched by a single epoll instance, letting one thread serve hundreds of
+		clients.  The listening socket and every client are registered edge
+		triggered.  An edge marks the socket ready and the loop keeps calling
+		its handler until a receive comes back short, so a handler may read as
+		much or as little as it likes each time it is called.
+		Sends made by a handler are gathered in the client's transmit buffer
+		and written in one go when the handler returns.  Sends made elsewhere
+		go straight to the socket while it has room.  Whatever the socket will
+		not take stays buffered, later sends are appended behind it, and it is
+		all written when the socket raises its next edge for room to send.
+
+		Each socket can have its own handler, set with RasPiEpollSetHandler().
+		The handler set on the listening socket is given to every client
+		accepted from it.  Clients accepted while the listening socket has no
+		handler wait to be picked up by the interface's accept function, which
+		processes the loop until one arrives.
+
+	#Usage
+		Initialize an sRasPiEpoll_t then create TCP servers on it with
+		RasPiEpollCreateTCPServer(), after that they are bound and used through
+		the general interface as usual.  The loop object is large, it should be
+		a global or allocated rather than placed on the stack.  Call
+		RasPiEpollProcess() from the main loop to wait for and dispatch events.
+
+		Receive and send never block.  A receive with no data waiting returns
+		NetWarn_EndOfData with no bytes, and NetFail_SocketState once the client
+		has closed the connection.  A send larger than RASPIEPOLL_TXBUFFSIZE
+		is refused with NetFail_BuffSize before any of it goes out, as the
+		part the socket does not take could not be held.
+
+	#File Information
+		File:	NetworkEpoll_RaspberryPi.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __RASPIEPOLL_H
+	#define __RASPIEPOLL_H
+
+/*****	Includes	*****/
+	#include <string.h>
+	#include <unistd.h>
+	#include <fcntl.h>
+	#include <errno.h>
+	#include <sys/socket.h>
+	#include <sys/epoll.h>
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+
+	#include "CommonUtils.h"
+	#include "NetworkGeneralInterface.h"
+
+/*****	Defines		*****/
+	#ifndef RASPIEPOLL_MAXSOCKETS
+		/**	@brief		Number of sockets, listening and clients, one loop can hold
+			@ingroup	raspiepoll
+		*/
+		#define RASPIEPOLL_MAXSOCKETS	512
+	#endif
+
+	#ifndef RASPIEPOLL_MAXFD
+		/**	@brief		Highest file descriptor number the loop can track plus one
+			@ingroup	raspiepoll
+		*/
+		#define RASPIEPOLL_MAXFD		4096
+	#endif
+
+	#ifndef RASPIEPOLL_TXBUFFSIZE
+		/**	@brief		Bytes each client can hold waiting for the socket to take them
+			@ingroup	raspiepoll
+		*/
+		#define RASPIEPOLL_TXBUFFSIZE	2048
+	#endif
+
+	#ifndef RASPIEPOLL_EVENTBATCH
+		/**	@brief		Number of events collected from the kernel in one wait
+			@ingroup	raspiepoll
+		*/
+		#define RASPIEPOLL_EVENTBATCH	64
+	#endif
+
+	/**	@brief		Marks a file descriptor that is not in the loop
+		@ingroup	raspiepoll
+	*/
+	#define RASPIEPOLL_NOSLOT		0xFFFF
+
+	/**	@brief		Capabilities of the epoll implementation of the TCP Server
+		@ingroup	raspiepoll
+	*/
+	#define TCPSERVEPOLL_CAPS	(TCPServ_Bind | TCPServ_CloseHost | TCPServ_AcceptConn | TCPServ_CloseClient | TCPServ_Receive | TCPServ_Send)
+
+/*****	Definitions	*****/
+	/**	@brief		Events reported to a socket's handler
+		@ingroup	raspiepoll
+	*/
+	typedef enum eRasPiEpollEvent_t {
+		RasPiEpoll_None		= 0x00,	/**< No events */
+		RasPiEpoll_Accepted	= 0x01,	/**< Socket is a newly accepted client */
+		RasPiEpoll_Readable	= 0x02,	/**< Data is waiting to be received */
+		RasPiEpoll_Writable	= 0x04,	/**< All buffered data has been sent */
+		RasPiEpoll_Hangup	= 0x08,	/**< Client closed its side or the connection failed */
+	} eRasPiEpollEvent_t;
+
+	/**	@brief		Function called when a socket has events
+		@details	The handler may receive, send, and close the socket through
+			the server's interface.  While the socket stays readable the handler
+			is called again each time the loop is processed.  Once a socket
+			that has hung up is read dry the handler is called one more time
+			with only RasPiEpoll_Hangup, so it can close after taking the last
+			of the data.
+		@param		pTCPServ	Server the socket belongs to
+		@param		pSck		Socket with events
+		@param		eEvents		Events that happened on the socket
+		@param		pParam		Parameter given when the handler was set
+		@ingroup	raspiepoll
+	*/
+	typedef void (*pfRasPiEpollHandler_t)(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam);
+
+	/**	@brief		State of one socket in the loop
+		@ingroup	raspiepoll
+	*/
+	typedef struct sRasPiEpollSlot_t {
+		sSocket_t Sck;							/**< Socket being watched */
+		sTCPServ_t *pTCPServ;					/**< Server the socket belongs to */
+		pfRasPiEpollHandler_t pfHandler;		/**< Handler for events, NULL if none is set */
+		void *pParam;							/**< Parameter given to the handler */
+
+		bool bInUse;							/**< True if the slot holds a socket */
+		bool bListener;							/**< True if the socket accepts connections */
+		bool bReadable;							/**< True until a receive drains the socket */
+		bool bQueued;							/**< True if the slot is in the ready list */
+		bool bHangup;							/**< True once the client has closed */
+		bool bWantWrite;						/**< True if the handler waits for buffered data to go */
+		bool bCorked;							/**< True while the handler runs, sends are gathered */
+
+		uint32_t nTxLen;						/**< Bytes waiting in the transmit buffer */
+		uint8_t aTxBuff[RASPIEPOLL_TXBUFFSIZE];	/**< Data the socket has not taken yet */
+	} sRasPiEpollSlot_t;
+
+	/**	@brief		Event loop shared by any number of TCP servers
+		@ingroup	raspiepoll
+	*/
+	typedef struct sRasPiEpoll_t {
+		int32_t nEpollFd;						/**< epoll instance */
+		uint32_t nSlotsUsed;					/**< Sockets held in the loop */
+
+		uint16_t aFdSlot[RASPIEPOLL_MAXFD];		/**< Slot holding each file descriptor */
+		sRasPiEpollSlot_t aSlots[RASPIEPOLL_MAXSOCKETS];	/**< Sockets in the loop */
+
+		uint16_t aReady[RASPIEPOLL_MAXSOCKETS];	/**< Slots with data still to be received */
+		uint32_t nReadyCnt;						/**< Slots in the ready list */
+
+		uint16_t aPending[RASPIEPOLL_MAXSOCKETS];	/**< Accepted clients with no handler, oldest first */
+		uint32_t nPendingCnt;					/**< Clients waiting to be accepted */
+	} sRasPiEpoll_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare an event loop for use
+		@param		pLoop		Loop to initialize
+		@return		Net_Success if the loop is ready, NetFail_Unknown if the
+			epoll instance could not be created
+		@ingroup	raspiepoll
+	*/
+	eNetReturn_t RasPiEpollInitialize(sRasPiEpoll_t *pLoop);
+
+	/**	@brief		Close every socket in the loop and the loop itself
+		@param		pLoop		Loop to close
+		@return		Net_Success once everything is closed
+		@ingroup	raspiepoll
+	*/
+	eNetReturn_t RasPiEpollClose(sRasPiEpoll_t *pLoop);
+
+	/**	@brief		Create a TCP server interface object that runs on an event loop
+		@param		pLoop		Loop the server's sockets are added to
+		@param		pTCPServ	Interface object to prepare
+		@return		Net_Success if the server is ready to bind
+		@ingroup	raspiepoll
+	*/
+	eNetReturn_t RasPiEpollCreateTCPServer(sRasPiEpoll_t *pLoop, sTCPServ_t *pTCPServ);
+
+	/**	@brief		Set the function called when a socket has events
+		@details	Setting the handler on the server's host socket makes it the
+			handler of every client accepted afterward.  Clients already waiting
+			for the accept function are given to it right away.
+		@param		pTCPServ	Server the socket belongs to
+		@param		pSck		Socket to set the handler of
+		@param		pfHandler	Function to call, NULL to stop calling one
+		@param		pParam		Parameter passed to the function
+		@return		Net_Success if the handler was set, NetFail_InvSocket if the
+			socket is not in the loop
+		@ingroup	raspiepoll
+	*/
+	eNetReturn_t RasPiEpollSetHandler(sTCPServ_t *pTCPServ, sSocket_t *pSck, pfRasPiEpollHandler_t pfHandler, void *pParam);
+
+	/**	@brief		Ask for the Writable event once a socket's buffered data is sent
+		@param		pTCPServ	Server the socket belongs to
+		@param		pSck		Socket to watch
+		@return		Net_Success if the event will be sent, NetFail_InvSocket if
+			the socket is not in the loop
+		@ingroup	raspiepoll
+	*/
+	eNetReturn_t RasPiEpollWantWrite(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+
+	/**	@brief		Get the number of bytes a socket still has buffered to send
+		@param		pTCPServ	Server the socket belongs to
+		@param		pSck		Socket to check
+		@return		Bytes in the socket's transmit buffer
+		@ingroup	raspiepoll
+	*/
+	uint32_t RasPiEpollTxPending(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+
+	/**	@brief		Wait for events and call the handlers of every socket that has them
+		@details	Does not wait if a socket is still readable from the last
+			call.
+		@param		pLoop		Loop to process
+		@param		nTimeoutMS	Milliseconds to wait for an event, 0 to return
+			right away
+		@return		Net_Success if events were handled or the wait timed out,
+			NetFail_Unknown if waiting failed
+		@ingroup	raspiepoll
+	*/
+	eNetReturn_t RasPiEpollProcess(sRasPiEpoll_t *pLoop, uint32_t nTimeoutMS);
+
+/*****	Functions	*****/
+
+
+#endif
+
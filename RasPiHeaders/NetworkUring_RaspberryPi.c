@@ -0,0 +1,1765 @@
+/**	File:	NetworkUring_RaspberryPi.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "NetworkUring_RaspberryPi.h"
+
+/*****	Defines		*****/
+	/**	@brief		Request kinds carried in the user data of each request
+		@ingroup	raspiuring
+	*/
+	#define RASPIURING_OPACCEPT		1
+	#define RASPIURING_OPRECV		2
+	#define RASPIURING_OPSEND		3
+	#define RASPIURING_OPCANCEL		4
+
+	/**	@brief		Pack the request kind, socket generation, buffer, and descriptor into user data
+		@ingroup	raspiuring
+	*/
+	#define RASPIURING_USERDATA(nOp, nGen, nBuff, nFd)	(((uint64_t)(nOp) << 56) | ((uint64_t)(nGen) << 48) | ((uint64_t)(nBuff) << 32) | (uint64_t)(uint32_t)(nFd))
+
+	/**	@brief		Longest a close waits for queued sends to leave
+		@ingroup	raspiuring
+	*/
+	#define RASPIURING_CLOSEWAITMS	1000
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+eNetReturn_t RasPiUringTCPServInitialize(sTCPServ_t *pTCPServ);
+eNetReturn_t RasPiUringTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn);
+eNetReturn_t RasPiUringTCPServCloseHost(sTCPServ_t *pTCPServ);
+eNetReturn_t RasPiUringTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+eNetReturn_t RasPiUringTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSck);
+eNetReturn_t RasPiUringTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t RasPiUringTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiUringTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nMillisec);
+
+eNetReturn_t RasPiUringTCPClientInitialize(sTCPClient_t *pTCPClient);
+eNetReturn_t RasPiUringTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t RasPiUringTCPClientClose(sTCPClient_t *pTCPClient);
+eNetReturn_t RasPiUringTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t RasPiUringTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiUringTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec);
+
+eNetReturn_t RasPiUringUDPServInitialize(sUDPServ_t *pUDPServ);
+eNetReturn_t RasPiUringUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn);
+eNetReturn_t RasPiUringUDPServCloseHost(sUDPServ_t *pUDPServ);
+eNetReturn_t RasPiUringUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t RasPiUringUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiUringUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv);
+eNetReturn_t RasPiUringUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec);
+
+eNetReturn_t RasPiUringUDPClientInitialize(sUDPClient_t *pUDPClient);
+eNetReturn_t RasPiUringUDPClientSetServer(sUDPClient_t *pUDPClient, sConnInfo_t *pConn);
+eNetReturn_t RasPiUringUDPClientReceive(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+eNetReturn_t RasPiUringUDPClientSend(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData);
+
+/**	@brief		Get the next free submission queue entry
+	@details	Submits the queue if it is full
+	@param		pRing		Ring to take the entry from
+	@return		Cleared entry, or NULL if the queue stayed full
+	@ingroup	raspiuring
+*/
+static struct io_uring_sqe *RasPiUringGetSQE(sRasPiUring_t *pRing);
+
+/**	@brief		Submit queued requests, optionally wait, and handle completions
+	@param		pRing		Ring to enter
+	@param		bWait		True to wait for at least one completion
+	@param		nTimeoutMS	Milliseconds to wait, 0 waits forever
+	@return		Net_Success if the ring was entered, NetFail_Unknown if it failed
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringEnter(sRasPiUring_t *pRing, bool bWait, uint32_t nTimeoutMS);
+
+/**	@brief		Handle every completion the kernel has posted
+	@param		pRing		Ring to read completions from
+	@ingroup	raspiuring
+*/
+static void RasPiUringReap(sRasPiUring_t *pRing);
+
+/**	@brief		Find the state of a socket in the ring
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@return		State of the socket, NULL if it is not in the ring
+	@ingroup	raspiuring
+*/
+static sRasPiUringSock_t *RasPiUringFindSock(sRasPiUring_t *pRing, int32_t nSocket);
+
+/**	@brief		Start tracking a socket and arm its multishot receive or accept
+	@param		pRing		Ring to add the socket to
+	@param		nSocket		Descriptor of the socket
+	@param		eType		Kind of socket
+	@return		Net_Success if the socket was added, NetFail_InvSocket if the
+		descriptor is too large for the ring
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringAddSocket(sRasPiUring_t *pRing, int32_t nSocket, eRasPiUringSockType_t eType);
+
+/**	@brief		Queue the multishot receive or accept for a socket
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@ingroup	raspiuring
+*/
+static void RasPiUringArm(sRasPiUring_t *pRing, int32_t nSocket);
+
+/**	@brief		Stop tracking a socket, cancel its requests, and close it
+	@details	Waits a short time for sends already queued to leave
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@ingroup	raspiuring
+*/
+static void RasPiUringDropSocket(sRasPiUring_t *pRing, int32_t nSocket);
+
+/**	@brief		Give a receive buffer back to the kernel
+	@param		pRing		Ring the buffer belongs to
+	@param		nBuff		Index of the buffer
+	@ingroup	raspiuring
+*/
+static void RasPiUringReturnRecv(sRasPiUring_t *pRing, uint16_t nBuff);
+
+/**	@brief		Take a send buffer, waiting for one to come free if needed
+	@param		pRing		Ring holding the buffers
+	@param		pnBuff		Returns the index of the buffer
+	@return		Net_Success if a buffer was taken, NetFail_Unknown if the ring
+		failed while waiting
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringTakeSend(sRasPiUring_t *pRing, uint16_t *pnBuff);
+
+/**	@brief		Put a send buffer back on the free list
+	@param		pRing		Ring holding the buffers
+	@param		nBuff		Index of the buffer
+	@ingroup	raspiuring
+*/
+static void RasPiUringFreeSend(sRasPiUring_t *pRing, uint16_t nBuff);
+
+/**	@brief		Queue the request that sends a buffer
+	@param		pRing		Ring holding the buffer
+	@param		nSocket		Descriptor to send through
+	@param		nBuff		Index of the buffer
+	@ingroup	raspiuring
+*/
+static void RasPiUringIssueSend(sRasPiUring_t *pRing, int32_t nSocket, uint16_t nBuff);
+
+/**	@brief		Find the send buffer a pointer lies in, if it is held by the application
+	@param		pRing		Ring holding the buffers
+	@param		pData		Pointer to check
+	@return		Index of the buffer, RASPIURING_NOBUFF if the pointer is not in
+		a held buffer
+	@ingroup	raspiuring
+*/
+static uint16_t RasPiUringHeldBuffer(sRasPiUring_t *pRing, void *pData);
+
+/**	@brief		Queue data to send on a TCP socket
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@param		nDataBytes	Number of bytes to send
+	@param		pData		Data to send
+	@return		Net_Success if the data was queued, NetFail_InvSocket if the
+		socket is not in the ring, NetFail_Unknown if an earlier send failed
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringStreamSend(sRasPiUring_t *pRing, int32_t nSocket, uint32_t nDataBytes, void *pData);
+
+/**	@brief		Queue a datagram to send on a UDP socket
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@param		pConn		Destination of the datagram
+	@param		nDataBytes	Number of bytes to send
+	@param		pData		Data to send
+	@return		Net_Success if the datagram was queued, NetFail_InvSocket if the
+		socket is not in the ring, NetFail_Unknown if an earlier send failed or
+		the datagram does not fit in a buffer
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringDgramSend(sRasPiUring_t *pRing, int32_t nSocket, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
+
+/**	@brief		Wait until a socket has data, closes, or its timeout passes
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@return		Net_Success if the wait finished, NetFail_Unknown if the ring
+		failed
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringWaitData(sRasPiUring_t *pRing, int32_t nSocket);
+
+/**	@brief		Read received data from a TCP socket
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@param		nDataBytes	Most bytes to read
+	@param		pData		Buffer to read into
+	@param		pnBytesRecv	Returns the number of bytes read
+	@return		Net_Success if all bytes were read, NetWarn_EndOfData if fewer
+		were, NetFail_SocketState if the peer closed, NetFail_Unknown on error
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringStreamRecv(sRasPiUring_t *pRing, int32_t nSocket, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+
+/**	@brief		Read one received datagram from a UDP socket
+	@details	Any part of the datagram that does not fit is discarded
+	@param		pRing		Ring holding the socket
+	@param		nSocket		Descriptor of the socket
+	@param		pConn		Returns the sender of the datagram
+	@param		nDataBytes	Most bytes to read
+	@param		pData		Buffer to read into
+	@param		pnBytesRecv	Returns the number of bytes read
+	@return		Net_Success if a datagram was read, NetWarn_EndOfData if none
+		arrived before the timeout, NetFail_Unknown on error
+	@ingroup	raspiuring
+*/
+static eNetReturn_t RasPiUringDgramRecv(sRasPiUring_t *pRing, int32_t nSocket, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
+
+/**	@brief		Read the monotonic clock
+	@return		Milliseconds since an arbitrary point
+	@ingroup	raspiuring
+*/
+static uint64_t RasPiUringTimeMS(void);
+
+/**	@brief		Check the running kernel is new enough for every feature the ring uses
+	@return		True if the kernel is RASPIURING_KERNELMAJOR.RASPIURING_KERNELMINOR or later
+	@ingroup	raspiuring
+*/
+static bool RasPiUringKernelSupported(void);
+
+/*****	Functions	*****/
+eNetReturn_t RasPiUringInitialize(sRasPiUring_t *pRing) {
+	struct io_uring_params Params;
+	struct io_uring_buf_reg BufReg;
+	struct iovec SendVec;
+	size_t nSQSize, nCQSize;
+	uint32_t nCtr;
+	uint8_t *pMem;
+
+	memset(pRing, 0, sizeof(sRasPiUring_t));
+	pRing->nRingFd = SOCKET_INVALID;
+
+	if (RasPiUringKernelSupported() == false) { //Older kernels take the ring but reject multishot receives later on
+		return NetFail_NotImplem;
+	}
+
+	memset(&Params, 0, sizeof(struct io_uring_params));
+	pRing->nRingFd = syscall(__NR_io_uring_setup, RASPIURING_ENTRIES, &Params);
+	if (pRing->nRingFd < 0) {
+		pRing->nRingFd = SOCKET_INVALID;
+
+		if ((errno == ENOSYS) || (errno == EPERM)) { //Kernel lacks io_uring or it is disabled
+			return NetFail_NotImplem;
+		}
+
+		return NetFail_Unknown;
+	}
+
+	if (CheckAllBitsInMask(Params.features, IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG) == false) {
+		RasPiUringClose(pRing);
+		return NetFail_NotImplem;
+	}
+
+	//Both queue rings share one mapping
+	nSQSize = Params.sq_off.array + (Params.sq_entries * sizeof(uint32_t));
+	nCQSize = Params.cq_off.cqes + (Params.cq_entries * sizeof(struct io_uring_cqe));
+	pRing->nRingMemSize = (nSQSize > nCQSize) ? nSQSize : nCQSize;
+
+	pRing->pRingMem = mmap(NULL, pRing->nRingMemSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->nRingFd, IORING_OFF_SQ_RING);
+	if (pRing->pRingMem == MAP_FAILED) {
+		pRing->pRingMem = NULL;
+		RasPiUringClose(pRing);
+		return NetFail_Unknown;
+	}
+
+	pRing->nSQEsSize = Params.sq_entries * sizeof(struct io_uring_sqe);
+	pRing->pSQEs = mmap(NULL, pRing->nSQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->nRingFd, IORING_OFF_SQES);
+	if (pRing->pSQEs == MAP_FAILED) {
+		pRing->pSQEs = NULL;
+		RasPiUringClose(pRing);
+		return NetFail_Unknown;
+	}
+
+	pMem = (uint8_t *)pRing->pRingMem;
+	pRing->pSQHead = (uint32_t *)&(pMem[Params.sq_off.head]);
+	pRing->pSQTail = (uint32_t *)&(pMem[Params.sq_off.tail]);
+	pRing->pSQArray = (uint32_t *)&(pMem[Params.sq_off.array]);
+	pRing->nSQMask = *((uint32_t *)&(pMem[Params.sq_off.ring_mask]));
+	pRing->nSQEntries = Params.sq_entries;
+	pRing->pCQHead = (uint32_t *)&(pMem[Params.cq_off.head]);
+	pRing->pCQTail = (uint32_t *)&(pMem[Params.cq_off.tail]);
+	pRing->nCQMask = *((uint32_t *)&(pMem[Params.cq_off.ring_mask]));
+	pRing->pCQEs = (struct io_uring_cqe *)&(pMem[Params.cq_off.cqes]);
+
+	//Send buffers are registered as one region, any address inside it can be sent
+	SendVec.iov_base = pRing->aSendBuff;
+	SendVec.iov_len = sizeof(pRing->aSendBuff);
+	if (syscall(__NR_io_uring_register, pRing->nRingFd, IORING_REGISTER_BUFFERS, &SendVec, 1) != 0) {
+		//errno has the failure code, usually the locked memory limit
+		RasPiUringClose(pRing);
+		return NetFail_Unknown;
+	}
+
+	for (nCtr = 0; nCtr < RASPIURING_SENDCOUNT; nCtr++) {
+		pRing->aSendInfo[nCtr].nNext = nCtr + 1;
+	}
+	pRing->aSendInfo[RASPIURING_SENDCOUNT - 1].nNext = RASPIURING_NOBUFF;
+	pRing->nSendFree = 0;
+
+	//Receive buffers are handed to the kernel through a buffer ring
+	pRing->nBufRingSize = RASPIURING_RECVCOUNT * sizeof(struct io_uring_buf);
+	pRing->pBufRing = mmap(NULL, pRing->nBufRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+	if (pRing->pBufRing == MAP_FAILED) {
+		pRing->pBufRing = NULL;
+		RasPiUringClose(pRing);
+		return NetFail_Unknown;
+	}
+
+	memset(&BufReg, 0, sizeof(struct io_uring_buf_reg));
+	BufReg.ring_addr = (uint64_t)(uintptr_t)pRing->pBufRing;
+	BufReg.ring_entries = RASPIURING_RECVCOUNT;
+	BufReg.bgid = 0;
+	if (syscall(__NR_io_uring_register, pRing->nRingFd, IORING_REGISTER_PBUF_RING, &BufReg, 1) != 0) {
+		munmap(pRing->pBufRing, pRing->nBufRingSize);
+		pRing->pBufRing = NULL;
+		RasPiUringClose(pRing);
+		return NetFail_NotImplem;
+	}
+
+	for (nCtr = 0; nCtr < RASPIURING_RECVCOUNT; nCtr++) {
+		RasPiUringReturnRecv(pRing, nCtr);
+	}
+
+	for (nCtr = 0; nCtr < RASPIURING_MAXFD; nCtr++) {
+		pRing->aSocks[nCtr].eType = RasPiUring_Free;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringClose(sRasPiUring_t *pRing) {
+	int32_t nCtr;
+
+	if (pRing->pSQEs != NULL) { //Queues are usable, close sockets through them
+		for (nCtr = 0; nCtr < RASPIURING_MAXFD; nCtr++) {
+			if (pRing->aSocks[nCtr].eType != RasPiUring_Free) {
+				RasPiUringDropSocket(pRing, nCtr);
+			}
+		}
+	}
+
+	//Closing the ring releases the registered buffers
+	if (pRing->nRingFd >= 0) {
+		close(pRing->nRingFd);
+		pRing->nRingFd = SOCKET_INVALID;
+	}
+
+	if (pRing->pBufRing != NULL) {
+		munmap(pRing->pBufRing, pRing->nBufRingSize);
+		pRing->pBufRing = NULL;
+	}
+
+	if (pRing->pSQEs != NULL) {
+		munmap(pRing->pSQEs, pRing->nSQEsSize);
+		pRing->pSQEs = NULL;
+	}
+
+	if (pRing->pRingMem != NULL) {
+		munmap(pRing->pRingMem, pRing->nRingMemSize);
+		pRing->pRingMem = NULL;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringCreateTCPServer(sRasPiUring_t *pRing, sTCPServ_t *pTCPServ) {
+	RasPiUringTCPServInitialize(pTCPServ);
+
+	pTCPServ->pHWInfo = pRing;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringCreateTCPClient(sRasPiUring_t *pRing, sTCPClient_t *pTCPClient) {
+	RasPiUringTCPClientInitialize(pTCPClient);
+
+	pTCPClient->pHWInfo = pRing;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringCreateUDPServer(sRasPiUring_t *pRing, sUDPServ_t *pUDPServ) {
+	RasPiUringUDPServInitialize(pUDPServ);
+
+	pUDPServ->pHWInfo = pRing;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringCreateUDPClient(sRasPiUring_t *pRing, sUDPClient_t *pUDPClient) {
+	RasPiUringUDPClientInitialize(pUDPClient);
+
+	pUDPClient->pHWInfo = pRing;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringGetSendBuffer(sRasPiUring_t *pRing, uint8_t **ppBuff) {
+	uint16_t nBuff;
+
+	if (RasPiUringTakeSend(pRing, &nBuff) != Net_Success) {
+		*ppBuff = NULL;
+		return NetFail_Unknown;
+	}
+
+	pRing->aSendInfo[nBuff].bHeld = true;
+	*ppBuff = pRing->aSendBuff[nBuff];
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringReleaseSendBuffer(sRasPiUring_t *pRing, uint8_t *pBuff) {
+	uint16_t nBuff;
+
+	nBuff = RasPiUringHeldBuffer(pRing, pBuff);
+	if (nBuff == RASPIURING_NOBUFF) {
+		return NetFail_Unknown;
+	}
+
+	RasPiUringFreeSend(pRing, nBuff);
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringProcess(sRasPiUring_t *pRing, uint32_t nTimeoutMS) {
+	return RasPiUringEnter(pRing, (nTimeoutMS > 0), nTimeoutMS);
+}
+
+eNetReturn_t RasPiUringTCPServInitialize(sTCPServ_t *pTCPServ) {
+	//Always begin with default settigns
+	IfaceTCPServObjInitialize(pTCPServ);
+
+	//Update the function pointers to this implementation
+	pTCPServ->pfInitialize = &RasPiUringTCPServInitialize;
+	pTCPServ->pfBind = &RasPiUringTCPServBind;
+	pTCPServ->pfCloseHost = &RasPiUringTCPServCloseHost;
+	pTCPServ->pfCloseSocket = &RasPiUringTCPServCloseSocket;
+	pTCPServ->pfAcceptClient = &RasPiUringTCPServAcceptClient;
+	pTCPServ->pfReceive = &RasPiUringTCPServReceive;
+	pTCPServ->pfSend = &RasPiUringTCPServSend;
+	pTCPServ->pfSetRecvTimeout = &RasPiUringTCPServSetRecvTimeOut;
+
+	pTCPServ->eCapabilities = TCPSERVURING_CAPS;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPServBind(sTCPServ_t *pTCPServ, sConnInfo_t *pConn) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pTCPServ->pHWInfo;
+	struct sockaddr_in sAddr;
+	int nReuse = 1;
+
+	if (pRing == NULL) { //Server was not created on a ring
+		return NetFail_SocketState;
+	}
+
+	if (pTCPServ->HostSck.nSocket != SOCKET_INVALID) { //Socket appears open, close it
+		RasPiUringTCPServCloseHost(pTCPServ);
+	}
+
+	//Create server socket
+	pTCPServ->HostSck.nSocket = socket(AF_INET, SOCK_STREAM, 0);
+	pTCPServ->HostSck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+	pTCPServ->HostSck.Conn.Port = pConn->Port;
+
+	if (pTCPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_Unknown; //errno may hold more information
+	}
+
+	setsockopt(pTCPServ->HostSck.nSocket, SOL_SOCKET, SO_REUSEADDR, &nReuse, sizeof(nReuse));
+
+	//Bind the requested port
+	memset(&sAddr, 0, sizeof(struct sockaddr_in));
+	sAddr.sin_port = htons(pConn->Port);
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_addr.s_addr = pConn->Addr.nNetLong;
+
+	if (bind(pTCPServ->HostSck.nSocket, (struct sockaddr *)&sAddr, sizeof(struct sockaddr_in)) != 0) {
+		//Returns -1 on error, errno holds code
+		close(pTCPServ->HostSck.nSocket);
+		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_BindErr;
+	}
+
+	if (listen(pTCPServ->HostSck.nSocket, SOMAXCONN) != 0) {
+		//Returns -1 on error, errno holds code
+		close(pTCPServ->HostSck.nSocket);
+		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_Unknown;
+	}
+
+	if (RasPiUringAddSocket(pRing, pTCPServ->HostSck.nSocket, RasPiUring_Listener) != Net_Success) {
+		close(pTCPServ->HostSck.nSocket);
+		pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_InvSocket;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPServCloseHost(sTCPServ_t *pTCPServ) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pTCPServ->pHWInfo;
+
+	if (pTCPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+
+	if (RasPiUringFindSock(pRing, pTCPServ->HostSck.nSocket) != NULL) {
+		RasPiUringDropSocket(pRing, pTCPServ->HostSck.nSocket);
+	} else {
+		close(pTCPServ->HostSck.nSocket);
+	}
+
+	pTCPServ->HostSck.nSocket = SOCKET_INVALID;
+	pTCPServ->HostSck.Conn.Addr.nNetLong = 0;
+	pTCPServ->HostSck.Conn.Port = 0;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pTCPServ->pHWInfo;
+
+	if (pSck->nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+
+	if (RasPiUringFindSock(pRing, pSck->nSocket) != NULL) {
+		RasPiUringDropSocket(pRing, pSck->nSocket);
+	} else {
+		close(pSck->nSocket);
+	}
+
+	pSck->nSocket = SOCKET_INVALID;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pTCPServ->pHWInfo;
+	sRasPiUringSock_t *pHost;
+	struct sockaddr_in sAddr;
+	socklen_t nAddrSize = sizeof(struct sockaddr_in);
+
+	pSck->nSocket = SOCKET_INVALID;
+
+	pHost = RasPiUringFindSock(pRing, pTCPServ->HostSck.nSocket);
+	if ((pHost == NULL) || (pHost->eType != RasPiUring_Listener)) { //Not listening
+		return NetFail_SocketState;
+	}
+
+	//The multishot accept fills the queue, wait for it like a blocking accept
+	while (pHost->nAcceptHead == SOCKET_INVALID) {
+		if (pHost->bClosed == true) {
+			return NetFail_SocketState;
+		}
+
+		if (RasPiUringEnter(pRing, true, 0) != Net_Success) {
+			return NetFail_Unknown;
+		}
+	}
+
+	pSck->nSocket = pHost->nAcceptHead;
+	pHost->nAcceptHead = pRing->aSocks[pSck->nSocket].nAcceptNext;
+	if (pHost->nAcceptHead == SOCKET_INVALID) {
+		pHost->nAcceptTail = SOCKET_INVALID;
+	}
+
+	//Data may already be waiting, the receive was armed when the client arrived
+	if (getpeername(pSck->nSocket, (struct sockaddr *)&sAddr, &nAddrSize) == 0) {
+		pSck->Conn.Addr.nNetLong = sAddr.sin_addr.s_addr;
+		pSck->Conn.Port = ntohs(sAddr.sin_port);
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	return RasPiUringStreamRecv((sRasPiUring_t *)pTCPServ->pHWInfo, pSck->nSocket, nDataBytes, pData, pnBytesRecv);
+}
+
+eNetReturn_t RasPiUringTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nDataBytes, void *pData) {
+	return RasPiUringStreamSend((sRasPiUring_t *)pTCPServ->pHWInfo, pSck->nSocket, nDataBytes, pData);
+}
+
+eNetReturn_t RasPiUringTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nMillisec) {
+	sRasPiUringSock_t *pSock;
+
+	pSock = RasPiUringFindSock((sRasPiUring_t *)pTCPServ->pHWInfo, pSck->nSocket);
+	if (pSock == NULL) {
+		return NetFail_InvSocket;
+	}
+
+	pSock->nTimeoutMS = nMillisec;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPClientInitialize(sTCPClient_t *pTCPClient) {
+	//Always begin with default settigns
+	IfaceTCPClientObjInitialize(pTCPClient);
+
+	//Update the function pointers to this implementation
+	pTCPClient->pfInitialize = &RasPiUringTCPClientInitialize;
+	pTCPClient->pfConnect = &RasPiUringTCPClientConnect;
+	pTCPClient->pfClose = &RasPiUringTCPClientClose;
+	pTCPClient->pfReceive = &RasPiUringTCPClientReceive;
+	pTCPClient->pfSend = &RasPiUringTCPClientSend;
+	pTCPClient->pfSetRecvTimeout = &RasPiUringTCPClientSetRecvTimeOut;
+
+	//Set other object values
+	pTCPClient->Sck.nSocket = SOCKET_INVALID;
+	pTCPClient->Sck.Conn.Addr.nNetLong = 0;
+	pTCPClient->Sck.Conn.Port = 0;
+	pTCPClient->eCapabilities = TCPCLIENTURING_CAPS;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pTCPClient->pHWInfo;
+	struct sockaddr_in sAddr;
+
+	if (pRing == NULL) { //Client was not created on a ring
+		return NetFail_SocketState;
+	}
+
+	if (pTCPClient->Sck.nSocket != SOCKET_INVALID) { //Socket appears open, close it
+		RasPiUringTCPClientClose(pTCPClient);
+	}
+
+	//Create client socket
+	pTCPClient->Sck.nSocket = socket(AF_INET, SOCK_STREAM, 0);
+	pTCPClient->Sck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+	pTCPClient->Sck.Conn.Port = pConn->Port;
+
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_Unknown; //errno may hold more information
+	}
+
+	//Connecting happens once, it is made directly
+	memset(&sAddr, 0, sizeof(struct sockaddr_in));
+	sAddr.sin_port = htons(pConn->Port);
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_addr.s_addr = pConn->Addr.nNetLong;
+
+	if (connect(pTCPClient->Sck.nSocket, (struct sockaddr *)&sAddr, sizeof(struct sockaddr_in)) != 0) {
+		close(pTCPClient->Sck.nSocket);
+		pTCPClient->Sck.nSocket = SOCKET_INVALID;
+
+		if (errno == ECONNREFUSED) {
+			return NetFail_ConnRefuse;
+		} else {
+			return NetFail_Unknown;
+		}
+	}
+
+	if (RasPiUringAddSocket(pRing, pTCPClient->Sck.nSocket, RasPiUring_Stream) != Net_Success) {
+		close(pTCPClient->Sck.nSocket);
+		pTCPClient->Sck.nSocket = SOCKET_INVALID;
+		return NetFail_InvSocket;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPClientClose(sTCPClient_t *pTCPClient) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pTCPClient->pHWInfo;
+
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return Net_Success;
+	}
+
+	if (RasPiUringFindSock(pRing, pTCPClient->Sck.nSocket) != NULL) {
+		RasPiUringDropSocket(pRing, pTCPClient->Sck.nSocket);
+	} else {
+		close(pTCPClient->Sck.nSocket);
+	}
+
+	pTCPClient->Sck.nSocket = SOCKET_INVALID;
+	pTCPClient->Sck.Conn.Addr.nNetLong = 0;
+	pTCPClient->Sck.Conn.Port = 0;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	return RasPiUringStreamRecv((sRasPiUring_t *)pTCPClient->pHWInfo, pTCPClient->Sck.nSocket, nDataBytes, pData, pnBytesRecv);
+}
+
+eNetReturn_t RasPiUringTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData) {
+	return RasPiUringStreamSend((sRasPiUring_t *)pTCPClient->pHWInfo, pTCPClient->Sck.nSocket, nDataBytes, pData);
+}
+
+eNetReturn_t RasPiUringTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec) {
+	sRasPiUringSock_t *pSock;
+
+	pSock = RasPiUringFindSock((sRasPiUring_t *)pTCPClient->pHWInfo, pTCPClient->Sck.nSocket);
+	if (pSock == NULL) {
+		return NetFail_InvSocket;
+	}
+
+	pSock->nTimeoutMS = nMillisec;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPServInitialize(sUDPServ_t *pUDPServ) {
+	//Start from the defaults so the gathered send falls back to copying
+	IfaceUDPServObjInitialize(pUDPServ);
+	
+	pUDPServ->HostSck.nSocket = SOCKET_INVALID;
+	pUDPServ->HostSck.Conn.Addr.nNetLong = 0;
+	pUDPServ->HostSck.Conn.Port = 0;
+	pUDPServ->eCapabilities = UDPSERVURING_CAPS;
+	pUDPServ->pHWInfo = NULL;
+
+	pUDPServ->pfInitialize = &RasPiUringUDPServInitialize;
+	pUDPServ->pfBind = &RasPiUringUDPServBind;
+	pUDPServ->pfCloseHost = &RasPiUringUDPServCloseHost;
+	pUDPServ->pfReceive = &RasPiUringUDPServReceive;
+	pUDPServ->pfSend = &RasPiUringUDPServSend;
+	pUDPServ->pfReceiveBatch = &RasPiUringUDPServReceiveBatch;
+	pUDPServ->pfSetRecvTimeout = &RasPiUringUDPServSetRecvTimeOut;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pUDPServ->pHWInfo;
+	struct sockaddr_in sAddr;
+
+	if (pRing == NULL) { //Server was not created on a ring
+		return NetFail_SocketState;
+	}
+
+	RasPiUringUDPServCloseHost(pUDPServ); //In case its open
+
+	//Setup and create the socket
+	pUDPServ->HostSck.nSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	pUDPServ->HostSck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+	pUDPServ->HostSck.Conn.Port = pConn->Port;
+
+	if (pUDPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_Unknown; //See errno for code
+	}
+
+	//Bind and listen on the port
+	memset(&sAddr, 0, sizeof(struct sockaddr_in));
+	sAddr.sin_port = htons(pConn->Port);
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_addr.s_addr = pConn->Addr.nNetLong;
+
+	if (bind(pUDPServ->HostSck.nSocket, (struct sockaddr *)&sAddr, sizeof(struct sockaddr_in)) != 0) {
+		//Returns -1 on error, errno holds code
+		close(pUDPServ->HostSck.nSocket);
+		pUDPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_BindErr;
+	}
+
+	if (RasPiUringAddSocket(pRing, pUDPServ->HostSck.nSocket, RasPiUring_Dgram) != Net_Success) {
+		close(pUDPServ->HostSck.nSocket);
+		pUDPServ->HostSck.nSocket = SOCKET_INVALID;
+		return NetFail_InvSocket;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPServCloseHost(sUDPServ_t *pUDPServ) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pUDPServ->pHWInfo;
+
+	if (pUDPServ->HostSck.nSocket == SOCKET_INVALID) {
+		return NetFail_InvSocket;
+	}
+
+	if (RasPiUringFindSock(pRing, pUDPServ->HostSck.nSocket) != NULL) {
+		RasPiUringDropSocket(pRing, pUDPServ->HostSck.nSocket);
+	} else {
+		close(pUDPServ->HostSck.nSocket);
+	}
+
+	pUDPServ->HostSck.nSocket = SOCKET_INVALID;
+	pUDPServ->HostSck.Conn.Addr.nNetLong = 0;
+	pUDPServ->HostSck.Conn.Port = 0;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	return RasPiUringDgramRecv((sRasPiUring_t *)pUDPServ->pHWInfo, pUDPServ->HostSck.nSocket, pConn, nDataBytes, pData, pnBytesRecv);
+}
+
+eNetReturn_t RasPiUringUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData) {
+	return RasPiUringDgramSend((sRasPiUring_t *)pUDPServ->pHWInfo, pUDPServ->HostSck.nSocket, pConn, nDataBytes, pData);
+}
+
+eNetReturn_t RasPiUringUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pUDPServ->pHWInfo;
+	sRasPiUringSock_t *pSock;
+	sNetPacket_t *pPkt;
+	eNetReturn_t eResult = Net_Success;
+
+	*pnPktsRecv = 0;
+	while (*pnPktsRecv < nPktCnt) {
+		pPkt = &(pPkts[*pnPktsRecv]);
+
+		eResult = RasPiUringDgramRecv(pRing, pUDPServ->HostSck.nSocket, &(pPkt->Conn), pPkt->nBuffSize, pPkt->pData, &(pPkt->nBytes));
+		if (eResult != Net_Success) {
+			break;
+		}
+
+		*pnPktsRecv += 1;
+
+		//Only the first datagram is waited for, after that take what is queued
+		pSock = RasPiUringFindSock(pRing, pUDPServ->HostSck.nSocket);
+		if ((pSock == NULL) || (pSock->nRecvHead == RASPIURING_NOBUFF)) {
+			break;
+		}
+	}
+
+	if (*pnPktsRecv > 0) {
+		return Net_Success;
+	}
+
+	return eResult;
+}
+
+eNetReturn_t RasPiUringUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec) {
+	sRasPiUringSock_t *pSock;
+
+	pSock = RasPiUringFindSock((sRasPiUring_t *)pUDPServ->pHWInfo, pUDPServ->HostSck.nSocket);
+	if (pSock == NULL) {
+		return NetFail_InvSocket;
+	}
+
+	pSock->nTimeoutMS = nMillisec;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPClientInitialize(sUDPClient_t *pUDPClient) {
+	pUDPClient->Sck.nSocket = SOCKET_INVALID;
+	pUDPClient->Sck.Conn.Addr.nNetLong = 0;
+	pUDPClient->Sck.Conn.Port = 0;
+	pUDPClient->eCapabilities = UDPCLIENTURING_CAPS;
+	pUDPClient->pHWInfo = NULL;
+
+	pUDPClient->pfInitialize = &RasPiUringUDPClientInitialize;
+	pUDPClient->pfSetServer = &RasPiUringUDPClientSetServer;
+	pUDPClient->pfReceive = &RasPiUringUDPClientReceive;
+	pUDPClient->pfSend = &RasPiUringUDPClientSend;
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPClientSetServer(sUDPClient_t *pUDPClient, sConnInfo_t *pConn) {
+	sRasPiUring_t *pRing = (sRasPiUring_t *)pUDPClient->pHWInfo;
+
+	if (pRing == NULL) { //Client was not created on a ring
+		return NetFail_SocketState;
+	}
+
+	if (pUDPClient->Sck.nSocket != SOCKET_INVALID) { //Changing servers, start a new socket
+		RasPiUringDropSocket(pRing, pUDPClient->Sck.nSocket);
+	}
+
+	//Save off the IP/Port to use when sending data
+	pUDPClient->Sck.Conn.Port = pConn->Port;
+	pUDPClient->Sck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+
+	pUDPClient->Sck.nSocket = socket(AF_INET, SOCK_DGRAM, 0);
+
+	if (pUDPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_Unknown; //See errno for code
+	}
+
+	if (RasPiUringAddSocket(pRing, pUDPClient->Sck.nSocket, RasPiUring_Dgram) != Net_Success) {
+		close(pUDPClient->Sck.nSocket);
+		pUDPClient->Sck.nSocket = SOCKET_INVALID;
+		return NetFail_InvSocket;
+	}
+
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUringUDPClientSend(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData) {
+	return RasPiUringDgramSend((sRasPiUring_t *)pUDPClient->pHWInfo, pUDPClient->Sck.nSocket, &(pUDPClient->Sck.Conn), nDataBytes, pData);
+}
+
+eNetReturn_t RasPiUringUDPClientReceive(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sConnInfo_t From;
+	eNetReturn_t eResult;
+
+	eResult = RasPiUringDgramRecv((sRasPiUring_t *)pUDPClient->pHWInfo, pUDPClient->Sck.nSocket, &From, nDataBytes, pData, pnBytesRecv);
+	if (eResult != Net_Success) {
+		return eResult;
+	}
+
+	if (pUDPClient->Sck.Conn.Addr.nNetLong != From.Addr.nNetLong) {
+		return NetWarn_WrongIP;
+	}
+
+	if (pUDPClient->Sck.Conn.Port != From.Port) {
+		return NetWarn_WrongPort;
+	}
+
+	return Net_Success;
+}
+
+static struct io_uring_sqe *RasPiUringGetSQE(sRasPiUring_t *pRing) {
+	struct io_uring_sqe *pSQE;
+	uint32_t nHead, nTail, nIdx;
+
+	nTail = *(pRing->pSQTail);
+	nHead = __atomic_load_n(pRing->pSQHead, __ATOMIC_ACQUIRE);
+
+	if (nTail - nHead >= pRing->nSQEntries) { //Full, hand what is there to the kernel
+		RasPiUringEnter(pRing, false, 0);
+
+		nHead = __atomic_load_n(pRing->pSQHead, __ATOMIC_ACQUIRE);
+		if (nTail - nHead >= pRing->nSQEntries) {
+			return NULL;
+		}
+	}
+
+	nIdx = nTail & pRing->nSQMask;
+	pSQE = &(pRing->pSQEs[nIdx]);
+	memset(pSQE, 0, sizeof(struct io_uring_sqe));
+	pRing->pSQArray[nIdx] = nIdx;
+
+	//The kernel only reads the queue when the ring is entered
+	__atomic_store_n(pRing->pSQTail, nTail + 1, __ATOMIC_RELEASE);
+	pRing->nToSubmit += 1;
+
+	return pSQE;
+}
+
+static eNetReturn_t RasPiUringEnter(sRasPiUring_t *pRing, bool bWait, uint32_t nTimeoutMS) {
+	struct io_uring_getevents_arg WaitArg;
+	struct __kernel_timespec WaitTime;
+	uint32_t nFlags = 0, nMinComplete = 0;
+	void *pArg = NULL;
+	size_t nArgSize = 0;
+	long nResult;
+
+	//Anything already complete is handled first, it may be what the caller wants
+	RasPiUringReap(pRing);
+
+	if ((bWait == false) && (pRing->nToSubmit == 0)) {
+		return Net_Success;
+	}
+
+	if (bWait == true) {
+		nFlags |= IORING_ENTER_GETEVENTS;
+		nMinComplete = 1;
+
+		if (nTimeoutMS > 0) {
+			WaitTime.tv_sec = nTimeoutMS / 1000;
+			WaitTime.tv_nsec = (nTimeoutMS % 1000) * 1000000;
+
+			memset(&WaitArg, 0, sizeof(struct io_uring_getevents_arg));
+			WaitArg.sigmask = 0;
+			WaitArg.sigmask_sz = _NSIG / 8;
+			WaitArg.ts = (uint64_t)(uintptr_t)&WaitTime;
+
+			nFlags |= IORING_ENTER_EXT_ARG;
+			pArg = &WaitArg;
+			nArgSize = sizeof(struct io_uring_getevents_arg);
+		}
+	}
+
+	nResult = syscall(__NR_io_uring_enter, pRing->nRingFd, pRing->nToSubmit, nMinComplete, nFlags, pArg, nArgSize);
+	if (nResult < 0) {
+		if ((errno != ETIME) && (errno != EINTR) && (errno != EBUSY) && (errno != EAGAIN)) {
+			//errno has the failure code
+			return NetFail_Unknown;
+		}
+	} else if ((uint32_t)nResult >= pRing->nToSubmit) {
+		pRing->nToSubmit = 0;
+	} else {
+		pRing->nToSubmit -= (uint32_t)nResult;
+	}
+
+	RasPiUringReap(pRing);
+
+	return Net_Success;
+}
+
+static void RasPiUringReap(sRasPiUring_t *pRing) {
+	struct io_uring_cqe *pCQE;
+	sRasPiUringSock_t *pSock;
+	sRasPiUringSendBuff_t *pSend;
+	sRasPiUringRecvBuff_t *pRecv;
+	struct io_uring_recvmsg_out *pMsgOut;
+	struct sockaddr_in *pFrom;
+	uint32_t nHead, nTail, nStart, nOp, nGen, nCQEFlags;
+	uint16_t nBuff;
+	int32_t nSocket, nResult;
+	bool bStale, bMore;
+
+	while (true) {
+		//Read the head each time, handling a completion can reap others
+		nHead = *(pRing->pCQHead);
+		nTail = __atomic_load_n(pRing->pCQTail, __ATOMIC_ACQUIRE);
+		if (nHead == nTail) {
+			break;
+		}
+
+		pCQE = &(pRing->pCQEs[nHead & pRing->nCQMask]);
+
+		nOp = (uint32_t)(pCQE->user_data >> 56);
+		nGen = (uint32_t)((pCQE->user_data >> 48) & 0xFF);
+		nBuff = (uint16_t)((pCQE->user_data >> 32) & 0xFFFF);
+		nSocket = (int32_t)(pCQE->user_data & 0xFFFFFFFF);
+		nResult = pCQE->res;
+		nCQEFlags = pCQE->flags;
+		bMore = CheckAllBitsInMask(nCQEFlags, IORING_CQE_F_MORE);
+
+		//Free the entry before handling it, handling may queue more requests
+		nHead += 1;
+		__atomic_store_n(pRing->pCQHead, nHead, __ATOMIC_RELEASE);
+
+		pSock = &(pRing->aSocks[nSocket]);
+		bStale = ((pSock->eType == RasPiUring_Free) || (pSock->nGen != nGen));
+
+		switch (nOp) {
+			case RASPIURING_OPACCEPT:
+				if (nResult >= 0) {
+					if ((bStale == true) || (RasPiUringAddSocket(pRing, nResult, RasPiUring_Stream) != Net_Success)) {
+						close(nResult); //Nowhere to put the client
+					} else { //Queue the client for the accept function
+						pRing->aSocks[nResult].nAcceptNext = SOCKET_INVALID;
+						if (pSock->nAcceptTail == SOCKET_INVALID) {
+							pSock->nAcceptHead = nResult;
+						} else {
+							pRing->aSocks[pSock->nAcceptTail].nAcceptNext = nResult;
+						}
+						pSock->nAcceptTail = nResult;
+					}
+				} else if ((bStale == false) && (nResult != -ECANCELED) && (nResult != -EINTR) && (nResult != -ECONNABORTED)) {
+					pSock->nError = nResult;
+					pSock->bClosed = true;
+				}
+
+				if ((bStale == false) && (bMore == false)) {
+					pSock->bRecvArmed = false;
+					if (pSock->bClosed == false) {
+						RasPiUringArm(pRing, nSocket);
+					}
+				}
+				break;
+			case RASPIURING_OPRECV:
+				if (CheckAllBitsInMask(nCQEFlags, IORING_CQE_F_BUFFER) == true) {
+					nBuff = (uint16_t)(nCQEFlags >> IORING_CQE_BUFFER_SHIFT);
+				} else {
+					nBuff = RASPIURING_NOBUFF;
+				}
+
+				if (bStale == true) {
+					if (nBuff != RASPIURING_NOBUFF) {
+						RasPiUringReturnRecv(pRing, nBuff);
+					}
+					break;
+				}
+
+				if ((nResult > 0) && (nBuff != RASPIURING_NOBUFF)) {
+					pRecv = &(pRing->aRecvInfo[nBuff]);
+					pRecv->nNext = RASPIURING_NOBUFF;
+
+					if (pSock->eType == RasPiUring_Dgram) { //Buffer leads with the sender and lengths
+						pMsgOut = (struct io_uring_recvmsg_out *)pRing->aRecvBuff[nBuff];
+						pFrom = (struct sockaddr_in *)&(pMsgOut[1]);
+						nStart = sizeof(struct io_uring_recvmsg_out) + pSock->RecvMsg.msg_namelen + pSock->RecvMsg.msg_controllen;
+
+						pRecv->nStart = nStart;
+						pRecv->nLen = pMsgOut->payloadlen;
+						if (pRecv->nLen > (uint32_t)nResult - nStart) { //Datagram was cut off
+							pRecv->nLen = (uint32_t)nResult - nStart;
+						}
+
+						pRecv->From.Addr.nNetLong = pFrom->sin_addr.s_addr;
+						pRecv->From.Port = ntohs(pFrom->sin_port);
+					} else {
+						pRecv->nStart = 0;
+						pRecv->nLen = (uint32_t)nResult;
+					}
+
+					if (pSock->nRecvTail == RASPIURING_NOBUFF) {
+						pSock->nRecvHead = nBuff;
+					} else {
+						pRing->aRecvInfo[pSock->nRecvTail].nNext = nBuff;
+					}
+					pSock->nRecvTail = nBuff;
+				} else {
+					if (nBuff != RASPIURING_NOBUFF) {
+						RasPiUringReturnRecv(pRing, nBuff);
+					}
+
+					if (nResult == -ENOBUFS) { //Pool is empty, receiving resumes as buffers are read
+						if (pSock->bStarved == false) {
+							pSock->bStarved = true;
+							pRing->nStarvedCnt += 1;
+						}
+					} else if ((nResult == 0) && (pSock->eType == RasPiUring_Stream)) { //Peer closed the connection
+						pSock->bClosed = true;
+					} else if ((nResult < 0) && (nResult != -ECANCELED)) {
+						pSock->nError = nResult;
+						pSock->bClosed = true;
+					}
+				}
+
+				if (bMore == false) {
+					pSock->bRecvArmed = false;
+					if ((pSock->bClosed == false) && (pSock->bStarved == false)) {
+						RasPiUringArm(pRing, nSocket);
+					}
+				}
+				break;
+			case RASPIURING_OPSEND:
+				pSend = &(pRing->aSendInfo[nBuff]);
+
+				if ((bStale == true) || (pSock->eType == RasPiUring_Dgram)) {
+					if ((bStale == false) && (nResult < 0)) {
+						pSock->nError = nResult;
+					}
+
+					RasPiUringFreeSend(pRing, nBuff);
+					break;
+				}
+
+				if (nResult < 0) { //Stream is broken, drop everything queued behind it
+					pSock->nError = nResult;
+					pSock->bClosed = true;
+
+					while (pSock->nSendHead != RASPIURING_NOBUFF) {
+						nBuff = pSock->nSendHead;
+						pSock->nSendHead = pRing->aSendInfo[nBuff].nNext;
+						RasPiUringFreeSend(pRing, nBuff);
+					}
+					pSock->nSendTail = RASPIURING_NOBUFF;
+					pSock->bSending = false;
+				} else if ((uint32_t)nResult < pSend->nLen) { //Short write, send the rest
+					pSend->nStart += (uint32_t)nResult;
+					pSend->nLen -= (uint32_t)nResult;
+					RasPiUringIssueSend(pRing, nSocket, nBuff);
+				} else {
+					pSock->nSendHead = pSend->nNext;
+					RasPiUringFreeSend(pRing, nBuff);
+
+					if (pSock->nSendHead != RASPIURING_NOBUFF) {
+						RasPiUringIssueSend(pRing, nSocket, pSock->nSendHead);
+					} else {
+						pSock->nSendTail = RASPIURING_NOBUFF;
+						pSock->bSending = false;
+					}
+				}
+				break;
+			default: //Cancel results need no handling
+				break;
+		}
+	}
+
+	return;
+}
+
+static sRasPiUringSock_t *RasPiUringFindSock(sRasPiUring_t *pRing, int32_t nSocket) {
+	if ((pRing == NULL) || (nSocket < 0) || (nSocket >= RASPIURING_MAXFD)) {
+		return NULL;
+	}
+
+	if (pRing->aSocks[nSocket].eType == RasPiUring_Free) {
+		return NULL;
+	}
+
+	return &(pRing->aSocks[nSocket]);
+}
+
+static eNetReturn_t RasPiUringAddSocket(sRasPiUring_t *pRing, int32_t nSocket, eRasPiUringSockType_t eType) {
+	sRasPiUringSock_t *pSock;
+	uint8_t nGen;
+
+	if ((nSocket < 0) || (nSocket >= RASPIURING_MAXFD)) {
+		return NetFail_InvSocket;
+	}
+
+	pSock = &(pRing->aSocks[nSocket]);
+
+	//A new generation keeps completions for the last user of this descriptor away
+	nGen = pSock->nGen + 1;
+	memset(pSock, 0, sizeof(sRasPiUringSock_t));
+	pSock->nGen = nGen;
+	pSock->eType = eType;
+	pSock->nRecvHead = RASPIURING_NOBUFF;
+	pSock->nRecvTail = RASPIURING_NOBUFF;
+	pSock->nSendHead = RASPIURING_NOBUFF;
+	pSock->nSendTail = RASPIURING_NOBUFF;
+	pSock->nAcceptHead = SOCKET_INVALID;
+	pSock->nAcceptTail = SOCKET_INVALID;
+	pSock->nAcceptNext = SOCKET_INVALID;
+
+	//Datagrams arrive with the sender's address ahead of the data
+	pSock->RecvMsg.msg_namelen = sizeof(struct sockaddr_in);
+
+	RasPiUringArm(pRing, nSocket);
+
+	return Net_Success;
+}
+
+static void RasPiUringArm(sRasPiUring_t *pRing, int32_t nSocket) {
+	sRasPiUringSock_t *pSock = &(pRing->aSocks[nSocket]);
+	struct io_uring_sqe *pSQE;
+
+	if (pSock->bRecvArmed == true) {
+		return;
+	}
+
+	pSQE = RasPiUringGetSQE(pRing);
+	if (pSQE == NULL) { //Try again when the queue has room
+		if (pSock->bStarved == false) {
+			pSock->bStarved = true;
+			pRing->nStarvedCnt += 1;
+		}
+		return;
+	}
+
+	pSQE->fd = nSocket;
+
+	switch (pSock->eType) {
+		case RasPiUring_Listener:
+			pSQE->opcode = IORING_OP_ACCEPT;
+			pSQE->ioprio = IORING_ACCEPT_MULTISHOT;
+			pSQE->user_data = RASPIURING_USERDATA(RASPIURING_OPACCEPT, pSock->nGen, 0, nSocket);
+			break;
+		case RasPiUring_Stream:
+			pSQE->opcode = IORING_OP_RECV;
+			pSQE->ioprio = IORING_RECV_MULTISHOT;
+			pSQE->flags = IOSQE_BUFFER_SELECT;
+			pSQE->buf_group = 0;
+			pSQE->user_data = RASPIURING_USERDATA(RASPIURING_OPRECV, pSock->nGen, 0, nSocket);
+			break;
+		case RasPiUring_Dgram:
+			pSQE->opcode = IORING_OP_RECVMSG;
+			pSQE->addr = (uint64_t)(uintptr_t)&(pSock->RecvMsg);
+			pSQE->len = 1;
+			pSQE->ioprio = IORING_RECV_MULTISHOT;
+			pSQE->flags = IOSQE_BUFFER_SELECT;
+			pSQE->buf_group = 0;
+			pSQE->user_data = RASPIURING_USERDATA(RASPIURING_OPRECV, pSock->nGen, 0, nSocket);
+			break;
+		default:
+			//Queued entry can't be taken back, make it do nothing
+			pSQE->opcode = IORING_OP_NOP;
+			pSQE->user_data = RASPIURING_USERDATA(RASPIURING_OPCANCEL, 0, 0, nSocket);
+			return;
+	}
+
+	pSock->bRecvArmed = true;
+
+	return;
+}
+
+static void RasPiUringDropSocket(sRasPiUring_t *pRing, int32_t nSocket) {
+	sRasPiUringSock_t *pSock = &(pRing->aSocks[nSocket]);
+	struct io_uring_sqe *pSQE;
+	uint64_t nDeadline;
+	uint16_t nBuff;
+	int32_t nClient;
+
+	//Let queued sends leave before the socket goes away
+	nDeadline = RasPiUringTimeMS() + RASPIURING_CLOSEWAITMS;
+	while ((pSock->bSending == true) && (pSock->bClosed == false) && (RasPiUringTimeMS() < nDeadline)) {
+		if (RasPiUringEnter(pRing, true, RASPIURING_CLOSEWAITMS) != Net_Success) {
+			break;
+		}
+	}
+
+	//Stop the multishot request, it must be gone before the descriptor is closed
+	pSQE = RasPiUringGetSQE(pRing);
+	if (pSQE != NULL) {
+		pSQE->opcode = IORING_OP_ASYNC_CANCEL;
+		pSQE->fd = nSocket;
+		pSQE->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+		pSQE->user_data = RASPIURING_USERDATA(RASPIURING_OPCANCEL, 0, 0, nSocket);
+		RasPiUringEnter(pRing, false, 0);
+	}
+
+	//Buffers still waiting to be read go back to the kernel
+	while (pSock->nRecvHead != RASPIURING_NOBUFF) {
+		nBuff = pSock->nRecvHead;
+		pSock->nRecvHead = pRing->aRecvInfo[nBuff].nNext;
+		RasPiUringReturnRecv(pRing, nBuff);
+	}
+
+	//Sends not yet given to the kernel are dropped, the one in flight is freed on completion
+	nBuff = pSock->nSendHead;
+	if ((nBuff != RASPIURING_NOBUFF) && (pSock->bSending == true)) {
+		nBuff = pRing->aSendInfo[nBuff].nNext;
+	}
+	while (nBuff != RASPIURING_NOBUFF) {
+		pSock->nSendHead = pRing->aSendInfo[nBuff].nNext;
+		RasPiUringFreeSend(pRing, nBuff);
+		nBuff = pSock->nSendHead;
+	}
+
+	//Clients nobody accepted are closed with their listener
+	while (pSock->nAcceptHead != SOCKET_INVALID) {
+		nClient = pSock->nAcceptHead;
+		pSock->nAcceptHead = pRing->aSocks[nClient].nAcceptNext;
+		RasPiUringDropSocket(pRing, nClient);
+	}
+
+	if (pSock->bStarved == true) {
+		pRing->nStarvedCnt -= 1;
+	}
+
+	pSock->eType = RasPiUring_Free;
+	pSock->nGen += 1;
+	pSock->bStarved = false;
+	pSock->bRecvArmed = false;
+
+	close(nSocket);
+
+	return;
+}
+
+static void RasPiUringReturnRecv(sRasPiUring_t *pRing, uint16_t nBuff) {
+	struct io_uring_buf *pBuf;
+	int32_t nCtr;
+
+	pBuf = &(pRing->pBufRing->bufs[pRing->nBufRingTail & (RASPIURING_RECVCOUNT - 1)]);
+	pBuf->addr = (uint64_t)(uintptr_t)pRing->aRecvBuff[nBuff];
+	pBuf->len = RASPIURING_BUFFSIZE;
+	pBuf->bid = nBuff;
+
+	pRing->nBufRingTail += 1;
+	__atomic_store_n(&(pRing->pBufRing->tail), pRing->nBufRingTail, __ATOMIC_RELEASE);
+
+	if (pRing->nStarvedCnt == 0) {
+		return;
+	}
+
+	//A buffer is free again, restart sockets that ran out
+	for (nCtr = 0; (nCtr < RASPIURING_MAXFD) && (pRing->nStarvedCnt > 0); nCtr++) {
+		if ((pRing->aSocks[nCtr].eType == RasPiUring_Free) || (pRing->aSocks[nCtr].bStarved == false)) {
+			continue;
+		}
+
+		pRing->aSocks[nCtr].bStarved = false;
+		pRing->nStarvedCnt -= 1;
+		RasPiUringArm(pRing, nCtr);
+	}
+
+	return;
+}
+
+static eNetReturn_t RasPiUringTakeSend(sRasPiUring_t *pRing, uint16_t *pnBuff) {
+	sRasPiUringSendBuff_t *pSend;
+
+	while (pRing->nSendFree == RASPIURING_NOBUFF) { //All in flight, wait like a blocking send
+		if (RasPiUringEnter(pRing, true, 0) != Net_Success) {
+			return NetFail_Unknown;
+		}
+	}
+
+	*pnBuff = pRing->nSendFree;
+	pSend = &(pRing->aSendInfo[*pnBuff]);
+	pRing->nSendFree = pSend->nNext;
+
+	pSend->nNext = RASPIURING_NOBUFF;
+	pSend->nStart = 0;
+	pSend->nLen = 0;
+	pSend->bHeld = false;
+
+	return Net_Success;
+}
+
+static void RasPiUringFreeSend(sRasPiUring_t *pRing, uint16_t nBuff) {
+	pRing->aSendInfo[nBuff].bHeld = false;
+	pRing->aSendInfo[nBuff].nNext = pRing->nSendFree;
+	pRing->nSendFree = nBuff;
+
+	return;
+}
+
+static void RasPiUringIssueSend(sRasPiUring_t *pRing, int32_t nSocket, uint16_t nBuff) {
+	sRasPiUringSock_t *pSock = &(pRing->aSocks[nSocket]);
+	sRasPiUringSendBuff_t *pSend = &(pRing->aSendInfo[nBuff]);
+	struct io_uring_sqe *pSQE;
+
+	pSQE = RasPiUringGetSQE(pRing);
+	while (pSQE == NULL) { //Queue is full of requests the kernel has not taken
+		RasPiUringEnter(pRing, true, 1);
+		pSQE = RasPiUringGetSQE(pRing);
+	}
+
+	pSQE->fd = nSocket;
+	pSQE->user_data = RASPIURING_USERDATA(RASPIURING_OPSEND, pSock->nGen, nBuff, nSocket);
+
+	if (pSock->eType == RasPiUring_Dgram) {
+		pSend->Vec.iov_base = &(pRing->aSendBuff[nBuff][pSend->nStart]);
+		pSend->Vec.iov_len = pSend->nLen;
+
+		memset(&(pSend->Msg), 0, sizeof(struct msghdr));
+		pSend->Msg.msg_name = &(pSend->Addr);
+		pSend->Msg.msg_namelen = sizeof(struct sockaddr_in);
+		pSend->Msg.msg_iov = &(pSend->Vec);
+		pSend->Msg.msg_iovlen = 1;
+
+		pSQE->opcode = IORING_OP_SENDMSG;
+		pSQE->addr = (uint64_t)(uintptr_t)&(pSend->Msg);
+		pSQE->len = 1;
+	} else {
+		//Index 0 is the region holding every send buffer
+		pSQE->opcode = IORING_OP_WRITE_FIXED;
+		pSQE->addr = (uint64_t)(uintptr_t)&(pRing->aSendBuff[nBuff][pSend->nStart]);
+		pSQE->len = pSend->nLen;
+		pSQE->off = 0;
+		pSQE->buf_index = 0;
+
+		pSock->bSending = true;
+	}
+
+	return;
+}
+
+static uint16_t RasPiUringHeldBuffer(sRasPiUring_t *pRing, void *pData) {
+	uintptr_t nOffset;
+	uint16_t nBuff;
+
+	if (((uint8_t *)pData < &(pRing->aSendBuff[0][0])) || ((uint8_t *)pData >= &(pRing->aSendBuff[RASPIURING_SENDCOUNT - 1][RASPIURING_BUFFSIZE - 1]) + 1)) {
+		return RASPIURING_NOBUFF;
+	}
+
+	nOffset = (uintptr_t)((uint8_t *)pData - &(pRing->aSendBuff[0][0]));
+	nBuff = (uint16_t)(nOffset / RASPIURING_BUFFSIZE);
+
+	if (pRing->aSendInfo[nBuff].bHeld == false) {
+		return RASPIURING_NOBUFF;
+	}
+
+	return nBuff;
+}
+
+static eNetReturn_t RasPiUringStreamSend(sRasPiUring_t *pRing, int32_t nSocket, uint32_t nDataBytes, void *pData) {
+	sRasPiUringSock_t *pSock;
+	sRasPiUringSendBuff_t *pSend;
+	uint8_t *pBytes = (uint8_t *)pData;
+	uint32_t nOffset, nCopy;
+	uint16_t nBuff;
+
+	pSock = RasPiUringFindSock(pRing, nSocket);
+	if ((pSock == NULL) || (pSock->eType != RasPiUring_Stream)) {
+		return NetFail_InvSocket;
+	}
+
+	if (pSock->nError != 0) { //An earlier send failed
+		return NetFail_Unknown;
+	}
+
+	nBuff = RasPiUringHeldBuffer(pRing, pData);
+	if (nBuff != RASPIURING_NOBUFF) { //Filled in place, hand it over as it is
+		nOffset = (uint32_t)(pBytes - pRing->aSendBuff[nBuff]);
+		if (nOffset + nDataBytes > RASPIURING_BUFFSIZE) {
+			return NetFail_Unknown;
+		}
+
+		pSend = &(pRing->aSendInfo[nBuff]);
+		pSend->bHeld = false;
+		pSend->nNext = RASPIURING_NOBUFF;
+		pSend->nStart = nOffset;
+		pSend->nLen = nDataBytes;
+
+		nDataBytes = 0;
+	}
+
+	while ((nDataBytes > 0) || (nBuff != RASPIURING_NOBUFF)) {
+		if (nBuff == RASPIURING_NOBUFF) {
+			nBuff = pSock->nSendTail;
+
+			//Pack behind the last queued buffer unless the kernel already has it
+			if ((nBuff != RASPIURING_NOBUFF) && ((nBuff != pSock->nSendHead) || (pSock->bSending == false))) {
+				pSend = &(pRing->aSendInfo[nBuff]);
+				nOffset = pSend->nStart + pSend->nLen;
+
+				if (nOffset < RASPIURING_BUFFSIZE) {
+					nCopy = RASPIURING_BUFFSIZE - nOffset;
+					if (nCopy > nDataBytes) {
+						nCopy = nDataBytes;
+					}
+
+					memcpy(&(pRing->aSendBuff[nBuff][nOffset]), pBytes, nCopy);
+					pSend->nLen += nCopy;
+					pBytes += nCopy;
+					nDataBytes -= nCopy;
+				}
+			}
+
+			if (nDataBytes == 0) {
+				break;
+			}
+
+			if (RasPiUringTakeSend(pRing, &nBuff) != Net_Success) {
+				return NetFail_Unknown;
+			}
+
+			if (RasPiUringFindSock(pRing, nSocket) != pSock) { //Closed while waiting for a buffer
+				RasPiUringFreeSend(pRing, nBuff);
+				return NetFail_SocketState;
+			}
+
+			pSend = &(pRing->aSendInfo[nBuff]);
+			nCopy = (nDataBytes > RASPIURING_BUFFSIZE) ? RASPIURING_BUFFSIZE : nDataBytes;
+			memcpy(pRing->aSendBuff[nBuff], pBytes, nCopy);
+			pSend->nLen = nCopy;
+			pBytes += nCopy;
+			nDataBytes -= nCopy;
+		}
+
+		//Add the buffer to the socket's queue
+		if (pSock->nSendTail == RASPIURING_NOBUFF) {
+			pSock->nSendHead = nBuff;
+		} else {
+			pRing->aSendInfo[pSock->nSendTail].nNext = nBuff;
+		}
+		pSock->nSendTail = nBuff;
+
+		if (pSock->bSending == false) {
+			RasPiUringIssueSend(pRing, nSocket, pSock->nSendHead);
+		}
+
+		nBuff = RASPIURING_NOBUFF;
+	}
+
+	return Net_Success;
+}
+
+static eNetReturn_t RasPiUringDgramSend(sRasPiUring_t *pRing, int32_t nSocket, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData) {
+	sRasPiUringSock_t *pSock;
+	sRasPiUringSendBuff_t *pSend;
+	uint16_t nBuff;
+
+	pSock = RasPiUringFindSock(pRing, nSocket);
+	if ((pSock == NULL) || (pSock->eType != RasPiUring_Dgram)) {
+		return NetFail_InvSocket;
+	}
+
+	if (pSock->nError != 0) { //Report an earlier failure once
+		pSock->nError = 0;
+		return NetFail_Unknown;
+	}
+
+	nBuff = RasPiUringHeldBuffer(pRing, pData);
+	if (nBuff != RASPIURING_NOBUFF) { //Filled in place, hand it over as it is
+		pSend = &(pRing->aSendInfo[nBuff]);
+		pSend->nStart = (uint32_t)((uint8_t *)pData - pRing->aSendBuff[nBuff]);
+		if (pSend->nStart + nDataBytes > RASPIURING_BUFFSIZE) {
+			return NetFail_Unknown;
+		}
+
+		pSend->bHeld = false;
+	} else {
+		if (nDataBytes > RASPIURING_BUFFSIZE) {
+			return NetFail_Unknown;
+		}
+
+		if (RasPiUringTakeSend(pRing, &nBuff) != Net_Success) {
+			return NetFail_Unknown;
+		}
+
+		pSend = &(pRing->aSendInfo[nBuff]);
+		memcpy(pRing->aSendBuff[nBuff], pData, nDataBytes);
+	}
+
+	pSend->nLen = nDataBytes;
+
+	memset(&(pSend->Addr), 0, sizeof(struct sockaddr_in));
+	pSend->Addr.sin_family = AF_INET;
+	pSend->Addr.sin_port = htons(pConn->Port);
+	pSend->Addr.sin_addr.s_addr = pConn->Addr.nNetLong;
+
+	RasPiUringIssueSend(pRing, nSocket, nBuff);
+
+	return Net_Success;
+}
+
+static eNetReturn_t RasPiUringWaitData(sRasPiUring_t *pRing, int32_t nSocket) {
+	sRasPiUringSock_t *pSock = &(pRing->aSocks[nSocket]);
+	uint64_t nNow, nDeadline;
+	uint8_t nGen = pSock->nGen;
+
+	nDeadline = RasPiUringTimeMS() + pSock->nTimeoutMS;
+
+	while ((pSock->nRecvHead == RASPIURING_NOBUFF) && (pSock->bClosed == false)) {
+		if (pSock->nTimeoutMS == 0) { //No timeout, wait as long as it takes
+			if (RasPiUringEnter(pRing, true, 0) != Net_Success) {
+				return NetFail_Unknown;
+			}
+		} else {
+			nNow = RasPiUringTimeMS();
+			if (nNow >= nDeadline) {
+				break;
+			}
+
+			if (RasPiUringEnter(pRing, true, (uint32_t)(nDeadline - nNow)) != Net_Success) {
+				return NetFail_Unknown;
+			}
+		}
+
+		if ((pSock->eType == RasPiUring_Free) || (pSock->nGen != nGen)) { //Closed while waiting
+			return NetFail_SocketState;
+		}
+	}
+
+	return Net_Success;
+}
+
+static eNetReturn_t RasPiUringStreamRecv(sRasPiUring_t *pRing, int32_t nSocket, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sRasPiUringSock_t *pSock;
+	sRasPiUringRecvBuff_t *pRecv;
+	uint8_t *pBytes = (uint8_t *)pData;
+	uint32_t nCopy;
+	uint16_t nBuff;
+	eNetReturn_t eResult;
+
+	*pnBytesRecv = 0;
+
+	pSock = RasPiUringFindSock(pRing, nSocket);
+	if ((pSock == NULL) || (pSock->eType != RasPiUring_Stream)) {
+		return NetFail_InvSocket;
+	}
+
+	eResult = RasPiUringWaitData(pRing, nSocket);
+	if (eResult != Net_Success) {
+		return eResult;
+	}
+
+	//Copy from each filled buffer in the order they arrived
+	while ((*pnBytesRecv < nDataBytes) && (pSock->nRecvHead != RASPIURING_NOBUFF)) {
+		nBuff = pSock->nRecvHead;
+		pRecv = &(pRing->aRecvInfo[nBuff]);
+
+		nCopy = nDataBytes - *pnBytesRecv;
+		if (nCopy > pRecv->nLen) {
+			nCopy = pRecv->nLen;
+		}
+
+		memcpy(&(pBytes[*pnBytesRecv]), &(pRing->aRecvBuff[nBuff][pRecv->nStart]), nCopy);
+		*pnBytesRecv += nCopy;
+		pRecv->nStart += nCopy;
+		pRecv->nLen -= nCopy;
+
+		if (pRecv->nLen == 0) { //Buffer is read, give it back
+			pSock->nRecvHead = pRecv->nNext;
+			if (pSock->nRecvHead == RASPIURING_NOBUFF) {
+				pSock->nRecvTail = RASPIURING_NOBUFF;
+			}
+
+			RasPiUringReturnRecv(pRing, nBuff);
+		}
+	}
+
+	if (*pnBytesRecv == 0) {
+		if (pSock->nError != 0) {
+			return NetFail_Unknown;
+		}
+
+		if ((pSock->bClosed == true) && (nDataBytes > 0)) { //Peer closed the connection
+			return NetFail_SocketState;
+		}
+	}
+
+	if (*pnBytesRecv < nDataBytes) {
+		return NetWarn_EndOfData;
+	} else {
+		return Net_Success;
+	}
+}
+
+static eNetReturn_t RasPiUringDgramRecv(sRasPiUring_t *pRing, int32_t nSocket, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
+	sRasPiUringSock_t *pSock;
+	sRasPiUringRecvBuff_t *pRecv;
+	uint16_t nBuff;
+	eNetReturn_t eResult;
+
+	*pnBytesRecv = 0;
+
+	pSock = RasPiUringFindSock(pRing, nSocket);
+	if ((pSock == NULL) || (pSock->eType != RasPiUring_Dgram)) {
+		return NetFail_InvSocket;
+	}
+
+	eResult = RasPiUringWaitData(pRing, nSocket);
+	if (eResult != Net_Success) {
+		return eResult;
+	}
+
+	if (pSock->nRecvHead == RASPIURING_NOBUFF) {
+		if (pSock->bClosed == true) {
+			return NetFail_Unknown;
+		}
+
+		return NetWarn_EndOfData;
+	}
+
+	nBuff = pSock->nRecvHead;
+	pRecv = &(pRing->aRecvInfo[nBuff]);
+
+	*pnBytesRecv = (pRecv->nLen < nDataBytes) ? pRecv->nLen : nDataBytes;
+	memcpy(pData, &(pRing->aRecvBuff[nBuff][pRecv->nStart]), *pnBytesRecv);
+
+	pConn->Addr.nNetLong = pRecv->From.Addr.nNetLong;
+	pConn->Port = pRecv->From.Port;
+
+	pSock->nRecvHead = pRecv->nNext;
+	if (pSock->nRecvHead == RASPIURING_NOBUFF) {
+		pSock->nRecvTail = RASPIURING_NOBUFF;
+	}
+
+	RasPiUringReturnRecv(pRing, nBuff);
+
+	return Net_Success;
+}
+
+static uint64_t RasPiUringTimeMS(void) {
+	struct timespec TimeInfo;
+
+	clock_gettime(CLOCK_MONOTONIC, &TimeInfo);
+
+	return ((uint64_t)TimeInfo.tv_sec * 1000) + ((uint64_t)TimeInfo.tv_nsec / 1000000);
+}
+
+
+static bool RasPiUringKernelSupported(void) {
+	struct utsname KernelInfo;
+	int nMajor, nMinor;
+
+	if (uname(&KernelInfo) != 0) {
+		return false;
+	}
+
+	//Release reads like 6.1.21-v8+, only the first two numbers matter
+	if (sscanf(KernelInfo.release, "%d.%d", &nMajor, &nMinor) != 2) {
+		return false;
+	}
+
+	if (nMajor != RASPIURING_KERNELMAJOR) {
+		return (nMajor > RASPIURING_KERNELMAJOR) ? true : false;
+	}
+
+	return (nMinor >= RASPIURING_KERNELMINOR) ? true : false;
+}
@@ -0,0 +1,322 @@
+/**	@defgroup	raspiuring
+	@brief		io_uring implementation of the network general interface for Linux
+	@details	v0.1
+	#Description
+		Implements the TCP server, TCP client, UDP server, and UDP client
+		interfaces by queueing requests to an io_uring shared by all of them
+		instead of making a system call for each send and receive.  Requests
+		collect in the submission queue and go to the kernel together the next
+		time the application waits on the ring.
+		Every socket has a multishot receive armed as soon as it is opened,
+		and listening sockets have a multishot accept.  The kernel keeps
+		filling receive buffers from a pool registered with the ring, and
+		receive calls copy out of the buffers already filled.  Buffers go back
+		to the pool once they are read.
+		Sends are copied into buffers registered with the ring, so the kernel
+		does not map them on every request.  A buffer taken with
+		RasPiUringGetSendBuffer() can be filled in place and sent with no copy
+		at all.  Each TCP socket sends one buffer at a time to keep the stream
+		in order, data sent while one is in flight is packed behind it.  UDP
+		sends all go to the kernel together.
+
+		Requires Linux kernel 6.0 or later, the first with multishot receives.
+		Multishot accepts and the registered receive buffer ring also need
+		5.19 or later.  RasPiUringInitialize() checks the running kernel and
+		fails with NetFail_NotImplem on anything older.  The ring is selected
+		when each interface object is created, use the plain socket
+		implementations in Network_RaspberryPi.h if RasPiUringInitialize()
+		fails.
+
+	#Usage
+		Initialize an sRasPiUring_t then create interface objects on it with
+		the RasPiUringCreate functions, after that they are used through the
+		general interface as usual.  The ring object holds all buffers, it
+		should be a global or allocated rather than placed on the stack.
+		A send returns once its data is queued.  Call RasPiUringProcess() from
+		the main loop so queued requests are submitted when the application
+		is not otherwise receiving.
+
+		Receives wait for data as the plain socket version does, set a timeout
+		to limit how long.  An error from a send that already returned is
+		reported by the next send on that socket.
+
+	#File Information
+		File:	NetworkUring_RaspberryPi.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __RASPIURING_H
+	#define __RASPIURING_H
+
+/*****	Includes	*****/
+	#define _GNU_SOURCE
+
+	#include <stdio.h>
+	#include <string.h>
+	#include <unistd.h>
+	#include <errno.h>
+	#include <signal.h>
+	#include <time.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <sys/utsname.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <linux/io_uring.h>
+
+	#include "CommonUtils.h"
+	#include "NetworkGeneralInterface.h"
+
+/*****	Defines		*****/
+	/**	@brief		Oldest kernel major version the ring runs on
+		@ingroup	raspiuring
+	*/
+	#define RASPIURING_KERNELMAJOR	6
+
+	/**	@brief		Oldest kernel minor version the ring runs on, multishot receive arrived in 6.0
+		@ingroup	raspiuring
+	*/
+	#define RASPIURING_KERNELMINOR	0
+
+	#ifndef RASPIURING_ENTRIES
+		/**	@brief		Number of requests the submission queue holds, must be a power of 2
+			@ingroup	raspiuring
+		*/
+		#define RASPIURING_ENTRIES		256
+	#endif
+
+	#ifndef RASPIURING_SENDCOUNT
+		/**	@brief		Number of registered send buffers
+			@ingroup	raspiuring
+		*/
+		#define RASPIURING_SENDCOUNT	128
+	#endif
+
+	#ifndef RASPIURING_RECVCOUNT
+		/**	@brief		Number of receive buffers in the pool, must be a power of 2
+			@ingroup	raspiuring
+		*/
+		#define RASPIURING_RECVCOUNT	128
+	#endif
+
+	#ifndef RASPIURING_BUFFSIZE
+		/**	@brief		Bytes in each send and receive buffer
+			@ingroup	raspiuring
+		*/
+		#define RASPIURING_BUFFSIZE		2048
+	#endif
+
+	#ifndef RASPIURING_MAXFD
+		/**	@brief		Highest file descriptor number the ring can track plus one
+			@ingroup	raspiuring
+		*/
+		#define RASPIURING_MAXFD		1024
+	#endif
+
+	/**	@brief		Marks the end of a list of buffers
+		@ingroup	raspiuring
+	*/
+	#define RASPIURING_NOBUFF		0xFFFF
+
+	/**	@brief		Capabilities of the io_uring implementation of the TCP Server
+		@ingroup	raspiuring
+	*/
+	#define TCPSERVURING_CAPS	(TCPServ_Bind | TCPServ_CloseHost | TCPServ_AcceptConn | TCPServ_CloseClient | TCPServ_Receive | TCPServ_Send)
+
+	/**	@brief		Capabilities of the io_uring implementation of the TCP Client
+		@ingroup	raspiuring
+	*/
+	#define TCPCLIENTURING_CAPS	(TCPClient_Connect | TCPClient_Close | TCPClient_Receive | TCPClient_Send)
+
+	#define UDPSERVURING_CAPS	(UDPServ_Bind | UDPServ_CloseHost | UDPServ_Receive | UDPServ_Send | UDPServ_RecvBatch)
+
+	#define UDPCLIENTURING_CAPS	(UDPClient_SetServ | UDPClient_Send | UDPClient_Receive)
+
+/*****	Definitions	*****/
+	/**	@brief		Kinds of socket the ring tracks
+		@ingroup	raspiuring
+	*/
+	typedef enum eRasPiUringSockType_t {
+		RasPiUring_Free		= 0,	/**< File descriptor is not in the ring */
+		RasPiUring_Listener	= 1,	/**< TCP socket accepting connections */
+		RasPiUring_Stream	= 2,	/**< Connected TCP socket */
+		RasPiUring_Dgram	= 3,	/**< UDP socket */
+	} eRasPiUringSockType_t;
+
+	/**	@brief		State of one socket in the ring
+		@ingroup	raspiuring
+	*/
+	typedef struct sRasPiUringSock_t {
+		eRasPiUringSockType_t eType;			/**< Kind of socket, free if not in use */
+		uint8_t nGen;							/**< Changes each time the descriptor is reused */
+		bool bRecvArmed;						/**< True while a multishot receive or accept is outstanding */
+		bool bStarved;							/**< True if receiving stopped for lack of buffers */
+		bool bClosed;							/**< True once the peer closed or the socket failed */
+		int32_t nError;							/**< Error from the last failed request, 0 if none */
+		uint32_t nTimeoutMS;					/**< Milliseconds a receive waits, 0 waits forever */
+
+		uint16_t nRecvHead;						/**< First filled receive buffer waiting to be read */
+		uint16_t nRecvTail;						/**< Last filled receive buffer waiting to be read */
+
+		uint16_t nSendHead;						/**< Send buffer in flight, others are queued behind it */
+		uint16_t nSendTail;						/**< Last send buffer queued */
+		bool bSending;							/**< True while the head send buffer is with the kernel */
+
+		int32_t nAcceptHead;					/**< First accepted client waiting, listeners only */
+		int32_t nAcceptTail;					/**< Last accepted client waiting, listeners only */
+		int32_t nAcceptNext;					/**< Next client waiting on the same listener */
+
+		struct msghdr RecvMsg;					/**< Layout of each datagram in a receive buffer */
+	} sRasPiUringSock_t;
+
+	/**	@brief		State of a send buffer
+		@ingroup	raspiuring
+	*/
+	typedef struct sRasPiUringSendBuff_t {
+		uint16_t nNext;							/**< Next buffer queued on the same socket */
+		uint32_t nStart;						/**< Offset of the first byte to send */
+		uint32_t nLen;							/**< Bytes left to send */
+		bool bHeld;								/**< True while the application is filling it */
+
+		struct msghdr Msg;						/**< Datagram request */
+		struct iovec Vec;						/**< Data of the datagram */
+		struct sockaddr_in Addr;				/**< Destination of the datagram */
+	} sRasPiUringSendBuff_t;
+
+	/**	@brief		State of a receive buffer
+		@ingroup	raspiuring
+	*/
+	typedef struct sRasPiUringRecvBuff_t {
+		uint16_t nNext;							/**< Next filled buffer on the same socket */
+		uint32_t nStart;						/**< Offset of the first byte not yet read */
+		uint32_t nLen;							/**< Bytes not yet read */
+		sConnInfo_t From;						/**< Sender of a datagram */
+	} sRasPiUringRecvBuff_t;
+
+	/**	@brief		An io_uring with its buffers and sockets
+		@ingroup	raspiuring
+	*/
+	typedef struct sRasPiUring_t {
+		int32_t nRingFd;						/**< io_uring instance */
+
+		void *pRingMem;							/**< Mapping holding both queue rings */
+		size_t nRingMemSize;					/**< Bytes in the queue ring mapping */
+		struct io_uring_sqe *pSQEs;				/**< Submission queue entries */
+		size_t nSQEsSize;						/**< Bytes in the entry mapping */
+		uint32_t *pSQHead;						/**< Submission entries the kernel has consumed */
+		uint32_t *pSQTail;						/**< Submission entries queued */
+		uint32_t *pSQArray;						/**< Order of the submission entries */
+		uint32_t nSQMask;						/**< Mask to turn a count into an entry index */
+		uint32_t nSQEntries;					/**< Entries in the submission queue */
+		uint32_t nToSubmit;						/**< Entries queued since the last submit */
+		uint32_t *pCQHead;						/**< Completions consumed */
+		uint32_t *pCQTail;						/**< Completions posted by the kernel */
+		uint32_t nCQMask;						/**< Mask to turn a count into a completion index */
+		struct io_uring_cqe *pCQEs;				/**< Completion queue entries */
+
+		struct io_uring_buf_ring *pBufRing;		/**< Ring giving receive buffers to the kernel */
+		size_t nBufRingSize;					/**< Bytes in the receive buffer ring */
+		uint16_t nBufRingTail;					/**< Receive buffers given to the kernel */
+		uint32_t nStarvedCnt;					/**< Sockets that stopped receiving for lack of buffers */
+
+		uint16_t nSendFree;						/**< First unused send buffer */
+		sRasPiUringSendBuff_t aSendInfo[RASPIURING_SENDCOUNT];	/**< State of each send buffer */
+		sRasPiUringRecvBuff_t aRecvInfo[RASPIURING_RECVCOUNT];	/**< State of each receive buffer */
+		sRasPiUringSock_t aSocks[RASPIURING_MAXFD];			/**< State of each socket by descriptor */
+
+		uint8_t aSendBuff[RASPIURING_SENDCOUNT][RASPIURING_BUFFSIZE];	/**< Send buffers, registered with the ring */
+		uint8_t aRecvBuff[RASPIURING_RECVCOUNT][RASPIURING_BUFFSIZE];	/**< Receive buffers, given to the kernel */
+	} sRasPiUring_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Create an io_uring and register its buffers
+		@param		pRing		Ring to initialize
+		@return		Net_Success if the ring is ready, NetFail_NotImplem if the
+			kernel is older than 6.0 or does not support the features used,
+			NetFail_Unknown if the ring could not be set up
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringInitialize(sRasPiUring_t *pRing);
+
+	/**	@brief		Close every socket in the ring and the ring itself
+		@param		pRing		Ring to close
+		@return		Net_Success once everything is closed
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringClose(sRasPiUring_t *pRing);
+
+	/**	@brief		Create a TCP server interface object that runs on a ring
+		@param		pRing		Ring the server's requests go through
+		@param		pTCPServ	Interface object to prepare
+		@return		Net_Success if the server is ready to bind
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringCreateTCPServer(sRasPiUring_t *pRing, sTCPServ_t *pTCPServ);
+
+	/**	@brief		Create a TCP client interface object that runs on a ring
+		@param		pRing		Ring the client's requests go through
+		@param		pTCPClient	Interface object to prepare
+		@return		Net_Success if the client is ready to connect
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringCreateTCPClient(sRasPiUring_t *pRing, sTCPClient_t *pTCPClient);
+
+	/**	@brief		Create a UDP server interface object that runs on a ring
+		@param		pRing		Ring the server's requests go through
+		@param		pUDPServ	Interface object to prepare
+		@return		Net_Success if the server is ready to bind
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringCreateUDPServer(sRasPiUring_t *pRing, sUDPServ_t *pUDPServ);
+
+	/**	@brief		Create a UDP client interface object that runs on a ring
+		@param		pRing		Ring the client's requests go through
+		@param		pUDPClient	Interface object to prepare
+		@return		Net_Success if the client is ready to set its server
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringCreateUDPClient(sRasPiUring_t *pRing, sUDPClient_t *pUDPClient);
+
+	/**	@brief		Take a registered send buffer to fill in place
+		@details	Passing data that lies in this buffer to a send hands the
+			buffer to the kernel with no copy.  Buffers that are not sent must
+			be given back with RasPiUringReleaseSendBuffer().
+		@param		pRing		Ring to take the buffer from
+		@param		ppBuff		Returns the buffer, RASPIURING_BUFFSIZE bytes long
+		@return		Net_Success if a buffer was taken, NetFail_Unknown if the
+			ring failed while waiting for one to come free
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringGetSendBuffer(sRasPiUring_t *pRing, uint8_t **ppBuff);
+
+	/**	@brief		Give back a send buffer that will not be sent
+		@param		pRing		Ring the buffer came from
+		@param		pBuff		Buffer returned by RasPiUringGetSendBuffer()
+		@return		Net_Success if the buffer was given back, NetFail_Unknown if
+			it is not a held send buffer
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringReleaseSendBuffer(sRasPiUring_t *pRing, uint8_t *pBuff);
+
+	/**	@brief		Submit queued requests and handle any completions
+		@param		pRing		Ring to process
+		@param		nTimeoutMS	Milliseconds to wait for a completion, 0 to
+			return right away
+		@return		Net_Success if the ring was processed, NetFail_Unknown if
+			submitting failed
+		@ingroup	raspiuring
+	*/
+	eNetReturn_t RasPiUringProcess(sRasPiUring_t *pRing, uint32_t nTimeoutMS);
+
+/*****	Functions	*****/
+
+
+#endif
+
@@ -25,24 +25,46 @@ eNetReturn_t RasPiTCPServCloseSocket(sTCPServ_t *pTCPServ, sSocket_t *pSck);
 eNetReturn_t RasPiTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *sSocket_t);
 eNetReturn_t RasPiTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *sSocket_t, uint32_t nNumBytes, void *pData, uint32_t *pnBytesRecv);
 eNetReturn_t RasPiTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *sSocket_t, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nVecCnt, sNetVec_t *pVecs);
 eNetReturn_t RasPiTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nMillisec);
 
 eNetReturn_t RasPiTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t RasPiTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn);
+eNetReturn_t RasPiTCPClientConnectCheck(sTCPClient_t *pTCPClient);
 eNetReturn_t RasPiTCPClientClose(sTCPClient_t *pTCPClient);
 eNetReturn_t RasPiTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nNumBytes, void *pData, uint32_t *pnBytesRecv);
 eNetReturn_t RasPiTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs);
 eNetReturn_t RasPiTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec);
 
 eNetReturn_t RasPiUDPServBind(sUDPServ_t *pUDPServ, sConnInfo_t *pConn);
 eNetReturn_t RasPiUDPServCloseHost(sUDPServ_t *pUDPServ);
 eNetReturn_t RasPiUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
 eNetReturn_t RasPiUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData);
+eNetReturn_t RasPiUDPServSendV(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs);
+eNetReturn_t RasPiUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv);
+eNetReturn_t RasPiUDPServSendBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent);
+eNetReturn_t RasPiUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec);
 
 eNetReturn_t RasPiUDPClientSetServer(sUDPClient_t *pUDPClient, sConnInfo_t *pConn);
 eNetReturn_t RasPiUDPClientClose(sUDPClient_t *pUDPClient);
 eNetReturn_t RasPiUDPClientSend(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData);
 eNetReturn_t RasPiUDPClientReceive(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv);
 
+/**	@brief		Send a list of pieces through a socket with sendmsg()
+	@details	For streams the list is handed over RASPINET_MAXIOVEC pieces at a time
+		and partial writes are picked up where they stopped.  With an address the 
+		list is sent as a single datagram.
+	@param		nSocket		Socket to send through
+	@param		pAddr		Address to send the datagram to, NULL for a connected stream
+	@param		nVecCnt		Number of pieces in the list
+	@param		pVecs		List of pieces to send
+	@return		Net_Success if everything was sent, NetFail_BuffSize if a datagram has
+		too many pieces, or NetFail_Unknown if the socket reported an error
+	@ingroup	raspinetwork
+*/
+eNetReturn_t RasPiSocketSendV(int32_t nSocket, struct sockaddr_in *pAddr, uint32_t nVecCnt, sNetVec_t *pVecs);
+
 /*****	Functions	*****/
 eNetReturn_t RasPiTCPServInitialize(sTCPServ_t *pTCPServ) {
 	//Always begin with default settigns
@@ -56,6 +78,7 @@ eNetReturn_t RasPiTCPServInitialize(sTCPServ_t *pTCPServ) {
 	pTCPServ->pfAcceptClient = &RasPiTCPServAcceptClient;
 	pTCPServ->pfReceive = &RasPiTCPServReceive;
 	pTCPServ->pfSend = &RasPiTCPServSend;
+	pTCPServ->pfSendV = &RasPiTCPServSendV;
 	pTCPServ->pfSetRecvTimeout = &RasPiTCPServSetRecvTimeOut;
 	
 	//Set other object values
@@ -132,9 +155,17 @@ eNetReturn_t RasPiTCPServAcceptClient(sTCPServ_t *pTCPServ, sSocket_t *pSck) {
 	while (pSck->nSocket== SOCKET_INVALID) {
 		pSck->nSocket= accept(pTCPServ->HostSck.nSocket, (struct sockaddr *)&sAddr, &nAddrSize);
 		//printf("Accept fail %d / %d\r\n", *sSocket_t, errno);
+		if (pSck->nSocket != SOCKET_INVALID) { //errno is only meaningful on failure
+			break;
+		}
+
 		if (errno == 9) { //Error 9: "Bad file number" means socket is not listening
 			return NetFail_SocketState;
 		}
+
+		if (errno != EINTR) { //Only a signal is worth retrying, anything else would spin
+			return NetFail_Unknown;
+		}
 	}
 	
 	//sAddr holds the client information
@@ -159,6 +190,9 @@ eNetReturn_t RasPiTCPServReceive(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t
 
 	if (nResult == SOCKET_INVALID) {
 		*pnBytesRecv = 0;
+	} else if ((nResult == 0) && (nDataBytes > 0)) { //Client closed the connection
+		*pnBytesRecv = 0;
+		return NetFail_SocketState;
 	} else {
 		*pnBytesRecv = nResult;
 	}
@@ -194,6 +228,10 @@ eNetReturn_t RasPiTCPServSend(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nD
 	return Net_Success;
 }
 
+eNetReturn_t RasPiTCPServSendV(sTCPServ_t *pTCPServ, sSocket_t *pSck, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	return RasPiSocketSendV(pSck->nSocket, NULL, nVecCnt, pVecs);
+}
+
 eNetReturn_t RasPiTCPServSetRecvTimeOut(sTCPServ_t *pTCPServ, sSocket_t *pClientSck, uint32_t nMillisec) {
 	struct timeval tTime;
 	int nResult, nKeepAlive;
@@ -220,9 +258,12 @@ eNetReturn_t RasPiTCPClientInitialize(sTCPClient_t *pTCPClient) {
 	//Update the function pointers to this implementation
 	pTCPClient->pfInitialize = &RasPiTCPClientInitialize;
 	pTCPClient->pfConnect = &RasPiTCPClientConnect;
+	pTCPClient->pfConnectStart = &RasPiTCPClientConnectStart;
+	pTCPClient->pfConnectCheck = &RasPiTCPClientConnectCheck;
 	pTCPClient->pfClose = &RasPiTCPClientClose;
 	pTCPClient->pfReceive = &RasPiTCPClientReceive;
 	pTCPClient->pfSend = &RasPiTCPClientSend;
+	pTCPClient->pfSendV = &RasPiTCPClientSendV;
 	pTCPClient->pfSetRecvTimeout = &RasPiTCPClientSetRecvTimeOut;
 	
 	//Set other object values
@@ -270,6 +311,97 @@ eNetReturn_t RasPiTCPClientConnect(sTCPClient_t *pTCPClient, sConnInfo_t *pConn)
 	return Net_Success;
 }
 
+eNetReturn_t RasPiTCPClientConnectStart(sTCPClient_t *pTCPClient, sConnInfo_t *pConn) {
+	struct sockaddr_in sAddr;
+	
+	if (pTCPClient->Sck.nSocket != SOCKET_INVALID) { //Socket appears open, close it
+		RasPiTCPClientClose(pTCPClient);
+	}
+	
+	//Create a client socket that won't wait on the connection
+	pTCPClient->Sck.nSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	pTCPClient->Sck.Conn.Addr.nNetLong = pConn->Addr.nNetLong;
+	pTCPClient->Sck.Conn.Port = pConn->Port;
+	
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_Unknown; //errno may hold more information
+	}
+	
+	sAddr.sin_port = htons(pConn->Port);
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_addr.s_addr = pConn->Addr.nNetLong;
+	
+	if (connect(pTCPClient->Sck.nSocket, (struct sockaddr *)&sAddr, sizeof(struct sockaddr_in)) == SOCKET_INVALID) {
+		if (errno == EINPROGRESS) {
+			return NetWarn_InProgress;
+		}
+		
+		RasPiTCPClientClose(pTCPClient);
+		if (errno == ECONNREFUSED) {
+			return NetFail_ConnRefuse;
+		} else {
+			return NetFail_Unknown;
+		}
+	}
+	
+	//Connected already, the rest of the functions expect the socket to wait
+	fcntl(pTCPClient->Sck.nSocket, F_SETFL, fcntl(pTCPClient->Sck.nSocket, F_GETFL) & ~O_NONBLOCK);
+	
+	return Net_Success;
+}
+
+eNetReturn_t RasPiTCPClientConnectCheck(sTCPClient_t *pTCPClient) {
+	struct sockaddr_in sAddr;
+	socklen_t nLen;
+	struct pollfd PollSck;
+	int nFlags, nErr;
+	
+	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) {
+		return NetFail_SocketState;
+	}
+	
+	//A failed connection leaves its reason in the socket error
+	nLen = sizeof(nErr);
+	if (getsockopt(pTCPClient->Sck.nSocket, SOL_SOCKET, SO_ERROR, &nErr, &nLen) == SOCKET_INVALID) {
+		return NetFail_Unknown;
+	}
+	
+	if (nErr == ECONNREFUSED) {
+		return NetFail_ConnRefuse;
+	} else if (nErr != 0) {
+		return NetFail_SocketState;
+	}
+	
+	//No peer yet means the connection is still being made
+	nLen = sizeof(sAddr);
+	if (getpeername(pTCPClient->Sck.nSocket, (struct sockaddr *)&sAddr, &nLen) == SOCKET_INVALID) {
+		if (errno == ENOTCONN) {
+			return NetWarn_InProgress;
+		}
+		
+		return NetFail_SocketState;
+	}
+	
+	//Connected, make sure the server hasn't closed it
+	PollSck.fd = pTCPClient->Sck.nSocket;
+	PollSck.events = POLLRDHUP;
+	PollSck.revents = 0;
+	
+	if (poll(&PollSck, 1, 0) > 0) {
+		if ((PollSck.revents & (POLLRDHUP | POLLHUP | POLLERR)) != 0) {
+			return NetFail_SocketState;
+		}
+	}
+	
+	//The rest of the functions expect the socket to wait
+	nFlags = fcntl(pTCPClient->Sck.nSocket, F_GETFL);
+	if ((nFlags & O_NONBLOCK) != 0) {
+		fcntl(pTCPClient->Sck.nSocket, F_SETFL, nFlags & ~O_NONBLOCK);
+	}
+	
+	return Net_Success;
+}
+
 eNetReturn_t RasPiTCPClientClose(sTCPClient_t *pTCPClient) {
 	if (pTCPClient->Sck.nSocket == SOCKET_INVALID) { //Socket appears open, close it
 		return Net_Success;
@@ -287,14 +419,22 @@ eNetReturn_t RasPiTCPClientReceive(sTCPClient_t *pTCPClient, uint32_t nDataBytes
 	int nResult;
 	
 	nResult = recv(pTCPClient->Sck.nSocket, pData, nDataBytes, 0);
-	if (nResult == SOCKET_INVALID) {
+	//errno of EAGAIN means try again, or request timed out
+	if ((nResult == SOCKET_INVALID) && (errno != EAGAIN)) {
 		*pnBytesRecv = 0;
 		
 		//errno has the failure code
 		return NetFail_Unknown;
 	}
 	
-	*pnBytesRecv = nResult;
+	if (nResult == SOCKET_INVALID) {
+		*pnBytesRecv = 0;
+	} else if ((nResult == 0) && (nDataBytes > 0)) { //Server closed the connection
+		*pnBytesRecv = 0;
+		return NetFail_SocketState;
+	} else {
+		*pnBytesRecv = nResult;
+	}
 	
 	if (*pnBytesRecv < nDataBytes) {
 		return NetWarn_EndOfData;
@@ -315,6 +455,10 @@ eNetReturn_t RasPiTCPClientSend(sTCPClient_t *pTCPClient, uint32_t nDataBytes, v
 	return Net_Success;
 }
 
+eNetReturn_t RasPiTCPClientSendV(sTCPClient_t *pTCPClient, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	return RasPiSocketSendV(pTCPClient->Sck.nSocket, NULL, nVecCnt, pVecs);
+}
+
 eNetReturn_t RasPiTCPClientSetRecvTimeOut(sTCPClient_t *pTCPClient, uint32_t nMillisec) {
 	struct timeval tTime;
 	int nResult;
@@ -346,6 +490,10 @@ eNetReturn_t RasPiUDPServInitialize(sUDPServ_t *pUDPServ) {
 	pUDPServ->pfCloseHost = &RasPiUDPServCloseHost;
 	pUDPServ->pfReceive = &RasPiUDPServReceive;
 	pUDPServ->pfSend = &RasPiUDPServSend;
+	pUDPServ->pfSendV = &RasPiUDPServSendV;
+	pUDPServ->pfReceiveBatch = &RasPiUDPServReceiveBatch;
+	pUDPServ->pfSendBatch = &RasPiUDPServSendBatch;
+	pUDPServ->pfSetRecvTimeout = &RasPiUDPServSetRecvTimeOut;
 	
 	return Net_Success;
 }
@@ -393,12 +541,19 @@ eNetReturn_t RasPiUDPServCloseHost(sUDPServ_t *pUDPServ) {
 
 eNetReturn_t RasPiUDPServReceive(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
 	struct sockaddr_in sAddr;
-	int nSize, nAddrLen;
+	int nSize;
+	socklen_t nAddrLen = sizeof(struct sockaddr_in);
 	
 	//Listen for incoming data
 	nSize = recvfrom(pUDPServ->HostSck.nSocket, pData, nDataBytes, 0, (struct sockaddr *)&sAddr, &nAddrLen);
 	if (nSize == SOCKET_INVALID) {
 		*pnBytesRecv = 0;
+		
+		//errno of EAGAIN means the request timed out
+		if (errno == EAGAIN) {
+			return Net_Success;
+		}
+		
 		return NetFail_Unknown; //errno has code
 	}
 	
@@ -427,6 +582,130 @@ eNetReturn_t RasPiUDPServSend(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t
 	return Net_Success;
 }
 
+eNetReturn_t RasPiUDPServSendV(sUDPServ_t *pUDPServ, sConnInfo_t *pConn, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	struct sockaddr_in sAddr;
+	
+	sAddr.sin_port = htons(pConn->Port);
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_addr.s_addr = pConn->Addr.nNetLong;
+	
+	return RasPiSocketSendV(pUDPServ->HostSck.nSocket, &sAddr, nVecCnt, pVecs);
+}
+
+eNetReturn_t RasPiUDPServReceiveBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsRecv) {
+	struct mmsghdr aMsgs[RASPINET_MAXBATCH];
+	struct iovec aIOVec[RASPINET_MAXBATCH];
+	struct sockaddr_in aAddr[RASPINET_MAXBATCH];
+	uint32_t nCtr;
+	int nResult;
+	
+	*pnPktsRecv = 0;
+	if (nPktCnt > RASPINET_MAXBATCH) {
+		nPktCnt = RASPINET_MAXBATCH;
+	}
+	
+	//Point each message at its packet's buffer
+	memset(aMsgs, 0, sizeof(struct mmsghdr) * nPktCnt);
+	for (nCtr = 0; nCtr < nPktCnt; nCtr++) {
+		aIOVec[nCtr].iov_base = pPkts[nCtr].pData;
+		aIOVec[nCtr].iov_len = pPkts[nCtr].nBuffSize;
+		
+		aMsgs[nCtr].msg_hdr.msg_name = &(aAddr[nCtr]);
+		aMsgs[nCtr].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+		aMsgs[nCtr].msg_hdr.msg_iov = &(aIOVec[nCtr]);
+		aMsgs[nCtr].msg_hdr.msg_iovlen = 1;
+	}
+	
+	//Wait for one datagram, then take whatever else is waiting
+	nResult = recvmmsg(pUDPServ->HostSck.nSocket, aMsgs, nPktCnt, MSG_WAITFORONE, NULL);
+	if (nResult == SOCKET_INVALID) {
+		//errno of EAGAIN means the request timed out, same as a single receive
+		if (errno == EAGAIN) {
+			return Net_Success;
+		}
+		
+		return NetFail_Unknown; //errno has code
+	}
+	
+	for (nCtr = 0; nCtr < (uint32_t)nResult; nCtr++) {
+		pPkts[nCtr].nBytes = aMsgs[nCtr].msg_len;
+		pPkts[nCtr].Conn.Addr.nNetLong = aAddr[nCtr].sin_addr.s_addr;
+		pPkts[nCtr].Conn.Port = ntohs(aAddr[nCtr].sin_port);
+	}
+	
+	*pnPktsRecv = nResult;
+	
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUDPServSendBatch(sUDPServ_t *pUDPServ, uint32_t nPktCnt, sNetPacket_t *pPkts, uint32_t *pnPktsSent) {
+	struct mmsghdr aMsgs[RASPINET_MAXBATCH];
+	struct iovec aIOVec[RASPINET_MAXBATCH];
+	struct sockaddr_in aAddr[RASPINET_MAXBATCH];
+	sNetPacket_t *pPkt;
+	uint32_t nCtr, nCnt;
+	int nResult;
+	
+	*pnPktsSent = 0;
+	while (*pnPktsSent < nPktCnt) {
+		nCnt = nPktCnt - *pnPktsSent;
+		if (nCnt > RASPINET_MAXBATCH) {
+			nCnt = RASPINET_MAXBATCH;
+		}
+		
+		//Fill in a message for each packet still to go
+		memset(aMsgs, 0, sizeof(struct mmsghdr) * nCnt);
+		for (nCtr = 0; nCtr < nCnt; nCtr++) {
+			pPkt = &(pPkts[*pnPktsSent + nCtr]);
+			
+			aAddr[nCtr].sin_port = htons(pPkt->Conn.Port);
+			aAddr[nCtr].sin_family = AF_INET;
+			aAddr[nCtr].sin_addr.s_addr = pPkt->Conn.Addr.nNetLong;
+			
+			aIOVec[nCtr].iov_base = pPkt->pData;
+			aIOVec[nCtr].iov_len = pPkt->nBytes;
+			
+			aMsgs[nCtr].msg_hdr.msg_name = &(aAddr[nCtr]);
+			aMsgs[nCtr].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+			aMsgs[nCtr].msg_hdr.msg_iov = &(aIOVec[nCtr]);
+			aMsgs[nCtr].msg_hdr.msg_iovlen = 1;
+		}
+		
+		//The kernel may take fewer than asked, go around for the rest
+		nResult = sendmmsg(pUDPServ->HostSck.nSocket, aMsgs, nCnt, 0);
+		if (nResult == SOCKET_INVALID) {
+			if (errno == EINTR) {
+				continue;
+			}
+			
+			return NetFail_Unknown; //errno has code
+		}
+		
+		*pnPktsSent += nResult;
+	}
+	
+	return Net_Success;
+}
+
+eNetReturn_t RasPiUDPServSetRecvTimeOut(sUDPServ_t *pUDPServ, uint32_t nMillisec) {
+	struct timeval tTime;
+	int nResult;
+	
+	//Convert the time requested into OS value
+	tTime.tv_sec = nMillisec / 1000;
+	tTime.tv_usec = (nMillisec % 1000) * 1000;
+	
+	//Set the timeout duration
+	nResult = setsockopt(pUDPServ->HostSck.nSocket, SOL_SOCKET, SO_RCVTIMEO, (void *)&tTime, sizeof(struct timeval));
+	
+	if (nResult != 0) {
+		//errno has error code
+		return NetFail_Unknown;
+	}
+	
+	return Net_Success;
+}
+
 eNetReturn_t RasPiUDPClientInitialize(sUDPClient_t *pUDPClient) {
 	pUDPClient->Sck.nSocket = SOCKET_INVALID;
 	pUDPClient->Sck.Conn.Addr.nNetLong = 0;
@@ -475,7 +754,8 @@ eNetReturn_t RasPiUDPClientSend(sUDPClient_t *pUDPClient, uint32_t nDataBytes, v
 
 eNetReturn_t RasPiUDPClientReceive(sUDPClient_t *pUDPClient, uint32_t nDataBytes, void *pData, uint32_t *pnBytesRecv) {
 	struct sockaddr_in sAddr;
-	int nSize, nAddrLen;
+	int nSize;
+	socklen_t nAddrLen = sizeof(struct sockaddr_in);
 	Port_t nPort;
 	
 	//Listen for incoming data
@@ -498,4 +778,65 @@ eNetReturn_t RasPiUDPClientReceive(sUDPClient_t *pUDPClient, uint32_t nDataBytes
 	}
 	
 	return Net_Success;
-}
\ No newline at end of file
+}
+
+eNetReturn_t RasPiSocketSendV(int32_t nSocket, struct sockaddr_in *pAddr, uint32_t nVecCnt, sNetVec_t *pVecs) {
+	struct iovec aIOVec[RASPINET_MAXIOVEC];
+	struct msghdr Msg;
+	uint32_t nVec, nCnt, nOffset;
+	ssize_t nSent;
+	
+	memset(&Msg, 0, sizeof(struct msghdr));
+	if (pAddr != NULL) {
+		if (nVecCnt > RASPINET_MAXIOVEC) { //A datagram must go in one call
+			return NetFail_BuffSize;
+		}
+		
+		Msg.msg_name = pAddr;
+		Msg.msg_namelen = sizeof(struct sockaddr_in);
+	}
+	
+	nVec = 0; //First piece not completely sent
+	nOffset = 0; //Bytes of that piece already sent
+	while (true) {
+		//List the pieces starting where the last call stopped
+		for (nCnt = 0; (nCnt < RASPINET_MAXIOVEC) && (nVec + nCnt < nVecCnt); nCnt++) {
+			aIOVec[nCnt].iov_base = pVecs[nVec + nCnt].pData;
+			aIOVec[nCnt].iov_len = pVecs[nVec + nCnt].nBytes;
+		}
+		
+		if (nCnt > 0) {
+			aIOVec[0].iov_base = ((uint8_t *)aIOVec[0].iov_base) + nOffset;
+			aIOVec[0].iov_len -= nOffset;
+		}
+		
+		Msg.msg_iov = aIOVec;
+		Msg.msg_iovlen = nCnt;
+		
+		nSent = sendmsg(nSocket, &Msg, 0);
+		if (nSent < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			
+			return NetFail_Unknown; //errno has code
+		}
+		
+		if (pAddr != NULL) { //Datagrams are never partially sent
+			return Net_Success;
+		}
+		
+		//Step past the pieces the socket took
+		while ((nVec < nVecCnt) && ((uint32_t)nSent >= pVecs[nVec].nBytes - nOffset)) {
+			nSent -= pVecs[nVec].nBytes - nOffset;
+			nOffset = 0;
+			nVec++;
+		}
+		
+		if (nVec >= nVecCnt) {
+			return Net_Success;
+		}
+		
+		nOffset += nSent;
+	}
+}
@@ -13,10 +13,19 @@
 	#define __RASPINETWORK_H
 
 /*****	Includes	*****/
+	#ifndef _GNU_SOURCE
+		#define _GNU_SOURCE	//Needed for recvmmsg(), sendmmsg(), and POLLRDHUP
+	#endif
+	
 	#include <stdio.h>
+	#include <stdbool.h>
+	#include <string.h>
 	
 	#include <unistd.h>
+	#include <fcntl.h>
+	#include <poll.h>
     #include <sys/socket.h>
+	#include <sys/uio.h>
 	#include <sys/time.h>
     #include <netinet/in.h>
 	#include <errno.h>
@@ -27,14 +36,14 @@
 	/**	@brief		Capabilities of the Raspberry Pi implementation of the TCP Server
 		@ingroup	raspinetwork
 	*/
-	#define TCPSERV_CAPS	(TCPServ_Bind | TCPServ_CloseHost | TCPServ_AcceptConn | TCPServ_CloseClient | TCPServ_Receive | TCPServ_Send)
+	#define TCPSERV_CAPS	(TCPServ_Bind | TCPServ_CloseHost | TCPServ_AcceptConn | TCPServ_CloseClient | TCPServ_Receive | TCPServ_Send | TCPServ_SendV)
 	
 	/**	@brief		Capabilities of the Raspberry Pi implementation of the TCP Client
 		@ingroup	raspinetwork
 	*/
-	#define TCPCLIENT_CAPS	(TCPClient_Connect | TCPClient_Close | TCPClient_Receive | TCPClient_Send)
+	#define TCPCLIENT_CAPS	(TCPClient_Connect | TCPClient_Close | TCPClient_Receive | TCPClient_Send | TCPClient_SendV | TCPClient_ConnStart)
 	
-	#define UDPSERV_CAPS	(UDPServ_Bind | UDPServ_CloseHost | UDPServ_Receive | UDPServ_Send)
+	#define UDPSERV_CAPS	(UDPServ_Bind | UDPServ_CloseHost | UDPServ_Receive | UDPServ_Send | UDPServ_SendV | UDPServ_RecvBatch | UDPServ_SendBatch)
 	
 	#define UDPCLIENT_CAPS	(UDPClient_SetServ | UDPClient_Send | UDPClient_Receive)
 	
@@ -51,6 +60,24 @@
 	#define UDPSERV_INIT	RasPiUDPServInitialize
 	
 	#define UDPCLIENT_INIT	RasPiUDPClientInitialize
+	
+	#ifndef RASPINET_MAXIOVEC
+		/**	@brief		Most pieces handed to the kernel in one gathered send
+			@details	Longer lists are sent in several calls, a UDP datagram must
+				fit in one.
+			@ingroup	raspinetwork
+		*/
+		#define RASPINET_MAXIOVEC	64
+	#endif
+	
+	#ifndef RASPINET_MAXBATCH
+		/**	@brief		Most datagrams handed to the kernel in one batch call
+			@details	Larger batches are sent in several calls, receives stop at
+				this many.
+			@ingroup	raspinetwork
+		*/
+		#define RASPINET_MAXBATCH	64
+	#endif
 
 /*****	Definitions	*****/
 
@@ -41,6 +41,8 @@
 	eSPIReturn_t RasPiSPIEndTransfer(sSPIIface_t *pIface);
 	
 	eSPIReturn_t RasPiSPITransferByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t *pnReadByte);
+	
+	eSPIReturn_t RasPiSPITransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes);
 
 /*****	Functions	*****/
 
@@ -64,6 +66,7 @@ eSPIReturn_t RasPiSPIPortInitialize(sSPIIface_t *pIface, void *pHWInfo, uint32_t
 	pIface->pfBeginTransfer = &RasPiSPIBeginTransfer;
 	pIface->pfEndTransfer = &RasPiSPIEndTransfer;
 	pIface->pfTransferByte = &RasPiSPITransferByte;
+	pIface->pfTransferBlock = &RasPiSPITransferBlock;
 	
 	//Set up the hardware
 	pSPI->SPIFile = open(pSPI->pcFilePath, O_RDWR);
@@ -183,4 +186,43 @@ eSPIReturn_t RasPiSPITransferByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_
 	}
 	
 	return SPI_Success;
-}
\ No newline at end of file
+}
+
+eSPIReturn_t RasPiSPITransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes) {
+	sRasPiSPIHWInfo_t *pSPI = (sRasPiSPIHWInfo_t *)(pIface->pHWInfo);
+	struct spi_ioc_transfer TranInfo;
+	int32_t nResult;
+	uint32_t nOffset, nChunk;
+	
+	for (nOffset = 0; nOffset < nBytes; nOffset += nChunk) {
+		nChunk = nBytes - nOffset;
+		if (nChunk > RASPISPI_MAXBLOCK) {
+			nChunk = RASPISPI_MAXBLOCK;
+		}
+		
+		memset(&TranInfo, 0, sizeof(struct spi_ioc_transfer));
+		
+		//A missing buffer is left 0, spidev then sends zeros or discards what is read
+		if (pSendBytes != NULL) {
+			TranInfo.tx_buf = (uintptr_t)(pSendBytes + nOffset);
+		}
+		
+		if (pReadBytes != NULL) {
+			TranInfo.rx_buf = (uintptr_t)(pReadBytes + nOffset);
+		}
+		
+		TranInfo.len = nChunk;
+		TranInfo.bits_per_word = RASPISPI_BITSPERWORD;
+		TranInfo.tx_nbits = 1;
+		TranInfo.rx_nbits = 1;
+		
+		//Chip select is handled by the caller, so the pieces stay in one frame
+		nResult = ioctl(pSPI->SPIFile, SPI_IOC_MESSAGE(1), &TranInfo);
+		if (nResult <= 0) {
+			pSPI->nLastErr = errno;
+			return SPIFail_Unknown;
+		}
+	}
+	
+	return SPI_Success;
+}
@@ -1,6 +1,6 @@
 /**	@defgroup	spiraspberrypi
 	@brief		SPI General Interface implementation for Raspberry Pi
-	@details	v0.2
+	@details	v0.3
 	#Description
 	
 	#File Information
@@ -39,12 +39,19 @@
 	/**	@brief		SPI 1 hardware object
 		@ingroup	spiraspberrypi
 	*/
-	#define SPI_1_CAPS			(SPI_Configure | SPI_BeginTransfer | SPI_EndTransfer | SPI_BiDir1Byte)
+	#define SPI_1_CAPS			(SPI_Configure | SPI_BeginTransfer | SPI_EndTransfer | SPI_BiDir1Byte | SPI_BiDirBlock)
 	
 	/**	@brief		Number of bits included in each word of the SPI transfer
 		@ingroup	spiraspberrypi
 	*/
 	#define RASPISPI_BITSPERWORD	8
+	
+	/**	@brief		Most bytes handed to the kernel in one transfer
+		@details	The spidev driver refuses transfers larger than its bufsiz
+			module parameter, which defaults to 4096.  Larger blocks are split.
+		@ingroup	spiraspberrypi
+	*/
+	#define RASPISPI_MAXBLOCK		4096
 
 /*****	Definitions	*****/
 	/**	@brief		Structure holding information on the SPI Hardware
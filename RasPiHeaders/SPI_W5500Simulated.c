@@ -0,0 +1,694 @@
+/**	File:	SPI_W5500Simulated.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "SPI_W5500Simulated.h"
+
+/*****	Definitions	*****/
+	//Frame control byte fields
+	#define W5500SIM_CTRLSOCKET		5		/* Right shift to the socket number */
+	#define W5500SIM_CTRLBLOCK		0x18	/* Mask of the block within the socket */
+	#define W5500SIM_CTRLCOMMON		0xF8	/* Mask of all block select bits, 0 for common registers */
+	#define W5500SIM_CTRLWRITE		0x04	/* Set for a write, clear for a read */
+
+	#define W5500SIM_BLOCKREGS		0x08
+	#define W5500SIM_BLOCKTX		0x10
+	#define W5500SIM_BLOCKRX		0x18
+
+	//Common registers
+	#define W5500SIM_CMNMODE		0x00
+	#define W5500SIM_CMNSOCKINT		0x17
+	#define W5500SIM_CMNSOCKMASK	0x18
+	#define W5500SIM_CMNPHYCFG		0x2E
+	#define W5500SIM_CMNVERSION		0x39
+
+	//Socket registers
+	#define W5500SIM_SCKMODE		0x00
+	#define W5500SIM_SCKCOMMAND		0x01
+	#define W5500SIM_SCKINT			0x02
+	#define W5500SIM_SCKSTATUS		0x03
+	#define W5500SIM_SCKDESTIP		0x0C
+	#define W5500SIM_SCKDESTPORT	0x10
+	#define W5500SIM_SCKRXSIZE		0x1E
+	#define W5500SIM_SCKTXSIZE		0x1F
+	#define W5500SIM_SCKTXFREE		0x20
+	#define W5500SIM_SCKTXREAD		0x22
+	#define W5500SIM_SCKTXWRITE		0x24
+	#define W5500SIM_SCKRXRECV		0x26
+	#define W5500SIM_SCKRXREAD		0x28
+	#define W5500SIM_SCKRXWRITE		0x2A
+	#define W5500SIM_SCKINTMASK		0x2C
+
+	//Values of the registers the model acts on
+	#define W5500SIM_MODERESET		0x80
+	#define W5500SIM_PROTMASK		0x0F
+	#define W5500SIM_PROTTCP		0x01
+	#define W5500SIM_PROTUDP		0x02
+
+	#define W5500SIM_CMDOPEN		0x01
+	#define W5500SIM_CMDLISTEN		0x02
+	#define W5500SIM_CMDCONNECT		0x04
+	#define W5500SIM_CMDDISCON		0x08
+	#define W5500SIM_CMDCLOSE		0x10
+	#define W5500SIM_CMDSEND		0x20
+	#define W5500SIM_CMDRECV		0x40
+
+	#define W5500SIM_INTSENDOK		0x10
+	#define W5500SIM_INTTIMEOUT		0x08
+	#define W5500SIM_INTRECV		0x04
+	#define W5500SIM_INTDISCON		0x02
+	#define W5500SIM_INTCONNECT		0x01
+	#define W5500SIM_INTALL			0xFF	/* Socket interrupt mask after reset */
+
+	#define W5500SIM_STATCLOSED		0x00
+	#define W5500SIM_STATINIT		0x13
+	#define W5500SIM_STATLISTEN		0x14
+	#define W5500SIM_STATESTABLISH	0x17
+	#define W5500SIM_STATCLOSEWAIT	0x1C
+	#define W5500SIM_STATUDP		0x22
+
+	#define W5500SIM_UDPHEADER		8		/* Bytes ahead of each datagram in the receive buffer */
+
+	#define W5500SIM_VERSION		0x04
+	#define W5500SIM_PHYLINKUP		0xBF	/* Link up at 100 Mbps full duplex, all capabilities */
+	#define W5500SIM_DEFAULTBUFF	2		/* KB of each buffer each socket gets after reset */
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	eSPIReturn_t W5500SimBeginTransfer(sSPIIface_t *pIface);
+
+	eSPIReturn_t W5500SimEndTransfer(sSPIIface_t *pIface);
+
+	eSPIReturn_t W5500SimTransferByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t *pnReadByte);
+
+	eSPIReturn_t W5500SimTransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes);
+
+	eSPICapabilities_t W5500SimGetCapabilities(sSPIIface_t *pIface);
+
+	uint8_t W5500SimFrameByte(sW5500SimInfo_t *pSim, uint8_t nSendByte);
+
+	uint8_t *W5500SimLocate(sW5500SimInfo_t *pSim, uint8_t nControl, uint16_t nAddress);
+
+	void W5500SimWriteReg(sW5500SimInfo_t *pSim, uint8_t nControl, uint16_t nAddress, uint8_t nValue);
+
+	void W5500SimCommand(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t nCommand);
+
+	void W5500SimReset(sW5500SimInfo_t *pSim);
+
+	void W5500SimRaise(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t nFlags);
+
+	void W5500SimUpdateInt(sW5500SimInfo_t *pSim);
+
+	uint32_t W5500SimBuffBase(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t nSizeReg);
+
+	uint32_t W5500SimRXFree(sW5500SimInfo_t *pSim, uint8_t nSocket);
+
+	void W5500SimRXPut(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t *pData, uint32_t nBytes);
+
+	void W5500SimTXDrain(sW5500SimInfo_t *pSim, uint8_t nSocket);
+
+	uint16_t W5500SimGet16(const uint8_t *pReg);
+
+	void W5500SimSet16(uint8_t *pReg, uint16_t nValue);
+
+/*****	Functions	*****/
+eSPIReturn_t W5500SimPortInitialize(sSPIIface_t *pIface, void *pHWInfo, uint32_t nBusClockFreq, eSPIDataOrder_t eDataOrder, eSPIMode_t eMode) {
+	sW5500SimInfo_t *pSim = (sW5500SimInfo_t *)pHWInfo;
+
+	if (pSim == NULL) {
+		return SPIFail_Unknown;
+	}
+
+	SPIInterfaceInitialize(pIface);
+
+	pIface->pfInitialise = &W5500SimPortInitialize;
+	pIface->pfBeginTransfer = &W5500SimBeginTransfer;
+	pIface->pfEndTransfer = &W5500SimEndTransfer;
+	pIface->pfTransferByte = &W5500SimTransferByte;
+	pIface->pfTransferBlock = &W5500SimTransferBlock;
+	pIface->pfGetCapabilities = &W5500SimGetCapabilities;
+
+	pIface->nBusClockFreq = nBusClockFreq;
+	pIface->eDataOrder = eDataOrder;
+	pIface->eMode = eMode;
+	pIface->pHWInfo = pHWInfo;
+
+	memset(pSim, 0, sizeof(sW5500SimInfo_t));
+	W5500SimReset(pSim);
+
+	return SPI_Success;
+}
+
+void W5500SimAttachInterrupt(sW5500SimInfo_t *pSim, sGPIOSimInfo_t *pPins, GPIOID_t nPin) {
+	pSim->pIntPins = pPins;
+	pSim->nIntPin = nPin;
+
+	//Start from the idle level so the first assert is an edge
+	GPIOSimSetInput(pPins, nPin, true);
+	W5500SimUpdateInt(pSim);
+}
+
+bool W5500SimPeerConnect(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t aAddr[4], uint16_t nPort) {
+	sW5500SimSocket_t *pSck;
+
+	if (nSocket >= W5500SIM_NUMSOCKETS) {
+		return false;
+	}
+
+	pSck = &(pSim->aSockets[nSocket]);
+	if (pSck->aRegs[W5500SIM_SCKSTATUS] != W5500SIM_STATLISTEN) {
+		return false;
+	}
+
+	memcpy(&(pSck->aRegs[W5500SIM_SCKDESTIP]), aAddr, 4);
+	W5500SimSet16(&(pSck->aRegs[W5500SIM_SCKDESTPORT]), nPort);
+
+	pSck->aRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATESTABLISH;
+	W5500SimRaise(pSim, nSocket, W5500SIM_INTCONNECT);
+	W5500SimUpdateInt(pSim);
+
+	return true;
+}
+
+bool W5500SimPeerClose(sW5500SimInfo_t *pSim, uint8_t nSocket) {
+	sW5500SimSocket_t *pSck;
+
+	if (nSocket >= W5500SIM_NUMSOCKETS) {
+		return false;
+	}
+
+	pSck = &(pSim->aSockets[nSocket]);
+	if (pSck->aRegs[W5500SIM_SCKSTATUS] != W5500SIM_STATESTABLISH) {
+		return false;
+	}
+
+	pSck->aRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATCLOSEWAIT;
+	W5500SimRaise(pSim, nSocket, W5500SIM_INTDISCON);
+	W5500SimUpdateInt(pSim);
+
+	return true;
+}
+
+uint32_t W5500SimPeerWrite(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t *pData, uint32_t nBytes) {
+	uint32_t nFree;
+
+	if (nSocket >= W5500SIM_NUMSOCKETS) {
+		return 0;
+	}
+
+	if (pSim->aSockets[nSocket].aRegs[W5500SIM_SCKSTATUS] != W5500SIM_STATESTABLISH) {
+		return 0;
+	}
+
+	nFree = W5500SimRXFree(pSim, nSocket);
+	if (nBytes > nFree) { //Only take what fits, as the window would allow
+		nBytes = nFree;
+	}
+
+	if (nBytes > 0) {
+		W5500SimRXPut(pSim, nSocket, pData, nBytes);
+		W5500SimRaise(pSim, nSocket, W5500SIM_INTRECV);
+		W5500SimUpdateInt(pSim);
+	}
+
+	return nBytes;
+}
+
+uint32_t W5500SimPeerSendTo(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t aAddr[4], uint16_t nPort, const uint8_t *pData, uint32_t nBytes) {
+	uint8_t aHeader[W5500SIM_UDPHEADER];
+
+	if (nSocket >= W5500SIM_NUMSOCKETS) {
+		return 0;
+	}
+
+	if (pSim->aSockets[nSocket].aRegs[W5500SIM_SCKSTATUS] != W5500SIM_STATUDP) {
+		return 0;
+	}
+
+	if ((nBytes > 0xFFFF) || (nBytes + W5500SIM_UDPHEADER > W5500SimRXFree(pSim, nSocket))) {
+		return 0; //The part drops datagrams that do not fit
+	}
+
+	memcpy(aHeader, aAddr, 4);
+	W5500SimSet16(&(aHeader[4]), nPort);
+	W5500SimSet16(&(aHeader[6]), (uint16_t)nBytes);
+
+	W5500SimRXPut(pSim, nSocket, aHeader, W5500SIM_UDPHEADER);
+	W5500SimRXPut(pSim, nSocket, pData, nBytes);
+	W5500SimRaise(pSim, nSocket, W5500SIM_INTRECV);
+	W5500SimUpdateInt(pSim);
+
+	return nBytes;
+}
+
+uint32_t W5500SimPeerRead(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t *pData, uint32_t nBytes) {
+	sW5500SimSocket_t *pSck;
+	uint32_t nCtr;
+
+	if (nSocket >= W5500SIM_NUMSOCKETS) {
+		return 0;
+	}
+
+	pSck = &(pSim->aSockets[nSocket]);
+	if (nBytes > pSck->nPeerCnt) {
+		nBytes = pSck->nPeerCnt;
+	}
+
+	for (nCtr = 0; nCtr < nBytes; nCtr++) {
+		pData[nCtr] = pSck->aPeer[pSck->nPeerHead];
+		pSck->nPeerHead = (pSck->nPeerHead + 1) % W5500SIM_PEERBUFF;
+	}
+
+	pSck->nPeerCnt -= nBytes;
+
+	if (pSck->bSending == true) { //Room for a send that was held up
+		W5500SimTXDrain(pSim, nSocket);
+		W5500SimUpdateInt(pSim);
+	}
+
+	return nBytes;
+}
+
+eSPIReturn_t W5500SimBeginTransfer(sSPIIface_t *pIface) {
+	sW5500SimInfo_t *pSim = (sW5500SimInfo_t *)pIface->pHWInfo;
+
+	pSim->nFramePos = 0;
+	pSim->nFrames += 1;
+
+	return SPI_Success;
+}
+
+eSPIReturn_t W5500SimEndTransfer(sSPIIface_t *pIface) {
+	//Any partial header is dropped when the next frame begins
+	return SPI_Success;
+}
+
+eSPIReturn_t W5500SimTransferByte(sSPIIface_t *pIface, uint8_t nSendByte, uint8_t *pnReadByte) {
+	sW5500SimInfo_t *pSim = (sW5500SimInfo_t *)pIface->pHWInfo;
+
+	pSim->nBusCalls += 1;
+	*pnReadByte = W5500SimFrameByte(pSim, nSendByte);
+
+	return SPI_Success;
+}
+
+eSPIReturn_t W5500SimTransferBlock(sSPIIface_t *pIface, const uint8_t *pSendBytes, uint8_t *pReadBytes, uint32_t nBytes) {
+	sW5500SimInfo_t *pSim = (sW5500SimInfo_t *)pIface->pHWInfo;
+	uint32_t nCtr;
+	uint8_t nRead;
+
+	pSim->nBusCalls += 1;
+
+	for (nCtr = 0; nCtr < nBytes; nCtr++) {
+		if (pSendBytes != NULL) {
+			nRead = W5500SimFrameByte(pSim, pSendBytes[nCtr]);
+		} else {
+			nRead = W5500SimFrameByte(pSim, 0xFF);
+		}
+
+		if (pReadBytes != NULL) {
+			pReadBytes[nCtr] = nRead;
+		}
+	}
+
+	return SPI_Success;
+}
+
+eSPICapabilities_t W5500SimGetCapabilities(sSPIIface_t *pIface) {
+	return SPI_BeginTransfer | SPI_EndTransfer | SPI_BiDir1Byte | SPI_BiDirBlock;
+}
+
+uint8_t W5500SimFrameByte(sW5500SimInfo_t *pSim, uint8_t nSendByte) {
+	uint8_t *pCell;
+	uint8_t nRead = 0;
+
+	pSim->nBusBytes += 1;
+
+	switch (pSim->nFramePos) {
+		case 0: //Address high byte
+			pSim->nAddress = nSendByte << 8;
+			break;
+		case 1: //Address low byte
+			pSim->nAddress |= nSendByte;
+			break;
+		case 2: //Control byte
+			pSim->nControl = nSendByte;
+			break;
+		default: //Data, the address advances with each byte
+			if ((pSim->nControl & W5500SIM_CTRLWRITE) != 0) {
+				W5500SimWriteReg(pSim, pSim->nControl, pSim->nAddress, nSendByte);
+			} else {
+				pCell = W5500SimLocate(pSim, pSim->nControl, pSim->nAddress);
+				if (pCell != NULL) {
+					nRead = *pCell;
+				}
+			}
+
+			pSim->nAddress += 1;
+			break;
+	}
+
+	pSim->nFramePos += 1;
+
+	return nRead;
+}
+
+uint8_t *W5500SimLocate(sW5500SimInfo_t *pSim, uint8_t nControl, uint16_t nAddress) {
+	sW5500SimSocket_t *pSck;
+	uint8_t nSocket, nSizeReg;
+	uint32_t nSize;
+	uint8_t nCtr;
+
+	if ((nControl & W5500SIM_CTRLCOMMON) == 0) {
+		if (nAddress >= W5500SIM_COMMONREGS) {
+			return NULL;
+		}
+
+		if (nAddress == W5500SIM_CMNSOCKINT) { //Reflects which sockets have flags raised
+			pSim->aCommon[W5500SIM_CMNSOCKINT] = 0;
+			for (nCtr = 0; nCtr < W5500SIM_NUMSOCKETS; nCtr++) {
+				if (pSim->aSockets[nCtr].aRegs[W5500SIM_SCKINT] != 0) { //Flags are only raised where unmasked
+					pSim->aCommon[W5500SIM_CMNSOCKINT] |= 1 << nCtr;
+				}
+			}
+		}
+
+		return &(pSim->aCommon[nAddress]);
+	}
+
+	nSocket = nControl >> W5500SIM_CTRLSOCKET;
+	pSck = &(pSim->aSockets[nSocket]);
+
+	switch (nControl & W5500SIM_CTRLBLOCK) {
+		case W5500SIM_BLOCKREGS:
+			if (nAddress >= W5500SIM_SOCKETREGS) {
+				return NULL;
+			}
+
+			return &(pSck->aRegs[nAddress]);
+
+		case W5500SIM_BLOCKTX:
+		case W5500SIM_BLOCKRX:
+			if ((nControl & W5500SIM_CTRLBLOCK) == W5500SIM_BLOCKTX) {
+				nSizeReg = W5500SIM_SCKTXSIZE;
+			} else {
+				nSizeReg = W5500SIM_SCKRXSIZE;
+			}
+
+			nSize = pSck->aRegs[nSizeReg] * 1024;
+			if (nSize == 0) { //Socket was given no memory
+				return NULL;
+			}
+
+			//Offsets wrap within the socket's part of the memory
+			nSize = (W5500SimBuffBase(pSim, nSocket, nSizeReg) + (nAddress & (nSize - 1))) % W5500SIM_BUFFMEM;
+
+			if (nSizeReg == W5500SIM_SCKTXSIZE) {
+				return &(pSim->aTXMem[nSize]);
+			} else {
+				return &(pSim->aRXMem[nSize]);
+			}
+
+		default: //Reserved block
+			return NULL;
+	}
+}
+
+void W5500SimWriteReg(sW5500SimInfo_t *pSim, uint8_t nControl, uint16_t nAddress, uint8_t nValue) {
+	sW5500SimSocket_t *pSck;
+	uint8_t *pCell;
+	uint8_t nSocket;
+
+	if ((nControl & W5500SIM_CTRLCOMMON) == 0) { //Common registers
+		if ((nAddress == W5500SIM_CMNVERSION) || (nAddress == W5500SIM_CMNSOCKINT)) { //Read only
+			return;
+		}
+
+		if ((nAddress == W5500SIM_CMNMODE) && ((nValue & W5500SIM_MODERESET) != 0)) {
+			W5500SimReset(pSim);
+			W5500SimUpdateInt(pSim);
+			return;
+		}
+	} else if ((nControl & W5500SIM_CTRLBLOCK) == W5500SIM_BLOCKREGS) { //Socket registers
+		nSocket = nControl >> W5500SIM_CTRLSOCKET;
+		pSck = &(pSim->aSockets[nSocket]);
+
+		switch (nAddress) {
+			case W5500SIM_SCKCOMMAND:
+				W5500SimCommand(pSim, nSocket, nValue);
+				W5500SimUpdateInt(pSim);
+				return;
+
+			case W5500SIM_SCKINT: //Writing a 1 clears the flag
+				pSck->aRegs[W5500SIM_SCKINT] &= ~nValue;
+				W5500SimUpdateInt(pSim);
+				return;
+
+			case W5500SIM_SCKSTATUS:
+			case W5500SIM_SCKTXFREE:
+			case W5500SIM_SCKTXFREE + 1:
+			case W5500SIM_SCKTXREAD:
+			case W5500SIM_SCKTXREAD + 1:
+			case W5500SIM_SCKRXRECV:
+			case W5500SIM_SCKRXRECV + 1:
+			case W5500SIM_SCKRXWRITE:
+			case W5500SIM_SCKRXWRITE + 1:
+				return; //Read only
+
+			default:
+				break;
+		}
+	}
+
+	pCell = W5500SimLocate(pSim, nControl, nAddress);
+	if (pCell != NULL) {
+		*pCell = nValue;
+	}
+
+	if ((nAddress == W5500SIM_CMNSOCKMASK) || (nAddress == W5500SIM_SCKINTMASK)) { //Masks change what INTn shows
+		W5500SimUpdateInt(pSim);
+	}
+}
+
+void W5500SimCommand(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t nCommand) {
+	sW5500SimSocket_t *pSck = &(pSim->aSockets[nSocket]);
+	uint8_t *pRegs = pSck->aRegs;
+	uint16_t nRead;
+
+	switch (nCommand) {
+		case W5500SIM_CMDOPEN:
+			if ((pRegs[W5500SIM_SCKMODE] & W5500SIM_PROTMASK) == W5500SIM_PROTTCP) {
+				pRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATINIT;
+			} else if ((pRegs[W5500SIM_SCKMODE] & W5500SIM_PROTMASK) == W5500SIM_PROTUDP) {
+				pRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATUDP;
+			} else {
+				break;
+			}
+
+			//Every pointer starts over
+			W5500SimSet16(&(pRegs[W5500SIM_SCKTXREAD]), 0);
+			W5500SimSet16(&(pRegs[W5500SIM_SCKTXWRITE]), 0);
+			W5500SimSet16(&(pRegs[W5500SIM_SCKTXFREE]), pRegs[W5500SIM_SCKTXSIZE] * 1024);
+			W5500SimSet16(&(pRegs[W5500SIM_SCKRXREAD]), 0);
+			W5500SimSet16(&(pRegs[W5500SIM_SCKRXWRITE]), 0);
+			W5500SimSet16(&(pRegs[W5500SIM_SCKRXRECV]), 0);
+			pSck->nRXWrite = 0;
+			pSck->nPeerHead = 0;
+			pSck->nPeerCnt = 0;
+			pSck->bSending = false;
+			break;
+
+		case W5500SIM_CMDLISTEN:
+			if (pRegs[W5500SIM_SCKSTATUS] == W5500SIM_STATINIT) {
+				pRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATLISTEN;
+			}
+			break;
+
+		case W5500SIM_CMDCONNECT: //The peer answers at once
+			if (pRegs[W5500SIM_SCKSTATUS] == W5500SIM_STATINIT) {
+				if (pSim->bPeerRefuse == true) {
+					pRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATCLOSED;
+					W5500SimRaise(pSim, nSocket, W5500SIM_INTTIMEOUT);
+				} else {
+					pRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATESTABLISH;
+					W5500SimRaise(pSim, nSocket, W5500SIM_INTCONNECT);
+				}
+			}
+			break;
+
+		case W5500SIM_CMDDISCON:
+		case W5500SIM_CMDCLOSE:
+			if (pRegs[W5500SIM_SCKSTATUS] != W5500SIM_STATCLOSED) {
+				pRegs[W5500SIM_SCKSTATUS] = W5500SIM_STATCLOSED;
+
+				if (nCommand == W5500SIM_CMDDISCON) {
+					W5500SimRaise(pSim, nSocket, W5500SIM_INTDISCON);
+				}
+			}
+			break;
+
+		case W5500SIM_CMDSEND:
+			if ((pRegs[W5500SIM_SCKSTATUS] == W5500SIM_STATESTABLISH) || (pRegs[W5500SIM_SCKSTATUS] == W5500SIM_STATUDP)) {
+				W5500SimTXDrain(pSim, nSocket);
+			}
+			break;
+
+		case W5500SIM_CMDRECV:
+			nRead = W5500SimGet16(&(pRegs[W5500SIM_SCKRXREAD]));
+			W5500SimSet16(&(pRegs[W5500SIM_SCKRXRECV]), pSck->nRXWrite - nRead);
+
+			if (pSck->nRXWrite != nRead) { //Data left behind raises the flag again
+				W5500SimRaise(pSim, nSocket, W5500SIM_INTRECV);
+			}
+			break;
+
+		default: //Commands the model does not act on
+			break;
+	}
+
+	pRegs[W5500SIM_SCKCOMMAND] = 0; //Command register clears once accepted
+}
+
+void W5500SimReset(sW5500SimInfo_t *pSim) {
+	uint8_t nCtr;
+
+	memset(pSim->aCommon, 0, sizeof(pSim->aCommon));
+	pSim->aCommon[W5500SIM_CMNVERSION] = W5500SIM_VERSION;
+	pSim->aCommon[W5500SIM_CMNPHYCFG] = W5500SIM_PHYLINKUP;
+
+	for (nCtr = 0; nCtr < W5500SIM_NUMSOCKETS; nCtr++) {
+		memset(pSim->aSockets[nCtr].aRegs, 0, W5500SIM_SOCKETREGS);
+		pSim->aSockets[nCtr].aRegs[W5500SIM_SCKRXSIZE] = W5500SIM_DEFAULTBUFF;
+		pSim->aSockets[nCtr].aRegs[W5500SIM_SCKTXSIZE] = W5500SIM_DEFAULTBUFF;
+		pSim->aSockets[nCtr].aRegs[W5500SIM_SCKINTMASK] = W5500SIM_INTALL;
+		W5500SimSet16(&(pSim->aSockets[nCtr].aRegs[W5500SIM_SCKTXFREE]), W5500SIM_DEFAULTBUFF * 1024);
+
+		pSim->aSockets[nCtr].nRXWrite = 0;
+		pSim->aSockets[nCtr].nPeerHead = 0;
+		pSim->aSockets[nCtr].nPeerCnt = 0;
+		pSim->aSockets[nCtr].nPeerLost = 0;
+		pSim->aSockets[nCtr].bSending = false;
+	}
+}
+
+void W5500SimRaise(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t nFlags) {
+	uint8_t *pRegs = pSim->aSockets[nSocket].aRegs;
+
+	//The part only sets the flags its mask allows
+	pRegs[W5500SIM_SCKINT] |= nFlags & pRegs[W5500SIM_SCKINTMASK];
+}
+
+void W5500SimUpdateInt(sW5500SimInfo_t *pSim) {
+	uint8_t nCtr;
+	bool bAsserted = false;
+
+	if (pSim->pIntPins == NULL) {
+		return;
+	}
+
+	for (nCtr = 0; nCtr < W5500SIM_NUMSOCKETS; nCtr++) {
+		if (((pSim->aCommon[W5500SIM_CMNSOCKMASK] & (1 << nCtr)) != 0) && (pSim->aSockets[nCtr].aRegs[W5500SIM_SCKINT] != 0)) {
+			bAsserted = true;
+			break;
+		}
+	}
+
+	//INTn is active low
+	GPIOSimSetInput(pSim->pIntPins, pSim->nIntPin, !bAsserted);
+}
+
+uint32_t W5500SimBuffBase(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t nSizeReg) {
+	uint32_t nBase = 0;
+	uint8_t nCtr;
+
+	//Each socket's memory follows that of the sockets before it
+	for (nCtr = 0; nCtr < nSocket; nCtr++) {
+		nBase += pSim->aSockets[nCtr].aRegs[nSizeReg] * 1024;
+	}
+
+	return nBase;
+}
+
+uint16_t W5500SimGet16(const uint8_t *pReg) {
+	return (pReg[0] << 8) | pReg[1];
+}
+
+void W5500SimSet16(uint8_t *pReg, uint16_t nValue) {
+	pReg[0] = nValue >> 8;
+	pReg[1] = nValue & 0xFF;
+}
+
+uint32_t W5500SimRXFree(sW5500SimInfo_t *pSim, uint8_t nSocket) {
+	sW5500SimSocket_t *pSck = &(pSim->aSockets[nSocket]);
+	uint16_t nUsed;
+
+	nUsed = pSck->nRXWrite - W5500SimGet16(&(pSck->aRegs[W5500SIM_SCKRXREAD]));
+
+	return (pSck->aRegs[W5500SIM_SCKRXSIZE] * 1024) - nUsed;
+}
+
+void W5500SimRXPut(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t *pData, uint32_t nBytes) {
+	sW5500SimSocket_t *pSck = &(pSim->aSockets[nSocket]);
+	uint32_t nBase, nSize, nCtr;
+	uint16_t nUsed;
+
+	nSize = pSck->aRegs[W5500SIM_SCKRXSIZE] * 1024;
+	nBase = W5500SimBuffBase(pSim, nSocket, W5500SIM_SCKRXSIZE);
+	nUsed = pSck->nRXWrite - W5500SimGet16(&(pSck->aRegs[W5500SIM_SCKRXREAD]));
+
+	for (nCtr = 0; nCtr < nBytes; nCtr++) {
+		pSim->aRXMem[(nBase + (pSck->nRXWrite & (nSize - 1))) % W5500SIM_BUFFMEM] = pData[nCtr];
+		pSck->nRXWrite += 1;
+	}
+
+	W5500SimSet16(&(pSck->aRegs[W5500SIM_SCKRXWRITE]), pSck->nRXWrite);
+	W5500SimSet16(&(pSck->aRegs[W5500SIM_SCKRXRECV]), nUsed + nBytes);
+}
+
+void W5500SimTXDrain(sW5500SimInfo_t *pSim, uint8_t nSocket) {
+	sW5500SimSocket_t *pSck = &(pSim->aSockets[nSocket]);
+	uint8_t *pRegs = pSck->aRegs;
+	uint32_t nBase, nSize, nWindow;
+	uint16_t nRead, nWrite;
+
+	nWindow = pSim->nPeerWindow;
+	if ((nWindow == 0) || (nWindow > W5500SIM_PEERBUFF)) {
+		nWindow = W5500SIM_PEERBUFF;
+	}
+
+	nSize = pRegs[W5500SIM_SCKTXSIZE] * 1024;
+	nBase = W5500SimBuffBase(pSim, nSocket, W5500SIM_SCKTXSIZE);
+	nRead = W5500SimGet16(&(pRegs[W5500SIM_SCKTXREAD]));
+	nWrite = W5500SimGet16(&(pRegs[W5500SIM_SCKTXWRITE]));
+
+	//Move what the peer has room for, the rest waits for it to collect
+	while (nRead != nWrite) {
+		if (pSck->nPeerCnt < nWindow) {
+			pSck->aPeer[(pSck->nPeerHead + pSck->nPeerCnt) % W5500SIM_PEERBUFF] = pSim->aTXMem[(nBase + (nRead & (nSize - 1))) % W5500SIM_BUFFMEM];
+			pSck->nPeerCnt += 1;
+		} else if (pRegs[W5500SIM_SCKSTATUS] == W5500SIM_STATUDP) { //Datagrams are dropped, not held
+			pSck->nPeerLost += 1;
+		} else {
+			break;
+		}
+
+		nRead += 1;
+	}
+
+	W5500SimSet16(&(pRegs[W5500SIM_SCKTXREAD]), nRead);
+	W5500SimSet16(&(pRegs[W5500SIM_SCKTXFREE]), nSize - (uint16_t)(nWrite - nRead));
+
+	if (nRead == nWrite) {
+		pSck->bSending = false;
+		W5500SimRaise(pSim, nSocket, W5500SIM_INTSENDOK);
+	} else {
+		pSck->bSending = true;
+	}
+}
@@ -0,0 +1,204 @@
+/**	@defgroup	spiw5500sim
+	@brief		Simulated W5500 Ethernet device on an SPI General Interface bus
+	@details	v0.3
+	# Description #
+		Provides an SPI bus with a model of the Wiznet W5500 attached so the
+		W5500 driver can run on any Linux machine.  The model holds the common
+		and socket registers and the 16 KB transmit and 16 KB receive buffer
+		memory, split between the sockets by their buffer size registers the way
+		the part does.  Buffer addresses wrap within each socket's buffer.
+
+		Socket commands act at once.  Open, listen, connect, close, send, and
+		receive move the socket through its states and update its pointers,
+		sizes, and interrupt flags.  Flags are only raised where the socket's
+		interrupt mask allows, and the INTn pin can be attached to a simulated
+		GPIO input which goes low while any socket enabled in the socket
+		interrupt mask has a flag raised.  A connect is taken up by the simulated
+		peer right away, or refused with a timeout if bPeerRefuse is set.  The
+		application plays the other end of each connection: it opens
+		connections to listening sockets, delivers data and UDP datagrams into
+		the receive buffers, and collects the data that was sent.  A TCP send 
+		only moves what fits in the peer's window, the rest stays in the 
+		transmit buffer with the send unfinished until the peer collects data, 
+		so senders see the back pressure a slow receiver causes.
+
+		Each read or write of the part is one frame, from the bus's begin
+		transfer to its end transfer, which the W5500 driver calls inside its
+		chip select.  The chip select pin itself is not watched.  Frames, bytes,
+		and the calls made into the bus are counted so the cost of driving the
+		part can be measured.
+
+	# Usage #
+		Pass an sW5500SimInfo_t as the hardware information when initializing
+		the SPI interface with W5500SimPortInitialize(), then hand that
+		interface to W5500Initialize() along with any GPIO interface for the
+		chip select, such as the simulated GPIO.  To drive INTn attach it to
+		an input pin with W5500SimAttachInterrupt() after the part is
+		initialized.
+
+	# File Information #
+		File:	SPI_W5500Simulated.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __SPIW5500SIMULATED
+	#define __SPIW5500SIMULATED
+
+/*****	Includes	*****/
+	#include "GPIO_Simulated.h"		//Sets the POSIX level, must come before system headers
+
+	#include <string.h>
+
+	#include "CommonUtils.h"
+	#include "SPIGeneralInterface.h"
+
+/*****	Definitions	*****/
+	/**	@brief		Number of sockets the simulated part has
+		@ingroup	spiw5500sim
+	*/
+	#define W5500SIM_NUMSOCKETS		8
+
+	/**	@brief		Bytes of transmit memory, and of receive memory, shared by all sockets
+		@ingroup	spiw5500sim
+	*/
+	#define W5500SIM_BUFFMEM		16384
+
+	/**	@brief		Bytes in the common register block
+		@ingroup	spiw5500sim
+	*/
+	#define W5500SIM_COMMONREGS		0x40
+
+	/**	@brief		Bytes in each socket register block
+		@ingroup	spiw5500sim
+	*/
+	#define W5500SIM_SOCKETREGS		0x30
+
+	#ifndef W5500SIM_PEERBUFF
+		/**	@brief		Bytes of sent data each socket holds for the application to collect
+			@ingroup	spiw5500sim
+		*/
+		#define W5500SIM_PEERBUFF	16384
+	#endif
+
+	/**	@brief		One socket of the simulated part
+		@ingroup	spiw5500sim
+	*/
+	typedef struct sW5500SimSocket_t {
+		uint8_t aRegs[W5500SIM_SOCKETREGS];		/**< Socket registers */
+		uint16_t nRXWrite;						/**< Where the next received byte is placed */
+
+		uint8_t aPeer[W5500SIM_PEERBUFF];		/**< Data sent, waiting to be collected */
+		uint32_t nPeerHead;						/**< Index of the oldest byte sent */
+		uint32_t nPeerCnt;						/**< Bytes sent waiting to be collected */
+		uint32_t nPeerLost;						/**< UDP bytes sent that did not fit to be collected */
+		bool bSending;							/**< A send is held up until the peer collects data */
+	} sW5500SimSocket_t;
+
+	/**	@brief		State of the simulated part and the bus to it
+		@ingroup	spiw5500sim
+	*/
+	typedef struct sW5500SimInfo_t {
+		uint8_t aCommon[W5500SIM_COMMONREGS];		/**< Common registers */
+		sW5500SimSocket_t aSockets[W5500SIM_NUMSOCKETS];	/**< Socket registers and state */
+		uint8_t aTXMem[W5500SIM_BUFFMEM];			/**< Transmit memory for all sockets */
+		uint8_t aRXMem[W5500SIM_BUFFMEM];			/**< Receive memory for all sockets */
+
+		uint32_t nFramePos;							/**< Bytes into the current frame */
+		uint16_t nAddress;							/**< Address of the next data byte in the frame */
+		uint8_t nControl;							/**< Control byte of the current frame */
+
+		sGPIOSimInfo_t *pIntPins;					/**< Simulated GPIO holding the INTn pin, NULL if not attached */
+		GPIOID_t nIntPin;							/**< Pin standing in for INTn */
+		bool bPeerRefuse;							/**< Connects are refused rather than accepted */
+		uint32_t nPeerWindow;						/**< Bytes the peer holds uncollected before TCP sends stall, 0 for W5500SIM_PEERBUFF */
+
+		uint32_t nFrames;							/**< Frames started on the bus */
+		uint64_t nBusBytes;							/**< Bytes moved over the bus */
+		uint64_t nBusCalls;							/**< Calls made into the bus to move bytes */
+	} sW5500SimInfo_t;
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Prepare the simulated bus and reset the part on it
+		@param		pIface			Pointer to interface object to prepare for use
+		@param		pHWInfo			Pointer to the sW5500SimInfo_t holding the part
+		@param		nBusClockFreq	Clock frequency, only recorded
+		@param		eDataOrder		Data order, only recorded
+		@param		eMode			SPI mode, only recorded
+		@return		SPI_Success once the part is ready
+		@ingroup	spiw5500sim
+	*/
+	eSPIReturn_t W5500SimPortInitialize(sSPIIface_t *pIface, void *pHWInfo, uint32_t nBusClockFreq, eSPIDataOrder_t eDataOrder, eSPIMode_t eMode);
+
+	/**	@brief		Attach the part's INTn output to a simulated GPIO input
+		@details	The pin is set to the current level of INTn right away, then
+			follows it as flags and masks change.
+		@param		pSim		Simulated part
+		@param		pPins		Simulated GPIO holding the pin
+		@param		nPin		Pin to drive
+		@ingroup	spiw5500sim
+	*/
+	void W5500SimAttachInterrupt(sW5500SimInfo_t *pSim, sGPIOSimInfo_t *pPins, GPIOID_t nPin);
+
+	/**	@brief		Open a connection from the peer to a listening TCP socket
+		@param		pSim		Simulated part
+		@param		nSocket		Socket that is listening
+		@param		aAddr		Address of the peer, most significant byte first
+		@param		nPort		Port of the peer
+		@return		True if the socket was listening and is now connected
+		@ingroup	spiw5500sim
+	*/
+	bool W5500SimPeerConnect(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t aAddr[4], uint16_t nPort);
+
+	/**	@brief		Close a connection from the peer's end
+		@param		pSim		Simulated part
+		@param		nSocket		Socket that is connected
+		@return		True if the socket was connected and is now closing
+		@ingroup	spiw5500sim
+	*/
+	bool W5500SimPeerClose(sW5500SimInfo_t *pSim, uint8_t nSocket);
+
+	/**	@brief		Deliver data from the peer into a socket's receive buffer
+		@param		pSim		Simulated part
+		@param		nSocket		Socket to deliver to
+		@param		pData		Data to deliver
+		@param		nBytes		Number of bytes to deliver
+		@return		Number of bytes that fit in the receive buffer
+		@ingroup	spiw5500sim
+	*/
+	uint32_t W5500SimPeerWrite(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t *pData, uint32_t nBytes);
+
+	/**	@brief		Deliver a datagram from the peer to a UDP socket
+		@details	The datagram is stored behind the source and length header as
+			the part does, and is dropped whole if it does not fit.
+		@param		pSim		Simulated part
+		@param		nSocket		UDP socket to deliver to
+		@param		aAddr		Address of the sender, most significant byte first
+		@param		nPort		Port of the sender
+		@param		pData		Datagram to deliver
+		@param		nBytes		Number of bytes in the datagram
+		@return		Number of bytes delivered, 0 if the datagram was dropped
+		@ingroup	spiw5500sim
+	*/
+	uint32_t W5500SimPeerSendTo(sW5500SimInfo_t *pSim, uint8_t nSocket, const uint8_t aAddr[4], uint16_t nPort, const uint8_t *pData, uint32_t nBytes);
+
+	/**	@brief		Collect data a socket has sent to the peer
+		@param		pSim		Simulated part
+		@param		nSocket		Socket to collect from
+		@param		pData		Buffer to receive the data
+		@param		nBytes		Number of bytes the buffer can hold
+		@return		Number of bytes collected
+		@ingroup	spiw5500sim
+	*/
+	uint32_t W5500SimPeerRead(sW5500SimInfo_t *pSim, uint8_t nSocket, uint8_t *pData, uint32_t nBytes);
+
+/*****	Functions	*****/
+
+
+#endif
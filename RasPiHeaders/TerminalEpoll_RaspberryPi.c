@@ -0,0 +1,82 @@
+/**	File:	TerminalEpoll_RaspberryPi.c
+	Author:	J. Beighel
+	Date:	2026-10-18
+*/
+
+/*****	Includes	*****/
+	#include "TerminalEpoll_RaspberryPi.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+/**	@brief		Handler on the host socket, opens a session for each new client
+	@param		pTCPServ	Server the client connected to
+	@param		pSck		Socket of the new client
+	@param		eEvents		Always RasPiEpoll_Accepted
+	@param		pParam		Terminal server to open the session in
+	@ingroup	raspitermepoll
+*/
+static void RasPiEpollTermAccept(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam);
+
+/**	@brief		Handler on each client socket, feeds input to its session
+	@param		pTCPServ	Server the client is connected to
+	@param		pSck		Socket of the client
+	@param		eEvents		Events on the socket
+	@param		pParam		Session of the client
+	@ingroup	raspitermepoll
+*/
+static void RasPiEpollTermSession(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam);
+
+/*****	Functions	*****/
+eReturn_t RasPiEpollServeTerminals(sTermServ_t *pTermServ) {
+	sTCPServ_t *pTCPServ = pTermServ->pTCPServ;
+
+	if (RasPiEpollSetHandler(pTCPServ, &(pTCPServ->HostSck), &RasPiEpollTermAccept, pTermServ) != Net_Success) {
+		return Fail_Invalid; //Server is not bound on an event loop
+	}
+
+	return Success;
+}
+
+static void RasPiEpollTermAccept(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam) {
+	sTermServ_t *pTermServ = (sTermServ_t *)pParam;
+	sTermSession_t *pSession;
+
+	if (TermServOpenSession(pTermServ, pSck, &pSession) != Success) { //No session free, turn the client away
+		pTCPServ->pfCloseSocket(pTCPServ, pSck);
+		return;
+	}
+
+	//From now on this client's events go straight to its session
+	RasPiEpollSetHandler(pTCPServ, pSck, &RasPiEpollTermSession, pSession);
+
+	return;
+}
+
+static void RasPiEpollTermSession(sTCPServ_t *pTCPServ, sSocket_t *pSck, eRasPiEpollEvent_t eEvents, void *pParam) {
+	sTermSession_t *pSession = (sTermSession_t *)pParam;
+
+	if ((eEvents & RasPiEpoll_Readable) != 0) {
+		if (TermServSessionInput(pSession) != Success) {
+			TermServCloseSession(pSession);
+			return;
+		}
+	}
+
+	//Wait for any remaining input to be read before closing
+	if (((eEvents & RasPiEpoll_Hangup) != 0) && ((eEvents & RasPiEpoll_Readable) == 0)) {
+		TermServCloseSession(pSession);
+	}
+
+	return;
+}
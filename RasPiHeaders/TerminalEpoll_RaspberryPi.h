@@ -0,0 +1,58 @@
+/**	@defgroup	raspitermepoll
+	@brief		Terminal sessions served from the epoll event loop
+	@details	v0.1
+	#Description
+		Connects a terminal server to a TCP server created on the epoll event
+		loop.  Every accepted client gets a session, input is handed to it as
+		the socket becomes readable, and the session is closed when the client
+		hangs up.  Output written while processing a line is gathered by the
+		loop and sent when the line is done.
+
+	#Usage
+		Create the TCP server with RasPiEpollCreateTCPServer() and bind it,
+		initialize the terminal server on it and add its handlers, then call
+		RasPiEpollServeTerminals().  Sessions are handled whenever
+		RasPiEpollProcess() is called.
+
+	#File Information
+		File:	TerminalEpoll_RaspberryPi.h
+		Author:	J. Beighel
+		Date:	2026-10-18
+*/
+
+#ifndef __RASPITERMEPOLL_H
+	#define __RASPITERMEPOLL_H
+
+/*****	Includes	*****/
+	#include "CommonUtils.h"
+	#include "TerminalServer.h"
+	#include "NetworkEpoll_RaspberryPi.h"
+
+/*****	Defines		*****/
+
+
+/*****	Definitions	*****/
+
+
+/*****	Constants	*****/
+
+
+/*****	Globals		*****/
+
+
+/*****	Prototypes 	*****/
+	/**	@brief		Begin serving terminal sessions to clients of the server
+		@details	Clients already waiting on the accept function are given
+			sessions right away.
+		@param		pTermServ	Terminal server to open sessions in, its TCP server
+			must be on an epoll loop and bound
+		@return		Success if clients will be served, Fail_Invalid if the TCP
+			server is not bound on an event loop
+		@ingroup	raspitermepoll
+	*/
+	eReturn_t RasPiEpollServeTerminals(sTermServ_t *pTermServ);
+
+/*****	Functions	*****/
+
+
+#endif